@@ -25,7 +25,7 @@ using namespace swss;
 #define VRF_PREFIX          "Vrf"
 #define VRF_MGMT            "mgmt"
 
-#define LOOPBACK_DEFAULT_MTU_STR "65536"
+#define LOOPBACK_DEFAULT_MTU 65536
 #define DEFAULT_MTU_STR 9100
 
 IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
@@ -78,91 +78,71 @@ IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
                         const IpPrefix &ipPrefix)
 {
-    stringstream    cmd;
-    string          res;
-    string          ipPrefixStr = ipPrefix.to_string();
-    string          broadcastIpStr = ipPrefix.getBroadcastIp().to_string();
-    int             prefixLen = ipPrefix.getMaskLength();
+    int prefixLen = ipPrefix.getMaskLength();
+    uint32_t metric = 0;
 
-    if (ipPrefix.isV4())
+    // Kernel adds connected route with default metric of 256. But the metric is not
+    // communicated to frr unless the ip address is added with explicit metric
+    // In voq system, We need the static route to the remote neighbor and connected
+    // route to have the same metric to enable BGP to choose paths from routes learned
+    // via eBGP and iBGP over the internal inband port be part of same ecmp group.
+    // For v4 both the metrics (connected and static) are default 0 so we do not need
+    // to set the metric explicitly.
+    if (!ipPrefix.isV4() && mySwitchType == "voq")
     {
-        (prefixLen < 31) ?
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<" dev " << shellquote(alias)) :
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias));
+        metric = 256;
     }
-    else
-    {
-        string metric = "";
-        // Kernel adds connected route with default metric of 256. But the metric is not
-        // communicated to frr unless the ip address is added with explicit metric
-        // In voq system, We need the static route to the remote neighbor and connected
-        // route to have the same metric to enable BGP to choose paths from routes learned
-        // via eBGP and iBGP over the internal inband port be part of same ecmp group.
-        // For v4 both the metrics (connected and static) are default 0 so we do not need
-        // to set the metric explicitly.
-        if(mySwitchType == "voq")
+
+    // ip address {{add|del}} {{ip_prefix}} [broadcast {{broadcast_ip}}] dev {{alias}} [metric 256]
+    auto setIp = [&]() {
+        if (opCmd == "add")
         {
-           metric = " metric 256";
+            return m_rtnl.addAddress(alias, ipPrefix, ipPrefix.isV4() && prefixLen < 31, metric);
         }
+        return m_rtnl.delAddress(alias, ipPrefix);
+    };
 
-        (prefixLen < 127) ?
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<
-         " dev " << shellquote(alias) << metric) :
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias) << metric);
-    }
-
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    int err = setIp();
+    if (err)
     {
         if (!ipPrefix.isV4() && opCmd == "add")
         {
-            SWSS_LOG_NOTICE("Failed to assign IPv6 on interface %s with return code %d, trying to enable IPv6 and retry", alias.c_str(), ret);
+            SWSS_LOG_NOTICE("Failed to assign IPv6 on interface %s: %s, trying to enable IPv6 and retry",
+                            alias.c_str(), RtnlClient::errorString(err).c_str());
             if (!enableIpv6Flag(alias))
             {
                 SWSS_LOG_ERROR("Failed to enable IPv6 on interface %s", alias.c_str());
                 return;
             }
-            ret = swss::exec(cmd.str(), res);
+            err = setIp();
         }
 
-        if (ret)
+        if (err)
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+            SWSS_LOG_ERROR("Failed to %s address %s on %s: %s", opCmd.c_str(), ipPrefix.to_string().c_str(),
+                           alias.c_str(), RtnlClient::errorString(err).c_str());
         }
     }
 }
 
 void IntfMgr::setIntfMac(const string &alias, const string &mac_str)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link set " << alias << " address " << mac_str;
-
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    // ip link set {{alias}} address {{mac}}
+    int err = m_rtnl.setLinkMac(alias, MacAddress(mac_str));
+    if (err)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to set %s address %s: %s", alias.c_str(), mac_str.c_str(), RtnlClient::errorString(err).c_str());
     }
 }
 
 void IntfMgr::setIntfVrf(const string &alias, const string &vrfName)
 {
-    stringstream cmd;
-    string res;
-
-    if (!vrfName.empty())
-    {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " master " << shellquote(vrfName);
-    }
-    else
+    // ip link set {{alias}} {{master {{vrf}}|nomaster}}
+    int err = m_rtnl.setLinkMaster(alias, vrfName);
+    if (err)
     {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " nomaster";
-    }
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to set %s master %s: %s", alias.c_str(), vrfName.empty() ? "none" : vrfName.c_str(),
+                       RtnlClient::errorString(err).c_str());
     }
 }
 
@@ -195,48 +175,50 @@ bool IntfMgr::setIntfMpls(const string &alias, const string& mpls)
 
 void IntfMgr::addLoopbackIntf(const string &alias)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link add " << alias << " mtu " << LOOPBACK_DEFAULT_MTU_STR << " type dummy && ";
-    cmd << IP_CMD << " link set " << alias << " up";
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    // ip link add {{alias}} mtu 65536 type dummy && ip link set {{alias}} up
+    int err = m_rtnl.addDummy(alias);
+    if (!err)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        err = m_rtnl.setLinkMtu(alias, LOOPBACK_DEFAULT_MTU);
+    }
+    if (!err)
+    {
+        err = m_rtnl.setLinkAdminState(alias, true);
+    }
+    if (err)
+    {
+        SWSS_LOG_ERROR("Failed to add loopback %s: %s", alias.c_str(), RtnlClient::errorString(err).c_str());
     }
 }
 
 void IntfMgr::delLoopbackIntf(const string &alias)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link del " << alias;
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    // ip link del {{alias}}
+    int err = m_rtnl.delLink(alias);
+    if (err)
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Failed to delete loopback %s: %s", alias.c_str(), RtnlClient::errorString(err).c_str());
     }
 }
 
 void IntfMgr::flushLoopbackIntfs()
 {
-    stringstream cmd;
-    string res;
+    vector<string> aliases;
 
-    cmd << IP_CMD << " link show type dummy | grep -o '" << LOOPBACK_PREFIX << "[^:]*'";
-
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    // ip link show type dummy
+    int err = m_rtnl.getLinks("dummy", aliases);
+    if (err)
     {
-        SWSS_LOG_DEBUG("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_DEBUG("Failed to get dummy links: %s", RtnlClient::errorString(err).c_str());
         return;
     }
 
-    auto aliases = tokenize(res, '\n');
     for (string &alias : aliases)
     {
+        if (alias.compare(0, strlen(LOOPBACK_PREFIX), LOOPBACK_PREFIX))
+        {
+            continue;
+        }
         SWSS_LOG_NOTICE("Remove loopback device %s", alias.c_str());
         delLoopbackIntf(alias);
     }
@@ -331,11 +313,9 @@ bool IntfMgr::isIntfChangeVrf(const string &alias, const string &vrfName)
 
 void IntfMgr::addHostSubIntf(const string&intf, const string &subIntf, const string &vlan)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD " link add link " << shellquote(intf) << " name " << shellquote(subIntf) << " type vlan id " << shellquote(vlan);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    // ip link add link {{intf}} name {{subintf}} type vlan id {{vlan}}
+    RTNL_WITH_ERROR_THROW(m_rtnl.addVlan(subIntf, intf, static_cast<uint16_t>(stoul(vlan)), false),
+                          "add " + subIntf + " link " + intf + " vlan " + vlan);
 }
 
 
@@ -431,9 +411,6 @@ void IntfMgr::updateSubIntfMtu(const string &alias, const string &mtu)
 
 std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, const string &parent_mtu)
 {
-    stringstream cmd;
-    string res;
-
     string subifMtu = mtu;
     subIntf subIf(alias);
 
@@ -445,19 +422,17 @@ std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, c
         subifMtu = parent_mtu;
     }
     SWSS_LOG_INFO("subintf %s active mtu: %s", alias.c_str(), subifMtu.c_str());
-    cmd << IP_CMD " link set " << shellquote(alias) << " mtu " << shellquote(subifMtu);
-    std::string cmd_str = cmd.str();
-    int ret = swss::exec(cmd_str, res);
+    int err = m_rtnl.setLinkMtu(alias, static_cast<uint32_t>(stoul(subifMtu)));
 
-    if (ret && !isIntfStateOk(alias))
+    if (err && !isIntfStateOk(alias))
     {
         // Can happen when a SET notification on the PORT_TABLE in the State DB
         // followed by a new DEL notification that send by portmgrd
-        SWSS_LOG_WARN("Setting mtu to %s netdev failed with cmd:%s, rc:%d, error:%s", alias.c_str(), cmd_str.c_str(), ret, res.c_str());
+        SWSS_LOG_WARN("Setting mtu to %s netdev failed: %s", alias.c_str(), RtnlClient::errorString(err).c_str());
     }
-    else if (ret)
+    else if (err)
     {
-        throw runtime_error(cmd_str + " : " + res);
+        throw runtime_error("set " + alias + " mtu " + subifMtu + " : " + RtnlClient::errorString(err));
     }
     return subifMtu;
 }
@@ -489,24 +464,19 @@ void IntfMgr::updateSubIntfAdminStatus(const string &alias, const string &admin)
 
 std::string IntfMgr::setHostSubIntfAdminStatus(const string &alias, const string &admin_status, const string &parent_admin_status)
 {
-    stringstream cmd;
-    string res, cmd_str;
-
     if (parent_admin_status == "up" || admin_status == "down")
     {
         SWSS_LOG_INFO("subintf %s admin_status: %s", alias.c_str(), admin_status.c_str());
-        cmd << IP_CMD " link set " << shellquote(alias) << " " << shellquote(admin_status);
-        cmd_str = cmd.str();
-        int ret = swss::exec(cmd_str, res);
-        if (ret && !isIntfStateOk(alias))
+        int err = m_rtnl.setLinkAdminState(alias, admin_status == "up");
+        if (err && !isIntfStateOk(alias))
         {
             // Can happen when a DEL notification is sent by portmgrd immediately followed by a new SET notification
-            SWSS_LOG_WARN("Setting admin_status to %s netdev failed with cmd:%s, rc:%d, error:%s",
-                          alias.c_str(), cmd_str.c_str(), ret, res.c_str());
+            SWSS_LOG_WARN("Setting admin_status to %s netdev failed: %s",
+                          alias.c_str(), RtnlClient::errorString(err).c_str());
         }
-        else if (ret)
+        else if (err)
         {
-            throw runtime_error(cmd_str + " : " + res);
+            throw runtime_error("set " + alias + " " + admin_status + " : " + RtnlClient::errorString(err));
         }
         return admin_status;
     }
@@ -518,11 +488,7 @@ std::string IntfMgr::setHostSubIntfAdminStatus(const string &alias, const string
 
 void IntfMgr::removeHostSubIntf(const string &subIntf)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD " link del " << shellquote(subIntf);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.delLink(subIntf), "del " + subIntf);
 }
 
 void IntfMgr::setSubIntfStateOk(const string &alias)
@@ -712,11 +678,7 @@ void IntfMgr::delIpv6LinkLocalNeigh(const string &alias)
                 IpAddress ipAddress(keys[1]);
                 if (ipAddress.getAddrScope() == IpAddress::AddrScope::LINK_SCOPE)
                 {
-                    stringstream cmd;
-                    string res;
-
-                    cmd << IP_CMD << " neigh del dev " << keys[0] << " " << keys[1] ;
-                    swss::exec(cmd.str(), res);
+                    m_rtnl.delNeighbor(keys[0], ipAddress);
                     SWSS_LOG_INFO("Deleted ipv6 link local neighbor - %s", keys[1].c_str());
                 }
             }
@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "rtnlclient.h"
 
 #include <map>
 #include <string>
@@ -32,6 +33,7 @@ private:
     Table m_cfgIntfTable, m_cfgVlanIntfTable, m_cfgLagIntfTable, m_cfgLoopbackIntfTable;
     Table m_statePortTable, m_stateLagTable, m_stateVlanTable, m_stateVrfTable, m_stateIntfTable;
     Table m_neighTable;
+    RtnlClient m_rtnl;
 
     SubIntfMap m_subIntfList;
     std::set<std::string> m_loopbackIntfList;
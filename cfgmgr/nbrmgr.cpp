@@ -9,7 +9,6 @@
 #include "ipprefix.h"
 #include "macaddress.h"
 #include "nbrmgr.h"
-#include "exec.h"
 #include "shellcmd.h"
 #include "subscriberstatetable.h"
 
@@ -496,16 +495,15 @@ bool NbrMgr::getVoqInbandInterfaceName(string &ibif, string &type)
 
 bool NbrMgr::addKernelRoute(string odev, IpAddress ip_addr)
 {
-    string cmd, res;
-
     SWSS_LOG_ENTER();
 
     string ip_str = ip_addr.to_string();
+    int err;
 
     if(ip_addr.isV4())
     {
-        cmd = string("") + IP_CMD + " route add " + ip_str + "/32 dev " + odev;
-        SWSS_LOG_NOTICE("IPv4 Route Add cmd: %s",cmd.c_str());
+        SWSS_LOG_NOTICE("IPv4 Route Add: %s/32 dev %s", ip_str.c_str(), odev.c_str());
+        err = m_rtnl.addRoute(odev, IpPrefix(ip_str + "/32"));
     }
     else
     {
@@ -514,16 +512,14 @@ bool NbrMgr::addKernelRoute(string odev, IpAddress ip_addr)
         // via eBGP and iBGP over the internal inband port be part of same ecmp group.
         // For v4 both the metrics (connected and static) are default 0 so we do not need
         // to set the metric explicitly.
-        cmd = string("") + IP_CMD + " -6 route add " + ip_str + "/128 dev " + odev + " metric 256";
-        SWSS_LOG_NOTICE("IPv6 Route Add cmd: %s",cmd.c_str());
+        SWSS_LOG_NOTICE("IPv6 Route Add: %s/128 dev %s metric 256", ip_str.c_str(), odev.c_str());
+        err = m_rtnl.addRoute(odev, IpPrefix(ip_str + "/128"), 256);
     }
 
-    int32_t ret = swss::exec(cmd, res);
-
-    if(ret)
+    if(err)
     {
         /* This failure the caller expects is due to mac move */
-        SWSS_LOG_INFO("Failed to add route for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_INFO("Failed to add route for %s, error: %s", ip_str.c_str(), RtnlClient::errorString(err).c_str());
         return false;
     }
 
@@ -533,29 +529,18 @@ bool NbrMgr::addKernelRoute(string odev, IpAddress ip_addr)
 
 bool NbrMgr::delKernelRoute(IpAddress ip_addr)
 {
-    string cmd, res;
-
     SWSS_LOG_ENTER();
 
     string ip_str = ip_addr.to_string();
+    IpPrefix prefix(ip_str + (ip_addr.isV4() ? "/32" : "/128"));
 
-    if(ip_addr.isV4())
-    {
-        cmd = string("") + IP_CMD + " route del " + ip_str + "/32";
-        SWSS_LOG_NOTICE("IPv4 Route Del cmd: %s",cmd.c_str());
-    }
-    else
-    {
-        cmd = string("") + IP_CMD + " -6 route del " + ip_str + "/128";
-        SWSS_LOG_NOTICE("IPv6 Route Del cmd: %s",cmd.c_str());
-    }
-
-    int32_t ret = swss::exec(cmd, res);
+    SWSS_LOG_NOTICE("%s Route Del: %s", ip_addr.isV4() ? "IPv4" : "IPv6", prefix.to_string().c_str());
+    int err = m_rtnl.delRoute(prefix);
 
-    if(ret)
+    if(err)
     {
         /* Just log error and return */
-        SWSS_LOG_ERROR("Failed to delete route for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_ERROR("Failed to delete route for %s, error: %s", ip_str.c_str(), RtnlClient::errorString(err).c_str());
         return false;
     }
 
@@ -567,27 +552,17 @@ bool NbrMgr::addKernelNeigh(string odev, IpAddress ip_addr, MacAddress mac_addr)
 {
     SWSS_LOG_ENTER();
 
-    string cmd, res;
     string ip_str = ip_addr.to_string();
     string mac_str = mac_addr.to_string();
 
-    if(ip_addr.isV4())
-    {
-        cmd = string("") + IP_CMD + " neigh add " + ip_str + " lladdr " + mac_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv4 Nbr Add cmd: %s",cmd.c_str());
-    }
-    else
-    {
-        cmd = string("") + IP_CMD + " -6 neigh add " + ip_str + " lladdr " + mac_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv6 Nbr Add cmd: %s",cmd.c_str());
-    }
+    SWSS_LOG_NOTICE("%s Nbr Add: %s lladdr %s dev %s", ip_addr.isV4() ? "IPv4" : "IPv6",
+                    ip_str.c_str(), mac_str.c_str(), odev.c_str());
+    int err = m_rtnl.addNeighbor(odev, ip_addr, mac_addr);
 
-    int32_t ret = swss::exec(cmd, res);
-
-    if(ret)
+    if(err)
     {
         /* This failure the caller expects is due to mac move */
-        SWSS_LOG_INFO("Failed to add Nbr for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_INFO("Failed to add Nbr for %s, error: %s", ip_str.c_str(), RtnlClient::errorString(err).c_str());
         return false;
     }
 
@@ -597,29 +572,17 @@ bool NbrMgr::addKernelNeigh(string odev, IpAddress ip_addr, MacAddress mac_addr)
 
 bool NbrMgr::delKernelNeigh(string odev, IpAddress ip_addr)
 {
-    string cmd, res;
-
     SWSS_LOG_ENTER();
 
     string ip_str = ip_addr.to_string();
 
-    if(ip_addr.isV4())
-    {
-        cmd = string("") + IP_CMD + " neigh del " + ip_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv4 Nbr Del cmd: %s",cmd.c_str());
-    }
-    else
-    {
-        cmd = string("") + IP_CMD + " -6 neigh del " + ip_str + " dev " + odev;
-        SWSS_LOG_NOTICE("IPv6 Nbr Del cmd: %s",cmd.c_str());
-    }
-
-    int32_t ret = swss::exec(cmd, res);
+    SWSS_LOG_NOTICE("%s Nbr Del: %s dev %s", ip_addr.isV4() ? "IPv4" : "IPv6", ip_str.c_str(), odev.c_str());
+    int err = m_rtnl.delNeighbor(odev, ip_addr);
 
-    if(ret)
+    if(err)
     {
         /* Just log error and return */
-        SWSS_LOG_ERROR("Failed to delete Nbr for %s, error: %d", ip_str.c_str(), ret);
+        SWSS_LOG_ERROR("Failed to delete Nbr for %s, error: %s", ip_str.c_str(), RtnlClient::errorString(err).c_str());
         return false;
     }
 
@@ -9,6 +9,7 @@
 #include "producerstatetable.h"
 #include "orch.h"
 #include "netmsg.h"
+#include "rtnlclient.h"
 
 using namespace std;
 
@@ -42,6 +43,7 @@ private:
 
     Table m_statePortTable, m_stateLagTable, m_stateVlanTable, m_stateIntfTable, m_stateNeighRestoreTable;
     struct nl_sock *m_nl_sock;
+    RtnlClient m_rtnl;
 };
 
 }
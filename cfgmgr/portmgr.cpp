@@ -4,7 +4,6 @@
 #include "tokenize.h"
 #include "ipprefix.h"
 #include "portmgr.h"
-#include "exec.h"
 #include "shellcmd.h"
 #include <swss/redisutility.h>
 
@@ -24,14 +23,9 @@ PortMgr::PortMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 
 bool PortMgr::setPortMtu(const string &alias, const string &mtu)
 {
-    stringstream cmd;
-    string res, cmd_str;
-
     // ip link set dev <port_name> mtu <mtu>
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << " mtu " << shellquote(mtu);
-    cmd_str = cmd.str();
-    int ret = swss::exec(cmd_str, res);
-    if (!ret)
+    int err = m_rtnl.setLinkMtu(alias, static_cast<uint32_t>(stoul(mtu)));
+    if (!err)
     {
         // Set the port MTU in application database to update both
         // the port MTU and possibly the port based router interface MTU
@@ -40,38 +34,33 @@ bool PortMgr::setPortMtu(const string &alias, const string &mtu)
     else if (!isPortStateOk(alias))
     {
         // Can happen when a DEL notification is sent by portmgrd immediately followed by a new SET notif
-        SWSS_LOG_WARN("Setting mtu to alias:%s netdev failed with cmd:%s, rc:%d, error:%s", alias.c_str(), cmd_str.c_str(), ret, res.c_str());
+        SWSS_LOG_WARN("Setting mtu to alias:%s netdev failed: %s", alias.c_str(), RtnlClient::errorString(err).c_str());
         return false;
     }
     else
     {
-        throw runtime_error(cmd_str + " : " + res);
+        throw runtime_error("set " + alias + " mtu " + mtu + " : " + RtnlClient::errorString(err));
     }
     return true;
 }
 
 bool PortMgr::setPortAdminStatus(const string &alias, const bool up)
 {
-    stringstream cmd;
-    string res, cmd_str;
-
     // ip link set dev <port_name> [up|down]
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << (up ? " up" : " down");
-    cmd_str = cmd.str();
-    int ret = swss::exec(cmd_str, res);
-    if (!ret)
+    int err = m_rtnl.setLinkAdminState(alias, up);
+    if (!err)
     {
         return writeConfigToAppDb(alias, "admin_status", (up ? "up" : "down"));
     }
     else if (!isPortStateOk(alias))
     {
         // Can happen when a DEL notification is sent by portmgrd immediately followed by a new SET notification
-        SWSS_LOG_WARN("Setting admin_status to alias:%s netdev failed with cmd%s, rc:%d, error:%s", alias.c_str(), cmd_str.c_str(), ret, res.c_str());
+        SWSS_LOG_WARN("Setting admin_status to alias:%s netdev failed: %s", alias.c_str(), RtnlClient::errorString(err).c_str());
         return false;
     }
     else
     {
-        throw runtime_error(cmd_str + " : " + res);
+        throw runtime_error("set " + alias + (up ? " up" : " down") + " : " + RtnlClient::errorString(err));
     }
     return true;
 }
@@ -3,6 +3,7 @@
 #include "dbconnector.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "rtnlclient.h"
 
 #include <map>
 #include <set>
@@ -27,6 +28,7 @@ private:
     Table m_statePortTable;
     ProducerStateTable m_appPortTable;
     ProducerStateTable m_appSendToIngressPortTable;
+    RtnlClient m_rtnl;
 
     std::set<std::string> m_portList;
 
@@ -23,6 +23,15 @@
     }                                           \
 })
 
+/* The same for a RtnlClient operation, which returns a negative errno */
+#define RTNL_WITH_ERROR_THROW(op, desc)   ({                                   \
+    int err = (op);                                                            \
+    if (err != 0)                                                              \
+    {                                                                          \
+        throw runtime_error(std::string(desc) + " : " + swss::RtnlClient::errorString(err)); \
+    }                                                                          \
+})
+
 static inline std::string shellquote(const std::string& str)
 {
     static const std::regex re("([$`\"\\\n])");
@@ -485,12 +485,8 @@ bool TeamMgr::setLagAdminStatus(const string &alias, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
     // ip link set dev <port_channel_name> [up|down]
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << " " << shellquote(admin_status);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkAdminState(alias, admin_status == "up"), "set " + alias + " " + admin_status);
 
     SWSS_LOG_NOTICE("Set port channel %s admin status to %s",
             alias.c_str(), admin_status.c_str());
@@ -502,12 +498,8 @@ bool TeamMgr::setLagMtu(const string &alias, const string &mtu)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
     // ip link set dev <port_channel_name> mtu <mtu_value>
-    cmd << IP_CMD << " link set dev " << shellquote(alias) << " mtu " << shellquote(mtu);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMtu(alias, static_cast<uint32_t>(stoul(mtu))), "set " + alias + " mtu " + mtu);
 
     vector<FieldValueTuple> fvs;
     FieldValueTuple fv("mtu", mtu);
@@ -737,8 +729,7 @@ task_process_status TeamMgr::addLagMember(const string &lag, const string &membe
     string res;
 
     // If port was already deleted, ignore this operation
-    cmd << IP_CMD << " link show " << shellquote(member);
-    if (exec(cmd.str(), res) != 0)
+    if (!m_rtnl.linkExists(member))
     {
 	SWSS_LOG_WARN("Unable to find port %s", member.c_str());
 	return task_ignore;
@@ -752,14 +743,13 @@ task_process_status TeamMgr::addLagMember(const string &lag, const string &membe
     }
 
     uint16_t keyId = generateLacpKey(lag);
-    cmd.str("");
-    cmd.clear();
 
-    // Set admin down LAG member (required by teamd) and enslave it
+    // Set admin down LAG member (required by teamd) and enslave it, a
+    // failure to set it down shows up as a failure to add it
     // ip link set dev <member> down;
     // teamdctl <port_channel_name> port config update <member> { "lacp_key": <lacp_key>, "link_watch": { "name": "ethtool" } };
     // teamdctl <port_channel_name> port add <member>;
-    cmd << IP_CMD << " link set dev " << shellquote(member) << " down; ";
+    m_rtnl.setLinkAdminState(member, false);
     cmd << TEAMDCTL_CMD << " " << shellquote(lag) << " port config update " << shellquote(member)
         << " '{\"lacp_key\":"
         << keyId
@@ -816,9 +806,7 @@ task_process_status TeamMgr::addLagMember(const string &lag, const string &membe
     }
 
     // ip link set dev <member> [up|down]
-    cmd.str(string());
-    cmd << IP_CMD << " link set dev " << shellquote(member) << " " << shellquote(admin_status);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkAdminState(member, admin_status == "up"), "set " + member + " " + admin_status);
 
     fvs.clear();
     FieldValueTuple fv("mtu", mtu);
@@ -840,7 +828,8 @@ bool TeamMgr::removeLagMember(const string &lag, const string &member)
     string res;
 
     // teamdctl <port_channel_name> port remove <member>;
-    cmd << TEAMDCTL_CMD << " " << lag << " port remove " << member << "; ";
+    cmd << TEAMDCTL_CMD << " " << lag << " port remove " << member;
+    exec(cmd.str(), res);
 
     vector<FieldValueTuple> fvs;
     m_cfgPortTable.get(member, fvs);
@@ -862,10 +851,12 @@ bool TeamMgr::removeLagMember(const string &lag, const string &member)
 
     // ip link set dev <port_name> [up|down];
     // ip link set dev <port_name> mtu
-    cmd << IP_CMD << " link set dev " << shellquote(member) << " " << shellquote(admin_status) << "; ";
-    cmd << IP_CMD << " link set dev " << shellquote(member) << " mtu " << shellquote(mtu);
-
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    int err = m_rtnl.setLinkAdminState(member, admin_status == "up");
+    if (err)
+    {
+        SWSS_LOG_ERROR("Failed to set %s %s: %s", member.c_str(), admin_status.c_str(), RtnlClient::errorString(err).c_str());
+    }
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMtu(member, static_cast<uint32_t>(stoul(mtu))), "set " + member + " mtu " + mtu);
     fvs.clear();
     FieldValueTuple fv("admin_status", admin_status);
     fvs.push_back(fv);
@@ -7,6 +7,7 @@
 #include "netmsg.h"
 #include "orch.h"
 #include "producerstatetable.h"
+#include "rtnlclient.h"
 #include <sys/types.h>
 
 namespace swss {
@@ -35,6 +36,7 @@ private:
     std::set<std::string> m_lagList;
 
     MacAddress m_mac;
+    RtnlClient m_rtnl;
 
     void doTask(Consumer &consumer);
     void doLagTask(Consumer &consumer);
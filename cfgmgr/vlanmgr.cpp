@@ -1,9 +1,11 @@
 #include <string.h>
+#include <algorithm>
+#include <functional>
+#include <fstream>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
 #include "vlanmgr.h"
-#include "exec.h"
 #include "tokenize.h"
 #include "shellcmd.h"
 #include "warm_restart.h"
@@ -15,7 +17,9 @@ using namespace swss;
 #define DOT1Q_BRIDGE_NAME   "Bridge"
 #define VLAN_PREFIX         "Vlan"
 #define LAG_PREFIX          "PortChannel"
-#define DEFAULT_VLAN_ID     "1"
+#define DUMMY_NAME          "dummy"
+#define DEFAULT_VLAN_ID     1
+#define DEFAULT_MTU         9100
 #define DEFAULT_MTU_STR     "9100"
 #define VLAN_HLEN            4
 
@@ -61,77 +65,56 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
             WarmStart::setWarmStartState("vlanmgrd", WarmStart::RECONCILED);
             SWSS_LOG_NOTICE("vlanmgr warmstart state set to RECONCILED");
         }
-        const std::string cmds = std::string("")
-          + IP_CMD + " link show " + DOT1Q_BRIDGE_NAME + " 2>/dev/null";
-
-        std::string res;
-        int ret = swss::exec(cmds, res);
-        if (ret == 0)
+        if (m_rtnl.linkExists(DOT1Q_BRIDGE_NAME))
         {
             // Don't reset vlan aware bridge upon swss docker warm restart.
             SWSS_LOG_INFO("vlanmgrd warm start, skipping bridge create");
             return;
         }
     }
-    // Initialize Linux dot1q bridge and enable vlan filtering
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link del Bridge 2>/dev/null ;
-    //               /sbin/ip link add Bridge up type bridge &&
-    //               /sbin/ip link set Bridge mtu {{ mtu_size }} &&
-    //               /sbin/ip link set Bridge address {{gMacAddress}} &&
-    //               /sbin/bridge vlan del vid 1 dev Bridge self;
-    //               /sbin/ip link del dummy 2>/dev/null;
-    //               /sbin/ip link add dummy type dummy &&
-    //               /sbin/ip link set dummy master Bridge &&
-    //               /sbin/ip link set dummy up"
-
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + IP_CMD + " link del " + DOT1Q_BRIDGE_NAME + " 2>/dev/null; "
-      + IP_CMD + " link add " + DOT1Q_BRIDGE_NAME + " up type bridge && "
-      + IP_CMD + " link set " + DOT1Q_BRIDGE_NAME + " mtu " + DEFAULT_MTU_STR + " && "
-      + IP_CMD + " link set " + DOT1Q_BRIDGE_NAME + " address " + gMacAddress.to_string() + " && "
-      + BRIDGE_CMD + " vlan del vid " + DEFAULT_VLAN_ID + " dev " + DOT1Q_BRIDGE_NAME + " self; "
-      + IP_CMD + " link del dev dummy 2>/dev/null; "
-      + IP_CMD + " link add dummy type dummy && "
-      + IP_CMD + " link set dummy master " + DOT1Q_BRIDGE_NAME + " && "
-      + IP_CMD + " link set dummy up" + "\"";
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    // Initialize Linux dot1q bridge and enable vlan filtering, the same as:
+    // /sbin/ip link del Bridge 2>/dev/null ;
+    // /sbin/ip link add Bridge up type bridge &&
+    // /sbin/ip link set Bridge mtu {{ mtu_size }} &&
+    // /sbin/ip link set Bridge address {{gMacAddress}} &&
+    // /sbin/bridge vlan del vid 1 dev Bridge self;
+    // /sbin/ip link del dummy 2>/dev/null;
+    // /sbin/ip link add dummy type dummy &&
+    // /sbin/ip link set dummy master Bridge &&
+    // /sbin/ip link set dummy up
+    m_rtnl.delLink(DOT1Q_BRIDGE_NAME);
+    RTNL_WITH_ERROR_THROW(m_rtnl.addBridge(DOT1Q_BRIDGE_NAME, true), "add bridge " DOT1Q_BRIDGE_NAME);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMtu(DOT1Q_BRIDGE_NAME, DEFAULT_MTU), "set " DOT1Q_BRIDGE_NAME " mtu");
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMac(DOT1Q_BRIDGE_NAME, gMacAddress), "set " DOT1Q_BRIDGE_NAME " address");
+    m_rtnl.delBridgeVlan(DOT1Q_BRIDGE_NAME, DEFAULT_VLAN_ID, true);
+    m_rtnl.delLink(DUMMY_NAME);
+    RTNL_WITH_ERROR_THROW(m_rtnl.addDummy(DUMMY_NAME), "add dummy " DUMMY_NAME);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMaster(DUMMY_NAME, DOT1Q_BRIDGE_NAME), "set " DUMMY_NAME " master " DOT1Q_BRIDGE_NAME);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkAdminState(DUMMY_NAME, true), "set " DUMMY_NAME " up");
 
     // /sbin/ip link set Bridge type bridge vlan_filtering 1
-    const std::string vlan_filtering_cmd = std::string(IP_CMD) + " link set " + DOT1Q_BRIDGE_NAME + " type bridge vlan_filtering 1";
-    EXEC_WITH_ERROR_THROW(vlan_filtering_cmd, res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setBridgeVlanFiltering(DOT1Q_BRIDGE_NAME, true), "set " DOT1Q_BRIDGE_NAME " vlan_filtering 1");
 
     // /sbin/ip link set Bridge type bridge no_linklocal_learn 1
-    const std::string no_ll_learn_cmd = std::string(IP_CMD) + " link set " + DOT1Q_BRIDGE_NAME + " type bridge no_linklocal_learn 1";
-    EXEC_WITH_ERROR_THROW(no_ll_learn_cmd, res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setBridgeNoLinkLocalLearn(DOT1Q_BRIDGE_NAME, true), "set " DOT1Q_BRIDGE_NAME " no_linklocal_learn 1");
 }
 
 bool VlanMgr::addHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
-    //               /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + BRIDGE_CMD + " vlan add vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self && "
-      + IP_CMD + " link add link " + DOT1Q_BRIDGE_NAME
-               + " up"
-               + " name " + VLAN_PREFIX + std::to_string(vlan_id)
-               + " address " + gMacAddress.to_string()
-               + " type vlan id " + std::to_string(vlan_id) + "\"";
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
-
-    res.clear();
-    const std::string echo_cmd = std::string("")
-      + ECHO_CMD + " 0 > /proc/sys/net/ipv4/conf/" + VLAN_PREFIX + std::to_string(vlan_id) + "/arp_evict_nocarrier";
-    swss::exec(echo_cmd, res);
+    // The same as:
+    // /sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
+    // /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
+
+    RTNL_WITH_ERROR_THROW(m_rtnl.addBridgeVlan(DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), false, true),
+                          "add vid " + std::to_string(vlan_id) + " to " DOT1Q_BRIDGE_NAME);
+    RTNL_WITH_ERROR_THROW(m_rtnl.addVlan(vlan_alias, DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), gMacAddress, true),
+                          "add " + vlan_alias);
+
+    std::ofstream arp_evict("/proc/sys/net/ipv4/conf/" + vlan_alias + "/arp_evict_nocarrier");
+    arp_evict << "0" << std::endl;
 
     return true;
 }
@@ -140,16 +123,14 @@ bool VlanMgr::removeHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link del Vlan{{vlan_id}} &&
-    //               /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + IP_CMD + " link del " + VLAN_PREFIX + std::to_string(vlan_id) + " && "
-      + BRIDGE_CMD + " vlan del vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self\"";
+    // The same as:
+    // /sbin/ip link del Vlan{{vlan_id}} &&
+    // /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.delLink(vlan_alias), "del " + vlan_alias);
+    RTNL_WITH_ERROR_THROW(m_rtnl.delBridgeVlan(DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), true),
+                          "del vid " + std::to_string(vlan_id) + " from " DOT1Q_BRIDGE_NAME);
 
     return true;
 }
@@ -158,13 +139,11 @@ bool VlanMgr::setHostVlanAdminState(int vlan_id, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
     // /sbin/ip link set Vlan{{vlan_id}} {{admin_status}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " " << shellquote(admin_status);
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkAdminState(vlan_alias, admin_status == "up"),
+                          "set " + vlan_alias + " " + admin_status);
 
     return true;
 }
@@ -173,14 +152,8 @@ bool VlanMgr::setHostVlanMtu(int vlan_id, uint32_t mtu)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
     // /sbin/ip link set Vlan{{vlan_id}} mtu {{mtu}}
-    const std::string cmds = std::string("")
-      + IP_CMD + " link set " + VLAN_PREFIX + std::to_string(vlan_id) + " mtu " + std::to_string(mtu);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-    if (ret == 0)
+    if (m_rtnl.setLinkMtu(VLAN_PREFIX + std::to_string(vlan_id), mtu) == 0)
     {
         return true;
     }
@@ -193,14 +166,13 @@ bool VlanMgr::setHostVlanMac(int vlan_id, const string &mac)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /sbin/ip link set Vlan{{vlan_id}} address {{mac}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " address " << shellquote(mac) << " && "
-            IP_CMD " link set " DOT1Q_BRIDGE_NAME " address " << shellquote(mac);
+    // /sbin/ip link set Vlan{{vlan_id}} address {{mac}} &&
+    // /sbin/ip link set Bridge address {{mac}}
+    const std::string vlan_alias = VLAN_PREFIX + std::to_string(vlan_id);
+    MacAddress mac_address(mac);
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMac(vlan_alias, mac_address), "set " + vlan_alias + " address " + mac);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkMac(DOT1Q_BRIDGE_NAME, mac_address), "set " DOT1Q_BRIDGE_NAME " address " + mac);
 
     return true;
 }
@@ -209,39 +181,36 @@ bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const str
 {
     SWSS_LOG_ENTER();
 
-    std::string tagging_cmd;
-    if (tagging_mode == "untagged" || tagging_mode == "priority_tagged")
-    {
-        tagging_cmd = "pvid untagged";
-    }
+    bool pvid_untagged = tagging_mode == "untagged" || tagging_mode == "priority_tagged";
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link set {{port_alias}} master Bridge &&
-    //               /sbin/bridge vlan del vid 1 dev {{ port_alias }} &&
-    //               /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}"
-    ostringstream cmds, inner;
-    inner << IP_CMD " link set " << shellquote(port_alias) << " master " DOT1Q_BRIDGE_NAME " && "
-      BRIDGE_CMD " vlan del vid " DEFAULT_VLAN_ID " dev " << shellquote(port_alias) << " && "
-      BRIDGE_CMD " vlan add vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " " + tagging_cmd;
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+    // The same as:
+    // /sbin/ip link set {{port_alias}} master Bridge &&
+    // /sbin/bridge vlan del vid 1 dev {{ port_alias }} &&
+    // /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}
+    auto add_member = [&]() {
+        int err = m_rtnl.setLinkMaster(port_alias, DOT1Q_BRIDGE_NAME);
+        if (!err)
+        {
+            err = m_rtnl.delBridgeVlan(port_alias, DEFAULT_VLAN_ID);
+        }
+        if (!err)
+        {
+            err = m_rtnl.addBridgeVlan(port_alias, static_cast<uint16_t>(vlan_id), pvid_untagged);
+        }
+        return err;
+    };
 
-    std::string res;
-    try
-    {
-        EXEC_WITH_ERROR_THROW(cmds.str(), res);
-    }
-    catch (const std::runtime_error& e)
+    int err = add_member();
+    if (err)
     {
         // Race conidtion can happen with portchannel removal might happen
-	// but state db is not updated yet so we can do retry instead of sending exception
-	if (!port_alias.compare(0, strlen(LAG_PREFIX), LAG_PREFIX))
-	{
+        // but state db is not updated yet so we can do retry instead of sending exception
+        if (!port_alias.compare(0, strlen(LAG_PREFIX), LAG_PREFIX))
+        {
             return false;
-	}
-        else
-	{
-            EXEC_WITH_ERROR_THROW(cmds.str(), res);
-	}
+        }
+
+        RTNL_WITH_ERROR_THROW(add_member(), "add " + port_alias + " to vid " + std::to_string(vlan_id));
     }
 
     return true;
@@ -251,38 +220,30 @@ bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c '/sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}} &&
-    //               ( vlanShow=$(/sbin/bridge vlan show dev {{port_alias}});
-    //               ret=$?;
-    //               if [ $ret -eq 0 ]; then
-    //               if (! echo "$vlanShow" | grep -q {{port_alias}})
-    //                 || (echo "$vlanShow" | grep -q None$)
-    //                 || (echo "$vlanShow" | grep -q {{port_alias}}$); then
-    //               /sbin/ip link set {{port_alias}} nomaster;
-    //               fi;
-    //               else exit $ret; fi )'
+    // The same as:
+    // /sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}}
+    // and /sbin/ip link set {{port_alias}} nomaster when no VLAN is left on the port.
+    RTNL_WITH_ERROR_THROW(m_rtnl.delBridgeVlan(port_alias, static_cast<uint16_t>(vlan_id)),
+                          "del " + port_alias + " from vid " + std::to_string(vlan_id));
 
-    // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
-    ostringstream cmds, inner;
-    inner << BRIDGE_CMD " vlan del vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " && ( "
-      "vlanShow=$(" BRIDGE_CMD " vlan show dev " << shellquote(port_alias) << "); "
-      "ret=$?; "
-      "if [ $ret -eq 0 ]; then "
-      "if (! echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << ") "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q None$) "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << "$); then "
-      IP_CMD " link set " << shellquote(port_alias) << " nomaster; "
-      "fi; "
-      "else exit $ret; fi )";
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    detachHostVlanMemberPort(port_alias);
 
     return true;
 }
 
+void VlanMgr::detachHostVlanMemberPort(const string &port_alias)
+{
+    SWSS_LOG_ENTER();
+
+    // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
+    vector<uint16_t> vlans;
+    RTNL_WITH_ERROR_THROW(m_rtnl.getBridgeVlans(port_alias, vlans), "show vlans of " + port_alias);
+    if (vlans.empty())
+    {
+        m_rtnl.setLinkMaster(port_alias, "");
+    }
+}
+
 bool VlanMgr::isVlanMacOk()
 {
     return !!gMacAddress;
@@ -602,6 +563,12 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
         vlan_alias = VLAN_PREFIX + to_string(vlan_id);
         string op = kfvOp(t);
 
+        /* A second task of a member waits for the first one to be applied */
+        if (m_vlanMemberPendingKeys.count(kfvKey(t)))
+        {
+            applyVlanMembers(consumer);
+        }
+
        // TODO:  store port/lag/VLAN data in local data structure and perform more validations.
         if (op == SET_COMMAND)
         {
@@ -639,39 +606,20 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (addHostVlanMember(vlan_id, port_alias, tagging_mode))
-            {
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
-
-                vector<FieldValueTuple> fvVector;
-                FieldValueTuple s("state", "ok");
-                fvVector.push_back(s);
-                m_stateVlanMemberTable.set(kfvKey(t), fvVector);
-
-                m_vlanMemberReplay.erase(kfvKey(t));
-                m_PortVlanMember[port_alias][vlan_alias] = tagging_mode;
-            }
-            else
-            {
-                SWSS_LOG_INFO("Netdevice for  %s not ready, delaying", kfvKey(t).c_str());
-                it++;
-                continue;
-            }
+            /* Applied with the other members of the port by applyVlanMembers() */
+            m_vlanMemberAdds[port_alias].push_back({it, vlan_id, tagging_mode});
+            m_vlanMemberPendingKeys.insert(kfvKey(t));
+            it++;
+            continue;
         }
         else if (op == DEL_COMMAND)
         {
             if (isVlanMemberStateOk(kfvKey(t)))
             {
-                removeHostVlanMember(vlan_id, port_alias);
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.del(key);
-                m_stateVlanMemberTable.del(kfvKey(t));
-                m_PortVlanMember[port_alias].erase(vlan_alias);
+                m_vlanMemberRemoves[port_alias].push_back({it, vlan_id, ""});
+                m_vlanMemberPendingKeys.insert(kfvKey(t));
+                it++;
+                continue;
             }
             else
             {
@@ -686,6 +634,9 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
         /* Other than the case of member port/lag is not ready, no retry will be performed */
         it = consumer.m_toSync.erase(it);
     }
+
+    applyVlanMembers(consumer);
+
     if (!replayDone && m_vlanMemberReplay.empty() &&
         WarmStart::isWarmStart())
     {
@@ -698,6 +649,193 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
     }
 }
 
+void VlanMgr::setVlanMemberState(const KeyOpFieldsValuesTuple &t, int vlan_id, const string &port_alias,
+                                 const string &tagging_mode)
+{
+    string vlan_alias = VLAN_PREFIX + to_string(vlan_id);
+    string key = vlan_alias + DEFAULT_KEY_SEPARATOR + port_alias;
+    m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
+
+    vector<FieldValueTuple> fvVector;
+    FieldValueTuple s("state", "ok");
+    fvVector.push_back(s);
+    m_stateVlanMemberTable.set(kfvKey(t), fvVector);
+
+    m_vlanMemberReplay.erase(kfvKey(t));
+    m_PortVlanMember[port_alias][vlan_alias] = tagging_mode;
+}
+
+void VlanMgr::delVlanMemberState(const KeyOpFieldsValuesTuple &t, int vlan_id, const string &port_alias)
+{
+    string vlan_alias = VLAN_PREFIX + to_string(vlan_id);
+    string key = vlan_alias + DEFAULT_KEY_SEPARATOR + port_alias;
+    m_appVlanMemberTableProducer.del(key);
+    m_stateVlanMemberTable.del(kfvKey(t));
+    m_PortVlanMember[port_alias].erase(vlan_alias);
+}
+
+/*
+ * Apply the pending VLAN member changes. Each port gets one request for its
+ * added VLANs and one for its removed VLANs, where contiguous tagged VLANs
+ * are sent as ranges, and the requests of all the ports are sent as a single
+ * batch. When the request of a port fails, its members are retried one by
+ * one so that each member gets its own result, as before batching.
+ */
+void VlanMgr::applyVlanMembers(Consumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_vlanMemberPendingKeys.empty())
+    {
+        return;
+    }
+
+    map<string, PortVlanRequest> adds, removes;
+    for (auto &port : m_vlanMemberAdds)
+    {
+        adds[port.first].members.swap(port.second);
+    }
+    for (auto &port : m_vlanMemberRemoves)
+    {
+        removes[port.first].members.swap(port.second);
+    }
+    m_vlanMemberAdds.clear();
+    m_vlanMemberRemoves.clear();
+    m_vlanMemberPendingKeys.clear();
+
+    auto toRanges = [](const vector<PendingVlanMember> &members, bool add) {
+        vector<RtnlClient::BridgeVlanRange> ranges, untagged;
+        vector<uint16_t> tagged;
+        for (const auto &member : members)
+        {
+            uint16_t vid = static_cast<uint16_t>(member.vlan_id);
+            if (add && member.tagging_mode != "tagged")
+            {
+                /* Kept in task order, the last untagged VLAN is the PVID */
+                untagged.push_back({vid, 0, true});
+            }
+            else
+            {
+                tagged.push_back(vid);
+            }
+        }
+
+        sort(tagged.begin(), tagged.end());
+        for (auto vid : tagged)
+        {
+            if (!ranges.empty() && ranges.back().lastVlanId + 1 == vid)
+            {
+                ranges.back().lastVlanId = vid;
+            }
+            else
+            {
+                ranges.push_back({vid, vid, false});
+            }
+        }
+        ranges.insert(ranges.end(), untagged.begin(), untagged.end());
+        return ranges;
+    };
+
+    /* Queue the requests of a port and remember where their results are */
+    auto queueRequests = [this](PortVlanRequest &request, const function<void()> &send) {
+        request.firstResult = m_rtnl.getBatchResults().size();
+        send();
+        request.resultCount = m_rtnl.getBatchResults().size() - request.firstResult;
+    };
+
+    // The same as, for each port:
+    // /sbin/ip link set {{port_alias}} master Bridge &&
+    // /sbin/bridge vlan del vid 1 dev {{port_alias}} &&
+    // /sbin/bridge vlan add vid {{first_vlan_id}}-{{last_vlan_id}} dev {{port_alias}} ...
+    // /sbin/bridge vlan del vid {{first_vlan_id}}-{{last_vlan_id}} dev {{port_alias}} ...
+    m_rtnl.beginBatch();
+    for (auto &port : adds)
+    {
+        const string &port_alias = port.first;
+        const auto ranges = toRanges(port.second.members, true);
+        queueRequests(port.second, [&]() {
+            m_rtnl.setLinkMaster(port_alias, DOT1Q_BRIDGE_NAME);
+            m_rtnl.delBridgeVlan(port_alias, DEFAULT_VLAN_ID);
+            m_rtnl.addBridgeVlans(port_alias, ranges);
+        });
+    }
+    for (auto &port : removes)
+    {
+        const string &port_alias = port.first;
+        const auto ranges = toRanges(port.second.members, false);
+        queueRequests(port.second, [&]() {
+            m_rtnl.delBridgeVlans(port_alias, ranges);
+        });
+    }
+    m_rtnl.commitBatch();
+
+    /* The result of a port is the first failure of its requests */
+    const vector<int> &results = m_rtnl.getBatchResults();
+    for (auto *requests : {&adds, &removes})
+    {
+        for (auto &port : *requests)
+        {
+            auto &request = port.second;
+            for (size_t i = 0; i < request.resultCount && !request.err; i++)
+            {
+                request.err = results[request.firstResult + i];
+            }
+        }
+    }
+
+    for (const auto &port : adds)
+    {
+        const string &port_alias = port.first;
+        int err = port.second.err;
+        if (err)
+        {
+            SWSS_LOG_INFO("Failed to add %zu VLANs to %s: %s, adding them one by one",
+                          port.second.members.size(), port_alias.c_str(), RtnlClient::errorString(err).c_str());
+        }
+
+        for (const auto &member : port.second.members)
+        {
+            const auto &t = member.task->second;
+            if (!err || addHostVlanMember(member.vlan_id, port_alias, member.tagging_mode))
+            {
+                setVlanMemberState(t, member.vlan_id, port_alias, member.tagging_mode);
+                consumer.m_toSync.erase(member.task);
+            }
+            else
+            {
+                SWSS_LOG_INFO("Netdevice for  %s not ready, delaying", kfvKey(t).c_str());
+            }
+        }
+    }
+
+    for (const auto &port : removes)
+    {
+        const string &port_alias = port.first;
+        int err = port.second.err;
+        if (err)
+        {
+            SWSS_LOG_INFO("Failed to remove %zu VLANs from %s: %s, removing them one by one",
+                          port.second.members.size(), port_alias.c_str(), RtnlClient::errorString(err).c_str());
+        }
+        else
+        {
+            detachHostVlanMemberPort(port_alias);
+        }
+
+        for (const auto &member : port.second.members)
+        {
+            const auto &t = member.task->second;
+            if (err)
+            {
+                removeHostVlanMember(member.vlan_id, port_alias);
+            }
+            delVlanMemberState(t, member.vlan_id, port_alias);
+            SWSS_LOG_DEBUG("%s", (consumer.dumpTuple(t)).c_str());
+            consumer.m_toSync.erase(member.task);
+        }
+    }
+}
+
 void VlanMgr::doVlanPacPortTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
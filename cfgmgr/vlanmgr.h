@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "rtnlclient.h"
 
 #include <set>
 #include <map>
@@ -29,6 +30,26 @@ private:
     std::set<std::string> m_vlanMemberReplay;
     bool replayDone;
     std::unordered_map<std::string, std::unordered_map<std::string, std::string>> m_PortVlanMember;
+    RtnlClient m_rtnl;
+
+    /* A VLAN member change of the current doVlanMemberTask pass */
+    struct PendingVlanMember
+    {
+        SyncMap::iterator task;
+        int vlan_id;
+        std::string tagging_mode;
+    };
+    /* Pending member adds and removes, by port */
+    std::map<std::string, std::vector<PendingVlanMember>> m_vlanMemberAdds, m_vlanMemberRemoves;
+    /* The batched requests of a port, by the range of their results in the batch */
+    struct PortVlanRequest
+    {
+        std::vector<PendingVlanMember> members;
+        size_t firstResult = 0;
+        size_t resultCount = 0;
+        int err = 0;
+    };
+    std::set<std::string> m_vlanMemberPendingKeys;
     
     void doTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
@@ -42,6 +63,11 @@ private:
     bool setHostVlanMac(int vlan_id, const std::string &mac);
     bool addHostVlanMember(int vlan_id, const std::string &port_alias, const std::string& tagging_mode);
     bool removeHostVlanMember(int vlan_id, const std::string &port_alias);
+    void detachHostVlanMemberPort(const std::string &port_alias);
+    void applyVlanMembers(Consumer &consumer);
+    void setVlanMemberState(const KeyOpFieldsValuesTuple &t, int vlan_id, const std::string &port_alias,
+                            const std::string &tagging_mode);
+    void delVlanMemberState(const KeyOpFieldsValuesTuple &t, int vlan_id, const std::string &port_alias);
     bool isMemberStateOk(const std::string &alias);
     bool isVlanStateOk(const std::string &alias);
     bool isVlanMacOk();
@@ -31,70 +31,37 @@ VrfMgr::VrfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, con
     }
 
     /* Get existing VRFs from Linux */
-    stringstream cmd;
-    string res;
+    map<string, uint32_t> vrfs;
+    RTNL_WITH_ERROR_THROW(m_rtnl.getVrfs(vrfs), "show vrf devices");
 
-    cmd << IP_CMD << " -d link show type vrf";
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
-
-    enum IpShowRowType
-    {
-        LINK_ROW,
-        MAC_ROW,
-        DETAILS_ROW,
-    };
-
-    string vrfName;
-    uint32_t table;
-    IpShowRowType rowType = LINK_ROW;
-    const auto& rows = tokenize(res, '\n');
-    for (const auto& row : rows)
+    for (const auto& vrf : vrfs)
     {
-        const auto& items = tokenize(row, ' ');
-        switch(rowType)
+        const string& vrfName = vrf.first;
+        if (WarmStart::isWarmStart())
         {
-            case LINK_ROW:
-                vrfName = items[1];
-                vrfName.pop_back();
-                rowType = MAC_ROW;
-                break;
-            case MAC_ROW:
-                rowType = DETAILS_ROW;
-                break;
-            case DETAILS_ROW:
-                if (WarmStart::isWarmStart())
-                {
-                    table = static_cast<uint32_t>(stoul(items[6]));
-                    m_vrfTableMap[vrfName] = table;
-                    m_freeTables.erase(table);
-                }
-                else
-                {
-                    // No deletion of mgmt table from kernel
-                    if (vrfName.compare("mgmt") == 0)
-                    { 
-                        SWSS_LOG_NOTICE("Skipping remove vrf device %s", vrfName.c_str());
-                        rowType = LINK_ROW;
-                        break;
-                    }
+            m_vrfTableMap[vrfName] = vrf.second;
+            m_freeTables.erase(vrf.second);
+            continue;
+        }
 
-                    SWSS_LOG_NOTICE("Remove vrf device %s", vrfName.c_str());
-                    cmd.str("");
-                    cmd.clear();
-                    cmd << IP_CMD << " link del " << vrfName;
-                    int ret = swss::exec(cmd.str(), res);
-                    if (ret)
-                    {
-                        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
-                    }
-                }
-                rowType = LINK_ROW;
-                break;
+        // No deletion of mgmt table from kernel
+        if (vrfName.compare("mgmt") == 0)
+        {
+            SWSS_LOG_NOTICE("Skipping remove vrf device %s", vrfName.c_str());
+            continue;
+        }
+
+        SWSS_LOG_NOTICE("Remove vrf device %s", vrfName.c_str());
+        int err = m_rtnl.delLink(vrfName);
+        if (err)
+        {
+            SWSS_LOG_ERROR("Failed to remove vrf device %s: %s", vrfName.c_str(), RtnlClient::errorString(err).c_str());
         }
     }
 
-    cmd.str("");
-    cmd.clear();
+    stringstream cmd;
+    string res;
+
     cmd << IP_CMD << " rule | grep '^0:'";
     if (swss::exec(cmd.str(), res) == 0)
     {
@@ -137,9 +104,6 @@ bool VrfMgr::delLink(const string& vrfName)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
     if (m_vrfTableMap.find(vrfName) == m_vrfTableMap.end())
     {
         return false;
@@ -152,8 +116,7 @@ bool VrfMgr::delLink(const string& vrfName)
         return true;
     }
 
-    cmd << IP_CMD << " link del " << shellquote(vrfName);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.delLink(vrfName), "del vrf " + vrfName);
 
     recycleTable(m_vrfTableMap[vrfName]);
     m_vrfTableMap.erase(vrfName);
@@ -165,9 +128,6 @@ bool VrfMgr::setLink(const string& vrfName)
 {
     SWSS_LOG_ENTER();
 
-    stringstream cmd;
-    string res;
-
     if (m_vrfTableMap.find(vrfName) != m_vrfTableMap.end())
     {
         return true;
@@ -188,15 +148,11 @@ bool VrfMgr::setLink(const string& vrfName)
         return false;
     }
 
-    cmd << IP_CMD << " link add " << shellquote(vrfName) << " type vrf table " << table;
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.addVrf(vrfName, table), "add vrf " + vrfName + " table " + to_string(table));
 
     m_vrfTableMap.emplace(vrfName, table);
 
-    cmd.str("");
-    cmd.clear();
-    cmd << IP_CMD << " link set " << shellquote(vrfName) << " up";
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    RTNL_WITH_ERROR_THROW(m_rtnl.setLinkAdminState(vrfName, true), "set vrf " + vrfName + " up");
 
     return true;
 }
@@ -1,6 +1,6 @@
+#include <errno.h>
 #include <unistd.h>
 #include <algorithm>
-#include <regex>
 #include <sstream>
 #include <string>
 #include <net/if.h>
@@ -9,7 +9,6 @@
 #include "producerstatetable.h"
 #include "macaddress.h"
 #include "vxlanmgr.h"
-#include "exec.h"
 #include "tokenize.h"
 #include "shellcmd.h"
 #include "warm_restart.h"
@@ -50,132 +49,95 @@ static std::string getVxlanIfName(const swss::VxlanMgr::VxlanInfo & info)
 // Commands
 
 #define RET_SUCCESS 0
+#define VXLAN_DST_PORT 4789
 
-static int cmdCreateVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdCreateVxlan(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link add {{VXLAN}} type vxlan id {{VNI}} [local {{SOURCE IP}}] dstport 4789
-    ostringstream cmd;
-    cmd << IP_CMD " link add "
-        << shellquote(info.m_vxlan)
-        << " type vxlan id "
-        << shellquote(info.m_vni)
-        << " ";
-    if (!info.m_sourceIp.empty())
-    {
-        cmd << " local " << shellquote(info.m_sourceIp);
-    }
-    cmd << " dstport 4789";
-    return swss::exec(cmd.str(), res);
+    try
+    {
+        uint32_t vni = static_cast<uint32_t>(stoul(info.m_vni));
+        if (info.m_sourceIp.empty())
+        {
+            return rtnl.addVxlan(info.m_vxlan, vni, nullptr, nullptr, VXLAN_DST_PORT, true);
+        }
+        IpAddress srcIp(info.m_sourceIp);
+        return rtnl.addVxlan(info.m_vxlan, vni, &srcIp, nullptr, VXLAN_DST_PORT, true);
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_ERROR("Invalid vxlan %s vni %s or source ip %s: %s", info.m_vxlan.c_str(),
+                       info.m_vni.c_str(), info.m_sourceIp.c_str(), e.what());
+        return -EINVAL;
+    }
 }
 
-static int cmdUpVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdUpVxlan(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlan)
-        << " up";
-    return swss::exec(cmd.str(), res);
+    return rtnl.setLinkAdminState(info.m_vxlan, true);
 }
 
-static int cmdCreateVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdCreateVxlanIf(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link add {{VXLAN_IF}} type bridge
-    ostringstream cmd;
-    cmd << IP_CMD " link add "
-        << shellquote(info.m_vxlanIf)
-        << " type bridge";
-    return swss::exec(cmd.str(), res);
+    return rtnl.addBridge(info.m_vxlanIf, false);
 }
 
-static int cmdAddVxlanIntoVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdAddVxlanIntoVxlanIf(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // brctl addif {{VXLAN_IF}} {{VXLAN}}
-    ostringstream cmd;
-    cmd << BRCTL_CMD " addif "
-        << shellquote(info.m_vxlanIf)
-        << " "
-        << shellquote(info.m_vxlan);
-    if (!info.m_macAddress.empty())
+    int ret = rtnl.setLinkMaster(info.m_vxlan, info.m_vxlanIf);
+    if (ret == RET_SUCCESS && !info.m_macAddress.empty())
     {
         // Change the MAC address of Vxlan bridge interface to ensure it's same with switch's.
         // Otherwise it will not response traceroute packets.
         // ip link set dev {{VXLAN_IF}} address {{MAC_ADDRESS}}
-        cmd << " && " IP_CMD " link set dev "
-            << shellquote(info.m_vxlanIf)
-            << " address "
-            << shellquote(info.m_macAddress);
+        ret = rtnl.setLinkMac(info.m_vxlanIf, MacAddress(info.m_macAddress));
     }
-    return swss::exec(cmd.str(), res);
+    return ret;
 }
 
-static int cmdAttachVxlanIfToVnet(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdAttachVxlanIfToVnet(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} master {{VNET}}
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " master "
-        << shellquote(info.m_vnet);
-    return swss::exec(cmd.str(), res);
+    return rtnl.setLinkMaster(info.m_vxlanIf, info.m_vnet);
 }
 
-static int cmdUpVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdUpVxlanIf(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " up";
-    return swss::exec(cmd.str(), res);
+    return rtnl.setLinkAdminState(info.m_vxlanIf, true);
 }
 
-static int cmdDeleteVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDeleteVxlan(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link del dev {{VXLAN}}
-    ostringstream cmd;
-    cmd << IP_CMD " link del dev "
-        << shellquote(info.m_vxlan);
-    return swss::exec(cmd.str(), res);
+    return rtnl.delLink(info.m_vxlan);
 }
 
-static int cmdVxlanLearningOff(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdVxlanLearningOff(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // bridge link set dev {{VXLAN}} learning off
-    ostringstream cmd;
-    cmd << BRIDGE_CMD << " link set dev "
-        << shellquote(info.m_vxlan) << " learning off";
-    return swss::exec(cmd.str(), res);
+    return rtnl.setBridgePortLearning(info.m_vxlan, false);
 }
 
-static int cmdDeleteVxlanFromVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDeleteVxlanFromVxlanIf(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // brctl delif {{VXLAN_IF}} {{VXLAN}}
-    ostringstream cmd;
-    cmd << BRCTL_CMD " delif "
-        << shellquote(info.m_vxlanIf)
-        << " " 
-        << shellquote(info.m_vxlan);
-    return swss::exec(cmd.str(), res);
+    return rtnl.setLinkMaster(info.m_vxlan, "");
 }
 
-static int cmdDeleteVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDeleteVxlanIf(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link del {{VXLAN_IF}}
-    ostringstream cmd;
-    cmd << IP_CMD " link del "
-        << shellquote(info.m_vxlanIf);
-    return swss::exec(cmd.str(), res);
+    return rtnl.delLink(info.m_vxlanIf);
 }
 
-static int cmdDetachVxlanIfFromVnet(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static int cmdDetachVxlanIfFromVnet(RtnlClient & rtnl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} nomaster
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " nomaster";
-    return swss::exec(cmd.str(), res);
+    return rtnl.setLinkMaster(info.m_vxlanIf, "");
 }
 
 // Vxlanmgr
@@ -808,11 +770,10 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
 {
     SWSS_LOG_ENTER();
     
-    std::string res;
     int ret = 0;
 
     // Create Vxlan
-    ret = cmdCreateVxlan(info, res);
+    ret = cmdCreateVxlan(m_rtnl, info);
     if (ret != RET_SUCCESS)
     {
         SWSS_LOG_WARN(
@@ -824,10 +785,10 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Up Vxlan
-    ret = cmdUpVxlan(info, res);
+    ret = cmdUpVxlan(m_rtnl, info);
     if (ret != RET_SUCCESS)
     {
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlan(m_rtnl, info);
         SWSS_LOG_WARN(
             "Fail to up vxlan %s",
             info.m_vxlan.c_str());
@@ -835,10 +796,10 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Create Vxlan Interface
-    ret = cmdCreateVxlanIf(info, res);
+    ret = cmdCreateVxlanIf(m_rtnl, info);
     if (ret != RET_SUCCESS)
     {
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlan(m_rtnl, info);
         SWSS_LOG_WARN(
             "Fail to create vxlan interface %s",
             info.m_vxlanIf.c_str());
@@ -846,11 +807,11 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Add vxlan into vxlan interface
-    ret = cmdAddVxlanIntoVxlanIf(info, res);
+    ret = cmdAddVxlanIntoVxlanIf(m_rtnl, info);
     if ( ret != RET_SUCCESS )
     {
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlanIf(m_rtnl, info);
+        cmdDeleteVxlan(m_rtnl, info);
         SWSS_LOG_WARN(
             "Fail to add %s into %s",
             info.m_vxlan.c_str(),
@@ -859,12 +820,12 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Attach vxlan interface to vnet
-    ret = cmdAttachVxlanIfToVnet(info, res);
+    ret = cmdAttachVxlanIfToVnet(m_rtnl, info);
     if ( ret != RET_SUCCESS )
     {
-        cmdDeleteVxlanFromVxlanIf(info, res);
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
+        cmdDeleteVxlanFromVxlanIf(m_rtnl, info);
+        cmdDeleteVxlanIf(m_rtnl, info);
+        cmdDeleteVxlan(m_rtnl, info);
         SWSS_LOG_WARN(
             "Fail to set %s master %s",
             info.m_vxlanIf.c_str(),
@@ -874,13 +835,13 @@ bool VxlanMgr::createVxlan(const VxlanInfo & info)
     }
 
     // Up Vxlan Interface
-    ret = cmdUpVxlanIf(info, res);
+    ret = cmdUpVxlanIf(m_rtnl, info);
     if ( ret != RET_SUCCESS )
     {
-        cmdDetachVxlanIfFromVnet(info, res);
-        cmdDeleteVxlanFromVxlanIf(info, res);
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
+        cmdDetachVxlanIfFromVnet(m_rtnl, info);
+        cmdDeleteVxlanFromVxlanIf(m_rtnl, info);
+        cmdDeleteVxlanIf(m_rtnl, info);
+        cmdDeleteVxlan(m_rtnl, info);
         SWSS_LOG_WARN(
             "Fail to up bridge %s",
             info.m_vxlanIf.c_str());
@@ -898,12 +859,10 @@ bool VxlanMgr::deleteVxlan(const VxlanInfo & info)
 {
     SWSS_LOG_ENTER();
 
-    std::string res;
-
-    cmdDetachVxlanIfFromVnet(info, res);
-    cmdDeleteVxlanFromVxlanIf(info, res);
-    cmdDeleteVxlanIf(info, res);
-    cmdDeleteVxlan(info, res);
+    cmdDetachVxlanIfFromVnet(m_rtnl, info);
+    cmdDeleteVxlanFromVxlanIf(m_rtnl, info);
+    cmdDeleteVxlanIf(m_rtnl, info);
+    cmdDeleteVxlan(m_rtnl, info);
 
     m_stateVxlanTable.del(info.m_vxlan);
 
@@ -954,9 +913,6 @@ int VxlanMgr::createVxlanNetdevice(std::string vxlanTunnelName, std::string vni_
                                    std::string src_ip, std::string dst_ip,
                                    std::string vlan_id)
 {
-    std::string res, cmds;
-    std::string link_add_cmd, link_set_master_cmd, link_up_cmd;
-    std::string bridge_add_cmd, bridge_untagged_add_cmd, bridge_del_vid_cmd, bridge_learn_off_cmd;
     std::string vxlan_dev_name;
     bool evpn_nvo = false;
 
@@ -1000,120 +956,100 @@ int VxlanMgr::createVxlanNetdevice(std::string vxlanTunnelName, std::string vni_
         evpn_nvo = true;
     }
 
-    // ip link add <vxlan_dev_name> type vxlan id <vni> local <src_ip> remote <dst_ip> 
-    // dstport 4789
+    // ip link add <vxlan_dev_name> address <mac> type vxlan id <vni> local <src_ip> [remote <dst_ip>]
+    // nolearning dstport 4789
     // ip link set <vxlan_dev_name> master DOT1Q_BRIDGE_NAME
-    // bridge vlan add vid <vlan_id> dev <vxlan_dev_name>
     // bridge vlan add vid <vlan_id> untagged pvid dev <vxlan_dev_name>
+    // bridge vlan del vid 1 dev <vxlan_dev_name>
     // bridge link set dev <vxlan_dev_name> learning off
     // ip link set <vxlan_dev_name> up
-
-    link_add_cmd = std::string("") + IP_CMD + " link add " + vxlan_dev_name + 
-                   " address " + gMacAddress.to_string() + " type vxlan id " + 
-                   std::string(vni_id) + " local " + src_ip + 
-                   ((dst_ip  == "")? "":(" remote " + dst_ip)) + 
-                   " nolearning " + " dstport 4789 ";
-    
-    link_set_master_cmd = std::string("") + IP_CMD + " link set " + 
-                          vxlan_dev_name + " master Bridge ";
-
-    link_up_cmd = std::string("") + IP_CMD + " link set " + vxlan_dev_name + " up ";
-
-    bridge_add_cmd = std::string("") + BRIDGE_CMD + " vlan add vid " + 
-                     std::string(vlan_id) + " dev " + vxlan_dev_name;
-
-    bridge_untagged_add_cmd = std::string("") + BRIDGE_CMD + " vlan add vid " + 
-                              std::string(vlan_id) + " untagged pvid dev " + vxlan_dev_name;
-
-    bridge_del_vid_cmd = std::string("") + BRIDGE_CMD + " vlan del vid 1 dev " + 
-                         vxlan_dev_name;
-
-    bridge_learn_off_cmd = std::string("") + BRIDGE_CMD + " link set dev " +
-                           vxlan_dev_name + " learning off ";
-    
-    
-    cmds = std::string("") + BASH_CMD + " -c \"" + 
-           link_add_cmd + " && " + 
-           link_set_master_cmd + " && " + 
-           bridge_add_cmd + " && " + 
-           bridge_untagged_add_cmd + " && "; 
-        
-    if ( vlan_id != "1")
+    // Each step needs the previous one, the first failure stops the sequence.
+    uint32_t vni;
+    uint16_t vlan;
+    IpAddress srcIp, dstIp;
+    try
     {
-        cmds += bridge_del_vid_cmd + " && ";
+        vni = static_cast<uint32_t>(stoul(vni_id));
+        vlan = static_cast<uint16_t>(stoul(vlan_id));
+        srcIp = IpAddress(src_ip);
+        if (!dst_ip.empty())
+        {
+            dstIp = IpAddress(dst_ip);
+        }
     }
-
-    if (evpn_nvo)
+    catch (const std::exception &e)
     {
-        cmds += bridge_learn_off_cmd + " && ";
+        SWSS_LOG_ERROR("Invalid VxlanNetDevice %s parameters: %s", vxlan_dev_name.c_str(), e.what());
+        return -EINVAL;
     }
 
-    cmds += link_up_cmd + "\"";
+    int ret = m_rtnl.addVxlan(vxlan_dev_name, vni, &srcIp, dst_ip.empty() ? nullptr : &dstIp,
+                              VXLAN_DST_PORT, false, &gMacAddress);
+    if (ret == RET_SUCCESS)
+    {
+        ret = m_rtnl.setLinkMaster(vxlan_dev_name, "Bridge");
+    }
+    if (ret == RET_SUCCESS)
+    {
+        ret = m_rtnl.addBridgeVlan(vxlan_dev_name, vlan, true);
+    }
+    if (ret == RET_SUCCESS && vlan != 1)
+    {
+        ret = m_rtnl.delBridgeVlan(vxlan_dev_name, 1);
+    }
+    if (ret == RET_SUCCESS && evpn_nvo)
+    {
+        ret = m_rtnl.setBridgePortLearning(vxlan_dev_name, false);
+    }
+    if (ret == RET_SUCCESS)
+    {
+        ret = m_rtnl.setLinkAdminState(vxlan_dev_name, true);
+    }
+    if (ret != RET_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create VxlanNetDevice %s: %s", vxlan_dev_name.c_str(),
+                       RtnlClient::errorString(ret).c_str());
+    }
 
-    return swss::exec(cmds,res);
+    return ret;
 }
 
 int VxlanMgr::downVxlanNetdevice(std::string vxlan_dev_name)
 {
-    int ret = 0;
-    std::string res;
-    const std::string cmd = std::string("") + IP_CMD + " link set dev " + vxlan_dev_name + " down";
-    exec(cmd, res);
-    return ret;
+    // ip link set dev <vxlan_dev_name> down
+    m_rtnl.setLinkAdminState(vxlan_dev_name, false);
+    return 0;
 }
 
 int VxlanMgr::deleteVxlanNetdevice(std::string vxlan_dev_name)
 {    
-    std::string res;
-    const std::string cmd = std::string("") + IP_CMD  + " link del dev " + vxlan_dev_name;
-    return swss::exec(cmd, res);
-}
-
-std::vector<std::string> VxlanMgr::parseNetDev(const string& stdout){
-    std::vector<std::string> netdevs;
-    std::regex device_name_pattern("^\\d+:\\s+([^:]+)");
-    std::smatch match_result;
-    auto lines = tokenize(stdout, '\n');
-    for (const std::string & line : lines)
-    {
-        SWSS_LOG_DEBUG("line : %s\n",line.c_str());
-        if (!std::regex_search(line, match_result, device_name_pattern))
-        {
-            continue;
-        }
-        std::string dev_name = match_result[1];
-        netdevs.push_back(dev_name);
-    }
-    return netdevs;
+    // ip link del dev <vxlan_dev_name>
+    return m_rtnl.delLink(vxlan_dev_name);
 }
 
 void VxlanMgr::getAllVxlanNetDevices()
 {
-    std::string stdout;
+    std::vector<std::string> netdevs;
 
-    // Get VxLan Netdev Interfaces
-    std::string cmd = std::string("") + IP_CMD + " link show type vxlan";
-    int ret = swss::exec(cmd, stdout);
+    // Get VxLan Netdev Interfaces, ip link show type vxlan
+    int ret = m_rtnl.getLinks("vxlan", netdevs);
     if (ret != 0)
     {
-        SWSS_LOG_ERROR("Cannot get vxlan devices by command : %s", cmd.c_str());
-        stdout.clear();
+        SWSS_LOG_ERROR("Cannot get vxlan devices: %s", RtnlClient::errorString(ret).c_str());
+        netdevs.clear();
     }
-    std::vector<std::string> netdevs = parseNetDev(stdout);
     for (auto netdev : netdevs)
     {
         m_vxlanNetDevices[netdev] = VXLAN;
     }
 
-    // Get VxLanIf Netdev Interfaces
-    cmd = std::string("") + IP_CMD + " link show type bridge";
-    ret = swss::exec(cmd, stdout);
+    // Get VxLanIf Netdev Interfaces, ip link show type bridge
+    ret = m_rtnl.getLinks("bridge", netdevs);
     if (ret != 0)
     {
-        SWSS_LOG_ERROR("Cannot get vxlanIf devices by command : %s", cmd.c_str());
-        stdout.clear();
+        SWSS_LOG_ERROR("Cannot get vxlanIf devices: %s", RtnlClient::errorString(ret).c_str());
+        netdevs.clear();
     }
-    netdevs = parseNetDev(stdout);
     for (auto netdev : netdevs)
     {
         if (netdev.find(VXLAN_IF_NAME_PREFIX) == 0)
@@ -1222,17 +1158,16 @@ void VxlanMgr::clearAllVxlanDevices()
         std::string netdev_type = it->second;
         SWSS_LOG_INFO("Deleting Stale NetDevice %s, type: %s\n", netdev_name.c_str(), netdev_type.c_str());
         VxlanInfo info;
-        std::string res;
         if (netdev_type.compare(VXLAN))
         {
             info.m_vxlan = netdev_name;
             downVxlanNetdevice(netdev_name);
-            cmdDeleteVxlan(info, res);
+            cmdDeleteVxlan(m_rtnl, info);
         }
         else if(netdev_type.compare(VXLAN_IF))
         {
             info.m_vxlanIf = netdev_name;
-            cmdDeleteVxlanIf(info, res);
+            cmdDeleteVxlanIf(m_rtnl, info);
         }
         it = m_vxlanNetDevices.erase(it);
     }
@@ -1244,12 +1179,11 @@ void VxlanMgr::disableLearningForAllVxlanNetdevices()
     {
         std::string netdev_name = it->second.vxlan_dev_name;
         VxlanInfo info;
-        std::string res;
         if (!netdev_name.empty())
         {
             SWSS_LOG_INFO("Disable learning for NetDevice %s\n", netdev_name.c_str());
             info.m_vxlan = netdev_name;
-            cmdVxlanLearningOff(info, res);
+            cmdVxlanLearningOff(m_rtnl, info);
         }
     }
 }
@@ -260,13 +260,27 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
     /* Read all netlink messages inside FPM message */
     for (; NLMSG_OK (nl_hdr, msg_len); nl_hdr = NLMSG_NEXT(nl_hdr, msg_len))
     {
+        /*
+         * Unicast routes of the default VRF, the bulk of a full table, are
+         * parsed straight from the message without libnl objects.
+         */
+        if (m_routesync->onRouteMsgFast(nl_hdr))
+        {
+            continue;
+        }
+
         /*
          * EVPN Type5 Add Routes need to be process in Raw mode as they contain
          * RMAC, VLAN and L3VNI information.
          * Where as all other route will be using rtnl api to extract information
          * from the netlink msg.
          */
-        bool isRaw = isRawProcessing(nl_hdr);
+        if (isRawProcessing(nl_hdr))
+        {
+            /* EVPN Type5 Add route processing */
+            processRawMsg(nl_hdr);
+            continue;
+        }
 
         nl_msg *msg = nlmsg_convert(nl_hdr);
         if (msg == NULL)
@@ -276,15 +290,7 @@ void FpmLink::processFpmMessage(fpm_msg_hdr_t* hdr)
 
         nlmsg_set_proto(msg, NETLINK_ROUTE);
 
-        if (isRaw)
-        {
-            /* EVPN Type5 Add route processing */
-            processRawMsg(nl_hdr);
-        }
-        else
-        {
-            NetDispatcher::getInstance().onNetlinkMessage(msg);
-        }
+        NetDispatcher::getInstance().onNetlinkMessage(msg);
         nlmsg_free(msg);
     }
 }
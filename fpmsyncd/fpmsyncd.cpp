@@ -1,3 +1,4 @@
+#include <getopt.h>
 #include <iostream>
 #include <inttypes.h>
 #include "logger.h"
@@ -24,6 +25,11 @@ static int gSelectTimeout;
 static int gFlushTimeout = FLUSH_TIMEOUT;
 // consider the traffic is small if pipeline contains < 500 entries
 #define SMALL_TRAFFIC 500
+// route updates are batched up to 1000 prefixes or 5 milliseconds by default
+#define DEFAULT_ROUTE_BATCH_SIZE 1000
+#define DEFAULT_ROUTE_BATCH_HOLD_US 5000
+// route batch counters are published to STATE_DB every second
+#define ROUTE_BATCH_STATS_INTERVAL 1
 
 /**
  * @brief fpmsyncd invokes redispipeline's flush with a timer
@@ -37,6 +43,19 @@ static int gFlushTimeout = FLUSH_TIMEOUT;
  */
 void flushPipeline(RedisPipeline& pipeline);
 
+/**
+ * @brief fpmsyncd writes the pending route updates when they are due
+ *
+ * The route batch is written to the pipeline once it has been held for the
+ * configured time, then the pipeline is flushed with flushPipeline().
+ * gSelectTimeout is shortened so that select() returns when the pending
+ * route updates are due.
+ *
+ * @param sync reference to the route sync holding the route batch
+ * @param pipeline reference to the pipeline to be flushed
+ */
+void flushRoutes(RouteSync& sync, RedisPipeline& pipeline);
+
 /*
  * Default warm-restart timer interval for routing-stack app. To be used only if
  * no explicit value has been defined in configuration.
@@ -69,10 +88,51 @@ static bool eoiuFlagsSet(Table &bgpStateTable)
     return true;
 }
 
+void usage()
+{
+    cout << "usage: fpmsyncd [-b batch_size] [-t hold_time]" << endl;
+    cout << "    -b batch_size: maximum number of prefixes in a route update batch, 0 disables batching" << endl;
+    cout << "                   (default " << DEFAULT_ROUTE_BATCH_SIZE << ")" << endl;
+    cout << "    -t hold_time: maximum time in microseconds a route update is held in a batch" << endl;
+    cout << "                  (default " << DEFAULT_ROUTE_BATCH_HOLD_US << ")" << endl;
+}
+
 int main(int argc, char **argv)
 {
     swss::Logger::linkToDbNative("fpmsyncd");
 
+    size_t routeBatchSize = DEFAULT_ROUTE_BATCH_SIZE;
+    uint64_t routeBatchHoldUs = DEFAULT_ROUTE_BATCH_HOLD_US;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:t:h")) != -1)
+    {
+        try
+        {
+            switch (opt)
+            {
+            case 'b':
+                routeBatchSize = stoul(optarg);
+                break;
+            case 't':
+                routeBatchHoldUs = stoull(optarg);
+                break;
+            case 'h':
+                usage();
+                return 1;
+            default: /* '?' */
+                usage();
+                return EXIT_FAILURE;
+            }
+        }
+        catch (const logic_error &e)
+        {
+            cerr << "Invalid value " << optarg << " for option -" << (char)opt << endl;
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
     const auto routeResponseChannelName = std::string("APPL_DB_") + APP_ROUTE_TABLE_NAME + "_RESPONSE_CHANNEL";
 
     DBConnector db("APPL_DB", 0);
@@ -84,9 +144,11 @@ int main(int argc, char **argv)
 
     RedisPipeline pipeline(&db, ROUTE_SYNC_PPL_SIZE);
     RouteSync sync(&pipeline);
+    sync.setRouteBatchPolicy(routeBatchSize, routeBatchHoldUs);
 
     DBConnector stateDb("STATE_DB", 0);
     Table bgpStateTable(&stateDb, STATE_BGP_TABLE_NAME);
+    Table fpmsyncdStatsTable(&stateDb, FPMSYNCD_STATS_TABLE);
 
     NetLink netlink;
 
@@ -120,11 +182,13 @@ int main(int argc, char **argv)
             SelectableTimer eoiuCheckTimer(timespec{0, 0});
             // After eoiu flags are detected, start a hold timer before starting reconciliation.
             SelectableTimer eoiuHoldTimer(timespec{0, 0});
+            SelectableTimer statsTimer(timespec{ROUTE_BATCH_STATS_INTERVAL, 0});
            
             /*
-             * Pipeline should be flushed right away to deal with state pending
-             * from previous try/catch iterations.
+             * Route batch and pipeline should be flushed right away to deal with
+             * state pending from previous try/catch iterations.
              */
+            sync.flushRouteBatch(true);
             pipeline.flush();
 
             cout << "Waiting for fpm-client connection..." << endl;
@@ -135,6 +199,9 @@ int main(int argc, char **argv)
             s.addSelectable(&netlink);
             s.addSelectable(&deviceMetadataTableSubscriber);
 
+            statsTimer.start();
+            s.addSelectable(&statsTimer);
+
             if (sync.isSuppressionEnabled())
             {
                 s.addSelectable(routeResponseChannel.get());
@@ -308,9 +375,17 @@ int main(int argc, char **argv)
                         sync.onRouteResponse(key, fieldValues);
                     }
                 }
+                else if (temps == &statsTimer)
+                {
+                    sync.publishRouteBatchStats(fpmsyncdStatsTable);
+                    if (!warmStartEnabled || sync.m_warmStartHelper.isReconciled())
+                    {
+                        flushRoutes(sync, pipeline);
+                    }
+                }
                 else if (!warmStartEnabled || sync.m_warmStartHelper.isReconciled())
                 {
-                    flushPipeline(pipeline);
+                    flushRoutes(sync, pipeline);
                 }
             }
         }
@@ -358,4 +433,22 @@ void flushPipeline(RedisPipeline& pipeline) {
         // by doing this, we make sure every entry eventually gets flushed
         gSelectTimeout = gFlushTimeout - idle;
     }
-}
\ No newline at end of file
+}
+
+void flushRoutes(RouteSync& sync, RedisPipeline& pipeline)
+{
+    sync.flushRouteBatch();
+
+    flushPipeline(pipeline);
+
+    int64_t batchTimeout = sync.getRouteBatchTimeout();
+    if (batchTimeout >= 0)
+    {
+        // round up to milliseconds, select would otherwise return before the batch is due
+        int timeout = (int)((batchTimeout + 999) / 1000);
+        if (gSelectTimeout == INFINITE || timeout < gSelectTimeout)
+        {
+            gSelectTimeout = timeout;
+        }
+    }
+}
@@ -13,6 +13,7 @@
 #include "converter.h"
 #include <string.h>
 #include <arpa/inet.h>
+#include <inttypes.h>
 
 using namespace std;
 using namespace swss;
@@ -772,7 +773,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            delRoute(destipprefix);
             return;
         }
         else
@@ -853,7 +854,7 @@ void RouteSync::onEvpnRouteMsg(struct nlmsghdr *h, int len)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        setRoute(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s vtep:%s vni:%s mac:%s intf:%s protocol:%s",
                        destipprefix, nexthops.c_str(), vni_list.c_str(), mac_list.c_str(), intf_list.c_str(),
                        proto_str.c_str());
@@ -1082,7 +1083,7 @@ void RouteSync::onSrv6SteerRouteMsg(struct nlmsghdr *h, int len)
 
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(routeTableKey);
+            delRoute(routeTableKey);
             m_srv6SidListTable.del(srv6SidListTableKey);
             return;
         }
@@ -1128,7 +1129,7 @@ void RouteSync::onSrv6SteerRouteMsg(struct nlmsghdr *h, int len)
         }
         if (!warmRestartInProgress)
         {
-            m_routeTable.set(routeTableKey, fvVectorRoute);
+            setRoute(routeTableKey, fvVectorRoute);
             SWSS_LOG_DEBUG("RouteTable set msg: %s vpn_sid: %s src_addr:%s",
                         routeTableKey, vpn_sid_str.c_str(),
                         src_addr_str.c_str());
@@ -1587,7 +1588,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     {
         if (!warmRestartInProgress)
         {
-            m_routeTable.del(destipprefix);
+            delRoute(destipprefix);
             return;
         }
         else
@@ -1621,7 +1622,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
             vector<FieldValueTuple> fvVector;
             FieldValueTuple fv("blackhole", "true");
             fvVector.push_back(fv);
-            m_routeTable.set(destipprefix, fvVector);
+            setRoute(destipprefix, fvVector);
             return;
         }
         case RTN_UNICAST:
@@ -1674,7 +1675,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
                     SWSS_LOG_NOTICE("RouteTable del msg for route with only one nh on eth0/docker0: %s %s %s %s",
                             destipprefix, gw_list.c_str(), intf_list.c_str(), mpls_list.c_str());
 
-                    m_routeTable.del(destipprefix);
+                    delRoute(destipprefix);
                 }
                 else
                 {
@@ -1716,7 +1717,7 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
 
     if (!warmRestartInProgress)
     {
-        m_routeTable.set(destipprefix, fvVector);
+        setRoute(destipprefix, fvVector);
         SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s %s", destipprefix,
                        gw_list.c_str(), intf_list.c_str(), mpls_list.c_str());
     }
@@ -1737,6 +1738,302 @@ void RouteSync::onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf)
     }
 }
 
+/* Append the text form of an IPv4/IPv6 address to str */
+static void appendAddress(string& str, int family, const void *addr)
+{
+    char buf[INET6_ADDRSTRLEN];
+    inet_ntop(family, addr, buf, sizeof(buf));
+    str += buf;
+}
+
+/* Next hop attributes handled by the libnl path only */
+static bool hasComplexNextHop(struct rtattr **tb)
+{
+    return tb[RTA_ENCAP_TYPE] || tb[RTA_ENCAP] || tb[RTA_VIA] || tb[RTA_NEWDST];
+}
+
+/*
+ * Fast path of regular routes, the counterpart of onMsg()/onRouteMsg() for
+ * IPv4/IPv6 unicast and blackhole routes of the default VRF. The route is
+ * parsed straight from the netlink message without allocating a libnl route
+ * object, and the field values are formatted into buffers that are reused
+ * from one message to the next. The fields written to APPL_DB are the same
+ * as on the libnl path.
+ * @arg h               Netlink message
+ *
+ * Return false if the message was not handled and has to go through the libnl
+ * path: VRF/VNET routes, encapsulated or MPLS next hops, other route types.
+ */
+bool RouteSync::onRouteMsgFast(struct nlmsghdr *h)
+{
+    if (h->nlmsg_type != RTM_NEWROUTE && h->nlmsg_type != RTM_DELROUTE)
+    {
+        return false;
+    }
+
+    int len = (int)(h->nlmsg_len - NLMSG_LENGTH(sizeof(struct rtmsg)));
+    if (len < 0)
+    {
+        return false;
+    }
+
+    struct rtmsg *rtm = (struct rtmsg *)NLMSG_DATA(h);
+    int family = rtm->rtm_family;
+    size_t addr_len;
+    if (family == AF_INET)
+    {
+        addr_len = IPV4_MAX_BYTE;
+    }
+    else if (family == AF_INET6)
+    {
+        addr_len = IPV6_MAX_BYTE;
+    }
+    else
+    {
+        return false;
+    }
+
+    struct rtattr *tb[RTA_MAX + 1] = {0};
+    netlink_parse_rtattr(tb, RTA_MAX, RTM_RTA(rtm), len);
+
+    /* Routes of a VRF or VNET are identified by the table (master device) */
+    uint32_t table = tb[RTA_TABLE] ? *(uint32_t *)RTA_DATA(tb[RTA_TABLE]) : rtm->rtm_table;
+    if (table != 0 || hasComplexNextHop(tb))
+    {
+        return false;
+    }
+
+    if (!tb[RTA_DST] || RTA_PAYLOAD(tb[RTA_DST]) != addr_len || rtm->rtm_dst_len > addr_len * 8)
+    {
+        return false;
+    }
+
+    m_fastKey.clear();
+    appendAddress(m_fastKey, family, RTA_DATA(tb[RTA_DST]));
+    if (rtm->rtm_dst_len != addr_len * 8)
+    {
+        m_fastKey += '/';
+        m_fastKey += to_string(rtm->rtm_dst_len);
+    }
+
+    bool warmRestartInProgress = m_warmStartHelper.inProgress();
+
+    if (h->nlmsg_type == RTM_DELROUTE)
+    {
+        if (!warmRestartInProgress)
+        {
+            delRoute(m_fastKey);
+        }
+        else
+        {
+            SWSS_LOG_INFO("Warm-Restart mode: Receiving delete msg: %s",
+                          m_fastKey.c_str());
+
+            vector<FieldValueTuple> fvVector;
+            const KeyOpFieldsValuesTuple kfv = std::make_tuple(m_fastKey,
+                                                               DEL_COMMAND,
+                                                               fvVector);
+            m_warmStartHelper.insertRefreshMap(kfv);
+        }
+        return true;
+    }
+
+    if (rtm->rtm_type == RTN_BLACKHOLE)
+    {
+        if (!isSuppressionEnabled())
+        {
+            sendOffloadReply(h);
+        }
+
+        vector<FieldValueTuple> fvVector;
+        FieldValueTuple fv("blackhole", "true");
+        fvVector.push_back(fv);
+        setRoute(m_fastKey, fvVector);
+        return true;
+    }
+
+    if (rtm->rtm_type != RTN_UNICAST)
+    {
+        return false;
+    }
+
+    /* Get nexthop lists */
+    m_fastGwList.clear();
+    m_fastIntfList.clear();
+    m_fastWeights.clear();
+
+    size_t nh_count = 0;
+    bool has_weights = true;
+    bool has_mgmt_intf = false;
+    char if_name[IFNAMSIZ];
+
+    auto addNextHop = [&](struct rtattr *gateway, unsigned if_index, uint8_t weight) {
+        if (nh_count++)
+        {
+            m_fastGwList += NHG_DELIMITER;
+            m_fastIntfList += NHG_DELIMITER;
+            m_fastWeights += NHG_DELIMITER;
+        }
+
+        if (gateway)
+        {
+            appendAddress(m_fastGwList, family, RTA_DATA(gateway));
+        }
+        else
+        {
+            m_fastGwList += (family == AF_INET6 ? "::" : "0.0.0.0");
+        }
+
+        if (!getIfName(if_index, if_name, IFNAMSIZ))
+        {
+            strcpy(if_name, "unknown");
+        }
+        m_fastIntfList += if_name;
+
+        /*
+         * An FRR behavior change from 7.2 to 7.5 makes FRR update default route to eth0 in interface
+         * up/down events. Skipping routes to eth0 or docker0 to avoid such behavior
+         */
+        if (!strcmp(if_name, "eth0") || !strcmp(if_name, "docker0"))
+        {
+            has_mgmt_intf = true;
+        }
+
+        has_weights = has_weights && weight;
+        m_fastWeights += to_string(weight);
+    };
+
+    if (tb[RTA_MULTIPATH])
+    {
+        /* The next hop of the route must only be given by the multipath attribute */
+        if (tb[RTA_GATEWAY] || tb[RTA_OIF])
+        {
+            return false;
+        }
+
+        struct rtnexthop *rtnh = (struct rtnexthop *)RTA_DATA(tb[RTA_MULTIPATH]);
+        int nh_len = (int)RTA_PAYLOAD(tb[RTA_MULTIPATH]);
+        struct rtattr *subtb[RTA_MAX + 1];
+
+        while (nh_len >= (int)sizeof(*rtnh))
+        {
+            if (rtnh->rtnh_len < sizeof(*rtnh) || rtnh->rtnh_len > nh_len)
+            {
+                return false;
+            }
+
+            memset(subtb, 0, sizeof(subtb));
+            netlink_parse_rtattr(subtb, RTA_MAX, RTNH_DATA(rtnh),
+                                 (int)(rtnh->rtnh_len - sizeof(*rtnh)));
+            if (hasComplexNextHop(subtb) ||
+                (subtb[RTA_GATEWAY] && RTA_PAYLOAD(subtb[RTA_GATEWAY]) != addr_len))
+            {
+                return false;
+            }
+
+            addNextHop(subtb[RTA_GATEWAY], rtnh->rtnh_ifindex, rtnh->rtnh_hops);
+
+            nh_len -= NLMSG_ALIGN(rtnh->rtnh_len);
+            rtnh = RTNH_NEXT(rtnh);
+        }
+    }
+    else if (tb[RTA_GATEWAY] || tb[RTA_OIF])
+    {
+        if (tb[RTA_GATEWAY] && RTA_PAYLOAD(tb[RTA_GATEWAY]) != addr_len)
+        {
+            return false;
+        }
+
+        unsigned if_index = tb[RTA_OIF] ? *(uint32_t *)RTA_DATA(tb[RTA_OIF]) : 0;
+        addNextHop(tb[RTA_GATEWAY], if_index, 0);
+    }
+
+    if (nh_count == 0)
+    {
+        return false;
+    }
+
+    if (!isSuppressionEnabled())
+    {
+        sendOffloadReply(h);
+    }
+
+    if (has_mgmt_intf)
+    {
+        SWSS_LOG_DEBUG("Skip routes to eth0 or docker0: %s %s %s",
+                m_fastKey.c_str(), m_fastGwList.c_str(), m_fastIntfList.c_str());
+        // If the route has only this next hop, all of its other next hops have been removed.
+        // The route is not wanted on eth0/docker0 but still has to be cleared from APPL_DB,
+        // see onRouteMsg().
+        if (nh_count == 1)
+        {
+            if (!warmRestartInProgress)
+            {
+                SWSS_LOG_NOTICE("RouteTable del msg for route with only one nh on eth0/docker0: %s %s %s",
+                        m_fastKey.c_str(), m_fastGwList.c_str(), m_fastIntfList.c_str());
+
+                delRoute(m_fastKey);
+            }
+            else
+            {
+                SWSS_LOG_NOTICE("Warm-Restart mode: Receiving delete msg for route with only nh on eth0/docker0: %s %s %s",
+                        m_fastKey.c_str(), m_fastGwList.c_str(), m_fastIntfList.c_str());
+
+                vector<FieldValueTuple> fvVector;
+                const KeyOpFieldsValuesTuple kfv = std::make_tuple(m_fastKey,
+                                                                   DEL_COMMAND,
+                                                                   fvVector);
+                m_warmStartHelper.insertRefreshMap(kfv);
+            }
+        }
+        return true;
+    }
+
+    /* protocol, nexthop, ifname and weight, in the order of onRouteMsg() */
+    m_fastFvs.resize(has_weights ? 4 : 3);
+    fvField(m_fastFvs[0]) = "protocol";
+    fvValue(m_fastFvs[0]) = getProtocolName(rtm->rtm_protocol);
+    fvField(m_fastFvs[1]) = "nexthop";
+    fvValue(m_fastFvs[1]).swap(m_fastGwList);
+    fvField(m_fastFvs[2]) = "ifname";
+    fvValue(m_fastFvs[2]).swap(m_fastIntfList);
+    if (has_weights)
+    {
+        fvField(m_fastFvs[3]) = "weight";
+        fvValue(m_fastFvs[3]).swap(m_fastWeights);
+    }
+
+    if (!warmRestartInProgress)
+    {
+        setRoute(m_fastKey, m_fastFvs);
+        SWSS_LOG_DEBUG("RouteTable set msg: %s %s %s", m_fastKey.c_str(),
+                       fvValue(m_fastFvs[1]).c_str(), fvValue(m_fastFvs[2]).c_str());
+    }
+    else
+    {
+        SWSS_LOG_INFO("Warm-Restart mode: RouteTable set msg: %s %s %s", m_fastKey.c_str(),
+                      fvValue(m_fastFvs[1]).c_str(), fvValue(m_fastFvs[2]).c_str());
+
+        const KeyOpFieldsValuesTuple kfv = std::make_tuple(m_fastKey,
+                                                           SET_COMMAND,
+                                                           m_fastFvs);
+        m_warmStartHelper.insertRefreshMap(kfv);
+    }
+
+    return true;
+}
+
+/* Return the protocol name, cached since it is looked up for every route */
+const string& RouteSync::getProtocolName(uint8_t proto)
+{
+    auto& name = m_protocolNames[proto];
+    if (name.empty())
+    {
+        name = getProtocolString(proto);
+    }
+    return name;
+}
+
 /* 
  * Handle label route
  * @arg nlmsg_type      Netlink message type
@@ -2398,9 +2695,185 @@ void RouteSync::onWarmStartEnd(DBConnector& applStateDb)
         markRoutesOffloaded(applStateDb);
     }
 
+    /* Reconciliation reads the route table and the pending updates must be in it */
+    flushRouteBatch(true);
+
     if (m_warmStartHelper.inProgress())
     {
         m_warmStartHelper.reconcile();
         SWSS_LOG_NOTICE("Warm-Restart reconciliation processed.");
     }
 }
+
+void RouteSync::setRouteBatchPolicy(size_t maxBatchSize, uint64_t maxHoldUs)
+{
+    SWSS_LOG_ENTER();
+
+    flushRouteBatch(true);
+
+    m_routeBatchSize = maxBatchSize;
+    m_routeBatchHoldUs = maxHoldUs;
+
+    SWSS_LOG_NOTICE("Route batch size %zu, hold time %" PRIu64 " us", m_routeBatchSize, m_routeBatchHoldUs);
+}
+
+void RouteSync::setRoute(const string& key, const vector<FieldValueTuple>& fvs)
+{
+    if (!m_routeBatchSize)
+    {
+        m_routeTable.set(key, fvs);
+        return;
+    }
+
+    m_routeBatchStats.updates++;
+    m_routeBatchStats.dirty = true;
+
+    auto it = m_routeBatchIndex.find(key);
+    if (it == m_routeBatchIndex.end())
+    {
+        if (m_routeBatch.empty())
+        {
+            m_routeBatchStart = chrono::steady_clock::now();
+        }
+        m_routeBatchIndex.emplace(key, m_routeBatch.size());
+        m_routeBatch.emplace_back(key, PendingRoute{false, true, fvs});
+    }
+    else
+    {
+        /* Same result as the previous set followed by this one, the fields are merged */
+        auto &route = m_routeBatch[it->second].second;
+        m_routeBatchStats.coalesced++;
+        if (!route.set)
+        {
+            route.set = true;
+            route.fvs = fvs;
+        }
+        else
+        {
+            for (const auto &fv : fvs)
+            {
+                auto field = find_if(route.fvs.begin(), route.fvs.end(), [&](const FieldValueTuple &f) {
+                    return fvField(f) == fvField(fv);
+                });
+                if (field == route.fvs.end())
+                {
+                    route.fvs.push_back(fv);
+                }
+                else
+                {
+                    fvValue(*field) = fvValue(fv);
+                }
+            }
+        }
+    }
+
+    if (m_routeBatch.size() >= m_routeBatchSize)
+    {
+        flushRouteBatch(true);
+    }
+}
+
+void RouteSync::delRoute(const string& key)
+{
+    if (!m_routeBatchSize)
+    {
+        m_routeTable.del(key);
+        return;
+    }
+
+    m_routeBatchStats.updates++;
+    m_routeBatchStats.dirty = true;
+
+    auto it = m_routeBatchIndex.find(key);
+    if (it == m_routeBatchIndex.end())
+    {
+        if (m_routeBatch.empty())
+        {
+            m_routeBatchStart = chrono::steady_clock::now();
+        }
+        m_routeBatchIndex.emplace(key, m_routeBatch.size());
+        m_routeBatch.emplace_back(key, PendingRoute{true, false, {}});
+    }
+    else
+    {
+        /* The delete overrides any pending set */
+        auto &route = m_routeBatch[it->second].second;
+        m_routeBatchStats.coalesced++;
+        route.del = true;
+        route.set = false;
+        route.fvs.clear();
+    }
+
+    if (m_routeBatch.size() >= m_routeBatchSize)
+    {
+        flushRouteBatch(true);
+    }
+}
+
+int64_t RouteSync::getRouteBatchTimeout() const
+{
+    if (m_routeBatch.empty())
+    {
+        return -1;
+    }
+
+    auto age = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_routeBatchStart).count();
+    return max<int64_t>(0, (int64_t)m_routeBatchHoldUs - age);
+}
+
+void RouteSync::flushRouteBatch(bool force)
+{
+    if (m_routeBatch.empty() || (!force && getRouteBatchTimeout() > 0))
+    {
+        return;
+    }
+
+    for (const auto &it : m_routeBatch)
+    {
+        if (it.second.del)
+        {
+            m_routeTable.del(it.first);
+        }
+        if (it.second.set)
+        {
+            m_routeTable.set(it.first, it.second.fvs);
+        }
+    }
+
+    uint64_t latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_routeBatchStart).count();
+
+    auto &stats = m_routeBatchStats;
+    stats.batches++;
+    stats.writes += m_routeBatch.size();
+    stats.maxBatchSize = max<uint64_t>(stats.maxBatchSize, m_routeBatch.size());
+    stats.totalLatencyUs += latency;
+    stats.maxLatencyUs = max(stats.maxLatencyUs, latency);
+    stats.dirty = true;
+
+    SWSS_LOG_DEBUG("Flushed route batch of %zu prefixes after %" PRIu64 " us", m_routeBatch.size(), latency);
+
+    m_routeBatch.clear();
+    m_routeBatchIndex.clear();
+}
+
+void RouteSync::publishRouteBatchStats(Table &statsTable)
+{
+    auto &stats = m_routeBatchStats;
+    if (!stats.dirty)
+    {
+        return;
+    }
+
+    vector<FieldValueTuple> fvs = {
+        {"updates", to_string(stats.updates)},
+        {"coalesced", to_string(stats.coalesced)},
+        {"batches", to_string(stats.batches)},
+        {"writes", to_string(stats.writes)},
+        {"avg_batch_size", to_string(stats.batches ? stats.writes / stats.batches : 0)},
+        {"max_batch_size", to_string(stats.maxBatchSize)},
+        {"avg_flush_latency_us", to_string(stats.batches ? stats.totalLatencyUs / stats.batches : 0)},
+        {"max_flush_latency_us", to_string(stats.maxLatencyUs)}
+    };
+    statsTable.set(FPMSYNCD_ROUTE_BATCH_STATS_KEY, fvs);
+    stats.dirty = false;
+}
@@ -29,6 +29,10 @@ namespace swss {
 /* Path to protocol name database provided by iproute2 */
 constexpr auto DefaultRtProtoPath = "/etc/iproute2/rt_protos";
 
+/* STATE_DB table of the fpmsyncd counters */
+#define FPMSYNCD_STATS_TABLE "FPMSYNCD_STATS_TABLE"
+#define FPMSYNCD_ROUTE_BATCH_STATS_KEY "route_batch"
+
 class RouteSync : public NetMsg
 {
 public:
@@ -40,6 +44,9 @@ public:
 
     virtual void onMsgRaw(struct nlmsghdr *obj);
 
+    /* Handle regular route straight from the netlink message, if possible */
+    bool onRouteMsgFast(struct nlmsghdr *h);
+
     void setSuppressionEnabled(bool enabled);
 
     bool isSuppressionEnabled() const
@@ -64,6 +71,22 @@ public:
         m_fpmInterface = nullptr;
     }
 
+    /*
+     * Batch the route table writes: updates of a prefix are coalesced until
+     * maxBatchSize prefixes are pending or the oldest update is maxHoldUs old.
+     * A batch size of 0 writes every update right away.
+     */
+    void setRouteBatchPolicy(size_t maxBatchSize, uint64_t maxHoldUs);
+
+    /* Write the pending route updates if the batch is due, or always if force */
+    void flushRouteBatch(bool force = false);
+
+    /* Microseconds until the pending route updates are due, -1 if there is none */
+    int64_t getRouteBatchTimeout() const;
+
+    /* Publish the route batching counters if they changed */
+    void publishRouteBatchStats(swss::Table &statsTable);
+
     WarmStartHelper  m_warmStartHelper;
 
 private:
@@ -85,6 +108,46 @@ private:
     bool                m_isSuppressionEnabled{false};
     FpmInterface*       m_fpmInterface {nullptr};
 
+    /* Buffers of the regular route fast path, reused across messages */
+    string              m_fastKey;
+    string              m_fastGwList;
+    string              m_fastIntfList;
+    string              m_fastWeights;
+    vector<FieldValueTuple> m_fastFvs;
+    array<string, 256>  m_protocolNames;
+
+    /* Pending update of a prefix, a delete and/or the fields to set */
+    struct PendingRoute
+    {
+        bool del;
+        bool set;
+        vector<FieldValueTuple> fvs;
+    };
+
+    struct RouteBatchStats
+    {
+        uint64_t updates = 0;
+        uint64_t coalesced = 0;
+        uint64_t batches = 0;
+        uint64_t writes = 0;
+        uint64_t maxBatchSize = 0;
+        uint64_t totalLatencyUs = 0;
+        uint64_t maxLatencyUs = 0;
+        bool dirty = false;
+    };
+
+    size_t              m_routeBatchSize {0};
+    uint64_t            m_routeBatchHoldUs {0};
+    /* Pending updates in arrival order and their index by prefix */
+    vector<pair<string, PendingRoute>> m_routeBatch;
+    unordered_map<string, size_t> m_routeBatchIndex;
+    chrono::steady_clock::time_point m_routeBatchStart;
+    RouteBatchStats     m_routeBatchStats;
+
+    /* Write a route to the route table, through the batch if enabled */
+    void setRoute(const string& key, const vector<FieldValueTuple>& fvs);
+    void delRoute(const string& key);
+
     /* Handle regular route (include VRF route) */
     void onRouteMsg(int nlmsg_type, struct nl_object *obj, char *vrf);
 
@@ -156,6 +219,9 @@ private:
     /* Get next hop weights*/
     string getNextHopWt(struct rtnl_route *route_obj);
 
+    /* Get route protocol name */
+    const string& getProtocolName(uint8_t proto);
+
     /* Sends FPM message with RTM_F_OFFLOAD flag set to zebra */
     bool sendOffloadReply(struct nlmsghdr* hdr);
 
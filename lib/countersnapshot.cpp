@@ -0,0 +1,434 @@
+#include "countersnapshot.h"
+#include "logger.h"
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace swss;
+
+namespace {
+
+const uint32_t SNAPSHOT_MAGIC = 0x53435753;
+const uint32_t SNAPSHOT_VERSION = 1;
+/* Copies a reader retries before it gives up on a writer that is stuck */
+const int SNAPSHOT_READ_RETRIES = 1000;
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "the sequence lock is shared between processes");
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;
+    uint32_t maxObjects;
+    uint32_t maxCounters;
+    /* Set when the writer removes the region */
+    std::atomic<uint32_t> closed;
+    uint32_t reserved;
+    std::atomic<uint64_t> sequence;
+    uint64_t layout;
+    uint64_t poll;
+    uint32_t objectCount;
+    uint32_t counterCount;
+};
+
+struct SnapshotRegion
+{
+    SnapshotHeader *header;
+    uint64_t *objects;
+    char *counters;
+    uint64_t *values;
+};
+
+size_t getRegionSize(size_t maxObjects, size_t maxCounters)
+{
+    return sizeof(SnapshotHeader)
+        + maxObjects * sizeof(uint64_t)
+        + maxCounters * CounterSnapshot::COUNTER_NAME_SIZE
+        + maxObjects * maxCounters * sizeof(uint64_t);
+}
+
+SnapshotRegion getRegion(void *base)
+{
+    SnapshotRegion region;
+    auto bytes = static_cast<char *>(base);
+
+    region.header = reinterpret_cast<SnapshotHeader *>(bytes);
+    bytes += sizeof(SnapshotHeader);
+    region.objects = reinterpret_cast<uint64_t *>(bytes);
+    bytes += region.header->maxObjects * sizeof(uint64_t);
+    region.counters = bytes;
+    bytes += region.header->maxCounters * CounterSnapshot::COUNTER_NAME_SIZE;
+    region.values = reinterpret_cast<uint64_t *>(bytes);
+
+    return region;
+}
+
+/* Mark the region of a previous writer closed, so that its readers map the new one */
+void closeRegion(const std::string &name)
+{
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(SnapshotHeader))
+    {
+        void *base = mmap(nullptr, sizeof(SnapshotHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (base != MAP_FAILED)
+        {
+            static_cast<SnapshotHeader *>(base)->closed.store(1, std::memory_order_release);
+            munmap(base, sizeof(SnapshotHeader));
+        }
+    }
+    ::close(fd);
+    shm_unlink(name.c_str());
+}
+
+}
+
+constexpr uint64_t CounterSnapshot::NOT_AVAILABLE;
+constexpr size_t CounterSnapshot::NOT_FOUND;
+constexpr size_t CounterSnapshot::COUNTER_NAME_SIZE;
+
+std::string CounterSnapshot::getRegionName(const std::string &group)
+{
+    return "/swss_counters." + group;
+}
+
+size_t CounterSnapshot::getObjectIndex(uint64_t object) const
+{
+    auto it = m_objectIndex.find(object);
+    return it == m_objectIndex.end() ? NOT_FOUND : it->second;
+}
+
+size_t CounterSnapshot::getCounterIndex(const std::string &counter) const
+{
+    auto it = m_counterIndex.find(counter);
+    return it == m_counterIndex.end() ? NOT_FOUND : it->second;
+}
+
+bool CounterSnapshot::get(uint64_t object, const std::string &counter, uint64_t &value) const
+{
+    size_t objectIdx = getObjectIndex(object);
+    size_t counterIdx = getCounterIndex(counter);
+    if (objectIdx == NOT_FOUND || counterIdx == NOT_FOUND)
+    {
+        return false;
+    }
+
+    value = getValue(objectIdx, counterIdx);
+    return value != NOT_AVAILABLE;
+}
+
+CounterSnapshotWriter::CounterSnapshotWriter(const std::string &group, size_t maxObjects, size_t maxCounters):
+    m_name(CounterSnapshot::getRegionName(group))
+{
+    SWSS_LOG_ENTER();
+
+    closeRegion(m_name);
+
+    int fd = shm_open(m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        SWSS_LOG_ERROR("Failed to create counter snapshot region %s, %s", m_name.c_str(), strerror(errno));
+        return;
+    }
+
+    size_t size = getRegionSize(maxObjects, maxCounters);
+    void *base = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0)
+    {
+        base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        SWSS_LOG_ERROR("Failed to map counter snapshot region %s, %s", m_name.c_str(), strerror(errno));
+        shm_unlink(m_name.c_str());
+        return;
+    }
+
+    /* The region is zeroed, the readers ignore it until the magic is set */
+    auto header = static_cast<SnapshotHeader *>(base);
+    header->version = SNAPSHOT_VERSION;
+    header->size = size;
+    header->maxObjects = static_cast<uint32_t>(maxObjects);
+    header->maxCounters = static_cast<uint32_t>(maxCounters);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SNAPSHOT_MAGIC;
+
+    m_region = base;
+    m_size = size;
+}
+
+CounterSnapshotWriter::~CounterSnapshotWriter()
+{
+    if (m_region == nullptr)
+    {
+        return;
+    }
+
+    static_cast<SnapshotHeader *>(m_region)->closed.store(1, std::memory_order_release);
+    munmap(m_region, m_size);
+    shm_unlink(m_name.c_str());
+}
+
+bool CounterSnapshotWriter::setLayout(const std::vector<uint64_t> &objects, const std::vector<std::string> &counters)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_region == nullptr)
+    {
+        return false;
+    }
+
+    auto region = getRegion(m_region);
+    if (objects.size() > region.header->maxObjects || counters.size() > region.header->maxCounters)
+    {
+        SWSS_LOG_ERROR("Counter snapshot region %s holds %u objects and %u counters, %zu and %zu requested",
+                       m_name.c_str(), region.header->maxObjects, region.header->maxCounters,
+                       objects.size(), counters.size());
+        return false;
+    }
+    for (const auto &counter : counters)
+    {
+        if (counter.size() >= CounterSnapshot::COUNTER_NAME_SIZE)
+        {
+            SWSS_LOG_ERROR("Counter name %s is too long for the snapshot region %s", counter.c_str(), m_name.c_str());
+            return false;
+        }
+    }
+
+    begin();
+
+    /* Unique across the writers of the group, the readers compare it with the one they copied */
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    region.header->layout = std::max(region.header->layout + 1, now);
+    region.header->objectCount = static_cast<uint32_t>(objects.size());
+    region.header->counterCount = static_cast<uint32_t>(counters.size());
+    std::copy(objects.begin(), objects.end(), region.objects);
+    for (size_t i = 0; i < counters.size(); i++)
+    {
+        char *name = region.counters + i * CounterSnapshot::COUNTER_NAME_SIZE;
+        memset(name, 0, CounterSnapshot::COUNTER_NAME_SIZE);
+        memcpy(name, counters[i].c_str(), counters[i].size());
+    }
+    std::fill(region.values, region.values + objects.size() * counters.size(), CounterSnapshot::NOT_AVAILABLE);
+
+    m_objectCount = objects.size();
+    m_counterCount = counters.size();
+
+    auto header = region.header;
+    header->sequence.store(header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    return true;
+}
+
+void CounterSnapshotWriter::begin()
+{
+    if (m_region == nullptr)
+    {
+        return;
+    }
+
+    auto header = static_cast<SnapshotHeader *>(m_region);
+    header->sequence.store(header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void CounterSnapshotWriter::set(size_t object, size_t counter, uint64_t value)
+{
+    if (m_region == nullptr || object >= m_objectCount || counter >= m_counterCount)
+    {
+        return;
+    }
+
+    getRegion(m_region).values[object * m_counterCount + counter] = value;
+}
+
+void CounterSnapshotWriter::commit()
+{
+    if (m_region == nullptr)
+    {
+        return;
+    }
+
+    auto header = static_cast<SnapshotHeader *>(m_region);
+    header->poll++;
+    header->sequence.store(header->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+CounterSnapshotReader::CounterSnapshotReader(const std::string &group):
+    m_name(CounterSnapshot::getRegionName(group))
+{
+}
+
+CounterSnapshotReader::~CounterSnapshotReader()
+{
+    close();
+}
+
+bool CounterSnapshotReader::open()
+{
+    int fd = shm_open(m_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    void *base = MAP_FAILED;
+    size_t size = 0;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(SnapshotHeader))
+    {
+        size = static_cast<size_t>(st.st_size);
+        base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+
+    if (base == MAP_FAILED)
+    {
+        return false;
+    }
+
+    auto header = static_cast<const SnapshotHeader *>(base);
+    if (header->magic != SNAPSHOT_MAGIC || header->version != SNAPSHOT_VERSION || header->size != size ||
+        getRegionSize(header->maxObjects, header->maxCounters) != size)
+    {
+        munmap(base, size);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    m_region = base;
+    m_size = size;
+    return true;
+}
+
+void CounterSnapshotReader::close()
+{
+    if (m_region != nullptr)
+    {
+        munmap(m_region, m_size);
+        m_region = nullptr;
+        m_size = 0;
+    }
+}
+
+bool CounterSnapshotReader::read(CounterSnapshot &snapshot)
+{
+    bool found = readRegion(snapshot);
+    Source source = found ? Source::SNAPSHOT : Source::REDIS;
+    if (found)
+    {
+        m_stats.snapshotReads++;
+    }
+    else
+    {
+        m_stats.redisFallbacks++;
+    }
+
+    if (source != m_source)
+    {
+        if (found)
+        {
+            SWSS_LOG_NOTICE("Counters are read from the counter snapshot region %s", m_name.c_str());
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Counter snapshot region %s has no poll, the counters are read from redis", m_name.c_str());
+        }
+        m_source = source;
+    }
+
+    return found;
+}
+
+bool CounterSnapshotReader::readRegion(CounterSnapshot &snapshot)
+{
+    if (m_region != nullptr && static_cast<SnapshotHeader *>(m_region)->closed.load(std::memory_order_acquire))
+    {
+        close();
+    }
+    if (m_region == nullptr && !open())
+    {
+        return false;
+    }
+
+    auto region = getRegion(m_region);
+    auto header = region.header;
+
+    std::vector<uint64_t> objects;
+    std::vector<std::string> counters;
+    for (int retry = 0; retry < SNAPSHOT_READ_RETRIES; retry++)
+    {
+        uint64_t sequence = header->sequence.load(std::memory_order_acquire);
+        if (sequence & 1)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint64_t layout = header->layout;
+        uint64_t poll = header->poll;
+        size_t objectCount = std::min(header->objectCount, header->maxObjects);
+        size_t counterCount = std::min(header->counterCount, header->maxCounters);
+
+        bool layoutChanged = layout != snapshot.m_layout;
+        if (layoutChanged)
+        {
+            objects.assign(region.objects, region.objects + objectCount);
+            counters.clear();
+            for (size_t i = 0; i < counterCount; i++)
+            {
+                const char *name = region.counters + i * CounterSnapshot::COUNTER_NAME_SIZE;
+                counters.emplace_back(name, strnlen(name, CounterSnapshot::COUNTER_NAME_SIZE));
+            }
+        }
+        snapshot.m_values.resize(objectCount * counterCount);
+        std::copy(region.values, region.values + objectCount * counterCount, snapshot.m_values.begin());
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (header->sequence.load(std::memory_order_relaxed) != sequence)
+        {
+            continue;
+        }
+
+        if (layoutChanged)
+        {
+            snapshot.m_layout = layout;
+            snapshot.m_objects.swap(objects);
+            snapshot.m_counters.swap(counters);
+            snapshot.m_objectIndex.clear();
+            for (size_t i = 0; i < snapshot.m_objects.size(); i++)
+            {
+                snapshot.m_objectIndex[snapshot.m_objects[i]] = i;
+            }
+            snapshot.m_counterIndex.clear();
+            for (size_t i = 0; i < snapshot.m_counters.size(); i++)
+            {
+                snapshot.m_counterIndex[snapshot.m_counters[i]] = i;
+            }
+        }
+        snapshot.m_poll = poll;
+
+        return poll != 0;
+    }
+
+    SWSS_LOG_WARN("Counter snapshot region %s is not readable, its writer is stuck", m_name.c_str());
+    snapshot = CounterSnapshot();
+    return false;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace swss {
+
+/*
+ * Counters of a flex counter group, published by the counter poller once per
+ * poll in a POSIX shared memory region, next to COUNTERS_DB, for the readers
+ * of the same host. Redis stays the interface of the external readers.
+ *
+ * The region of a group has a fixed layout sized when it is created: a
+ * header, the object ids, the counter names and a value per object and
+ * counter. It is updated under a sequence lock: the writer makes the
+ * sequence odd while it updates the region, and a reader retries its copy
+ * if the sequence was odd or changed meanwhile. Readers never block the
+ * writer.
+ */
+class CounterSnapshot
+{
+public:
+    /* Value of a counter that was not read at the last poll */
+    static constexpr uint64_t NOT_AVAILABLE = std::numeric_limits<uint64_t>::max();
+    static constexpr size_t NOT_FOUND = std::numeric_limits<size_t>::max();
+    static constexpr size_t COUNTER_NAME_SIZE = 64;
+
+    static std::string getRegionName(const std::string &group);
+
+    /* Layout generation, changed each time the objects or counters change */
+    uint64_t getLayout() const
+    {
+        return m_layout;
+    }
+
+    /* Number of polls the writer published */
+    uint64_t getPoll() const
+    {
+        return m_poll;
+    }
+
+    const std::vector<uint64_t> &getObjects() const
+    {
+        return m_objects;
+    }
+
+    const std::vector<std::string> &getCounters() const
+    {
+        return m_counters;
+    }
+
+    /* Indexes of the layout, NOT_FOUND if the object or counter is not in it */
+    size_t getObjectIndex(uint64_t object) const;
+    size_t getCounterIndex(const std::string &counter) const;
+
+    uint64_t getValue(size_t object, size_t counter) const
+    {
+        return m_values[object * m_counters.size() + counter];
+    }
+
+    /* False if the object or counter is not in the snapshot or was not read */
+    bool get(uint64_t object, const std::string &counter, uint64_t &value) const;
+
+private:
+    friend class CounterSnapshotReader;
+
+    uint64_t m_layout = 0;
+    uint64_t m_poll = 0;
+    std::vector<uint64_t> m_objects;
+    std::vector<std::string> m_counters;
+    std::unordered_map<uint64_t, size_t> m_objectIndex;
+    std::unordered_map<std::string, size_t> m_counterIndex;
+    std::vector<uint64_t> m_values;
+};
+
+class CounterSnapshotWriter
+{
+public:
+    /* Create the region of the group, or take over the one left by a previous writer */
+    CounterSnapshotWriter(const std::string &group, size_t maxObjects, size_t maxCounters);
+    /* Remove the region, the readers fall back to redis */
+    ~CounterSnapshotWriter();
+
+    CounterSnapshotWriter(const CounterSnapshotWriter&) = delete;
+    CounterSnapshotWriter& operator=(const CounterSnapshotWriter&) = delete;
+
+    bool isValid() const
+    {
+        return m_region != nullptr;
+    }
+
+    /*
+     * Set the objects and counters of the next polls, all the values are
+     * NOT_AVAILABLE until they are set. False if they don't fit in the region.
+     */
+    bool setLayout(const std::vector<uint64_t> &objects, const std::vector<std::string> &counters);
+
+    /* A poll, the values are only visible to the readers after commit() */
+    void begin();
+    void set(size_t object, size_t counter, uint64_t value);
+    void commit();
+
+private:
+    std::string m_name;
+    void *m_region = nullptr;
+    size_t m_size = 0;
+    size_t m_objectCount = 0;
+    size_t m_counterCount = 0;
+};
+
+class CounterSnapshotReader
+{
+public:
+    /* Reads since the reader was created */
+    struct Stats
+    {
+        uint64_t snapshotReads = 0;
+        /* Reads that found no poll, the counters were read from redis */
+        uint64_t redisFallbacks = 0;
+    };
+
+    explicit CounterSnapshotReader(const std::string &group);
+    ~CounterSnapshotReader();
+
+    CounterSnapshotReader(const CounterSnapshotReader&) = delete;
+    CounterSnapshotReader& operator=(const CounterSnapshotReader&) = delete;
+
+    /*
+     * Copy the last published poll into the snapshot. False if the group has
+     * no region, or no poll was published in it yet, then the counters are to
+     * be read from redis. Each change between the two is logged.
+     */
+    bool read(CounterSnapshot &snapshot);
+
+    const Stats &getStats() const
+    {
+        return m_stats;
+    }
+
+private:
+    enum class Source
+    {
+        NONE,
+        SNAPSHOT,
+        REDIS,
+    };
+
+    std::string m_name;
+    void *m_region = nullptr;
+    size_t m_size = 0;
+    Source m_source = Source::NONE;
+    Stats m_stats;
+
+    bool open();
+    void close();
+    bool readRegion(CounterSnapshot &snapshot);
+};
+
+}
@@ -1,10 +1,80 @@
 #include "recorder.h"
 #include "timestamp.h"
 #include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
+#include <endian.h>
+#include <time.h>
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
 
 using namespace swss;
 
+namespace {
+
+const char REC_FILE_MAGIC[8] = { 'S', 'W', 'S', 'S', 'R', 'E', 'C', 0 };
+const uint32_t REC_VERSION = 1;
+const uint32_t REC_BLOCK_MAGIC = 0x4b4c4253;
+
+struct RecBlockHeader
+{
+    uint32_t magic;
+    uint8_t compression;
+    uint8_t reserved[3];
+    uint32_t size;
+    uint32_t storedSize;
+};
+
+void appendBytes(std::vector<char> &block, const void *data, size_t size)
+{
+    auto bytes = static_cast<const char *>(data);
+    block.insert(block.end(), bytes, bytes + size);
+}
+
+/* Same format as swss::getTimestamp() */
+std::string formatTimestamp(uint64_t timestampUs)
+{
+    time_t sec = static_cast<time_t>(timestampUs / 1000000);
+    struct tm tm;
+    char buffer[64];
+
+    localtime_r(&sec, &tm);
+    size_t size = strftime(buffer, 32, "%Y-%m-%d.%T.", &tm);
+    snprintf(&buffer[size], 32, "%06u", static_cast<unsigned int>(timestampUs % 1000000));
+    return std::string(buffer);
+}
+
+bool compressionSupported(RecCompression compression)
+{
+    switch (compression)
+    {
+        case RecCompression::NONE:
+            return true;
+#ifdef HAVE_ZSTD
+        case RecCompression::ZSTD:
+            return true;
+#endif
+#ifdef HAVE_LZ4
+        case RecCompression::LZ4:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+}
+
+const size_t RecWriter::BLOCK_SIZE = 64 * 1024;
+const size_t RecWriter::MAX_PENDING_BLOCKS = 64;
+
 const std::string Recorder::DEFAULT_DIR = ".";
 const std::string Recorder::REC_START = "|recording started";
 const std::string Recorder::SWSS_FNAME = "swss.rec";
@@ -60,8 +130,7 @@ void RecWriter::startRec(bool exit_if_failure)
     }
 
     fname = getLoc() + "/" + getFile();
-    record_ofs.open(fname, std::ofstream::out | std::ofstream::app);
-    if (!record_ofs.is_open())
+    if (!openFile())
     {
         SWSS_LOG_ERROR("%s Recorder: Failed to open recording file %s: error %s", getName().c_str(), fname.c_str(), strerror(errno));
         if (exit_if_failure)
@@ -71,15 +140,41 @@ void RecWriter::startRec(bool exit_if_failure)
         else
         {
             setRecord(false);
+            return;
         }
     }
-    record_ofs << swss::getTimestamp() << Recorder::REC_START << std::endl;
+
+    if (m_format == RecFormat::BINARY)
+    {
+        if (!compressionSupported(m_compression))
+        {
+            SWSS_LOG_WARN("%s Recorder: Compression %d is not supported, recording uncompressed", getName().c_str(), static_cast<int>(m_compression));
+            m_compression = RecCompression::NONE;
+        }
+        m_block.reserve(BLOCK_SIZE);
+        m_writer = std::thread(&RecWriter::writerThread, this);
+        record(Recorder::REC_START.substr(1));
+    }
+    else
+    {
+        record_ofs << swss::getTimestamp() << Recorder::REC_START << std::endl;
+    }
     SWSS_LOG_NOTICE("%s Recorder: Recording started at %s", getName().c_str(), fname.c_str());
 }
 
 
 RecWriter::~RecWriter()
 {
+    if (m_writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stop = true;
+        }
+        m_blockReady.notify_one();
+        m_writer.join();
+    }
+
     if (record_ofs.is_open())
     {
         record_ofs.close();      
@@ -93,12 +188,61 @@ void RecWriter::record(const std::string& val)
     {
         return ;
     }
+
+    if (m_format == RecFormat::BINARY)
+    {
+        uint64_t timestamp = htole64(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count()));
+        uint32_t size = htole32(static_cast<uint32_t>(val.size()));
+
+        std::unique_lock<std::mutex> lock(m_lock);
+        appendBytes(m_block, &timestamp, sizeof(timestamp));
+        appendBytes(m_block, &size, sizeof(size));
+        appendBytes(m_block, val.data(), val.size());
+
+        if (m_block.size() >= BLOCK_SIZE)
+        {
+            m_blockDone.wait(lock, [this]() { return m_blocks.size() < MAX_PENDING_BLOCKS; });
+            m_blocks.push_back(std::move(m_block));
+            m_block = std::vector<char>();
+            m_block.reserve(BLOCK_SIZE);
+            m_blockReady.notify_one();
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
     if (isRotate())
     {
         setRotate(false);
         logfileReopen();
     }
-    record_ofs << swss::getTimestamp() << "|" << val << std::endl;
+    std::string timestamp = swss::getTimestamp();
+    record_ofs << timestamp << "|" << val << std::endl;
+
+    m_fileSize += timestamp.size() + val.size() + 2;
+    if (m_maxFileSize && m_fileSize >= m_maxFileSize)
+    {
+        rotateFiles();
+        if (!openFile())
+        {
+            SWSS_LOG_ERROR("%s Recorder: Failed to open file %s: %s", getName().c_str(), fname.c_str(), strerror(errno));
+        }
+    }
+}
+
+
+void RecWriter::flush()
+{
+    if (!m_writer.joinable())
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_flush = true;
+    m_blockReady.notify_one();
+    m_blockDone.wait(lock, [this]() { return !m_flush; });
 }
 
 
@@ -110,12 +254,310 @@ void RecWriter::logfileReopen()
      * empty file here.
      */
     record_ofs.close();
-    record_ofs.open(fname, std::ofstream::out | std::ofstream::app);
 
-    if (!record_ofs.is_open())
+    if (!openFile())
     {
         SWSS_LOG_ERROR("%s Recorder: Failed to open file %s: %s", getName().c_str(), fname.c_str(), strerror(errno));
         return;
     }
     SWSS_LOG_INFO("%s Recorder: LogRotate request handled", getName().c_str());
 }
+
+
+bool RecWriter::openFile()
+{
+    bool binary = m_format == RecFormat::BINARY;
+
+    /* Records of the other format are moved aside as a rotated file */
+    std::ifstream ifs(fname, std::ifstream::in | std::ifstream::binary);
+    char magic[sizeof(REC_FILE_MAGIC)];
+    if (ifs.read(magic, sizeof(magic)).gcount() > 0 &&
+        (ifs.gcount() == sizeof(magic) && !memcmp(magic, REC_FILE_MAGIC, sizeof(magic))) != binary)
+    {
+        ifs.close();
+        rotateFiles();
+    }
+
+    record_ofs.open(fname, binary ? std::ofstream::out | std::ofstream::app | std::ofstream::binary :
+                                    std::ofstream::out | std::ofstream::app);
+    if (!record_ofs.is_open())
+    {
+        return false;
+    }
+
+    record_ofs.seekp(0, std::ofstream::end);
+    m_fileSize = static_cast<uint64_t>(record_ofs.tellp());
+    if (binary && m_fileSize == 0)
+    {
+        uint32_t version = htole32(REC_VERSION);
+        record_ofs.write(REC_FILE_MAGIC, sizeof(REC_FILE_MAGIC));
+        record_ofs.write(reinterpret_cast<const char *>(&version), sizeof(version));
+        record_ofs.flush();
+        m_fileSize = sizeof(REC_FILE_MAGIC) + sizeof(REC_VERSION);
+    }
+    return true;
+}
+
+
+/*
+ * Rename file to file.rotated.1, file.rotated.1 to file.rotated.2 and so on,
+ * the oldest one being overwritten once the max number of files is reached.
+ * At least one rotated file is kept, so that a file of the other format is
+ * moved aside even without rotation.
+ */
+void RecWriter::rotateFiles()
+{
+    record_ofs.close();
+
+    const std::string rotated = fname + ".rotated.";
+    for (unsigned int i = std::max(m_maxFiles, 2u) - 2; i > 0; i--)
+    {
+        rename((rotated + std::to_string(i)).c_str(), (rotated + std::to_string(i + 1)).c_str());
+    }
+    rename(fname.c_str(), (rotated + "1").c_str());
+}
+
+
+void RecWriter::writerThread()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+        if (m_blocks.empty() && !m_flush && !m_stop)
+        {
+            m_blockReady.wait_for(lock, std::chrono::seconds(1));
+        }
+
+        /* On timeout, flush and stop the records of the current block are written too */
+        if (m_blocks.empty() && !m_block.empty())
+        {
+            m_blocks.push_back(std::move(m_block));
+            m_block = std::vector<char>();
+            m_block.reserve(BLOCK_SIZE);
+        }
+
+        if (m_blocks.empty())
+        {
+            if (m_flush)
+            {
+                m_flush = false;
+                m_blockDone.notify_all();
+            }
+            if (m_stop)
+            {
+                return;
+            }
+            continue;
+        }
+
+        auto block = std::move(m_blocks.front());
+        m_blocks.pop_front();
+
+        lock.unlock();
+        if (isRotate())
+        {
+            setRotate(false);
+            logfileReopen();
+        }
+        writeBlock(block);
+        lock.lock();
+
+        m_blockDone.notify_all();
+    }
+}
+
+
+void RecWriter::writeBlock(const std::vector<char> &block)
+{
+    RecBlockHeader header = {};
+    header.magic = REC_BLOCK_MAGIC;
+    header.compression = static_cast<uint8_t>(RecCompression::NONE);
+    header.size = static_cast<uint32_t>(block.size());
+    header.storedSize = header.size;
+
+    const char *data = block.data();
+    std::vector<char> compressed;
+
+    /* A block is stored uncompressed when it does not get smaller */
+    switch (m_compression)
+    {
+#ifdef HAVE_ZSTD
+        case RecCompression::ZSTD:
+        {
+            compressed.resize(ZSTD_compressBound(block.size()));
+            size_t size = ZSTD_compress(compressed.data(), compressed.size(), block.data(), block.size(), 1);
+            if (!ZSTD_isError(size) && size < block.size())
+            {
+                header.compression = static_cast<uint8_t>(RecCompression::ZSTD);
+                header.storedSize = static_cast<uint32_t>(size);
+                data = compressed.data();
+            }
+            break;
+        }
+#endif
+#ifdef HAVE_LZ4
+        case RecCompression::LZ4:
+        {
+            compressed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(block.size()))));
+            int size = LZ4_compress_default(block.data(), compressed.data(), static_cast<int>(block.size()),
+                                            static_cast<int>(compressed.size()));
+            if (size > 0 && static_cast<size_t>(size) < block.size())
+            {
+                header.compression = static_cast<uint8_t>(RecCompression::LZ4);
+                header.storedSize = static_cast<uint32_t>(size);
+                data = compressed.data();
+            }
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+
+    uint64_t frameSize = sizeof(header) + header.storedSize;
+    if (m_maxFileSize && m_fileSize > sizeof(REC_FILE_MAGIC) + sizeof(REC_VERSION) &&
+        m_fileSize + frameSize > m_maxFileSize)
+    {
+        rotateFiles();
+        if (!openFile())
+        {
+            SWSS_LOG_ERROR("%s Recorder: Failed to open file %s: %s", getName().c_str(), fname.c_str(), strerror(errno));
+            return;
+        }
+    }
+
+    uint32_t storedSize = header.storedSize;
+    header.magic = htole32(header.magic);
+    header.size = htole32(header.size);
+    header.storedSize = htole32(header.storedSize);
+    record_ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    record_ofs.write(data, storedSize);
+    record_ofs.flush();
+    m_fileSize += frameSize;
+}
+
+
+bool RecReader::open(const std::string& fname)
+{
+    m_ifs.open(fname, std::ifstream::in | std::ifstream::binary);
+    if (!m_ifs.is_open())
+    {
+        return false;
+    }
+
+    char magic[sizeof(REC_FILE_MAGIC)];
+    m_binary = m_ifs.read(magic, sizeof(magic)).gcount() == sizeof(magic) &&
+               !memcmp(magic, REC_FILE_MAGIC, sizeof(magic));
+    if (!m_binary)
+    {
+        m_ifs.clear();
+        m_ifs.seekg(0);
+        return true;
+    }
+
+    uint32_t version = 0;
+    m_ifs.read(reinterpret_cast<char *>(&version), sizeof(version));
+    version = le32toh(version);
+    if (version != REC_VERSION)
+    {
+        SWSS_LOG_ERROR("Recording file %s: unsupported version %u", fname.c_str(), version);
+        return false;
+    }
+    return true;
+}
+
+
+bool RecReader::next(std::string& timestamp, std::string& val)
+{
+    if (!m_binary)
+    {
+        std::string line;
+        if (!std::getline(m_ifs, line))
+        {
+            return false;
+        }
+
+        auto pos = line.find('|');
+        timestamp = line.substr(0, pos);
+        val = pos == std::string::npos ? "" : line.substr(pos + 1);
+        return true;
+    }
+
+    while (m_offset == m_block.size())
+    {
+        if (!readBlock())
+        {
+            return false;
+        }
+    }
+
+    uint64_t ts;
+    uint32_t size;
+    if (m_block.size() - m_offset < sizeof(ts) + sizeof(size))
+    {
+        SWSS_LOG_ERROR("Recording file: truncated record");
+        return false;
+    }
+    memcpy(&ts, &m_block[m_offset], sizeof(ts));
+    memcpy(&size, &m_block[m_offset + sizeof(ts)], sizeof(size));
+    ts = le64toh(ts);
+    size = le32toh(size);
+    m_offset += sizeof(ts) + sizeof(size);
+    if (m_block.size() - m_offset < size)
+    {
+        SWSS_LOG_ERROR("Recording file: truncated record");
+        return false;
+    }
+
+    timestamp = formatTimestamp(ts);
+    val.assign(&m_block[m_offset], size);
+    m_offset += size;
+    return true;
+}
+
+
+bool RecReader::readBlock()
+{
+    RecBlockHeader header;
+    if (m_ifs.read(reinterpret_cast<char *>(&header), sizeof(header)).gcount() != sizeof(header))
+    {
+        /* End of the file, or a block that was being written */
+        return false;
+    }
+    header.magic = le32toh(header.magic);
+    header.size = le32toh(header.size);
+    header.storedSize = le32toh(header.storedSize);
+    if (header.magic != REC_BLOCK_MAGIC)
+    {
+        SWSS_LOG_ERROR("Recording file: corrupted block");
+        return false;
+    }
+
+    std::vector<char> stored(header.storedSize);
+    if (m_ifs.read(stored.data(), header.storedSize).gcount() != static_cast<std::streamsize>(header.storedSize))
+    {
+        return false;
+    }
+
+    m_offset = 0;
+    switch (static_cast<RecCompression>(header.compression))
+    {
+        case RecCompression::NONE:
+            m_block.swap(stored);
+            return true;
+#ifdef HAVE_ZSTD
+        case RecCompression::ZSTD:
+            m_block.resize(header.size);
+            return ZSTD_decompress(m_block.data(), m_block.size(), stored.data(), stored.size()) == header.size;
+#endif
+#ifdef HAVE_LZ4
+        case RecCompression::LZ4:
+            m_block.resize(header.size);
+            return LZ4_decompress_safe(stored.data(), m_block.data(), static_cast<int>(stored.size()),
+                                       static_cast<int>(m_block.size())) == static_cast<int>(header.size);
+#endif
+        default:
+            SWSS_LOG_ERROR("Recording file: unsupported compression %u", header.compression);
+            return false;
+    }
+}
@@ -5,9 +5,41 @@
 #include <iostream>
 #include <sstream>
 #include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <stdint.h>
 
 namespace swss {
 
+/*
+ * Recording file formats. The text format is one "timestamp|record" line
+ * per record. The binary format is a file header followed by blocks of
+ * records, each block optionally compressed:
+ *
+ *   file header:  "SWSSREC" 0, uint32 version
+ *   block header: uint32 magic, uint8 compression, 3 reserved bytes,
+ *                 uint32 records size, uint32 stored size
+ *   record:       uint64 timestamp in microseconds since the epoch,
+ *                 uint32 size, record
+ *
+ * Integers are in little endian byte order.
+ */
+enum class RecFormat
+{
+    TEXT,
+    BINARY,
+};
+
+enum class RecCompression : uint8_t
+{
+    NONE = 0,
+    ZSTD = 1,
+    LZ4 = 2,
+};
+
 class RecBase {
 public:
     RecBase() = default;
@@ -40,12 +72,79 @@ public:
     void startRec(bool exit_if_failure);
     void record(const std::string& val);
 
+    /* To be set before startRec() */
+    void setFormat(RecFormat format) { m_format = format; }
+    void setCompression(RecCompression compression) { m_compression = compression; }
+    /*
+     * Rotate the file once it reaches maxSize bytes, 0 to never rotate,
+     * keeping maxFiles files including the current one. The rotated files
+     * are named file.rotated.1 and up, apart from the file.1 of logrotate.
+     */
+    void setMaxFileSize(uint64_t maxSize, unsigned int maxFiles) { m_maxFileSize = maxSize; m_maxFiles = maxFiles; }
+    RecFormat getFormat() { return m_format; }
+
+    /* Wait for the binary records to be written to the file */
+    void flush();
+
+    /* Records buffered per block, and blocks waiting for the writer thread */
+    static const size_t BLOCK_SIZE;
+    static const size_t MAX_PENDING_BLOCKS;
+
 protected:
     void logfileReopen();
 
 private:
     std::ofstream record_ofs;
     std::string fname;
+    /* Tasks may be recorded by orchagent worker threads */
+    std::mutex m_lock;
+
+    RecFormat m_format = RecFormat::TEXT;
+    RecCompression m_compression = RecCompression::NONE;
+    uint64_t m_maxFileSize = 0;
+    unsigned int m_maxFiles = 0;
+    uint64_t m_fileSize = 0;
+
+    /*
+     * The binary records are added to m_block, and full blocks are
+     * compressed and written by m_writer. The recording threads wait when
+     * MAX_PENDING_BLOCKS blocks are not written yet.
+     */
+    std::vector<char> m_block;
+    std::deque<std::vector<char>> m_blocks;
+    std::condition_variable m_blockReady;
+    std::condition_variable m_blockDone;
+    std::thread m_writer;
+    bool m_writing = false;
+    bool m_flush = false;
+    bool m_stop = false;
+
+    bool openFile();
+    void rotateFiles();
+    void writerThread();
+    void writeBlock(const std::vector<char> &block);
+};
+
+/* Reads the records of a recording file, in text or binary format */
+class RecReader {
+public:
+    RecReader() = default;
+    bool open(const std::string& fname);
+    bool isBinary() { return m_binary; }
+
+    /*
+     * Get the next record and its timestamp, formatted as in the text
+     * format. Return false at the end of the file or on a corrupted block.
+     */
+    bool next(std::string& timestamp, std::string& val);
+
+private:
+    std::ifstream m_ifs;
+    bool m_binary = false;
+    std::vector<char> m_block;
+    size_t m_offset = 0;
+
+    bool readBlock();
 };
 
 class SwSSRec : public RecWriter {
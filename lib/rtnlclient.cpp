@@ -0,0 +1,867 @@
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+#include <linux/if_bridge.h>
+#include <linux/neighbour.h>
+
+#include <system_error>
+
+#include "logger.h"
+#include "rtnlclient.h"
+
+using namespace std;
+using namespace swss;
+
+/* Requests sent by a single sendmsg(), well below the socket buffer size */
+#define RTNL_SEND_CHUNK_SIZE    (64 * 1024)
+#define RTNL_RECV_BUFFER_SIZE   (64 * 1024)
+#define RTNL_SOCKET_BUFFER_SIZE (4 * 1024 * 1024)
+
+#ifndef NETLINK_CAP_ACK
+#define NETLINK_CAP_ACK         10
+#endif
+
+#ifndef IFA_RT_PRIORITY
+#define IFA_RT_PRIORITY         9
+#endif
+
+namespace
+{
+    /* Append the netlink header and the family header of a request */
+    size_t startMsg(vector<uint8_t> &buf, uint16_t type, uint16_t flags, uint32_t seq,
+                    const void *hdr, size_t hdrLen)
+    {
+        size_t offset = NLMSG_ALIGN(buf.size());
+        buf.resize(offset + NLMSG_LENGTH(hdrLen));
+
+        auto *nlh = reinterpret_cast<struct nlmsghdr *>(&buf[offset]);
+        nlh->nlmsg_type = type;
+        nlh->nlmsg_flags = static_cast<uint16_t>(flags | NLM_F_REQUEST);
+        nlh->nlmsg_seq = seq;
+        nlh->nlmsg_pid = 0;
+        memcpy(NLMSG_DATA(nlh), hdr, hdrLen);
+
+        return offset;
+    }
+
+    void endMsg(vector<uint8_t> &buf, size_t offset)
+    {
+        buf.resize(NLMSG_ALIGN(buf.size()));
+        reinterpret_cast<struct nlmsghdr *>(&buf[offset])->nlmsg_len = static_cast<uint32_t>(buf.size() - offset);
+    }
+
+    size_t addAttr(vector<uint8_t> &buf, uint16_t type, const void *data, size_t len)
+    {
+        size_t offset = RTA_ALIGN(buf.size());
+        buf.resize(offset + RTA_LENGTH(len));
+
+        auto *rta = reinterpret_cast<struct rtattr *>(&buf[offset]);
+        rta->rta_type = type;
+        rta->rta_len = static_cast<unsigned short>(RTA_LENGTH(len));
+        if (len)
+        {
+            memcpy(RTA_DATA(rta), data, len);
+        }
+
+        return offset;
+    }
+
+    template <typename T>
+    void addAttr(vector<uint8_t> &buf, uint16_t type, T value)
+    {
+        addAttr(buf, type, &value, sizeof(value));
+    }
+
+    void addAttr(vector<uint8_t> &buf, uint16_t type, const string &value)
+    {
+        addAttr(buf, type, value.c_str(), value.size() + 1);
+    }
+
+    size_t startNest(vector<uint8_t> &buf, uint16_t type)
+    {
+        return addAttr(buf, static_cast<uint16_t>(type | NLA_F_NESTED), nullptr, 0);
+    }
+
+    void endNest(vector<uint8_t> &buf, size_t offset)
+    {
+        reinterpret_cast<struct rtattr *>(&buf[offset])->rta_len = static_cast<unsigned short>(buf.size() - offset);
+    }
+
+    void addIpAttr(vector<uint8_t> &buf, uint16_t type, const IpAddress &ip)
+    {
+        const ip_addr_t addr = ip.getIp();
+        if (ip.isV4())
+        {
+            addAttr(buf, type, &addr.ip_addr.ipv4_addr, sizeof(addr.ip_addr.ipv4_addr));
+        }
+        else
+        {
+            addAttr(buf, type, addr.ip_addr.ipv6_addr, sizeof(addr.ip_addr.ipv6_addr));
+        }
+    }
+
+    /* Parse the attributes of a message or of a nested attribute */
+    void parseAttrs(const struct rtattr **tb, int max, const struct rtattr *rta, int len)
+    {
+        memset(tb, 0, sizeof(*tb) * (max + 1));
+        for (; RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+        {
+            int type = rta->rta_type & NLA_TYPE_MASK;
+            if (type <= max)
+            {
+                tb[type] = rta;
+            }
+        }
+    }
+}
+
+RtnlClient::RtnlClient()
+{
+    m_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (m_fd < 0)
+    {
+        throw system_error(errno, system_category(), "Failed to open rtnetlink socket");
+    }
+
+    struct sockaddr_nl addr = {};
+    addr.nl_family = AF_NETLINK;
+    if (bind(m_fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) < 0)
+    {
+        int err = errno;
+        close(m_fd);
+        throw system_error(err, system_category(), "Failed to bind rtnetlink socket");
+    }
+
+    /* Batches are acknowledged at once, the acks must not echo the requests */
+    int one = 1;
+    int bufSize = RTNL_SOCKET_BUFFER_SIZE;
+    setsockopt(m_fd, SOL_NETLINK, NETLINK_CAP_ACK, &one, sizeof(one));
+    setsockopt(m_fd, SOL_SOCKET, SO_SNDBUF, &bufSize, sizeof(bufSize));
+    setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+
+    m_seq = static_cast<uint32_t>(time(nullptr));
+}
+
+RtnlClient::~RtnlClient()
+{
+    close(m_fd);
+}
+
+bool RtnlClient::isRetriable(int err)
+{
+    return err == -ENODEV || err == -EBUSY || err == -EAGAIN;
+}
+
+string RtnlClient::errorString(int err)
+{
+    return strerror(-err);
+}
+
+void RtnlClient::beginBatch()
+{
+    m_batching = true;
+    m_requests.clear();
+    m_requestOps.clear();
+    m_results.clear();
+}
+
+int RtnlClient::commitBatch()
+{
+    m_batching = false;
+
+    /* Requests are sent by chunks of whole messages */
+    size_t offset = 0;
+    size_t msg = 0;
+    while (offset < m_requests.size())
+    {
+        size_t end = offset;
+        size_t firstMsg = msg;
+        while (end < m_requests.size() && (end == offset || end - offset < RTNL_SEND_CHUNK_SIZE))
+        {
+            end += NLMSG_ALIGN(reinterpret_cast<struct nlmsghdr *>(&m_requests[end])->nlmsg_len);
+            msg++;
+        }
+
+        int err = sendRequests(offset, end, firstMsg, msg);
+        if (err)
+        {
+            /* Nothing is known about the requests left, report them failed */
+            for (size_t i = firstMsg; i < m_requestOps.size(); i++)
+            {
+                int &result = m_results[m_requestOps[i]];
+                result = result ? result : err;
+            }
+            break;
+        }
+        offset = end;
+    }
+
+    m_requests.clear();
+    m_requestOps.clear();
+
+    for (int result : m_results)
+    {
+        if (result)
+        {
+            return result;
+        }
+    }
+    return 0;
+}
+
+int RtnlClient::sendRequests(size_t begin, size_t end, size_t firstMsg, size_t lastMsg)
+{
+    struct sockaddr_nl kernel = {};
+    kernel.nl_family = AF_NETLINK;
+
+    ssize_t sent;
+    do
+    {
+        sent = sendto(m_fd, &m_requests[begin], end - begin, 0,
+                      reinterpret_cast<struct sockaddr *>(&kernel), sizeof(kernel));
+    } while (sent < 0 && errno == EINTR);
+
+    if (sent < 0)
+    {
+        SWSS_LOG_ERROR("Failed to send rtnetlink requests: %s", strerror(errno));
+        return -errno;
+    }
+
+    /* Collect an ack for each request, with its error if it failed */
+    vector<uint8_t> buf(RTNL_RECV_BUFFER_SIZE);
+    size_t pending = lastMsg - firstMsg;
+    while (pending)
+    {
+        ssize_t len = recv(m_fd, buf.data(), buf.size(), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            SWSS_LOG_ERROR("Failed to receive rtnetlink acks: %s", strerror(errno));
+            return -errno;
+        }
+
+        size_t left = static_cast<size_t>(len);
+        for (auto *nlh = reinterpret_cast<struct nlmsghdr *>(buf.data()); NLMSG_OK(nlh, left); nlh = NLMSG_NEXT(nlh, left))
+        {
+            if (nlh->nlmsg_type != NLMSG_ERROR)
+            {
+                continue;
+            }
+
+            size_t msg = nlh->nlmsg_seq - m_firstSeq;
+            if (msg < firstMsg || msg >= lastMsg)
+            {
+                continue;
+            }
+
+            auto *ack = reinterpret_cast<struct nlmsgerr *>(NLMSG_DATA(nlh));
+            m_results[m_requestOps[msg]] = ack->error;
+            pending--;
+        }
+    }
+
+    return 0;
+}
+
+int RtnlClient::dump(vector<uint8_t> &request, const function<void(const struct nlmsghdr *)> &handler)
+{
+    auto *req = reinterpret_cast<struct nlmsghdr *>(request.data());
+    req->nlmsg_flags |= NLM_F_DUMP;
+    req->nlmsg_seq = m_seq++;
+
+    struct sockaddr_nl kernel = {};
+    kernel.nl_family = AF_NETLINK;
+    if (sendto(m_fd, request.data(), request.size(), 0, reinterpret_cast<struct sockaddr *>(&kernel), sizeof(kernel)) < 0)
+    {
+        return -errno;
+    }
+
+    vector<uint8_t> buf(RTNL_RECV_BUFFER_SIZE);
+    while (true)
+    {
+        ssize_t len = recv(m_fd, buf.data(), buf.size(), 0);
+        if (len < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -errno;
+        }
+
+        size_t left = static_cast<size_t>(len);
+        for (auto *nlh = reinterpret_cast<struct nlmsghdr *>(buf.data()); NLMSG_OK(nlh, left); nlh = NLMSG_NEXT(nlh, left))
+        {
+            if (nlh->nlmsg_seq != req->nlmsg_seq)
+            {
+                continue;
+            }
+            if (nlh->nlmsg_type == NLMSG_DONE)
+            {
+                return 0;
+            }
+            if (nlh->nlmsg_type == NLMSG_ERROR)
+            {
+                return reinterpret_cast<struct nlmsgerr *>(NLMSG_DATA(nlh))->error;
+            }
+            handler(nlh);
+        }
+    }
+}
+
+/* Start a request, the previous results are dropped unless a batch is open */
+size_t RtnlClient::startRequest(uint16_t type, uint16_t flags, const void *hdr, size_t hdrLen)
+{
+    if (!m_batching)
+    {
+        m_requests.clear();
+        m_requestOps.clear();
+        m_results.clear();
+    }
+
+    if (m_requestOps.empty())
+    {
+        m_firstSeq = m_seq;
+    }
+
+    return startMsg(m_requests, type, static_cast<uint16_t>(flags | NLM_F_ACK), m_seq++, hdr, hdrLen);
+}
+
+int RtnlClient::endRequest(size_t offset)
+{
+    endMsg(m_requests, offset);
+    m_requestOps.push_back(m_results.size());
+    m_results.push_back(0);
+
+    return m_batching ? 0 : commitBatch();
+}
+
+/* Record an operation that failed before its request could be built */
+int RtnlClient::failRequest(int err)
+{
+    if (!m_batching)
+    {
+        m_results.clear();
+    }
+    m_results.push_back(err);
+
+    return err;
+}
+
+bool RtnlClient::linkExists(const string &ifname)
+{
+    return if_nametoindex(ifname.c_str()) != 0;
+}
+
+int RtnlClient::dumpLinks(const string &kind, const function<void(const char *, const struct rtattr *)> &handler)
+{
+    vector<uint8_t> request;
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+    size_t offset = startMsg(request, RTM_GETLINK, 0, 0, &ifi, sizeof(ifi));
+    endMsg(request, offset);
+
+    return dump(request, [&](const struct nlmsghdr *nlh) {
+        if (nlh->nlmsg_type != RTM_NEWLINK)
+        {
+            return;
+        }
+
+        const struct rtattr *tb[IFLA_MAX + 1];
+        const struct rtattr *linkinfo[IFLA_INFO_MAX + 1];
+        parseAttrs(tb, IFLA_MAX, IFLA_RTA(NLMSG_DATA(nlh)), static_cast<int>(IFLA_PAYLOAD(nlh)));
+        if (!tb[IFLA_IFNAME] || !tb[IFLA_LINKINFO])
+        {
+            return;
+        }
+
+        parseAttrs(linkinfo, IFLA_INFO_MAX, static_cast<const struct rtattr *>(RTA_DATA(tb[IFLA_LINKINFO])),
+                   static_cast<int>(RTA_PAYLOAD(tb[IFLA_LINKINFO])));
+        if (!linkinfo[IFLA_INFO_KIND] || kind != static_cast<const char *>(RTA_DATA(linkinfo[IFLA_INFO_KIND])))
+        {
+            return;
+        }
+
+        handler(static_cast<const char *>(RTA_DATA(tb[IFLA_IFNAME])), linkinfo[IFLA_INFO_DATA]);
+    });
+}
+
+int RtnlClient::getVrfs(map<string, uint32_t> &vrfs)
+{
+    SWSS_LOG_ENTER();
+
+    vrfs.clear();
+    return dumpLinks("vrf", [&](const char *ifname, const struct rtattr *infoData) {
+        if (!infoData)
+        {
+            return;
+        }
+
+        const struct rtattr *vrfinfo[IFLA_VRF_MAX + 1];
+        parseAttrs(vrfinfo, IFLA_VRF_MAX, static_cast<const struct rtattr *>(RTA_DATA(infoData)),
+                   static_cast<int>(RTA_PAYLOAD(infoData)));
+        if (vrfinfo[IFLA_VRF_TABLE])
+        {
+            vrfs[ifname] = *static_cast<const uint32_t *>(RTA_DATA(vrfinfo[IFLA_VRF_TABLE]));
+        }
+    });
+}
+
+int RtnlClient::getLinks(const string &kind, vector<string> &ifnames)
+{
+    SWSS_LOG_ENTER();
+
+    ifnames.clear();
+    return dumpLinks(kind, [&](const char *ifname, const struct rtattr *) {
+        ifnames.push_back(ifname);
+    });
+}
+
+int RtnlClient::newLink(const string &ifname, const string &kind, uint32_t flags, uint32_t link,
+                        const MacAddress *mac, const vector<pair<uint16_t, vector<uint8_t>>> &data)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_flags = flags;
+    ifi.ifi_change = flags;
+
+    size_t offset = startRequest(RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, &ifi, sizeof(ifi));
+    addAttr(m_requests, IFLA_IFNAME, ifname);
+    if (link)
+    {
+        addAttr(m_requests, IFLA_LINK, link);
+    }
+    if (mac)
+    {
+        addAttr(m_requests, IFLA_ADDRESS, mac->getMac(), ETHER_ADDR_LEN);
+    }
+
+    size_t linkinfo = startNest(m_requests, IFLA_LINKINFO);
+    addAttr(m_requests, IFLA_INFO_KIND, kind);
+    if (!data.empty())
+    {
+        size_t infoData = startNest(m_requests, IFLA_INFO_DATA);
+        for (const auto &attr : data)
+        {
+            addAttr(m_requests, attr.first, attr.second.data(), attr.second.size());
+        }
+        endNest(m_requests, infoData);
+    }
+    endNest(m_requests, linkinfo);
+
+    return endRequest(offset);
+}
+
+int RtnlClient::setLink(const string &ifname, uint32_t flags, uint32_t change,
+                        uint16_t attrType, const void *attr, size_t attrLen)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_flags = flags;
+    ifi.ifi_change = change;
+
+    size_t offset = startRequest(RTM_NEWLINK, 0, &ifi, sizeof(ifi));
+    addAttr(m_requests, IFLA_IFNAME, ifname);
+    if (attr)
+    {
+        addAttr(m_requests, attrType, attr, attrLen);
+    }
+
+    return endRequest(offset);
+}
+
+int RtnlClient::addBridge(const string &ifname, bool up)
+{
+    return newLink(ifname, "bridge", up ? IFF_UP : 0, 0, nullptr, {});
+}
+
+int RtnlClient::addDummy(const string &ifname)
+{
+    return newLink(ifname, "dummy", 0, 0, nullptr, {});
+}
+
+int RtnlClient::newVlan(const string &ifname, const string &parent, uint16_t vlanId,
+                        const MacAddress *mac, bool up)
+{
+    uint32_t link = if_nametoindex(parent.c_str());
+    if (!link)
+    {
+        return failRequest(-ENODEV);
+    }
+
+    vector<uint8_t> id(sizeof(vlanId));
+    memcpy(id.data(), &vlanId, sizeof(vlanId));
+    return newLink(ifname, "vlan", up ? IFF_UP : 0, link, mac, {{IFLA_VLAN_ID, id}});
+}
+
+int RtnlClient::addVlan(const string &ifname, const string &parent, uint16_t vlanId,
+                        const MacAddress &mac, bool up)
+{
+    return newVlan(ifname, parent, vlanId, &mac, up);
+}
+
+int RtnlClient::addVlan(const string &ifname, const string &parent, uint16_t vlanId, bool up)
+{
+    return newVlan(ifname, parent, vlanId, nullptr, up);
+}
+
+int RtnlClient::addVrf(const string &ifname, uint32_t table)
+{
+    vector<uint8_t> id(sizeof(table));
+    memcpy(id.data(), &table, sizeof(table));
+    return newLink(ifname, "vrf", 0, 0, nullptr, {{IFLA_VRF_TABLE, id}});
+}
+
+int RtnlClient::addVxlan(const string &ifname, uint32_t vni, const IpAddress *srcIp, const IpAddress *dstIp,
+                         uint16_t dstPort, bool learning, const MacAddress *mac)
+{
+    vector<pair<uint16_t, vector<uint8_t>>> data;
+
+    vector<uint8_t> id(sizeof(vni));
+    memcpy(id.data(), &vni, sizeof(vni));
+    data.emplace_back(IFLA_VXLAN_ID, id);
+
+    auto addIp = [&](uint16_t v4Type, uint16_t v6Type, const IpAddress &ip) {
+        const ip_addr_t addr = ip.getIp();
+        if (ip.isV4())
+        {
+            const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&addr.ip_addr.ipv4_addr);
+            data.emplace_back(v4Type, vector<uint8_t>(bytes, bytes + sizeof(addr.ip_addr.ipv4_addr)));
+        }
+        else
+        {
+            data.emplace_back(v6Type, vector<uint8_t>(addr.ip_addr.ipv6_addr, addr.ip_addr.ipv6_addr + 16));
+        }
+    };
+    if (srcIp)
+    {
+        addIp(IFLA_VXLAN_LOCAL, IFLA_VXLAN_LOCAL6, *srcIp);
+    }
+    if (dstIp)
+    {
+        addIp(IFLA_VXLAN_GROUP, IFLA_VXLAN_GROUP6, *dstIp);
+    }
+
+    uint16_t port = htons(dstPort);
+    const uint8_t *portBytes = reinterpret_cast<const uint8_t *>(&port);
+    data.emplace_back(IFLA_VXLAN_PORT, vector<uint8_t>(portBytes, portBytes + sizeof(port)));
+    data.emplace_back(IFLA_VXLAN_LEARNING, vector<uint8_t>{static_cast<uint8_t>(learning)});
+
+    return newLink(ifname, "vxlan", 0, 0, mac, data);
+}
+
+int RtnlClient::delLink(const string &ifname)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+
+    size_t offset = startRequest(RTM_DELLINK, 0, &ifi, sizeof(ifi));
+    addAttr(m_requests, IFLA_IFNAME, ifname);
+
+    return endRequest(offset);
+}
+
+int RtnlClient::setLinkAdminState(const string &ifname, bool up)
+{
+    return setLink(ifname, up ? IFF_UP : 0, IFF_UP, 0, nullptr, 0);
+}
+
+int RtnlClient::setLinkMtu(const string &ifname, uint32_t mtu)
+{
+    return setLink(ifname, 0, 0, IFLA_MTU, &mtu, sizeof(mtu));
+}
+
+int RtnlClient::setLinkMac(const string &ifname, const MacAddress &mac)
+{
+    return setLink(ifname, 0, 0, IFLA_ADDRESS, mac.getMac(), ETHER_ADDR_LEN);
+}
+
+int RtnlClient::setLinkMaster(const string &ifname, const string &master)
+{
+    uint32_t index = 0;
+    if (!master.empty())
+    {
+        index = if_nametoindex(master.c_str());
+        if (!index)
+        {
+            return failRequest(-ENODEV);
+        }
+    }
+
+    return setLink(ifname, 0, 0, IFLA_MASTER, &index, sizeof(index));
+}
+
+int RtnlClient::setBridgeOption(const string &ifname, uint16_t type, const void *data, size_t len)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_UNSPEC;
+
+    size_t offset = startRequest(RTM_NEWLINK, 0, &ifi, sizeof(ifi));
+    addAttr(m_requests, IFLA_IFNAME, ifname);
+    size_t linkinfo = startNest(m_requests, IFLA_LINKINFO);
+    addAttr(m_requests, IFLA_INFO_KIND, string("bridge"));
+    size_t infoData = startNest(m_requests, IFLA_INFO_DATA);
+    addAttr(m_requests, type, data, len);
+    endNest(m_requests, infoData);
+    endNest(m_requests, linkinfo);
+
+    return endRequest(offset);
+}
+
+int RtnlClient::setBridgeVlanFiltering(const string &ifname, bool enable)
+{
+    uint8_t value = enable;
+    return setBridgeOption(ifname, IFLA_BR_VLAN_FILTERING, &value, sizeof(value));
+}
+
+int RtnlClient::setBridgeNoLinkLocalLearn(const string &ifname, bool enable)
+{
+    struct br_boolopt_multi opt = {};
+    opt.optmask = 1U << BR_BOOLOPT_NO_LL_LEARN;
+    opt.optval = enable ? opt.optmask : 0;
+    return setBridgeOption(ifname, IFLA_BR_MULTI_BOOLOPT, &opt, sizeof(opt));
+}
+
+int RtnlClient::setBridgePortLearning(const string &ifname, bool enable)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_BRIDGE;
+    ifi.ifi_index = static_cast<int>(if_nametoindex(ifname.c_str()));
+    if (!ifi.ifi_index)
+    {
+        return failRequest(-ENODEV);
+    }
+
+    size_t offset = startRequest(RTM_SETLINK, 0, &ifi, sizeof(ifi));
+    size_t protinfo = startNest(m_requests, IFLA_PROTINFO);
+    addAttr(m_requests, IFLA_BRPORT_LEARNING, static_cast<uint8_t>(enable));
+    endNest(m_requests, protinfo);
+
+    return endRequest(offset);
+}
+
+int RtnlClient::bridgeVlans(uint16_t type, const string &ifname, const vector<BridgeVlanRange> &vlans, bool self)
+{
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_BRIDGE;
+    ifi.ifi_index = static_cast<int>(if_nametoindex(ifname.c_str()));
+    if (!ifi.ifi_index)
+    {
+        return failRequest(-ENODEV);
+    }
+
+    size_t offset = startRequest(type, 0, &ifi, sizeof(ifi));
+    size_t afspec = startNest(m_requests, IFLA_AF_SPEC);
+    if (self)
+    {
+        addAttr(m_requests, IFLA_BRIDGE_FLAGS, static_cast<uint16_t>(BRIDGE_FLAGS_SELF));
+    }
+
+    /* The kernel applies the entries in order, a range is a begin and an end entry */
+    for (const auto &range : vlans)
+    {
+        uint16_t flags = range.pvidUntagged ? (BRIDGE_VLAN_INFO_PVID | BRIDGE_VLAN_INFO_UNTAGGED) : 0;
+        struct bridge_vlan_info vinfo = {};
+        if (range.lastVlanId > range.vlanId)
+        {
+            vinfo.flags = static_cast<uint16_t>(flags | BRIDGE_VLAN_INFO_RANGE_BEGIN);
+            vinfo.vid = range.vlanId;
+            addAttr(m_requests, IFLA_BRIDGE_VLAN_INFO, vinfo);
+            vinfo.flags = static_cast<uint16_t>(flags | BRIDGE_VLAN_INFO_RANGE_END);
+            vinfo.vid = range.lastVlanId;
+            addAttr(m_requests, IFLA_BRIDGE_VLAN_INFO, vinfo);
+        }
+        else
+        {
+            vinfo.flags = flags;
+            vinfo.vid = range.vlanId;
+            addAttr(m_requests, IFLA_BRIDGE_VLAN_INFO, vinfo);
+        }
+    }
+    endNest(m_requests, afspec);
+
+    return endRequest(offset);
+}
+
+int RtnlClient::addBridgeVlan(const string &ifname, uint16_t vlanId, bool pvidUntagged,
+                              bool self, uint16_t lastVlanId)
+{
+    return bridgeVlans(RTM_SETLINK, ifname, {{vlanId, lastVlanId, pvidUntagged}}, self);
+}
+
+int RtnlClient::delBridgeVlan(const string &ifname, uint16_t vlanId, bool self, uint16_t lastVlanId)
+{
+    return bridgeVlans(RTM_DELLINK, ifname, {{vlanId, lastVlanId, false}}, self);
+}
+
+int RtnlClient::addBridgeVlans(const string &ifname, const vector<BridgeVlanRange> &vlans, bool self)
+{
+    return bridgeVlans(RTM_SETLINK, ifname, vlans, self);
+}
+
+int RtnlClient::delBridgeVlans(const string &ifname, const vector<BridgeVlanRange> &vlans, bool self)
+{
+    return bridgeVlans(RTM_DELLINK, ifname, vlans, self);
+}
+
+int RtnlClient::getBridgeVlans(const string &ifname, vector<uint16_t> &vlans)
+{
+    SWSS_LOG_ENTER();
+
+    int index = static_cast<int>(if_nametoindex(ifname.c_str()));
+    if (!index)
+    {
+        return -ENODEV;
+    }
+
+    vector<uint8_t> request;
+    struct ifinfomsg ifi = {};
+    ifi.ifi_family = AF_BRIDGE;
+    size_t offset = startMsg(request, RTM_GETLINK, 0, 0, &ifi, sizeof(ifi));
+    addAttr(request, IFLA_EXT_MASK, static_cast<uint32_t>(RTEXT_FILTER_BRVLAN));
+    endMsg(request, offset);
+
+    vlans.clear();
+    return dump(request, [&](const struct nlmsghdr *nlh) {
+        auto *msg = static_cast<const struct ifinfomsg *>(NLMSG_DATA(nlh));
+        if (nlh->nlmsg_type != RTM_NEWLINK || msg->ifi_index != index)
+        {
+            return;
+        }
+
+        const struct rtattr *tb[IFLA_MAX + 1];
+        parseAttrs(tb, IFLA_MAX, IFLA_RTA(msg), static_cast<int>(IFLA_PAYLOAD(nlh)));
+        if (!tb[IFLA_AF_SPEC])
+        {
+            return;
+        }
+
+        int len = static_cast<int>(RTA_PAYLOAD(tb[IFLA_AF_SPEC]));
+        for (auto *rta = static_cast<const struct rtattr *>(RTA_DATA(tb[IFLA_AF_SPEC])); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+        {
+            if ((rta->rta_type & NLA_TYPE_MASK) == IFLA_BRIDGE_VLAN_INFO)
+            {
+                vlans.push_back(static_cast<const struct bridge_vlan_info *>(RTA_DATA(rta))->vid);
+            }
+        }
+    });
+}
+
+int RtnlClient::address(uint16_t type, uint16_t flags, const string &ifname, const IpPrefix &prefix,
+                        bool broadcast, uint32_t metric)
+{
+    struct ifaddrmsg ifa = {};
+    ifa.ifa_family = prefix.isV4() ? AF_INET : AF_INET6;
+    ifa.ifa_prefixlen = static_cast<unsigned char>(prefix.getMaskLength());
+    ifa.ifa_index = if_nametoindex(ifname.c_str());
+    if (!ifa.ifa_index)
+    {
+        return failRequest(-ENODEV);
+    }
+
+    size_t offset = startRequest(type, flags, &ifa, sizeof(ifa));
+    addIpAttr(m_requests, IFA_LOCAL, prefix.getIp());
+    addIpAttr(m_requests, IFA_ADDRESS, prefix.getIp());
+    if (broadcast && prefix.isV4())
+    {
+        addIpAttr(m_requests, IFA_BROADCAST, prefix.getBroadcastIp());
+    }
+    if (metric)
+    {
+        addAttr(m_requests, IFA_RT_PRIORITY, metric);
+    }
+
+    return endRequest(offset);
+}
+
+int RtnlClient::addAddress(const string &ifname, const IpPrefix &prefix, bool broadcast, uint32_t metric)
+{
+    return address(RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL, ifname, prefix, broadcast, metric);
+}
+
+int RtnlClient::delAddress(const string &ifname, const IpPrefix &prefix)
+{
+    return address(RTM_DELADDR, 0, ifname, prefix, false, 0);
+}
+
+int RtnlClient::neighbor(uint16_t type, uint16_t flags, const string &ifname,
+                         const IpAddress &ip, const MacAddress *mac)
+{
+    struct ndmsg ndm = {};
+    ndm.ndm_family = ip.isV4() ? AF_INET : AF_INET6;
+    ndm.ndm_state = NUD_PERMANENT;
+    ndm.ndm_ifindex = static_cast<int>(if_nametoindex(ifname.c_str()));
+    if (!ndm.ndm_ifindex)
+    {
+        return failRequest(-ENODEV);
+    }
+
+    size_t offset = startRequest(type, flags, &ndm, sizeof(ndm));
+    addIpAttr(m_requests, NDA_DST, ip);
+    if (mac)
+    {
+        addAttr(m_requests, NDA_LLADDR, mac->getMac(), ETHER_ADDR_LEN);
+    }
+
+    return endRequest(offset);
+}
+
+int RtnlClient::addNeighbor(const string &ifname, const IpAddress &ip, const MacAddress &mac)
+{
+    return neighbor(RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_EXCL, ifname, ip, &mac);
+}
+
+int RtnlClient::delNeighbor(const string &ifname, const IpAddress &ip)
+{
+    return neighbor(RTM_DELNEIGH, 0, ifname, ip, nullptr);
+}
+
+int RtnlClient::addRoute(const string &ifname, const IpPrefix &prefix, uint32_t metric)
+{
+    struct rtmsg rtm = {};
+    rtm.rtm_family = prefix.isV4() ? AF_INET : AF_INET6;
+    rtm.rtm_dst_len = static_cast<unsigned char>(prefix.getMaskLength());
+    rtm.rtm_table = RT_TABLE_MAIN;
+    rtm.rtm_protocol = RTPROT_BOOT;
+    rtm.rtm_scope = RT_SCOPE_LINK;
+    rtm.rtm_type = RTN_UNICAST;
+
+    uint32_t oif = if_nametoindex(ifname.c_str());
+    if (!oif)
+    {
+        return failRequest(-ENODEV);
+    }
+
+    size_t offset = startRequest(RTM_NEWROUTE, NLM_F_CREATE | NLM_F_EXCL, &rtm, sizeof(rtm));
+    addIpAttr(m_requests, RTA_DST, prefix.getIp());
+    addAttr(m_requests, RTA_OIF, oif);
+    if (metric)
+    {
+        addAttr(m_requests, RTA_PRIORITY, metric);
+    }
+
+    return endRequest(offset);
+}
+
+int RtnlClient::delRoute(const IpPrefix &prefix)
+{
+    struct rtmsg rtm = {};
+    rtm.rtm_family = prefix.isV4() ? AF_INET : AF_INET6;
+    rtm.rtm_dst_len = static_cast<unsigned char>(prefix.getMaskLength());
+    rtm.rtm_table = RT_TABLE_MAIN;
+    rtm.rtm_scope = RT_SCOPE_NOWHERE;
+
+    size_t offset = startRequest(RTM_DELROUTE, 0, &rtm, sizeof(rtm));
+    addIpAttr(m_requests, RTA_DST, prefix.getIp());
+
+    return endRequest(offset);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <stdint.h>
+#include <linux/rtnetlink.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+#include "macaddress.h"
+
+namespace swss {
+
+/*
+ * In-process replacement of the ip/bridge commands run by the cfgmgr
+ * daemons. Each operation is sent to the kernel as a rtnetlink request and
+ * returns 0 once it is acknowledged, or the negative errno of the failure.
+ *
+ * Between beginBatch() and commitBatch() the operations are only queued
+ * (and return 0, unless the request cannot be built), then commitBatch()
+ * sends them together and collects all the acknowledgements. The result of
+ * each queued operation is then available from getBatchResults(), in the
+ * order of the operations.
+ *
+ * Interface names given as master, parent or bridge port are resolved when
+ * the operation is queued, so they must exist before the batch is started.
+ */
+class RtnlClient
+{
+public:
+    RtnlClient();
+    ~RtnlClient();
+
+    RtnlClient(const RtnlClient&) = delete;
+    RtnlClient& operator=(const RtnlClient&) = delete;
+
+    /* Links, "ip link" */
+    bool linkExists(const std::string &ifname);
+    /* VRF devices and their routing table, "ip -d link show type vrf" */
+    int getVrfs(std::map<std::string, uint32_t> &vrfs);
+    /* Links of a kind, "ip link show type <kind>" */
+    int getLinks(const std::string &kind, std::vector<std::string> &ifnames);
+    int addBridge(const std::string &ifname, bool up);
+    int addDummy(const std::string &ifname);
+    int addVlan(const std::string &ifname, const std::string &parent, uint16_t vlanId,
+                const MacAddress &mac, bool up);
+    int addVlan(const std::string &ifname, const std::string &parent, uint16_t vlanId, bool up);
+    int addVrf(const std::string &ifname, uint32_t table);
+    /* The source and remote addresses and the MAC address are optional */
+    int addVxlan(const std::string &ifname, uint32_t vni, const IpAddress *srcIp, const IpAddress *dstIp,
+                 uint16_t dstPort, bool learning, const MacAddress *mac = nullptr);
+    int delLink(const std::string &ifname);
+    int setLinkAdminState(const std::string &ifname, bool up);
+    int setLinkMtu(const std::string &ifname, uint32_t mtu);
+    int setLinkMac(const std::string &ifname, const MacAddress &mac);
+    /* An empty master detaches the link from its master */
+    int setLinkMaster(const std::string &ifname, const std::string &master);
+    int setBridgeVlanFiltering(const std::string &ifname, bool enable);
+    int setBridgeNoLinkLocalLearn(const std::string &ifname, bool enable);
+    /* MAC learning of a bridge port, "bridge link set dev <ifname> learning" */
+    int setBridgePortLearning(const std::string &ifname, bool enable);
+
+    /*
+     * Bridge VLANs, "bridge vlan". With self the VLAN is set on the bridge
+     * device itself instead of the bridge port. The VLANs from vlanId to
+     * lastVlanId are set by a single request.
+     */
+    int addBridgeVlan(const std::string &ifname, uint16_t vlanId, bool pvidUntagged,
+                      bool self = false, uint16_t lastVlanId = 0);
+    int delBridgeVlan(const std::string &ifname, uint16_t vlanId,
+                      bool self = false, uint16_t lastVlanId = 0);
+    int getBridgeVlans(const std::string &ifname, std::vector<uint16_t> &vlans);
+
+    /*
+     * Several VLANs of a port set by a single request. A PVID can't be a
+     * range, the kernel rejects pvidUntagged with lastVlanId.
+     */
+    struct BridgeVlanRange
+    {
+        uint16_t vlanId;
+        uint16_t lastVlanId;
+        bool pvidUntagged;
+    };
+    int addBridgeVlans(const std::string &ifname, const std::vector<BridgeVlanRange> &vlans, bool self = false);
+    int delBridgeVlans(const std::string &ifname, const std::vector<BridgeVlanRange> &vlans, bool self = false);
+
+    /*
+     * Addresses, neighbors and routes, "ip address", "ip neigh" and "ip route".
+     * With broadcast an IPv4 address gets the broadcast address of its subnet,
+     * a non zero metric is set on the prefix route of the address.
+     */
+    int addAddress(const std::string &ifname, const IpPrefix &prefix,
+                   bool broadcast = false, uint32_t metric = 0);
+    int delAddress(const std::string &ifname, const IpPrefix &prefix);
+    int addNeighbor(const std::string &ifname, const IpAddress &ip, const MacAddress &mac);
+    int delNeighbor(const std::string &ifname, const IpAddress &ip);
+    int addRoute(const std::string &ifname, const IpPrefix &prefix, uint32_t metric = 0);
+    int delRoute(const IpPrefix &prefix);
+
+    void beginBatch();
+    /* Return 0 if all the queued operations succeeded, else the first error */
+    int commitBatch();
+    const std::vector<int> &getBatchResults() const
+    {
+        return m_results;
+    }
+
+    /* Errors worth a retry, such as a port that is not created yet */
+    static bool isRetriable(int err);
+    static std::string errorString(int err);
+
+private:
+    int m_fd = -1;
+    uint32_t m_seq = 0;
+    bool m_batching = false;
+
+    /*
+     * Queued requests, back to back, the operation of each request and the
+     * result of each operation. Request i is sent with sequence m_firstSeq + i.
+     */
+    std::vector<uint8_t> m_requests;
+    std::vector<size_t> m_requestOps;
+    std::vector<int> m_results;
+    uint32_t m_firstSeq = 0;
+
+    size_t startRequest(uint16_t type, uint16_t flags, const void *hdr, size_t hdrLen);
+    int endRequest(size_t offset);
+    int failRequest(int err);
+
+    int newLink(const std::string &ifname, const std::string &kind, uint32_t flags, uint32_t link,
+                const MacAddress *mac, const std::vector<std::pair<uint16_t, std::vector<uint8_t>>> &data);
+    int newVlan(const std::string &ifname, const std::string &parent, uint16_t vlanId,
+                const MacAddress *mac, bool up);
+    int setLink(const std::string &ifname, uint32_t flags, uint32_t change,
+                uint16_t attrType, const void *attr, size_t attrLen);
+    int setBridgeOption(const std::string &ifname, uint16_t type, const void *data, size_t len);
+    int bridgeVlans(uint16_t type, const std::string &ifname, const std::vector<BridgeVlanRange> &vlans, bool self);
+    int address(uint16_t type, uint16_t flags, const std::string &ifname, const IpPrefix &prefix,
+                bool broadcast, uint32_t metric);
+    int neighbor(uint16_t type, uint16_t flags, const std::string &ifname,
+                 const IpAddress &ip, const MacAddress *mac);
+
+    int sendRequests(size_t begin, size_t end, size_t firstMsg, size_t lastMsg);
+    int dump(std::vector<uint8_t> &request, const std::function<void(const struct nlmsghdr *)> &handler);
+    /* Dump the links of a kind, with the name and the IFLA_INFO_DATA attribute of each */
+    int dumpLinks(const std::string &kind, const std::function<void(const char *, const struct rtattr *)> &handler);
+};
+
+}
@@ -0,0 +1,74 @@
+#include "tablebatchreader.h"
+#include "logger.h"
+#include <hiredis/hiredis.h>
+#include <stdexcept>
+
+using namespace swss;
+
+TableBatchReader::TableBatchReader(DBConnector *db, const std::string &tableName) :
+    m_db(db),
+    m_table(tableName, SonicDBConfig::getSeparator(db))
+{
+}
+
+void TableBatchReader::get(const std::vector<std::string> &keys, std::vector<std::vector<FieldValueTuple>> &values)
+{
+    values.assign(keys.size(), std::vector<FieldValueTuple>());
+    if (keys.empty())
+    {
+        return;
+    }
+
+    std::string buffer;
+    for (const auto &key : keys)
+    {
+        formatHgetall(m_table.getKeyName(key), buffer);
+    }
+
+    redisContext *context = m_db->getContext();
+    if (redisAppendFormattedCommand(context, buffer.data(), buffer.size()) != REDIS_OK)
+    {
+        throw std::runtime_error("Failed to append the HGETALL of table " + m_table.getTableName());
+    }
+
+    m_stats.batches++;
+    m_stats.commands += keys.size();
+    m_stats.requestBytes += buffer.size();
+
+    /* All the replies are read, even after an error one, to keep the connection in sync */
+    std::string error;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        redisReply *reply = nullptr;
+        if (redisGetReply(context, reinterpret_cast<void **>(&reply)) != REDIS_OK || reply == nullptr)
+        {
+            throw std::runtime_error("Failed to read the HGETALL of table " + m_table.getTableName() +
+                                     ": " + context->errstr);
+        }
+
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements % 2 != 0)
+        {
+            if (error.empty())
+            {
+                error = reply->type == REDIS_REPLY_ERROR ? std::string(reply->str, reply->len) : "unexpected reply";
+            }
+            freeReplyObject(reply);
+            continue;
+        }
+
+        auto &fvs = values[i];
+        fvs.reserve(reply->elements / 2);
+        for (size_t j = 0; j < reply->elements; j += 2)
+        {
+            fvs.emplace_back(std::string(reply->element[j]->str, reply->element[j]->len),
+                             std::string(reply->element[j + 1]->str, reply->element[j + 1]->len));
+        }
+        m_stats.replyBytes += getReplySize(fvs);
+        freeReplyObject(reply);
+    }
+
+    if (!error.empty())
+    {
+        throw std::runtime_error("Failed to read table " + m_table.getTableName() + ": " + error);
+    }
+}
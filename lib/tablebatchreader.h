@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "dbconnector.h"
+#include "table.h"
+
+namespace swss {
+
+/*
+ * Reads the fields of many keys of a table in one round trip. Table::get()
+ * sends an HGETALL and waits for its reply, and RedisPipeline only buffers
+ * the commands whose reply is not needed, so reading N keys with them costs
+ * N round trips. Here the N HGETALL are written to the connection at once,
+ * then their replies are read in order.
+ */
+class TableBatchReader
+{
+public:
+    /* Counted since the reader was created */
+    struct Stats
+    {
+        /* Round trips, one per get() with at least one key */
+        uint64_t batches = 0;
+        uint64_t commands = 0;
+        /* Size of the commands and of the replies, as sent on the connection */
+        uint64_t requestBytes = 0;
+        uint64_t replyBytes = 0;
+    };
+
+    TableBatchReader(DBConnector *db, const std::string &tableName);
+
+    /* The fields of each key, in the order of the keys, empty if a key does not exist */
+    void get(const std::vector<std::string> &keys, std::vector<std::vector<FieldValueTuple>> &values);
+
+    const Stats &getStats() const
+    {
+        return m_stats;
+    }
+
+    /* Append the HGETALL of a key to a buffer of commands */
+    static void formatHgetall(const std::string &key, std::string &buffer)
+    {
+        buffer += "*2\r\n$7\r\nHGETALL\r\n$" + std::to_string(key.size()) + "\r\n" + key + "\r\n";
+    }
+
+    /* Size of the reply of an HGETALL */
+    static size_t getReplySize(const std::vector<FieldValueTuple> &values)
+    {
+        size_t size = 3 + std::to_string(values.size() * 2).size();
+        for (const auto &fv : values)
+        {
+            for (const std::string *str : { &fvField(fv), &fvValue(fv) })
+            {
+                size += 5 + std::to_string(str->size()).size() + str->size();
+            }
+        }
+        return size;
+    }
+
+private:
+    DBConnector *m_db;
+    TableBase m_table;
+    Stats m_stats;
+};
+
+}
@@ -14,23 +14,33 @@
 #include "neighsync.h"
 #include "warm_restart.h"
 #include <algorithm>
+#include <deque>
 
 using namespace std;
 using namespace swss;
 
 NeighSync::NeighSync(RedisPipeline *pipelineAppDB, DBConnector *stateDb, DBConnector *cfgDb) :
-    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME),
+    m_pipeline(pipelineAppDB),
     m_stateNeighRestoreTable(stateDb, STATE_NEIGH_RESTORE_TABLE_NAME),
-    m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME),
-    m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
+    m_neighTable(pipelineAppDB, APP_NEIGH_TABLE_NAME, true),
+    m_cfgPeerSwitchTable(cfgDb, CFG_PEER_SWITCH_TABLE_NAME),
     m_cfgVlanInterfaceTable(cfgDb, CFG_VLAN_INTF_TABLE_NAME),
-    m_cfgPeerSwitchTable(cfgDb, CFG_PEER_SWITCH_TABLE_NAME)
+    m_cfgLagInterfaceTable(cfgDb, CFG_LAG_INTF_TABLE_NAME),
+    m_cfgInterfaceTable(cfgDb, CFG_INTF_TABLE_NAME)
 {
     m_AppRestartAssist = new AppRestartAssist(pipelineAppDB, "neighsyncd", "swss", DEFAULT_NEIGHSYNC_WARMSTART_TIMER);
     if (m_AppRestartAssist)
     {
         m_AppRestartAssist->registerAppTable(APP_NEIGH_TABLE_NAME, &m_neighTable);
     }
+
+    /* The subscribers start with the existing entries, load them before any neighbor event */
+    for (auto selectable : getConfigSelectables())
+    {
+        processConfig(selectable);
+    }
+
+    m_stats.intervalStart = chrono::steady_clock::now();
 }
 
 NeighSync::~NeighSync()
@@ -63,14 +73,16 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     string key;
     string family;
     string intfName;
-    std::vector<std::string> peerSwitchKeys;
-    m_cfgPeerSwitchTable.getKeys(peerSwitchKeys);
-    bool is_dualtor = peerSwitchKeys.size() > 0;
+    bool is_dualtor = !m_peerSwitches.empty();
 
     if ((nlmsg_type != RTM_NEWNEIGH) && (nlmsg_type != RTM_GETNEIGH) &&
         (nlmsg_type != RTM_DELNEIGH))
         return;
 
+    m_eventTime = chrono::steady_clock::now();
+    m_stats.events++;
+    m_stats.intervalEvents++;
+
     if (rtnl_neigh_get_family(neigh) == AF_INET)
         family = IPV4_NAME;
     else if (rtnl_neigh_get_family(neigh) == AF_INET6)
@@ -169,6 +181,8 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     }
     else
     {
+        m_pendingEvents.push_back(m_eventTime);
+        m_stats.writes++;
         if (delete_key == true)
         {
             m_neighTable.del(key);
@@ -178,49 +192,180 @@ void NeighSync::onMsg(int nlmsg_type, struct nl_object *obj)
     }
 }
 
-/* To check the ipv6 link local is enabled on a given port */
-bool NeighSync::isLinkLocalEnabled(const string &port)
+vector<Selectable *> NeighSync::getConfigSelectables()
 {
-    vector<FieldValueTuple> values;
+    return { &m_cfgPeerSwitchTable, &m_cfgVlanInterfaceTable, &m_cfgLagInterfaceTable, &m_cfgInterfaceTable };
+}
 
-    if (!port.compare(0, strlen("Vlan"), "Vlan"))
+bool NeighSync::processConfig(Selectable *selectable)
+{
+    for (auto table : { &m_cfgPeerSwitchTable, &m_cfgVlanInterfaceTable, &m_cfgLagInterfaceTable, &m_cfgInterfaceTable })
     {
-        if (!m_cfgVlanInterfaceTable.get(port, values))
+        if (selectable != table)
         {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
+            continue;
         }
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        table->pops(entries);
+        for (const auto &entry : entries)
+        {
+            updateConfigCache(*table, entry);
+        }
+        return true;
     }
-    else if (!port.compare(0, strlen("PortChannel"), "PortChannel"))
+
+    return false;
+}
+
+void NeighSync::updateConfigCache(SubscriberStateTable &table, const KeyOpFieldsValuesTuple &entry)
+{
+    const string &key = kfvKey(entry);
+    bool set = kfvOp(entry) == SET_COMMAND;
+
+    if (&table == &m_cfgPeerSwitchTable)
     {
-        if (!m_cfgLagInterfaceTable.get(port, values))
+        if (set)
         {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
+            m_peerSwitches.insert(key);
         }
+        else
+        {
+            m_peerSwitches.erase(key);
+        }
+        return;
     }
-    else if (!port.compare(0, strlen("Ethernet"), "Ethernet"))
+
+    /* Only the interface entries, not their IP address entries */
+    if (key.find(config_db_key_delimiter) != string::npos)
+    {
+        return;
+    }
+
+    auto &enabled = &table == &m_cfgVlanInterfaceTable ? m_vlanIntfLinkLocal :
+                    &table == &m_cfgLagInterfaceTable ? m_lagIntfLinkLocal : m_intfLinkLocal;
+
+    const auto &values = kfvFieldsValues(entry);
+    auto it = std::find_if(values.begin(), values.end(), [](const FieldValueTuple& t){ return t.first == "ipv6_use_link_local_only";});
+    if (set && it != values.end() && it->second == "enable")
     {
-        if (!m_cfgInterfaceTable.get(port, values))
+        enabled.insert(key);
+    }
+    else
+    {
+        enabled.erase(key);
+    }
+}
+
+/*
+ * The latency of an event is measured up to the flush of the pipeline that
+ * carries its write. A write sent earlier, because the pipeline filled up,
+ * is still accounted until that flush.
+ */
+void NeighSync::flush()
+{
+    m_pipeline->flush();
+
+    if (m_pendingEvents.empty())
+    {
+        return;
+    }
+
+    auto now = chrono::steady_clock::now();
+    for (const auto &eventTime : m_pendingEvents)
+    {
+        addLatency(static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(now - eventTime).count()));
+    }
+    m_pendingEvents.clear();
+}
+
+/* Reservoir sampling keeps the p99 accurate during an event storm */
+void NeighSync::addLatency(uint64_t latencyUs)
+{
+    auto &stats = m_stats;
+    stats.maxLatencyUs = max(stats.maxLatencyUs, latencyUs);
+
+    if (stats.latencyUs.size() < NEIGH_LATENCY_SAMPLES)
+    {
+        stats.latencyUs.push_back(latencyUs);
+    }
+    else
+    {
+        uint64_t slot = m_sampler() % (stats.intervalLatencies + 1);
+        if (slot < NEIGH_LATENCY_SAMPLES)
         {
-            SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
-            return false;
+            stats.latencyUs[slot] = latencyUs;
         }
     }
+    stats.intervalLatencies++;
+}
+
+void NeighSync::publishStats(Table &statsTable)
+{
+    auto &stats = m_stats;
+    auto now = chrono::steady_clock::now();
+    auto intervalUs = chrono::duration_cast<chrono::microseconds>(now - stats.intervalStart).count();
+    uint64_t rate = intervalUs > 0 ? stats.intervalEvents * 1000000 / static_cast<uint64_t>(intervalUs) : 0;
+
+    /* Nothing to report until events come, once the rate went back to 0 */
+    if (stats.intervalEvents == 0 && stats.lastRate == 0)
+    {
+        stats.intervalStart = now;
+        return;
+    }
+
+    uint64_t p99 = 0;
+    if (!stats.latencyUs.empty())
+    {
+        auto nth = stats.latencyUs.begin() + static_cast<long>(stats.latencyUs.size() * 99 / 100);
+        nth_element(stats.latencyUs.begin(), nth, stats.latencyUs.end());
+        p99 = *nth;
+    }
+
+    vector<FieldValueTuple> fvs = {
+        {"events", to_string(stats.events)},
+        {"writes", to_string(stats.writes)},
+        {"events_per_sec", to_string(rate)},
+        {"latency_p99_us", to_string(p99)},
+        {"latency_max_us", to_string(stats.maxLatencyUs)}
+    };
+    statsTable.set(NEIGHSYNCD_EVENT_STATS_KEY, fvs);
+
+    stats.lastRate = rate;
+    stats.intervalEvents = 0;
+    stats.intervalLatencies = 0;
+    stats.maxLatencyUs = 0;
+    stats.latencyUs.clear();
+    stats.intervalStart = now;
+}
+
+/* To check the ipv6 link local is enabled on a given port, from the config cache */
+bool NeighSync::isLinkLocalEnabled(const string &port)
+{
+    const unordered_set<string> *enabled;
+
+    if (!port.compare(0, strlen("Vlan"), "Vlan"))
+    {
+        enabled = &m_vlanIntfLinkLocal;
+    }
+    else if (!port.compare(0, strlen("PortChannel"), "PortChannel"))
+    {
+        enabled = &m_lagIntfLinkLocal;
+    }
+    else if (!port.compare(0, strlen("Ethernet"), "Ethernet"))
+    {
+        enabled = &m_intfLinkLocal;
+    }
     else
     {
         SWSS_LOG_INFO("IPv6 Link local is not supported for %s ", port.c_str());
         return false;
     }
 
-    auto it = std::find_if(values.begin(), values.end(), [](const FieldValueTuple& t){ return t.first == "ipv6_use_link_local_only";});
-    if (it != values.end())
+    if (enabled->count(port))
     {
-        if (it->second == "enable")
-        {
-            SWSS_LOG_INFO("IPv6 Link local is enabled on %s", port.c_str());
-            return true;
-        }
+        SWSS_LOG_INFO("IPv6 Link local is enabled on %s", port.c_str());
+        return true;
     }
 
     SWSS_LOG_INFO("IPv6 Link local is not enabled on %s", port.c_str());
@@ -1,8 +1,15 @@
 #ifndef __NEIGHSYNC__
 #define __NEIGHSYNC__
 
+#include <chrono>
+#include <random>
+#include <set>
+#include <unordered_set>
+#include <vector>
+
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "subscriberstatetable.h"
 #include "netmsg.h"
 #include "warmRestartAssist.h"
 
@@ -16,6 +23,12 @@
  */
 #define RESTORE_NEIGH_WAIT_TIME_OUT 180
 
+#define NEIGHSYNCD_STATS_TABLE "NEIGHSYNCD_STATS_TABLE"
+#define NEIGHSYNCD_EVENT_STATS_KEY "neigh_events"
+
+/* Event to APPL_DB latencies sampled per stats interval to compute the p99 */
+#define NEIGH_LATENCY_SAMPLES 65536
+
 namespace swss {
 
 class NeighSync : public NetMsg
@@ -35,13 +48,51 @@ public:
         return m_AppRestartAssist;
     }
 
+    /* CONFIG_DB subscribers keeping the local config cache up to date */
+    std::vector<Selectable *> getConfigSelectables();
+    /* Return false if the selectable is not one of the config subscribers */
+    bool processConfig(Selectable *selectable);
+
+    /* Send the pending APPL_DB writes */
+    void flush();
+    void publishStats(Table &statsTable);
+
 private:
-    Table m_stateNeighRestoreTable, m_cfgPeerSwitchTable;
+    RedisPipeline *m_pipeline;
+    Table m_stateNeighRestoreTable;
     ProducerStateTable m_neighTable;
     AppRestartAssist  *m_AppRestartAssist;
-    Table m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
+    SubscriberStateTable m_cfgPeerSwitchTable;
+    SubscriberStateTable m_cfgVlanInterfaceTable, m_cfgLagInterfaceTable, m_cfgInterfaceTable;
+
+    /*
+     * Local copy of the CONFIG_DB data used per neighbor event: the peer
+     * switches, and the interfaces with ipv6_use_link_local_only enabled.
+     */
+    std::set<std::string> m_peerSwitches;
+    std::unordered_set<std::string> m_vlanIntfLinkLocal, m_lagIntfLinkLocal, m_intfLinkLocal;
+
+    struct NeighEventStats
+    {
+        uint64_t events = 0;
+        uint64_t writes = 0;
+        uint64_t intervalEvents = 0;
+        uint64_t lastRate = 0;
+        uint64_t intervalLatencies = 0;
+        uint64_t maxLatencyUs = 0;
+        std::vector<uint64_t> latencyUs;
+        std::chrono::steady_clock::time_point intervalStart;
+    };
+
+    /* Arrival time of the events written to APPL_DB since the last flush */
+    std::vector<std::chrono::steady_clock::time_point> m_pendingEvents;
+    std::chrono::steady_clock::time_point m_eventTime;
+    NeighEventStats m_stats;
+    std::minstd_rand m_sampler;
 
+    void updateConfigCache(SubscriberStateTable &table, const KeyOpFieldsValuesTuple &entry);
     bool isLinkLocalEnabled(const std::string &port);
+    void addLatency(uint64_t latencyUs);
 };
 
 }
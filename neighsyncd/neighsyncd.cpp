@@ -4,6 +4,7 @@
 #include <chrono>
 #include "logger.h"
 #include "select.h"
+#include "selectabletimer.h"
 #include "netdispatcher.h"
 #include "netlink.h"
 #include "neighsyncd/neighsync.h"
@@ -11,6 +12,9 @@
 using namespace std;
 using namespace swss;
 
+/* Interval in seconds of the neighbor event stats in STATE_DB */
+#define NEIGH_STATS_INTERVAL 1
+
 int main(int argc, char **argv)
 {
     Logger::linkToDbNative("neighsyncd");
@@ -21,6 +25,7 @@ int main(int argc, char **argv)
     DBConnector cfgDb("CONFIG_DB", 0);
 
     NeighSync sync(&pipelineAppDB, &stateDb, &cfgDb);
+    Table statsTable(&stateDb, NEIGHSYNCD_STATS_TABLE);
 
     NetDispatcher::getInstance().registerMessageHandler(RTM_NEWNEIGH, &sync);
     NetDispatcher::getInstance().registerMessageHandler(RTM_DELNEIGH, &sync);
@@ -31,6 +36,7 @@ int main(int argc, char **argv)
         {
             NetLink netlink;
             Select s;
+            SelectableTimer statsTimer(timespec{NEIGH_STATS_INTERVAL, 0});
 
             using namespace std::chrono;
             /*
@@ -67,10 +73,23 @@ int main(int argc, char **argv)
             netlink.dumpRequest(RTM_GETNEIGH);
 
             s.addSelectable(&netlink);
+            s.addSelectables(sync.getConfigSelectables());
+            s.addSelectable(&statsTimer);
+            statsTimer.start();
             while (true)
             {
                 Selectable *temps;
                 s.select(&temps);
+
+                if (temps == &statsTimer)
+                {
+                    sync.publishStats(statsTable);
+                }
+                else
+                {
+                    sync.processConfig(temps);
+                }
+
                 /*
                  * If warmstart is in progress, we check the reconcile timer,
                  * if timer expired, we stop the timer and start the reconcile process
@@ -83,6 +102,9 @@ int main(int argc, char **argv)
                         sync.getRestartAssist()->reconcile();
                     }
                 }
+
+                /* The APPL_DB writes are buffered, send them once per wake-up */
+                sync.flush();
             }
         }
         catch (const std::exception& e)
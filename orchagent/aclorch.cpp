@@ -32,6 +32,7 @@ extern CrmOrch *gCrmOrch;
 extern SwitchOrch *gSwitchOrch;
 extern string gMySwitchType;
 extern Directory<Orch*> gDirectory;
+extern size_t gMaxBulkSize;
 
 #define MIN_VLAN_ID 1    // 0 is a reserved VLAN ID
 #define MAX_VLAN_ID 4095 // 4096 is a reserved VLAN ID
@@ -1225,11 +1226,22 @@ bool AclRule::createRule()
     SWSS_LOG_ENTER();
 
     vector<sai_attribute_t> rule_attrs;
-    sai_object_id_t range_objects[2];
-    sai_object_list_t range_object_list = {0, range_objects};
+
+    if (!getRuleAttributes(rule_attrs))
+    {
+        return false;
+    }
+
+    auto status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+
+    return onRuleCreated(status);
+}
+
+bool AclRule::getRuleAttributes(vector<sai_attribute_t>& rule_attrs)
+{
+    SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
-    sai_status_t status;
 
     // store table oid this rule belongs to
     attr.id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
@@ -1253,6 +1265,10 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
+    // range object list must stay valid until the rule is created,
+    // which is deferred to the bulk flush in bulk mode
+    m_rangeOids.clear();
+
     if (!m_rangeConfig.empty())
     {
         for (const auto& rangeConfig: m_rangeConfig)
@@ -1263,17 +1279,18 @@ bool AclRule::createRule()
             if (!range)
             {
                 // release already created range if any
-                AclRange::remove(range_objects, range_object_list.count);
+                AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+                m_rangeOids.clear();
                 return false;
             }
 
             m_ranges.push_back(range);
-            range_objects[range_object_list.count++] = range->getOid();
+            m_rangeOids.push_back(range->getOid());
         }
 
         attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
         attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.objlist = range_object_list;
+        attr.value.aclfield.data.objlist = {(uint32_t)m_rangeOids.size(), m_rangeOids.data()};
         rule_attrs.push_back(attr);
     }
 
@@ -1291,7 +1308,13 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
-    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    return true;
+}
+
+bool AclRule::onRuleCreated(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
     if (status != SAI_STATUS_SUCCESS)
     {
         if (status == SAI_STATUS_ITEM_ALREADY_EXISTS)
@@ -1301,7 +1324,8 @@ bool AclRule::createRule()
         }
         SWSS_LOG_ERROR("Failed to create ACL rule %s, rv:%d",
                 m_id.c_str(), status);
-        AclRange::remove(range_objects, range_object_list.count);
+        AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+        m_rangeOids.clear();
         decreaseNextHopRefCount();
     }
 
@@ -1368,6 +1392,14 @@ bool AclRule::removeRule()
     }
 
     auto status = sai_acl_api->remove_acl_entry(m_ruleOid);
+
+    return onRuleRemoved(status);
+}
+
+bool AclRule::onRuleRemoved(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
     if (status != SAI_STATUS_SUCCESS)
     {
         if (status == SAI_STATUS_ITEM_NOT_FOUND)
@@ -1423,6 +1455,22 @@ bool AclRule::update(const AclRule& updatedRule)
 {
     SWSS_LOG_ENTER();
 
+    vector<UpdatedAttribute> attrs;
+
+    if (!prepareUpdate(updatedRule, attrs))
+    {
+        return false;
+    }
+
+    setAttributes(attrs);
+
+    return onUpdated(attrs);
+}
+
+bool AclRule::prepareUpdate(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs)
+{
+    SWSS_LOG_ENTER();
+
     if (!m_rangeConfig.empty() || !updatedRule.m_rangeConfig.empty())
     {
         SWSS_LOG_ERROR("Updating range matches is currently not implemented");
@@ -1434,22 +1482,82 @@ bool AclRule::update(const AclRule& updatedRule)
         return false;
     }
 
-    if (!updatePriority(updatedRule))
+    getUpdatedPriority(updatedRule, attrs);
+    getUpdatedMatches(updatedRule, attrs);
+    getUpdatedActions(updatedRule, attrs);
+
+    return true;
+}
+
+void AclRule::bulkSetAttributes(AclEntryBulker& bulker, vector<UpdatedAttribute>& attrs)
+{
+    for (auto& attr: attrs)
     {
-        return false;
+        bulker.set_entry_attribute(&attr.status, m_ruleOid, &attr.attr.getSaiAttr());
     }
+}
 
-    if (!updateMatches(updatedRule))
+void AclRule::setAttributes(vector<UpdatedAttribute>& attrs)
+{
+    // Stop at the first failure, the remaining attributes are not executed
+    for (auto& attr: attrs)
     {
-        return false;
+        attr.status = sai_acl_api->set_acl_entry_attribute(m_ruleOid, &attr.attr.getSaiAttr());
+        if (attr.status != SAI_STATUS_SUCCESS)
+        {
+            break;
+        }
     }
+}
+
+bool AclRule::onUpdated(const vector<UpdatedAttribute>& attrs)
+{
+    bool success = true;
 
-    if (!updateActions(updatedRule))
+    for (const auto& attr: attrs)
     {
-        return false;
+        const auto& saiAttr = attr.attr.getSaiAttr();
+        auto id = static_cast<sai_acl_entry_attr_t>(saiAttr.id);
+
+        if (attr.status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to update attribute %s on ACL rule %s in ACL table %s: %s",
+                           getAttributeIdName(SAI_OBJECT_TYPE_ACL_ENTRY, id).c_str(),
+                           getId().c_str(), getTableId().c_str(),
+                           sai_serialize_status(attr.status).c_str());
+            success = false;
+            continue;
+        }
+
+        if (id == SAI_ACL_ENTRY_ATTR_PRIORITY)
+        {
+            m_priority = saiAttr.value.s32;
+        }
+        else if (id >= SAI_ACL_ENTRY_ATTR_FIELD_START && id <= SAI_ACL_ENTRY_ATTR_FIELD_END)
+        {
+            if (attr.disabled)
+            {
+                m_matches.erase(id);
+            }
+            else
+            {
+                setMatch(id, saiAttr.value.aclfield);
+            }
+        }
+        else
+        {
+            if (attr.disabled)
+            {
+                m_actions.erase(id);
+            }
+            else
+            {
+                setAction(id, saiAttr.value.aclaction);
+            }
+        }
     }
 
-    return true;
+    return success;
 }
 
 bool AclRule::updateCounter(const AclRule& updatedRule)
@@ -1478,27 +1586,20 @@ bool AclRule::updateCounter(const AclRule& updatedRule)
     return true;
 }
 
-bool AclRule::updatePriority(const AclRule& updatedRule)
+void AclRule::getUpdatedPriority(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs) const
 {
     if (m_priority == updatedRule.m_priority)
     {
-        return true;
+        return;
     }
 
     sai_attribute_t attr {};
     attr.id = SAI_ACL_ENTRY_ATTR_PRIORITY;
     attr.value.s32 = updatedRule.m_priority;
-    if (!setAttribute(attr))
-    {
-        return false;
-    }
-
-    m_priority = updatedRule.m_priority;
-
-    return true;
+    attrs.emplace_back(attr, false);
 }
 
-bool AclRule::updateMatches(const AclRule& updatedRule)
+void AclRule::getUpdatedMatches(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs) const
 {
     vector<pair<sai_acl_entry_attr_t, SaiAttrWrapper>> matchesUpdated;
     vector<pair<sai_acl_entry_attr_t, SaiAttrWrapper>> matchesDisabled;
@@ -1529,27 +1630,16 @@ bool AclRule::updateMatches(const AclRule& updatedRule)
     {
         auto attr = attrPair.second.getSaiAttr();
         attr.value.aclfield.enable = false;
-        if (!setAttribute(attr))
-        {
-            return false;
-        }
-        m_matches.erase(attrPair.first);
+        attrs.emplace_back(attr, true);
     }
 
     for (const auto& attrPair: matchesUpdated)
     {
-        auto attr = attrPair.second.getSaiAttr();
-        if (!setAttribute(attr))
-        {
-            return false;
-        }
-        setMatch(attrPair.first, attr.value.aclfield);
+        attrs.emplace_back(attrPair.second.getSaiAttr(), false);
     }
-
-    return true;
 }
 
-bool AclRule::updateActions(const AclRule& updatedRule)
+void AclRule::getUpdatedActions(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs) const
 {
     vector<pair<sai_acl_entry_attr_t, SaiAttrWrapper>> actionsUpdated;
     vector<pair<sai_acl_entry_attr_t, SaiAttrWrapper>> actionsDisabled;
@@ -1580,24 +1670,13 @@ bool AclRule::updateActions(const AclRule& updatedRule)
     {
         auto attr = attrPair.second.getSaiAttr();
         attr.value.aclaction.enable = false;
-        if (!setAttribute(attr))
-        {
-            return false;
-        }
-        m_actions.erase(attrPair.first);
+        attrs.emplace_back(attr, true);
     }
 
     for (const auto& attrPair: actionsUpdated)
     {
-        auto attr = attrPair.second.getSaiAttr();
-        if (!setAttribute(attr))
-        {
-            return false;
-        }
-        setAction(attrPair.first, attr.value.aclaction);
+        attrs.emplace_back(attrPair.second.getSaiAttr(), false);
     }
-
-    return true;
 }
 
 bool AclRule::setPriority(const sai_uint32_t &value)
@@ -1857,14 +1936,22 @@ bool AclRule::createCounter()
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
-    vector<sai_attribute_t> counter_attrs;
-
     if (m_counterOid != SAI_NULL_OBJECT_ID)
     {
         return true;
     }
 
+    auto counter_attrs = getCounterAttributes();
+    auto status = sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data());
+
+    return onCounterCreated(status);
+}
+
+vector<sai_attribute_t> AclRule::getCounterAttributes() const
+{
+    sai_attribute_t attr;
+    vector<sai_attribute_t> counter_attrs;
+
     attr.id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
     attr.value.oid = m_pTable->getOid();
     counter_attrs.push_back(attr);
@@ -1876,9 +1963,15 @@ bool AclRule::createCounter()
         counter_attrs.push_back(attr);
     }
 
-    if (sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data()) != SAI_STATUS_SUCCESS)
+    return counter_attrs;
+}
+
+bool AclRule::onCounterCreated(sai_status_t status)
+{
+    if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create counter for the rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
+        m_counterOid = SAI_NULL_OBJECT_ID;
         return false;
     }
 
@@ -1918,7 +2011,14 @@ bool AclRule::removeCounter()
         return true;
     }
 
-    if (sai_acl_api->remove_acl_counter(m_counterOid) != SAI_STATUS_SUCCESS)
+    auto status = sai_acl_api->remove_acl_counter(m_counterOid);
+
+    return onCounterRemoved(status);
+}
+
+bool AclRule::onCounterRemoved(sai_status_t status)
+{
+    if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to remove ACL counter for rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
         return false;
@@ -1933,6 +2033,58 @@ bool AclRule::removeCounter()
     return true;
 }
 
+bool AclRule::isBulkSupported() const
+{
+    return true;
+}
+
+bool AclRule::bulkCreateCounter(AclCounterBulker& bulker, sai_status_t& status)
+{
+    if (!m_createCounter || m_counterOid != SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    auto counter_attrs = getCounterAttributes();
+    bulker.create_entry(&m_counterOid, &status, (uint32_t)counter_attrs.size(), counter_attrs.data());
+    return true;
+}
+
+bool AclRule::bulkCreateRule(AclEntryBulker& bulker, sai_status_t& status)
+{
+    vector<sai_attribute_t> rule_attrs;
+
+    if (!getRuleAttributes(rule_attrs))
+    {
+        return false;
+    }
+
+    bulker.create_entry(&m_ruleOid, &status, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    return true;
+}
+
+bool AclRule::bulkRemoveRule(AclEntryBulker& bulker, sai_status_t& status)
+{
+    if (m_ruleOid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    bulker.remove_entry(&status, m_ruleOid);
+    return true;
+}
+
+bool AclRule::bulkRemoveCounter(AclCounterBulker& bulker, sai_status_t& status)
+{
+    if (m_counterOid == SAI_NULL_OBJECT_ID)
+    {
+        return false;
+    }
+
+    bulker.remove_entry(&status, m_counterOid);
+    return true;
+}
+
 AclRulePacket::AclRulePacket(AclOrch *aclOrch, string rule, string table, bool createCounter) :
         AclRule(aclOrch, rule, table, createCounter)
 {
@@ -2283,6 +2435,12 @@ bool AclRuleMirror::deactivate()
     return true;
 }
 
+bool AclRuleMirror::isBulkSupported() const
+{
+    // The rule is only created in SAI while its mirror session is active
+    return false;
+}
+
 bool AclRuleMirror::update(const AclRule& rule)
 {
     auto mirrorRule = dynamic_cast<const AclRuleMirror*>(&rule);
@@ -3208,6 +3366,12 @@ void AclRuleDTelWatchListEntry::onUpdate(SubjectType type, void *cntx)
     }
 }
 
+bool AclRuleDTelWatchListEntry::isBulkSupported() const
+{
+    // The rule depends on the state of the DTel INT session
+    return false;
+}
+
 bool AclRuleDTelWatchListEntry::update(const AclRule& rule)
 {
     auto dtelWatchListRule = dynamic_cast<const AclRuleDTelWatchListEntry*>(&rule);
@@ -4082,10 +4246,16 @@ AclOrch::AclOrch(vector<TableConnector>& connectors, DBConnector* stateDb, Switc
             StatsMode::READ,
             ACL_COUNTER_DEFAULT_POLLING_INTERVAL_MS,
             ACL_COUNTER_DEFAULT_ENABLED_STATE
-        )
+        ),
+        m_aclEntryBulker(sai_acl_api, gSwitchId, gMaxBulkSize),
+        m_aclCounterBulker(sai_acl_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
+    // One failed rule must not fail the other rules of the batch
+    m_aclEntryBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+    m_aclCounterBulker.set_error_mode(SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR);
+
     init(connectors, portOrch, mirrorOrch, neighOrch, routeOrch);
 
     if (m_dTelOrch)
@@ -5039,20 +5209,92 @@ bool AclOrch::updateAclRule(shared_ptr<AclRule> updatedRule)
 {
     SWSS_LOG_ENTER();
 
-    auto tableId = updatedRule->getTableId();
-    sai_object_id_t tableOid = getTableById(tableId);
-    if (tableOid == SAI_NULL_OBJECT_ID)
+    return updateAclRules({ updatedRule }).front();
+}
+
+/*
+ * The changed attributes of all the rules are set with one bulk call, each
+ * rule is completed according to the statuses of its own attributes. A single
+ * attribute is set without the bulker. Rules that don't support batching are
+ * updated one by one by their table.
+ */
+vector<bool> AclOrch::updateAclRules(const vector<shared_ptr<AclRule>>& updatedRules)
+{
+    SWSS_LOG_ENTER();
+
+    vector<bool> results(updatedRules.size(), false);
+    vector<AclRule*> rules(updatedRules.size(), nullptr);
+    vector<vector<AclRule::UpdatedAttribute>> attrs(updatedRules.size());
+    size_t attrCount = 0;
+
+    for (size_t i = 0; i < updatedRules.size(); i++)
     {
-        SWSS_LOG_ERROR("Failed to add ACL rule in ACL table %s. Table doesn't exist", tableId.c_str());
-        return false;
+        auto tableId = updatedRules[i]->getTableId();
+        sai_object_id_t tableOid = getTableById(tableId);
+        if (tableOid == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to add ACL rule in ACL table %s. Table doesn't exist", tableId.c_str());
+            continue;
+        }
+
+        auto& table = m_AclTables[tableOid];
+        auto ruleIter = table.rules.find(updatedRules[i]->getId());
+        if (ruleIter == table.rules.end() || !ruleIter->second->isBulkSupported())
+        {
+            results[i] = table.updateRule(updatedRules[i]);
+            continue;
+        }
+
+        if (!ruleIter->second->prepareUpdate(*updatedRules[i], attrs[i]))
+        {
+            SWSS_LOG_ERROR("Failed to update ACL rule %s in table %s",
+                           ruleIter->first.c_str(), tableId.c_str());
+            continue;
+        }
+
+        rules[i] = ruleIter->second.get();
+        attrCount += attrs[i].size();
     }
 
-    if (!m_AclTables[tableOid].updateRule(updatedRule))
+    for (size_t i = 0; i < rules.size(); i++)
     {
-        return false;
+        if (!rules[i])
+        {
+            continue;
+        }
+
+        if (attrCount > 1)
+        {
+            rules[i]->bulkSetAttributes(m_aclEntryBulker, attrs[i]);
+        }
+        else
+        {
+            rules[i]->setAttributes(attrs[i]);
+        }
     }
+    m_aclEntryBulker.flush();
 
-    return true;
+    for (size_t i = 0; i < rules.size(); i++)
+    {
+        if (!rules[i])
+        {
+            continue;
+        }
+
+        results[i] = rules[i]->onUpdated(attrs[i]);
+        if (results[i])
+        {
+            SWSS_LOG_NOTICE("Successfully updated ACL rule %s in table %s",
+                            rules[i]->getId().c_str(), rules[i]->getTableId().c_str());
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to update ACL rule %s in table %s",
+                           rules[i]->getId().c_str(), rules[i]->getTableId().c_str());
+        }
+    }
+
+    return results;
 }
 
 bool AclOrch::isCombinedMirrorV6Table()
@@ -5388,6 +5630,9 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    vector<AclRuleBulkContext> bulkContexts;
+    unordered_set<string> bulkKeys;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -5407,6 +5652,12 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             continue;
         }
 
+        // Operations on the same rule must be applied in order
+        if (bulkKeys.find(key) != bulkKeys.end())
+        {
+            flushAclRuleBulk(consumer, bulkContexts, bulkKeys);
+        }
+
         if (op == SET_COMMAND)
         {
             bool bAllAttributesOk = true;
@@ -5448,6 +5699,7 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             {
                 SWSS_LOG_ERROR("Error while creating ACL rule %s: %s", rule_id.c_str(), e.what());
                 it = consumer.m_toSync.erase(it);
+                flushAclRuleBulk(consumer, bulkContexts, bulkKeys);
                 return;
             }
             bool bHasTCPFlag = false;
@@ -5532,6 +5784,16 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             // validate and create ACL rule
             if (bAllAttributesOk && newRule->validate())
             {
+                if (m_ruleBulkEnabled && isAclRuleBulkable(newRule, table_id, false))
+                {
+                    bulkContexts.emplace_back(it, newRule, table_oid, false);
+                    bulkKeys.insert(key);
+                    it++;
+                    continue;
+                }
+
+                flushAclRuleBulk(consumer, bulkContexts, bulkKeys);
+
                 if (addAclRule(newRule, table_id))
                 {
                     setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
@@ -5553,6 +5815,22 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
         }
         else if (op == DEL_COMMAND)
         {
+            sai_object_id_t table_oid = getTableById(table_id);
+            if (m_ruleBulkEnabled && table_oid != SAI_NULL_OBJECT_ID)
+            {
+                auto ruleIter = m_AclTables[table_oid].rules.find(rule_id);
+                if (ruleIter != m_AclTables[table_oid].rules.end() &&
+                    isAclRuleBulkable(ruleIter->second, table_id, true))
+                {
+                    bulkContexts.emplace_back(it, ruleIter->second, table_oid, true);
+                    bulkKeys.insert(key);
+                    it++;
+                    continue;
+                }
+            }
+
+            flushAclRuleBulk(consumer, bulkContexts, bulkKeys);
+
             if (removeAclRule(table_id, rule_id))
             {
                 removeAclRuleStatus(table_id, rule_id);
@@ -5571,6 +5849,209 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
         }
     }
+
+    flushAclRuleBulk(consumer, bulkContexts, bulkKeys);
+}
+
+bool AclOrch::isAclRuleBulkable(const shared_ptr<AclRule>& rule, const string& table_id, bool remove)
+{
+    if (!rule->isBulkSupported())
+    {
+        return false;
+    }
+
+    // The EGR_SET_DSCP companion rules are managed with the rule
+    if (remove)
+    {
+        return m_egrDscpRuleMetadata.find(table_id + ":" + rule->getId()) == m_egrDscpRuleMetadata.end();
+    }
+
+    if (isUsingEgrSetDscp(table_id))
+    {
+        return false;
+    }
+
+    // Replacing an existing rule removes it first, keep it on the single object path
+    const auto& rules = m_AclTables[getTableById(table_id)].rules;
+    return rules.find(rule->getId()) == rules.end();
+}
+
+/*
+ * Create and remove the batched rules with bulk SAI calls:
+ *   1. remove the ACL entries of the removed rules, create the counters of the new rules
+ *   2. remove the counters of the removed rules, create the ACL entries of the new rules
+ *   3. remove the counters of the new rules whose ACL entry failed to be created
+ * Every rule is completed according to its own status, failed rules are left
+ * in m_toSync to be retried like on the single object path.
+ */
+void AclOrch::flushAclRuleBulk(Consumer &consumer, vector<AclRuleBulkContext> &contexts, unordered_set<string> &keys)
+{
+    SWSS_LOG_ENTER();
+
+    if (contexts.empty())
+    {
+        return;
+    }
+
+    // A single rule does not save any SAI call, use the single object path
+    if (contexts.size() == 1)
+    {
+        auto& ctx = contexts.front();
+        string table_id = ctx.rule->getTableId();
+        string rule_id = ctx.rule->getId();
+
+        if (ctx.remove)
+        {
+            if (removeAclRule(table_id, rule_id))
+            {
+                removeAclRuleStatus(table_id, rule_id);
+                consumer.m_toSync.erase(ctx.it);
+            }
+            else
+            {
+                // Mark pending removal status if removeAclRule returns error
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_REMOVAL);
+            }
+        }
+        else
+        {
+            if (addAclRule(ctx.rule, table_id))
+            {
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
+                consumer.m_toSync.erase(ctx.it);
+            }
+            else
+            {
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_CREATION);
+            }
+        }
+
+        contexts.clear();
+        keys.clear();
+        return;
+    }
+
+    for (auto& ctx: contexts)
+    {
+        if (ctx.remove)
+        {
+            if (ctx.rule->hasCounter())
+            {
+                deregisterFlexCounter(*ctx.rule);
+            }
+            ctx.queued = ctx.rule->bulkRemoveRule(m_aclEntryBulker, ctx.status);
+        }
+        else
+        {
+            ctx.queued = ctx.rule->bulkCreateCounter(m_aclCounterBulker, ctx.status);
+        }
+    }
+    m_aclEntryBulker.flush();
+    m_aclCounterBulker.flush();
+
+    for (auto& ctx: contexts)
+    {
+        if (ctx.remove)
+        {
+            ctx.success = !ctx.queued || ctx.rule->onRuleRemoved(ctx.status);
+            ctx.queued = false;
+            if (ctx.success)
+            {
+                ctx.success = ctx.rule->removeRanges();
+                ctx.queued = ctx.rule->bulkRemoveCounter(m_aclCounterBulker, ctx.status);
+            }
+        }
+        else
+        {
+            ctx.success = !ctx.queued || ctx.rule->onCounterCreated(ctx.status);
+            ctx.queued = false;
+            if (ctx.success)
+            {
+                ctx.queued = ctx.rule->bulkCreateRule(m_aclEntryBulker, ctx.status);
+                ctx.success = ctx.queued;
+            }
+        }
+    }
+    m_aclCounterBulker.flush();
+    m_aclEntryBulker.flush();
+
+    for (auto& ctx: contexts)
+    {
+        if (ctx.remove)
+        {
+            if (ctx.queued)
+            {
+                ctx.success &= ctx.rule->onCounterRemoved(ctx.status);
+            }
+            ctx.queued = false;
+        }
+        else
+        {
+            if (ctx.queued)
+            {
+                ctx.success = ctx.rule->onRuleCreated(ctx.status);
+            }
+            ctx.queued = !ctx.success && ctx.rule->bulkRemoveCounter(m_aclCounterBulker, ctx.status);
+        }
+    }
+    m_aclCounterBulker.flush();
+
+    for (auto& ctx: contexts)
+    {
+        string table_id = ctx.rule->getTableId();
+        string rule_id = ctx.rule->getId();
+        auto& table = m_AclTables[ctx.table_oid];
+
+        if (ctx.queued)
+        {
+            ctx.rule->onCounterRemoved(ctx.status);
+        }
+
+        if (ctx.remove)
+        {
+            if (ctx.success)
+            {
+                table.rules.erase(rule_id);
+                SWSS_LOG_NOTICE("Successfully deleted ACL rule %s in table %s",
+                        rule_id.c_str(), table_id.c_str());
+                removeAclRuleStatus(table_id, rule_id);
+                consumer.m_toSync.erase(ctx.it);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to delete ACL rule %s in table %s",
+                        rule_id.c_str(), table_id.c_str());
+                // Mark pending removal status if removal returns error
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_REMOVAL);
+            }
+        }
+        else
+        {
+            if (ctx.success)
+            {
+                table.rules[rule_id] = ctx.rule;
+                SWSS_LOG_NOTICE("Successfully created ACL rule %s in table %s",
+                        rule_id.c_str(), table_id.c_str());
+                if (ctx.rule->hasCounter())
+                {
+                    registerFlexCounter(*ctx.rule);
+                }
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::ACTIVE);
+                consumer.m_toSync.erase(ctx.it);
+            }
+            else
+            {
+                SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s",
+                        rule_id.c_str(), table_id.c_str());
+                setAclRuleStatus(table_id, rule_id, AclObjectStatus::PENDING_CREATION);
+            }
+        }
+    }
+
+    SWSS_LOG_INFO("Flushed %zu bulk ACL rule operations", contexts.size());
+
+    contexts.clear();
+    keys.clear();
 }
 
 void AclOrch::doAclTableTypeTask(Consumer &consumer)
@@ -17,6 +17,7 @@
 #include "observer.h"
 #include "vxlanorch.h"
 #include "flex_counter_manager.h"
+#include "bulker.h"
 
 #include "acltable.h"
 
@@ -284,6 +285,9 @@ private:
 
 class AclTable;
 
+typedef ObjectBulker<sai_acl_entry_bulk_t> AclEntryBulker;
+typedef ObjectBulker<sai_acl_counter_bulk_t> AclCounterBulker;
+
 class AclRule
 {
 public:
@@ -324,6 +328,48 @@ public:
     virtual bool enableCounter();
     virtual bool disableCounter();
 
+    /*
+     * Batched creation and removal of the rule SAI objects, driven by
+     * AclOrch. The bulk*() methods queue the objects in the bulkers and
+     * return false when there is nothing to queue, the on*() methods complete
+     * the operation with the per-object status once the bulker is flushed.
+     * Rules whose SAI objects depend on the state of other orchs must not be
+     * batched.
+     */
+    virtual bool isBulkSupported() const;
+    bool bulkCreateCounter(AclCounterBulker& bulker, sai_status_t& status);
+    bool bulkCreateRule(AclEntryBulker& bulker, sai_status_t& status);
+    bool bulkRemoveRule(AclEntryBulker& bulker, sai_status_t& status);
+    bool bulkRemoveCounter(AclCounterBulker& bulker, sai_status_t& status);
+    bool onCounterCreated(sai_status_t status);
+    bool onRuleCreated(sai_status_t status);
+    bool onRuleRemoved(sai_status_t status);
+    bool onCounterRemoved(sai_status_t status);
+    virtual bool removeRanges();
+
+    /*
+     * Batched update of the rule, driven by AclOrch::updateAclRules().
+     * prepareUpdate() updates the counter of the rule and collects its
+     * changed priority, match and action attributes, which are then set with
+     * bulkSetAttributes() or setAttributes(). onUpdated() applies the
+     * attributes that were set to the rule.
+     */
+    struct UpdatedAttribute
+    {
+        UpdatedAttribute(const sai_attribute_t& attr, bool disabled) :
+            attr(SAI_OBJECT_TYPE_ACL_ENTRY, attr), disabled(disabled)
+        {
+        }
+
+        SaiAttrWrapper attr;
+        bool disabled;
+        sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+    };
+    bool prepareUpdate(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs);
+    void bulkSetAttributes(AclEntryBulker& bulker, vector<UpdatedAttribute>& attrs);
+    void setAttributes(vector<UpdatedAttribute>& attrs);
+    bool onUpdated(const vector<UpdatedAttribute>& attrs);
+
     string getId() const;
     string getTableId() const;
     sai_object_id_t getOid() const;
@@ -346,12 +392,14 @@ protected:
     virtual bool createCounter();
     virtual bool createRule();
     virtual bool removeCounter();
-    virtual bool removeRanges();
     virtual bool removeRule();
 
-    virtual bool updatePriority(const AclRule& updatedRule);
-    virtual bool updateMatches(const AclRule& updatedRule);
-    virtual bool updateActions(const AclRule& updatedRule);
+    vector<sai_attribute_t> getCounterAttributes() const;
+    bool getRuleAttributes(vector<sai_attribute_t>& rule_attrs);
+
+    virtual void getUpdatedPriority(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs) const;
+    virtual void getUpdatedMatches(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs) const;
+    virtual void getUpdatedActions(const AclRule& updatedRule, vector<UpdatedAttribute>& attrs) const;
     virtual bool updateCounter(const AclRule& updatedRule);
 
     virtual bool setPriority(const sai_uint32_t &value);
@@ -380,6 +428,7 @@ protected:
 
     vector<AclRangeConfig> m_rangeConfig;
     vector<AclRange*> m_ranges;
+    vector<sai_object_id_t> m_rangeOids;
 
 private:
     bool m_createCounter;
@@ -412,6 +461,7 @@ public:
     bool activate();
     bool deactivate();
 
+    bool isBulkSupported() const override;
     bool update(const AclRule& updatedRule) override;
 protected:
     bool m_state {false};
@@ -432,6 +482,7 @@ public:
     bool activate();
     bool deactivate();
 
+    bool isBulkSupported() const override;
     bool update(const AclRule& updatedRule) override;
 protected:
     DTelOrch *m_pDTelOrch;
@@ -585,6 +636,8 @@ public:
     bool addAclRule(shared_ptr<AclRule> aclRule, string table_id);
     bool removeAclRule(string table_id, string rule_id);
     bool updateAclRule(shared_ptr<AclRule> updatedAclRule);
+    // Update existing rules, one update per rule, the changed attributes of all the rules are set with one bulk call
+    vector<bool> updateAclRules(const vector<shared_ptr<AclRule>>& updatedAclRules);
     bool updateAclRule(string table_id, string rule_id, string attr_name, void *data, bool oper);
     bool updateAclRule(string table_id, string rule_id, bool enableCounter);
     AclRule* getAclRule(string table_id, string rule_id);
@@ -619,6 +672,12 @@ public:
     // Get the OID for the ACL bind point for a given port
     static bool getAclBindPortId(Port& port, sai_object_id_t& port_id);
 
+    // Batch the SAI operations of the ACL rules of one doTask() run, enabled by default
+    void setRuleBulkEnabled(bool enabled)
+    {
+        m_ruleBulkEnabled = enabled;
+    }
+
     using Orch::doTask;  // Allow access to the basic doTask
     map<sai_object_id_t, AclTable>  getAclTables()
     {
@@ -626,10 +685,28 @@ public:
     }
 
 private:
+    struct AclRuleBulkContext
+    {
+        AclRuleBulkContext(SyncMap::iterator it, shared_ptr<AclRule> rule, sai_object_id_t table_oid, bool remove) :
+            it(it), rule(rule), table_oid(table_oid), remove(remove)
+        {
+        }
+
+        SyncMap::iterator it;
+        shared_ptr<AclRule> rule;
+        sai_object_id_t table_oid;
+        bool remove;
+        bool queued = false;
+        bool success = true;
+        sai_status_t status = SAI_STATUS_NOT_EXECUTED;
+    };
+
     SwitchOrch *m_switchOrch;
     void doTask(Consumer &consumer);
     void doAclTableTask(Consumer &consumer);
     void doAclRuleTask(Consumer &consumer);
+    bool isAclRuleBulkable(const shared_ptr<AclRule>& rule, const string& table_id, bool remove);
+    void flushAclRuleBulk(Consumer &consumer, vector<AclRuleBulkContext> &contexts, unordered_set<string> &keys);
     void doAclTableTypeTask(Consumer &consumer);
     void init(vector<TableConnector>& connectors, PortsOrch *portOrch, MirrorOrch *mirrorOrch, NeighOrch *neighOrch, RouteOrch *routeOrch);
     void initDefaultTableTypes(const string& platform, const string& sub_platform);
@@ -698,6 +775,10 @@ private:
     acl_capabilities_t m_aclCapabilities;
     acl_action_enum_values_capabilities_t m_aclEnumActionCapabilities;
     FlexCounterManager m_flex_counter_manager;
+
+    bool m_ruleBulkEnabled = true;
+    AclEntryBulker m_aclEntryBulker;
+    AclCounterBulker m_aclCounterBulker;
 };
 
 #endif /* SWSS_ACLORCH_H */
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <assert.h>
+#include <string.h>
+#include <tuple>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -89,6 +91,14 @@ static inline bool operator==(const sai_route_entry_t& a, const sai_route_entry_
         ;
 }
 
+static inline bool operator==(const sai_fdb_entry_t& a, const sai_fdb_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && memcmp(a.mac_address, b.mac_address, sizeof(a.mac_address)) == 0
+        && a.bv_id == b.bv_id
+        ;
+}
+
 static inline bool operator==(const sai_inseg_entry_t& a, const sai_inseg_entry_t& b)
 {
     return a.switch_id == b.switch_id
@@ -338,8 +348,7 @@ struct SaiBulkerTraits<sai_next_hop_group_api_t>
     using set_entry_attribute_fn = sai_set_next_hop_group_member_attribute_fn;
     using bulk_create_entry_fn = sai_bulk_object_create_fn;
     using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
-    // TODO: wait until available in SAI
-    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
 template<>
@@ -352,8 +361,7 @@ struct SaiBulkerTraits<sai_next_hop_api_t>
     using set_entry_attribute_fn = sai_set_next_hop_attribute_fn;
     using bulk_create_entry_fn = sai_bulk_object_create_fn;
     using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
-    // TODO: wait until available in SAI
-    //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
 template<>
@@ -392,6 +400,53 @@ struct SaiBulkerTraits<sai_dash_vnet_api_t>
     using set_entry_attribute_fn = sai_set_vnet_attribute_fn;
     using bulk_create_entry_fn = sai_bulk_object_create_fn;
     using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+/*
+ * ACL entries and ACL counters share sai_acl_api_t, so the bulker of each
+ * object type is keyed by a tag type instead of the API type.
+ */
+struct sai_acl_entry_bulk_t;
+struct sai_acl_counter_bulk_t;
+
+template<>
+struct SaiBulkerTraits<sai_acl_entry_bulk_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_acl_api_t;
+    using create_entry_fn = sai_create_acl_entry_fn;
+    using remove_entry_fn = sai_remove_acl_entry_fn;
+    using set_entry_attribute_fn = sai_set_acl_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_acl_counter_bulk_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_acl_api_t;
+    using create_entry_fn = sai_create_acl_counter_fn;
+    using remove_entry_fn = sai_remove_acl_counter_fn;
+    using set_entry_attribute_fn = sai_set_acl_counter_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_router_interface_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_router_interface_api_t;
+    using create_entry_fn = sai_create_router_interface_fn;
+    using remove_entry_fn = sai_remove_router_interface_fn;
+    using set_entry_attribute_fn = sai_set_router_interface_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
 template<>
@@ -828,6 +883,103 @@ private:
     }
 };
 
+extern sai_fdb_api_t *sai_fdb_api;
+
+template <typename F>
+inline sai_status_t sai_bulk_object_apply(
+        _In_ uint32_t object_count,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses,
+        _In_ F fn)
+{
+    sai_status_t status = SAI_STATUS_SUCCESS;
+
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        if (status != SAI_STATUS_SUCCESS && mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)
+        {
+            object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        object_statuses[i] = fn(i);
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return status;
+}
+
+/*
+ * FDB bulk operations. The native bulk API is used when the SAI implements
+ * it, otherwise the entries are programmed one by one so that the callers
+ * always get per-entry statuses.
+ */
+inline sai_status_t sai_bulk_create_fdb_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    if (sai_fdb_api->create_fdb_entries)
+    {
+        sai_status_t status = sai_fdb_api->create_fdb_entries(object_count, fdb_entry, attr_count, attr_list, mode, object_statuses);
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return status;
+        }
+    }
+
+    return sai_bulk_object_apply(object_count, mode, object_statuses, [&](uint32_t i) {
+        return sai_fdb_api->create_fdb_entry(&fdb_entry[i], attr_count[i], attr_list[i]);
+    });
+}
+
+inline sai_status_t sai_bulk_remove_fdb_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    if (sai_fdb_api->remove_fdb_entries)
+    {
+        sai_status_t status = sai_fdb_api->remove_fdb_entries(object_count, fdb_entry, mode, object_statuses);
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return status;
+        }
+    }
+
+    return sai_bulk_object_apply(object_count, mode, object_statuses, [&](uint32_t i) {
+        return sai_fdb_api->remove_fdb_entry(&fdb_entry[i]);
+    });
+}
+
+inline sai_status_t sai_bulk_set_fdb_entries_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    if (sai_fdb_api->set_fdb_entries_attribute)
+    {
+        sai_status_t status = sai_fdb_api->set_fdb_entries_attribute(object_count, fdb_entry, attr_list, mode, object_statuses);
+        if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+        {
+            return status;
+        }
+    }
+
+    return sai_bulk_object_apply(object_count, mode, object_statuses, [&](uint32_t i) {
+        return sai_fdb_api->set_fdb_entry_attribute(&fdb_entry[i], &attr_list[i]);
+    });
+}
+
 template <>
 inline EntityBulker<sai_route_api_t>::EntityBulker(sai_route_api_t *api, size_t max_bulk_size) :
     max_bulk_size(max_bulk_size)
@@ -841,13 +993,9 @@ template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api, size_t max_bulk_size) :
     max_bulk_size(max_bulk_size)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
-    create_entries = api->create_fdb_entries;
-    remove_entries = api->remove_fdb_entries;
-    set_entries_attribute = api->set_fdb_entries_attribute;
-    */
+    create_entries = sai_bulk_create_fdb_entries;
+    remove_entries = sai_bulk_remove_fdb_entries;
+    set_entries_attribute = sai_bulk_set_fdb_entries_attribute;
 }
 
 template <>
@@ -916,18 +1064,31 @@ public:
         _Out_ sai_object_id_t *object_id,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
+    {
+        return create_entry(object_id, nullptr, attr_count, attr_list);
+    }
+
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
     {
         assert(object_id);
         if (!object_id) throw std::invalid_argument("object_id is null");
         assert(attr_list);
         if (!attr_list) throw std::invalid_argument("attr_list is null");
 
-        creating_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(object_id), std::forward_as_tuple(attr_list, attr_list + attr_count));
+        creating_entries.emplace_back(object_id, object_status, std::vector<sai_attribute_t>(attr_list, attr_list + attr_count));
 
-        auto& last_attrs = std::get<1>(creating_entries.back());
+        auto& last_attrs = std::get<2>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
 
         *object_id = SAI_NULL_OBJECT_ID; // not created immediately, postponed until flush
+        if (object_status)
+        {
+            *object_status = SAI_STATUS_NOT_EXECUTED;
+        }
         return SAI_STATUS_NOT_EXECUTED;
     }
 
@@ -943,6 +1104,11 @@ public:
         auto found_setting = setting_entries.find(object_id);
         if (found_setting != setting_entries.end())
         {
+            // Mark old one as done
+            for (auto& attr: found_setting->second)
+            {
+                *attr.second = SAI_STATUS_SUCCESS;
+            }
             setting_entries.erase(found_setting);
         }
 
@@ -951,29 +1117,33 @@ public:
         return *object_status;
     }
 
-    // TODO: wait until available in SAI
-    /*
-    sai_status_t set_entry_attribute(
+    void set_entry_attribute(
+        _Out_ sai_status_t *object_status,
         _In_ sai_object_id_t object_id,
         _In_ const sai_attribute_t *attr)
     {
-        auto found_setting = setting_entries.find(object_id);
-        if (found_setting != setting_entries.end())
-        {
-            // For simplicity, just insert new attribute at the vector end, no merging
-            found_setting->second.emplace_back(*attr);
-        }
-        else
-        {
-            // Create a new key if not exists in the map
-            setting_entries.emplace(std::piecewise_construct,
-                std::forward_as_tuple(object_id),
-                std::forward_as_tuple(1, *attr));
-        }
+        assert(object_status);
+        if (!object_status) throw std::invalid_argument("object_status is null");
+        assert(object_id != SAI_NULL_OBJECT_ID);
+        if (object_id == SAI_NULL_OBJECT_ID) throw std::invalid_argument("object_id is null");
+        assert(attr);
+        if (!attr) throw std::invalid_argument("attr is null");
+        if (!set_entries_attribute) throw std::logic_error("Bulk set is not supported");
+
+        // For simplicity, just insert new attribute at the vector end, no merging
+        setting_entries[object_id].emplace_back(*attr, object_status);
+        *object_status = SAI_STATUS_NOT_EXECUTED;
+    }
 
-        return SAI_STATUS_SUCCESS;
+    /*
+     * STOP_ON_ERROR (the default) stops a bulk call at the first failed
+     * object, the objects after it are reported as SAI_STATUS_NOT_EXECUTED.
+     * IGNORE_ERROR lets every object of the bulk call be processed.
+     */
+    void set_error_mode(sai_bulk_op_error_mode_t mode)
+    {
+        error_mode = mode;
     }
-    */
 
     void flush()
     {
@@ -1005,58 +1175,64 @@ public:
         {
             create_statuses.clear();
             std::vector<sai_object_id_t *> rs;
+            std::vector<sai_status_t *> ss;
             std::vector<sai_attribute_t const*> tss;
             std::vector<uint32_t> cs;
 
             for (auto const& i: creating_entries)
             {
                 sai_object_id_t *pid = std::get<0>(i);
-                auto const& attrs = std::get<1>(i);
+                auto const& attrs = std::get<2>(i);
                 if (*pid == SAI_NULL_OBJECT_ID)
                 {
                     rs.push_back(pid);
+                    ss.push_back(std::get<1>(i));
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
 
                     if (rs.size() >= max_bulk_size)
                     {
-                        flush_creating_entries(rs, tss, cs);
+                        flush_creating_entries(rs, ss, tss, cs);
                     }
                 }
             }
-            flush_creating_entries(rs, tss, cs);
+            flush_creating_entries(rs, ss, tss, cs);
 
             creating_entries.clear();
         }
 
         // Setting
-        // TODO: wait until available in SAI
-        /*
         if (!setting_entries.empty())
         {
             std::vector<sai_object_id_t> rs;
             std::vector<sai_attribute_t> ts;
+            std::vector<sai_status_t *> status_vector;
 
             for (auto const& i: setting_entries)
             {
                 auto const& entry = i.first;
                 auto const& attrs = i.second;
-                for (auto const& attr: attrs)
+                for (auto const& ia: attrs)
                 {
-                    rs.push_back(entry);
-                    ts.push_back(attr);
-
-                    if (rs.size() >= max_bulk_size)
+                    auto const& attr = ia.first;
+                    sai_status_t *object_status = ia.second;
+                    if (*object_status == SAI_STATUS_NOT_EXECUTED)
                     {
-                        flush_setting_entries(rs, ts);
+                        rs.push_back(entry);
+                        ts.push_back(attr);
+                        status_vector.push_back(object_status);
+
+                        if (rs.size() >= max_bulk_size)
+                        {
+                            flush_setting_entries(rs, ts, status_vector);
+                        }
                     }
                 }
             }
-            flush_setting_entries(rs, ts);
+            flush_setting_entries(rs, ts, status_vector);
 
             setting_entries.clear();
         }
-        */
     }
 
     void clear()
@@ -1086,32 +1262,25 @@ public:
     }
 
 private:
-    struct object_entry
-    {
-        sai_object_id_t *object_id;
-        std::vector<sai_attribute_t> attrs;
-        template <class InputIterator>
-        object_entry(sai_object_id_t *object_id, InputIterator first, InputIterator last)
-            : object_id(object_id)
-            , attrs(first, last)
-        {
-        }
-    };
-
     sai_object_id_t                                         switch_id;
 
     size_t max_bulk_size;
 
-    std::vector<std::pair<                                  // A vector of pair of
+    sai_bulk_op_error_mode_t error_mode = SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR;
+
+    std::vector<std::tuple<                                 // A vector of tuple of
             sai_object_id_t *,                              // - object_id
+            sai_status_t *,                                 // - OUT object_status, optional
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
     std::unordered_map<                                     // A map of
-            sai_object_id_t,                                // object_id -> (OUT object_status, attributes)
-            std::pair<
-                    sai_status_t *,
-                    std::vector<sai_attribute_t>
+            sai_object_id_t,                                // object_id ->
+            std::vector<                                    //     vector of attribute and status
+                    std::pair<
+                            sai_attribute_t,                //     (attr_value, OUT object_status)
+                            sai_status_t *
+                    >
             >
     >                                                       setting_entries;
 
@@ -1121,8 +1290,7 @@ private:
 
     typename Ts::bulk_create_entry_fn                       create_entries;
     typename Ts::bulk_remove_entry_fn                       remove_entries;
-    // TODO: wait until available in SAI
-    //typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute;
+    typename Ts::bulk_set_entry_attribute_fn                set_entries_attribute = nullptr;
 
     std::unordered_map<sai_object_id_t, sai_status_t>       create_statuses;
 
@@ -1135,7 +1303,7 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), error_mode, statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
@@ -1160,6 +1328,7 @@ private:
 
     sai_status_t flush_creating_entries(
         _Inout_ std::vector<sai_object_id_t *> &rs,
+        _Inout_ std::vector<sai_status_t *> &ss,
         _Inout_ std::vector<sai_attribute_t const*> &tss,
         _Inout_ std::vector<uint32_t> &cs)
     {
@@ -1171,7 +1340,7 @@ private:
         std::vector<sai_object_id_t> object_ids(count);
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            , error_mode, object_ids.data(), statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", count);
@@ -1187,20 +1356,24 @@ private:
             create_statuses.emplace(object_ids[i], statuses[i]);
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+            if (ss[i])
+            {
+                *ss[i] = statuses[i];
+            }
         }
 
         rs.clear();
+        ss.clear();
         tss.clear();
         cs.clear();
 
         return status;
     }
 
-    // TODO: wait until available in SAI
-    /*
     sai_status_t flush_setting_entries(
         _Inout_ std::vector<sai_object_id_t> &rs,
-        _Inout_ std::vector<sai_attribute_t> &ts)
+        _Inout_ std::vector<sai_attribute_t> &ts,
+        _Inout_ std::vector<sai_status_t *> &status_vector)
     {
         if (rs.empty())
         {
@@ -1209,7 +1382,7 @@ private:
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+            , error_mode, statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush setting_entries %zu\n", count);
@@ -1220,12 +1393,17 @@ private:
                             count, sai_serialize_status(status).c_str());
         }
 
+        for (size_t i = 0; i < count; i++)
+        {
+            *status_vector[i] = statuses[i];
+        }
+
         rs.clear();
         ts.clear();
+        status_vector.clear();
 
         return status;
     }
-     */
 };
 
 template <>
@@ -1258,3 +1436,137 @@ inline ObjectBulker<sai_dash_vnet_api_t>::ObjectBulker(SaiBulkerTraits<sai_dash_
     create_entries = api->create_vnets;
     remove_entries = api->remove_vnets;
 }
+
+/*
+ * ACL entries and counters have no bulk functions in sai_acl_api_t, they are
+ * created and removed through the generic SAI bulk object functions.
+ */
+inline sai_status_t sai_bulk_create_acl_entries(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_create(switch_id, SAI_OBJECT_TYPE_ACL_ENTRY, object_count,
+                                  attr_count, attr_list, mode, object_id, object_statuses);
+}
+
+inline sai_status_t sai_bulk_remove_acl_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_remove(SAI_OBJECT_TYPE_ACL_ENTRY, object_count, object_id, mode, object_statuses);
+}
+
+inline sai_status_t sai_bulk_set_acl_entries_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_set_attribute(SAI_OBJECT_TYPE_ACL_ENTRY, object_count, object_id, attr_list, mode, object_statuses);
+}
+
+inline sai_status_t sai_bulk_create_acl_counters(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_create(switch_id, SAI_OBJECT_TYPE_ACL_COUNTER, object_count,
+                                  attr_count, attr_list, mode, object_id, object_statuses);
+}
+
+inline sai_status_t sai_bulk_remove_acl_counters(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_remove(SAI_OBJECT_TYPE_ACL_COUNTER, object_count, object_id, mode, object_statuses);
+}
+
+inline sai_status_t sai_bulk_set_acl_counters_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_set_attribute(SAI_OBJECT_TYPE_ACL_COUNTER, object_count, object_id, attr_list, mode, object_statuses);
+}
+
+template <>
+inline ObjectBulker<sai_acl_entry_bulk_t>::ObjectBulker(SaiBulkerTraits<sai_acl_entry_bulk_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = sai_bulk_create_acl_entries;
+    remove_entries = sai_bulk_remove_acl_entries;
+    set_entries_attribute = sai_bulk_set_acl_entries_attribute;
+}
+
+template <>
+inline ObjectBulker<sai_acl_counter_bulk_t>::ObjectBulker(SaiBulkerTraits<sai_acl_counter_bulk_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = sai_bulk_create_acl_counters;
+    remove_entries = sai_bulk_remove_acl_counters;
+    set_entries_attribute = sai_bulk_set_acl_counters_attribute;
+}
+
+/*
+ * Router interfaces have no bulk functions in sai_router_interface_api_t
+ * either, they go through the generic SAI bulk object functions too.
+ */
+inline sai_status_t sai_bulk_create_router_interfaces(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_create(switch_id, SAI_OBJECT_TYPE_ROUTER_INTERFACE, object_count,
+                                  attr_count, attr_list, mode, object_id, object_statuses);
+}
+
+inline sai_status_t sai_bulk_remove_router_interfaces(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_remove(SAI_OBJECT_TYPE_ROUTER_INTERFACE, object_count, object_id, mode, object_statuses);
+}
+
+inline sai_status_t sai_bulk_set_router_interfaces_attribute(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const sai_attribute_t *attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    return sai_bulk_object_set_attribute(SAI_OBJECT_TYPE_ROUTER_INTERFACE, object_count, object_id, attr_list, mode, object_statuses);
+}
+
+template <>
+inline ObjectBulker<sai_router_interface_api_t>::ObjectBulker(SaiBulkerTraits<sai_router_interface_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = sai_bulk_create_router_interfaces;
+    remove_entries = sai_bulk_remove_router_interfaces;
+    set_entries_attribute = sai_bulk_set_router_interfaces_attribute;
+}
@@ -1215,6 +1215,14 @@ void CoppOrch::initTrapRatePlugin()
         SWSS_LOG_ERROR("Trap flex counter groups were not set successfully: %s", e.what());
     }
 
+    // Keep the plugin of the native rates, it is set back to the Lua
+    // plugin when they are disabled
+    auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+    if (flex_counters_orch && flex_counters_orch->getNativeRatesState(HOSTIF_TRAP_COUNTER_FLEX_COUNTER_GROUP))
+    {
+        trapSha = "";
+    }
+
     setFlexCounterGroupParameter(HOSTIF_TRAP_COUNTER_FLEX_COUNTER_GROUP,
                                  "", // Do not touch poll interval
                                  STATS_MODE_READ,
@@ -24,7 +24,9 @@ CounterCheckOrch& CounterCheckOrch::getInstance(DBConnector *db)
 CounterCheckOrch::CounterCheckOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
-    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE))
+    m_countersTable(new Table(m_countersDb.get(), COUNTERS_TABLE)),
+    m_portSnapshotReader(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP),
+    m_queueSnapshotReader(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP)
 {
     SWSS_LOG_ENTER();
 
@@ -44,10 +46,19 @@ void CounterCheckOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
 
+    readCounterSnapshots();
     mcCounterCheck();
     pfcFrameCounterCheck();
 }
 
+void CounterCheckOrch::readCounterSnapshots()
+{
+    SWSS_LOG_ENTER();
+
+    m_portSnapshotValid = m_portSnapshotReader.read(m_portSnapshot);
+    m_queueSnapshotValid = m_queueSnapshotReader.read(m_queueSnapshot);
+}
+
 void CounterCheckOrch::mcCounterCheck()
 {
     SWSS_LOG_ENTER();
@@ -162,6 +173,20 @@ PfcFrameCounters CounterCheckOrch::getPfcFrameCounters(sai_object_id_t portId)
         "SAI_PORT_STAT_PFC_7_RX_PKTS"
     };
 
+    if (m_portSnapshotValid && m_portSnapshot.getObjectIndex(portId) != CounterSnapshot::NOT_FOUND)
+    {
+        for (size_t prio = 0; prio != counterNames.size(); prio++)
+        {
+            uint64_t value;
+            if (m_portSnapshot.get(portId, counterNames[prio], value))
+            {
+                counters[prio] = value;
+            }
+        }
+
+        return counters;
+    }
+
     if (!m_countersTable->get(sai_serialize_object_id(portId), fieldValues))
     {
         return counters;
@@ -197,9 +222,32 @@ QueueMcCounters CounterCheckOrch::getQueueMcCounters(
     {
         sai_object_id_t queueId = port.m_queue_ids[prio];
         auto queueIdStr = sai_serialize_object_id(queueId);
-        auto queueType = m_countersDb->hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
 
-        if (queueType.get() == nullptr || *queueType != "SAI_QUEUE_TYPE_MULTICAST" || !m_countersTable->get(queueIdStr, fieldValues))
+        auto mcQueue = m_mcQueues.find(queueId);
+        if (mcQueue == m_mcQueues.end())
+        {
+            auto queueType = m_countersDb->hget(COUNTERS_QUEUE_TYPE_MAP, queueIdStr);
+            if (queueType.get() == nullptr)
+            {
+                continue;
+            }
+            mcQueue = m_mcQueues.emplace(queueId, *queueType == "SAI_QUEUE_TYPE_MULTICAST").first;
+        }
+
+        if (!mcQueue->second)
+        {
+            continue;
+        }
+
+        if (m_queueSnapshotValid && m_queueSnapshot.getObjectIndex(queueId) != CounterSnapshot::NOT_FOUND)
+        {
+            uint64_t pkts = numeric_limits<uint64_t>::max();
+            m_queueSnapshot.get(queueId, "SAI_QUEUE_STAT_PACKETS", pkts);
+            counters.push_back(pkts);
+            continue;
+        }
+
+        if (!m_countersTable->get(queueIdStr, fieldValues))
         {
             continue;
         }
@@ -223,6 +271,7 @@ QueueMcCounters CounterCheckOrch::getQueueMcCounters(
 
 void CounterCheckOrch::addPort(const Port& port)
 {
+    readCounterSnapshots();
     m_mcCountersMap.emplace(port.m_port_id, getQueueMcCounters(port));
     m_pfcFrameCountersMap.emplace(port.m_port_id, getPfcFrameCounters(port.m_port_id));
 }
@@ -231,4 +280,8 @@ void CounterCheckOrch::removePort(const Port& port)
 {
     m_mcCountersMap.erase(port.m_port_id);
     m_pfcFrameCountersMap.erase(port.m_port_id);
+    for (auto queueId : port.m_queue_ids)
+    {
+        m_mcQueues.erase(queueId);
+    }
 }
@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "port.h"
 #include "timer.h"
+#include "countersnapshot.h"
 #include <array>
 
 #define PFC_WD_TC_MAX 8
@@ -31,12 +32,24 @@ private:
     PfcFrameCounters getPfcFrameCounters(sai_object_id_t portId);
     void mcCounterCheck();
     void pfcFrameCounterCheck();
+    void readCounterSnapshots();
 
     std::map<sai_object_id_t, QueueMcCounters> m_mcCountersMap;
     std::map<sai_object_id_t, PfcFrameCounters> m_pfcFrameCountersMap;
 
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
+
+    // Counters published in shared memory by the counter poller, read once
+    // per check, COUNTERS_DB is read for the objects that are not in them
+    swss::CounterSnapshotReader m_portSnapshotReader;
+    swss::CounterSnapshotReader m_queueSnapshotReader;
+    swss::CounterSnapshot m_portSnapshot;
+    swss::CounterSnapshot m_queueSnapshot;
+    bool m_portSnapshotValid = false;
+    bool m_queueSnapshotValid = false;
+    // Whether a queue is multicast, once COUNTERS_QUEUE_TYPE_MAP has it
+    std::map<sai_object_id_t, bool> m_mcQueues;
 };
 
 #endif
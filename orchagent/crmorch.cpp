@@ -1,4 +1,5 @@
 #include <sstream>
+#include <algorithm>
 #include <inttypes.h>
 
 #include "crmorch.h"
@@ -7,9 +8,12 @@
 #include "saihelper.h"
 
 #define CRM_POLLING_INTERVAL "polling_interval"
+#define CRM_EVENT_DRIVEN "event_driven"
 #define CRM_COUNTERS_TABLE_KEY "STATS"
 
 #define CRM_POLLING_INTERVAL_DEFAULT (5 * 60)
+#define CRM_WATERMARK_CHECK_INTERVAL 1
+#define CRM_EVENT_DRIVEN_FULL_UPDATE_POLLS 12
 #define CRM_THRESHOLD_TYPE_DEFAULT CrmThresholdType::CRM_PERCENTAGE
 #define CRM_THRESHOLD_LOW_DEFAULT 70
 #define CRM_THRESHOLD_HIGH_DEFAULT 85
@@ -283,6 +287,13 @@ const map<string, CrmThresholdType> crmThreshTypeMap =
     { "free", CrmThresholdType::CRM_FREE }
 };
 
+const map<CrmThresholdType, string> crmThreshTypeNameMap =
+{
+    { CrmThresholdType::CRM_PERCENTAGE, "TH_PERCENTAGE" },
+    { CrmThresholdType::CRM_USED, "TH_USED" },
+    { CrmThresholdType::CRM_FREE, "TH_FREE" }
+};
+
 const map<string, CrmResourceType> crmAvailCntsTableMap =
 {
     { "crm_stats_ipv4_route_available", CrmResourceType::CRM_IPV4_ROUTE },
@@ -371,7 +382,8 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
     Orch(db, tableName),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
     m_countersCrmTable(new Table(m_countersDb.get(), COUNTERS_CRM_TABLE)),
-    m_timer(new SelectableTimer(timespec { .tv_sec = CRM_POLLING_INTERVAL_DEFAULT, .tv_nsec = 0 }))
+    m_timer(new SelectableTimer(timespec { .tv_sec = CRM_POLLING_INTERVAL_DEFAULT, .tv_nsec = 0 })),
+    m_watermarkTimer(new SelectableTimer(timespec { .tv_sec = CRM_WATERMARK_CHECK_INTERVAL, .tv_nsec = 0 }))
 {
     SWSS_LOG_ENTER();
 
@@ -389,6 +401,9 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
     auto executor = new ExecutableTimer(m_timer, this, "CRM_COUNTERS_POLL");
     Orch::addExecutor(executor);
     m_timer->start();
+
+    // Runs in event driven mode, for the used counter updates that cross a threshold
+    Orch::addExecutor(new ExecutableTimer(m_watermarkTimer, this, "CRM_WATERMARK_CHECK"));
 }
 
 CrmOrch::CrmResourceEntry::CrmResourceEntry(string name, CrmThresholdType thresholdType, uint32_t lowThreshold, uint32_t highThreshold):
@@ -463,6 +478,23 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
                 m_timer->setInterval(interv);
                 m_timer->reset();
             }
+            else if (field == CRM_EVENT_DRIVEN)
+            {
+                std::lock_guard<std::recursive_mutex> lock(m_resLock);
+                m_eventDriven = (value == "true");
+                m_usedCountersChanged = true;
+                m_eventDrivenPolls = 0;
+                if (m_eventDriven)
+                {
+                    m_watermarkTimer->start();
+                }
+                else
+                {
+                    m_watermarkTimer->stop();
+                    m_watermarkResources.clear();
+                    m_watermarkPending = false;
+                }
+            }
             else if (crmThreshTypeResMap.find(field) != crmThreshTypeResMap.end())
             {
                 auto thresholdType = crmThreshTypeMap.at(value);
@@ -514,10 +546,14 @@ void CrmOrch::handleSetCommand(const string& key, const vector<FieldValueTuple>&
 void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter++;
+        checkCrmWatermark(resource, cnt);
     }
     catch (...)
     {
@@ -529,10 +565,14 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        auto &cnt = m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.usedCounter--;
+        checkCrmWatermark(resource, cnt);
     }
     catch (...)
     {
@@ -544,6 +584,8 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t stage, sai_acl_bind_point_type_t point)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -559,6 +601,8 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t stage, sai_acl_bind_point_type_t point, sai_object_id_t oid)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -598,6 +642,8 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -614,6 +660,8 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_t tableId)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -629,6 +677,8 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -644,6 +694,8 @@ void CrmOrch::incCrmExtTableUsedCounter(CrmResourceType resource, std::string ta
 void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string table_name)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -659,6 +711,8 @@ void CrmOrch::decCrmExtTableUsedCounter(CrmResourceType resource, std::string ta
 void CrmOrch::incCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t tableId)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -692,6 +746,8 @@ void CrmOrch::incCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
 void CrmOrch::decCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t tableId)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+    m_usedCountersChanged = true;
 
     try
     {
@@ -723,12 +779,79 @@ void CrmOrch::decCrmDashAclUsedCounter(CrmResourceType resource, sai_object_id_t
 void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
+    std::lock_guard<std::recursive_mutex> lock(m_resLock);
+
+    if (&timer == m_watermarkTimer)
+    {
+        if (!m_watermarkPending.exchange(false))
+        {
+            return;
+        }
+
+        for (auto type : m_watermarkResources)
+        {
+            getResAvailability(type, m_resourcesMap.at(type));
+        }
+        updateCrmCountersTable(true);
+        for (auto type : m_watermarkResources)
+        {
+            checkCrmThresholds(m_resourcesMap.at(type));
+        }
+        m_watermarkResources.clear();
+        return;
+    }
+
+    // Availability changed outside orchagent and lost COUNTERS_DB entries are caught up by a full update
+    bool fullUpdate = !m_eventDriven || (++m_eventDrivenPolls % CRM_EVENT_DRIVEN_FULL_UPDATE_POLLS == 0);
 
-    getResAvailableCounters();
-    updateCrmCountersTable();
+    // Shared resources may change the availability of each other, so all of them are read
+    if (fullUpdate || m_usedCountersChanged)
+    {
+        m_usedCountersChanged = false;
+        getResAvailableCounters();
+    }
+
+    updateCrmCountersTable(!fullUpdate);
     checkCrmThresholds();
 }
 
+/*
+ * With CRM event_driven set, the polling reads the available counters from
+ * SAI only if a used counter changed, and writes only the changed counters to
+ * COUNTERS_DB, except for every CRM_EVENT_DRIVEN_FULL_UPDATE_POLLS polling
+ * which reads and writes all of them. Between two readings of the available
+ * counter of a resource, its usage is tracked by the used counter updates,
+ * each taking one entry of the resource. When the utilization estimated that
+ * way crosses the high threshold, or the low threshold after the high one was
+ * exceeded, the resource is flagged. The watermark timer of the main thread
+ * then reads it from SAI and checks its thresholds within a second, instead
+ * of at the next polling. The used counters may be updated by orchs run by
+ * worker threads, which must not touch the timer.
+ */
+void CrmOrch::checkCrmWatermark(CrmResourceType type, const CrmResourceCounter &cnt)
+{
+    const auto &res = m_resourcesMap.at(type);
+
+    if (!m_eventDriven || (res.resStatus != CrmResourceStatus::CRM_RES_SUPPORTED) || (cnt.queriedUsedCounter < 0) ||
+        (m_watermarkResources.find(type) != m_watermarkResources.end()))
+    {
+        return;
+    }
+
+    int64_t available = static_cast<int64_t>(cnt.availableCounter) - (static_cast<int64_t>(cnt.usedCounter) - cnt.queriedUsedCounter);
+    uint32_t percentageUtil = 0;
+    uint64_t utilization = getCrmUtilization(res, cnt.usedCounter, static_cast<uint32_t>(max<int64_t>(available, 0)), percentageUtil);
+
+    if (((cnt.exceededLogCounter == 0) && (utilization >= res.highThreshold)) ||
+        ((cnt.exceededLogCounter > 0) && (utilization <= res.lowThreshold)))
+    {
+        SWSS_LOG_INFO("%s crossed a threshold, used count %u", res.name.c_str(), cnt.usedCounter);
+
+        m_watermarkResources.insert(type);
+        m_watermarkPending = true;
+    }
+}
+
 bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
 {
     sai_attribute_t attr;
@@ -801,7 +924,9 @@ bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
         availCount = attr.value.u32;
     }
 
-    res.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = static_cast<uint32_t>(availCount);
+    auto &cnt = res.countersMap[CRM_COUNTERS_TABLE_KEY];
+    cnt.availableCounter = static_cast<uint32_t>(availCount);
+    cnt.queriedUsedCounter = cnt.usedCounter;
 
     return true;
 }
@@ -1028,7 +1153,7 @@ void CrmOrch::getResAvailableCounters()
     }
 }
 
-void CrmOrch::updateCrmCountersTable()
+void CrmOrch::updateCrmCountersTable(bool changedOnly)
 {
     SWSS_LOG_ENTER();
 
@@ -1037,17 +1162,23 @@ void CrmOrch::updateCrmCountersTable()
     {
         try
         {
-            const auto &res = m_resourcesMap.at(i.second);
+            auto &res = m_resourcesMap.at(i.second);
             if (res.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
             {
                 continue;
             }
 
-            for (const auto &cnt : res.countersMap)
+            for (auto &cnt : res.countersMap)
             {
+                if (changedOnly && (cnt.second.writtenUsedCounter == cnt.second.usedCounter))
+                {
+                    continue;
+                }
+
                 FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
                 vector<FieldValueTuple> attrs = { attr };
                 m_countersCrmTable->set(cnt.first, attrs);
+                cnt.second.writtenUsedCounter = cnt.second.usedCounter;
             }
         }
         catch(const out_of_range &e)
@@ -1061,17 +1192,23 @@ void CrmOrch::updateCrmCountersTable()
     {
         try
         {
-            const auto &res = m_resourcesMap.at(i.second);
+            auto &res = m_resourcesMap.at(i.second);
             if (res.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
             {
                 continue;
             }
 
-            for (const auto &cnt : res.countersMap)
+            for (auto &cnt : res.countersMap)
             {
+                if (changedOnly && (cnt.second.writtenAvailableCounter == cnt.second.availableCounter))
+                {
+                    continue;
+                }
+
                 FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
                 vector<FieldValueTuple> attrs = { attr };
                 m_countersCrmTable->set(cnt.first, attrs);
+                cnt.second.writtenAvailableCounter = cnt.second.availableCounter;
             }
         }
         catch(const out_of_range &e)
@@ -1087,77 +1224,86 @@ void CrmOrch::checkCrmThresholds()
 
     for (auto &i : m_resourcesMap)
     {
-        auto &res = i.second;
+        checkCrmThresholds(i.second);
+    }
+}
+
+void CrmOrch::checkCrmThresholds(CrmResourceEntry &res)
+{
+    SWSS_LOG_ENTER();
+
+    if (res.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
+    {
+        return;
+    }
 
-        if (res.resStatus == CrmResourceStatus::CRM_RES_NOT_SUPPORTED)
-        {
-            continue;
-        }
+    auto threshTypeIt = crmThreshTypeNameMap.find(res.thresholdType);
+    if (threshTypeIt == crmThreshTypeNameMap.end())
+    {
+        throw runtime_error("Unknown threshold type for CRM resource");
+    }
+    const auto &threshType = threshTypeIt->second;
 
-        for (auto &j : i.second.countersMap)
+    for (auto &j : res.countersMap)
+    {
+        auto &cnt = j.second;
+        uint32_t percentageUtil = 0;
+        uint64_t utilization = getCrmUtilization(res, cnt.usedCounter, cnt.availableCounter, percentageUtil);
+
+        if ((utilization >= res.highThreshold) && (cnt.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
         {
-            auto &cnt = j.second;
-            uint64_t utilization = 0;
-            uint32_t percentageUtil = 0;
-            string threshType = "";
+            event_params_t params = {
+                { "percent", to_string(percentageUtil) },
+                { "used_cnt", to_string(cnt.usedCounter) },
+                { "free_cnt", to_string(cnt.availableCounter) }};
 
-            if (cnt.usedCounter != 0)
-            {
-                uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
-                if (dvsr != 0)
-                {
-                    percentageUtil = (cnt.usedCounter * 100) / dvsr;
-                }
-                else
-                {
-                    SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
-                                  res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
-                }
-            }
+            SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
+                          res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
 
-            switch (res.thresholdType)
-            {
-                case CrmThresholdType::CRM_PERCENTAGE:
-                    utilization = percentageUtil;
-                    threshType = "TH_PERCENTAGE";
-                    break;
-                case CrmThresholdType::CRM_USED:
-                    utilization = cnt.usedCounter;
-                    threshType = "TH_USED";
-                    break;
-                case CrmThresholdType::CRM_FREE:
-                    utilization = cnt.availableCounter;
-                    threshType = "TH_FREE";
-                    break;
-                default:
-                    throw runtime_error("Unknown threshold type for CRM resource");
-            }
+            event_publish(g_events_handle, "chk_crm_threshold", &params);
+            cnt.exceededLogCounter++;
+        }
+        else if ((utilization <= res.lowThreshold) && (cnt.exceededLogCounter > 0) && (res.highThreshold != res.lowThreshold))
+        {
+            SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
+                          res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
 
-            if ((utilization >= res.highThreshold) && (cnt.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
-            {
-                event_params_t params = {
-                    { "percent", to_string(percentageUtil) },
-                    { "used_cnt", to_string(cnt.usedCounter) },
-                    { "free_cnt", to_string(cnt.availableCounter) }};
+            cnt.exceededLogCounter = 0;
+        }
+    }
+}
 
-                SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+uint64_t CrmOrch::getCrmUtilization(const CrmResourceEntry &res, uint32_t used, uint32_t available, uint32_t &percentageUtil) const
+{
+    percentageUtil = 0;
 
-                event_publish(g_events_handle, "chk_crm_threshold", &params);
-                cnt.exceededLogCounter++;
-            }
-            else if ((utilization <= res.lowThreshold) && (cnt.exceededLogCounter > 0) && (res.highThreshold != res.lowThreshold))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    if (used != 0)
+    {
+        uint32_t dvsr = used + available;
+        if (dvsr != 0)
+        {
+            percentageUtil = (used * 100) / dvsr;
+        }
+        else
+        {
+            SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
+                          res.name.c_str(), used, available);
+        }
+    }
 
-                cnt.exceededLogCounter = 0;
-            }
-        } // end of counters loop
-    } // end of resources loop
+    switch (res.thresholdType)
+    {
+        case CrmThresholdType::CRM_PERCENTAGE:
+            return percentageUtil;
+        case CrmThresholdType::CRM_USED:
+            return used;
+        case CrmThresholdType::CRM_FREE:
+            return available;
+        default:
+            throw runtime_error("Unknown threshold type for CRM resource");
+    }
 }
 
-
 string CrmOrch::getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint)
 {
     string key = "ACL_STATS";
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <map>
+#include <mutex>
+#include <set>
 #include "orch.h"
 #include "port.h"
 #include "events.h"
@@ -93,6 +96,7 @@ private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::Table> m_countersCrmTable = nullptr;
     swss::SelectableTimer *m_timer = nullptr;
+    swss::SelectableTimer *m_watermarkTimer = nullptr;
 
     struct CrmResourceCounter
     {
@@ -100,6 +104,11 @@ private:
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
         uint32_t exceededLogCounter = 0;
+        /* Used counter when the available counter was read from SAI, -1 until it is read */
+        int64_t queriedUsedCounter = -1;
+        /* Counters last written to COUNTERS_DB, -1 until they are written */
+        int64_t writtenUsedCounter = -1;
+        int64_t writtenAvailableCounter = -1;
     };
 
     struct CrmResourceEntry
@@ -120,6 +129,16 @@ private:
     std::chrono::seconds m_pollingInterval;
 
     std::map<CrmResourceType, CrmResourceEntry> m_resourcesMap;
+    /* Used counters may be updated by orchs run by worker threads */
+    std::recursive_mutex m_resLock;
+    /* Event driven mode, the polling reads the available counters from SAI only after a used counter changed */
+    bool m_eventDriven = false;
+    bool m_usedCountersChanged = true;
+    /* Pollings in event driven mode, every CRM_EVENT_DRIVEN_FULL_UPDATE_POLLS one reads and writes all the counters */
+    uint32_t m_eventDrivenPolls = 0;
+    /* Resources whose estimated utilization crossed the high or low threshold, checked by m_watermarkTimer */
+    std::set<CrmResourceType> m_watermarkResources;
+    std::atomic<bool> m_watermarkPending { false };
 
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
@@ -127,8 +146,11 @@ private:
     bool getResAvailability(CrmResourceType type, CrmResourceEntry &res);
     bool getDashAclGroupResAvailability(CrmResourceType type, CrmResourceEntry &res);
     void getResAvailableCounters();
-    void updateCrmCountersTable();
+    void updateCrmCountersTable(bool changedOnly = false);
     void checkCrmThresholds();
+    void checkCrmThresholds(CrmResourceEntry &res);
+    void checkCrmWatermark(CrmResourceType type, const CrmResourceCounter &cnt);
+    uint64_t getCrmUtilization(const CrmResourceEntry &res, uint32_t used, uint32_t available, uint32_t &percentageUtil) const;
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     std::string getCrmAclTableKey(sai_object_id_t id);
     std::string getCrmP4rtTableKey(std::string table_name);
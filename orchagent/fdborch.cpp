@@ -1,5 +1,6 @@
 #include <assert.h>
 #include <iostream>
+#include <set>
 #include <vector>
 #include <unordered_map>
 #include <utility>
@@ -18,6 +19,7 @@
 extern sai_fdb_api_t    *sai_fdb_api;
 
 extern sai_object_id_t  gSwitchId;
+extern size_t           gMaxBulkSize;
 extern CrmOrch *        gCrmOrch;
 extern MlagOrch*        gMlagOrch;
 extern Directory<Orch*> gDirectory;
@@ -29,7 +31,8 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    gFdbBulker(sai_fdb_api, gMaxBulkSize)
 {
     for(auto it: appFdbTables)
     {
@@ -726,6 +729,10 @@ void FdbOrch::doTask(Consumer& consumer)
         origin = FDB_ORIGIN_MCLAG_ADVERTIZED;
     }
 
+    /* FDB bulk contexts of the tasks waiting for the bulker results */
+    std::deque<FdbBulkContext> toBulk;
+    std::vector<std::pair<SyncMap::iterator, FdbBulkContext*>> pending;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -855,60 +862,53 @@ void FdbOrch::doTask(Consumer& consumer)
                 }
             }
 
-
-            FdbData fdbData;
-            fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
-            fdbData.type = type;
-            fdbData.origin = origin;
-            fdbData.remote_ip = remote_ip;
-            fdbData.esi = esi;
-            fdbData.vni = vni;
-            fdbData.is_flush_pending = false;
-            fdbData.discard = discard;
-            if (addFdbEntry(entry, port, fdbData))
+            toBulk.emplace_back(true);
+            auto& ctx = toBulk.back();
+            ctx.entry = entry;
+            ctx.port_name = port;
+            ctx.fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+            ctx.fdbData.type = type;
+            ctx.fdbData.origin = origin;
+            ctx.fdbData.remote_ip = remote_ip;
+            ctx.fdbData.esi = esi;
+            ctx.fdbData.vni = vni;
+            ctx.fdbData.is_flush_pending = false;
+            ctx.fdbData.discard = discard;
+
+            if (addFdbEntry(ctx, true))
             {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
-                {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    if (type == "dynamic_local")
-                    {
-                        m_mclagFdbStateTable.del(key);
-                    }
-                }
-
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-                {
-                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
-
-                    if(!remote_ip.length())
-                    {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
-                    }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
-                }
+                doFdbTaskPost(ctx, vlan);
                 it = consumer.m_toSync.erase(it);
             }
             else
+            {
+                if (!ctx.object_statuses.empty())
+                {
+                    pending.emplace_back(it, &ctx);
+                }
                 it++;
+            }
         }
         else if (op == DEL_COMMAND)
         {
-            if (removeFdbEntry(entry, origin))
-            {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
-                {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    m_mclagFdbStateTable.del(key);
-                    SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
-                            "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
-                }
+            toBulk.emplace_back(false);
+            auto& ctx = toBulk.back();
+            ctx.entry = entry;
+            ctx.origin = origin;
 
+            if (removeFdbEntry(ctx, true))
+            {
+                doFdbTaskPost(ctx, vlan);
                 it = consumer.m_toSync.erase(it);
             }
             else
+            {
+                if (!ctx.object_statuses.empty())
+                {
+                    pending.emplace_back(it, &ctx);
+                }
                 it++;
-
+            }
         }
         else
         {
@@ -916,6 +916,57 @@ void FdbOrch::doTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (pending.empty())
+    {
+        return;
+    }
+
+    // Flush the FDB bulker, so FDB entries will be written to syncd and ASIC
+    gFdbBulker.flush();
+
+    // Go through the bulker results in the order of the tasks
+    for (auto& p : pending)
+    {
+        auto& ctx = *p.second;
+        bool done = ctx.is_set ? addFdbEntryPost(ctx) : removeFdbEntryPost(ctx);
+        if (!done)
+        {
+            continue;
+        }
+
+        Port vlan;
+        if (m_portsOrch->getPort(ctx.entry.bv_id, vlan))
+        {
+            doFdbTaskPost(ctx, vlan);
+        }
+        consumer.m_toSync.erase(p.first);
+    }
+}
+
+/* Update the MCLAG state of a FDB task once it is programmed */
+void FdbOrch::doFdbTaskPost(const FdbBulkContext& ctx, const Port& vlan)
+{
+    FdbOrigin origin = ctx.is_set ? ctx.fdbData.origin : ctx.origin;
+    if (origin != FDB_ORIGIN_MCLAG_ADVERTIZED)
+    {
+        return;
+    }
+
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + ctx.entry.mac.to_string();
+    if (ctx.is_set)
+    {
+        if (ctx.fdbData.type == "dynamic_local")
+        {
+            m_mclagFdbStateTable.del(key);
+        }
+    }
+    else
+    {
+        m_mclagFdbStateTable.del(key);
+        SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
+                "Mac: %s Vlan: %d ", ctx.entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id);
+    }
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -927,41 +978,78 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
         return;
     }
 
-    sai_status_t status;
+    if (&consumer == m_flushNotificationsConsumer)
+    {
+        flushFdbRequests(consumer);
+        return;
+    }
+
     std::string op;
     std::string data;
     std::vector<swss::FieldValueTuple> values;
-    string alias;
-    string vlan;
-    Port port;
-    Port vlanPort;
 
     consumer.pop(op, data, values);
 
-    if (&consumer == m_flushNotificationsConsumer)
+    if (&consumer == m_fdbNotificationConsumer && op == "fdb_event")
     {
-        if (op == "ALL")
+        uint32_t count;
+        sai_fdb_event_notification_data_t *fdbevent = nullptr;
+        sai_fdb_entry_type_t sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+
+        sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+
+        for (uint32_t i = 0; i < count; ++i)
         {
-            vector<sai_attribute_t>    attrs;
-            sai_attribute_t            attr;
-            attr.id = SAI_FDB_FLUSH_ATTR_ENTRY_TYPE;
-            attr.value.s32 = SAI_FDB_FLUSH_ENTRY_TYPE_DYNAMIC;
-            attrs.push_back(attr);
-            status = sai_fdb_api->flush_fdb_entries(gSwitchId, (uint32_t)attrs.size(), attrs.data());
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Flush fdb failed, return code %x", status);
-            }
+            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
 
-            if (status == SAI_STATUS_SUCCESS) {
-                for (map<FdbEntry, FdbData>::iterator it = m_entries.begin();
-                        it != m_entries.end(); it++)
+            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
+            {
+                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
+                {
+                    oid = fdbevent[i].attr[j].value.oid;
+                }
+                else if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_TYPE)
                 {
-                    it->second.is_flush_pending = true;
+                    sai_fdb_type = (sai_fdb_entry_type_t)fdbevent[i].attr[j].value.s32;
                 }
             }
 
-            return;
+            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid, sai_fdb_type);
+        }
+
+        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+    }
+}
+
+/*
+ * Drain the pending FLUSHFDBREQUEST notifications and flush them in one go.
+ * Duplicated requests are flushed once, and a request covered by a wider one
+ * of the same batch (all, per port or per VLAN) is skipped.
+ */
+void FdbOrch::flushFdbRequests(NotificationConsumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    std::deque<KeyOpFieldsValuesTuple> requests;
+    consumer.pops(requests);
+
+    bool flushAll = false;
+    set<sai_object_id_t> portFlushes;
+    set<sai_object_id_t> vlanFlushes;
+    set<pair<sai_object_id_t, sai_object_id_t>> portVlanFlushes;
+
+    for (const auto& request : requests)
+    {
+        const string& op = kfvOp(request);
+        const string& data = kfvKey(request);
+        string alias;
+        string vlan;
+        Port port;
+        Port vlanPort;
+
+        if (op == "ALL")
+        {
+            flushAll = true;
         }
         else if (op == "PORT")
         {
@@ -969,20 +1057,19 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
             if (alias.empty())
             {
                 SWSS_LOG_ERROR("Receive wrong port to flush fdb!");
-                return;
+                continue;
             }
             if (!m_portsOrch->getPort(alias, port))
             {
                 SWSS_LOG_ERROR("Get Port from port(%s) failed!", alias.c_str());
-                return;
+                continue;
             }
             if (port.m_bridge_port_id == SAI_NULL_OBJECT_ID)
             {
-                return;
+                continue;
             }
-            flushFDBEntries(port.m_bridge_port_id, SAI_NULL_OBJECT_ID);
+            portFlushes.insert(port.m_bridge_port_id);
             SWSS_LOG_NOTICE("Clear fdb by port(%s)", alias.c_str());
-            return;
         }
         else if (op == "VLAN")
         {
@@ -990,20 +1077,19 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
             if (vlan.empty())
             {
                 SWSS_LOG_ERROR("Receive wrong vlan to flush fdb!");
-                return;
+                continue;
             }
             if (!m_portsOrch->getPort(vlan, vlanPort))
             {
                 SWSS_LOG_ERROR("Get Port from vlan(%s) failed!", vlan.c_str());
-                return;
+                continue;
             }
             if (vlanPort.m_vlan_info.vlan_oid == SAI_NULL_OBJECT_ID)
             {
-                return;
+                continue;
             }
-            flushFDBEntries(SAI_NULL_OBJECT_ID, vlanPort.m_vlan_info.vlan_oid);
+            vlanFlushes.insert(vlanPort.m_vlan_info.vlan_oid);
             SWSS_LOG_NOTICE("Clear fdb by vlan(%s)", vlan.c_str());
-            return;
         }
         else if (op == "PORTVLAN")
         {
@@ -1016,61 +1102,100 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
             if (alias.empty() || vlan.empty())
             {
                 SWSS_LOG_ERROR("Receive wrong port or vlan to flush fdb!");
-                return;
+                continue;
             }
             if (!m_portsOrch->getPort(alias, port))
             {
                 SWSS_LOG_ERROR("Get Port from port(%s) failed!", alias.c_str());
-                return;
+                continue;
             }
             if (!m_portsOrch->getPort(vlan, vlanPort))
             {
                 SWSS_LOG_ERROR("Get Port from vlan(%s) failed!", vlan.c_str());
-                return;
+                continue;
             }
             if (port.m_bridge_port_id == SAI_NULL_OBJECT_ID ||
                 vlanPort.m_vlan_info.vlan_oid == SAI_NULL_OBJECT_ID)
             {
-                return;
+                continue;
             }
-            flushFDBEntries(port.m_bridge_port_id, vlanPort.m_vlan_info.vlan_oid); 
+            portVlanFlushes.emplace(port.m_bridge_port_id, vlanPort.m_vlan_info.vlan_oid);
             SWSS_LOG_NOTICE("Clear fdb by port(%s)+vlan(%s)", alias.c_str(), vlan.c_str());
-            return;
         }
         else
         {
             SWSS_LOG_ERROR("Received unknown flush fdb request");
-            return;
         }
     }
-    else if (&consumer == m_fdbNotificationConsumer && op == "fdb_event")
+
+    if (flushAll)
     {
-        uint32_t count;
-        sai_fdb_event_notification_data_t *fdbevent = nullptr;
-        sai_fdb_entry_type_t sai_fdb_type = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+        vector<sai_attribute_t>    attrs;
+        sai_attribute_t            attr;
+        attr.id = SAI_FDB_FLUSH_ATTR_ENTRY_TYPE;
+        attr.value.s32 = SAI_FDB_FLUSH_ENTRY_TYPE_DYNAMIC;
+        attrs.push_back(attr);
+        sai_status_t status = sai_fdb_api->flush_fdb_entries(gSwitchId, (uint32_t)attrs.size(), attrs.data());
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Flush fdb failed, return code %x", status);
+            return;
+        }
 
-        sai_deserialize_fdb_event_ntf(data, count, &fdbevent);
+        for (auto& it : m_entries)
+        {
+            it.second.is_flush_pending = true;
+        }
 
-        for (uint32_t i = 0; i < count; ++i)
+        SWSS_LOG_INFO("Flushed all fdb, %zu other requests skipped", requests.size() - 1);
+        return;
+    }
+
+    set<sai_object_id_t> flushedPorts;
+    set<sai_object_id_t> flushedVlans;
+
+    for (auto bridge_port_oid : portFlushes)
+    {
+        if (issueFdbFlush(bridge_port_oid, SAI_NULL_OBJECT_ID) == SAI_STATUS_SUCCESS)
         {
-            sai_object_id_t oid = SAI_NULL_OBJECT_ID;
+            flushedPorts.insert(bridge_port_oid);
+        }
+    }
 
-            for (uint32_t j = 0; j < fdbevent[i].attr_count; ++j)
-            {
-                if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
-                {
-                    oid = fdbevent[i].attr[j].value.oid;
-                }
-                else if (fdbevent[i].attr[j].id == SAI_FDB_ENTRY_ATTR_TYPE)
-                {
-                    sai_fdb_type = (sai_fdb_entry_type_t)fdbevent[i].attr[j].value.s32;
-                }
-            }
+    for (auto vlan_oid : vlanFlushes)
+    {
+        if (issueFdbFlush(SAI_NULL_OBJECT_ID, vlan_oid) == SAI_STATUS_SUCCESS)
+        {
+            flushedVlans.insert(vlan_oid);
+        }
+    }
 
-            this->update(fdbevent[i].event_type, &fdbevent[i].fdb_entry, oid, sai_fdb_type);
+    for (const auto& portVlan : portVlanFlushes)
+    {
+        if (portFlushes.count(portVlan.first) || vlanFlushes.count(portVlan.second))
+        {
+            continue;
         }
+        if (issueFdbFlush(portVlan.first, portVlan.second) == SAI_STATUS_SUCCESS)
+        {
+            flushedPorts.insert(portVlan.first);
+            flushedVlans.insert(portVlan.second);
+        }
+    }
 
-        sai_deserialize_free_fdb_event_ntf(count, fdbevent);
+    if (flushedPorts.empty() && flushedVlans.empty())
+    {
+        return;
+    }
+
+    /* Mark the flushed entries in a single pass over the FDB cache */
+    for (auto& it : m_entries)
+    {
+        if (flushedPorts.count(it.second.bridge_port_id) ||
+            flushedVlans.count(it.first.bv_id))
+        {
+            it.second.is_flush_pending = true;
+        }
     }
 }
 
@@ -1089,10 +1214,6 @@ void FdbOrch::doTask(NotificationConsumer& consumer)
 void FdbOrch::flushFDBEntries(sai_object_id_t bridge_port_oid,
                               sai_object_id_t vlan_oid)
 {
-    vector<sai_attribute_t>    attrs;
-    sai_attribute_t            attr;
-    sai_status_t               rv = SAI_STATUS_SUCCESS;
-
     SWSS_LOG_ENTER();
 
     if (SAI_NULL_OBJECT_ID == bridge_port_oid &&
@@ -1103,6 +1224,31 @@ void FdbOrch::flushFDBEntries(sai_object_id_t bridge_port_oid,
         return;
     }
 
+    sai_status_t rv = issueFdbFlush(bridge_port_oid, vlan_oid);
+
+    if (SAI_STATUS_SUCCESS == rv) {
+        for (map<FdbEntry, FdbData>::iterator it = m_entries.begin();
+                it != m_entries.end(); it++)
+        {
+            if ((bridge_port_oid != SAI_NULL_OBJECT_ID &&
+                    it->second.bridge_port_id == bridge_port_oid) ||
+                    (vlan_oid != SAI_NULL_OBJECT_ID &&
+                    it->first.bv_id == vlan_oid))
+            {
+                it->second.is_flush_pending = true;
+            }
+        }
+    }
+}
+
+/* Flush the dynamic FDB entries of a bridge port, a VLAN or both in SAI */
+sai_status_t FdbOrch::issueFdbFlush(sai_object_id_t bridge_port_oid,
+                                    sai_object_id_t vlan_oid)
+{
+    vector<sai_attribute_t>    attrs;
+    sai_attribute_t            attr;
+    sai_status_t               rv = SAI_STATUS_SUCCESS;
+
     if (SAI_NULL_OBJECT_ID != bridge_port_oid)
     {
         attr.id = SAI_FDB_FLUSH_ATTR_BRIDGE_PORT_ID;
@@ -1130,20 +1276,9 @@ void FdbOrch::flushFDBEntries(sai_object_id_t bridge_port_oid,
         SWSS_LOG_ERROR("Flushing FDB failed. rv:%d", rv);
     }
 
-    if (SAI_STATUS_SUCCESS == rv) {
-        for (map<FdbEntry, FdbData>::iterator it = m_entries.begin();
-                it != m_entries.end(); it++)
-        {
-            if ((bridge_port_oid != SAI_NULL_OBJECT_ID &&
-                    it->second.bridge_port_id == bridge_port_oid) ||
-                    (vlan_oid != SAI_NULL_OBJECT_ID &&
-                    it->first.bv_id == vlan_oid))
-            {
-                it->second.is_flush_pending = true;
-            }
-        }
-    }
+    return rv;
 }
+
 void FdbOrch::flushFdbByVlan(const string &alias)
 {
     sai_status_t status;
@@ -1270,6 +1405,30 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         FdbData fdbData)
 {
+    FdbBulkContext ctx(true);
+    ctx.entry = entry;
+    ctx.port_name = port_name;
+    ctx.fdbData = fdbData;
+
+    if (addFdbEntry(ctx, false))
+    {
+        return true;
+    }
+
+    return addFdbEntryPost(ctx);
+}
+
+/*
+ * Validate a FDB entry and program it, or queue it into the FDB bulker when
+ * bulk is set. Returns true when the task is complete without any SAI
+ * operation. Otherwise the SAI statuses are collected in the context and
+ * addFdbEntryPost() completes the task, an empty status list means retry.
+ */
+bool FdbOrch::addFdbEntry(FdbBulkContext& ctx, bool bulk)
+{
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    FdbData& fdbData = ctx.fdbData;
     Port vlan;
     Port port;
     string end_point_ip = "";
@@ -1323,8 +1482,9 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     FdbOrigin oldOrigin = FDB_ORIGIN_INVALID ;
     bool macUpdate = false;
 
+    /* An entry pending removal in the bulker is created again */
     auto it = m_entries.find(entry);
-    if (it != m_entries.end())
+    if (it != m_entries.end() && !(bulk && gFdbBulker.bulk_entry_pending_removal(fdb_entry)))
     {
         /* get existing port and type */
         oldType = it->second.type;
@@ -1412,7 +1572,8 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     }
 
     sai_attribute_t attr;
-    vector<sai_attribute_t> attrs;
+    vector<sai_attribute_t>& attrs = ctx.attrs;
+    attrs.clear();
 
     attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
     if (fdbData.origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
@@ -1489,19 +1650,83 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     attr.id = SAI_FDB_ENTRY_ATTR_PACKET_ACTION;
     attr.value.s32 = (fdbData.discard == "true") ? SAI_PACKET_ACTION_DROP: SAI_PACKET_ACTION_FORWARD;
     attrs.push_back(attr);
+
+    ctx.macUpdate = macUpdate;
+    ctx.oldPortName = oldPort.m_alias;
+    ctx.oldType = oldType;
+    ctx.oldOrigin = oldOrigin;
+
     if (macUpdate)
     {
         SWSS_LOG_INFO("MAC-Update FDB %s in %s on from-%s:to-%s from-%s:to-%s origin-%d-to-%d",
                 entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
                 port_name.c_str(), oldType.c_str(), fdbData.type.c_str(),
                 oldOrigin, fdbData.origin);
-        for (auto itr : attrs)
+        for (const auto& itr : attrs)
         {
-            status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+            ctx.object_statuses.emplace_back();
+            if (bulk)
+            {
+                gFdbBulker.set_entry_attribute(&ctx.object_statuses.back(), &fdb_entry, &itr);
+            }
+            else
+            {
+                status = sai_fdb_api->set_fdb_entry_attribute(&fdb_entry, &itr);
+                ctx.object_statuses.back() = status;
+            }
+        }
+    }
+    else
+    {
+        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
+
+        ctx.object_statuses.emplace_back();
+        if (bulk)
+        {
+            gFdbBulker.create_entry(&ctx.object_statuses.back(), &fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        }
+        else
+        {
+            status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+            ctx.object_statuses.back() = status;
+        }
+    }
+
+    return false;
+}
+
+bool FdbOrch::addFdbEntryPost(const FdbBulkContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const string& port_name = ctx.port_name;
+    const FdbData& fdbData = ctx.fdbData;
+    const string& oldType = ctx.oldType;
+    const FdbOrigin oldOrigin = ctx.oldOrigin;
+    const bool macUpdate = ctx.macUpdate;
+    Port vlan;
+    Port port;
+    Port oldPort;
+
+    SWSS_LOG_ENTER();
+
+    const auto& object_statuses = ctx.object_statuses;
+
+    if (object_statuses.empty())
+    {
+        // Something went wrong before FDB bulker, will retry
+        return false;
+    }
+
+    if (macUpdate)
+    {
+        auto it_status = object_statuses.begin();
+        for (const auto& itr : ctx.attrs)
+        {
+            sai_status_t status = *it_status++;
             if (status != SAI_STATUS_SUCCESS)
             {
-                SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in %s on %s, rv:%d",
-                            itr.id, entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str(), status);
+                SWSS_LOG_ERROR("macUpdate-Failed for attr.id=0x%x for FDB %s in bv_id 0x%" PRIx64 " on %s, rv:%d",
+                            itr.id, entry.mac.to_string().c_str(), entry.bv_id, port_name.c_str(), status);
                 task_process_status handle_status = handleSaiSetStatus(SAI_API_FDB, status);
                 if (handle_status != task_success)
                 {
@@ -1509,30 +1734,65 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 }
             }
         }
-        if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
-        {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
-            port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
-        }
     }
     else
     {
-        SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
-
-        status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
+        sai_status_t status = object_statuses.front();
         if (status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to create %s FDB %s in %s on %s, rv:%d",
+            SWSS_LOG_ERROR("Failed to create %s FDB %s in bv_id 0x%" PRIx64 " on %s, rv:%d",
                     fdbData.type.c_str(), entry.mac.to_string().c_str(),
-                    vlan.m_alias.c_str(), port_name.c_str(), status);
+                    entry.bv_id, port_name.c_str(), status);
             task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, status); //FIXME: it should be based on status. Some could be retried, some not
             if (handle_status != task_success)
             {
                 return parseHandleSaiStatusFailure(handle_status);
             }
         }
+    }
+
+    if (!m_portsOrch->getPort(entry.bv_id, vlan) || !m_portsOrch->getPort(port_name, port))
+    {
+        /*
+         * The entry is in SAI already and must not be retried. Keep the
+         * entry and the CRM counter in sync, the counters and the state of
+         * the missing vlan or port cannot be updated.
+         */
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of programmed FDB %s",
+                entry.bv_id, port_name.c_str(), entry.mac.to_string().c_str());
+
+        FdbData storeFdbData = fdbData;
+        storeFdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+        for (const auto& attr : ctx.attrs)
+        {
+            if (attr.id == SAI_FDB_ENTRY_ATTR_BRIDGE_PORT_ID)
+            {
+                storeFdbData.bridge_port_id = attr.value.oid;
+            }
+        }
+        m_entries[entry] = storeFdbData;
+
+        if (!macUpdate)
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
+        }
+
+        return true;
+    }
+
+    if (macUpdate)
+    {
+        if (m_portsOrch->getPort(ctx.oldPortName, oldPort) &&
+            oldPort.m_bridge_port_id != port.m_bridge_port_id)
+        {
+            oldPort.m_fdb_count--;
+            m_portsOrch->setPort(oldPort.m_alias, oldPort);
+            port.m_fdb_count++;
+            m_portsOrch->setPort(port.m_alias, port);
+        }
+    }
+    else
+    {
         port.m_fdb_count++;
         m_portsOrch->setPort(port.m_alias, port);
         vlan.m_fdb_count++;
@@ -1547,7 +1807,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         //If the MAC is dynamic_local change the origin accordingly
         //MAC is added/updated as dynamic to allow aging.
         SWSS_LOG_INFO("MAC-Update Modify to dynamic FDB %s in %s on from-%s:to-%s from-%s:to-%s origin-%d-to-%d",
-                entry.mac.to_string().c_str(), vlan.m_alias.c_str(), oldPort.m_alias.c_str(),
+                entry.mac.to_string().c_str(), vlan.m_alias.c_str(), ctx.oldPortName.c_str(),
                 port_name.c_str(), oldType.c_str(), fdbData.type.c_str(), 
                 oldOrigin, fdbData.origin);
 
@@ -1623,6 +1883,26 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
 
 bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
 {
+    FdbBulkContext ctx(false);
+    ctx.entry = entry;
+    ctx.origin = origin;
+
+    if (removeFdbEntry(ctx, false))
+    {
+        return true;
+    }
+
+    return removeFdbEntryPost(ctx);
+}
+
+/*
+ * Remove a FDB entry, or queue the removal into the FDB bulker when bulk is
+ * set. Same return convention as addFdbEntry(FdbBulkContext&, bool).
+ */
+bool FdbOrch::removeFdbEntry(FdbBulkContext& ctx, bool bulk)
+{
+    const FdbEntry& entry = ctx.entry;
+    FdbOrigin origin = ctx.origin;
     Port vlan;
     Port port;
 
@@ -1683,15 +1963,45 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+    ctx.fdbData = fdbData;
+    ctx.port_name = port.m_alias;
 
-    sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
-    status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    ctx.object_statuses.emplace_back();
+    if (bulk)
+    {
+        gFdbBulker.remove_entry(&ctx.object_statuses.back(), &fdb_entry);
+    }
+    else
+    {
+        ctx.object_statuses.back() = sai_fdb_api->remove_fdb_entry(&fdb_entry);
+    }
+
+    return false;
+}
+
+bool FdbOrch::removeFdbEntryPost(const FdbBulkContext& ctx)
+{
+    const FdbEntry& entry = ctx.entry;
+    const FdbData& fdbData = ctx.fdbData;
+    Port vlan;
+    Port port;
+
+    SWSS_LOG_ENTER();
+
+    const auto& object_statuses = ctx.object_statuses;
+
+    if (object_statuses.empty())
+    {
+        // Something went wrong before FDB bulker, will retry
+        return false;
+    }
+
+    sai_status_t status = object_statuses.front();
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64,
@@ -1703,6 +2013,22 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
+    if (!m_portsOrch->getPort(entry.bv_id, vlan) || !m_portsOrch->getPort(ctx.port_name, port))
+    {
+        /*
+         * The entry is removed from SAI already and must not be retried.
+         * Keep the entry and the CRM counter in sync, the counters and the
+         * state of the missing vlan or port cannot be updated.
+         */
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of removed FDB %s",
+                entry.bv_id, ctx.port_name.c_str(), entry.mac.to_string().c_str());
+        (void)m_entries.erase(entry);
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_FDB_ENTRY);
+        return true;
+    }
+
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+
     SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
             entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
 
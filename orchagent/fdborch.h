@@ -1,9 +1,13 @@
 #ifndef SWSS_FDBORCH_H
 #define SWSS_FDBORCH_H
 
+#include <deque>
+#include <set>
+
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 enum FdbOrigin
 {
@@ -81,6 +85,32 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+struct FdbBulkContext
+{
+    std::deque<sai_status_t>            object_statuses;    // Bulk statuses
+    std::vector<sai_attribute_t>        attrs;              // Attributes of the create or set operation
+    FdbEntry                            entry;
+    std::string                         port_name;
+    FdbData                             fdbData;
+    FdbOrigin                           origin;             // Origin of the delete operation
+    bool                                is_set;             // True if set operation
+
+    /* Existing entry overwritten by the set operation */
+    bool                                macUpdate;
+    std::string                         oldPortName;
+    std::string                         oldType;
+    FdbOrigin                           oldOrigin;
+
+    FdbBulkContext(bool is_set)
+        : origin(FDB_ORIGIN_PROVISIONED), is_set(is_set), macUpdate(false), oldOrigin(FDB_ORIGIN_INVALID)
+    {
+    }
+
+    // Disable any copy constructors
+    FdbBulkContext(const FdbBulkContext&) = delete;
+    FdbBulkContext(FdbBulkContext&&) = delete;
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -113,6 +143,7 @@ private:
     vector<Table*> m_appTables;
     Table m_fdbStateTable;
     Table m_mclagFdbStateTable;
+    EntityBulker<sai_fdb_api_t> gFdbBulker;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
     shared_ptr<DBConnector> m_notificationsDb;
@@ -124,6 +155,13 @@ private:
     void updatePortOperState(const PortOperStateUpdate&);
 
     bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(FdbBulkContext& ctx, bool bulk);
+    bool addFdbEntryPost(const FdbBulkContext& ctx);
+    bool removeFdbEntry(FdbBulkContext& ctx, bool bulk);
+    bool removeFdbEntryPost(const FdbBulkContext& ctx);
+    void doFdbTaskPost(const FdbBulkContext& ctx, const Port& vlan);
+    void flushFdbRequests(NotificationConsumer& consumer);
+    sai_status_t issueFdbFlush(sai_object_id_t bridge_port_oid, sai_object_id_t vlan_oid);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
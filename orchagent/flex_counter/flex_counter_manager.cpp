@@ -1,5 +1,8 @@
 #include "flex_counter_manager.h"
 
+#include <algorithm>
+#include <map>
+#include <tuple>
 #include <vector>
 
 #include "schema.h"
@@ -10,7 +13,9 @@
 #include <macsecorch.h>
 
 using std::shared_ptr;
+using std::map;
 using std::string;
+using std::tuple;
 using std::unordered_map;
 using std::unordered_set;
 using std::vector;
@@ -21,6 +26,8 @@ using swss::ProducerTable;
 extern sai_switch_api_t *sai_switch_api;
 
 extern sai_object_id_t gSwitchId;
+extern bool gTraditionalFlexCounter;
+extern bool gFlexCounterBulkKeys;
 
 const string FLEX_COUNTER_ENABLE("enable");
 const string FLEX_COUNTER_DISABLE("disable");
@@ -126,7 +133,7 @@ FlexCounterManager::~FlexCounterManager()
 
     for (const auto& counter: installed_counters)
     {
-        stopFlexCounterPolling(counter.second, getFlexCounterTableKey(group_name, counter.first));
+        stopFlexCounterPolling(counter.second.switch_id, getFlexCounterTableKey(group_name, counter.first));
     }
 
     delFlexCounterGroup(group_name, is_gearbox);
@@ -212,12 +219,29 @@ void FlexCounterManager::setCounterIdList(
         return;
     }
 
-    auto key = getFlexCounterTableKey(group_name, object_id);
-    auto counter_ids = serializeCounterStats(counter_stats);
-    auto effective_switch_id = switch_id == SAI_NULL_OBJECT_ID ? gSwitchId : switch_id;
+    CounterIdList counter = {
+        switch_id == SAI_NULL_OBJECT_ID ? gSwitchId : switch_id,
+        counter_type_it->second,
+        serializeCounterStats(counter_stats)
+    };
+
+    auto installed_it = installed_counters.find(object_id);
+    if (installed_it != installed_counters.end() && installed_it->second == counter)
+    {
+        // Drop a queued change that would be undone
+        pending_counters.erase(object_id);
+        return;
+    }
 
-    startFlexCounterPolling(effective_switch_id, key, counter_ids, counter_type_it->second);
-    installed_counters[object_id] = effective_switch_id;
+    if (bulk_depth)
+    {
+        pending_counters[object_id] = counter;
+        return;
+    }
+
+    auto key = getFlexCounterTableKey(group_name, object_id);
+    startFlexCounterPolling(counter.switch_id, key, counter.counter_ids, counter.counter_field);
+    installed_counters[object_id] = counter;
 
     SWSS_LOG_DEBUG("Updated flex counter id list for object '%" PRIu64 "' in group '%s'.",
             object_id,
@@ -230,9 +254,16 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
 {
     SWSS_LOG_ENTER();
 
+    bool pending = pending_counters.erase(object_id) > 0;
+
     auto counter_it = installed_counters.find(object_id);
     if (counter_it == installed_counters.end())
     {
+        if (pending)
+        {
+            return;
+        }
+
         SWSS_LOG_WARN("No counters found on object '%" PRIu64 "' in group '%s'.",
                 object_id,
                 group_name.c_str());
@@ -240,7 +271,7 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
     }
 
     auto key = getFlexCounterTableKey(group_name, object_id);
-    stopFlexCounterPolling(installed_counters[object_id], key);
+    stopFlexCounterPolling(counter_it->second.switch_id, key);
     installed_counters.erase(counter_it);
 
     SWSS_LOG_DEBUG("Cleared flex counter id list for object '%" PRIu64 "' in group '%s'.",
@@ -248,6 +279,80 @@ void FlexCounterManager::clearCounterIdList(const sai_object_id_t object_id)
             group_name.c_str());
 }
 
+// startBulk queues the counter id lists set until the matching endBulk().
+// Bulk mode can be nested, they are installed by the outermost endBulk().
+void FlexCounterManager::startBulk()
+{
+    SWSS_LOG_ENTER();
+
+    bulk_depth++;
+}
+
+void FlexCounterManager::endBulk()
+{
+    SWSS_LOG_ENTER();
+
+    if (bulk_depth == 0)
+    {
+        SWSS_LOG_ERROR("Flex counter group '%s' is not in bulk mode.", group_name.c_str());
+        return;
+    }
+
+    if (--bulk_depth == 0)
+    {
+        flush();
+    }
+}
+
+// flush installs the queued counter id lists. The objects are grouped by
+// switch and counter id list, each group is sent as a list of keys,
+// "GROUP:oid1,oid2,...", when syncd accepts them (orchagent -x). Otherwise,
+// and in the traditional flex counter model whose FLEX_COUNTER_TABLE keys
+// name a single object, each object keeps its own key.
+void FlexCounterManager::flush()
+{
+    SWSS_LOG_ENTER();
+
+    if (pending_counters.empty())
+    {
+        return;
+    }
+
+    map<tuple<sai_object_id_t, string, string>, vector<sai_object_id_t>> updates;
+
+    for (const auto& it: pending_counters)
+    {
+        const auto& counter = it.second;
+        updates[std::make_tuple(counter.switch_id, counter.counter_field, counter.counter_ids)].push_back(it.first);
+    }
+
+    size_t chunk_size = gFlexCounterBulkKeys && !gTraditionalFlexCounter ? FLEX_COUNTER_BULK_CHUNK_SIZE : 1;
+
+    for (const auto& it: updates)
+    {
+        CounterIdList counter = { std::get<0>(it.first), std::get<1>(it.first), std::get<2>(it.first) };
+        const auto& object_ids = it.second;
+        for (size_t i = 0; i < object_ids.size(); i += chunk_size)
+        {
+            auto end = object_ids.begin() + static_cast<ptrdiff_t>(std::min(i + chunk_size, object_ids.size()));
+            startFlexCounterPolling(counter.switch_id,
+                    getFlexCounterTableKey(group_name, object_ids.begin() + static_cast<ptrdiff_t>(i), end),
+                    counter.counter_ids, counter.counter_field);
+        }
+
+        for (const auto& object_id: object_ids)
+        {
+            installed_counters[object_id] = counter;
+        }
+    }
+
+    SWSS_LOG_INFO("Installed %zu flex counter id lists in group '%s'.",
+            pending_counters.size(),
+            group_name.c_str());
+
+    pending_counters.clear();
+}
+
 string FlexCounterManager::getFlexCounterTableKey(
         const string& group_name,
         const sai_object_id_t object_id) const
@@ -257,6 +362,26 @@ string FlexCounterManager::getFlexCounterTableKey(
     return group_name + ":" + sai_serialize_object_id(object_id);
 }
 
+string FlexCounterManager::getFlexCounterTableKey(
+        const string& group_name,
+        vector<sai_object_id_t>::const_iterator begin,
+        vector<sai_object_id_t>::const_iterator end) const
+{
+    SWSS_LOG_ENTER();
+
+    string key = group_name + ":";
+    for (auto it = begin; it != end; ++it)
+    {
+        if (it != begin)
+        {
+            key.append(",");
+        }
+        key.append(sai_serialize_object_id(*it));
+    }
+
+    return key;
+}
+
 // serializeCounterStats turns a set of stats into a format suitable for FLEX_COUNTER_DB.
 string FlexCounterManager::serializeCounterStats(
         const unordered_set<string>& counter_stats) const
@@ -278,3 +403,20 @@ string FlexCounterManager::serializeCounterStats(
 
     return stats_string;
 }
+
+FlexCounterBulk::FlexCounterBulk(std::initializer_list<FlexCounterManager*> managers) :
+    managers(managers)
+{
+    for (auto manager: this->managers)
+    {
+        manager->startBulk();
+    }
+}
+
+FlexCounterBulk::~FlexCounterBulk()
+{
+    for (auto manager: managers)
+    {
+        manager->endBulk();
+    }
+}
@@ -5,6 +5,7 @@
 #include <unordered_set>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 #include "dbconnector.h"
 #include "producertable.h"
 #include "table.h"
@@ -35,8 +36,19 @@ enum class CounterType
     ENI
 };
 
+// Maximum number of objects installed or removed by one flex counter request
+#define FLEX_COUNTER_BULK_CHUNK_SIZE 1024
+
 // FlexCounterManager allows users to manage a group of flex counters.
 //
+// Between startBulk() and endBulk(), counter id lists that are set are only
+// queued. When multi-object keys are enabled (orchagent -x), endBulk()
+// installs the queued objects that share the same counter id list with one
+// request per FLEX_COUNTER_BULK_CHUNK_SIZE objects, instead of one request
+// per object. Counter id lists are still cleared right away, as the object
+// is usually removed next. Setting the counter id list an object already
+// polls is a no-op, in and out of bulk mode.
+//
 // TODO: FlexCounterManager doesn't currently support the full range of
 // flex counter features. In particular, support for standard (i.e. non-debug)
 // counters and support for plugins needs to be added.
@@ -76,6 +88,9 @@ class FlexCounterManager
                 const sai_object_id_t switch_id=SAI_NULL_OBJECT_ID);
         void clearCounterIdList(const sai_object_id_t object_id);
 
+        void startBulk();
+        void endBulk();
+
         const std::string& getGroupName() const
         {
             return group_name;
@@ -100,9 +115,29 @@ class FlexCounterManager
         void applyGroupConfiguration();
 
     private:
+        struct CounterIdList
+        {
+            sai_object_id_t switch_id;
+            std::string counter_field;
+            std::string counter_ids;
+
+            bool operator==(const CounterIdList& other) const
+            {
+                return switch_id == other.switch_id &&
+                       counter_field == other.counter_field &&
+                       counter_ids == other.counter_ids;
+            }
+        };
+
+        void flush();
+
         std::string getFlexCounterTableKey(
                 const std::string& group_name,
                 const sai_object_id_t object_id) const;
+        std::string getFlexCounterTableKey(
+                const std::string& group_name,
+                std::vector<sai_object_id_t>::const_iterator begin,
+                std::vector<sai_object_id_t>::const_iterator end) const;
         std::string serializeCounterStats(
                 const std::unordered_set<std::string>& counter_stats) const;
 
@@ -111,7 +146,9 @@ class FlexCounterManager
         uint polling_interval;
         bool enabled;
         swss::FieldValueTuple fv_plugin;
-        std::unordered_map<sai_object_id_t, sai_object_id_t> installed_counters;
+        std::unordered_map<sai_object_id_t, CounterIdList> installed_counters;
+        std::unordered_map<sai_object_id_t, CounterIdList> pending_counters;
+        uint bulk_depth = 0;
         bool is_gearbox;
 
         static const std::unordered_map<StatsMode, std::string> stats_mode_lookup;
@@ -119,6 +156,21 @@ class FlexCounterManager
         static const std::unordered_map<CounterType, std::string> counter_id_field_lookup;
 };
 
+// FlexCounterBulk keeps the given flex counter managers in bulk mode for
+// its lifetime.
+class FlexCounterBulk
+{
+    public:
+        FlexCounterBulk(std::initializer_list<FlexCounterManager*> managers);
+        ~FlexCounterBulk();
+
+        FlexCounterBulk(const FlexCounterBulk&) = delete;
+        FlexCounterBulk& operator=(const FlexCounterBulk&) = delete;
+
+    private:
+        std::vector<FlexCounterManager*> managers;
+};
+
 class FlexManagerDirectory
 {
     public:
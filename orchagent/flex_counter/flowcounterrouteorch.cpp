@@ -9,6 +9,7 @@
 #include "table.h"
 #include "vnetorch.h"
 
+#include <set>
 #include <string>
 
 extern Directory<Orch*>  gDirectory;
@@ -637,24 +638,26 @@ void FlowCounterRouteOrch::createRouteFlowCounterByPattern(const RoutePattern &r
     {
         SWSS_LOG_NOTICE("Creating route flow counter for pattern %s", route_pattern.to_string().c_str());
 
+        /* The route table is not ordered by prefix, sort the matches so that max_match_count picks the same routes */
+        std::set<IpPrefix> matches;
         for (auto &entry : iter->second)
+        {
+            if (route_pattern.is_match(route_pattern.vrf_id, entry.first) && !isRouteAlreadyBound(route_pattern, entry.first))
+            {
+                matches.insert(entry.first);
+            }
+        }
+
+        for (auto &ip_prefix : matches)
         {
             if (current_bound_count == route_pattern.max_match_count)
             {
                 return;
             }
 
-            if (route_pattern.is_match(route_pattern.vrf_id, entry.first))
+            if (bindFlowCounter(route_pattern, route_pattern.vrf_id, ip_prefix))
             {
-                if (isRouteAlreadyBound(route_pattern, entry.first))
-                {
-                    continue;
-                }
-
-                if (bindFlowCounter(route_pattern, route_pattern.vrf_id, entry.first))
-                {
-                    ++current_bound_count;
-                }
+                ++current_bound_count;
             }
         }
     }
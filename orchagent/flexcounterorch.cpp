@@ -15,6 +15,7 @@
 #include "macsecorch.h"
 #include "dash/dashorch.h"
 #include "flowcounterrouteorch.h"
+#include "ratecounters.h"
 
 extern sai_port_api_t *sai_port_api;
 extern sai_switch_api_t *sai_switch_api;
@@ -42,6 +43,10 @@ extern sai_object_id_t gSwitchId;
 #define FLOW_CNT_ROUTE_KEY          "FLOW_CNT_ROUTE"
 #define ENI_KEY                     "ENI"
 
+#define NATIVE_RATES_FIELD          "NATIVE_RATES"
+
+#define LAZY_BUFFER_COUNTERS_IDLE_TIME_SEC  600
+
 unordered_map<string, string> flexCounterGroupMap =
 {
     {"PORT", PORT_STAT_COUNTER_FLEX_COUNTER_GROUP},
@@ -66,15 +71,37 @@ unordered_map<string, string> flexCounterGroupMap =
     {"ENI", ENI_STAT_COUNTER_FLEX_COUNTER_GROUP}
 };
 
+struct NativeRatesGroup
+{
+    RateCounters::Type type;
+    string pluginField;
+};
+
+/* Flex counter groups whose rates Lua plugin can be replaced by RateCounters */
+static const unordered_map<string, NativeRatesGroup> nativeRatesGroupMap =
+{
+    {PORT_KEY, {RateCounters::Type::PORT, PORT_PLUGIN_FIELD}},
+    {RIF_KEY, {RateCounters::Type::RIF, RIF_PLUGIN_FIELD}},
+    {FLOW_CNT_TRAP_KEY, {RateCounters::Type::TRAP, FLOW_COUNTER_PLUGIN_FIELD}},
+    {TUNNEL_KEY, {RateCounters::Type::TUNNEL, TUNNEL_PLUGIN_FIELD}}
+};
+
 
 FlexCounterOrch::FlexCounterOrch(DBConnector *db, vector<string> &tableNames):
     Orch(db, tableNames),
     m_flexCounterConfigTable(db, CFG_FLEX_COUNTER_TABLE_NAME),
     m_bufferQueueConfigTable(db, CFG_BUFFER_QUEUE_TABLE_NAME),
     m_bufferPgConfigTable(db, CFG_BUFFER_PG_TABLE_NAME),
-    m_deviceMetadataConfigTable(db, CFG_DEVICE_METADATA_TABLE_NAME)
+    m_deviceMetadataConfigTable(db, CFG_DEVICE_METADATA_TABLE_NAME),
+    m_countersDb(new DBConnector("COUNTERS_DB", 0)),
+    m_applDb(new DBConnector("APPL_DB", 0)),
+    m_applPortTable(new Table(m_applDb.get(), APP_PORT_TABLE_NAME))
 {
     SWSS_LOG_ENTER();
+
+    m_ratesPollConsumer = new NotificationConsumer(m_countersDb.get(), RATES_POLL_CHANNEL);
+    auto ratesPollNotifier = new Notifier(m_ratesPollConsumer, this, RATES_POLL_CHANNEL);
+    Orch::addExecutor(ratesPollNotifier);
 }
 
 FlexCounterOrch::~FlexCounterOrch(void)
@@ -153,6 +180,8 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     // This postponement is introduced by design to accelerate the initialization process
                     if(gPortsOrch && (value == "enable"))
                     {
+                        initLazyBufferCounters();
+
                         if(key == PORT_KEY)
                         {
                             gPortsOrch->generatePortCounterMap();
@@ -245,6 +274,10 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                         }
                     }
                 }
+                else if (field == NATIVE_RATES_FIELD)
+                {
+                    setNativeRates(key, value);
+                }
                 else if(field == FLEX_COUNTER_DELAY_STATUS_FIELD)
                 {
                     // This field is ignored since it is being used before getting into this loop.
@@ -262,6 +295,59 @@ void FlexCounterOrch::doTask(Consumer &consumer)
     }
 }
 
+void FlexCounterOrch::doTask(NotificationConsumer &consumer)
+{
+    SWSS_LOG_ENTER();
+
+    if (&consumer != m_ratesPollConsumer)
+    {
+        return;
+    }
+
+    // Polls of a group that were notified while orchagent was busy are
+    // run as one, over the time of all of them and the objects of the
+    // last one, since the counters they were notified for are overwritten
+    std::deque<KeyOpFieldsValuesTuple> polls;
+    consumer.pops(polls);
+
+    map<string, pair<uint64_t, const KeyOpFieldsValuesTuple *>> groupPolls;
+    for (const auto &poll : polls)
+    {
+        uint32_t pollTime;
+        try
+        {
+            pollTime = to_uint<uint32_t>(kfvKey(poll));
+        }
+        catch (const std::exception &e)
+        {
+            SWSS_LOG_WARN("Invalid %s rates poll time %s, %s", kfvOp(poll).c_str(), kfvKey(poll).c_str(), e.what());
+            continue;
+        }
+
+        auto &groupPoll = groupPolls[kfvOp(poll)];
+        groupPoll.first += pollTime;
+        groupPoll.second = &poll;
+    }
+
+    vector<string> keys;
+    for (const auto &groupPoll : groupPolls)
+    {
+        auto rates = m_nativeRates.find(groupPoll.first);
+        if (rates == m_nativeRates.end())
+        {
+            continue;
+        }
+
+        keys.clear();
+        for (const auto &fv : kfvFieldsValues(*groupPoll.second.second))
+        {
+            keys.push_back(fvField(fv));
+        }
+
+        rates->second->poll(static_cast<uint32_t>(min<uint64_t>(groupPoll.second.first, UINT32_MAX)), keys);
+    }
+}
+
 bool FlexCounterOrch::getPortCountersState() const
 {
     return m_port_counter_enabled;
@@ -356,6 +442,162 @@ static bool isCreateOnlyConfigDbBuffers(Table& deviceMetadataConfigTable)
     return false;
 }
 
+/*
+ * DEVICE_METADATA|localhost lazy_buffer_counters enables the lazy queue and PG
+ * counters of PortsOrch, lazy_buffer_counters_idle_time is the time in seconds
+ * a port stays oper down before its counters are removed, 0 to keep them.
+ * Read once, before the first queue or PG counter map is generated.
+ */
+void FlexCounterOrch::initLazyBufferCounters()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_lazy_buffer_counters_initialized)
+    {
+        return;
+    }
+    m_lazy_buffer_counters_initialized = true;
+
+    string value;
+    bool enabled = false;
+    uint32_t idleTime = LAZY_BUFFER_COUNTERS_IDLE_TIME_SEC;
+
+    try
+    {
+        if (m_deviceMetadataConfigTable.hget("localhost", "lazy_buffer_counters", value))
+        {
+            enabled = value == "true";
+        }
+        if (m_deviceMetadataConfigTable.hget("localhost", "lazy_buffer_counters_idle_time", value))
+        {
+            idleTime = to_uint<uint32_t>(value);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        SWSS_LOG_ERROR("Invalid lazy buffer counters configuration: %s", e.what());
+    }
+
+    if (enabled)
+    {
+        gPortsOrch->setLazyBufferCounters(true, idleTime);
+    }
+}
+
+/*
+ * FLEX_COUNTER_TABLE|<group> NATIVE_RATES enables the rates of the PORT, RIF,
+ * FLOW_CNT_TRAP and TUNNEL groups to be computed by orchagent: the Lua plugin
+ * of the group is replaced by one that notifies orchagent of each poll. The
+ * rates are written to the same RATES fields, and the Lua plugin goes on
+ * from them when it is disabled.
+ */
+void FlexCounterOrch::setNativeRates(const string &key, const string &value)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = nativeRatesGroupMap.find(key);
+    if (it == nativeRatesGroupMap.end())
+    {
+        SWSS_LOG_NOTICE("Native rates are not supported for flex counter group %s", key.c_str());
+        return;
+    }
+
+    bool enable;
+    if (value == "enable")
+    {
+        enable = true;
+    }
+    else if (value == "disable")
+    {
+        enable = false;
+    }
+    else
+    {
+        SWSS_LOG_NOTICE("Unsupported NATIVE_RATES mode set input, please use enable or disable");
+        return;
+    }
+
+    const auto &group = flexCounterGroupMap[key];
+    if (enable == getNativeRatesState(group))
+    {
+        return;
+    }
+
+    auto rates = enable ? make_shared<RateCounters>(it->second.type, m_countersDb.get(), group) :
+                          m_nativeRates[group];
+    string plugin;
+    try
+    {
+        if (enable)
+        {
+            string notifyLuaScript = "local rates_group = '" + group + "'\n" +
+                swss::loadLuaScript(RATES_POLL_NOTIFY_PLUGIN);
+            plugin = swss::loadRedisScript(m_countersDb.get(), notifyLuaScript);
+        }
+        else
+        {
+            string ratesLuaScript = swss::loadLuaScript(rates->getLuaPlugin());
+            plugin = swss::loadRedisScript(m_countersDb.get(), ratesLuaScript);
+        }
+    }
+    catch (const runtime_error &e)
+    {
+        SWSS_LOG_ERROR("Native rates of flex counter group %s were not set: %s", key.c_str(), e.what());
+        return;
+    }
+
+    SWSS_LOG_NOTICE("Native rates of flex counter group %s %s", key.c_str(), value.c_str());
+
+    if (enable)
+    {
+        if (it->second.type == RateCounters::Type::PORT)
+        {
+            rates->setSerdesRateGetter([this](sai_object_id_t id) { return getPortSerdesRate(id); });
+        }
+        m_nativeRates[group] = rates;
+    }
+    else
+    {
+        m_nativeRates.erase(group);
+    }
+
+    setFlexCounterGroupParameter(group,
+                                 "", // Do not touch poll interval
+                                 "",
+                                 it->second.pluginField,
+                                 plugin);
+}
+
+/* Serdes rate of a port, of its lanes and speed in APPL_DB as port_rates.lua reads them */
+double FlexCounterOrch::getPortSerdesRate(sai_object_id_t id)
+{
+    SWSS_LOG_ENTER();
+
+    Port port;
+    if (!gPortsOrch || !gPortsOrch->getPort(id, port))
+    {
+        return 0;
+    }
+
+    string lanes, speed;
+    if (!m_applPortTable->hget(port.m_alias, "lanes", lanes) ||
+        !m_applPortTable->hget(port.m_alias, "speed", speed))
+    {
+        return 0;
+    }
+
+    try
+    {
+        uint32_t laneCount = static_cast<uint32_t>(count(lanes.begin(), lanes.end(), ',') + 1);
+        return RateCounters::getSerdesRate(laneCount, to_uint<uint32_t>(speed));
+    }
+    catch (const std::exception &e)
+    {
+        SWSS_LOG_WARN("Invalid speed %s of port %s, %s", speed.c_str(), port.m_alias.c_str(), e.what());
+        return 0;
+    }
+}
+
 map<string, FlexCounterQueueStates> FlexCounterOrch::getQueueConfigurations()
 {
     SWSS_LOG_ENTER();
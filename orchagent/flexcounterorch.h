@@ -5,11 +5,14 @@
 #include "port.h"
 #include "producertable.h"
 #include "table.h"
+#include "notificationconsumer.h"
 
 extern "C" {
 #include "sai.h"
 }
 
+class RateCounters;
+
 const std::string createAllAvailableBuffersStr = "create_all_available_buffers";
 
 class FlexCounterQueueStates
@@ -39,7 +42,9 @@ private:
 class FlexCounterOrch: public Orch
 {
 public:
+    using Orch::doTask;
     void doTask(Consumer &consumer);
+    void doTask(swss::NotificationConsumer &consumer);
     FlexCounterOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
     virtual ~FlexCounterOrch(void);
     bool getPortCountersState() const;
@@ -52,9 +57,15 @@ public:
     std::map<std::string, FlexCounterPgStates> getPgConfigurations();
     bool getHostIfTrapCounterState() const {return m_hostif_trap_counter_enabled;}
     bool getRouteFlowCountersState() const {return m_route_flow_counter_enabled;}
+    // The rates of the group are computed by orchagent instead of its Lua plugin
+    bool getNativeRatesState(const std::string &group) const {return m_nativeRates.count(group) != 0;}
     bool bake() override;
 
 private:
+    void initLazyBufferCounters();
+    void setNativeRates(const std::string &key, const std::string &value);
+    double getPortSerdesRate(sai_object_id_t id);
+
     bool m_port_counter_enabled = false;
     bool m_port_buffer_drop_counter_enabled = false;
     bool m_queue_enabled = false;
@@ -63,10 +74,16 @@ private:
     bool m_pg_watermark_enabled = false;
     bool m_hostif_trap_counter_enabled = false;
     bool m_route_flow_counter_enabled = false;
+    bool m_lazy_buffer_counters_initialized = false;
     Table m_flexCounterConfigTable;
     Table m_bufferQueueConfigTable;
     Table m_bufferPgConfigTable;
     Table m_deviceMetadataConfigTable;
+    std::shared_ptr<swss::DBConnector> m_countersDb;
+    std::shared_ptr<swss::DBConnector> m_applDb;
+    std::shared_ptr<Table> m_applPortTable;
+    swss::NotificationConsumer *m_ratesPollConsumer = nullptr;
+    std::map<std::string, std::shared_ptr<RateCounters>> m_nativeRates;
 };
 
 #endif
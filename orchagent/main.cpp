@@ -17,6 +17,7 @@ extern "C" {
 #include <stdexcept>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 
 #include <sys/time.h>
 #include <sairedis.h>
@@ -61,6 +62,8 @@ extern bool gIsNatSupported;
 #define SAIREDIS_RECORD_ENABLE 0x1
 #define SWSS_RECORD_ENABLE (0x1 << 1)
 #define RESPONSE_PUBLISHER_RECORD_ENABLE (0x1 << 2)
+/* Files kept by the size based rotation of the recordings */
+#define REC_MAX_FILES 10
 
 string gMySwitchType = "";
 int32_t gVoqMySwitchId = -1;
@@ -69,11 +72,13 @@ uint32_t gCfgSystemPorts = 0;
 string gMyHostName = "";
 string gMyAsicName = "";
 bool gTraditionalFlexCounter = false;
+bool gNhgInPlaceUpdate = false;
+bool gFlexCounterBulkKeys = false;
 uint32_t create_switch_timeout = 0;
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-q zmq_server_address] [-c mode] [-t create_switch_timeout] [-v VRF] [-w] [-l] [-u] [-e record_format] [-g record_max_size] [-x]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -95,6 +100,12 @@ void usage()
     cout << "    -c counter mode (traditional|asic_db), default: asic_db" << endl;
     cout << "    -t Override create switch timeout, in sec" << endl;
     cout << "    -v vrf: VRF name (default empty)" << endl;
+    cout << "    -w enable worker threads for orchs of independent execution groups (default disabled)" << endl;
+    cout << "    -l export orch scheduling latency statistics to STATE_DB (default disabled)" << endl;
+    cout << "    -u update the members of next hop groups used by a single route in place (default disabled)" << endl;
+    cout << "    -e record_format: format of swss.rec and responsepublisher.rec (text|binary|binary_zstd|binary_lz4), default: text" << endl;
+    cout << "    -g record_max_size: rotate swss.rec and responsepublisher.rec at this size in MB, keeping " << REC_MAX_FILES << " files (default 0, no rotation)" << endl;
+    cout << "    -x install the flex counters of objects sharing a counter id list with multi-object keys, needs syncd support (default disabled)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -349,8 +360,13 @@ int main(int argc, char **argv)
     bool   enable_zmq = false;
     string responsepublisher_rec_filename = Recorder::RESPPUB_FNAME;
     int record_type = 3; // Only swss and sairedis recordings enabled by default.
+    bool enable_worker_threads = false;
+    bool enable_sched_stats = false;
+    RecFormat record_format = RecFormat::TEXT;
+    RecCompression record_compression = RecCompression::NONE;
+    uint64_t record_max_size = 0;
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:q:c:t:v:")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:q:c:t:v:wlue:g:x")) != -1)
     {
         switch (opt)
         {
@@ -450,6 +466,55 @@ int main(int argc, char **argv)
                 vrf = optarg;
             }
             break;
+        case 'w':
+            enable_worker_threads = true;
+            SWSS_LOG_NOTICE("Enabling orch worker threads");
+            break;
+        case 'l':
+            enable_sched_stats = true;
+            break;
+        case 'u':
+            gNhgInPlaceUpdate = true;
+            SWSS_LOG_NOTICE("Enabling in-place next hop group update");
+            break;
+        case 'x':
+            gFlexCounterBulkKeys = true;
+            SWSS_LOG_NOTICE("Enabling multi-object flex counter keys");
+            break;
+        case 'e':
+            if (optarg == string("binary") || optarg == string("binary_zstd") || optarg == string("binary_lz4"))
+            {
+                record_format = RecFormat::BINARY;
+                if (optarg == string("binary_zstd"))
+                {
+                    record_compression = RecCompression::ZSTD;
+                }
+                else if (optarg == string("binary_lz4"))
+                {
+                    record_compression = RecCompression::LZ4;
+                }
+            }
+            else if (optarg != string("text"))
+            {
+                SWSS_LOG_ERROR("Invalid record format: %s", optarg);
+                exit(EXIT_FAILURE);
+            }
+            break;
+        case 'g':
+            {
+                /* A number of MB, strtoull() alone would take "-1" or "10abc" */
+                errno = 0;
+                unsigned long long size = strtoull(optarg, NULL, 10);
+                if (!*optarg || strspn(optarg, "0123456789") != strlen(optarg) || errno == ERANGE ||
+                    size > (UINT64_MAX >> 20))
+                {
+                    SWSS_LOG_ERROR("Invalid record max size: %s", optarg);
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                record_max_size = static_cast<uint64_t>(size) << 20;
+            }
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
@@ -475,6 +540,9 @@ int main(int argc, char **argv)
     );
     Recorder::Instance().swss.setLocation(record_location);
     Recorder::Instance().swss.setFileName(swss_rec_filename);
+    Recorder::Instance().swss.setFormat(record_format);
+    Recorder::Instance().swss.setCompression(record_compression);
+    Recorder::Instance().swss.setMaxFileSize(record_max_size, REC_MAX_FILES);
     Recorder::Instance().swss.startRec(true);
 
     Recorder::Instance().respub.setRecord(
@@ -483,6 +551,9 @@ int main(int argc, char **argv)
     );
     Recorder::Instance().respub.setLocation(record_location);
     Recorder::Instance().respub.setFileName(responsepublisher_rec_filename);
+    Recorder::Instance().respub.setFormat(record_format);
+    Recorder::Instance().respub.setCompression(record_compression);
+    Recorder::Instance().respub.setMaxFileSize(record_max_size, REC_MAX_FILES);
     Recorder::Instance().respub.startRec(false);
 
     // Instantiate database connectors
@@ -800,6 +871,9 @@ int main(int argc, char **argv)
         orchDaemon = make_shared<FabricOrchDaemon>(&appl_db, &config_db, &state_db, chassis_app_db.get(), zmq_server.get());
     }
 
+    orchDaemon->setWorkerThreadsEnabled(enable_worker_threads);
+    orchDaemon->setSchedStatsEnabled(enable_sched_stats);
+
     if (!orchDaemon->init())
     {
         SWSS_LOG_ERROR("Failed to initialize orchestration daemon");
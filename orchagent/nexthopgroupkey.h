@@ -1,8 +1,28 @@
 #ifndef SWSS_NEXTHOPGROUPKEY_H
 #define SWSS_NEXTHOPGROUPKEY_H
 
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include "nexthopkey.h"
 
+/*
+ * Set of next hops of a next hop group.
+ *
+ * The next hop sets are interned in a process wide table: all the keys built
+ * with the same next hops and weights point to one shared set, which carries
+ * a small integer ID and a precomputed hash. Copying a key does not copy the
+ * set, and equality is a pointer compare. Interned sets are never modified:
+ * add() and remove() build a new set and intern it, so the references
+ * returned by getNextHops() are only valid until the key is modified or
+ * destroyed. Interned sets are released with their last key, and their ID
+ * reused. The intern table is shared by all threads, a given key object must
+ * only be used by one thread.
+ *
+ * The string constructors remain the way to build a key.
+ */
 class NextHopGroupKey
 {
 public:
@@ -14,10 +34,12 @@ public:
         m_overlay_nexthops = false;
         m_srv6_nexthops = false;
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
+        std::set<NextHopKey> nhs;
         for (const auto &nh : nhv)
         {
-            m_nexthops.insert(nh);
+            nhs.insert(nh);
         }
+        assign(std::move(nhs));
     }
 
     /* ip_string|if_alias|vni|router_mac separated by ',' */
@@ -28,22 +50,26 @@ public:
             m_overlay_nexthops = true;
             m_srv6_nexthops = false;
             auto nhv = tokenize(nexthops, NHG_DELIMITER);
+            std::set<NextHopKey> nhs;
             for (const auto &nh_str : nhv)
             {
                 auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                nhs.insert(nh);
             }
+            assign(std::move(nhs));
         }
         else if (srv6_nh)
         {
             m_overlay_nexthops = false;
             m_srv6_nexthops = true;
             auto nhv = tokenize(nexthops, NHG_DELIMITER);
+            std::set<NextHopKey> nhs;
             for (const auto &nh_str : nhv)
             {
                 auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                nhs.insert(nh);
             }
+            assign(std::move(nhs));
         }
     }
 
@@ -54,34 +80,54 @@ public:
         std::vector<std::string> nhv = tokenize(nexthops, NHG_DELIMITER);
         std::vector<std::string> wtv = tokenize(weights, NHG_DELIMITER);
         bool set_weight = wtv.size() == nhv.size();
+        std::set<NextHopKey> nhs;
         for (uint32_t i = 0; i < nhv.size(); i++)
         {
             NextHopKey nh(nhv[i]);
             nh.weight = set_weight? (uint32_t)std::stoi(wtv[i]) : 0;
-            m_nexthops.insert(nh);
+            nhs.insert(nh);
         }
+        assign(std::move(nhs));
     }
 
     inline const std::set<NextHopKey> &getNextHops() const
     {
-        return m_nexthops;
+        return m_members ? m_members->nexthops : emptyNextHops();
     }
 
     inline size_t getSize() const
     {
-        return m_nexthops.size();
+        return m_members ? m_members->nexthops.size() : 0;
+    }
+
+    /* Handle of the next hop set, 0 for the empty set */
+    inline uint32_t getId() const
+    {
+        return m_members ? m_members->id : 0;
+    }
+
+    inline size_t getHash() const
+    {
+        return m_members ? m_members->hash : 0;
     }
 
     inline bool operator<(const NextHopGroupKey &o) const
     {
-        if (m_nexthops < o.m_nexthops)
+        if (m_members == o.m_members)
+        {
+            return false;
+        }
+
+        const auto &nhs = getNextHops();
+        const auto &o_nhs = o.getNextHops();
+        if (nhs < o_nhs)
         {
             return true;
         }
-        else if (m_nexthops == o.m_nexthops)
+        else if (nhs == o_nhs)
         {
-            auto it1 = m_nexthops.begin();
-            for (auto& it2 : o.m_nexthops)
+            auto it1 = nhs.begin();
+            for (auto& it2 : o_nhs)
             {
                 if (it1->weight < it2.weight)
                 {
@@ -99,20 +145,7 @@ public:
 
     inline bool operator==(const NextHopGroupKey &o) const
     {
-        if (m_nexthops != o.m_nexthops)
-        {
-            return false;
-        }
-        auto it1 = m_nexthops.begin();
-        for (auto& it2 : o.m_nexthops)
-        {
-            if (it2.weight != it1->weight)
-            {
-                return false;
-            }
-            it1++;
-        }
-        return true;
+        return m_members == o.m_members;
     }
 
     inline bool operator!=(const NextHopGroupKey &o) const
@@ -122,33 +155,38 @@ public:
 
     void add(const std::string &ip, const std::string &alias)
     {
-        m_nexthops.emplace(ip, alias);
+        add(NextHopKey(ip, alias));
     }
 
     void add(const std::string &nh)
     {
-        m_nexthops.insert(nh);
+        add(NextHopKey(nh));
     }
 
     void add(const NextHopKey &nh)
     {
-        m_nexthops.insert(nh);
+        if (!contains(nh))
+        {
+            std::set<NextHopKey> nhs = getNextHops();
+            nhs.insert(nh);
+            assign(std::move(nhs));
+        }
     }
 
     bool contains(const std::string &ip, const std::string &alias) const
     {
         NextHopKey nh(ip, alias);
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return getNextHops().find(nh) != getNextHops().end();
     }
 
     bool contains(const std::string &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return getNextHops().find(nh) != getNextHops().end();
     }
 
     bool contains(const NextHopKey &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return getNextHops().find(nh) != getNextHops().end();
     }
 
     bool contains(const NextHopGroupKey &nhs) const
@@ -165,7 +203,7 @@ public:
 
     bool hasIntfNextHop() const
     {
-        for (const auto &nh : m_nexthops)
+        for (const auto &nh : getNextHops())
         {
             if (nh.isIntfNextHop())
             {
@@ -177,27 +215,33 @@ public:
 
     void remove(const std::string &ip, const std::string &alias)
     {
-        NextHopKey nh(ip, alias);
-        m_nexthops.erase(nh);
+        remove(NextHopKey(ip, alias));
     }
 
     void remove(const std::string &nh)
     {
-        m_nexthops.erase(nh);
+        remove(NextHopKey(nh));
     }
 
     void remove(const NextHopKey &nh)
     {
-        m_nexthops.erase(nh);
+        if (contains(nh))
+        {
+            /* nh may be an element of the current set, erase it before the set is released */
+            std::set<NextHopKey> nhs = getNextHops();
+            nhs.erase(nh);
+            assign(std::move(nhs));
+        }
     }
 
     const std::string to_string() const
     {
         string nhs_str;
+        const auto &nhs = getNextHops();
 
-        for (auto it = m_nexthops.begin(); it != m_nexthops.end(); ++it)
+        for (auto it = nhs.begin(); it != nhs.end(); ++it)
         {
-            if (it != m_nexthops.begin())
+            if (it != nhs.begin())
             {
                 nhs_str += NHG_DELIMITER;
             }
@@ -223,13 +267,164 @@ public:
 
     void clear()
     {
-        m_nexthops.clear();
+        m_members.reset();
     }
 
 private:
-    std::set<NextHopKey> m_nexthops;
-    bool m_overlay_nexthops;
-    bool m_srv6_nexthops;
+    struct Members
+    {
+        Members(std::set<NextHopKey> &&nhs) : nexthops(std::move(nhs)) {}
+        ~Members();
+
+        const std::set<NextHopKey> nexthops;
+        size_t hash = 0;
+        uint32_t id = 0;
+    };
+
+    struct InternTable
+    {
+        struct Entry
+        {
+            const Members *members;
+            std::weak_ptr<Members> ref;
+        };
+
+        std::mutex mutex;
+        std::unordered_multimap<size_t, Entry> sets;
+        std::vector<uint32_t> freeIds;
+        uint32_t nextId = 1;
+    };
+
+    /* Never destroyed, keys may outlive the static objects at exit */
+    static InternTable &getInternTable()
+    {
+        static InternTable *table = new InternTable();
+        return *table;
+    }
+
+    static const std::set<NextHopKey> &emptyNextHops()
+    {
+        static const std::set<NextHopKey> nhs;
+        return nhs;
+    }
+
+    static bool sameNextHops(const std::set<NextHopKey> &a, const std::set<NextHopKey> &b)
+    {
+        if (a != b)
+        {
+            return false;
+        }
+        auto it1 = a.begin();
+        for (auto &it2 : b)
+        {
+            if (it1->weight != it2.weight)
+            {
+                return false;
+            }
+            it1++;
+        }
+        return true;
+    }
+
+    static std::shared_ptr<Members> intern(std::set<NextHopKey> &&nhs)
+    {
+        size_t hash = 0;
+        for (const auto &nh : nhs)
+        {
+            boost::hash_combine(hash, std::hash<NextHopKey>()(nh));
+            boost::hash_combine(hash, nh.weight);
+        }
+
+        auto &table = getInternTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+
+        /*
+         * The sets are compared through the raw pointers, only the match is
+         * locked: a set whose last key is dropped meanwhile would otherwise be
+         * destroyed here, and release() it under the table lock. Its next hops
+         * stay valid until release() returns, which waits for the lock.
+         */
+        auto range = table.sets.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (sameNextHops(it->second.members->nexthops, nhs))
+            {
+                auto existing = it->second.ref.lock();
+                if (existing)
+                {
+                    return existing;
+                }
+            }
+        }
+
+        auto members = std::make_shared<Members>(std::move(nhs));
+        if (table.freeIds.empty())
+        {
+            members->id = table.nextId++;
+        }
+        else
+        {
+            members->id = table.freeIds.back();
+            table.freeIds.pop_back();
+        }
+        members->hash = hash;
+        table.sets.emplace(hash, InternTable::Entry{ members.get(), members });
+        return members;
+    }
+
+    static void release(const Members *members)
+    {
+        auto &table = getInternTable();
+        std::lock_guard<std::mutex> lock(table.mutex);
+
+        auto range = table.sets.equal_range(members->hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second.members == members)
+            {
+                table.sets.erase(it);
+                break;
+            }
+        }
+        table.freeIds.push_back(members->id);
+    }
+
+    /* Make the key point to the interned set, the empty set is a null pointer */
+    void assign(std::set<NextHopKey> &&nhs)
+    {
+        if (nhs.empty())
+        {
+            m_members.reset();
+        }
+        else
+        {
+            m_members = intern(std::move(nhs));
+        }
+    }
+
+    std::shared_ptr<const Members> m_members;
+    bool m_overlay_nexthops = false;
+    bool m_srv6_nexthops = false;
 };
 
+inline NextHopGroupKey::Members::~Members()
+{
+    if (id != 0)
+    {
+        NextHopGroupKey::release(this);
+    }
+}
+
+namespace std
+{
+    template <>
+    struct hash<NextHopGroupKey>
+    {
+        size_t operator()(const NextHopGroupKey &key) const
+        {
+            return key.getHash();
+        }
+    };
+}
+
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
@@ -1,6 +1,8 @@
 #ifndef SWSS_NEXTHOPKEY_H
 #define SWSS_NEXTHOPKEY_H
 
+#include <boost/functional/hash.hpp>
+
 #include "ipaddress.h"
 #include "tokenize.h"
 #include "label.h"
@@ -199,4 +201,34 @@ struct NextHopKey
     }
 };
 
+namespace std
+{
+    /* Hash of the fields compared by NextHopKey::operator== */
+    template <>
+    struct hash<NextHopKey>
+    {
+        size_t operator()(const NextHopKey &nh) const
+        {
+            size_t seed = 0;
+            ip_addr_t ip = nh.ip_address.getIp();
+            boost::hash_combine(seed, ip.family);
+            if (ip.family == AF_INET)
+            {
+                boost::hash_combine(seed, ip.ip_addr.ipv4);
+            }
+            else
+            {
+                boost::hash_range(seed, ip.ip_addr.ipv6, ip.ip_addr.ipv6 + sizeof(ip.ip_addr.ipv6));
+            }
+            boost::hash_combine(seed, nh.alias);
+            boost::hash_combine(seed, nh.vni);
+            boost::hash_range(seed, nh.mac_address.getMac(), nh.mac_address.getMac() + sizeof(sai_mac_t));
+            boost::hash_combine(seed, nh.label_stack.m_labelstack);
+            boost::hash_combine(seed, nh.srv6_segment);
+            boost::hash_combine(seed, nh.srv6_source);
+            return seed;
+        }
+    };
+}
+
 #endif /* SWSS_NEXTHOPKEY_H */
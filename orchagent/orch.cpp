@@ -85,13 +85,14 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry)
     Recorder::Instance().swss.record(dumpTuple(entry));
 
     /*
-    * m_toSync is a multimap which will allow one key with multiple values,
+    * m_toSync is a SyncMap which will allow one key with multiple values,
     * Also, the order of the key-value pairs whose keys compare equivalent
-    * is the order of insertion and does not change. (since C++11)
+    * is the order of insertion and does not change.
     */
+    auto ret = m_toSync.equal_range(key);
 
     /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    if (ret.first == ret.second)
     {
         m_toSync.emplace(key, entry);
     }
@@ -115,7 +116,6 @@ void ConsumerBase::addToSync(const KeyOpFieldsValuesTuple &entry)
         * in such case, we insert the key-value with SET.
         * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
         */
-        auto ret = m_toSync.equal_range(key);
         auto iter = ret.first;
         for (; iter != ret.second; ++iter)
         {
@@ -24,6 +24,7 @@ extern "C" {
 #include "macaddress.h"
 #include "response_publisher.h"
 #include "recorder.h"
+#include "syncmap.h"
 
 const char delimiter           = ':';
 const char list_item_delimiter = ',';
@@ -79,11 +80,6 @@ typedef std::map<std::string, std::shared_ptr<object_reference_map>> type_map;
 typedef std::map<std::string, sai_object_id_t> object_map;
 typedef std::pair<std::string, sai_object_id_t> object_map_pair;
 
-// Use multimap to support multiple OpFieldsValues for the same key (e,g, DEL and SET)
-// The order of the key-value pairs whose keys compare equivalent is the order of
-// insertion and does not change. (since C++11)
-typedef std::multimap<std::string, swss::KeyOpFieldsValuesTuple> SyncMap;
-
 typedef std::pair<std::string, int> table_name_with_pri_t;
 
 class Orch;
@@ -156,6 +152,12 @@ public:
     // TODO: hide?
     SyncMap m_toSync;
 
+    /* Select how pending tasks are indexed and ordered, see SyncMapIndex */
+    void setPendingTaskIndex(SyncMapIndex index)
+    {
+        m_toSync.setIndex(index);
+    }
+
     /* record the tuple */
     void recordTuple(const swss::KeyOpFieldsValuesTuple &tuple);
 
@@ -251,6 +253,38 @@ public:
      * @brief Flush pending responses
      */
     void flushResponses();
+
+    /**
+     * @brief Set the execution group of the orch
+     *
+     * Orchs with a non-empty execution group are run by a dedicated worker
+     * thread of that group when orchagent worker threads are enabled. Orchs
+     * without a group are run by the main thread.
+     */
+    void setExecutionGroup(const std::string &group)
+    {
+        m_executionGroup = group;
+    }
+
+    const std::string &getExecutionGroup() const
+    {
+        return m_executionGroup;
+    }
+
+    /**
+     * @brief Declare that the orch shares mutable state with another orch
+     *
+     * Dependent orchs are always run by the same thread.
+     */
+    void addDependency(Orch *orch)
+    {
+        m_dependencies.insert(orch);
+    }
+
+    const std::set<Orch *> &getDependencies() const
+    {
+        return m_dependencies;
+    }
 protected:
     ConsumerMap m_consumerMap;
 
@@ -275,6 +309,9 @@ protected:
 
     ResponsePublisher m_publisher{"APPL_STATE_DB"};
 private:
+    std::string m_executionGroup;
+    std::set<Orch *> m_dependencies;
+
     void addConsumer(swss::DBConnector *db, std::string tableName, int pri = default_orch_pri);
 };
 
@@ -99,6 +99,8 @@ OrchDaemon::~OrchDaemon()
      * orchagents management is in order.
      * For now it fixes, possible crash during process exit.
      */
+    stopWorkers();
+
     auto it = m_orchList.rbegin();
     for(; it != m_orchList.rend(); ++it) {
         delete(*it);
@@ -233,6 +235,9 @@ bool OrchDaemon::init()
         { APP_LABEL_ROUTE_TABLE_NAME,  routeorch_pri }
     };
     gRouteOrch = new RouteOrch(m_applDb, route_tables, gSwitchOrch, gNeighOrch, gIntfsOrch, vrf_orch, gFgNhgOrch, gSrv6Orch);
+    gRouteOrch->addDependency(gNeighOrch);
+    gRouteOrch->addDependency(gIntfsOrch);
+    gNeighOrch->addDependency(gIntfsOrch);
     gNhgOrch = new NhgOrch(m_applDb, APP_NEXTHOP_GROUP_TABLE_NAME);
     gCbfNhgOrch = new CbfNhgOrch(m_applDb, APP_CLASS_BASED_NEXT_HOP_GROUP_TABLE_NAME);
 
@@ -261,11 +266,14 @@ bool OrchDaemon::init()
     NvgreTunnelMapOrch *nvgre_tunnel_map_orch = new NvgreTunnelMapOrch(m_configDb, CFG_NVGRE_TUNNEL_MAP_TABLE_NAME);
     gDirectory.set(nvgre_tunnel_map_orch);
 
+    /* DASH orchs only share state among themselves and may be run by a worker thread */
+    DBConnector *dash_db = getExecutionGroupDb(m_applDb);
+
 	vector<string> dash_vnet_tables = {
         APP_DASH_VNET_TABLE_NAME,
         APP_DASH_VNET_MAPPING_TABLE_NAME
     };
-    DashVnetOrch *dash_vnet_orch = new DashVnetOrch(m_applDb, dash_vnet_tables, m_zmqServer);
+    DashVnetOrch *dash_vnet_orch = new DashVnetOrch(dash_db, dash_vnet_tables, m_zmqServer);
     gDirectory.set(dash_vnet_orch);
 
     vector<string> dash_tables = {
@@ -276,7 +284,7 @@ bool OrchDaemon::init()
         APP_DASH_QOS_TABLE_NAME
     };
 
-    DashOrch *dash_orch = new DashOrch(m_applDb, dash_tables, m_zmqServer);
+    DashOrch *dash_orch = new DashOrch(dash_db, dash_tables, m_zmqServer);
     gDirectory.set(dash_orch);
 
     vector<string> dash_route_tables = {
@@ -285,7 +293,7 @@ bool OrchDaemon::init()
         APP_DASH_ROUTE_GROUP_TABLE_NAME
     };
 
-    DashRouteOrch *dash_route_orch = new DashRouteOrch(m_applDb, dash_route_tables, dash_orch, m_zmqServer);
+    DashRouteOrch *dash_route_orch = new DashRouteOrch(dash_db, dash_route_tables, dash_orch, m_zmqServer);
     gDirectory.set(dash_route_orch);
 
     vector<string> dash_acl_tables = {
@@ -295,9 +303,17 @@ bool OrchDaemon::init()
         APP_DASH_ACL_GROUP_TABLE_NAME,
         APP_DASH_ACL_RULE_TABLE_NAME
     };
-    DashAclOrch *dash_acl_orch = new DashAclOrch(m_applDb, dash_acl_tables, dash_orch, m_zmqServer);
+    DashAclOrch *dash_acl_orch = new DashAclOrch(dash_db, dash_acl_tables, dash_orch, m_zmqServer);
     gDirectory.set(dash_acl_orch);
 
+    for (Orch *o : std::vector<Orch *>{ dash_vnet_orch, dash_orch, dash_route_orch, dash_acl_orch })
+    {
+        o->setExecutionGroup("dash");
+    }
+    dash_vnet_orch->addDependency(dash_orch);
+    dash_route_orch->addDependency(dash_orch);
+    dash_acl_orch->addDependency(dash_orch);
+
     vector<string> qos_tables = {
         CFG_TC_TO_QUEUE_MAP_TABLE_NAME,
         CFG_SCHEDULER_TABLE_NAME,
@@ -807,10 +823,137 @@ void OrchDaemon::flush()
         handleSaiFailure(true);
     }
 
-    for (auto* orch: m_orchList)
+    for (auto* orch: getMainOrchList())
     {
         orch->flushResponses();
     }
+
+    m_schedStats.publish();
+}
+
+/*
+ * Return a DB connector for orchs that may be run by a worker thread.
+ * A dedicated connection is needed since redis contexts are not thread safe.
+ */
+DBConnector *OrchDaemon::getExecutionGroupDb(DBConnector *db)
+{
+    if (!m_workerThreadsEnabled)
+    {
+        return db;
+    }
+
+    m_workerDbs.emplace_back(db->newConnector(0));
+    return m_workerDbs.back().get();
+}
+
+const std::vector<Orch *> &OrchDaemon::getMainOrchList() const
+{
+    return m_mainOrchList.empty() ? m_orchList : m_mainOrchList;
+}
+
+/*
+ * Assign every orch to a thread according to its execution group. Orchs
+ * depending on each other are always assigned to the same thread. When
+ * dependent orchs declare different execution groups, they all stay on the
+ * main thread.
+ */
+void OrchDaemon::assignWorkers()
+{
+    SWSS_LOG_ENTER();
+
+    m_schedStats.setEnabled(m_schedStatsEnabled);
+
+    if (!m_workerThreadsEnabled)
+    {
+        m_mainOrchList = m_orchList;
+        return;
+    }
+
+    /* Union-find over the declared dependencies */
+    unordered_map<Orch *, Orch *> parent;
+    auto findRoot = [&parent](Orch *o) {
+        auto root = o;
+        while (parent.count(root) && parent[root] != root)
+        {
+            root = parent[root];
+        }
+        while (o != root)
+        {
+            auto next = parent[o];
+            parent[o] = root;
+            o = next;
+        }
+        return root;
+    };
+
+    for (Orch *o : m_orchList)
+    {
+        for (Orch *dep : o->getDependencies())
+        {
+            auto a = findRoot(o);
+            auto b = findRoot(dep);
+            parent[a] = a;
+            parent[b] = a;
+        }
+    }
+
+    unordered_map<Orch *, string> rootGroups;
+    for (Orch *o : m_orchList)
+    {
+        const auto &group = o->getExecutionGroup();
+        if (group.empty())
+        {
+            continue;
+        }
+
+        auto rc = rootGroups.emplace(findRoot(o), group);
+        if (!rc.second && !rc.first->second.empty() && rc.first->second != group)
+        {
+            SWSS_LOG_WARN("Dependent orchs declare execution groups %s and %s, running them on the main thread",
+                          rc.first->second.c_str(), group.c_str());
+            rc.first->second.clear();
+        }
+    }
+
+    map<string, OrchWorker *> workers;
+    for (Orch *o : m_orchList)
+    {
+        auto it = rootGroups.find(findRoot(o));
+        if (it == rootGroups.end() || it->second.empty())
+        {
+            m_mainOrchList.push_back(o);
+            continue;
+        }
+
+        auto &worker = workers[it->second];
+        if (worker == nullptr)
+        {
+            m_workers.emplace_back(new OrchWorker(it->second));
+            worker = m_workers.back().get();
+            worker->getSchedStats().setEnabled(m_schedStatsEnabled);
+        }
+        worker->addOrch(o);
+    }
+}
+
+void OrchDaemon::startWorkers()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &worker : m_workers)
+    {
+        worker->start();
+    }
+}
+
+void OrchDaemon::stopWorkers()
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &worker : m_workers)
+    {
+        worker->stop();
+    }
 }
 
 /* Release the file handle so the log can be rotated */
@@ -833,7 +976,10 @@ void OrchDaemon::start()
 
     Recorder::Instance().sairedis.setRotate(false);
 
-    for (Orch *o : m_orchList)
+    assignWorkers();
+    startWorkers();
+
+    for (Orch *o : getMainOrchList())
     {
         m_select->addSelectables(o->getSelectables());
     }
@@ -885,13 +1031,17 @@ void OrchDaemon::start()
         }
 
         auto *c = (Executor *)s;
+        auto texec = std::chrono::high_resolution_clock::now();
         c->execute();
+        m_schedStats.record(c->getName(),
+                            std::chrono::duration_cast<std::chrono::microseconds>(texec - tend).count(),
+                            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - texec).count());
 
         /* After each iteration, periodically check all m_toSync map to
          * execute all the remaining tasks that need to be retried. */
 
         /* TODO: Abstract Orch class to have a specific todo list */
-        for (Orch *o : m_orchList)
+        for (Orch *o : getMainOrchList())
             o->doTask();
 
         /*
@@ -901,7 +1051,18 @@ void OrchDaemon::start()
          */
         if (gSwitchOrch && gSwitchOrch->checkRestartReady())
         {
+            /*
+             * Stop the worker threads first, so that the pending tasks
+             * inspected by the check are not changed by a worker before
+             * orchagent freezes.
+             */
+            stopWorkers();
+
             bool ret = warmRestartCheck();
+            if (!ret || gSwitchOrch->checkRestartNoFreeze())
+            {
+                startWorkers();
+            }
             if (ret)
             {
                 // Orchagent is ready to perform warm restart, stop processing any new db data.
@@ -1016,10 +1177,19 @@ bool OrchDaemon::warmRestoreAndSyncUp()
  */
 void OrchDaemon::getTaskToSync(vector<string> &ts)
 {
-    for (Orch *o : m_orchList)
+    for (Orch *o : getMainOrchList())
     {
         o->dumpPendingTasks(ts);
     }
+
+    for (auto &worker : m_workers)
+    {
+        auto lock = worker->pause();
+        for (Orch *o : worker->getOrchs())
+        {
+            o->dumpPendingTasks(ts);
+        }
+    }
 }
 
 
@@ -52,6 +52,7 @@
 #include "dash/dashorch.h"
 #include "dash/dashrouteorch.h"
 #include "dash/dashvnetorch.h"
+#include "orchworker.h"
 #include <sairedis.h>
 
 using namespace swss;
@@ -83,6 +84,15 @@ public:
     {
         m_fabricQueueStatEnabled = enabled;
     }
+    /* Run orchs of non-default execution groups in their own threads, must be set before init() */
+    void setWorkerThreadsEnabled(bool enabled)
+    {
+        m_workerThreadsEnabled = enabled;
+    }
+    void setSchedStatsEnabled(bool enabled)
+    {
+        m_schedStatsEnabled = enabled;
+    }
     void logRotate();
 private:
     DBConnector *m_applDb;
@@ -95,13 +105,28 @@ private:
     bool m_fabricPortStatEnabled = true;
     bool m_fabricQueueStatEnabled = true;
 
+    bool m_workerThreadsEnabled = false;
+    bool m_schedStatsEnabled = false;
+
     std::vector<Orch *> m_orchList;
     Select *m_select;
+
+    /* Orchs run by the main thread, and worker threads running the other execution groups */
+    std::vector<Orch *> m_mainOrchList;
+    std::vector<std::unique_ptr<OrchWorker>> m_workers;
+    std::vector<std::unique_ptr<DBConnector>> m_workerDbs;
+    OrchSchedStats m_schedStats{"main"};
     
     std::chrono::time_point<std::chrono::high_resolution_clock> m_lastHeartBeat;
 
     void flush();
 
+    DBConnector *getExecutionGroupDb(DBConnector *db);
+    void assignWorkers();
+    void startWorkers();
+    void stopWorkers();
+    const std::vector<Orch *> &getMainOrchList() const;
+
     void heartBeat(std::chrono::time_point<std::chrono::high_resolution_clock> tcurrent);
 
     void freezeAndHeartBeat(unsigned int duration);
@@ -0,0 +1,197 @@
+#include <inttypes.h>
+
+#include "orchworker.h"
+#include "logger.h"
+#include "saihelper.h"
+#include "sairedis.h"
+
+using namespace std;
+using namespace swss;
+
+#define WORKER_SELECT_TIMEOUT 1000
+
+extern sai_switch_api_t *sai_switch_api;
+extern sai_object_id_t gSwitchId;
+
+OrchSchedStats::OrchSchedStats(const string &threadName) :
+        m_threadName(threadName)
+{
+}
+
+void OrchSchedStats::record(const string &executor, uint64_t waitUs, uint64_t execUs)
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    auto &entry = m_entries[executor];
+    entry.count++;
+    entry.totalWaitUs += waitUs;
+    entry.maxWaitUs = max(entry.maxWaitUs, waitUs);
+    entry.totalExecUs += execUs;
+    entry.maxExecUs = max(entry.maxExecUs, execUs);
+    entry.dirty = true;
+}
+
+void OrchSchedStats::publish()
+{
+    if (!m_enabled)
+    {
+        return;
+    }
+
+    if (!m_statsTable)
+    {
+        m_stateDb = make_unique<DBConnector>("STATE_DB", 0);
+        m_statsTable = make_unique<Table>(m_stateDb.get(), ORCH_SCHED_STATS_TABLE);
+    }
+
+    for (auto &it : m_entries)
+    {
+        auto &entry = it.second;
+        if (!entry.dirty)
+        {
+            continue;
+        }
+
+        vector<FieldValueTuple> fvs = {
+            {"count", to_string(entry.count)},
+            {"avg_wait_us", to_string(entry.totalWaitUs / entry.count)},
+            {"max_wait_us", to_string(entry.maxWaitUs)},
+            {"avg_exec_us", to_string(entry.totalExecUs / entry.count)},
+            {"max_exec_us", to_string(entry.maxExecUs)}
+        };
+        m_statsTable->set(m_threadName + state_db_key_delimiter + it.first, fvs);
+        entry.dirty = false;
+    }
+}
+
+OrchWorker::OrchWorker(const string &group) :
+        m_group(group),
+        m_running(false),
+        m_stats(group)
+{
+    m_select.addSelectable(&m_stopEvent);
+}
+
+OrchWorker::~OrchWorker()
+{
+    stop();
+}
+
+void OrchWorker::addOrch(Orch *orch)
+{
+    m_orchList.push_back(orch);
+    m_select.addSelectables(orch->getSelectables());
+}
+
+void OrchWorker::start()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_running)
+    {
+        return;
+    }
+
+    m_running = true;
+    m_thread = make_unique<thread>(&OrchWorker::run, this);
+
+    SWSS_LOG_NOTICE("Started orch worker %s with %zu orchs", m_group.c_str(), m_orchList.size());
+}
+
+void OrchWorker::stop()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_running)
+    {
+        return;
+    }
+
+    m_running = false;
+    m_stopEvent.notify();
+    m_thread->join();
+    m_thread.reset();
+
+    SWSS_LOG_NOTICE("Stopped orch worker %s", m_group.c_str());
+}
+
+/* Flush the sairedis pipeline and the responses of the worker orchs */
+void OrchWorker::flush()
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t attr;
+    attr.id = SAI_REDIS_SWITCH_ATTR_FLUSH;
+    sai_status_t status = sai_switch_api->set_switch_attribute(gSwitchId, &attr);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to flush redis pipeline %d", status);
+        handleSaiFailure(true);
+    }
+
+    for (auto *orch : m_orchList)
+    {
+        orch->flushResponses();
+    }
+
+    m_stats.publish();
+}
+
+void OrchWorker::run()
+{
+    SWSS_LOG_ENTER();
+
+    auto tstart = chrono::steady_clock::now();
+
+    while (m_running)
+    {
+        Selectable *s;
+        int ret = m_select.select(&s, WORKER_SELECT_TIMEOUT);
+
+        auto tselect = chrono::steady_clock::now();
+        if (chrono::duration_cast<chrono::milliseconds>(tselect - tstart).count() >= WORKER_SELECT_TIMEOUT)
+        {
+            tstart = tselect;
+            flush();
+        }
+
+        if (ret == Select::ERROR)
+        {
+            SWSS_LOG_NOTICE("Orch worker %s error: %s!", m_group.c_str(), strerror(errno));
+            continue;
+        }
+
+        if (ret == Select::TIMEOUT)
+        {
+            flush();
+            continue;
+        }
+
+        if (s == &m_stopEvent)
+        {
+            break;
+        }
+
+        lock_guard<mutex> lock(m_execMutex);
+
+        auto *c = (Executor *)s;
+        auto texec = chrono::steady_clock::now();
+        c->execute();
+        auto tdone = chrono::steady_clock::now();
+
+        m_stats.record(c->getName(),
+                       chrono::duration_cast<chrono::microseconds>(texec - tselect).count(),
+                       chrono::duration_cast<chrono::microseconds>(tdone - texec).count());
+
+        /* Retry the remaining tasks of the worker orchs */
+        for (Orch *o : m_orchList)
+        {
+            o->doTask();
+        }
+    }
+
+    flush();
+}
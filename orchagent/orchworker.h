@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "dbconnector.h"
+#include "select.h"
+#include "selectableevent.h"
+#include "table.h"
+#include "orch.h"
+
+#define ORCH_SCHED_STATS_TABLE "ORCH_SCHED_STATS_TABLE"
+
+/*
+ * Scheduling statistics of the executors run by one orchagent thread.
+ *
+ * For every executor selected by the thread, the time spent in execute() and
+ * the time the executor waited before being run are tracked. The wait time is
+ * measured from the select returning the executor to the start of its
+ * execute(): it covers the housekeeping of the thread loop and, for a worker,
+ * the wait for the execution lock held by the main thread.
+ *
+ * Statistics are published to STATE_DB ORCH_SCHED_STATS_TABLE|<thread>|<executor>.
+ */
+class OrchSchedStats
+{
+public:
+    OrchSchedStats(const std::string &threadName);
+
+    void setEnabled(bool enabled)
+    {
+        m_enabled = enabled;
+    }
+
+    bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    void record(const std::string &executor, uint64_t waitUs, uint64_t execUs);
+
+    /* Write the entries updated since the last publish, must be called by the owning thread */
+    void publish();
+
+private:
+    struct Entry
+    {
+        uint64_t count = 0;
+        uint64_t totalWaitUs = 0;
+        uint64_t maxWaitUs = 0;
+        uint64_t totalExecUs = 0;
+        uint64_t maxExecUs = 0;
+        bool dirty = false;
+    };
+
+    std::string m_threadName;
+    bool m_enabled = false;
+    std::unordered_map<std::string, Entry> m_entries;
+
+    std::unique_ptr<swss::DBConnector> m_stateDb;
+    std::unique_ptr<swss::Table> m_statsTable;
+};
+
+/*
+ * Worker thread running the orchs of one execution group.
+ *
+ * The worker runs the same select loop as the OrchDaemon main thread on its
+ * own Select. Orchs pinned to a worker must have been created with their own
+ * DB connectors, since redis contexts are not shared between threads.
+ */
+class OrchWorker
+{
+public:
+    OrchWorker(const std::string &group);
+    ~OrchWorker();
+
+    OrchWorker(const OrchWorker&) = delete;
+    OrchWorker& operator=(const OrchWorker&) = delete;
+
+    const std::string &getGroup() const
+    {
+        return m_group;
+    }
+
+    void addOrch(Orch *orch);
+
+    const std::vector<Orch *> &getOrchs() const
+    {
+        return m_orchList;
+    }
+
+    OrchSchedStats &getSchedStats()
+    {
+        return m_stats;
+    }
+
+    void start();
+    void stop();
+
+    /*
+     * Block the worker between two loop iterations. Used by the main thread to
+     * inspect the pending tasks of the worker orchs.
+     */
+    std::unique_lock<std::mutex> pause()
+    {
+        return std::unique_lock<std::mutex>(m_execMutex);
+    }
+
+private:
+    std::string m_group;
+    std::vector<Orch *> m_orchList;
+
+    swss::Select m_select;
+    swss::SelectableEvent m_stopEvent;
+    std::atomic<bool> m_running;
+    std::unique_ptr<std::thread> m_thread;
+    std::mutex m_execMutex;
+
+    OrchSchedStats m_stats;
+
+    void run();
+    void flush();
+};
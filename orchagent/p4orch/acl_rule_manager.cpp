@@ -3,9 +3,11 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "SaiAttributeList.h"
+#include "bulker.h"
 #include "converter.h"
 #include "crmorch.h"
 #include "dbconnector.h"
@@ -32,6 +34,7 @@ extern sai_hostif_api_t *sai_hostif_api;
 extern CrmOrch *gCrmOrch;
 extern PortsOrch *gPortsOrch;
 extern P4Orch *gP4Orch;
+extern size_t gMaxBulkSize;
 
 namespace p4orch
 {
@@ -180,6 +183,13 @@ void AclRuleManager::drain()
 {
     SWSS_LOG_ENTER();
 
+    // Consecutive new rules are validated first and then created together with
+    // bulk SAI calls. Any other entry, or a rule that is already in the batch,
+    // creates the batch first. Updates and deletions stay per rule.
+    std::vector<P4AclRule> acl_rule_list;
+    std::vector<swss::KeyOpFieldsValuesTuple> tuple_list;
+    std::unordered_set<std::string> acl_rule_keys;
+
     for (const auto &key_op_fvs_tuple : m_entries)
     {
         std::string table_name;
@@ -218,14 +228,38 @@ void AclRuleManager::drain()
         const auto &acl_table_name = app_db_entry.acl_table_name;
         const auto &acl_rule_key =
             KeyGenerator::generateAclRuleKey(app_db_entry.match_fvs, std::to_string(app_db_entry.priority));
+        const auto &table_name_and_rule_key = concatTableNameAndRuleKey(acl_table_name, acl_rule_key);
+        if (acl_rule_keys.count(table_name_and_rule_key) != 0)
+        {
+            processAddRuleRequests(acl_rule_list, tuple_list);
+            acl_rule_list.clear();
+            tuple_list.clear();
+            acl_rule_keys.clear();
+        }
 
         const auto &operation = kfvOp(key_op_fvs_tuple);
+        auto *acl_rule = getAclRule(acl_table_name, acl_rule_key);
+        if (!tuple_list.empty() && (operation != SET_COMMAND || acl_rule != nullptr))
+        {
+            processAddRuleRequests(acl_rule_list, tuple_list);
+            acl_rule_list.clear();
+            tuple_list.clear();
+            acl_rule_keys.clear();
+        }
+
         if (operation == SET_COMMAND)
         {
-            auto *acl_rule = getAclRule(acl_table_name, acl_rule_key);
             if (acl_rule == nullptr)
             {
-                status = processAddRuleRequest(acl_rule_key, app_db_entry);
+                P4AclRule new_acl_rule{};
+                status = buildAclRule(acl_rule_key, app_db_entry, new_acl_rule);
+                if (status.ok())
+                {
+                    acl_rule_list.push_back(std::move(new_acl_rule));
+                    tuple_list.push_back(key_op_fvs_tuple);
+                    acl_rule_keys.insert(table_name_and_rule_key);
+                    continue;
+                }
             }
             else
             {
@@ -244,6 +278,10 @@ void AclRuleManager::drain()
         m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple), status,
                              /*replace=*/true);
     }
+    if (!tuple_list.empty())
+    {
+        processAddRuleRequests(acl_rule_list, tuple_list);
+    }
     m_entries.clear();
 }
 
@@ -373,11 +411,19 @@ ReturnCode AclRuleManager::createAclCounter(const std::string &acl_table_name, c
     CHECK_ERROR_AND_LOG_AND_RETURN(
         sai_acl_api->create_acl_counter(counter_oid, gSwitchId, (uint32_t)attrs.size(), attrs.data()),
         "Faied to create counter for the rule in table " << sai_serialize_object_id(acl_rule.acl_table_oid));
-    SWSS_LOG_NOTICE("Suceeded to create ACL counter %s ", sai_serialize_object_id(*counter_oid).c_str());
-    m_p4OidMapper->setOID(SAI_OBJECT_TYPE_ACL_COUNTER, counter_key, *counter_oid);
+    addAclCounter(acl_table_name, counter_key, acl_rule, *counter_oid);
+    return ReturnCode();
+}
+
+void AclRuleManager::addAclCounter(const std::string &acl_table_name, const std::string &counter_key,
+                                   const P4AclRule &acl_rule, sai_object_id_t counter_oid)
+{
+    SWSS_LOG_ENTER();
+
+    SWSS_LOG_NOTICE("Suceeded to create ACL counter %s ", sai_serialize_object_id(counter_oid).c_str());
+    m_p4OidMapper->setOID(SAI_OBJECT_TYPE_ACL_COUNTER, counter_key, counter_oid);
     gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, acl_rule.acl_table_oid);
     m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_ACL_TABLE, acl_table_name);
-    return ReturnCode();
 }
 
 ReturnCode AclRuleManager::removeAclCounter(const std::string &acl_table_name, const std::string &counter_key)
@@ -1569,6 +1615,125 @@ ReturnCode AclRuleManager::createAclRule(P4AclRule &acl_rule)
     return ReturnCode();
 }
 
+std::vector<ReturnCode> AclRuleManager::createAclRules(std::vector<P4AclRule> &acl_rules)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(acl_rules.size());
+    std::vector<bool> created_meters(acl_rules.size(), false);
+    std::vector<bool> created_counters(acl_rules.size(), false);
+
+    // There is no bulk policer API, the meters are created per rule.
+    for (size_t i = 0; i < acl_rules.size(); ++i)
+    {
+        auto &acl_rule = acl_rules[i];
+        if (acl_rule.meter.enabled && acl_rule.meter.meter_oid == SAI_NULL_OBJECT_ID)
+        {
+            statuses[i] = createAclMeter(acl_rule.meter,
+                                         concatTableNameAndRuleKey(acl_rule.acl_table_name, acl_rule.acl_rule_key),
+                                         &acl_rule.meter.meter_oid);
+            if (!statuses[i].ok())
+            {
+                SWSS_LOG_ERROR("Failed to create ACL meter for rule %s", QuotedVar(acl_rule.acl_rule_key).c_str());
+                continue;
+            }
+            created_meters[i] = true;
+        }
+    }
+
+    std::vector<std::vector<sai_attribute_t>> counter_attrs(acl_rules.size());
+    std::vector<sai_status_t> counter_statuses(acl_rules.size(), SAI_STATUS_NOT_EXECUTED);
+    ObjectBulker<sai_acl_counter_bulk_t> counter_bulker(sai_acl_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < acl_rules.size(); ++i)
+    {
+        auto &acl_rule = acl_rules[i];
+        if (statuses[i].ok() && (acl_rule.counter.packets_enabled || acl_rule.counter.bytes_enabled) &&
+            acl_rule.counter.counter_oid == SAI_NULL_OBJECT_ID)
+        {
+            counter_attrs[i] = getCounterSaiAttrs(acl_rule);
+            counter_bulker.create_entry(&acl_rule.counter.counter_oid, &counter_statuses[i],
+                                        (uint32_t)counter_attrs[i].size(), counter_attrs[i].data());
+            created_counters[i] = true;
+        }
+    }
+    counter_bulker.flush();
+
+    for (size_t i = 0; i < acl_rules.size(); ++i)
+    {
+        auto &acl_rule = acl_rules[i];
+        if (!created_counters[i])
+        {
+            continue;
+        }
+        const auto &table_name_and_rule_key = concatTableNameAndRuleKey(acl_rule.acl_table_name, acl_rule.acl_rule_key);
+        if (counter_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            addAclCounter(acl_rule.acl_table_name, table_name_and_rule_key, acl_rule, acl_rule.counter.counter_oid);
+            continue;
+        }
+        created_counters[i] = false;
+        statuses[i] = ReturnCode(counter_statuses[i]) << "Faied to create counter for the rule in table "
+                                                      << sai_serialize_object_id(acl_rule.acl_table_oid);
+        SWSS_LOG_ERROR("%s SAI_STATUS: %s", statuses[i].message().c_str(),
+                       sai_serialize_status(counter_statuses[i]).c_str());
+        SWSS_LOG_ERROR("Failed to create ACL counter for rule %s", QuotedVar(acl_rule.acl_rule_key).c_str());
+        if (created_meters[i])
+        {
+            auto rc = removeAclMeter(table_name_and_rule_key);
+            if (!rc.ok())
+            {
+                SWSS_RAISE_CRITICAL_STATE("Failed to remove ACL meter in recovery.");
+            }
+        }
+    }
+
+    std::vector<std::vector<sai_attribute_t>> entry_attrs(acl_rules.size());
+    std::vector<sai_status_t> entry_statuses(acl_rules.size(), SAI_STATUS_NOT_EXECUTED);
+    ObjectBulker<sai_acl_entry_bulk_t> entry_bulker(sai_acl_api, gSwitchId, gMaxBulkSize);
+    for (size_t i = 0; i < acl_rules.size(); ++i)
+    {
+        if (statuses[i].ok())
+        {
+            entry_attrs[i] = getRuleSaiAttrs(acl_rules[i]);
+            entry_bulker.create_entry(&acl_rules[i].acl_entry_oid, &entry_statuses[i],
+                                      (uint32_t)entry_attrs[i].size(), entry_attrs[i].data());
+        }
+    }
+    entry_bulker.flush();
+
+    for (size_t i = 0; i < acl_rules.size(); ++i)
+    {
+        auto &acl_rule = acl_rules[i];
+        if (!statuses[i].ok() || entry_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            continue;
+        }
+        statuses[i] = ReturnCode(entry_statuses[i])
+                      << "Failed to create ACL entry in table " << QuotedVar(acl_rule.acl_table_name);
+        SWSS_LOG_ERROR("%s SAI_STATUS: %s", statuses[i].message().c_str(),
+                       sai_serialize_status(entry_statuses[i]).c_str());
+        const auto &table_name_and_rule_key = concatTableNameAndRuleKey(acl_rule.acl_table_name, acl_rule.acl_rule_key);
+        if (created_meters[i])
+        {
+            auto rc = removeAclMeter(table_name_and_rule_key);
+            if (!rc.ok())
+            {
+                SWSS_RAISE_CRITICAL_STATE("Failed to remove ACL meter in recovery.");
+            }
+        }
+        if (created_counters[i])
+        {
+            auto rc = removeAclCounter(acl_rule.acl_table_name, table_name_and_rule_key);
+            if (!rc.ok())
+            {
+                SWSS_RAISE_CRITICAL_STATE("Failed to remove ACL counter in recovery.");
+            }
+        }
+    }
+
+    return statuses;
+}
+
 ReturnCode AclRuleManager::updateAclRule(const P4AclRule &acl_rule, const P4AclRule &old_acl_rule,
                                          std::vector<sai_attribute_t> &acl_entry_attrs,
                                          std::vector<sai_attribute_t> &rollback_attrs)
@@ -1798,10 +1963,9 @@ ReturnCode AclRuleManager::removeAclRule(const std::string &acl_table_name, cons
     return ReturnCode();
 }
 
-ReturnCode AclRuleManager::processAddRuleRequest(const std::string &acl_rule_key,
-                                                 const P4AclRuleAppDbEntry &app_db_entry)
+ReturnCode AclRuleManager::buildAclRule(const std::string &acl_rule_key, const P4AclRuleAppDbEntry &app_db_entry,
+                                        P4AclRule &acl_rule)
 {
-    P4AclRule acl_rule{};
     acl_rule.priority = app_db_entry.priority;
     acl_rule.acl_rule_key = acl_rule_key;
     acl_rule.p4_action = app_db_entry.action;
@@ -1847,13 +2011,61 @@ ReturnCode AclRuleManager::processAddRuleRequest(const std::string &acl_rule_key
                                  << "Invalid ACL counter type " << QuotedVar(acl_table->counter_unit));
         }
     }
-    status = createAclRule(acl_rule);
+    return ReturnCode();
+}
+
+ReturnCode AclRuleManager::processAddRuleRequest(const std::string &acl_rule_key,
+                                                 const P4AclRuleAppDbEntry &app_db_entry)
+{
+    P4AclRule acl_rule{};
+    RETURN_IF_ERROR(buildAclRule(acl_rule_key, app_db_entry, acl_rule));
+    auto status = createAclRule(acl_rule);
     if (!status.ok())
     {
         SWSS_LOG_ERROR("Failed to create ACL rule with key %s in table %s", QuotedVar(acl_rule.acl_rule_key).c_str(),
                        QuotedVar(app_db_entry.acl_table_name).c_str());
         return status;
     }
+    addAclRule(acl_rule);
+    return status;
+}
+
+void AclRuleManager::processAddRuleRequests(std::vector<P4AclRule> &acl_rules,
+                                            const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses;
+    if (acl_rules.size() == 1)
+    {
+        // A single rule is created with the per object SAI calls.
+        statuses.push_back(createAclRule(acl_rules[0]));
+    }
+    else
+    {
+        statuses = createAclRules(acl_rules);
+    }
+
+    for (size_t i = 0; i < tuple_list.size(); ++i)
+    {
+        if (statuses[i].ok())
+        {
+            addAclRule(acl_rules[i]);
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to create ACL rule with key %s in table %s",
+                           QuotedVar(acl_rules[i].acl_rule_key).c_str(), QuotedVar(acl_rules[i].acl_table_name).c_str());
+        }
+        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(tuple_list[i]), kfvFieldsValues(tuple_list[i]), statuses[i],
+                             /*replace=*/true);
+    }
+}
+
+void AclRuleManager::addAclRule(P4AclRule &acl_rule)
+{
+    SWSS_LOG_ENTER();
+
     // ACL entry created in HW, update refcount
     if (!acl_rule.action_redirect_nexthop_key.empty())
     {
@@ -1896,11 +2108,11 @@ ReturnCode AclRuleManager::processAddRuleRequest(const std::string &acl_rule_key
         // Meter was created, increase ACL rule ref count
         m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_POLICER, table_name_and_rule_key);
     }
-    m_aclRuleTables[acl_table->acl_table_name][acl_rule_key] = std::move(acl_rule);
-    SWSS_LOG_NOTICE(
-        "Suceeded to create ACL rule %s : %s", QuotedVar(acl_rule_key).c_str(),
-        sai_serialize_object_id(m_aclRuleTables[acl_table->acl_table_name][acl_rule_key].acl_entry_oid).c_str());
-    return status;
+    const auto acl_table_name = acl_rule.acl_table_name;
+    const auto acl_rule_key = acl_rule.acl_rule_key;
+    m_aclRuleTables[acl_table_name][acl_rule_key] = std::move(acl_rule);
+    SWSS_LOG_NOTICE("Suceeded to create ACL rule %s : %s", QuotedVar(acl_rule_key).c_str(),
+                    sai_serialize_object_id(m_aclRuleTables[acl_table_name][acl_rule_key].acl_entry_oid).c_str());
 }
 
 ReturnCode AclRuleManager::processDeleteRuleRequest(const std::string &acl_table_name, const std::string &acl_rule_key)
@@ -66,6 +66,15 @@ class AclRuleManager : public ObjectManagerInterface
     // Processes add operation for an ACL rule.
     ReturnCode processAddRuleRequest(const std::string &acl_rule_key, const P4AclRuleAppDbEntry &app_db_entry);
 
+    // Processes add operations for new ACL rules built by buildAclRule(), and
+    // publishes the status of each rule.
+    void processAddRuleRequests(std::vector<P4AclRule> &acl_rules,
+                                const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list);
+
+    // Validate an APP_DB entry and build the ACL rule to be created.
+    ReturnCode buildAclRule(const std::string &acl_rule_key, const P4AclRuleAppDbEntry &app_db_entry,
+                            P4AclRule &acl_rule);
+
     // Processes delete operation for an ACL rule.
     ReturnCode processDeleteRuleRequest(const std::string &acl_table_name, const std::string &acl_rule_key);
 
@@ -78,10 +87,20 @@ class AclRuleManager : public ObjectManagerInterface
     // Create an ACL rule.
     ReturnCode createAclRule(P4AclRule &acl_rule);
 
+    // Create ACL rules, with bulk SAI calls for the counters and entries.
+    std::vector<ReturnCode> createAclRules(std::vector<P4AclRule> &acl_rules);
+
+    // Add a created ACL rule and update the reference counts of its objects.
+    void addAclRule(P4AclRule &acl_rule);
+
     // Create an ACL counter.
     ReturnCode createAclCounter(const std::string &acl_table_name, const std::string &counter_key,
                                 const P4AclRule &acl_rule, sai_object_id_t *counter_oid);
 
+    // Add a created ACL counter to the centralized map.
+    void addAclCounter(const std::string &acl_table_name, const std::string &counter_key, const P4AclRule &acl_rule,
+                       sai_object_id_t counter_oid);
+
     // Create an ACL meter.
     ReturnCode createAclMeter(const P4AclMeter &p4_acl_meter, const std::string &meter_key, sai_object_id_t *meter_oid);
 
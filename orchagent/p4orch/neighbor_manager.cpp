@@ -3,9 +3,11 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "SaiAttributeList.h"
+#include "bulker.h"
 #include "crmorch.h"
 #include "dbconnector.h"
 #include "logger.h"
@@ -25,6 +27,8 @@ extern sai_object_id_t gSwitchId;
 
 extern sai_neighbor_api_t *sai_neighbor_api;
 
+extern size_t gMaxBulkSize;
+
 extern CrmOrch *gCrmOrch;
 
 namespace
@@ -168,7 +172,7 @@ P4NeighborEntry *NeighborManager::getNeighborEntry(const std::string &neighbor_k
     return &m_neighborTable[neighbor_key];
 }
 
-ReturnCode NeighborManager::createNeighbor(P4NeighborEntry &neighbor_entry)
+ReturnCode NeighborManager::validateNeighborCreate(P4NeighborEntry &neighbor_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -186,11 +190,63 @@ ReturnCode NeighborManager::createNeighbor(P4NeighborEntry &neighbor_entry)
     }
 
     ASSIGN_OR_RETURN(neighbor_entry.neigh_entry, getSaiEntry(neighbor_entry));
+    return ReturnCode();
+}
+
+ReturnCode NeighborManager::createNeighbor(P4NeighborEntry &neighbor_entry)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateNeighborCreate(neighbor_entry));
     auto attrs = getSaiAttrs(neighbor_entry);
 
     CHECK_ERROR_AND_LOG_AND_RETURN(sai_neighbor_api->create_neighbor_entry(
                                        &neighbor_entry.neigh_entry, static_cast<uint32_t>(attrs.size()), attrs.data()),
-                                   "Failed to create neighbor with key " << QuotedVar(neighbor_key));
+                                   "Failed to create neighbor with key " << QuotedVar(neighbor_entry.neighbor_key));
+
+    addNeighbor(neighbor_entry);
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> NeighborManager::createNeighbors(std::vector<P4NeighborEntry> &neighbor_entries)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(neighbor_entries.size());
+    std::vector<sai_status_t> object_statuses(neighbor_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    EntityBulker<sai_neighbor_api_t> neighbor_bulker(sai_neighbor_api, gMaxBulkSize);
+
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
+    {
+        auto attrs = getSaiAttrs(neighbor_entries[i]);
+        neighbor_bulker.create_entry(&object_statuses[i], &neighbor_entries[i].neigh_entry,
+                                     static_cast<uint32_t>(attrs.size()), attrs.data());
+    }
+
+    neighbor_bulker.flush();
+
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
+    {
+        const auto &neighbor_entry = neighbor_entries[i];
+        CHECK_ERROR_AND_LOG(object_statuses[i],
+                            "Failed to create neighbor with key " << QuotedVar(neighbor_entry.neighbor_key));
+        if (object_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            addNeighbor(neighbor_entry);
+        }
+        else
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to create neighbor with key " << QuotedVar(neighbor_entry.neighbor_key);
+        }
+    }
+
+    return statuses;
+}
+
+void NeighborManager::addNeighbor(const P4NeighborEntry &neighbor_entry)
+{
+    SWSS_LOG_ENTER();
 
     m_p4OidMapper->increaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry.router_intf_key);
     if (neighbor_entry.neighbor_id.isV4())
@@ -202,12 +258,11 @@ ReturnCode NeighborManager::createNeighbor(P4NeighborEntry &neighbor_entry)
         gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
     }
 
-    m_neighborTable[neighbor_key] = neighbor_entry;
-    m_p4OidMapper->setDummyOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
-    return ReturnCode();
+    m_neighborTable[neighbor_entry.neighbor_key] = neighbor_entry;
+    m_p4OidMapper->setDummyOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_entry.neighbor_key);
 }
 
-ReturnCode NeighborManager::removeNeighbor(const std::string &neighbor_key)
+ReturnCode NeighborManager::validateNeighborRemove(const std::string &neighbor_key)
 {
     SWSS_LOG_ENTER();
 
@@ -231,9 +286,61 @@ ReturnCode NeighborManager::removeNeighbor(const std::string &neighbor_key)
                              << " referenced by other objects (ref_count = " << ref_count << ")");
     }
 
+    return ReturnCode();
+}
+
+ReturnCode NeighborManager::removeNeighbor(const std::string &neighbor_key)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateNeighborRemove(neighbor_key));
+    auto *neighbor_entry = getNeighborEntry(neighbor_key);
+
     CHECK_ERROR_AND_LOG_AND_RETURN(sai_neighbor_api->remove_neighbor_entry(&neighbor_entry->neigh_entry),
                                    "Failed to remove neighbor with key " << QuotedVar(neighbor_key));
 
+    eraseNeighbor(neighbor_key);
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> NeighborManager::removeNeighbors(const std::vector<P4NeighborEntry> &neighbor_entries)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(neighbor_entries.size());
+    std::vector<sai_status_t> object_statuses(neighbor_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    EntityBulker<sai_neighbor_api_t> neighbor_bulker(sai_neighbor_api, gMaxBulkSize);
+
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
+    {
+        neighbor_bulker.remove_entry(&object_statuses[i], &neighbor_entries[i].neigh_entry);
+    }
+
+    neighbor_bulker.flush();
+
+    for (size_t i = 0; i < neighbor_entries.size(); ++i)
+    {
+        const auto &neighbor_key = neighbor_entries[i].neighbor_key;
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to remove neighbor with key " << QuotedVar(neighbor_key));
+        if (object_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            eraseNeighbor(neighbor_key);
+        }
+        else
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to remove neighbor with key " << QuotedVar(neighbor_key);
+        }
+    }
+
+    return statuses;
+}
+
+void NeighborManager::eraseNeighbor(const std::string &neighbor_key)
+{
+    SWSS_LOG_ENTER();
+
+    auto *neighbor_entry = getNeighborEntry(neighbor_key);
     m_p4OidMapper->decreaseRefCount(SAI_OBJECT_TYPE_ROUTER_INTERFACE, neighbor_entry->router_intf_key);
     if (neighbor_entry->neighbor_id.isV4())
     {
@@ -246,7 +353,6 @@ ReturnCode NeighborManager::removeNeighbor(const std::string &neighbor_key)
 
     m_p4OidMapper->eraseOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key);
     m_neighborTable.erase(neighbor_key);
-    return ReturnCode();
 }
 
 ReturnCode NeighborManager::setDstMacAddress(P4NeighborEntry *neighbor_entry, const swss::MacAddress &mac_address)
@@ -268,7 +374,8 @@ ReturnCode NeighborManager::setDstMacAddress(P4NeighborEntry *neighbor_entry, co
     return ReturnCode();
 }
 
-ReturnCode NeighborManager::processAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key)
+ReturnCode NeighborManager::validateAddRequest(const P4NeighborAppDbEntry &app_db_entry,
+                                               const std::string &neighbor_key)
 {
     SWSS_LOG_ENTER();
 
@@ -282,6 +389,15 @@ ReturnCode NeighborManager::processAddRequest(const P4NeighborAppDbEntry &app_db
                              << QuotedVar(neighbor_key));
     }
 
+    return ReturnCode();
+}
+
+ReturnCode NeighborManager::processAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateAddRequest(app_db_entry, neighbor_key));
+
     P4NeighborEntry neighbor_entry(app_db_entry.router_intf_id, app_db_entry.neighbor_id, app_db_entry.dst_mac_address);
     auto status = createNeighbor(neighbor_entry);
     if (!status.ok())
@@ -372,6 +488,14 @@ void NeighborManager::drain()
 {
     SWSS_LOG_ENTER();
 
+    // Consecutive creations or removals are validated first and then
+    // programmed together with bulk SAI calls. An entry of another operation,
+    // or of a neighbor that is already in the batch, programs the batch first.
+    std::vector<P4NeighborEntry> neighbor_list;
+    std::vector<swss::KeyOpFieldsValuesTuple> tuple_list;
+    std::unordered_set<std::string> neighbor_keys;
+    std::string batch_operation;
+
     for (const auto &key_op_fvs_tuple : m_entries)
     {
         std::string table_name;
@@ -406,15 +530,41 @@ void NeighborManager::drain()
 
         const std::string neighbor_key =
             KeyGenerator::generateNeighborKey(app_db_entry.router_intf_id, app_db_entry.neighbor_id);
+        if (neighbor_keys.count(neighbor_key) != 0)
+        {
+            processEntries(batch_operation, neighbor_list, tuple_list);
+            neighbor_list.clear();
+            tuple_list.clear();
+            neighbor_keys.clear();
+        }
 
         const std::string &operation = kfvOp(key_op_fvs_tuple);
+        auto *neighbor_entry = getNeighborEntry(neighbor_key);
+        bool batched = (operation == SET_COMMAND && neighbor_entry == nullptr) || operation == DEL_COMMAND;
+        if (!tuple_list.empty() && (!batched || operation != batch_operation))
+        {
+            processEntries(batch_operation, neighbor_list, tuple_list);
+            neighbor_list.clear();
+            tuple_list.clear();
+            neighbor_keys.clear();
+        }
+
         if (operation == SET_COMMAND)
         {
-            auto *neighbor_entry = getNeighborEntry(neighbor_key);
             if (neighbor_entry == nullptr)
             {
                 // Create neighbor
-                status = processAddRequest(app_db_entry, neighbor_key);
+                P4NeighborEntry new_neighbor_entry(app_db_entry.router_intf_id, app_db_entry.neighbor_id,
+                                                   app_db_entry.dst_mac_address);
+                status = validateAddRequest(app_db_entry, neighbor_key);
+                if (status.ok())
+                {
+                    status = validateNeighborCreate(new_neighbor_entry);
+                }
+                if (status.ok())
+                {
+                    neighbor_list.push_back(new_neighbor_entry);
+                }
             }
             else
             {
@@ -425,19 +575,69 @@ void NeighborManager::drain()
         else if (operation == DEL_COMMAND)
         {
             // Delete neighbor
-            status = processDeleteRequest(neighbor_key);
+            status = validateNeighborRemove(neighbor_key);
+            if (status.ok())
+            {
+                neighbor_list.push_back(*neighbor_entry);
+            }
         }
         else
         {
             status = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM) << "Unknown operation type " << QuotedVar(operation);
             SWSS_LOG_ERROR("%s", status.message().c_str());
         }
+
+        if (batched && status.ok())
+        {
+            batch_operation = operation;
+            tuple_list.push_back(key_op_fvs_tuple);
+            neighbor_keys.insert(neighbor_key);
+            continue;
+        }
         m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple), status,
                              /*replace=*/true);
     }
+    if (!tuple_list.empty())
+    {
+        processEntries(batch_operation, neighbor_list, tuple_list);
+    }
     m_entries.clear();
 }
 
+void NeighborManager::processEntries(const std::string &operation, std::vector<P4NeighborEntry> &neighbor_list,
+                                     const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses;
+    if (neighbor_list.size() == 1)
+    {
+        // A single neighbor is programmed with the per object SAI call.
+        auto status = (operation == SET_COMMAND) ? createNeighbor(neighbor_list[0])
+                                                 : removeNeighbor(neighbor_list[0].neighbor_key);
+        statuses.push_back(status);
+    }
+    else if (operation == SET_COMMAND)
+    {
+        statuses = createNeighbors(neighbor_list);
+    }
+    else
+    {
+        statuses = removeNeighbors(neighbor_list);
+    }
+
+    for (size_t i = 0; i < tuple_list.size(); ++i)
+    {
+        if (!statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to %s neighbor with key %s", operation == SET_COMMAND ? "create" : "remove",
+                           QuotedVar(neighbor_list[i].neighbor_key).c_str());
+        }
+        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(tuple_list[i]), kfvFieldsValues(tuple_list[i]), statuses[i],
+                             /*replace=*/true);
+    }
+}
+
 std::string NeighborManager::verifyState(const std::string &key, const std::vector<swss::FieldValueTuple> &tuple)
 {
     SWSS_LOG_ENTER();
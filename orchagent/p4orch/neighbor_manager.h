@@ -60,9 +60,18 @@ class NeighborManager : public ObjectManagerInterface
                                                                 const std::vector<swss::FieldValueTuple> &attributes);
     ReturnCode validateNeighborAppDbEntry(const P4NeighborAppDbEntry &app_db_entry);
     P4NeighborEntry *getNeighborEntry(const std::string &neighbor_key);
+    ReturnCode validateNeighborCreate(P4NeighborEntry &neighbor_entry);
     ReturnCode createNeighbor(P4NeighborEntry &neighbor_entry);
+    std::vector<ReturnCode> createNeighbors(std::vector<P4NeighborEntry> &neighbor_entries);
+    void addNeighbor(const P4NeighborEntry &neighbor_entry);
+    ReturnCode validateNeighborRemove(const std::string &neighbor_key);
     ReturnCode removeNeighbor(const std::string &neighbor_key);
+    std::vector<ReturnCode> removeNeighbors(const std::vector<P4NeighborEntry> &neighbor_entries);
+    void eraseNeighbor(const std::string &neighbor_key);
     ReturnCode setDstMacAddress(P4NeighborEntry *neighbor_entry, const swss::MacAddress &mac_address);
+    void processEntries(const std::string &operation, std::vector<P4NeighborEntry> &neighbor_list,
+                        const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list);
+    ReturnCode validateAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key);
     ReturnCode processAddRequest(const P4NeighborAppDbEntry &app_db_entry, const std::string &neighbor_key);
     ReturnCode processUpdateRequest(const P4NeighborAppDbEntry &app_db_entry, P4NeighborEntry *neighbor_entry);
     ReturnCode processDeleteRequest(const std::string &neighbor_key);
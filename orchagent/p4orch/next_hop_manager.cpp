@@ -3,9 +3,11 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "SaiAttributeList.h"
+#include "bulker.h"
 #include "crmorch.h"
 #include "dbconnector.h"
 #include "ipaddress.h"
@@ -24,6 +26,7 @@ using ::p4orch::kTableKeyDelimiter;
 
 extern sai_object_id_t gSwitchId;
 extern sai_next_hop_api_t *sai_next_hop_api;
+extern size_t gMaxBulkSize;
 extern CrmOrch *gCrmOrch;
 extern P4Orch *gP4Orch;
 
@@ -184,6 +187,14 @@ void NextHopManager::drain()
 {
     SWSS_LOG_ENTER();
 
+    // Consecutive creations or removals are validated first and then
+    // programmed together with bulk SAI calls. An entry of another operation,
+    // or of a next hop that is already in the batch, programs the batch first.
+    std::vector<P4NextHopEntry> next_hop_list;
+    std::vector<swss::KeyOpFieldsValuesTuple> tuple_list;
+    std::unordered_set<std::string> next_hop_keys;
+    std::string batch_operation;
+
     for (const auto &key_op_fvs_tuple : m_entries)
     {
         std::string table_name;
@@ -206,9 +217,26 @@ void NextHopManager::drain()
         auto &app_db_entry = *app_db_entry_or;
 
         const std::string next_hop_key = KeyGenerator::generateNextHopKey(app_db_entry.next_hop_id);
+        if (next_hop_keys.count(next_hop_key) != 0)
+        {
+            processEntries(batch_operation, next_hop_list, tuple_list);
+            next_hop_list.clear();
+            tuple_list.clear();
+            next_hop_keys.clear();
+        }
 
         // Fulfill the operation.
         const std::string &operation = kfvOp(key_op_fvs_tuple);
+        auto *next_hop_entry = getNextHopEntry(next_hop_key);
+        bool batched = (operation == SET_COMMAND && next_hop_entry == nullptr) || operation == DEL_COMMAND;
+        if (!tuple_list.empty() && (!batched || operation != batch_operation))
+        {
+            processEntries(batch_operation, next_hop_list, tuple_list);
+            next_hop_list.clear();
+            tuple_list.clear();
+            next_hop_keys.clear();
+        }
+
         if (operation == SET_COMMAND)
         {
             status = validateAppDbEntry(app_db_entry);
@@ -221,11 +249,16 @@ void NextHopManager::drain()
                                      /*replace=*/true);
                 continue;
             }
-            auto *next_hop_entry = getNextHopEntry(next_hop_key);
             if (next_hop_entry == nullptr)
             {
                 // Create new next hop.
-                status = processAddRequest(app_db_entry);
+                P4NextHopEntry new_next_hop_entry(app_db_entry.next_hop_id, app_db_entry.router_interface_id,
+                                                  app_db_entry.gre_tunnel_id, app_db_entry.neighbor_id);
+                status = validateNextHopCreate(new_next_hop_entry);
+                if (status.ok())
+                {
+                    next_hop_list.push_back(new_next_hop_entry);
+                }
             }
             else
             {
@@ -236,19 +269,69 @@ void NextHopManager::drain()
         else if (operation == DEL_COMMAND)
         {
             // Delete next hop.
-            status = processDeleteRequest(next_hop_key);
+            status = validateNextHopRemove(next_hop_key);
+            if (status.ok())
+            {
+                next_hop_list.push_back(*next_hop_entry);
+            }
         }
         else
         {
             status = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM) << "Unknown operation type " << QuotedVar(operation);
             SWSS_LOG_ERROR("%s", status.message().c_str());
         }
+
+        if (batched && status.ok())
+        {
+            batch_operation = operation;
+            tuple_list.push_back(key_op_fvs_tuple);
+            next_hop_keys.insert(next_hop_key);
+            continue;
+        }
         m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple), status,
                              /*replace=*/true);
     }
+    if (!tuple_list.empty())
+    {
+        processEntries(batch_operation, next_hop_list, tuple_list);
+    }
     m_entries.clear();
 }
 
+void NextHopManager::processEntries(const std::string &operation, std::vector<P4NextHopEntry> &next_hop_list,
+                                    const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses;
+    if (next_hop_list.size() == 1)
+    {
+        // A single next hop is programmed with the per object SAI call.
+        auto status = (operation == SET_COMMAND) ? createNextHop(next_hop_list[0])
+                                                 : removeNextHop(next_hop_list[0].next_hop_key);
+        statuses.push_back(status);
+    }
+    else if (operation == SET_COMMAND)
+    {
+        statuses = createNextHops(next_hop_list);
+    }
+    else
+    {
+        statuses = removeNextHops(next_hop_list);
+    }
+
+    for (size_t i = 0; i < tuple_list.size(); ++i)
+    {
+        if (!statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to %s next hop with key %s", operation == SET_COMMAND ? "create" : "remove",
+                           QuotedVar(next_hop_list[i].next_hop_key).c_str());
+        }
+        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(tuple_list[i]), kfvFieldsValues(tuple_list[i]), statuses[i],
+                             /*replace=*/true);
+    }
+}
+
 P4NextHopEntry *NextHopManager::getNextHopEntry(const std::string &next_hop_key)
 {
     SWSS_LOG_ENTER();
@@ -335,7 +418,7 @@ ReturnCode NextHopManager::processAddRequest(const P4NextHopAppDbEntry &app_db_e
     return status;
 }
 
-ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
+ReturnCode NextHopManager::validateNextHopCreate(P4NextHopEntry &next_hop_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -381,6 +464,15 @@ ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
                              << " does not exist in centralized mapper");
     }
 
+    return ReturnCode();
+}
+
+ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateNextHopCreate(next_hop_entry));
+
     ASSIGN_OR_RETURN(std::vector<sai_attribute_t> attrs, getSaiAttrs(next_hop_entry));
 
     // Call SAI API.
@@ -388,6 +480,64 @@ ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
                                                                      (uint32_t)attrs.size(), attrs.data()),
                                    "Failed to create next hop " << QuotedVar(next_hop_entry.next_hop_key));
 
+    addNextHop(next_hop_entry);
+
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> NextHopManager::createNextHops(std::vector<P4NextHopEntry> &next_hop_entries)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(next_hop_entries.size());
+    std::vector<sai_status_t> object_statuses(next_hop_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    std::vector<bool> queued(next_hop_entries.size(), false);
+    ObjectBulker<sai_next_hop_api_t> next_hop_bulker(sai_next_hop_api, gSwitchId, gMaxBulkSize);
+
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
+    {
+        auto attrs_or = getSaiAttrs(next_hop_entries[i]);
+        if (!attrs_or.ok())
+        {
+            statuses[i] = attrs_or.status();
+            continue;
+        }
+        auto &attrs = *attrs_or;
+        next_hop_bulker.create_entry(&next_hop_entries[i].next_hop_oid, &object_statuses[i], (uint32_t)attrs.size(),
+                                     attrs.data());
+        queued[i] = true;
+    }
+
+    next_hop_bulker.flush();
+
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
+    {
+        if (!queued[i])
+        {
+            continue;
+        }
+        auto &next_hop_entry = next_hop_entries[i];
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to create next hop " << QuotedVar(next_hop_entry.next_hop_key));
+        if (object_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            addNextHop(next_hop_entry);
+        }
+        else
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to create next hop " << QuotedVar(next_hop_entry.next_hop_key);
+        }
+    }
+
+    return statuses;
+}
+
+void NextHopManager::addNextHop(const P4NextHopEntry &next_hop_entry)
+{
+    SWSS_LOG_ENTER();
+
+    const auto neighbor_key =
+        KeyGenerator::generateNeighborKey(next_hop_entry.router_interface_id, next_hop_entry.neighbor_id);
     if (!next_hop_entry.gre_tunnel_id.empty())
     {
         // On successful creation, increment ref count for tunnel object
@@ -416,8 +566,6 @@ ReturnCode NextHopManager::createNextHop(P4NextHopEntry &next_hop_entry)
 
     // Add the key to OID map to centralized mapper.
     m_p4OidMapper->setOID(SAI_OBJECT_TYPE_NEXT_HOP, next_hop_entry.next_hop_key, next_hop_entry.next_hop_oid);
-
-    return ReturnCode();
 }
 
 ReturnCode NextHopManager::processUpdateRequest(const P4NextHopAppDbEntry &app_db_entry, P4NextHopEntry *next_hop_entry)
@@ -444,7 +592,7 @@ ReturnCode NextHopManager::processDeleteRequest(const std::string &next_hop_key)
     return status;
 }
 
-ReturnCode NextHopManager::removeNextHop(const std::string &next_hop_key)
+ReturnCode NextHopManager::validateNextHopRemove(const std::string &next_hop_key)
 {
     SWSS_LOG_ENTER();
 
@@ -472,10 +620,60 @@ ReturnCode NextHopManager::removeNextHop(const std::string &next_hop_key)
                              << " referenced by other objects (ref_count = " << ref_count);
     }
 
+    return ReturnCode();
+}
+
+ReturnCode NextHopManager::removeNextHop(const std::string &next_hop_key)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateNextHopRemove(next_hop_key));
+    auto *next_hop_entry = getNextHopEntry(next_hop_key);
+
     // Call SAI API.
     CHECK_ERROR_AND_LOG_AND_RETURN(sai_next_hop_api->remove_next_hop(next_hop_entry->next_hop_oid),
                                    "Failed to remove next hop " << QuotedVar(next_hop_entry->next_hop_key));
 
+    return eraseNextHop(next_hop_key);
+}
+
+std::vector<ReturnCode> NextHopManager::removeNextHops(const std::vector<P4NextHopEntry> &next_hop_entries)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(next_hop_entries.size());
+    std::vector<sai_status_t> object_statuses(next_hop_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    ObjectBulker<sai_next_hop_api_t> next_hop_bulker(sai_next_hop_api, gSwitchId, gMaxBulkSize);
+
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
+    {
+        next_hop_bulker.remove_entry(&object_statuses[i], next_hop_entries[i].next_hop_oid);
+    }
+
+    next_hop_bulker.flush();
+
+    for (size_t i = 0; i < next_hop_entries.size(); ++i)
+    {
+        const auto &next_hop_key = next_hop_entries[i].next_hop_key;
+        CHECK_ERROR_AND_LOG(object_statuses[i], "Failed to remove next hop " << QuotedVar(next_hop_key));
+        if (object_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            statuses[i] = eraseNextHop(next_hop_key);
+        }
+        else
+        {
+            statuses[i] = ReturnCode(object_statuses[i]) << "Failed to remove next hop " << QuotedVar(next_hop_key);
+        }
+    }
+
+    return statuses;
+}
+
+ReturnCode NextHopManager::eraseNextHop(const std::string &next_hop_key)
+{
+    SWSS_LOG_ENTER();
+
+    auto *next_hop_entry = getNextHopEntry(next_hop_key);
     if (!next_hop_entry->gre_tunnel_id.empty())
     {
         // On successful deletion, decrement ref count for tunnel object
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "ipaddress.h"
 #include "orch.h"
@@ -72,21 +73,47 @@ class NextHopManager : public ObjectManagerInterface
     ReturnCodeOr<P4NextHopAppDbEntry> deserializeP4NextHopAppDbEntry(
         const std::string &key, const std::vector<swss::FieldValueTuple> &attributes);
 
+    // Programs a batch of validated entries of the same operation and
+    // publishes the status of each of them.
+    void processEntries(const std::string &operation, std::vector<P4NextHopEntry> &next_hop_list,
+                        const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list);
+
     // Processes add operation for an entry.
     ReturnCode processAddRequest(const P4NextHopAppDbEntry &app_db_entry);
 
+    // Validates the creation of a next hop, resolving the router interface and
+    // neighbor of a tunnel next hop.
+    ReturnCode validateNextHopCreate(P4NextHopEntry &next_hop_entry);
+
     // Creates an next hop in the next hop table. Return true on success.
     ReturnCode createNextHop(P4NextHopEntry &next_hop_entry);
 
+    // Creates validated next hops with bulk SAI calls. Returns the status of
+    // each next hop.
+    std::vector<ReturnCode> createNextHops(std::vector<P4NextHopEntry> &next_hop_entries);
+
+    // Updates the references and the caches of a created next hop.
+    void addNextHop(const P4NextHopEntry &next_hop_entry);
+
     // Processes update operation for an entry.
     ReturnCode processUpdateRequest(const P4NextHopAppDbEntry &app_db_entry, P4NextHopEntry *next_hop_entry);
 
     // Processes delete operation for an entry.
     ReturnCode processDeleteRequest(const std::string &next_hop_key);
 
+    // Validates the removal of a next hop.
+    ReturnCode validateNextHopRemove(const std::string &next_hop_key);
+
     // Deletes an next hop in the next hop table. Return true on success.
     ReturnCode removeNextHop(const std::string &next_hop_key);
 
+    // Removes validated next hops with bulk SAI calls. Returns the status of
+    // each next hop.
+    std::vector<ReturnCode> removeNextHops(const std::vector<P4NextHopEntry> &next_hop_entries);
+
+    // Updates the references and the caches of a removed next hop.
+    ReturnCode eraseNextHop(const std::string &next_hop_key);
+
     // Verifies internal cache for an entry.
     std::string verifyStateCache(const P4NextHopAppDbEntry &app_db_entry, const P4NextHopEntry *next_hop_entry);
 
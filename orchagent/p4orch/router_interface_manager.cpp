@@ -5,10 +5,12 @@
 #include <nlohmann/json.hpp>
 #include <sstream>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "SaiAttributeList.h"
+#include "bulker.h"
 #include "dbconnector.h"
 #include "directory.h"
 #include "logger.h"
@@ -26,6 +28,8 @@ extern sai_object_id_t gVirtualRouterId;
 
 extern sai_router_interface_api_t *sai_router_intfs_api;
 
+extern size_t gMaxBulkSize;
+
 extern PortsOrch *gPortsOrch;
 extern Directory<Orch *> gDirectory;
 
@@ -178,8 +182,8 @@ P4RouterInterfaceEntry *RouterInterfaceManager::getRouterInterfaceEntry(const st
     return &m_routerIntfTable[router_intf_key];
 }
 
-ReturnCode RouterInterfaceManager::createRouterInterface(const std::string &router_intf_key,
-                                                         P4RouterInterfaceEntry &router_intf_entry)
+ReturnCode RouterInterfaceManager::validateRouterInterfaceCreate(const std::string &router_intf_key,
+                                                                 const P4RouterInterfaceEntry &router_intf_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -196,6 +200,15 @@ ReturnCode RouterInterfaceManager::createRouterInterface(const std::string &rout
                                                                      << " already exists in the centralized map");
     }
 
+    return ReturnCode();
+}
+
+ReturnCode RouterInterfaceManager::createRouterInterface(const std::string &router_intf_key,
+                                                         P4RouterInterfaceEntry &router_intf_entry)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateRouterInterfaceCreate(router_intf_key, router_intf_entry));
     ASSIGN_OR_RETURN(std::vector<sai_attribute_t> attrs, getSaiAttrs(router_intf_entry));
 
     CHECK_ERROR_AND_LOG_AND_RETURN(
@@ -203,15 +216,74 @@ ReturnCode RouterInterfaceManager::createRouterInterface(const std::string &rout
                                                       (uint32_t)attrs.size(), attrs.data()),
         "Failed to create router interface " << QuotedVar(router_intf_entry.router_interface_id));
 
+    addRouterInterface(router_intf_key, router_intf_entry);
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> RouterInterfaceManager::createRouterInterfaces(
+    std::vector<P4RouterInterfaceEntry> &router_intf_entries)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(router_intf_entries.size());
+    std::vector<sai_status_t> object_statuses(router_intf_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    std::vector<std::vector<sai_attribute_t>> attr_lists(router_intf_entries.size());
+    std::vector<bool> queued(router_intf_entries.size(), false);
+    ObjectBulker<sai_router_interface_api_t> router_intf_bulker(sai_router_intfs_api, gSwitchId, gMaxBulkSize);
+
+    for (size_t i = 0; i < router_intf_entries.size(); ++i)
+    {
+        auto attrs_or = getSaiAttrs(router_intf_entries[i]);
+        if (!attrs_or.ok())
+        {
+            statuses[i] = attrs_or.status();
+            continue;
+        }
+        attr_lists[i] = *attrs_or;
+        router_intf_bulker.create_entry(&router_intf_entries[i].router_interface_oid, &object_statuses[i],
+                                        static_cast<uint32_t>(attr_lists[i].size()), attr_lists[i].data());
+        queued[i] = true;
+    }
+
+    router_intf_bulker.flush();
+
+    for (size_t i = 0; i < router_intf_entries.size(); ++i)
+    {
+        if (!queued[i])
+        {
+            continue;
+        }
+        const auto &router_intf_entry = router_intf_entries[i];
+        CHECK_ERROR_AND_LOG(object_statuses[i],
+                            "Failed to create router interface " << QuotedVar(router_intf_entry.router_interface_id));
+        if (object_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            addRouterInterface(
+                KeyGenerator::generateRouterInterfaceKey(router_intf_entry.router_interface_id), router_intf_entry);
+        }
+        else
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to create router interface " << QuotedVar(router_intf_entry.router_interface_id);
+        }
+    }
+
+    return statuses;
+}
+
+void RouterInterfaceManager::addRouterInterface(const std::string &router_intf_key,
+                                                const P4RouterInterfaceEntry &router_intf_entry)
+{
+    SWSS_LOG_ENTER();
+
     gPortsOrch->increasePortRefCount(router_intf_entry.port_name);
     gDirectory.get<VRFOrch *>()->increaseVrfRefCount(gVirtualRouterId);
 
     m_routerIntfTable[router_intf_key] = router_intf_entry;
     m_p4OidMapper->setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE, router_intf_key, router_intf_entry.router_interface_oid);
-    return ReturnCode();
 }
 
-ReturnCode RouterInterfaceManager::removeRouterInterface(const std::string &router_intf_key)
+ReturnCode RouterInterfaceManager::validateRouterInterfaceRemove(const std::string &router_intf_key)
 {
     SWSS_LOG_ENTER();
 
@@ -235,16 +307,69 @@ ReturnCode RouterInterfaceManager::removeRouterInterface(const std::string &rout
                              << " referenced by other objects (ref_count = " << ref_count << ")");
     }
 
+    return ReturnCode();
+}
+
+ReturnCode RouterInterfaceManager::removeRouterInterface(const std::string &router_intf_key)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateRouterInterfaceRemove(router_intf_key));
+    auto *router_intf_entry = getRouterInterfaceEntry(router_intf_key);
+
     CHECK_ERROR_AND_LOG_AND_RETURN(
         sai_router_intfs_api->remove_router_interface(router_intf_entry->router_interface_oid),
         "Failed to remove router interface " << QuotedVar(router_intf_entry->router_interface_id));
 
+    eraseRouterInterface(router_intf_key);
+    return ReturnCode();
+}
+
+std::vector<ReturnCode> RouterInterfaceManager::removeRouterInterfaces(
+    const std::vector<P4RouterInterfaceEntry> &router_intf_entries)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses(router_intf_entries.size());
+    std::vector<sai_status_t> object_statuses(router_intf_entries.size(), SAI_STATUS_NOT_EXECUTED);
+    ObjectBulker<sai_router_interface_api_t> router_intf_bulker(sai_router_intfs_api, gSwitchId, gMaxBulkSize);
+
+    for (size_t i = 0; i < router_intf_entries.size(); ++i)
+    {
+        router_intf_bulker.remove_entry(&object_statuses[i], router_intf_entries[i].router_interface_oid);
+    }
+
+    router_intf_bulker.flush();
+
+    for (size_t i = 0; i < router_intf_entries.size(); ++i)
+    {
+        const auto &router_intf_entry = router_intf_entries[i];
+        CHECK_ERROR_AND_LOG(object_statuses[i],
+                            "Failed to remove router interface " << QuotedVar(router_intf_entry.router_interface_id));
+        if (object_statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            eraseRouterInterface(KeyGenerator::generateRouterInterfaceKey(router_intf_entry.router_interface_id));
+        }
+        else
+        {
+            statuses[i] = ReturnCode(object_statuses[i])
+                          << "Failed to remove router interface " << QuotedVar(router_intf_entry.router_interface_id);
+        }
+    }
+
+    return statuses;
+}
+
+void RouterInterfaceManager::eraseRouterInterface(const std::string &router_intf_key)
+{
+    SWSS_LOG_ENTER();
+
+    auto *router_intf_entry = getRouterInterfaceEntry(router_intf_key);
     gPortsOrch->decreasePortRefCount(router_intf_entry->port_name);
     gDirectory.get<VRFOrch *>()->decreaseVrfRefCount(gVirtualRouterId);
 
     m_p4OidMapper->eraseOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE, router_intf_key);
     m_routerIntfTable.erase(router_intf_key);
-    return ReturnCode();
 }
 
 ReturnCode RouterInterfaceManager::setSourceMacAddress(P4RouterInterfaceEntry *router_intf_entry,
@@ -267,8 +392,7 @@ ReturnCode RouterInterfaceManager::setSourceMacAddress(P4RouterInterfaceEntry *r
     return ReturnCode();
 }
 
-ReturnCode RouterInterfaceManager::processAddRequest(const P4RouterInterfaceAppDbEntry &app_db_entry,
-                                                     const std::string &router_intf_key)
+ReturnCode RouterInterfaceManager::validateAddRequest(const P4RouterInterfaceAppDbEntry &app_db_entry)
 {
     SWSS_LOG_ENTER();
 
@@ -282,6 +406,16 @@ ReturnCode RouterInterfaceManager::processAddRequest(const P4RouterInterfaceAppD
                              << QuotedVar(app_db_entry.router_interface_id));
     }
 
+    return ReturnCode();
+}
+
+ReturnCode RouterInterfaceManager::processAddRequest(const P4RouterInterfaceAppDbEntry &app_db_entry,
+                                                     const std::string &router_intf_key)
+{
+    SWSS_LOG_ENTER();
+
+    RETURN_IF_ERROR(validateAddRequest(app_db_entry));
+
     P4RouterInterfaceEntry router_intf_entry(app_db_entry.router_interface_id, app_db_entry.port_name,
                                              app_db_entry.src_mac_address);
     auto status = createRouterInterface(router_intf_key, router_intf_entry);
@@ -375,6 +509,15 @@ void RouterInterfaceManager::drain()
 {
     SWSS_LOG_ENTER();
 
+    // Consecutive creations or removals are validated first and then
+    // programmed together with bulk SAI calls. An entry of another operation,
+    // or of a router interface that is already in the batch, programs the
+    // batch first.
+    std::vector<P4RouterInterfaceEntry> router_intf_list;
+    std::vector<swss::KeyOpFieldsValuesTuple> tuple_list;
+    std::unordered_set<std::string> router_intf_keys;
+    std::string batch_operation;
+
     for (const auto &key_op_fvs_tuple : m_entries)
     {
         std::string table_name;
@@ -408,15 +551,41 @@ void RouterInterfaceManager::drain()
         }
 
         const std::string router_intf_key = KeyGenerator::generateRouterInterfaceKey(app_db_entry.router_interface_id);
+        if (router_intf_keys.count(router_intf_key) != 0)
+        {
+            processEntries(batch_operation, router_intf_list, tuple_list);
+            router_intf_list.clear();
+            tuple_list.clear();
+            router_intf_keys.clear();
+        }
 
         const std::string &operation = kfvOp(key_op_fvs_tuple);
+        auto *router_intf_entry = getRouterInterfaceEntry(router_intf_key);
+        bool batched = (operation == SET_COMMAND && router_intf_entry == nullptr) || operation == DEL_COMMAND;
+        if (!tuple_list.empty() && (!batched || operation != batch_operation))
+        {
+            processEntries(batch_operation, router_intf_list, tuple_list);
+            router_intf_list.clear();
+            tuple_list.clear();
+            router_intf_keys.clear();
+        }
+
         if (operation == SET_COMMAND)
         {
-            auto *router_intf_entry = getRouterInterfaceEntry(router_intf_key);
             if (router_intf_entry == nullptr)
             {
                 // Create router interface
-                status = processAddRequest(app_db_entry, router_intf_key);
+                P4RouterInterfaceEntry new_router_intf_entry(app_db_entry.router_interface_id, app_db_entry.port_name,
+                                                             app_db_entry.src_mac_address);
+                status = validateAddRequest(app_db_entry);
+                if (status.ok())
+                {
+                    status = validateRouterInterfaceCreate(router_intf_key, new_router_intf_entry);
+                }
+                if (status.ok())
+                {
+                    router_intf_list.push_back(new_router_intf_entry);
+                }
             }
             else
             {
@@ -427,19 +596,74 @@ void RouterInterfaceManager::drain()
         else if (operation == DEL_COMMAND)
         {
             // Delete router interface
-            status = processDeleteRequest(router_intf_key);
+            status = validateRouterInterfaceRemove(router_intf_key);
+            if (status.ok())
+            {
+                router_intf_list.push_back(*router_intf_entry);
+            }
         }
         else
         {
             status = ReturnCode(StatusCode::SWSS_RC_INVALID_PARAM) << "Unknown operation type " << QuotedVar(operation);
             SWSS_LOG_ERROR("%s", status.message().c_str());
         }
+
+        if (batched && status.ok())
+        {
+            batch_operation = operation;
+            tuple_list.push_back(key_op_fvs_tuple);
+            router_intf_keys.insert(router_intf_key);
+            continue;
+        }
         m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(key_op_fvs_tuple), kfvFieldsValues(key_op_fvs_tuple), status,
                              /*replace=*/true);
     }
+    if (!tuple_list.empty())
+    {
+        processEntries(batch_operation, router_intf_list, tuple_list);
+    }
     m_entries.clear();
 }
 
+void RouterInterfaceManager::processEntries(const std::string &operation,
+                                            std::vector<P4RouterInterfaceEntry> &router_intf_list,
+                                            const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list)
+{
+    SWSS_LOG_ENTER();
+
+    std::vector<ReturnCode> statuses;
+    if (router_intf_list.size() == 1)
+    {
+        // A single router interface is programmed with the per object SAI call.
+        const auto router_intf_key =
+            KeyGenerator::generateRouterInterfaceKey(router_intf_list[0].router_interface_id);
+        auto status = (operation == SET_COMMAND) ? createRouterInterface(router_intf_key, router_intf_list[0])
+                                                 : removeRouterInterface(router_intf_key);
+        statuses.push_back(status);
+    }
+    else if (operation == SET_COMMAND)
+    {
+        statuses = createRouterInterfaces(router_intf_list);
+    }
+    else
+    {
+        statuses = removeRouterInterfaces(router_intf_list);
+    }
+
+    for (size_t i = 0; i < tuple_list.size(); ++i)
+    {
+        if (!statuses[i].ok())
+        {
+            SWSS_LOG_ERROR("Failed to %s router interface with key %s",
+                           operation == SET_COMMAND ? "create" : "remove",
+                           QuotedVar(KeyGenerator::generateRouterInterfaceKey(router_intf_list[i].router_interface_id))
+                               .c_str());
+        }
+        m_publisher->publish(APP_P4RT_TABLE_NAME, kfvKey(tuple_list[i]), kfvFieldsValues(tuple_list[i]), statuses[i],
+                             /*replace=*/true);
+    }
+}
+
 std::string RouterInterfaceManager::verifyState(const std::string &key, const std::vector<swss::FieldValueTuple> &tuple)
 {
     SWSS_LOG_ENTER();
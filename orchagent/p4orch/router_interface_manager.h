@@ -59,9 +59,19 @@ class RouterInterfaceManager : public ObjectManagerInterface
     ReturnCodeOr<P4RouterInterfaceAppDbEntry> deserializeRouterIntfEntry(
         const std::string &key, const std::vector<swss::FieldValueTuple> &attributes);
     P4RouterInterfaceEntry *getRouterInterfaceEntry(const std::string &router_intf_key);
+    ReturnCode validateRouterInterfaceCreate(const std::string &router_intf_key,
+                                             const P4RouterInterfaceEntry &router_intf_entry);
     ReturnCode createRouterInterface(const std::string &router_intf_key, P4RouterInterfaceEntry &router_intf_entry);
+    std::vector<ReturnCode> createRouterInterfaces(std::vector<P4RouterInterfaceEntry> &router_intf_entries);
+    void addRouterInterface(const std::string &router_intf_key, const P4RouterInterfaceEntry &router_intf_entry);
+    ReturnCode validateRouterInterfaceRemove(const std::string &router_intf_key);
     ReturnCode removeRouterInterface(const std::string &router_intf_key);
+    std::vector<ReturnCode> removeRouterInterfaces(const std::vector<P4RouterInterfaceEntry> &router_intf_entries);
+    void eraseRouterInterface(const std::string &router_intf_key);
     ReturnCode setSourceMacAddress(P4RouterInterfaceEntry *router_intf_entry, const swss::MacAddress &mac_address);
+    void processEntries(const std::string &operation, std::vector<P4RouterInterfaceEntry> &router_intf_list,
+                        const std::vector<swss::KeyOpFieldsValuesTuple> &tuple_list);
+    ReturnCode validateAddRequest(const P4RouterInterfaceAppDbEntry &app_db_entry);
     ReturnCode processAddRequest(const P4RouterInterfaceAppDbEntry &app_db_entry, const std::string &router_intf_key);
     ReturnCode processUpdateRequest(const P4RouterInterfaceAppDbEntry &app_db_entry,
                                     P4RouterInterfaceEntry *router_intf_entry);
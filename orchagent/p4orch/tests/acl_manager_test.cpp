@@ -1,6 +1,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <nlohmann/json.hpp>
@@ -10,7 +11,9 @@
 #include "acl_table_manager.h"
 #include "acl_util.h"
 #include "acltable.h"
+#include "mock_response_publisher.h"
 #include "mock_sai_acl.h"
+#include "mock_sai_bulk_object.h"
 #include "mock_sai_hostif.h"
 #include "mock_sai_policer.h"
 #include "mock_sai_serialize.h"
@@ -49,6 +52,7 @@ extern sai_object_id_t kMirrorSessionOid1;
 extern char *gMirrorSession2;
 extern sai_object_id_t kMirrorSessionOid2;
 extern bool gIsNatSupported;
+extern std::unique_ptr<MockResponsePublisher> gMockResponsePublisher;
 
 namespace p4orch
 {
@@ -78,6 +82,7 @@ constexpr sai_object_id_t kAclIngressRuleOid2 = 1002;
 constexpr sai_object_id_t kAclMeterOid1 = 2001;
 constexpr sai_object_id_t kAclMeterOid2 = 2002;
 constexpr sai_object_id_t kAclCounterOid1 = 3001;
+constexpr sai_object_id_t kAclCounterOid2 = 3002;
 constexpr sai_object_id_t kUdfGroupOid1 = 4001;
 constexpr sai_object_id_t kUdfMatchOid1 = 5001;
 constexpr sai_object_id_t kUdfOid1 = 6001;
@@ -729,6 +734,29 @@ P4AclTableDefinitionAppDbEntry getDefaultAclTableDefAppDbEntry()
     return app_db_entry;
 }
 
+// Returns an action for a bulk create call, setting the object IDs and
+// statuses of the objects.
+std::function<sai_status_t(sai_object_id_t, sai_object_type_t, uint32_t, const uint32_t *, const sai_attribute_t **,
+                           sai_bulk_op_error_mode_t, sai_object_id_t *, sai_status_t *)>
+BulkCreateObjects(const std::vector<sai_object_id_t> &oids, const std::vector<sai_status_t> &statuses)
+{
+    return [oids, statuses](sai_object_id_t, sai_object_type_t, uint32_t object_count, const uint32_t *,
+                            const sai_attribute_t **, sai_bulk_op_error_mode_t, sai_object_id_t *object_id,
+                            sai_status_t *object_statuses) {
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_id[i] = oids[i];
+            object_statuses[i] = statuses[i];
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    };
+}
+
 std::vector<swss::FieldValueTuple> getDefaultRuleFieldValueTuples()
 {
     std::vector<swss::FieldValueTuple> attributes;
@@ -820,6 +848,7 @@ class AclManagerTest : public ::testing::Test
     void setUpMockApi()
     {
         mock_sai_acl = &mock_sai_acl_;
+        mock_sai_bulk_object = &mock_sai_bulk_object_;
         mock_sai_serialize = &mock_sai_serialize_;
         mock_sai_policer = &mock_sai_policer_;
         mock_sai_hostif = &mock_sai_hostif_;
@@ -1062,6 +1091,7 @@ class AclManagerTest : public ::testing::Test
     }
 
     StrictMock<MockSaiAcl> mock_sai_acl_;
+    StrictMock<MockSaiBulkObject> mock_sai_bulk_object_;
     StrictMock<MockSaiSerialize> mock_sai_serialize_;
     StrictMock<MockSaiPolicer> mock_sai_policer_;
     StrictMock<MockSaiHostif> mock_sai_hostif_;
@@ -2398,6 +2428,113 @@ TEST_F(AclManagerTest, DrainRuleTuplesToProcessSetDelRequestSucceeds)
     EXPECT_EQ(nullptr, GetAclRule(kAclIngressTableName, acl_rule_key));
 }
 
+TEST_F(AclManagerTest, DrainRuleTuplesToProcessMultipleSetRequestsUsesBulkSai)
+{
+    ASSERT_NO_FATAL_FAILURE(AddDefaultIngressTable());
+    // The status of each rule is published through the P4Orch response publisher.
+    gMockResponsePublisher = std::make_unique<MockResponsePublisher>();
+    const auto &rule_tuple_key1 = std::string(kAclIngressTableName) + kTableKeyDelimiter +
+                                  "{\"match/ether_type\":\"0x0800\",\"match/"
+                                  "ipv6_dst\":\"fdf8:f53b:82e4::53 & "
+                                  "fdf8:f53b:82e4::53\",\"priority\":15}";
+    const auto &rule_tuple_key2 = std::string(kAclIngressTableName) + kTableKeyDelimiter +
+                                  "{\"match/ether_type\":\"0x0800\",\"match/"
+                                  "ipv6_dst\":\"fdf8:f53b:82e4::53 & "
+                                  "fdf8:f53b:82e4::53\",\"priority\":16}";
+    EnqueueRuleTuple(std::string(kAclIngressTableName),
+                     swss::KeyOpFieldsValuesTuple({rule_tuple_key1, SET_COMMAND, getDefaultRuleFieldValueTuples()}));
+    EnqueueRuleTuple(std::string(kAclIngressTableName),
+                     swss::KeyOpFieldsValuesTuple({rule_tuple_key2, SET_COMMAND, getDefaultRuleFieldValueTuples()}));
+
+    // Meters are created per rule, counters and entries in one bulk call each,
+    // in the order of the rules.
+    EXPECT_CALL(mock_sai_policer_, create_policer(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<0>(kAclMeterOid1), Return(SAI_STATUS_SUCCESS)))
+        .WillOnce(DoAll(SetArgPointee<0>(kAclMeterOid2), Return(SAI_STATUS_SUCCESS)));
+    EXPECT_CALL(mock_sai_bulk_object_,
+                create_objects(Eq(gSwitchId), Eq(SAI_OBJECT_TYPE_ACL_COUNTER), Eq(2u), _, _, _, _, _))
+        .WillOnce(Invoke(BulkCreateObjects({kAclCounterOid1, kAclCounterOid2},
+                                           {SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS})));
+    EXPECT_CALL(mock_sai_bulk_object_,
+                create_objects(Eq(gSwitchId), Eq(SAI_OBJECT_TYPE_ACL_ENTRY), Eq(2u), _, _, _, _, _))
+        .WillOnce(Invoke(BulkCreateObjects({kAclIngressRuleOid1, kAclIngressRuleOid2},
+                                           {SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS})));
+    EXPECT_CALL(*gMockResponsePublisher, publish(Eq(APP_P4RT_TABLE_NAME), Eq(rule_tuple_key1), _,
+                                                 Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    EXPECT_CALL(*gMockResponsePublisher, publish(Eq(APP_P4RT_TABLE_NAME), Eq(rule_tuple_key2), _,
+                                                 Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    DrainRuleTuples();
+    gMockResponsePublisher.reset();
+
+    const auto &acl_rule_key1 = "match/ether_type=0x0800:match/ipv6_dst=fdf8:f53b:82e4::53 & "
+                                "fdf8:f53b:82e4::53:priority=15";
+    const auto &acl_rule_key2 = "match/ether_type=0x0800:match/ipv6_dst=fdf8:f53b:82e4::53 & "
+                                "fdf8:f53b:82e4::53:priority=16";
+    const auto *acl_rule = GetAclRule(kAclIngressTableName, acl_rule_key1);
+    ASSERT_NE(nullptr, acl_rule);
+    EXPECT_EQ(kAclIngressRuleOid1, acl_rule->acl_entry_oid);
+    EXPECT_EQ(kAclCounterOid1, acl_rule->counter.counter_oid);
+    EXPECT_EQ(kAclMeterOid1, acl_rule->meter.meter_oid);
+    acl_rule = GetAclRule(kAclIngressTableName, acl_rule_key2);
+    ASSERT_NE(nullptr, acl_rule);
+    EXPECT_EQ(kAclIngressRuleOid2, acl_rule->acl_entry_oid);
+    EXPECT_EQ(kAclCounterOid2, acl_rule->counter.counter_oid);
+    EXPECT_EQ(kAclMeterOid2, acl_rule->meter.meter_oid);
+    EXPECT_EQ(rule_tuple_key2, acl_rule->db_key);
+}
+
+TEST_F(AclManagerTest, DrainRuleTuplesToProcessMultipleSetRequestsRollsBackFailedRule)
+{
+    ASSERT_NO_FATAL_FAILURE(AddDefaultIngressTable());
+    // The status of each rule is published through the P4Orch response publisher.
+    gMockResponsePublisher = std::make_unique<MockResponsePublisher>();
+    const auto &rule_tuple_key1 = std::string(kAclIngressTableName) + kTableKeyDelimiter +
+                                  "{\"match/ether_type\":\"0x0800\",\"match/"
+                                  "ipv6_dst\":\"fdf8:f53b:82e4::53 & "
+                                  "fdf8:f53b:82e4::53\",\"priority\":15}";
+    const auto &rule_tuple_key2 = std::string(kAclIngressTableName) + kTableKeyDelimiter +
+                                  "{\"match/ether_type\":\"0x0800\",\"match/"
+                                  "ipv6_dst\":\"fdf8:f53b:82e4::53 & "
+                                  "fdf8:f53b:82e4::53\",\"priority\":16}";
+    EnqueueRuleTuple(std::string(kAclIngressTableName),
+                     swss::KeyOpFieldsValuesTuple({rule_tuple_key1, SET_COMMAND, getDefaultRuleFieldValueTuples()}));
+    EnqueueRuleTuple(std::string(kAclIngressTableName),
+                     swss::KeyOpFieldsValuesTuple({rule_tuple_key2, SET_COMMAND, getDefaultRuleFieldValueTuples()}));
+
+    // The second ACL entry fails, its meter and counter are removed.
+    EXPECT_CALL(mock_sai_policer_, create_policer(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<0>(kAclMeterOid1), Return(SAI_STATUS_SUCCESS)))
+        .WillOnce(DoAll(SetArgPointee<0>(kAclMeterOid2), Return(SAI_STATUS_SUCCESS)));
+    EXPECT_CALL(mock_sai_bulk_object_,
+                create_objects(Eq(gSwitchId), Eq(SAI_OBJECT_TYPE_ACL_COUNTER), Eq(2u), _, _, _, _, _))
+        .WillOnce(Invoke(BulkCreateObjects({kAclCounterOid1, kAclCounterOid2},
+                                           {SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS})));
+    EXPECT_CALL(mock_sai_bulk_object_,
+                create_objects(Eq(gSwitchId), Eq(SAI_OBJECT_TYPE_ACL_ENTRY), Eq(2u), _, _, _, _, _))
+        .WillOnce(Invoke(BulkCreateObjects({kAclIngressRuleOid1, SAI_NULL_OBJECT_ID},
+                                           {SAI_STATUS_SUCCESS, SAI_STATUS_INSUFFICIENT_RESOURCES})));
+    EXPECT_CALL(mock_sai_policer_, remove_policer(Eq(kAclMeterOid2))).WillOnce(Return(SAI_STATUS_SUCCESS));
+    EXPECT_CALL(mock_sai_acl_, remove_acl_counter(Eq(kAclCounterOid2))).WillOnce(Return(SAI_STATUS_SUCCESS));
+    EXPECT_CALL(*gMockResponsePublisher, publish(Eq(APP_P4RT_TABLE_NAME), Eq(rule_tuple_key1), _,
+                                                 Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    EXPECT_CALL(*gMockResponsePublisher, publish(Eq(APP_P4RT_TABLE_NAME), Eq(rule_tuple_key2), _,
+                                                 Eq(StatusCode::SWSS_RC_FULL), Eq(true)));
+    DrainRuleTuples();
+    gMockResponsePublisher.reset();
+
+    const auto &acl_rule_key1 = "match/ether_type=0x0800:match/ipv6_dst=fdf8:f53b:82e4::53 & "
+                                "fdf8:f53b:82e4::53:priority=15";
+    const auto &acl_rule_key2 = "match/ether_type=0x0800:match/ipv6_dst=fdf8:f53b:82e4::53 & "
+                                "fdf8:f53b:82e4::53:priority=16";
+    const auto *acl_rule = GetAclRule(kAclIngressTableName, acl_rule_key1);
+    ASSERT_NE(nullptr, acl_rule);
+    EXPECT_EQ(kAclIngressRuleOid1, acl_rule->acl_entry_oid);
+    EXPECT_EQ(nullptr, GetAclRule(kAclIngressTableName, acl_rule_key2));
+    const auto &table_name_and_rule_key2 = std::string(kAclIngressTableName) + kTableKeyDelimiter + acl_rule_key2;
+    EXPECT_FALSE(p4_oid_mapper_->existsOID(SAI_OBJECT_TYPE_ACL_COUNTER, table_name_and_rule_key2));
+    EXPECT_FALSE(p4_oid_mapper_->existsOID(SAI_OBJECT_TYPE_POLICER, table_name_and_rule_key2));
+}
+
 TEST_F(AclManagerTest, DrainRuleTuplesToProcessSetRequestInvalidTableNameRuleKeyFails)
 {
     auto attributes = getDefaultRuleFieldValueTuples();
@@ -16,6 +16,10 @@ void FlexCounterOrch::doTask(Consumer &consumer)
 {
 }
 
+void FlexCounterOrch::doTask(swss::NotificationConsumer &consumer)
+{
+}
+
 bool FlexCounterOrch::getPortCountersState() const
 {
     return true;
@@ -0,0 +1,19 @@
+#include "mock_sai_bulk_object.h"
+
+MockSaiBulkObject *mock_sai_bulk_object;
+
+sai_status_t sai_bulk_object_create(_In_ sai_object_id_t switch_id, _In_ sai_object_type_t object_type,
+                                    _In_ uint32_t object_count, _In_ const uint32_t *attr_count,
+                                    _In_ const sai_attribute_t **attr_list, _In_ sai_bulk_op_error_mode_t mode,
+                                    _Out_ sai_object_id_t *object_id, _Out_ sai_status_t *object_statuses)
+{
+    return mock_sai_bulk_object->create_objects(switch_id, object_type, object_count, attr_count, attr_list, mode,
+                                                object_id, object_statuses);
+}
+
+sai_status_t sai_bulk_object_remove(_In_ sai_object_type_t object_type, _In_ uint32_t object_count,
+                                    _In_ const sai_object_id_t *object_id, _In_ sai_bulk_op_error_mode_t mode,
+                                    _Out_ sai_status_t *object_statuses)
+{
+    return mock_sai_bulk_object->remove_objects(object_type, object_count, object_id, mode, object_statuses);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <gmock/gmock.h>
+
+extern "C"
+{
+#include "sai.h"
+}
+
+// Mock Class mapping methods to the generic SAI bulk object functions, which
+// the tests define in place of the ones of libsairedis.
+class MockSaiBulkObject
+{
+  public:
+    MOCK_METHOD8(create_objects,
+                 sai_status_t(_In_ sai_object_id_t switch_id, _In_ sai_object_type_t object_type,
+                              _In_ uint32_t object_count, _In_ const uint32_t *attr_count,
+                              _In_ const sai_attribute_t **attr_list, _In_ sai_bulk_op_error_mode_t mode,
+                              _Out_ sai_object_id_t *object_id, _Out_ sai_status_t *object_statuses));
+
+    MOCK_METHOD5(remove_objects,
+                 sai_status_t(_In_ sai_object_type_t object_type, _In_ uint32_t object_count,
+                              _In_ const sai_object_id_t *object_id, _In_ sai_bulk_op_error_mode_t mode,
+                              _Out_ sai_status_t *object_statuses));
+};
+
+// Note that before the bulk functions are used, mock_sai_bulk_object must be
+// initialized to point to an instance of MockSaiBulkObject.
+extern MockSaiBulkObject *mock_sai_bulk_object;
@@ -17,8 +17,11 @@
 using ::p4orch::kTableKeyDelimiter;
 
 using ::testing::_;
+using ::testing::DoAll;
 using ::testing::Eq;
+using ::testing::Invoke;
 using ::testing::Return;
+using ::testing::SetArrayArgument;
 using ::testing::StrictMock;
 using ::testing::Truly;
 
@@ -828,6 +831,106 @@ TEST_F(NeighborManagerTest, DrainInvalidOperation)
     ValidateNeighborEntryNotPresent(neighbor_entry, /*check_ref_count=*/true);
 }
 
+TEST_F(NeighborManagerTest, DrainMultipleCreateAndDeleteRequestsUseBulkSai)
+{
+    ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                                      KeyGenerator::generateRouterInterfaceKey(kRouterInterfaceId1),
+                                      kRouterInterfaceOid1));
+
+    const std::string appl_db_key1 = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) + kTableKeyDelimiter +
+                                     CreateNeighborAppDbKey(kRouterInterfaceId1, kNeighborId1);
+    const std::string appl_db_key2 = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) + kTableKeyDelimiter +
+                                     CreateNeighborAppDbKey(kRouterInterfaceId1, kNeighborId2);
+
+    // Enqueue entries for create operation, both neighbors are created by a
+    // single bulk call.
+    Enqueue(swss::KeyOpFieldsValuesTuple(
+        appl_db_key1, SET_COMMAND,
+        {swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress1.to_string()}}));
+    Enqueue(swss::KeyOpFieldsValuesTuple(
+        appl_db_key2, SET_COMMAND,
+        {swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress2.to_string()}}));
+
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entries(Eq(2), _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key1), _, Eq(StatusCode::SWSS_RC_SUCCESS),
+                                    Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key2), _, Eq(StatusCode::SWSS_RC_SUCCESS),
+                                    Eq(true)));
+    Drain();
+
+    P4NeighborEntry neighbor_entry1(kRouterInterfaceId1, kNeighborId1, kMacAddress1);
+    neighbor_entry1.neigh_entry.switch_id = gSwitchId;
+    copy(neighbor_entry1.neigh_entry.ip_address, neighbor_entry1.neighbor_id);
+    neighbor_entry1.neigh_entry.rif_id = kRouterInterfaceOid1;
+    ValidateNeighborEntry(neighbor_entry1, /*router_intf_ref_count=*/2);
+
+    P4NeighborEntry neighbor_entry2(kRouterInterfaceId1, kNeighborId2, kMacAddress2);
+    neighbor_entry2.neigh_entry.switch_id = gSwitchId;
+    copy(neighbor_entry2.neigh_entry.ip_address, neighbor_entry2.neighbor_id);
+    neighbor_entry2.neigh_entry.rif_id = kRouterInterfaceOid1;
+    ValidateNeighborEntry(neighbor_entry2, /*router_intf_ref_count=*/2);
+
+    // Enqueue entries for delete operation.
+    std::vector<swss::FieldValueTuple> attributes;
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key1, DEL_COMMAND, attributes));
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key2, DEL_COMMAND, attributes));
+
+    EXPECT_CALL(mock_sai_neighbor_, remove_neighbor_entries(Eq(2), _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
+    Drain();
+
+    ValidateNeighborEntryNotPresent(neighbor_entry1, /*check_ref_count=*/true);
+    ValidateNeighborEntryNotPresent(neighbor_entry2, /*check_ref_count=*/true);
+}
+
+TEST_F(NeighborManagerTest, DrainMultipleCreateRequestsPublishStatusPerEntry)
+{
+    ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                                      KeyGenerator::generateRouterInterfaceKey(kRouterInterfaceId1),
+                                      kRouterInterfaceOid1));
+
+    const std::string appl_db_key1 = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) + kTableKeyDelimiter +
+                                     CreateNeighborAppDbKey(kRouterInterfaceId1, kNeighborId1);
+    const std::string appl_db_key2 = std::string(APP_P4RT_NEIGHBOR_TABLE_NAME) + kTableKeyDelimiter +
+                                     CreateNeighborAppDbKey(kRouterInterfaceId1, kNeighborId2);
+    Enqueue(swss::KeyOpFieldsValuesTuple(
+        appl_db_key1, SET_COMMAND,
+        {swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress1.to_string()}}));
+    Enqueue(swss::KeyOpFieldsValuesTuple(
+        appl_db_key2, SET_COMMAND,
+        {swss::FieldValueTuple{prependParamField(p4orch::kDstMac), kMacAddress2.to_string()}}));
+
+    // The IPv6 neighbor fails in the bulk call.
+    EXPECT_CALL(mock_sai_neighbor_, create_neighbor_entries(Eq(2), _, _, _, _, _))
+        .WillOnce(Invoke([](uint32_t object_count, const sai_neighbor_entry_t *neighbor_entry,
+                            const uint32_t *attr_count, const sai_attribute_t **attr_list,
+                            sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses) {
+            for (uint32_t i = 0; i < object_count; i++)
+            {
+                object_statuses[i] = neighbor_entry[i].ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV6
+                                         ? SAI_STATUS_FAILURE
+                                         : SAI_STATUS_SUCCESS;
+            }
+            return SAI_STATUS_FAILURE;
+        }));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key1), _, Eq(StatusCode::SWSS_RC_SUCCESS),
+                                    Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key2), _, Eq(StatusCode::SWSS_RC_UNKNOWN),
+                                    Eq(true)));
+    Drain();
+
+    P4NeighborEntry neighbor_entry1(kRouterInterfaceId1, kNeighborId1, kMacAddress1);
+    neighbor_entry1.neigh_entry.switch_id = gSwitchId;
+    copy(neighbor_entry1.neigh_entry.ip_address, neighbor_entry1.neighbor_id);
+    neighbor_entry1.neigh_entry.rif_id = kRouterInterfaceOid1;
+    ValidateNeighborEntry(neighbor_entry1, /*router_intf_ref_count=*/1);
+
+    P4NeighborEntry neighbor_entry2(kRouterInterfaceId1, kNeighborId2, kMacAddress2);
+    ValidateNeighborEntryNotPresent(neighbor_entry2, /*check_ref_count=*/true, /*router_intf_ref_count=*/1);
+}
+
 TEST_F(NeighborManagerTest, VerifyStateTest)
 {
     P4NeighborEntry neighbor_entry(kRouterInterfaceId1, kNeighborId1, kMacAddress1);
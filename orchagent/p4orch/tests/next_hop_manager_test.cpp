@@ -3,7 +3,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <chrono>
 #include <functional>
+#include <iostream>
 #include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_map>
@@ -28,8 +30,10 @@ using ::p4orch::kTableKeyDelimiter;
 using ::testing::_;
 using ::testing::DoAll;
 using ::testing::Eq;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgPointee;
+using ::testing::SetArrayArgument;
 using ::testing::StrictMock;
 using ::testing::Truly;
 
@@ -48,6 +52,7 @@ namespace
 constexpr char *kNextHopId = "8";
 constexpr char *kNextHopP4AppDbKey = R"({"match/nexthop_id":"8"})";
 constexpr sai_object_id_t kNextHopOid = 101;
+constexpr sai_object_id_t kNextHopOid2 = 103;
 constexpr char *kTunnelNextHopId = "tunnel-nexthop-1";
 constexpr char *kTunnelNextHopP4AppDbKey = R"({"match/nexthop_id":"tunnel-nexthop-1"})";
 constexpr sai_object_id_t kTunnelNextHopOid = 102;
@@ -75,6 +80,13 @@ const P4NextHopAppDbEntry kP4NextHopAppDbEntry2{/*next_hop_id=*/kNextHopId,
                                                 /*neighbor_id=*/swss::IpAddress(kNeighborId2),
                                                 /*action_str=*/"set_ip_nexthop"};
 
+// APP DB entry of a second next hop, for bulk requests.
+const P4NextHopAppDbEntry kP4NextHopAppDbEntry4{/*next_hop_id=*/"9",
+                                                /*router_interface_id=*/kRouterInterfaceId2,
+                                                /*gre_tunnel_id=*/"",
+                                                /*neighbor_id=*/swss::IpAddress(kNeighborId2),
+                                                /*action_str=*/"set_ip_nexthop"};
+
 // APP DB entries for Delete request.
 const P4NextHopAppDbEntry kP4NextHopAppDbEntry3{/*next_hop_id=*/kNextHopId,
                                                 /*router_interface_id=*/"",
@@ -109,6 +121,22 @@ const P4GreTunnelEntry kP4TunnelEntry2(
     /*encap_dst_ip=*/swss::IpAddress(kNeighborId2),
     /*neighbor_id=*/swss::IpAddress(kNeighborId2));
 
+swss::KeyOpFieldsValuesTuple CreateNextHopKeyOpFieldsValuesTuple(const P4NextHopAppDbEntry &app_entry,
+                                                                 const std::string &op)
+{
+    nlohmann::json j;
+    j[prependMatchField(p4orch::kNexthopId)] = app_entry.next_hop_id;
+    std::vector<swss::FieldValueTuple> fvs;
+    if (op == SET_COMMAND)
+    {
+        fvs = {{p4orch::kAction, p4orch::kSetIpNexthop},
+               {prependParamField(p4orch::kNeighborId), app_entry.neighbor_id.to_string()},
+               {prependParamField(p4orch::kRouterInterfaceId), app_entry.router_interface_id}};
+    }
+    return swss::KeyOpFieldsValuesTuple(std::string(APP_P4RT_NEXTHOP_TABLE_NAME) + kTableKeyDelimiter + j.dump(), op,
+                                        fvs);
+}
+
 std::unordered_map<sai_attr_id_t, sai_attribute_value_t> CreateAttributeListForNextHopObject(
     const P4NextHopAppDbEntry &app_entry, const sai_object_id_t &oid,
     const swss::IpAddress &neighbor_id = swss::IpAddress("0.0.0.0"))
@@ -1023,6 +1051,141 @@ TEST_F(NextHopManagerTest, DrainDeleteRequestShouldSucceedForExistingNextHop)
     EXPECT_TRUE(ValidateRefCnt(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key, 0));
 }
 
+TEST_F(NextHopManagerTest, DrainMultipleCreateAndDeleteRequestsShouldUseBulkSai)
+{
+    ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry1, kRouterInterfaceOid1));
+    ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry4, kRouterInterfaceOid2));
+    auto key_op_fvs_1 = CreateNextHopKeyOpFieldsValuesTuple(kP4NextHopAppDbEntry1, SET_COMMAND);
+    auto key_op_fvs_2 = CreateNextHopKeyOpFieldsValuesTuple(kP4NextHopAppDbEntry4, SET_COMMAND);
+    Enqueue(key_op_fvs_1);
+    Enqueue(key_op_fvs_2);
+
+    // Both next hops are created by a single bulk call.
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid, kNextHopOid2};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_SUCCESS};
+    EXPECT_CALL(mock_sai_next_hop_, create_next_hops(Eq(gSwitchId), Eq(2), _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(kfvKey(key_op_fvs_1)), _,
+                                    Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(kfvKey(key_op_fvs_2)), _,
+                                    Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    Drain();
+
+    EXPECT_TRUE(ValidateNextHopEntryAdd(kP4NextHopAppDbEntry1, kNextHopOid));
+    EXPECT_TRUE(ValidateNextHopEntryAdd(kP4NextHopAppDbEntry4, kNextHopOid2));
+
+    // Both next hops are removed by a single bulk call.
+    Enqueue(CreateNextHopKeyOpFieldsValuesTuple(kP4NextHopAppDbEntry1, DEL_COMMAND));
+    Enqueue(CreateNextHopKeyOpFieldsValuesTuple(kP4NextHopAppDbEntry4, DEL_COMMAND));
+    EXPECT_CALL(mock_sai_next_hop_, remove_next_hops(Eq(2), _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<3>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_SUCCESS)));
+    Drain();
+
+    EXPECT_EQ(GetNextHopEntry(KeyGenerator::generateNextHopKey(kP4NextHopAppDbEntry1.next_hop_id)), nullptr);
+    EXPECT_EQ(GetNextHopEntry(KeyGenerator::generateNextHopKey(kP4NextHopAppDbEntry4.next_hop_id)), nullptr);
+    const std::string neighbor_key =
+        KeyGenerator::generateNeighborKey(kP4NextHopAppDbEntry4.router_interface_id, kP4NextHopAppDbEntry4.neighbor_id);
+    EXPECT_TRUE(ValidateRefCnt(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key, 0));
+}
+
+TEST_F(NextHopManagerTest, DrainMultipleCreateRequestsShouldPublishStatusPerEntry)
+{
+    ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry1, kRouterInterfaceOid1));
+    ASSERT_TRUE(ResolveNextHopEntryDependency(kP4NextHopAppDbEntry4, kRouterInterfaceOid2));
+    auto key_op_fvs_1 = CreateNextHopKeyOpFieldsValuesTuple(kP4NextHopAppDbEntry1, SET_COMMAND);
+    auto key_op_fvs_2 = CreateNextHopKeyOpFieldsValuesTuple(kP4NextHopAppDbEntry4, SET_COMMAND);
+    Enqueue(key_op_fvs_1);
+    Enqueue(key_op_fvs_2);
+
+    std::vector<sai_object_id_t> exp_oids{kNextHopOid, SAI_NULL_OBJECT_ID};
+    std::vector<sai_status_t> exp_status{SAI_STATUS_SUCCESS, SAI_STATUS_FAILURE};
+    EXPECT_CALL(mock_sai_next_hop_, create_next_hops(Eq(gSwitchId), Eq(2), _, _, _, _, _))
+        .WillOnce(DoAll(SetArrayArgument<5>(exp_oids.begin(), exp_oids.end()),
+                        SetArrayArgument<6>(exp_status.begin(), exp_status.end()), Return(SAI_STATUS_FAILURE)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(kfvKey(key_op_fvs_1)), _,
+                                    Eq(StatusCode::SWSS_RC_SUCCESS), Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(kfvKey(key_op_fvs_2)), _,
+                                    Eq(StatusCode::SWSS_RC_UNKNOWN), Eq(true)));
+    Drain();
+
+    // Only the failed next hop is not created.
+    EXPECT_TRUE(ValidateNextHopEntryAdd(kP4NextHopAppDbEntry1, kNextHopOid));
+    EXPECT_EQ(GetNextHopEntry(KeyGenerator::generateNextHopKey(kP4NextHopAppDbEntry4.next_hop_id)), nullptr);
+    const std::string neighbor_key =
+        KeyGenerator::generateNeighborKey(kP4NextHopAppDbEntry4.router_interface_id, kP4NextHopAppDbEntry4.neighbor_id);
+    EXPECT_TRUE(ValidateRefCnt(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY, neighbor_key, 0));
+}
+
+// Reports the next hop creation and removal rate of the bulk drain.
+// Run with --gtest_also_run_disabled_tests --gtest_filter=*NextHop_Bulk_Benchmark*
+TEST_F(NextHopManagerTest, DISABLED_NextHop_Bulk_Benchmark)
+{
+    const size_t next_hop_count = 10000;
+
+    ASSERT_TRUE(p4_oid_mapper_.setOID(SAI_OBJECT_TYPE_ROUTER_INTERFACE,
+                                      KeyGenerator::generateRouterInterfaceKey(kRouterInterfaceId1),
+                                      kRouterInterfaceOid1));
+    std::vector<P4NextHopAppDbEntry> app_db_entries;
+    for (size_t i = 0; i < next_hop_count; i++)
+    {
+        swss::IpAddress neighbor_id("10." + std::to_string((i >> 16) & 0xff) + "." + std::to_string((i >> 8) & 0xff) +
+                                    "." + std::to_string(i & 0xff));
+        app_db_entries.push_back(P4NextHopAppDbEntry{/*next_hop_id=*/"nexthop-" + std::to_string(i),
+                                                     /*router_interface_id=*/kRouterInterfaceId1,
+                                                     /*gre_tunnel_id=*/"",
+                                                     /*neighbor_id=*/neighbor_id,
+                                                     /*action_str=*/"set_ip_nexthop"});
+        ASSERT_TRUE(p4_oid_mapper_.setDummyOID(SAI_OBJECT_TYPE_NEIGHBOR_ENTRY,
+                                               KeyGenerator::generateNeighborKey(kRouterInterfaceId1, neighbor_id)));
+    }
+
+    sai_object_id_t next_oid = 0x1000;
+    EXPECT_CALL(mock_sai_next_hop_, create_next_hops(_, _, _, _, _, _, _))
+        .WillRepeatedly(Invoke([&next_oid](sai_object_id_t switch_id, uint32_t object_count, const uint32_t *attr_count,
+                                           const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+                                           sai_object_id_t *object_id, sai_status_t *object_statuses) {
+            for (uint32_t i = 0; i < object_count; i++)
+            {
+                object_id[i] = next_oid++;
+                object_statuses[i] = SAI_STATUS_SUCCESS;
+            }
+            return SAI_STATUS_SUCCESS;
+        }));
+    EXPECT_CALL(mock_sai_next_hop_, remove_next_hops(_, _, _, _))
+        .WillRepeatedly(Invoke([](uint32_t object_count, const sai_object_id_t *object_id,
+                                  sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses) {
+            for (uint32_t i = 0; i < object_count; i++)
+            {
+                object_statuses[i] = SAI_STATUS_SUCCESS;
+            }
+            return SAI_STATUS_SUCCESS;
+        }));
+    EXPECT_CALL(publisher_, publish(_, _, _, _, _)).WillRepeatedly(Return());
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &app_db_entry : app_db_entries)
+    {
+        Enqueue(CreateNextHopKeyOpFieldsValuesTuple(app_db_entry, SET_COMMAND));
+    }
+    Drain();
+    auto created = std::chrono::steady_clock::now();
+    ASSERT_NE(GetNextHopEntry(KeyGenerator::generateNextHopKey(app_db_entries.back().next_hop_id)), nullptr);
+
+    for (const auto &app_db_entry : app_db_entries)
+    {
+        Enqueue(CreateNextHopKeyOpFieldsValuesTuple(app_db_entry, DEL_COMMAND));
+    }
+    Drain();
+    auto removed = std::chrono::steady_clock::now();
+    ASSERT_EQ(GetNextHopEntry(KeyGenerator::generateNextHopKey(app_db_entries.back().next_hop_id)), nullptr);
+
+    double create_sec = std::chrono::duration<double>(created - start).count();
+    double remove_sec = std::chrono::duration<double>(removed - created).count();
+    std::cout << next_hop_count << " next hops, create " << (double)next_hop_count / create_sec
+              << " next hops/sec, remove " << (double)next_hop_count / remove_sec << " next hops/sec" << std::endl;
+}
+
 TEST_F(NextHopManagerTest, VerifyIpNextHopStateTest)
 {
     auto *p4_next_hop_entry = AddNextHopEntry1();
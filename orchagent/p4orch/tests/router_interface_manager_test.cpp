@@ -7,6 +7,7 @@
 #include <string>
 
 #include "mock_response_publisher.h"
+#include "mock_sai_bulk_object.h"
 #include "mock_sai_router_interface.h"
 #include "p4orch.h"
 #include "p4orch/p4orch_util.h"
@@ -19,6 +20,7 @@ using ::p4orch::kTableKeyDelimiter;
 using ::testing::_;
 using ::testing::DoAll;
 using ::testing::Eq;
+using ::testing::Invoke;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 using ::testing::StrictMock;
@@ -52,6 +54,7 @@ const swss::MacAddress kMacAddress2("00:ff:ee:dd:cc:bb");
 const swss::MacAddress kZeroMacAddress("00:00:00:00:00:00");
 
 constexpr char *kRouterIntfAppDbKey = R"({"match/router_interface_id":"intf-3/4"})";
+constexpr char *kRouterIntfAppDbKey2 = R"({"match/router_interface_id":"Ethernet20"})";
 
 std::unordered_map<sai_attr_id_t, sai_attribute_value_t> CreateRouterInterfaceAttributeList(
     const sai_object_id_t &virtual_router_oid, const swss::MacAddress mac_address, const sai_object_id_t &port_oid,
@@ -156,6 +159,7 @@ class RouterInterfaceManagerTest : public ::testing::Test
     void SetUp() override
     {
         mock_sai_router_intf = &mock_sai_router_intf_;
+        mock_sai_bulk_object = &mock_sai_bulk_object_;
         sai_router_intfs_api->create_router_interface = mock_create_router_interface;
         sai_router_intfs_api->remove_router_interface = mock_remove_router_interface;
         sai_router_intfs_api->set_router_interface_attribute = mock_set_router_interface_attribute;
@@ -261,6 +265,7 @@ class RouterInterfaceManagerTest : public ::testing::Test
     }
 
     StrictMock<MockSaiRouterInterface> mock_sai_router_intf_;
+    StrictMock<MockSaiBulkObject> mock_sai_bulk_object_;
     MockResponsePublisher publisher_;
     P4OidMapper p4_oid_mapper_;
     RouterInterfaceManager router_intf_manager_;
@@ -847,6 +852,110 @@ TEST_F(RouterInterfaceManagerTest, DrainInvalidOperation)
     ValidateRouterInterfaceEntryNotPresent(kRouterInterfaceId1);
 }
 
+TEST_F(RouterInterfaceManagerTest, DrainMultipleCreateAndDeleteRequestsUseBulkSai)
+{
+    const std::string appl_db_key1 =
+        std::string(APP_P4RT_ROUTER_INTERFACE_TABLE_NAME) + kTableKeyDelimiter + std::string(kRouterIntfAppDbKey);
+    const std::string appl_db_key2 =
+        std::string(APP_P4RT_ROUTER_INTERFACE_TABLE_NAME) + kTableKeyDelimiter + std::string(kRouterIntfAppDbKey2);
+
+    // Enqueue entries for create operation, both router interfaces are created
+    // by a single bulk call.
+    Enqueue(swss::KeyOpFieldsValuesTuple(
+        appl_db_key1, SET_COMMAND,
+        {swss::FieldValueTuple{prependParamField(p4orch::kPort), kPortName1},
+         swss::FieldValueTuple{prependParamField(p4orch::kSrcMac), kMacAddress1.to_string()}}));
+    Enqueue(swss::KeyOpFieldsValuesTuple(
+        appl_db_key2, SET_COMMAND,
+        {swss::FieldValueTuple{prependParamField(p4orch::kPort), kPortName2},
+         swss::FieldValueTuple{prependParamField(p4orch::kSrcMac), kMacAddress2.to_string()}}));
+
+    EXPECT_CALL(mock_sai_bulk_object_,
+                create_objects(Eq(gSwitchId), Eq(SAI_OBJECT_TYPE_ROUTER_INTERFACE), Eq(2u), _, _, _, _, _))
+        .WillOnce(Invoke([](sai_object_id_t, sai_object_type_t, uint32_t, const uint32_t *attr_count,
+                            const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t,
+                            sai_object_id_t *object_id, sai_status_t *object_statuses) {
+            EXPECT_EQ(5u, attr_count[0]);
+            EXPECT_TRUE(MatchCreateRouterInterfaceAttributeList(
+                attr_list[0], CreateRouterInterfaceAttributeList(gVirtualRouterId, kMacAddress1, kPortOid1, kMtu1)));
+            EXPECT_EQ(5u, attr_count[1]);
+            EXPECT_TRUE(MatchCreateRouterInterfaceAttributeList(
+                attr_list[1], CreateRouterInterfaceAttributeList(gVirtualRouterId, kMacAddress2, kPortOid2, kMtu2)));
+            object_id[0] = kRouterInterfaceOid1;
+            object_id[1] = kRouterInterfaceOid2;
+            object_statuses[0] = SAI_STATUS_SUCCESS;
+            object_statuses[1] = SAI_STATUS_SUCCESS;
+            return SAI_STATUS_SUCCESS;
+        }));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key1), _, Eq(StatusCode::SWSS_RC_SUCCESS),
+                                    Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key2), _, Eq(StatusCode::SWSS_RC_SUCCESS),
+                                    Eq(true)));
+    Drain();
+
+    P4RouterInterfaceEntry router_intf_entry1(kRouterInterfaceId1, kPortName1, kMacAddress1);
+    router_intf_entry1.router_interface_oid = kRouterInterfaceOid1;
+    ValidateRouterInterfaceEntry(router_intf_entry1);
+    P4RouterInterfaceEntry router_intf_entry2(kRouterInterfaceId2, kPortName2, kMacAddress2);
+    router_intf_entry2.router_interface_oid = kRouterInterfaceOid2;
+    ValidateRouterInterfaceEntry(router_intf_entry2);
+
+    // Enqueue entries for delete operation, the second one fails.
+    std::vector<swss::FieldValueTuple> attributes;
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key1, DEL_COMMAND, attributes));
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key2, DEL_COMMAND, attributes));
+
+    EXPECT_CALL(mock_sai_bulk_object_, remove_objects(Eq(SAI_OBJECT_TYPE_ROUTER_INTERFACE), Eq(2u), _, _, _))
+        .WillOnce(Invoke([](sai_object_type_t, uint32_t object_count, const sai_object_id_t *object_id,
+                            sai_bulk_op_error_mode_t, sai_status_t *object_statuses) {
+            for (uint32_t i = 0; i < object_count; i++)
+            {
+                object_statuses[i] =
+                    (object_id[i] == kRouterInterfaceOid1) ? SAI_STATUS_SUCCESS : SAI_STATUS_OBJECT_IN_USE;
+            }
+            return SAI_STATUS_FAILURE;
+        }));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key1), _, Eq(StatusCode::SWSS_RC_SUCCESS),
+                                    Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key2), _, Eq(StatusCode::SWSS_RC_IN_USE),
+                                    Eq(true)));
+    Drain();
+
+    ValidateRouterInterfaceEntryNotPresent(kRouterInterfaceId1);
+    ValidateRouterInterfaceEntry(router_intf_entry2);
+}
+
+TEST_F(RouterInterfaceManagerTest, DrainMultipleCreateRequestsStopOnFirstFailure)
+{
+    const std::string appl_db_key1 =
+        std::string(APP_P4RT_ROUTER_INTERFACE_TABLE_NAME) + kTableKeyDelimiter + std::string(kRouterIntfAppDbKey);
+    const std::string appl_db_key2 =
+        std::string(APP_P4RT_ROUTER_INTERFACE_TABLE_NAME) + kTableKeyDelimiter + std::string(kRouterIntfAppDbKey2);
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key1, SET_COMMAND,
+                                         {swss::FieldValueTuple{prependParamField(p4orch::kPort), kPortName1}}));
+    Enqueue(swss::KeyOpFieldsValuesTuple(appl_db_key2, SET_COMMAND,
+                                         {swss::FieldValueTuple{prependParamField(p4orch::kPort), kPortName2}}));
+
+    // The router interfaces after the failed one are not executed.
+    EXPECT_CALL(mock_sai_bulk_object_,
+                create_objects(Eq(gSwitchId), Eq(SAI_OBJECT_TYPE_ROUTER_INTERFACE), Eq(2u), _, _,
+                               Eq(SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR), _, _))
+        .WillOnce(Invoke([](sai_object_id_t, sai_object_type_t, uint32_t, const uint32_t *, const sai_attribute_t **,
+                            sai_bulk_op_error_mode_t, sai_object_id_t *, sai_status_t *object_statuses) {
+            object_statuses[0] = SAI_STATUS_FAILURE;
+            object_statuses[1] = SAI_STATUS_NOT_EXECUTED;
+            return SAI_STATUS_FAILURE;
+        }));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key1), _, Eq(StatusCode::SWSS_RC_UNKNOWN),
+                                    Eq(true)));
+    EXPECT_CALL(publisher_, publish(Eq(APP_P4RT_TABLE_NAME), Eq(appl_db_key2), _,
+                                    Eq(StatusCode::SWSS_RC_NOT_EXECUTED), Eq(true)));
+    Drain();
+
+    ValidateRouterInterfaceEntryNotPresent(kRouterInterfaceId1);
+    ValidateRouterInterfaceEntryNotPresent(kRouterInterfaceId2);
+}
+
 TEST_F(RouterInterfaceManagerTest, VerifyStateTest)
 {
     P4RouterInterfaceEntry router_intf_entry(kRouterInterfaceId1, kPortName1, kMacAddress1);
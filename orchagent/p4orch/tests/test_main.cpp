@@ -45,6 +45,7 @@ size_t gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
 bool gSyncMode = false;
 bool gIsNatSupported = false;
 bool gTraditionalFlexCounter = false;
+bool gFlexCounterBulkKeys = false;
 
 PortsOrch *gPortsOrch;
 CrmOrch *gCrmOrch;
@@ -488,8 +488,6 @@ bool PbhOrch::createPbhRule(const PbhRule &rule)
         return false;
     }
 
-    std::shared_ptr<AclRulePbh> pbhRule;
-
     if (rule.flow_counter.is_set)
     {
         pbhRule = std::make_shared<AclRulePbh>(this->aclOrch, rule.name, rule.table, rule.flow_counter.value);
@@ -653,7 +651,12 @@ bool PbhOrch::createPbhRule(const PbhRule &rule)
     return true;
 }
 
-bool PbhOrch::updatePbhRule(const PbhRule &rule)
+/*
+ * Build the ACL rule of the updated PBH rule, null if the rule is up-to-date.
+ * The ACL rules of all the updated PBH rules are then updated in one batch,
+ * see deployPbhRuleSetupTasks().
+ */
+bool PbhOrch::preparePbhRuleUpdate(const PbhRule &rule, std::shared_ptr<AclRulePbh> &pbhRule)
 {
     SWSS_LOG_ENTER();
 
@@ -693,8 +696,6 @@ bool PbhOrch::updatePbhRule(const PbhRule &rule)
         return false;
     }
 
-    std::shared_ptr<AclRulePbh> pbhRule;
-
     if (rule.flow_counter.is_set)
     {
         pbhRule = std::make_shared<AclRulePbh>(this->aclOrch, rule.name, rule.table, rule.flow_counter.value);
@@ -862,9 +863,18 @@ bool PbhOrch::updatePbhRule(const PbhRule &rule)
         }
     }
 
-    if (!this->aclOrch->updateAclRule(pbhRule))
+    return true;
+}
+
+bool PbhOrch::completePbhRuleUpdate(const PbhRule &rule)
+{
+    SWSS_LOG_ENTER();
+
+    PbhRule rObj;
+
+    if (!this->pbhHlpr.getPbhRule(rObj, rule.key))
     {
-        SWSS_LOG_ERROR("Failed to update PBH rule(%s) in SAI", rule.key.c_str());
+        SWSS_LOG_ERROR("Failed to update PBH rule(%s) in internal cache: object doesn't exist", rule.key.c_str());
         return false;
     }
 
@@ -933,6 +943,9 @@ void PbhOrch::deployPbhRuleSetupTasks()
     auto &map = this->pbhHlpr.ruleTask.pendingSetupMap;
     auto it = map.begin();
 
+    std::vector<PbhRule> updatedRules;
+    std::vector<std::shared_ptr<AclRule>> updatedAclRules;
+
     while (it != map.end())
     {
         auto &key = it->first;
@@ -956,14 +969,42 @@ void PbhOrch::deployPbhRuleSetupTasks()
         }
         else
         {
-            if (!this->updatePbhRule(rule))
+            std::shared_ptr<AclRulePbh> pbhRule;
+
+            if (!this->preparePbhRuleUpdate(rule, pbhRule))
             {
                 SWSS_LOG_ERROR("Failed to update PBH rule(%s): ASIC and CONFIG DB are diverged", key.c_str());
             }
+            else if (pbhRule)
+            {
+                updatedRules.push_back(rule);
+                updatedAclRules.push_back(pbhRule);
+            }
         }
 
         it = map.erase(it);
     }
+
+    if (updatedAclRules.empty())
+    {
+        return;
+    }
+
+    // Set the changed attributes of all the updated rules at once
+    const auto &results = this->aclOrch->updateAclRules(updatedAclRules);
+
+    for (std::size_t i = 0; i < updatedRules.size(); i++)
+    {
+        if (!results.at(i))
+        {
+            SWSS_LOG_ERROR("Failed to update PBH rule(%s) in SAI", updatedRules[i].key.c_str());
+        }
+
+        if (!results.at(i) || !this->completePbhRuleUpdate(updatedRules[i]))
+        {
+            SWSS_LOG_ERROR("Failed to update PBH rule(%s): ASIC and CONFIG DB are diverged", updatedRules[i].key.c_str());
+        }
+    }
 }
 
 void PbhOrch::deployPbhRuleRemoveTasks()
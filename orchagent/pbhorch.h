@@ -50,7 +50,8 @@ private:
     bool removePbhTable(const PbhTable &table);
 
     bool createPbhRule(const PbhRule &rule);
-    bool updatePbhRule(const PbhRule &rule);
+    bool preparePbhRuleUpdate(const PbhRule &rule, std::shared_ptr<AclRulePbh> &pbhRule);
+    bool completePbhRuleUpdate(const PbhRule &rule);
     bool removePbhRule(const PbhRule &rule);
 
     bool createPbhHash(const PbhHash &hash);
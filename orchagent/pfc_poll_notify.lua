@@ -0,0 +1,13 @@
+-- KEYS - queue IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - counters table name
+-- ARGV[3] - poll time interval (milliseconds)
+-- Notify orchagent that the PFC watchdog counters of this poll are written,
+-- the storm detection itself runs in orchagent
+
+local counters_db = ARGV[1]
+
+redis.call('SELECT', counters_db)
+redis.call('PUBLISH', 'PFC_WD_POLL', '["poll","' .. ARGV[3] .. '"]')
+
+return {}
@@ -0,0 +1,349 @@
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include "pfcwddetector.h"
+#include "logger.h"
+#include "sai_serialize.h"
+#include "schema.h"
+
+#define PFC_WD_PORT_PFC_PREFIX          "SAI_PORT_STAT_PFC_"
+#define PFC_WD_PORT_PFC_RX_SUFFIX       "_RX_PKTS"
+#define PFC_WD_PORT_PFC_ON2OFF_SUFFIX   "_ON2OFF_RX_PKTS"
+#define PFC_WD_TC_MAX                   8
+
+using namespace std;
+using namespace swss;
+
+void PfcWdDetector::addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+        uint32_t detectionTime, uint32_t restorationTime, bool alert)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_queueIndex.find(queueId);
+    if (it == m_queueIndex.end())
+    {
+        it = m_queueIndex.emplace(queueId, m_queues.size()).first;
+        m_queues.emplace_back();
+    }
+
+    Queue &queue = m_queues[it->second];
+    queue = Queue();
+    queue.queueId = queueId;
+    queue.portId = portId;
+    queue.index = index;
+    queue.alert = alert;
+    queue.detectionTime = static_cast<uint64_t>(detectionTime) * 1000;
+    queue.restorationTime = static_cast<uint64_t>(restorationTime) * 1000;
+    queue.detectionTimeLeft = queue.detectionTime;
+    queue.restorationTimeLeft = queue.restorationTime;
+}
+
+void PfcWdDetector::removeQueue(sai_object_id_t queueId)
+{
+    SWSS_LOG_ENTER();
+
+    auto it = m_queueIndex.find(queueId);
+    if (it == m_queueIndex.end())
+    {
+        return;
+    }
+
+    // Keep the array dense, the last queue takes the place of the removed one
+    size_t idx = it->second;
+    m_queueIndex.erase(it);
+    if (idx != m_queues.size() - 1)
+    {
+        m_queues[idx] = m_queues.back();
+        m_queueIndex[m_queues[idx].queueId] = idx;
+    }
+    m_queues.pop_back();
+}
+
+void PfcWdDetector::reset(void)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &queue : m_queues)
+    {
+        queue.detectionTimeLeft = queue.detectionTime;
+        queue.restorationTimeLeft = queue.restorationTime;
+        queue.hasDetectLast = false;
+        queue.hasPfcRxLast = false;
+    }
+}
+
+void PfcWdDetector::poll(uint32_t pollTime, const vector<QueueSample>& samples,
+        vector<pair<sai_object_id_t, Event>>& events)
+{
+    events.clear();
+
+    uint64_t pollTimeUs = static_cast<uint64_t>(pollTime) * 1000;
+    size_t count = min(samples.size(), m_queues.size());
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Queue &queue = m_queues[i];
+        const QueueSample &sample = samples[i];
+
+        if (sample.bigRedSwitch || !sample.valid)
+        {
+            continue;
+        }
+
+        if (sample.operational || queue.alert)
+        {
+            // pfc_detect_broadcom.lua
+            if (queue.hasDetectLast && queue.hasPfcRxLast)
+            {
+                bool storm = (sample.pfcRxPackets > queue.pfcRxPacketsLast &&
+                              sample.pfcOn2OffRxPackets == queue.pfcOn2OffRxPacketsLast &&
+                              queue.pauseStatusLast && sample.pauseStatus) ||
+                             sample.debugStorm;
+                if (storm)
+                {
+                    if (queue.detectionTimeLeft <= pollTimeUs)
+                    {
+                        events.emplace_back(queue.queueId, Event::STORM);
+                        queue.detectionTimeLeft = queue.detectionTime;
+                    }
+                    else
+                    {
+                        queue.detectionTimeLeft -= pollTimeUs;
+                    }
+                }
+                else
+                {
+                    if (queue.alert && !sample.operational)
+                    {
+                        events.emplace_back(queue.queueId, Event::RESTORE);
+                    }
+                    queue.detectionTimeLeft = queue.detectionTime;
+                }
+            }
+
+            queue.pauseStatusLast = sample.pauseStatus;
+            queue.packetsLast = sample.packets;
+            queue.pfcOn2OffRxPacketsLast = sample.pfcOn2OffRxPackets;
+            queue.hasDetectLast = true;
+        }
+        else if (queue.restorationTime != 0)
+        {
+            // pfc_restore.lua
+            if (queue.hasPfcRxLast)
+            {
+                if (sample.pfcRxPackets == queue.pfcRxPacketsLast && !sample.debugStorm)
+                {
+                    if (queue.restorationTimeLeft <= pollTimeUs)
+                    {
+                        events.emplace_back(queue.queueId, Event::RESTORE);
+                        queue.restorationTimeLeft = queue.restorationTime;
+                    }
+                    else
+                    {
+                        queue.restorationTimeLeft -= pollTimeUs;
+                    }
+                }
+                else
+                {
+                    queue.restorationTimeLeft = queue.restorationTime;
+                }
+            }
+        }
+        else
+        {
+            continue;
+        }
+
+        queue.pfcRxPacketsLast = sample.pfcRxPackets;
+        queue.hasPfcRxLast = true;
+    }
+}
+
+PfcWdCountersTableReader::PfcWdCountersTableReader(DBConnector *countersDb):
+    m_batchReader(countersDb, COUNTERS_TABLE)
+{
+    SWSS_LOG_ENTER();
+}
+
+const string& PfcWdCountersTableReader::getKey(sai_object_id_t id)
+{
+    auto it = m_keys.find(id);
+    if (it == m_keys.end())
+    {
+        it = m_keys.emplace(id, sai_serialize_object_id(id)).first;
+    }
+
+    return it->second;
+}
+
+void PfcWdCountersTableReader::read(const vector<PfcWdDetector::Queue>& queues,
+        vector<PfcWdDetector::QueueSample>& samples)
+{
+    samples.assign(queues.size(), PfcWdDetector::QueueSample());
+    m_ports.clear();
+    m_batchKeys.clear();
+    m_queueKeys.assign(queues.size(), 0);
+
+    // The keys of the queues and of their ports, read in one batch
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        const auto &queue = queues[i];
+        if (queue.index >= PFC_WD_TC_MAX)
+        {
+            continue;
+        }
+
+        if (m_ports.find(queue.portId) == m_ports.end())
+        {
+            m_ports[queue.portId].key = m_batchKeys.size();
+            m_batchKeys.push_back(getKey(queue.portId));
+        }
+
+        m_queueKeys[i] = m_batchKeys.size();
+        m_batchKeys.push_back(getKey(queue.queueId));
+    }
+
+    m_batchReader.get(m_batchKeys, m_batchValues);
+
+    for (auto &port : m_ports)
+    {
+        for (const auto &fv : m_batchValues[port.second.key])
+        {
+            const string &field = fvField(fv);
+            const size_t prefixLen = sizeof(PFC_WD_PORT_PFC_PREFIX) - 1;
+            if (field.size() <= prefixLen + 1 ||
+                field.compare(0, prefixLen, PFC_WD_PORT_PFC_PREFIX) != 0 ||
+                field[prefixLen] < '0' || field[prefixLen] >= '0' + PFC_WD_TC_MAX)
+            {
+                continue;
+            }
+
+            uint8_t tc = static_cast<uint8_t>(field[prefixLen] - '0');
+            const char *suffix = field.c_str() + prefixLen + 1;
+            uint64_t value = strtoull(fvValue(fv).c_str(), nullptr, 10);
+            if (strcmp(suffix, PFC_WD_PORT_PFC_RX_SUFFIX) == 0)
+            {
+                port.second.hasPfcRx[tc] = true;
+                port.second.pfcRx[tc] = value;
+            }
+            else if (strcmp(suffix, PFC_WD_PORT_PFC_ON2OFF_SUFFIX) == 0)
+            {
+                port.second.hasPfcOn2OffRx[tc] = true;
+                port.second.pfcOn2OffRx[tc] = value;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        const auto &queue = queues[i];
+        auto &sample = samples[i];
+
+        if (queue.index >= PFC_WD_TC_MAX)
+        {
+            continue;
+        }
+
+        bool hasOccupancy = false;
+        bool hasPackets = false;
+        bool hasPauseStatus = false;
+        for (const auto &fv : m_batchValues[m_queueKeys[i]])
+        {
+            const string &field = fvField(fv);
+            if (field == "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES")
+            {
+                hasOccupancy = true;
+            }
+            else if (field == "SAI_QUEUE_STAT_PACKETS")
+            {
+                hasPackets = true;
+                sample.packets = strtoull(fvValue(fv).c_str(), nullptr, 10);
+            }
+            else if (field == "SAI_QUEUE_ATTR_PAUSE_STATUS")
+            {
+                hasPauseStatus = true;
+                sample.pauseStatus = fvValue(fv) == "true";
+            }
+            else if (field == "DEBUG_STORM")
+            {
+                sample.debugStorm = fvValue(fv) == "enabled";
+            }
+        }
+
+        const auto &counters = m_ports[queue.portId];
+        sample.pfcRxPackets = counters.pfcRx[queue.index];
+        sample.pfcOn2OffRxPackets = counters.pfcOn2OffRx[queue.index];
+        sample.valid = hasOccupancy && hasPackets && hasPauseStatus &&
+                       counters.hasPfcRx[queue.index] && counters.hasPfcOn2OffRx[queue.index];
+    }
+}
+
+PfcWdSnapshotReader::PfcWdSnapshotReader(const string& group, DBConnector *countersDb):
+    m_reader(group),
+    m_tableReader(countersDb)
+{
+    SWSS_LOG_ENTER();
+
+    resolveCounters();
+}
+
+void PfcWdSnapshotReader::resolveCounters(void)
+{
+    m_layout = m_snapshot.getLayout();
+    m_occupancy = m_snapshot.getCounterIndex("SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES");
+    m_packets = m_snapshot.getCounterIndex("SAI_QUEUE_STAT_PACKETS");
+    m_pauseStatus = m_snapshot.getCounterIndex("SAI_QUEUE_ATTR_PAUSE_STATUS");
+    for (uint8_t tc = 0; tc < PFC_WD_TC_MAX; tc++)
+    {
+        string prefix = PFC_WD_PORT_PFC_PREFIX + to_string(tc);
+        m_pfcRx[tc] = m_snapshot.getCounterIndex(prefix + PFC_WD_PORT_PFC_RX_SUFFIX);
+        m_pfcOn2OffRx[tc] = m_snapshot.getCounterIndex(prefix + PFC_WD_PORT_PFC_ON2OFF_SUFFIX);
+    }
+}
+
+void PfcWdSnapshotReader::read(const vector<PfcWdDetector::Queue>& queues,
+        vector<PfcWdDetector::QueueSample>& samples)
+{
+    if (!m_reader.read(m_snapshot))
+    {
+        m_tableReader.read(queues, samples);
+        return;
+    }
+
+    if (m_snapshot.getLayout() != m_layout)
+    {
+        resolveCounters();
+    }
+
+    auto getValue = [this](size_t object, size_t counter, uint64_t &value) {
+        if (object == CounterSnapshot::NOT_FOUND || counter == CounterSnapshot::NOT_FOUND)
+        {
+            return false;
+        }
+        value = m_snapshot.getValue(object, counter);
+        return value != CounterSnapshot::NOT_AVAILABLE;
+    };
+
+    samples.assign(queues.size(), PfcWdDetector::QueueSample());
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        const auto &queue = queues[i];
+        auto &sample = samples[i];
+
+        if (queue.index >= PFC_WD_TC_MAX)
+        {
+            continue;
+        }
+
+        size_t queueIdx = m_snapshot.getObjectIndex(queue.queueId);
+        size_t portIdx = m_snapshot.getObjectIndex(queue.portId);
+
+        uint64_t occupancy, pauseStatus;
+        sample.valid = getValue(queueIdx, m_occupancy, occupancy) &&
+                       getValue(queueIdx, m_packets, sample.packets) &&
+                       getValue(queueIdx, m_pauseStatus, pauseStatus) &&
+                       getValue(portIdx, m_pfcRx[queue.index], sample.pfcRxPackets) &&
+                       getValue(portIdx, m_pfcOn2OffRx[queue.index], sample.pfcOn2OffRxPackets);
+        sample.pauseStatus = sample.valid && pauseStatus != 0;
+    }
+}
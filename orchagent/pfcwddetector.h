@@ -0,0 +1,175 @@
+#ifndef PFC_WD_DETECTOR_H
+#define PFC_WD_DETECTOR_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "table.h"
+#include "countersnapshot.h"
+#include "tablebatchreader.h"
+
+extern "C" {
+#include "sai.h"
+}
+
+// In-process PFC storm detection. It runs the state machine of
+// pfc_detect_broadcom.lua and pfc_restore.lua on the queues of the
+// PFC watchdog, with the state of each queue kept in a flat array
+// instead of the *_last and *_LEFT fields of COUNTERS_DB.
+class PfcWdDetector
+{
+    public:
+        // Counters of a queue and of the PFC priority of its port at one poll,
+        // with the watchdog status of the queue
+        struct QueueSample
+        {
+            bool valid = false;
+            uint64_t packets = 0;
+            uint64_t pfcRxPackets = 0;
+            uint64_t pfcOn2OffRxPackets = 0;
+            bool pauseStatus = false;
+            bool debugStorm = false;
+
+            bool operational = true;
+            bool bigRedSwitch = false;
+        };
+
+        struct Queue
+        {
+            sai_object_id_t queueId = SAI_NULL_OBJECT_ID;
+            sai_object_id_t portId = SAI_NULL_OBJECT_ID;
+            uint8_t index = 0;
+            bool alert = false;
+
+            // In usec, no restoration when 0
+            uint64_t detectionTime = 0;
+            uint64_t restorationTime = 0;
+            uint64_t detectionTimeLeft = 0;
+            uint64_t restorationTimeLeft = 0;
+
+            bool hasDetectLast = false;
+            bool hasPfcRxLast = false;
+            uint64_t packetsLast = 0;
+            uint64_t pfcRxPacketsLast = 0;
+            uint64_t pfcOn2OffRxPacketsLast = 0;
+            bool pauseStatusLast = false;
+        };
+
+        enum class Event
+        {
+            STORM,
+            RESTORE,
+        };
+
+        // Detection and restoration time in msec, as configured
+        void addQueue(sai_object_id_t queueId, sai_object_id_t portId, uint8_t index,
+                uint32_t detectionTime, uint32_t restorationTime, bool alert);
+        void removeQueue(sai_object_id_t queueId);
+        // Forget the last counters and time left of all the queues
+        void reset(void);
+
+        inline const std::vector<Queue>& getQueues(void) const
+        {
+            return m_queues;
+        }
+
+        // Run one poll over the samples of the queues, in the order of
+        // getQueues(), and return the events to apply, in the same order.
+        // The poll time is in msec.
+        void poll(uint32_t pollTime, const std::vector<QueueSample>& samples,
+                std::vector<std::pair<sai_object_id_t, Event>>& events);
+
+    private:
+        std::vector<Queue> m_queues;
+        std::unordered_map<sai_object_id_t, size_t> m_queueIndex;
+};
+
+// Source of the counters of the PFC watchdog queues
+class PfcWdCounterReader
+{
+    public:
+        virtual ~PfcWdCounterReader(void) = default;
+
+        // Fill one sample per queue, the watchdog status is left to the caller
+        virtual void read(const std::vector<PfcWdDetector::Queue>& queues,
+                std::vector<PfcWdDetector::QueueSample>& samples) = 0;
+};
+
+// Counters of the COUNTERS table, as written by syncd, read with one HGETALL
+// per queue and per port, all sent in one batch per poll
+class PfcWdCountersTableReader: public PfcWdCounterReader
+{
+    public:
+        PfcWdCountersTableReader(swss::DBConnector *countersDb);
+
+        void read(const std::vector<PfcWdDetector::Queue>& queues,
+                std::vector<PfcWdDetector::QueueSample>& samples) override;
+
+        inline const swss::TableBatchReader::Stats& getStats(void) const
+        {
+            return m_batchReader.getStats();
+        }
+
+    private:
+        struct PortCounters
+        {
+            // Index of the port in the keys of the batch
+            size_t key = 0;
+            bool hasPfcRx[8] = {};
+            bool hasPfcOn2OffRx[8] = {};
+            uint64_t pfcRx[8] = {};
+            uint64_t pfcOn2OffRx[8] = {};
+        };
+
+        const std::string& getKey(sai_object_id_t id);
+
+        swss::TableBatchReader m_batchReader;
+        std::unordered_map<sai_object_id_t, std::string> m_keys;
+        std::unordered_map<sai_object_id_t, PortCounters> m_ports;
+
+        // Keys and replies of the batch, and the index of each queue in them
+        std::vector<std::string> m_batchKeys;
+        std::vector<std::vector<swss::FieldValueTuple>> m_batchValues;
+        std::vector<size_t> m_queueKeys;
+};
+
+// Counters of the counter snapshot region of the group, when the counter
+// poller publishes one, else of the COUNTERS table. DEBUG_STORM is not a
+// counter, it is only honoured when the COUNTERS table is read.
+class PfcWdSnapshotReader: public PfcWdCounterReader
+{
+    public:
+        PfcWdSnapshotReader(const std::string& group, swss::DBConnector *countersDb);
+
+        void read(const std::vector<PfcWdDetector::Queue>& queues,
+                std::vector<PfcWdDetector::QueueSample>& samples) override;
+
+        inline const swss::CounterSnapshotReader::Stats& getSnapshotStats(void) const
+        {
+            return m_reader.getStats();
+        }
+
+        inline const swss::TableBatchReader::Stats& getTableStats(void) const
+        {
+            return m_tableReader.getStats();
+        }
+
+    private:
+        void resolveCounters(void);
+
+        swss::CounterSnapshotReader m_reader;
+        swss::CounterSnapshot m_snapshot;
+        PfcWdCountersTableReader m_tableReader;
+
+        // Counter indexes of the snapshot layout they were resolved for
+        uint64_t m_layout = 0;
+        size_t m_occupancy = swss::CounterSnapshot::NOT_FOUND;
+        size_t m_packets = swss::CounterSnapshot::NOT_FOUND;
+        size_t m_pauseStatus = swss::CounterSnapshot::NOT_FOUND;
+        size_t m_pfcRx[8];
+        size_t m_pfcOn2OffRx[8];
+};
+
+#endif
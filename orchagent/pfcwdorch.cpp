@@ -1,5 +1,7 @@
 #include <limits.h>
 #include <inttypes.h>
+#include <stdint.h>
+#include <algorithm>
 #include <unordered_map>
 #include "pfcwdorch.h"
 #include "sai_serialize.h"
@@ -16,6 +18,8 @@
 #define PFC_WD_DETECTION_TIME           "detection_time"
 #define PFC_WD_RESTORATION_TIME         "restoration_time"
 #define BIG_RED_SWITCH_FIELD            "BIG_RED_SWITCH"
+#define NATIVE_DETECTION_FIELD          "NATIVE_DETECTION"
+#define PFC_WD_POLL_CHANNEL             "PFC_WD_POLL"
 #define PFC_WD_IN_STORM                 "storm"
 
 #define PFC_WD_DETECTION_TIME_MAX       (5 * 1000)
@@ -352,6 +356,10 @@ task_process_status PfcWdSwOrch<DropHandler, ForwardHandler>::createEntry(const
                 SWSS_LOG_NOTICE("Receive brs mode set, %s", value.c_str());
                 setBigRedSwitchMode(value);
             }
+            else if (field == NATIVE_DETECTION_FIELD)
+            {
+                setNativeDetection(value);
+            }
         }
     }
     else
@@ -589,6 +597,8 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::registerInWdDb(const Port& port,
 
         // Create internal entry
         m_entryMap.emplace(queueId, PfcWdQueueEntry(action, port.m_port_id, i, port.m_alias));
+        m_detector.addQueue(queueId, port.m_port_id, i, detectionTime, restorationTime,
+                action == PfcWdAction::PFC_WD_ACTION_ALERT);
 
         // Initialize PFC WD related counters
         PfcWdActionHandler::initWdCounters(
@@ -667,6 +677,7 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::unregisterFromWdDb(const Port& po
         }
 
         m_entryMap.erase(queueId);
+        m_detector.removeQueue(queueId);
 
         // Clean up
         string countersKey = this->getCountersTable()->getTableName() + this->getCountersTable()->getTableNameSeparator() + sai_serialize_object_id(queueId);
@@ -721,6 +732,27 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
     {
         SWSS_LOG_WARN("Lua scripts and polling interval for PFC watchdog were not set successfully");
     }
+    m_luaPlugins = plugins;
+
+    // The native detection implements the broadcom state machine only,
+    // the other platforms keep their Lua plugins
+    if (this->m_platform == BRCM_PLATFORM_SUBSTRING)
+    {
+        try
+        {
+            string pollNotifyLuaScript = swss::loadLuaScript("pfc_poll_notify.lua");
+            m_pollNotifyPlugin = swss::loadRedisScript(
+                    this->getCountersDb().get(),
+                    pollNotifyLuaScript);
+            m_nativeDetectionSupported = true;
+        }
+        catch (...)
+        {
+            SWSS_LOG_WARN("Lua script for PFC watchdog native detection was not loaded successfully");
+        }
+    }
+    m_counterReader = unique_ptr<PfcWdCounterReader>(
+            new PfcWdSnapshotReader(PFC_WD_FLEX_COUNTER_GROUP, this->getCountersDb().get()));
 
     setFlexCounterGroupParameter(PFC_WD_FLEX_COUNTER_GROUP,
                                  pollIntervalStr,
@@ -734,6 +766,12 @@ PfcWdSwOrch<DropHandler, ForwardHandler>::PfcWdSwOrch(
     auto wdNotification = new Notifier(consumer, this, "PFC_WD_ACTION");
     Orch::addExecutor(wdNotification);
 
+    m_pollNotificationConsumer = new swss::NotificationConsumer(
+            this->getCountersDb().get(),
+            PFC_WD_POLL_CHANNEL);
+    auto pollNotification = new Notifier(m_pollNotificationConsumer, this, PFC_WD_POLL_CHANNEL);
+    Orch::addExecutor(pollNotification);
+
     auto interv = timespec { .tv_sec = COUNTER_CHECK_POLL_TIMEOUT_SEC, .tv_nsec = 0 };
     auto timer = new SelectableTimer(interv);
     auto executor = new ExecutableTimer(timer, this, "PFC_WD_COUNTERS_POLL");
@@ -899,6 +937,35 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(swss::NotificationConsumer
 {
     SWSS_LOG_ENTER();
 
+    if (&wdNotification == m_pollNotificationConsumer)
+    {
+        // Polls that were notified while orchagent was busy are run as
+        // one, over the time of all of them, since the counters they
+        // were notified for are overwritten already
+        std::deque<KeyOpFieldsValuesTuple> polls;
+        wdNotification.pops(polls);
+
+        uint64_t pollTime = 0;
+        for (const auto &poll : polls)
+        {
+            try
+            {
+                pollTime += to_uint<uint32_t>(kfvKey(poll));
+            }
+            catch (const std::exception &e)
+            {
+                SWSS_LOG_WARN("Invalid PFC watchdog poll time %s, %s", kfvKey(poll).c_str(), e.what());
+                pollTime += m_pollInterval;
+            }
+        }
+
+        if (!polls.empty())
+        {
+            runNativeDetection(static_cast<uint32_t>(min<uint64_t>(pollTime, UINT32_MAX)));
+        }
+        return;
+    }
+
     string queueIdStr;
     string event;
     vector<swss::FieldValueTuple> values;
@@ -939,6 +1006,88 @@ void PfcWdSwOrch<DropHandler, ForwardHandler>::doTask(SelectableTimer &timer)
 
 }
 
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::runNativeDetection(uint32_t pollTime)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_nativeDetection)
+    {
+        return;
+    }
+
+    const auto &queues = m_detector.getQueues();
+    m_counterReader->read(queues, m_samples);
+
+    for (size_t i = 0; i < queues.size(); i++)
+    {
+        auto entry = m_entryMap.find(queues[i].queueId);
+        m_samples[i].operational = entry == m_entryMap.end() || entry->second.handler == nullptr;
+        m_samples[i].bigRedSwitch = m_bigRedSwitchFlag;
+    }
+
+    m_detector.poll(pollTime, m_samples, m_events);
+
+    for (const auto &event : m_events)
+    {
+        string name = event.second == PfcWdDetector::Event::STORM ? "storm" : "restore";
+        if (!startWdActionOnQueue(name, event.first))
+        {
+            SWSS_LOG_ERROR("Failed to start PFC watchdog %s event action on queue 0x%" PRIx64, name.c_str(), event.first);
+        }
+    }
+}
+
+template <typename DropHandler, typename ForwardHandler>
+void PfcWdSwOrch<DropHandler, ForwardHandler>::setNativeDetection(const string &value)
+{
+    SWSS_LOG_ENTER();
+
+    bool enable;
+    if (value == "enable")
+    {
+        enable = true;
+    }
+    else if (value == "disable")
+    {
+        enable = false;
+    }
+    else
+    {
+        SWSS_LOG_NOTICE("Unsupported NATIVE_DETECTION mode set input, please use enable or disable");
+        return;
+    }
+
+    if (enable && !m_nativeDetectionSupported)
+    {
+        SWSS_LOG_NOTICE("PFC watchdog native detection is not supported on platform %s, keep the Lua plugins",
+                this->m_platform.c_str());
+        return;
+    }
+
+    if (enable == m_nativeDetection)
+    {
+        return;
+    }
+
+    SWSS_LOG_NOTICE("PFC watchdog native detection %s", value.c_str());
+
+    // Both state machines start over from their initial state, as on a
+    // warm reboot
+    m_nativeDetection = enable;
+    m_detector.reset();
+    if (!enable)
+    {
+        clearPluginState();
+    }
+
+    setFlexCounterGroupParameter(PFC_WD_FLEX_COUNTER_GROUP,
+                                 "",
+                                 "",
+                                 QUEUE_PLUGIN_FIELD,
+                                 enable ? m_pollNotifyPlugin : m_luaPlugins);
+}
+
 template <typename DropHandler, typename ForwardHandler>
 void PfcWdSwOrch<DropHandler, ForwardHandler>::report_pfc_storm(
         sai_object_id_t id, const PfcWdQueueEntry *entry, const string &info)
@@ -1076,10 +1225,10 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::startWdActionOnQueue(const string
 }
 
 template <typename DropHandler, typename ForwardHandler>
-bool PfcWdSwOrch<DropHandler, ForwardHandler>::bake()
+void PfcWdSwOrch<DropHandler, ForwardHandler>::clearPluginState(void)
 {
-    // clean all *_last and *_LEFT fields in COUNTERS_TABLE
-    // to allow warm-reboot pfc detect & restore state machine to enter the same init state as cold-reboot
+    SWSS_LOG_ENTER();
+
     vector<string> cKeys;
     this->getCountersTable()->getKeys(cKeys);
     for (const auto &key : cKeys)
@@ -1103,6 +1252,14 @@ bool PfcWdSwOrch<DropHandler, ForwardHandler>::bake()
                 wLasts);
         }
     }
+}
+
+template <typename DropHandler, typename ForwardHandler>
+bool PfcWdSwOrch<DropHandler, ForwardHandler>::bake()
+{
+    // clean all *_last and *_LEFT fields in COUNTERS_TABLE
+    // to allow warm-reboot pfc detect & restore state machine to enter the same init state as cold-reboot
+    clearPluginState();
 
     Orch::bake();
 
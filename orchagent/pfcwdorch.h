@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "port.h"
 #include "pfcactionhandler.h"
+#include "pfcwddetector.h"
 #include "producertable.h"
 #include "notificationconsumer.h"
 #include "timer.h"
@@ -122,6 +123,9 @@ private:
             uint32_t detectionTime, uint32_t restorationTime, PfcWdAction action);
     void unregisterFromWdDb(const Port& port);
     void doTask(swss::NotificationConsumer &wdNotification);
+    void runNativeDetection(uint32_t pollTime);
+    void setNativeDetection(const string &value);
+    void clearPluginState(void);
 
     string filterPfcCounters(string counters, set<uint8_t>& losslessTc);
     string getFlexCounterTableKey(string s);
@@ -142,6 +146,18 @@ private:
     bool m_bigRedSwitchFlag = false;
     int m_pollInterval;
 
+    // Storm detection in orchagent instead of the Lua plugins, the poll
+    // plugin only notifies that the counters of a poll are written
+    bool m_nativeDetectionSupported = false;
+    bool m_nativeDetection = false;
+    string m_luaPlugins;
+    string m_pollNotifyPlugin;
+    swss::NotificationConsumer *m_pollNotificationConsumer = nullptr;
+    PfcWdDetector m_detector;
+    unique_ptr<PfcWdCounterReader> m_counterReader;
+    vector<PfcWdDetector::QueueSample> m_samples;
+    vector<pair<sai_object_id_t, PfcWdDetector::Event>> m_events;
+
     shared_ptr<DBConnector> m_applDb = nullptr;
     // Track queues in storm
     shared_ptr<Table> m_applTable = nullptr;
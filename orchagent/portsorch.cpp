@@ -46,6 +46,7 @@ extern sai_hostif_api_t* sai_hostif_api;
 extern sai_acl_api_t* sai_acl_api;
 extern sai_queue_api_t *sai_queue_api;
 extern sai_object_id_t gSwitchId;
+extern size_t gMaxBulkSize;
 extern sai_fdb_api_t *sai_fdb_api;
 extern sai_tam_api_t *sai_tam_api;
 extern sai_l2mc_group_api_t *sai_l2mc_group_api;
@@ -75,6 +76,7 @@ extern event_handle_t g_events_handle;
 
 #define PORT_SPEED_LIST_DEFAULT_SIZE                     16
 #define PORT_STATE_POLLING_SEC                            5
+#define LAZY_BUFFER_COUNTERS_POLLING_SEC                 10
 #define PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS     1000
 #define PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS     60000
 #define QUEUE_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS   10000
@@ -537,7 +539,8 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
                 PORT_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false),
         port_buffer_drop_stat_manager(PORT_BUFFER_DROP_STAT_FLEX_COUNTER_GROUP, StatsMode::READ, PORT_BUFFER_DROP_STAT_POLLING_INTERVAL_MS, false),
         queue_stat_manager(QUEUE_STAT_COUNTER_FLEX_COUNTER_GROUP, StatsMode::READ, QUEUE_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false),
-        m_port_state_poller(new SelectableTimer(timespec { .tv_sec = PORT_STATE_POLLING_SEC, .tv_nsec = 0 }))
+        m_port_state_poller(new SelectableTimer(timespec { .tv_sec = PORT_STATE_POLLING_SEC, .tv_nsec = 0 })),
+        m_lazyBufferCountersPoller(new SelectableTimer(timespec { .tv_sec = LAZY_BUFFER_COUNTERS_POLLING_SEC, .tv_nsec = 0 }))
 {
     SWSS_LOG_ENTER();
 
@@ -811,6 +814,9 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     auto executor = new ExecutableTimer(m_port_state_poller, this, "PORT_STATE_POLLER");
     Orch::addExecutor(executor);
+
+    executor = new ExecutableTimer(m_lazyBufferCountersPoller, this, "LAZY_BUFFER_COUNTERS_POLLER");
+    Orch::addExecutor(executor);
 }
 
 void PortsOrch::initializeCpuPort()
@@ -3639,6 +3645,11 @@ void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
     /* remove port name map from counter table */
     m_counterTable->hdel("", alias);
 
+    m_lazyQueueStates.erase(alias);
+    m_lazyPgStates.erase(alias);
+    m_lazyBufferCountersCreated.erase(alias);
+    m_lazyBufferCountersIdleSince.erase(alias);
+
     /* Remove the associated port serdes attribute */
     removePortSerdesAttribute(p.m_port_id);
 
@@ -3978,6 +3989,9 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
+                // Install the counters of the initialized ports together
+                FlexCounterBulk bulk({ &port_stat_manager, &gb_port_stat_manager, &port_buffer_drop_stat_manager });
+
                 // Port add comparison logic
                 for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
                 {
@@ -7499,6 +7513,10 @@ void PortsOrch::addQueueFlexCounters(map<string, FlexCounterQueueStates> queuesS
                 }
                 queuesStateVector.insert(make_pair(it.second.m_alias, flexCounterQueueState));
             }
+            if (deferQueueCounters(it.second, queuesStateVector.at(it.second.m_alias)))
+            {
+                continue;
+            }
             addQueueFlexCountersPerPort(it.second, queuesStateVector.at(it.second.m_alias));
         }
     }
@@ -7584,6 +7602,10 @@ void PortsOrch::addQueueWatermarkFlexCounters(map<string, FlexCounterQueueStates
                 }
                 queuesStateVector.insert(make_pair(it.second.m_alias, flexCounterQueueState));
             }
+            if (deferQueueCounters(it.second, queuesStateVector.at(it.second.m_alias)))
+            {
+                continue;
+            }
             addQueueWatermarkFlexCountersPerPort(it.second, queuesStateVector.at(it.second.m_alias));
         }
     }
@@ -7891,6 +7913,10 @@ void PortsOrch::addPriorityGroupFlexCounters(map<string, FlexCounterPgStates> pg
                 }
                 pgsStateVector.insert(make_pair(it.second.m_alias, flexCounterPgState));
             }
+            if (deferPgCounters(it.second, pgsStateVector.at(it.second.m_alias)))
+            {
+                continue;
+            }
             addPriorityGroupFlexCountersPerPort(it.second, pgsStateVector.at(it.second.m_alias));
         }
     }
@@ -7959,6 +7985,10 @@ void PortsOrch::addPriorityGroupWatermarkFlexCounters(map<string, FlexCounterPgS
                 }
                 pgsStateVector.insert(make_pair(it.second.m_alias, flexCounterPgState));
             }
+            if (deferPgCounters(it.second, pgsStateVector.at(it.second.m_alias)))
+            {
+                continue;
+            }
             addPriorityGroupWatermarkFlexCountersPerPort(it.second, pgsStateVector.at(it.second.m_alias));
         }
     }
@@ -8094,6 +8124,207 @@ void PortsOrch::generatePortBufferDropCounterMap()
     m_isPortBufferDropCounterMapGenerated = true;
 }
 
+void PortsOrch::setLazyBufferCounters(bool enable, uint32_t idleTime)
+{
+    SWSS_LOG_ENTER();
+
+    /* VOQ counters are always enabled, see generateQueueMapPerPort() */
+    m_lazyBufferCounters = enable && gMySwitchType != "voq";
+    m_lazyBufferCountersIdleTime = idleTime;
+
+    if (m_lazyBufferCounters && m_lazyBufferCountersIdleTime)
+    {
+        m_lazyBufferCountersPoller->start();
+    }
+    else
+    {
+        m_lazyBufferCountersPoller->stop();
+    }
+
+    SWSS_LOG_NOTICE("Lazy queue and PG counters %s, idle time %u seconds",
+                    m_lazyBufferCounters ? "enabled" : "disabled", m_lazyBufferCountersIdleTime);
+}
+
+/*
+ * Keep the queue counter states of the port, and return true if its flex
+ * counters are not to be added now, the port is not oper up yet.
+ */
+bool PortsOrch::deferQueueCounters(const Port& port, const FlexCounterQueueStates& queuesState)
+{
+    if (!m_lazyBufferCounters)
+    {
+        return false;
+    }
+
+    m_lazyQueueStates.erase(port.m_alias);
+    m_lazyQueueStates.emplace(port.m_alias, queuesState);
+
+    return deferBufferCounters(port);
+}
+
+bool PortsOrch::deferPgCounters(const Port& port, const FlexCounterPgStates& pgsState)
+{
+    if (!m_lazyBufferCounters)
+    {
+        return false;
+    }
+
+    m_lazyPgStates.erase(port.m_alias);
+    m_lazyPgStates.emplace(port.m_alias, pgsState);
+
+    return deferBufferCounters(port);
+}
+
+bool PortsOrch::deferBufferCounters(const Port& port)
+{
+    if (m_lazyBufferCountersCreated.count(port.m_alias))
+    {
+        return false;
+    }
+
+    if (port.m_oper_status == SAI_PORT_OPER_STATUS_UP)
+    {
+        m_lazyBufferCountersCreated.insert(port.m_alias);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Create the queue and PG flex counters of the port that are enabled so far,
+ * the counter maps of all the ports are generated up front
+ */
+void PortsOrch::createLazyBufferCounters(const Port& port)
+{
+    SWSS_LOG_ENTER();
+
+    auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
+    FlexCounterBulk bulk({ &queue_stat_manager });
+
+    m_lazyBufferCountersCreated.insert(port.m_alias);
+
+    auto queues = m_lazyQueueStates.find(port.m_alias);
+    if (queues != m_lazyQueueStates.end())
+    {
+        if (flexCounterOrch->getQueueCountersState())
+        {
+            addQueueFlexCountersPerPort(port, queues->second);
+        }
+        if (flexCounterOrch->getQueueWatermarkCountersState())
+        {
+            addQueueWatermarkFlexCountersPerPort(port, queues->second);
+        }
+    }
+
+    auto pgs = m_lazyPgStates.find(port.m_alias);
+    if (pgs != m_lazyPgStates.end())
+    {
+        if (flexCounterOrch->getPgCountersState())
+        {
+            addPriorityGroupFlexCountersPerPort(port, pgs->second);
+        }
+        if (flexCounterOrch->getPgWatermarkCountersState())
+        {
+            addPriorityGroupWatermarkFlexCountersPerPort(port, pgs->second);
+        }
+    }
+
+    SWSS_LOG_INFO("Created queue and PG flex counters of port %s", port.m_alias.c_str());
+}
+
+/* Remove what createLazyBufferCounters() created */
+void PortsOrch::removeLazyBufferCounters(const Port& port)
+{
+    SWSS_LOG_ENTER();
+
+    auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
+
+    auto queues = m_lazyQueueStates.find(port.m_alias);
+    if (queues != m_lazyQueueStates.end())
+    {
+        for (size_t queueIndex = 0; queueIndex < port.m_queue_ids.size(); ++queueIndex)
+        {
+            const auto id = sai_serialize_object_id(port.m_queue_ids[queueIndex]);
+
+            string queueType;
+            uint8_t queueRealIndex = 0;
+            if (!getQueueTypeAndIndex(port.m_queue_ids[queueIndex], queueType, queueRealIndex) ||
+                !queues->second.isQueueCounterEnabled(queueRealIndex))
+            {
+                continue;
+            }
+
+            if (flexCounterOrch->getQueueCountersState())
+            {
+                queue_stat_manager.clearCounterIdList(port.m_queue_ids[queueIndex]);
+            }
+            if (flexCounterOrch->getQueueWatermarkCountersState())
+            {
+                stopFlexCounterPolling(gSwitchId, getQueueWatermarkFlexCounterTableKey(id));
+            }
+        }
+    }
+
+    auto pgs = m_lazyPgStates.find(port.m_alias);
+    if (pgs != m_lazyPgStates.end())
+    {
+        for (size_t pgIndex = 0; pgIndex < port.m_priority_group_ids.size(); ++pgIndex)
+        {
+            if (!pgs->second.isPgCounterEnabled(static_cast<uint32_t>(pgIndex)))
+            {
+                continue;
+            }
+
+            const auto id = sai_serialize_object_id(port.m_priority_group_ids[pgIndex]);
+
+            if (flexCounterOrch->getPgCountersState())
+            {
+                stopFlexCounterPolling(gSwitchId, getPriorityGroupDropPacketsFlexCounterTableKey(id));
+            }
+            if (flexCounterOrch->getPgWatermarkCountersState())
+            {
+                stopFlexCounterPolling(gSwitchId, getPriorityGroupWatermarkFlexCounterTableKey(id));
+            }
+        }
+    }
+
+    m_lazyBufferCountersCreated.erase(port.m_alias);
+
+    SWSS_LOG_INFO("Removed queue and PG flex counters of idle port %s", port.m_alias.c_str());
+}
+
+void PortsOrch::removeIdleBufferCounters()
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_lazyBufferCounters || !m_lazyBufferCountersIdleTime)
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto idleTime = std::chrono::seconds(m_lazyBufferCountersIdleTime);
+
+    for (auto it = m_lazyBufferCountersIdleSince.begin(); it != m_lazyBufferCountersIdleSince.end(); )
+    {
+        Port port;
+        if (!getPort(it->first, port) || port.m_oper_status == SAI_PORT_OPER_STATUS_UP)
+        {
+            it = m_lazyBufferCountersIdleSince.erase(it);
+            continue;
+        }
+        if (now - it->second < idleTime)
+        {
+            ++it;
+            continue;
+        }
+
+        removeLazyBufferCounters(port);
+        it = m_lazyBufferCountersIdleSince.erase(it);
+    }
+}
+
 uint32_t PortsOrch::getNumberOfPortSupportedPgCounters(string port)
 {
     return static_cast<uint32_t>(m_portList[port].m_priority_group_ids.size());
@@ -8132,6 +8363,18 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
 
         sai_deserialize_port_oper_status_ntf(data, count, &portoperstatus);
 
+        /* Read the speed and FEC of the ports that went up at once, for this notification only */
+        vector<sai_object_id_t> up_port_ids;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            Port port;
+            if (portoperstatus[i].port_state == SAI_PORT_OPER_STATUS_UP && getPort(portoperstatus[i].port_id, port))
+            {
+                up_port_ids.push_back(portoperstatus[i].port_id);
+            }
+        }
+        fetchPortOperAttrs(up_port_ids, getPortOperSpeedFecAttrIds());
+
         for (uint32_t i = 0; i < count; i++)
         {
             Port port;
@@ -8149,6 +8392,7 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
                 continue;
             }
 
+            m_portOperAttrCache[id][SAI_PORT_ATTR_OPER_STATUS].u32 = status;
             updatePortOperStatus(port, status);
             if (status == SAI_PORT_OPER_STATUS_UP)
             {
@@ -8189,6 +8433,7 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
             m_portList[port.m_alias] = port;
         }
 
+        m_portOperAttrCache.clear();
         sai_deserialize_free_port_oper_status_ntf(count, portoperstatus);
     }
     else if (&consumer == m_portHostTxReadyNotificationConsumer && op == "port_host_tx_ready")
@@ -8289,6 +8534,22 @@ void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
     }
     port.m_oper_status = status;
 
+    if (m_lazyBufferCounters && port.m_type == Port::PHY)
+    {
+        if (status == SAI_PORT_OPER_STATUS_UP)
+        {
+            m_lazyBufferCountersIdleSince.erase(port.m_alias);
+            if (!m_lazyBufferCountersCreated.count(port.m_alias))
+            {
+                createLazyBufferCounters(port);
+            }
+        }
+        else if (m_lazyBufferCountersCreated.count(port.m_alias))
+        {
+            m_lazyBufferCountersIdleSince.emplace(port.m_alias, std::chrono::steady_clock::now());
+        }
+    }
+
     if(port.m_type == Port::TUNNEL)
     {
         return;
@@ -8369,6 +8630,31 @@ void PortsOrch::refreshPortStatus()
 {
     SWSS_LOG_ENTER();
 
+    /* Read the oper status of all the ports, then the speed and FEC of the ports that are up */
+    vector<sai_object_id_t> port_ids;
+    for (auto &it: m_portList)
+    {
+        if (it.second.m_type == Port::PHY)
+        {
+            port_ids.push_back(it.second.m_port_id);
+        }
+    }
+
+    m_portOperAttrCache.clear();
+    fetchPortOperAttrs(port_ids, { SAI_PORT_ATTR_OPER_STATUS });
+
+    vector<sai_object_id_t> up_port_ids;
+    for (auto port_id : port_ids)
+    {
+        sai_attribute_value_t value;
+        if (getCachedPortOperAttr(port_id, SAI_PORT_ATTR_OPER_STATUS, value) &&
+            value.u32 == SAI_PORT_OPER_STATUS_UP)
+        {
+            up_port_ids.push_back(port_id);
+        }
+    }
+    fetchPortOperAttrs(up_port_ids, getPortOperSpeedFecAttrIds());
+
     for (auto &it: m_portList)
     {
         auto &port = it.second;
@@ -8380,6 +8666,7 @@ void PortsOrch::refreshPortStatus()
         sai_port_oper_status_t status;
         if (!getPortOperStatus(port, status))
         {
+            m_portOperAttrCache.clear();
             throw runtime_error("PortsOrch get port oper status failure");
         }
 
@@ -8412,6 +8699,109 @@ void PortsOrch::refreshPortStatus()
             updateDbPortOperFec(port,fec_str);
         }
     }
+
+    m_portOperAttrCache.clear();
+}
+
+/*
+ * Read the attributes of the ports into m_portOperAttrCache, with a bulk GET
+ * per gMaxBulkSize ports. If the bulk GET is not supported, or fails for a
+ * port, the attributes of the port are read by a single GET. The attributes
+ * of a port that can't be read are left out of the cache, so that the
+ * getters read them one by one and report the failure.
+ */
+void PortsOrch::fetchPortOperAttrs(const vector<sai_object_id_t> &port_ids, const vector<sai_attr_id_t> &attr_ids)
+{
+    SWSS_LOG_ENTER();
+
+    if (port_ids.empty() || attr_ids.empty())
+    {
+        return;
+    }
+
+    size_t count = port_ids.size();
+    vector<vector<sai_attribute_t>> attrDataList(count);
+    vector<uint32_t> attrCountList(count, static_cast<uint32_t>(attr_ids.size()));
+    vector<sai_attribute_t *> attrPtrList(count);
+    vector<sai_status_t> statusList(count, SAI_STATUS_NOT_EXECUTED);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        for (auto attr_id : attr_ids)
+        {
+            sai_attribute_t attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.id = attr_id;
+            attrDataList[i].push_back(attr);
+        }
+        attrPtrList[i] = attrDataList[i].data();
+    }
+
+    if (m_portBulkGetSupported && sai_port_api->get_ports_attribute != nullptr)
+    {
+        size_t bulkSize = gMaxBulkSize ? gMaxBulkSize : count;
+        for (size_t begin = 0; begin < count; begin += bulkSize)
+        {
+            auto status = sai_port_api->get_ports_attribute(
+                gSwitchId, static_cast<uint32_t>(min(bulkSize, count - begin)),
+                &port_ids[begin], &attrCountList[begin], &attrPtrList[begin],
+                SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, &statusList[begin]
+            );
+            if (status == SAI_STATUS_NOT_IMPLEMENTED || status == SAI_STATUS_NOT_SUPPORTED)
+            {
+                SWSS_LOG_NOTICE("Bulk get of port attributes is not supported, rv:%d", status);
+                m_portBulkGetSupported = false;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (statusList[i] != SAI_STATUS_SUCCESS)
+        {
+            statusList[i] = sai_port_api->get_port_attribute(port_ids[i], attrCountList[i], attrPtrList[i]);
+            if (statusList[i] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_INFO("Failed to get attributes of port 0x%" PRIx64 ", rv:%d", port_ids[i], statusList[i]);
+                continue;
+            }
+        }
+
+        auto &cache = m_portOperAttrCache[port_ids[i]];
+        for (const auto &attr : attrDataList[i])
+        {
+            cache[attr.id] = attr.value;
+        }
+    }
+}
+
+bool PortsOrch::getCachedPortOperAttr(sai_object_id_t port_id, sai_attr_id_t attr_id, sai_attribute_value_t &value) const
+{
+    auto port_it = m_portOperAttrCache.find(port_id);
+    if (port_it == m_portOperAttrCache.end())
+    {
+        return false;
+    }
+
+    auto attr_it = port_it->second.find(attr_id);
+    if (attr_it == port_it->second.end())
+    {
+        return false;
+    }
+
+    value = attr_it->second;
+    return true;
+}
+
+vector<sai_attr_id_t> PortsOrch::getPortOperSpeedFecAttrIds() const
+{
+    vector<sai_attr_id_t> attr_ids = { SAI_PORT_ATTR_OPER_SPEED };
+    if (oper_fec_sup)
+    {
+        attr_ids.push_back(SAI_PORT_ATTR_OPER_PORT_FEC_MODE);
+    }
+    return attr_ids;
 }
 
 bool PortsOrch::getPortOperStatus(const Port& port, sai_port_oper_status_t& status) const
@@ -8423,6 +8813,13 @@ bool PortsOrch::getPortOperStatus(const Port& port, sai_port_oper_status_t& stat
         return false;
     }
 
+    sai_attribute_value_t value;
+    if (getCachedPortOperAttr(port.m_port_id, SAI_PORT_ATTR_OPER_STATUS, value))
+    {
+        status = static_cast<sai_port_oper_status_t>(value.u32);
+        return true;
+    }
+
     sai_attribute_t attr;
     attr.id = SAI_PORT_ATTR_OPER_STATUS;
 
@@ -8447,17 +8844,23 @@ bool PortsOrch::getPortOperSpeed(const Port& port, sai_uint32_t& speed) const
         return false;
     }
 
-    sai_attribute_t attr;
-    attr.id = SAI_PORT_ATTR_OPER_SPEED;
-
-    sai_status_t ret = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
-    if (ret != SAI_STATUS_SUCCESS)
+    /* A speed of 0 read in bulk may be stale by now, it is read again */
+    sai_attribute_value_t value;
+    if (!getCachedPortOperAttr(port.m_port_id, SAI_PORT_ATTR_OPER_SPEED, value) || value.u32 == 0)
     {
-        SWSS_LOG_ERROR("Failed to get oper speed for %s", port.m_alias.c_str());
-        return false;
+        sai_attribute_t attr;
+        attr.id = SAI_PORT_ATTR_OPER_SPEED;
+
+        sai_status_t ret = sai_port_api->get_port_attribute(port.m_port_id, 1, &attr);
+        if (ret != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to get oper speed for %s", port.m_alias.c_str());
+            return false;
+        }
+        value = attr.value;
     }
 
-    speed = static_cast<sai_uint32_t>(attr.value.u32);
+    speed = static_cast<sai_uint32_t>(value.u32);
 
     if (speed == 0)
     {
@@ -8483,6 +8886,13 @@ bool PortsOrch::getPortOperFec(const Port& port, sai_port_fec_mode_t &fec_mode)
         return false;
     }
 
+    sai_attribute_value_t value;
+    if (getCachedPortOperAttr(port.m_port_id, SAI_PORT_ATTR_OPER_PORT_FEC_MODE, value))
+    {
+        fec_mode = static_cast<sai_port_fec_mode_t>(value.s32);
+        return true;
+    }
+
     sai_attribute_t attr;
     attr.id = SAI_PORT_ATTR_OPER_PORT_FEC_MODE;
 
@@ -10034,6 +10444,12 @@ bool PortsOrch::removePtTam(sai_object_id_t tam_id)
 
 void PortsOrch::doTask(swss::SelectableTimer &timer)
 {
+    if (&timer == m_lazyBufferCountersPoller)
+    {
+        removeIdleBufferCounters();
+        return;
+    }
+
     Port port;
 
     for (auto it = m_port_state_poll.begin(); it != m_port_state_poll.end(); )
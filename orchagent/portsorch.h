@@ -1,6 +1,7 @@
 #ifndef SWSS_PORTSORCH_H
 #define SWSS_PORTSORCH_H
 
+#include <chrono>
 #include <map>
 #include <unordered_set>
 
@@ -201,6 +202,14 @@ public:
     void generatePortCounterMap();
     void generatePortBufferDropCounterMap();
 
+    /*
+     * In lazy mode, the queue and PG flex counters of a PHY port are added
+     * once the port is oper up, and removed after the port has been oper down
+     * for idleTime seconds (0 keeps them). The counter maps of all the ports
+     * are still generated, for the CLI and the watermark readers.
+     */
+    void setLazyBufferCounters(bool enable, uint32_t idleTime);
+
     void refreshPortStatus();
     bool removeAclTableGroup(const Port &p);
 
@@ -460,6 +469,33 @@ private:
     bool m_isPortCounterMapGenerated = false;
     bool m_isPortBufferDropCounterMapGenerated = false;
 
+    /* Lazy queue and PG counters, the counter states of each PHY port */
+    bool m_lazyBufferCounters = false;
+    uint32_t m_lazyBufferCountersIdleTime = 0;
+    swss::SelectableTimer *m_lazyBufferCountersPoller = nullptr;
+    map<string, FlexCounterQueueStates> m_lazyQueueStates;
+    map<string, FlexCounterPgStates> m_lazyPgStates;
+    unordered_set<string> m_lazyBufferCountersCreated;
+    /* Ports with created counters that are oper down, and since when */
+    map<string, std::chrono::steady_clock::time_point> m_lazyBufferCountersIdleSince;
+    bool deferQueueCounters(const Port& port, const FlexCounterQueueStates& queuesState);
+    bool deferPgCounters(const Port& port, const FlexCounterPgStates& pgsState);
+    bool deferBufferCounters(const Port& port);
+    void createLazyBufferCounters(const Port& port);
+    void removeLazyBufferCounters(const Port& port);
+    void removeIdleBufferCounters();
+
+    /*
+     * Oper status, speed and FEC of the PHY ports, read in bulk by
+     * refreshPortStatus() and the port state change handler. It only lives
+     * for one of these passes, and is cleared at its end.
+     */
+    map<sai_object_id_t, map<sai_attr_id_t, sai_attribute_value_t>> m_portOperAttrCache;
+    bool m_portBulkGetSupported = true;
+    void fetchPortOperAttrs(const vector<sai_object_id_t> &port_ids, const vector<sai_attr_id_t> &attr_ids);
+    bool getCachedPortOperAttr(sai_object_id_t port_id, sai_attr_id_t attr_id, sai_attribute_value_t &value) const;
+    vector<sai_attr_id_t> getPortOperSpeedFecAttrIds() const;
+
     bool isAutoNegEnabled(sai_object_id_t id);
     task_process_status setPortAutoNeg(Port &port, bool autoneg);
     task_process_status setPortInterfaceType(Port &port, sai_port_interface_type_t interface_type);
@@ -0,0 +1,554 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include "ratecounters.h"
+#include "logger.h"
+#include "schema.h"
+#include "sai_serialize.h"
+
+#define RATES_TABLE_NAME                "RATES"
+#define RATES_INIT_DONE_FIELD           "INIT_DONE"
+#define RATES_LAST_SUFFIX               "_last"
+#define RATES_FEC_PRE_BER_FIELD         "FEC_PRE_BER"
+#define RATES_FEC_POST_BER_FIELD        "FEC_POST_BER"
+// The writes of a poll of up to 2048 objects go in one batch
+#define RATES_PIPELINE_SIZE             4096
+// The serdes rate of a port is looked up again every minute at 1 second
+// polling, to follow its speed
+#define RATES_SERDES_RATE_REFRESH_POLLS 60
+// Statistical average of the bit errors of an uncorrectable RS-FEC frame
+#define RATES_RS_AVERAGE_FRAME_BER      1e-8
+
+// FEC counters of the ports, after the counters of their rates
+#define PORT_FEC_CORRECTED_BITS         6
+#define PORT_FEC_NOT_CORRECTABLE_FRAMES 7
+#define PORT_FEC_MASK                   ((1 << PORT_FEC_CORRECTED_BITS) | (1 << PORT_FEC_NOT_CORRECTABLE_FRAMES))
+
+using namespace std;
+using namespace swss;
+
+const size_t RateCounters::MAX_COUNTERS;
+const size_t RateCounters::MAX_RATES;
+
+struct RateCounters::Spec
+{
+    // A rate is the sum of the deltas of the counters of its mask
+    Spec(const string &name, const string &luaPlugin, const vector<string> &counters,
+            const vector<string> &lastFields, uint8_t required,
+            const vector<pair<string, uint8_t>> &rates, bool fec):
+        name(name),
+        luaPlugin(luaPlugin),
+        counters(counters),
+        lastFields(lastFields),
+        required(required),
+        fec(fec)
+    {
+        for (size_t c = this->lastFields.size(); c < counters.size(); c++)
+        {
+            this->lastFields.push_back(counters[c] + RATES_LAST_SUFFIX);
+        }
+
+        for (size_t r = 0; r < MAX_RATES; r++)
+        {
+            for (size_t c = 0; c < MAX_COUNTERS; c++)
+            {
+                weights[r][c] = r < rates.size() && (rates[r].second & (1 << c)) ? 1.0 : 0.0;
+            }
+        }
+        for (const auto &rate : rates)
+        {
+            this->rates.push_back(rate.first);
+        }
+    }
+
+    string name;
+    string luaPlugin;
+    vector<string> counters;
+    vector<string> lastFields;
+    // Counters without which the object is skipped, the others are 0
+    // when they are missing
+    uint8_t required;
+    vector<string> rates;
+    double weights[MAX_RATES][MAX_COUNTERS];
+    bool fec;
+};
+
+static string formatNumber(double value)
+{
+    // The number format of the Lua plugins
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.14g", value);
+    return buffer;
+}
+
+const RateCounters::Spec& RateCounters::getSpec(Type type)
+{
+    static const Spec port("PORT", "port_rates.lua",
+            {
+                "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+                "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+                "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+                "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+                "SAI_PORT_STAT_IF_IN_OCTETS",
+                "SAI_PORT_STAT_IF_OUT_OCTETS",
+                "SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS",
+                "SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES",
+            },
+            {
+                "SAI_PORT_STAT_IF_IN_UCAST_PKTS_last",
+                "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last",
+                "SAI_PORT_STAT_IF_OUT_UCAST_PKTS_last",
+                "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS_last",
+                "SAI_PORT_STAT_IF_IN_OCTETS_last",
+                "SAI_PORT_STAT_IF_OUT_OCTETS_last",
+                // As port_rates.lua names them
+                "SAI_PORT_STAT_IF_FEC_CORRECTED_BITS_last",
+                "SAI_PORT_STAT_IF_FEC_NOT_CORRECTABLE_FARMES_last",
+            },
+            0x3f,
+            {{"RX_BPS", 0x10}, {"RX_PPS", 0x03}, {"TX_BPS", 0x20}, {"TX_PPS", 0x0c}},
+            true);
+    static const Spec rif("RIF", "rif_rates.lua",
+            {
+                "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS",
+                "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS",
+                "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS",
+                "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS",
+            },
+            {},
+            0x0f,
+            {{"RX_BPS", 0x01}, {"RX_PPS", 0x02}, {"TX_BPS", 0x04}, {"TX_PPS", 0x08}},
+            false);
+    static const Spec trap("TRAP", "trap_rates.lua",
+            {
+                "SAI_COUNTER_STAT_PACKETS",
+            },
+            {},
+            0,
+            {{"RX_PPS", 0x01}},
+            false);
+    static const Spec tunnel("TUNNEL", "tunnel_rates.lua",
+            {
+                "SAI_TUNNEL_STAT_IN_OCTETS",
+                "SAI_TUNNEL_STAT_IN_PACKETS",
+                "SAI_TUNNEL_STAT_OUT_OCTETS",
+                "SAI_TUNNEL_STAT_OUT_PACKETS",
+            },
+            {},
+            0,
+            {{"RX_BPS", 0x01}, {"RX_PPS", 0x02}, {"TX_BPS", 0x04}, {"TX_PPS", 0x08}},
+            false);
+
+    switch (type)
+    {
+        case Type::PORT:
+            return port;
+        case Type::RIF:
+            return rif;
+        case Type::TRAP:
+            return trap;
+        case Type::TUNNEL:
+        default:
+            return tunnel;
+    }
+}
+
+RateCounters::RateCounters(Type type, DBConnector *countersDb, const string &group):
+    m_spec(getSpec(type)),
+    m_reader(group),
+    m_batchReader(countersDb, COUNTERS_TABLE),
+    m_pipeline(countersDb, RATES_PIPELINE_SIZE),
+    m_ratesTable(&m_pipeline, RATES_TABLE_NAME, true)
+{
+    SWSS_LOG_ENTER();
+
+    resolveCounters();
+}
+
+const string& RateCounters::getName(void) const
+{
+    return m_spec.name;
+}
+
+const string& RateCounters::getLuaPlugin(void) const
+{
+    return m_spec.luaPlugin;
+}
+
+void RateCounters::setSerdesRateGetter(SerdesRateGetter getter)
+{
+    m_serdesRateGetter = getter;
+    for (auto &object : m_objects)
+    {
+        object.serdesRateAge = 0;
+    }
+}
+
+double RateCounters::getSerdesRate(uint32_t laneCount, uint32_t speed)
+{
+    if (laneCount == 0 || speed == 0 || speed % laneCount != 0)
+    {
+        return 0;
+    }
+
+    double serdes;
+    switch (speed / laneCount)
+    {
+        case 1000:
+            serdes = 1.25e+9;
+            break;
+        case 10000:
+            serdes = 10.3125e+9;
+            break;
+        case 25000:
+            serdes = 25.78125e+9;
+            break;
+        case 50000:
+            serdes = 53.125e+9;
+            break;
+        case 100000:
+            serdes = 106.25e+9;
+            break;
+        default:
+            return 0;
+    }
+
+    return laneCount * serdes;
+}
+
+size_t RateCounters::getObject(const string &key)
+{
+    auto it = m_objectIndex.find(key);
+    if (it != m_objectIndex.end())
+    {
+        return it->second;
+    }
+
+    Object object;
+    object.key = key;
+    try
+    {
+        sai_deserialize_object_id(key, object.id);
+    }
+    catch (const exception &e)
+    {
+        // Read from the COUNTERS table only
+        object.id = SAI_NULL_OBJECT_ID;
+    }
+
+    size_t slot = m_objects.size();
+    m_objects.push_back(move(object));
+    m_objectIndex.emplace(key, slot);
+    m_last.resize(m_objects.size() * MAX_COUNTERS, 0);
+    m_rates.resize(m_objects.size() * MAX_RATES, 0);
+
+    return slot;
+}
+
+void RateCounters::resolveCounters(void)
+{
+    m_layout = m_snapshot.getLayout();
+    for (size_t c = 0; c < MAX_COUNTERS; c++)
+    {
+        m_counterIndex[c] = c < m_spec.counters.size() ?
+            m_snapshot.getCounterIndex(m_spec.counters[c]) : CounterSnapshot::NOT_FOUND;
+    }
+}
+
+bool RateCounters::readSnapshotCounters(const Object &object, uint64_t *values, uint8_t &present)
+{
+    present = 0;
+
+    size_t objectIdx = m_snapshotValid && object.id != SAI_NULL_OBJECT_ID ?
+        m_snapshot.getObjectIndex(object.id) : CounterSnapshot::NOT_FOUND;
+    if (objectIdx == CounterSnapshot::NOT_FOUND)
+    {
+        return false;
+    }
+
+    for (size_t c = 0; c < m_spec.counters.size(); c++)
+    {
+        if (m_counterIndex[c] == CounterSnapshot::NOT_FOUND)
+        {
+            continue;
+        }
+
+        uint64_t value = m_snapshot.getValue(objectIdx, m_counterIndex[c]);
+        if (value != CounterSnapshot::NOT_AVAILABLE)
+        {
+            values[c] = value;
+            present |= static_cast<uint8_t>(1 << c);
+        }
+    }
+
+    return true;
+}
+
+void RateCounters::parseCounters(const vector<FieldValueTuple> &fvs, uint64_t *values, uint8_t &present)
+{
+    for (const auto &fv : fvs)
+    {
+        for (size_t c = 0; c < m_spec.counters.size(); c++)
+        {
+            if (fvField(fv) != m_spec.counters[c])
+            {
+                continue;
+            }
+
+            const char *str = fvValue(fv).c_str();
+            char *end;
+            uint64_t value = strtoull(str, &end, 10);
+            if (end != str && *end == '\0')
+            {
+                values[c] = value;
+                present |= static_cast<uint8_t>(1 << c);
+            }
+            break;
+        }
+    }
+}
+
+void RateCounters::updateFec(Object &object, uint32_t pollTime, const uint64_t *current,
+        const uint64_t *last, vector<FieldValueTuple> &values)
+{
+    // -1 until there are two polls of FEC counters and the serdes rate of
+    // the port is known
+    double preBer = -1;
+    double postBer = -1;
+
+    if (object.state != State::NONE && object.hasFecLast)
+    {
+        if (object.serdesRateAge == 0)
+        {
+            object.serdesRate = m_serdesRateGetter ? m_serdesRateGetter(object.id) : 0;
+            object.serdesRateAge = RATES_SERDES_RATE_REFRESH_POLLS;
+        }
+        object.serdesRateAge--;
+
+        if (object.serdesRate > 0)
+        {
+            double serdesBits = object.serdesRate * pollTime / 1000;
+            preBer = (static_cast<double>(current[PORT_FEC_CORRECTED_BITS]) -
+                      static_cast<double>(last[PORT_FEC_CORRECTED_BITS])) / serdesBits;
+            postBer = (static_cast<double>(current[PORT_FEC_NOT_CORRECTABLE_FRAMES]) -
+                       static_cast<double>(last[PORT_FEC_NOT_CORRECTABLE_FRAMES])) *
+                      RATES_RS_AVERAGE_FRAME_BER / serdesBits;
+        }
+    }
+
+    values.emplace_back(m_spec.lastFields[PORT_FEC_CORRECTED_BITS], to_string(current[PORT_FEC_CORRECTED_BITS]));
+    values.emplace_back(m_spec.lastFields[PORT_FEC_NOT_CORRECTABLE_FRAMES], to_string(current[PORT_FEC_NOT_CORRECTABLE_FRAMES]));
+    values.emplace_back(RATES_FEC_PRE_BER_FIELD, formatNumber(preBer));
+    values.emplace_back(RATES_FEC_POST_BER_FIELD, formatNumber(postBer));
+    object.hasFecLast = true;
+}
+
+void RateCounters::poll(uint32_t pollTime, const vector<string> &keys)
+{
+    SWSS_LOG_ENTER();
+
+    // No rates are computed until the smoothing factor is configured, as
+    // in the Lua plugins
+    string alphaStr;
+    m_stats.commands++;
+    m_stats.roundTrips++;
+    if (!m_ratesTable.hget(m_spec.name, m_spec.name + "_ALPHA", alphaStr))
+    {
+        SWSS_LOG_DEBUG("%s_ALPHA is not defined", m_spec.name.c_str());
+        return;
+    }
+
+    char *end;
+    double alpha = strtod(alphaStr.c_str(), &end);
+    if (end == alphaStr.c_str() || *end != '\0')
+    {
+        SWSS_LOG_WARN("Invalid %s_ALPHA %s", m_spec.name.c_str(), alphaStr.c_str());
+        return;
+    }
+
+    if (pollTime == 0)
+    {
+        SWSS_LOG_WARN("Invalid %s rates poll time 0", m_spec.name.c_str());
+        return;
+    }
+
+    m_pollCount++;
+    m_stats.polls++;
+    m_slots.clear();
+    for (const auto &key : keys)
+    {
+        size_t slot = getObject(key);
+        if (m_objects[slot].poll != m_pollCount)
+        {
+            m_objects[slot].poll = m_pollCount;
+            m_slots.push_back(slot);
+        }
+    }
+
+    const size_t count = m_slots.size();
+    m_current.assign(count * MAX_COUNTERS, 0);
+    m_present.assign(count, 0);
+    m_valid.assign(count, 0);
+    m_newRates.assign(count * MAX_RATES, 0);
+
+    m_snapshotValid = m_reader.read(m_snapshot);
+    if (m_snapshotValid && m_snapshot.getLayout() != m_layout)
+    {
+        resolveCounters();
+    }
+
+    m_batchKeys.clear();
+    m_batchSlots.clear();
+    for (size_t i = 0; i < count; i++)
+    {
+        const Object &object = m_objects[m_slots[i]];
+        if (!readSnapshotCounters(object, &m_current[i * MAX_COUNTERS], m_present[i]))
+        {
+            m_batchKeys.push_back(object.key);
+            m_batchSlots.push_back(i);
+        }
+    }
+
+    // The objects that are not in the snapshot are read from the COUNTERS
+    // table, all in one batch
+    if (!m_batchKeys.empty())
+    {
+        m_batchReader.get(m_batchKeys, m_batchValues);
+        m_stats.commands += m_batchKeys.size();
+        m_stats.roundTrips++;
+
+        for (size_t j = 0; j < m_batchSlots.size(); j++)
+        {
+            size_t i = m_batchSlots[j];
+            parseCounters(m_batchValues[j], &m_current[i * MAX_COUNTERS], m_present[i]);
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_valid[i] = (m_present[i] & m_spec.required) == m_spec.required;
+    }
+
+    // The rates of all the objects, over arrays of fixed width. The first
+    // rates of an object are stored unsmoothed.
+    const double scale = 1000.0 / pollTime;
+    for (size_t i = 0; i < count; i++)
+    {
+        const size_t slot = m_slots[i];
+        const uint64_t *current = &m_current[i * MAX_COUNTERS];
+        const uint64_t *last = &m_last[slot * MAX_COUNTERS];
+        const double *rates = &m_rates[slot * MAX_RATES];
+        double *newRates = &m_newRates[i * MAX_RATES];
+        const double a = m_objects[slot].state == State::DONE ? alpha : 1.0;
+
+        double delta[MAX_COUNTERS];
+        for (size_t c = 0; c < MAX_COUNTERS; c++)
+        {
+            delta[c] = (static_cast<double>(current[c]) - static_cast<double>(last[c])) * scale;
+        }
+
+        for (size_t r = 0; r < MAX_RATES; r++)
+        {
+            double rate = 0;
+            for (size_t c = 0; c < MAX_COUNTERS; c++)
+            {
+                rate += m_spec.weights[r][c] * delta[c];
+            }
+            newRates[r] = a * rate + (1.0 - a) * rates[r];
+        }
+    }
+
+    vector<FieldValueTuple> values;
+    uint64_t writes = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!m_valid[i])
+        {
+            continue;
+        }
+
+        const size_t slot = m_slots[i];
+        Object &object = m_objects[slot];
+        const uint64_t *current = &m_current[i * MAX_COUNTERS];
+        uint64_t *last = &m_last[slot * MAX_COUNTERS];
+        const double *newRates = &m_newRates[i * MAX_RATES];
+
+        values.clear();
+        if (object.state != State::NONE)
+        {
+            for (size_t r = 0; r < m_spec.rates.size(); r++)
+            {
+                values.emplace_back(m_spec.rates[r], formatNumber(newRates[r]));
+            }
+            copy_n(newRates, MAX_RATES, &m_rates[slot * MAX_RATES]);
+        }
+
+        for (size_t c = 0; c < m_spec.counters.size(); c++)
+        {
+            if (m_spec.fec && c >= PORT_FEC_CORRECTED_BITS)
+            {
+                break;
+            }
+            values.emplace_back(m_spec.lastFields[c], to_string(current[c]));
+            last[c] = current[c];
+        }
+
+        // The FEC counters are optional, their fields are left as they are
+        // when a port has none
+        if (m_spec.fec && (m_present[i] & PORT_FEC_MASK) == PORT_FEC_MASK)
+        {
+            updateFec(object, pollTime, current, last, values);
+            last[PORT_FEC_CORRECTED_BITS] = current[PORT_FEC_CORRECTED_BITS];
+            last[PORT_FEC_NOT_CORRECTABLE_FRAMES] = current[PORT_FEC_NOT_CORRECTABLE_FRAMES];
+        }
+
+        m_ratesTable.set(object.key, values);
+        writes++;
+
+        if (object.state == State::NONE)
+        {
+            object.state = State::COUNTERS_LAST;
+            m_ratesTable.set(object.key + ":" + m_spec.name, { { RATES_INIT_DONE_FIELD, "COUNTERS_LAST" } });
+            writes++;
+        }
+        else if (object.state == State::COUNTERS_LAST)
+        {
+            object.state = State::DONE;
+            m_ratesTable.set(object.key + ":" + m_spec.name, { { RATES_INIT_DONE_FIELD, "DONE" } });
+            writes++;
+        }
+    }
+
+    m_ratesTable.flush();
+    m_stats.commands += writes;
+    m_stats.roundTrips += writes != 0;
+
+    removeStaleObjects();
+}
+
+void RateCounters::removeStaleObjects(void)
+{
+    size_t slot = 0;
+    while (slot < m_objects.size())
+    {
+        if (m_objects[slot].poll == m_pollCount)
+        {
+            slot++;
+            continue;
+        }
+
+        size_t back = m_objects.size() - 1;
+        m_objectIndex.erase(m_objects[slot].key);
+        if (slot != back)
+        {
+            m_objects[slot] = move(m_objects[back]);
+            m_objectIndex[m_objects[slot].key] = slot;
+            copy_n(&m_last[back * MAX_COUNTERS], MAX_COUNTERS, &m_last[slot * MAX_COUNTERS]);
+            copy_n(&m_rates[back * MAX_RATES], MAX_RATES, &m_rates[slot * MAX_RATES]);
+        }
+
+        m_objects.pop_back();
+        m_last.resize(m_objects.size() * MAX_COUNTERS);
+        m_rates.resize(m_objects.size() * MAX_RATES);
+    }
+}
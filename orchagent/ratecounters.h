@@ -0,0 +1,154 @@
+#ifndef RATE_COUNTERS_H
+#define RATE_COUNTERS_H
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "dbconnector.h"
+#include "redispipeline.h"
+#include "table.h"
+#include "countersnapshot.h"
+#include "tablebatchreader.h"
+
+extern "C" {
+#include "sai.h"
+}
+
+#define RATES_POLL_CHANNEL              "RATES_POLL"
+#define RATES_POLL_NOTIFY_PLUGIN        "rates_poll_notify.lua"
+
+// In-process rate computation of the port, RIF, trap and tunnel counters.
+// It computes the rates of port_rates.lua, rif_rates.lua, trap_rates.lua
+// and tunnel_rates.lua and writes them with the *_last counters and the
+// INIT_DONE state to the same RATES fields, so that the Lua plugins can
+// take over again. The counters of the last poll and the rates are kept
+// in fixed-size arrays instead of being read back from redis.
+class RateCounters
+{
+    public:
+        enum class Type
+        {
+            PORT,
+            RIF,
+            TRAP,
+            TUNNEL,
+        };
+
+        static const size_t MAX_COUNTERS = 8;
+        static const size_t MAX_RATES = 4;
+
+        // Serdes rate of all the lanes of a port, in bits per second, 0 if
+        // it is not known
+        typedef std::function<double(sai_object_id_t)> SerdesRateGetter;
+
+        // The counters are read from the counter snapshot region of the
+        // flex counter group, when the counter poller publishes one, else
+        // from the COUNTERS table
+        RateCounters(Type type, swss::DBConnector *countersDb, const std::string &group);
+
+        // Name of the rates in the RATES table: PORT, RIF, TRAP or TUNNEL
+        const std::string& getName(void) const;
+        // Lua plugin that computes the same rates in redis
+        const std::string& getLuaPlugin(void) const;
+
+        // FEC BER of the ports, not computed without it
+        void setSerdesRateGetter(SerdesRateGetter getter);
+        // Serdes rate of a port of the lane count and speed in Mbps, as
+        // port_rates.lua computes it
+        static double getSerdesRate(uint32_t laneCount, uint32_t speed);
+
+        // Compute the rates of the objects of a poll, as the keys of the
+        // COUNTERS table, over the poll time in msec. The objects that are
+        // not in the poll are forgotten.
+        void poll(uint32_t pollTime, const std::vector<std::string> &keys);
+
+        inline size_t getObjectCount(void) const
+        {
+            return m_objects.size();
+        }
+
+        // Redis commands of the polls, and the round trips they took: the
+        // smoothing factor read, the counters read from the COUNTERS table
+        // in one batch, and the writes flushed at once
+        struct Stats
+        {
+            uint64_t polls = 0;
+            uint64_t commands = 0;
+            uint64_t roundTrips = 0;
+        };
+
+        inline const Stats& getStats(void) const
+        {
+            return m_stats;
+        }
+
+    private:
+        enum class State : uint8_t
+        {
+            NONE,
+            COUNTERS_LAST,
+            DONE,
+        };
+
+        struct Object
+        {
+            std::string key;
+            sai_object_id_t id = SAI_NULL_OBJECT_ID;
+            State state = State::NONE;
+            uint64_t poll = 0;
+
+            bool hasFecLast = false;
+            double serdesRate = 0;
+            uint32_t serdesRateAge = 0;
+        };
+
+        struct Spec;
+        static const Spec& getSpec(Type type);
+
+        size_t getObject(const std::string &key);
+        void resolveCounters(void);
+        bool readSnapshotCounters(const Object &object, uint64_t *values, uint8_t &present);
+        void parseCounters(const std::vector<swss::FieldValueTuple> &fvs, uint64_t *values, uint8_t &present);
+        void updateFec(Object &object, uint32_t pollTime, const uint64_t *current,
+                const uint64_t *last, std::vector<swss::FieldValueTuple> &values);
+        void removeStaleObjects(void);
+
+        const Spec &m_spec;
+        SerdesRateGetter m_serdesRateGetter;
+
+        swss::CounterSnapshotReader m_reader;
+        swss::CounterSnapshot m_snapshot;
+        bool m_snapshotValid = false;
+        uint64_t m_layout = 0;
+        size_t m_counterIndex[MAX_COUNTERS];
+
+        // Objects of the poll that are not in the snapshot, by their index
+        // in the poll
+        swss::TableBatchReader m_batchReader;
+        std::vector<std::string> m_batchKeys;
+        std::vector<std::vector<swss::FieldValueTuple>> m_batchValues;
+        std::vector<size_t> m_batchSlots;
+        swss::RedisPipeline m_pipeline;
+        swss::Table m_ratesTable;
+
+        uint64_t m_pollCount = 0;
+        Stats m_stats;
+        std::vector<Object> m_objects;
+        std::unordered_map<std::string, size_t> m_objectIndex;
+
+        // MAX_COUNTERS and MAX_RATES values per object, in the order of
+        // m_objects
+        std::vector<uint64_t> m_last;
+        std::vector<double> m_rates;
+
+        // Objects of the current poll and their counters and rates, in
+        // the order of the poll
+        std::vector<size_t> m_slots;
+        std::vector<uint8_t> m_valid;
+        std::vector<uint64_t> m_current;
+        std::vector<uint8_t> m_present;
+        std::vector<double> m_newRates;
+};
+
+#endif
@@ -0,0 +1,21 @@
+-- KEYS - object IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - counters table name
+-- ARGV[3] - poll time interval (milliseconds)
+-- rates_group - flex counter group of the objects, defined by orchagent
+-- when it loads the script
+-- Notify orchagent that the counters of this poll are written, the rates
+-- themselves are computed in orchagent
+
+local counters_db = ARGV[1]
+
+local message = {'["', rates_group, '","', ARGV[3], '"'}
+for i = 1, #KEYS do
+    message[#message + 1] = ',"' .. KEYS[i] .. '",""'
+end
+message[#message + 1] = ']'
+
+redis.call('SELECT', counters_db)
+redis.call('PUBLISH', 'RATES_POLL', table.concat(message))
+
+return {}
@@ -1,5 +1,6 @@
 #include "response_publisher.h"
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -65,7 +66,7 @@ void RecordResponse(const std::string &response_channel, const std::string &key,
 } // namespace
 
 ResponsePublisher::ResponsePublisher(const std::string &dbName, bool buffered, bool db_write_thread)
-    : m_db(std::make_unique<swss::DBConnector>(dbName, 0)), m_buffered(buffered)
+    : m_db_name(dbName), m_db(std::make_unique<swss::DBConnector>(dbName, 0)), m_buffered(buffered)
 {
     if (m_buffered)
     {
@@ -79,6 +80,7 @@ ResponsePublisher::ResponsePublisher(const std::string &dbName, bool buffered, b
     }
     if (db_write_thread)
     {
+        m_ring.resize(RESPONSE_PUBLISHER_QUEUE_SIZE);
         m_update_thread = std::unique_ptr<std::thread>(new std::thread(&ResponsePublisher::dbUpdateThread, this));
     }
 }
@@ -87,12 +89,10 @@ ResponsePublisher::~ResponsePublisher()
 {
     if (m_update_thread != nullptr)
     {
-        {
-            std::lock_guard<std::mutex> lock(m_lock);
-            m_queue.emplace(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
-                            /*replace=*/false, /*flush=*/false, /*shutdown=*/true);
-        }
-        m_signal.notify_one();
+        auto &e = reserveEntry();
+        e.flush = false;
+        e.shutdown = true;
+        commitEntry();
         m_update_thread->join();
     }
 }
@@ -142,11 +142,18 @@ void ResponsePublisher::writeToDB(const std::string &table, const std::string &k
 {
     if (m_update_thread != nullptr)
     {
-        {
-            std::lock_guard<std::mutex> lock(m_lock);
-            m_queue.emplace(table, key, values, op, replace, /*flush=*/false, /*shutdown=*/false);
-        }
-        m_signal.notify_one();
+        // The entry keeps the buffers of its previous use, assign reuses them.
+        auto &e = reserveEntry();
+        e.table.assign(table);
+        e.key.assign(key);
+        e.values.assign(values.begin(), values.end());
+        e.op.assign(op);
+        e.replace = replace;
+        e.flush = false;
+        e.shutdown = false;
+        e.queued = std::chrono::steady_clock::now();
+        commitEntry();
+        m_entries.fetch_add(1, std::memory_order_relaxed);
     }
     else
     {
@@ -161,37 +168,36 @@ void ResponsePublisher::writeToDBInternal(const std::string &table, const std::s
 {
     swss::Table applStateTable{m_db_pipe.get(), table, m_buffered};
 
-    auto attrs = values;
     if (op == SET_COMMAND)
     {
         if (replace)
         {
             applStateTable.del(key);
         }
-        if (!values.size())
-        {
-            attrs.push_back(swss::FieldValueTuple("NULL", "NULL"));
-        }
 
-        // Write to DB only if the key does not exist or non-NULL attributes are
-        // being written to the entry.
-        std::vector<swss::FieldValueTuple> fv;
-        if (!applStateTable.get(key, fv))
-        {
-            applStateTable.set(key, attrs);
-            return;
-        }
-        for (auto it = attrs.cbegin(); it != attrs.cend();)
+        // A "NULL" attribute is only a placeholder for an entry without
+        // attributes, it is written when the entry does not exist yet.
+        std::vector<swss::FieldValueTuple> attrs;
+        bool null = values.empty();
+        for (const auto &value : values)
         {
-            if (it->first == "NULL")
+            if (value.first == "NULL")
             {
-                it = attrs.erase(it);
+                null = true;
             }
             else
             {
-                it++;
+                attrs.push_back(value);
             }
         }
+
+        // Only this case needs to read the entry, the other writes are just
+        // pipelined.
+        std::vector<swss::FieldValueTuple> fv;
+        if (null && (replace || !applStateTable.get(key, fv)))
+        {
+            attrs.push_back(swss::FieldValueTuple("NULL", "NULL"));
+        }
         if (attrs.size())
         {
             applStateTable.set(key, attrs);
@@ -208,12 +214,10 @@ void ResponsePublisher::flush()
     m_ntf_pipe->flush();
     if (m_update_thread != nullptr)
     {
-        {
-            std::lock_guard<std::mutex> lock(m_lock);
-            m_queue.emplace(/*table=*/"", /*key=*/"", /*values =*/std::vector<swss::FieldValueTuple>{}, /*op=*/"",
-                            /*replace=*/false, /*flush=*/true, /*shutdown=*/false);
-        }
-        m_signal.notify_one();
+        auto &e = reserveEntry();
+        e.flush = true;
+        e.shutdown = false;
+        commitEntry();
     }
     else
     {
@@ -226,32 +230,241 @@ void ResponsePublisher::setBuffered(bool buffered)
     m_buffered = buffered;
 }
 
+ResponsePublisher::Stats ResponsePublisher::getStats() const
+{
+    Stats stats;
+    stats.entries = m_entries.load(std::memory_order_relaxed);
+    stats.writes = m_writes.load(std::memory_order_relaxed);
+    stats.coalesced = m_coalesced.load(std::memory_order_relaxed);
+    stats.queue_full = m_queue_full.load(std::memory_order_relaxed);
+    stats.queue_depth = m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed);
+    stats.max_queue_depth = m_max_queue_depth.load(std::memory_order_relaxed);
+    stats.latency_total_us = m_latency_total_us.load(std::memory_order_relaxed);
+    stats.latency_max_us = m_latency_max_us.load(std::memory_order_relaxed);
+    return stats;
+}
+
+ResponsePublisher::entry &ResponsePublisher::reserveEntry()
+{
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    if (tail - m_head.load(std::memory_order_acquire) == m_ring.size())
+    {
+        // Nothing is dropped, the publisher waits for the DB write thread.
+        m_queue_full.fetch_add(1, std::memory_order_relaxed);
+        while (tail - m_head.load(std::memory_order_acquire) == m_ring.size())
+        {
+            std::this_thread::yield();
+        }
+    }
+    return m_ring[tail & (m_ring.size() - 1)];
+}
+
+void ResponsePublisher::commitEntry()
+{
+    auto tail = m_tail.load(std::memory_order_relaxed) + 1;
+    m_tail.store(tail, std::memory_order_seq_cst);
+
+    auto depth = tail - m_head.load(std::memory_order_relaxed);
+    if (depth > m_max_queue_depth.load(std::memory_order_relaxed))
+    {
+        m_max_queue_depth.store(depth, std::memory_order_relaxed);
+    }
+
+    // Pairs with the store of m_waiting then the load of m_tail in
+    // waitForEntries(), one of the two sides sees the other.
+    if (m_waiting.load(std::memory_order_seq_cst))
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_signal.notify_one();
+    }
+}
+
+void ResponsePublisher::waitForEntries()
+{
+    m_waiting.store(true, std::memory_order_seq_cst);
+    {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_signal.wait_for(lock, std::chrono::seconds(RESPONSE_PUBLISHER_STATS_INTERVAL), [this]() {
+            return m_tail.load(std::memory_order_seq_cst) != m_head.load(std::memory_order_relaxed);
+        });
+    }
+    m_waiting.store(false, std::memory_order_relaxed);
+}
+
 void ResponsePublisher::dbUpdateThread()
 {
+    swss::DBConnector stateDb("STATE_DB", 0);
+    swss::Table statsTable(&stateDb, RESPONSE_PUBLISHER_STATS_TABLE);
+    auto statsTime = std::chrono::steady_clock::now();
+
     while (true)
     {
-        entry e;
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto tail = m_tail.load(std::memory_order_acquire);
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - statsTime >= std::chrono::seconds(RESPONSE_PUBLISHER_STATS_INTERVAL))
+        {
+            publishStats(statsTable);
+            statsTime = now;
+        }
+
+        if (head == tail)
+        {
+            // Caught up with the publisher, send what was coalesced so far.
+            writePendingWrites();
+            waitForEntries();
+            continue;
+        }
+
+        for (; head != tail; head++)
         {
-            std::unique_lock<std::mutex> lock(m_lock);
-            while (m_queue.empty())
+            auto &e = m_ring[head & (m_ring.size() - 1)];
+            if (e.shutdown)
+            {
+                writePendingWrites();
+                m_db_pipe->flush();
+                m_head.store(head + 1, std::memory_order_release);
+                publishStats(statsTable);
+                return;
+            }
+            if (e.flush)
+            {
+                writePendingWrites();
+                m_db_pipe->flush();
+            }
+            else
             {
-                m_signal.wait(lock);
+                queuePendingWrite(e);
             }
+            m_head.store(head + 1, std::memory_order_release);
+        }
+    }
+}
+
+// Merges the write of the entry into the pending write of its key, so that
+// applying the pending write gives the same DB content as applying both.
+void ResponsePublisher::queuePendingWrite(entry &e)
+{
+    std::string id = e.table + ":" + e.key;
+    auto it = m_pending_index.find(id);
+    if (it == m_pending_index.end())
+    {
+        if (m_pending_count == m_pending.size())
+        {
+            m_pending.emplace_back();
+        }
+        auto &w = m_pending[m_pending_count];
+        m_pending_index.emplace(std::move(id), m_pending_count++);
+
+        // Swap the buffers, the ring entry gets back the ones of an earlier write.
+        w.table.swap(e.table);
+        w.key.swap(e.key);
+        w.values.swap(e.values);
+        w.op.swap(e.op);
+        w.replace = e.replace;
+        w.queued = e.queued;
+        if (w.op == SET_COMMAND && w.values.empty())
+        {
+            w.values.emplace_back("NULL", "NULL");
+        }
+        return;
+    }
 
-            e = m_queue.front();
-            m_queue.pop();
+    auto &w = m_pending[it->second];
+    m_coalesced.fetch_add(1, std::memory_order_relaxed);
+
+    if (e.op == DEL_COMMAND)
+    {
+        w.op.assign(DEL_COMMAND);
+        w.values.clear();
+        w.replace = false;
+        return;
+    }
+
+    if (e.replace || w.op == DEL_COMMAND)
+    {
+        // A delete followed by a set is a replace.
+        w.op.assign(SET_COMMAND);
+        w.values.swap(e.values);
+        w.replace = true;
+        if (w.values.empty())
+        {
+            w.values.emplace_back("NULL", "NULL");
         }
-        if (e.shutdown)
+        return;
+    }
+
+    // The entry exists once the pending set is written, the "NULL"
+    // placeholder of this write would be skipped.
+    for (const auto &value : e.values)
+    {
+        if (value.first == "NULL")
         {
-            break;
+            continue;
         }
-        if (e.flush)
+        bool found = false;
+        for (auto &fv : w.values)
         {
-            m_db_pipe->flush();
+            if (fv.first == value.first)
+            {
+                fv.second = value.second;
+                found = true;
+            }
         }
-        else
+        if (!found)
         {
-            writeToDBInternal(e.table, e.key, e.values, e.op, e.replace);
+            w.values.push_back(value);
         }
     }
 }
+
+void ResponsePublisher::writePendingWrites()
+{
+    if (!m_pending_count)
+    {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    uint64_t latency_total_us = 0;
+    uint64_t latency_max_us = m_latency_max_us.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < m_pending_count; i++)
+    {
+        auto &w = m_pending[i];
+        writeToDBInternal(w.table, w.key, w.values, w.op, w.replace);
+
+        auto latency_us =
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(now - w.queued).count());
+        latency_total_us += latency_us;
+        latency_max_us = std::max(latency_max_us, latency_us);
+    }
+
+    m_writes.fetch_add(m_pending_count, std::memory_order_relaxed);
+    m_latency_total_us.fetch_add(latency_total_us, std::memory_order_relaxed);
+    m_latency_max_us.store(latency_max_us, std::memory_order_relaxed);
+
+    m_pending_count = 0;
+    m_pending_index.clear();
+}
+
+void ResponsePublisher::publishStats(swss::Table &statsTable)
+{
+    auto stats = getStats();
+    if (stats.entries == m_published_entries && !stats.queue_depth)
+    {
+        return;
+    }
+    m_published_entries = stats.entries;
+
+    std::vector<swss::FieldValueTuple> fvs = {
+        {"entries", std::to_string(stats.entries)},
+        {"writes", std::to_string(stats.writes)},
+        {"coalesced", std::to_string(stats.coalesced)},
+        {"queue_full", std::to_string(stats.queue_full)},
+        {"queue_depth", std::to_string(stats.queue_depth)},
+        {"max_queue_depth", std::to_string(stats.max_queue_depth)},
+        {"latency_avg_us", std::to_string(stats.writes ? stats.latency_total_us / stats.writes : 0)},
+        {"latency_max_us", std::to_string(stats.latency_max_us)}};
+    statsTable.set(m_db_name, fvs);
+}
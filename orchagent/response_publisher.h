@@ -1,9 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -15,9 +16,22 @@
 #include "response_publisher_interface.h"
 #include "table.h"
 
+// Number of preallocated entries between the publisher and the DB write
+// thread, a power of 2.
+#define RESPONSE_PUBLISHER_QUEUE_SIZE 16384
+
+#define RESPONSE_PUBLISHER_STATS_TABLE "RESPONSE_PUBLISHER_STATS_TABLE"
+// Interval in seconds of the DB write thread stats in STATE_DB.
+#define RESPONSE_PUBLISHER_STATS_INTERVAL 1
+
 // This class performs two tasks when publish is called:
 // 1. Sends a notification into the redis channel.
 // 2. Writes the operation into the DB.
+//
+// With the DB write thread, the DB writes are handed over through a single
+// producer single consumer ring. The thread coalesces the writes of a key
+// queued before it gets to them, and publishes its stats in STATE_DB
+// RESPONSE_PUBLISHER_STATS_TABLE|<dbName>.
 class ResponsePublisher : public ResponsePublisherInterface
 {
   public:
@@ -60,6 +74,27 @@ class ResponsePublisher : public ResponsePublisherInterface
      */
     void setBuffered(bool buffered);
 
+    struct Stats
+    {
+        // Entries queued to the DB write thread.
+        uint64_t entries;
+        // Writes sent to the DB, and writes merged into a later one of the same key.
+        uint64_t writes;
+        uint64_t coalesced;
+        // Times the publisher waited for a free entry.
+        uint64_t queue_full;
+        uint64_t queue_depth;
+        uint64_t max_queue_depth;
+        // From the entry queued to its write sent to the DB.
+        uint64_t latency_total_us;
+        uint64_t latency_max_us;
+    };
+
+    /**
+     * @brief Get the DB write thread stats
+     */
+    Stats getStats() const;
+
   private:
     struct entry
     {
@@ -70,22 +105,21 @@ class ResponsePublisher : public ResponsePublisherInterface
         bool replace;
         bool flush;
         bool shutdown;
-
-        entry()
-        {
-        }
-
-        entry(const std::string &table, const std::string &key, const std::vector<swss::FieldValueTuple> &values,
-              const std::string &op, bool replace, bool flush, bool shutdown)
-            : table(table), key(key), values(values), op(op), replace(replace), flush(flush), shutdown(shutdown)
-        {
-        }
+        std::chrono::steady_clock::time_point queued;
     };
 
+    entry &reserveEntry();
+    void commitEntry();
+    void waitForEntries();
+
     void dbUpdateThread();
+    void queuePendingWrite(entry &e);
+    void writePendingWrites();
+    void publishStats(swss::Table &statsTable);
     void writeToDBInternal(const std::string &table, const std::string &key,
                            const std::vector<swss::FieldValueTuple> &values, const std::string &op, bool replace);
 
+    std::string m_db_name;
     std::unique_ptr<swss::DBConnector> m_db;
     std::unique_ptr<swss::RedisPipeline> m_ntf_pipe;
     std::unique_ptr<swss::RedisPipeline> m_db_pipe;
@@ -93,7 +127,29 @@ class ResponsePublisher : public ResponsePublisherInterface
     bool m_buffered{false};
     // Thread to write to DB.
     std::unique_ptr<std::thread> m_update_thread;
-    std::queue<entry> m_queue;
-    mutable std::mutex m_lock;
+
+    // Ring of entries, written at m_tail by the publisher and read at m_head
+    // by the DB write thread. The indexes only grow.
+    std::vector<entry> m_ring;
+    alignas(64) std::atomic<uint64_t> m_head{0};
+    alignas(64) std::atomic<uint64_t> m_tail{0};
+    // Set while the DB write thread sleeps, the publisher wakes it up then.
+    alignas(64) std::atomic<bool> m_waiting{false};
+    std::mutex m_lock;
     std::condition_variable m_signal;
+
+    // Writes taken from the ring and not sent yet, one per key. The entries
+    // are reused from one batch to the next.
+    std::vector<entry> m_pending;
+    size_t m_pending_count{0};
+    std::unordered_map<std::string, size_t> m_pending_index;
+
+    std::atomic<uint64_t> m_entries{0};
+    std::atomic<uint64_t> m_writes{0};
+    std::atomic<uint64_t> m_coalesced{0};
+    std::atomic<uint64_t> m_queue_full{0};
+    std::atomic<uint64_t> m_max_queue_depth{0};
+    std::atomic<uint64_t> m_latency_total_us{0};
+    std::atomic<uint64_t> m_latency_max_us{0};
+    uint64_t m_published_entries{0};
 };
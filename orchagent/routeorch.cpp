@@ -30,6 +30,7 @@ extern TunnelDecapOrch *gTunneldecapOrch;
 
 extern size_t gMaxBulkSize;
 extern string gMySwitchType;
+extern bool gNhgInPlaceUpdate;
 
 /* Default maximum number of next hop groups */
 #define DEFAULT_NUMBER_OF_ECMP_GROUPS   128
@@ -54,6 +55,14 @@ RouteOrch::RouteOrch(DBConnector *db, vector<table_name_with_pri_t> &tableNames,
 
     m_publisher.setBuffered(true);
 
+    /* Route updates do not depend on key order, use the hashed FIFO index
+     * to avoid ordered key compares on large route tables */
+    auto routeConsumer = dynamic_cast<ConsumerBase *>(getExecutor(APP_ROUTE_TABLE_NAME));
+    if (routeConsumer != nullptr)
+    {
+        routeConsumer->setPendingTaskIndex(SyncMapIndex::Hashed);
+    }
+
     sai_attribute_t attr;
     attr.id = SAI_SWITCH_ATTR_NUMBER_OF_ECMP_GROUPS;
 
@@ -315,18 +324,15 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr, sai_object_
         observerEntry = m_nextHopObservers.find(host);
 
         /* Find the prefixes that cover the destination IP */
-        if (m_syncdRoutes.find(vrf_id) != m_syncdRoutes.end())
+        auto route_table = m_syncdRoutes.find(vrf_id);
+        if (route_table != m_syncdRoutes.end())
         {
-            for (auto route : m_syncdRoutes.at(vrf_id))
-            {
-                if (route.first.isAddressInSubnet(dstAddr))
-                {
-                    SWSS_LOG_INFO("Prefix %s covers destination address",
-                            route.first.to_string().c_str());
-                    observerEntry->second.routeTable.emplace(
-                            route.first, route.second);
-                }
-            }
+            route_table->second.forEachCovering(dstAddr, [&](const RouteTable::value_type &route) {
+                SWSS_LOG_INFO("Prefix %s covers destination address",
+                        route.first.to_string().c_str());
+                observerEntry->second.routeTable.emplace(
+                        route.first, route.second);
+            });
         }
     }
 
@@ -560,7 +566,7 @@ void RouteOrch::doTask(Consumer& consumer)
                 {
                     /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                     SWSS_LOG_NOTICE("Start resync routes\n");
-                    for (auto j : m_syncdRoutes)
+                    for (const auto &j : m_syncdRoutes)
                     {
                         string vrf;
 
@@ -569,7 +575,7 @@ void RouteOrch::doTask(Consumer& consumer)
                             vrf = m_vrfOrch->getVRFname(j.first) + ":";
                         }
 
-                        for (auto i : j.second)
+                        for (const auto &i : j.second)
                         {
                             vector<FieldValueTuple> v;
                             key = vrf + i.first.to_string();
@@ -1070,6 +1076,8 @@ void RouteOrch::doTask(Consumer& consumer)
                 removeNextHopGroup(it_nhg.first);
             }
         }
+
+        m_bulkNhgPendingRefs.clear();
     }
 }
 
@@ -1575,26 +1583,391 @@ bool RouteOrch::removeNextHopGroup(const NextHopGroupKey &nexthops)
     return true;
 }
 
-void RouteOrch::addNextHopRoute(const NextHopKey& nextHop, const RouteKey& routeKey)
+/*
+ * Check whether the route can move to the next hop group nexthops by updating
+ * the members of its current group in place: the group must be owned by
+ * RouteOrch, used by this route only, and not be referenced by another route
+ * of the current bulk.
+ */
+bool RouteOrch::isNextHopGroupUpdatable(const RouteBulkContext& ctx, const NextHopGroupKey &nexthops)
 {
-    auto it = m_nextHops.find((nextHop));
+    SWSS_LOG_ENTER();
 
-    if (it != m_nextHops.end())
+    if (nexthops.is_overlay_nexthop() || nexthops.is_srv6_nexthop())
+    {
+        return false;
+    }
+
+    /* Members of ordered groups have to be re-sequenced, recreate the group */
+    if (m_switchOrch->checkOrderedEcmpEnable())
+    {
+        return false;
+    }
+
+    auto it_table = m_syncdRoutes.find(ctx.vrf_id);
+    if (it_table == m_syncdRoutes.end())
+    {
+        return false;
+    }
+
+    auto it_route = it_table->second.find(ctx.ip_prefix);
+    if (it_route == it_table->second.end() || !it_route->second.nhg_index.empty())
+    {
+        return false;
+    }
+
+    const NextHopGroupKey& current = it_route->second.nhg_key;
+    if (current.getSize() <= 1 || current.is_overlay_nexthop() || current.is_srv6_nexthop())
     {
-        if (it->second.find(routeKey) != it->second.end())
+        return false;
+    }
+
+    auto it_nhg = m_syncdNextHopGroups.find(current);
+    if (it_nhg == m_syncdNextHopGroups.end() || it_nhg->second.ref_count != 1 ||
+        m_bulkNhgPendingRefs.find(current) != m_bulkNhgPendingRefs.end())
+    {
+        return false;
+    }
+
+    if (m_fgNhgOrch->syncdContainsFgNhg(ctx.vrf_id, ctx.ip_prefix))
+    {
+        return false;
+    }
+
+    sai_route_entry_t route_entry;
+    route_entry.vr_id = ctx.vrf_id;
+    route_entry.switch_id = gSwitchId;
+    copy(route_entry.destination, ctx.ip_prefix);
+    if (gRouteBulker.bulk_entry_pending_removal(route_entry))
+    {
+        return false;
+    }
+
+    /* Routes over mux next hops are tracked per next hop, keep the regular flow */
+    MuxOrch* mux_orch = gDirectory.get<MuxOrch*>();
+    if (mux_orch->isMuxNexthops(current) || mux_orch->isMuxNexthops(nexthops))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Move the next hop group of key current to key nexthops without recreating
+ * it: the members that are not in nexthops are removed from the SAI group and
+ * the new members are added, the group keeps its SAI ID and its references.
+ * The members whose weight changed are kept and their weight is set. New
+ * members are added before the old ones are removed so that traffic is not
+ * blackholed while the group is updated. Returns false if the group is left
+ * unchanged, in which case a new group has to be created.
+ */
+bool RouteOrch::updateNextHopGroup(const NextHopGroupKey &current, const NextHopGroupKey &nexthops)
+{
+    SWSS_LOG_ENTER();
+
+    auto it_nhg = m_syncdNextHopGroups.find(current);
+    assert(it_nhg != m_syncdNextHopGroups.end());
+    assert(!hasNextHopGroup(nexthops));
+
+    sai_object_id_t next_hop_group_id = it_nhg->second.next_hop_group_id;
+    const set<NextHopKey>& cur_next_hops = current.getNextHops();
+    const set<NextHopKey>& new_next_hops = nexthops.getNextHops();
+
+    vector<NextHopKey> removed_next_hops;
+    for (const auto& nh : cur_next_hops)
+    {
+        if (new_next_hops.find(nh) == new_next_hops.end())
         {
-            SWSS_LOG_INFO("Route already present in nh table %s",
-                          routeKey.prefix.to_string().c_str());
-            return;
+            removed_next_hops.push_back(nh);
         }
+    }
 
-        it->second.insert(routeKey);
+    /* Next hops kept in the group, with their new weight when it changed */
+    vector<NextHopKey> added_next_hops;
+    vector<NextHopKey> reweighted_next_hops;
+    for (const auto& nh : new_next_hops)
+    {
+        auto it = cur_next_hops.find(nh);
+        if (it == cur_next_hops.end())
+        {
+            added_next_hops.push_back(nh);
+        }
+        else if (it->weight != nh.weight)
+        {
+            reweighted_next_hops.push_back(nh);
+        }
     }
-    else
+
+    /* All the new next hops must be resolved, else let addNextHopGroup handle them */
+    for (const auto& nh : added_next_hops)
+    {
+        if (!m_neighOrch->hasNextHop(nh) &&
+            !(nh.isMplsNextHop() && m_neighOrch->hasNextHop(NextHopKey(nh.ip_address, nh.alias))))
+        {
+            SWSS_LOG_INFO("Failed to get next hop %s in %s",
+                    nh.to_string().c_str(), nexthops.to_string().c_str());
+            return false;
+        }
+    }
+
+    /* The group must keep at least one active member */
+    if (std::all_of(new_next_hops.begin(), new_next_hops.end(), [this](const NextHopKey& nh) {
+            return m_neighOrch->isNextHopFlagSet(nh, NHFLAGS_IFDOWN);
+        }))
+    {
+        SWSS_LOG_INFO("Skipping update of next hop group %s as none of nexthop are active",
+                      current.to_string().c_str());
+        return false;
+    }
+
+    vector<sai_object_id_t> next_hop_ids;
+    vector<NextHopKey> created_next_hops;
+    /* MPLS next hops created here, removed again if the group is left unchanged */
+    vector<NextHopKey> created_mpls_next_hops;
+    for (const auto& nh : added_next_hops)
+    {
+        if (!m_neighOrch->hasNextHop(nh))
+        {
+            NeighborContext ctx = NeighborContext(nh);
+            if (m_neighOrch->addNextHop(ctx))
+            {
+                created_mpls_next_hops.push_back(nh);
+            }
+        }
+
+        // skip next hop group member create for neighbor from down port
+        if (m_neighOrch->isNextHopFlagSet(nh, NHFLAGS_IFDOWN))
+        {
+            SWSS_LOG_INFO("Interface down for NH %s, skip this NH", nh.to_string().c_str());
+            continue;
+        }
+
+        next_hop_ids.push_back(m_neighOrch->getNextHopId(nh));
+        created_next_hops.push_back(nh);
+    }
+
+    size_t add_count = next_hop_ids.size();
+    vector<sai_object_id_t> nhgm_ids(add_count);
+    for (size_t i = 0; i < add_count; i++)
+    {
+        vector<sai_attribute_t> nhgm_attrs;
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_GROUP_ID;
+        nhgm_attr.value.oid = next_hop_group_id;
+        nhgm_attrs.push_back(nhgm_attr);
+
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_NEXT_HOP_ID;
+        nhgm_attr.value.oid = next_hop_ids[i];
+        nhgm_attrs.push_back(nhgm_attr);
+
+        if (created_next_hops[i].weight)
+        {
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+            nhgm_attr.value.s32 = created_next_hops[i].weight;
+            nhgm_attrs.push_back(nhgm_attr);
+        }
+
+        gNextHopGroupMemberBulker.create_entry(&nhgm_ids[i],
+                                                 (uint32_t)nhgm_attrs.size(),
+                                                 nhgm_attrs.data());
+    }
+    gNextHopGroupMemberBulker.flush();
+
+    bool created = true;
+    for (size_t i = 0; i < add_count; i++)
     {
-        set<RouteKey> routes;
-        routes.insert(routeKey);
-        m_nextHops.insert(make_pair(nextHop, routes));
+        if (nhgm_ids[i] == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to add next hop %s to group %" PRIx64,
+                           created_next_hops[i].to_string().c_str(), next_hop_group_id);
+            created = false;
+        }
+    }
+
+    auto& nhgm = it_nhg->second.nhopgroup_members;
+
+    /*
+     * Set the weight of the kept members. The member of a down next hop has
+     * no SAI object, it is added back with the weight of the new key.
+     */
+    vector<NextHopKey> reweighted_members;
+    for (const auto& nh : reweighted_next_hops)
+    {
+        if (!created)
+        {
+            break;
+        }
+
+        auto it = nhgm.find(nh);
+        if (it == nhgm.end() || m_neighOrch->isNextHopFlagSet(nh, NHFLAGS_IFDOWN))
+        {
+            continue;
+        }
+
+        sai_attribute_t nhgm_attr;
+        nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+        nhgm_attr.value.s32 = nh.weight ? nh.weight : 1;
+        sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
+                it->second.next_hop_id, &nhgm_attr);
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to set weight %u of next hop %s in group %" PRIx64 ", rv:%d",
+                           nh.weight, nh.to_string().c_str(), next_hop_group_id, status);
+            handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
+            created = false;
+            break;
+        }
+        reweighted_members.push_back(nh);
+    }
+
+    if (!created)
+    {
+        /* Restore the weights of the kept members */
+        for (const auto& nh : reweighted_members)
+        {
+            uint32_t weight = cur_next_hops.find(nh)->weight;
+
+            sai_attribute_t nhgm_attr;
+            nhgm_attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+            nhgm_attr.value.s32 = weight ? weight : 1;
+            sai_status_t status = sai_next_hop_group_api->set_next_hop_group_member_attribute(
+                    nhgm[nh].next_hop_id, &nhgm_attr);
+            if (status != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to restore weight %u of next hop %s in group %" PRIx64 ", rv:%d",
+                               weight, nh.to_string().c_str(), next_hop_group_id, status);
+                handleSaiSetStatus(SAI_API_NEXT_HOP_GROUP, status);
+            }
+        }
+
+        /* Leave the group unchanged, it is recreated by the regular flow */
+        vector<sai_status_t> statuses(add_count, SAI_STATUS_SUCCESS);
+        for (size_t i = 0; i < add_count; i++)
+        {
+            if (nhgm_ids[i] != SAI_NULL_OBJECT_ID)
+            {
+                gNextHopGroupMemberBulker.remove_entry(&statuses[i], nhgm_ids[i]);
+            }
+        }
+        gNextHopGroupMemberBulker.flush();
+
+        for (size_t i = 0; i < add_count; i++)
+        {
+            if (statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to remove next hop group member[%zu] %" PRIx64 ", rv:%d",
+                               i, nhgm_ids[i], statuses[i]);
+                handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
+            }
+        }
+
+        for (const auto& nh : created_mpls_next_hops)
+        {
+            if (m_neighOrch->getNextHopRefCount(nh) == 0)
+            {
+                m_neighOrch->removeMplsNextHop(nh);
+            }
+        }
+        return false;
+    }
+
+    vector<sai_object_id_t> nhgm_removed_ids;
+    for (const auto& nh : removed_next_hops)
+    {
+        auto it = nhgm.find(nh);
+        if (it == nhgm.end())
+        {
+            continue;
+        }
+
+        /* The member of a down next hop was already removed */
+        if (!m_neighOrch->isNextHopFlagSet(nh, NHFLAGS_IFDOWN))
+        {
+            nhgm_removed_ids.push_back(it->second.next_hop_id);
+        }
+        nhgm.erase(it);
+    }
+
+    size_t remove_count = nhgm_removed_ids.size();
+    vector<sai_status_t> statuses(remove_count);
+    for (size_t i = 0; i < remove_count; i++)
+    {
+        gNextHopGroupMemberBulker.remove_entry(&statuses[i], nhgm_removed_ids[i]);
+    }
+    gNextHopGroupMemberBulker.flush();
+
+    for (size_t i = 0; i < add_count; i++)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        nhgm[created_next_hops[i]].next_hop_id = nhgm_ids[i];
+        nhgm[created_next_hops[i]].seq_id = 0;
+    }
+
+    /*
+     * The new members are in use by the group whatever the outcome of the
+     * removals, so the bookkeeping and the re-keying below are completed
+     * before a failed removal is handled. A member that could not be removed
+     * stays counted in CRM.
+     */
+    vector<size_t> failed_removals;
+    for (size_t i = 0; i < remove_count; i++)
+    {
+        if (statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            failed_removals.push_back(i);
+            continue;
+        }
+
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+    }
+
+    /* Take the references on the new next hops before releasing the old ones */
+    for (const auto& nh : added_next_hops)
+    {
+        m_neighOrch->increaseNextHopRefCount(nh);
+    }
+    for (const auto& nh : removed_next_hops)
+    {
+        m_neighOrch->decreaseNextHopRefCount(nh);
+        /* Remove any MPLS-specific NH that was created */
+        if (nh.isMplsNextHop() && m_neighOrch->getNextHopRefCount(nh) == 0)
+        {
+            m_neighOrch->removeMplsNextHop(nh);
+        }
+    }
+
+    /* The group and its route reference move to the new key */
+    NextHopGroupEntry next_hop_group_entry = std::move(it_nhg->second);
+    m_syncdNextHopGroups.erase(it_nhg);
+    m_syncdNextHopGroups.emplace(nexthops, std::move(next_hop_group_entry));
+
+    SWSS_LOG_NOTICE("Update next hop group %s to %s in place, %zu members added, %zu removed, %zu reweighted",
+                    current.to_string().c_str(), nexthops.to_string().c_str(),
+                    added_next_hops.size(), removed_next_hops.size(), reweighted_next_hops.size());
+
+    /* The group moved to the new key, the route has to be updated whatever the removal status */
+    for (size_t i : failed_removals)
+    {
+        SWSS_LOG_ERROR("Failed to remove next hop group member[%zu] %" PRIx64 ", rv:%d",
+                       i, nhgm_removed_ids[i], statuses[i]);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEXT_HOP_GROUP, statuses[i]);
+        if (handle_status == task_success)
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_NEXTHOP_GROUP_MEMBER);
+        }
+    }
+
+    return true;
+}
+
+void RouteOrch::addNextHopRoute(const NextHopKey& nextHop, const RouteKey& routeKey)
+{
+    if (!m_nextHops[nextHop].insert(routeKey).second)
+    {
+        SWSS_LOG_INFO("Route already present in nh table %s",
+                      routeKey.prefix.to_string().c_str());
     }
 }
 
@@ -1604,16 +1977,15 @@ void RouteOrch::removeNextHopRoute(const NextHopKey& nextHop, const RouteKey& ro
 
     if (it != m_nextHops.end())
     {
-        if (it->second.find(routeKey) == it->second.end())
+        if (it->second.erase(routeKey) == 0)
         {
             SWSS_LOG_INFO("Route not present in nh table %s", routeKey.prefix.to_string().c_str());
             return;
         }
 
-        it->second.erase(routeKey);
         if (it->second.empty())
         {
-            m_nextHops.erase(nextHop);
+            m_nextHops.erase(it);
         }
     }
     else
@@ -1895,6 +2267,14 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
     /* The route is pointing to a next hop group */
     else
     {
+        /* Update the members of the group used by the route only, instead of creating a new group */
+        if (gNhgInPlaceUpdate && !hasNextHopGroup(nextHops) &&
+            isNextHopGroupUpdatable(ctx, nextHops) &&
+            updateNextHopGroup(it_route->second.nhg_key, nextHops))
+        {
+            ctx.nhg_updated_in_place = true;
+        }
+
         /* Check if there is already an existing next hop group */
         if (!hasNextHopGroup(nextHops))
         {
@@ -1964,6 +2344,7 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
         }
 
         next_hop_id = m_syncdNextHopGroups[nextHops].next_hop_group_id;
+        m_bulkNhgPendingRefs.insert(nextHops);
     }
 
     /* Sync the route entry */
@@ -2008,6 +2389,11 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
             return false;
         }
     }
+    else if (ctx.nhg_updated_in_place)
+    {
+        /* The route keeps pointing to its group, whose members were updated */
+        object_statuses.emplace_back(SAI_STATUS_SUCCESS);
+    }
     else
     {
         /* Set the packet action to forward when there was no next hop (dropped) and not pointing to blackhole*/
@@ -2263,7 +2649,13 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
             }
         }
 
-        if (m_fgNhgOrch->syncdContainsFgNhg(vrf_id, ipPrefix))
+        if (ctx.nhg_updated_in_place)
+        {
+            /* The route reference was moved along with the group to the new key */
+            SWSS_LOG_INFO("Route %s next hop group updated in place",
+                    ipPrefix.to_string().c_str());
+        }
+        else if (m_fgNhgOrch->syncdContainsFgNhg(vrf_id, ipPrefix))
         {
             /* Remove FG nhg since prefix now points to standard nhg/nhs */
             m_fgNhgOrch->removeFgNhg(vrf_id, ipPrefix);
@@ -2339,7 +2731,10 @@ bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey
         if (ctx.nhg_index.empty())
         {
             /* Increase the ref_count for the next hop (group) entry */
-            increaseNextHopRefCount(nextHops);
+            if (!ctx.nhg_updated_in_place)
+            {
+                increaseNextHopRefCount(nextHops);
+            }
         }
         else
         {
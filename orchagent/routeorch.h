@@ -13,9 +13,13 @@
 #include "ipaddresses.h"
 #include "ipprefix.h"
 #include "nexthopgroupkey.h"
+#include "routetrie.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <tuple>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -54,6 +58,9 @@ struct NextHopUpdate
  * Structure describing the next hop group used by a route.  As the next hop
  * groups can either be owned by RouteOrch or by NhgOrch, we have to keep track
  * of the next hop group index, as it is the one telling us which one owns it.
+ *
+ * The next hop group key references its interned next hop set, so routes
+ * using the same next hops share it and compare by pointer.
  */
 struct RouteNhg
 {
@@ -69,9 +76,9 @@ struct RouteNhg
     RouteNhg(const NextHopGroupKey& key, const std::string& index) :
         nhg_key(key), nhg_index(index) {}
 
-    bool operator==(const RouteNhg& rnhg)
+    bool operator==(const RouteNhg& rnhg) const
        { return ((nhg_key == rnhg.nhg_key) && (nhg_index == rnhg.nhg_index)); }
-    bool operator!=(const RouteNhg& rnhg) { return !(*this == rnhg); }
+    bool operator!=(const RouteNhg& rnhg) const { return !(*this == rnhg); }
 };
 
 struct NextHopObserverEntry;
@@ -84,14 +91,16 @@ struct RouteKey
 
     bool operator < (const RouteKey& rhs) const
     {
-        return (vrf_id <= rhs.vrf_id && prefix < rhs.prefix);
+        return std::tie(vrf_id, prefix) < std::tie(rhs.vrf_id, rhs.prefix);
     }
 };
 
 /* NextHopGroupTable: NextHopGroupKey, NextHopGroupEntry */
-typedef std::map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
+typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
 /* RouteTable: destination network, NextHopGroupKey */
-typedef std::map<IpPrefix, RouteNhg> RouteTable;
+typedef RouteTrie<RouteNhg> RouteTable;
+/* ObservedRouteTable: prefixes covering an observed destination, longest last */
+typedef std::map<IpPrefix, RouteNhg> ObservedRouteTable;
 /* RouteTables: vrf_id, RouteTable */
 typedef std::map<sai_object_id_t, RouteTable> RouteTables;
 /* LabelRouteTable: destination label, next hop address(es) */
@@ -107,7 +116,7 @@ typedef std::map<NextHopKey, std::set<RouteKey>> NextHopRouteTable;
 
 struct NextHopObserverEntry
 {
-    RouteTable routeTable;
+    ObservedRouteTable routeTable;
     list<Observer *> observers;
 };
 
@@ -122,13 +131,15 @@ struct RouteBulkContext
     bool                                excp_intfs_flag;
     // using_temp_nhg will track if the NhgOrch's owned NHG is temporary or not
     bool                                using_temp_nhg;
+    // nhg_updated_in_place is set when the members of the route's NHG were updated
+    bool                                nhg_updated_in_place;
 
     std::string                         key;       // Key in database table
     std::string                         protocol;  // Protocol string
     bool                                is_set;    // True if set operation
 
     RouteBulkContext(const std::string& key, bool is_set)
-        : key(key), excp_intfs_flag(false), using_temp_nhg(false), is_set(is_set)
+        : key(key), excp_intfs_flag(false), using_temp_nhg(false), nhg_updated_in_place(false), is_set(is_set)
     {
     }
 
@@ -144,6 +155,7 @@ struct RouteBulkContext
         excp_intfs_flag = false;
         vrf_id = SAI_NULL_OBJECT_ID;
         using_temp_nhg = false;
+        nhg_updated_in_place = false;
         key.clear();
         protocol.clear();
     }
@@ -198,6 +210,7 @@ public:
 
     bool addNextHopGroup(const NextHopGroupKey&);
     bool removeNextHopGroup(const NextHopGroupKey&);
+    bool updateNextHopGroup(const NextHopGroupKey&, const NextHopGroupKey&);
 
     void addNextHopRoute(const NextHopKey&, const RouteKey&);
     void removeNextHopRoute(const NextHopKey&, const RouteKey&);
@@ -253,6 +266,9 @@ private:
     std::set<std::pair<NextHopGroupKey, sai_object_id_t>> m_bulkNhgReducedRefCnt;
     /* m_bulkNhgReducedRefCnt: nexthop, vrf_id */
 
+    std::unordered_set<NextHopGroupKey> m_bulkNhgPendingRefs;
+    /* m_bulkNhgPendingRefs: groups used by routes of the current bulk, not yet counted in ref_count */
+
     std::set<IpPrefix> m_SubnetDecapTermsCreated;
     ProducerStateTable m_appTunnelDecapTermProducer;
 
@@ -267,6 +283,7 @@ private:
     bool removeRoute(RouteBulkContext& ctx);
     bool addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
     bool removeRoutePost(const RouteBulkContext& ctx);
+    bool isNextHopGroupUpdatable(const RouteBulkContext& ctx, const NextHopGroupKey&);
 
     void addTempLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
     bool addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
@@ -0,0 +1,630 @@
+#ifndef SWSS_ROUTETRIE_H
+#define SWSS_ROUTETRIE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+/*
+ * Per-VRF prefix store of RouteOrch.
+ *
+ * A path compressed binary (Patricia) trie keyed by IpPrefix, with one tree
+ * per address family. Nodes and entries live in two deques and are linked by
+ * 32 bit indices instead of pointers, and the branching nodes only carry the
+ * trie structure. Removed nodes and entries are put on free lists and reused,
+ * so a table at steady state does not allocate, and references to the stored
+ * entries stay valid across insertions and removals of other entries. The
+ * prefix of an entry must not be modified.
+ *
+ * A node either holds a route or is a branching point with two children, the
+ * family roots (/0) being the only nodes allowed to be empty. Prefixes are
+ * compared on their first mask length bits.
+ *
+ * Prefixes are identified like in std::map, so 10.0.0.1/24 and 10.0.0.0/24
+ * are different entries. Prefixes with host bits set are not stored in the
+ * trie but in a std::map on the side, and take part in forEachCovering().
+ *
+ * The interface is the subset of std::map used by RouteOrch. Iteration does
+ * not follow the IpPrefix order: it visits the IPv4 prefixes then the IPv6
+ * prefixes of the trie, each prefix before the more specific prefixes it
+ * covers, then the prefixes with host bits set. Callers needing the IpPrefix
+ * order must sort the entries themselves.
+ */
+template <typename V>
+class RouteTrie
+{
+public:
+    typedef swss::IpPrefix key_type;
+    typedef V mapped_type;
+    typedef std::pair<swss::IpPrefix, V> value_type;
+
+private:
+    static const uint32_t NIL = UINT32_MAX;
+
+    /* Prefixes with host bits set, to the index of their entry */
+    typedef std::map<swss::IpPrefix, uint32_t> HostPrefixMap;
+
+    struct Key
+    {
+        uint8_t addr[16];
+        uint8_t len;
+        uint8_t family;
+    };
+
+    struct Node
+    {
+        Node(const Key &k, uint32_t p) : key(k), parent(p) {}
+
+        Key key;
+        uint32_t parent;
+        uint32_t child[2] = { NIL, NIL };
+        /* Index of the entry, NIL for a branching node */
+        uint32_t value = NIL;
+    };
+
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef typename RouteTrie::value_type value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef typename std::conditional<Const, const value_type *, value_type *>::type pointer;
+        typedef typename std::conditional<Const, const value_type &, value_type &>::type reference;
+        typedef typename std::conditional<Const, const RouteTrie *, RouteTrie *>::type trie_pointer;
+
+        Iterator() = default;
+        Iterator(trie_pointer trie, uint32_t index) : m_trie(trie), m_index(index) {}
+        Iterator(trie_pointer trie, typename HostPrefixMap::const_iterator host) : m_trie(trie), m_host(host) {}
+
+        /* iterator to const_iterator conversion */
+        template <bool C = Const, typename = typename std::enable_if<C>::type>
+        Iterator(const Iterator<false> &o) : m_trie(o.m_trie), m_index(o.m_index), m_host(o.m_host) {}
+
+        reference operator*() const
+        {
+            uint32_t value = m_index != NIL ? m_trie->m_nodes[m_index].value : m_host->second;
+            return m_trie->m_values[value];
+        }
+        pointer operator->() const { return &**this; }
+
+        Iterator &operator++()
+        {
+            if (m_index == NIL)
+            {
+                ++m_host;
+                return *this;
+            }
+
+            m_index = m_trie->next(m_index);
+            if (m_index == NIL)
+            {
+                m_host = m_trie->m_hostPrefixes.begin();
+            }
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        /* The host prefix position is only meaningful once the trie is exhausted */
+        bool operator==(const Iterator &o) const
+        {
+            if (m_index != NIL || o.m_index != NIL)
+            {
+                return m_index == o.m_index;
+            }
+            return m_host == o.m_host;
+        }
+        bool operator!=(const Iterator &o) const { return !(*this == o); }
+
+    private:
+        friend class RouteTrie;
+        friend class Iterator<true>;
+
+        trie_pointer m_trie = nullptr;
+        uint32_t m_index = NIL;
+        typename HostPrefixMap::const_iterator m_host;
+    };
+
+public:
+    typedef Iterator<false> iterator;
+    typedef Iterator<true> const_iterator;
+
+    iterator begin() { return toIterator(firstEntry()); }
+    iterator end() { return iterator(this, m_hostPrefixes.cend()); }
+    const_iterator begin() const { return firstEntry(); }
+    const_iterator end() const { return const_iterator(this, m_hostPrefixes.cend()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    iterator find(const swss::IpPrefix &prefix)
+    {
+        return toIterator(static_cast<const RouteTrie *>(this)->find(prefix));
+    }
+
+    const_iterator find(const swss::IpPrefix &prefix) const
+    {
+        bool hostBits;
+        Key key = makeKey(prefix, &hostBits);
+        if (hostBits)
+        {
+            return const_iterator(this, m_hostPrefixes.find(prefix));
+        }
+
+        uint32_t index = lookup(key);
+        return index != NIL ? const_iterator(this, index) : end();
+    }
+
+    size_t count(const swss::IpPrefix &prefix) const
+    {
+        return find(prefix) == end() ? 0 : 1;
+    }
+
+    V &at(const swss::IpPrefix &prefix)
+    {
+        auto it = find(prefix);
+        if (it == end())
+        {
+            throw std::out_of_range("RouteTrie::at");
+        }
+        return it->second;
+    }
+
+    const V &at(const swss::IpPrefix &prefix) const
+    {
+        return const_cast<RouteTrie *>(this)->at(prefix);
+    }
+
+    V &operator[](const swss::IpPrefix &prefix)
+    {
+        return emplace(prefix, V()).first->second;
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const swss::IpPrefix &prefix, Args&&... args)
+    {
+        bool hostBits;
+        Key key = makeKey(prefix, &hostBits);
+        if (hostBits)
+        {
+            auto host = m_hostPrefixes.find(prefix);
+            if (host != m_hostPrefixes.end())
+            {
+                return std::make_pair(iterator(this, host), false);
+            }
+
+            host = m_hostPrefixes.emplace(prefix, allocateValue(prefix, std::forward<Args>(args)...)).first;
+            m_size++;
+            return std::make_pair(iterator(this, host), true);
+        }
+
+        uint32_t index = insert(key);
+        if (m_nodes[index].value != NIL)
+        {
+            return std::make_pair(iterator(this, index), false);
+        }
+
+        m_nodes[index].value = allocateValue(prefix, std::forward<Args>(args)...);
+        m_size++;
+        return std::make_pair(iterator(this, index), true);
+    }
+
+    size_t erase(const swss::IpPrefix &prefix)
+    {
+        auto it = find(prefix);
+        if (it == end())
+        {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    /* Only branching nodes are released, so the successor stays in place */
+    iterator erase(const_iterator pos)
+    {
+        if (pos.m_index == NIL)
+        {
+            releaseValue(pos.m_host->second);
+            m_size--;
+            return iterator(this, m_hostPrefixes.erase(pos.m_host));
+        }
+
+        uint32_t next_index = next(pos.m_index);
+        remove(pos.m_index);
+        return next_index != NIL ? iterator(this, next_index) : iterator(this, m_hostPrefixes.cbegin());
+    }
+
+    void clear()
+    {
+        m_nodes.clear();
+        m_values.clear();
+        m_free.clear();
+        m_freeValues.clear();
+        m_hostPrefixes.clear();
+        m_root[0] = m_root[1] = NIL;
+        m_size = 0;
+    }
+
+    /*
+     * Call fn on each stored prefix covering the address, from the least to
+     * the most specific one.
+     */
+    template <typename F>
+    void forEachCovering(const swss::IpAddress &ip, F fn) const
+    {
+        /* Covering host prefixes, merged with the trie path by mask length */
+        std::vector<const value_type *> hosts;
+        for (const auto &host : m_hostPrefixes)
+        {
+            if (host.first.isAddressInSubnet(ip))
+            {
+                hosts.push_back(&m_values[host.second]);
+            }
+        }
+        std::stable_sort(hosts.begin(), hosts.end(), [](const value_type *a, const value_type *b) {
+            return a->first.getMaskLength() < b->first.getMaskLength();
+        });
+        auto host = hosts.begin();
+
+        Key key = makeKey(ip, ip.isV4() ? 32 : 128);
+        uint32_t index = m_root[key.family];
+        while (index != NIL)
+        {
+            const Node &node = m_nodes[index];
+            if (commonLength(node.key, key, node.key.len) < node.key.len)
+            {
+                break;
+            }
+            if (node.value != NIL)
+            {
+                for (; host != hosts.end() && (*host)->first.getMaskLength() < node.key.len; ++host)
+                {
+                    fn(**host);
+                }
+                fn(static_cast<const value_type &>(m_values[node.value]));
+            }
+            if (node.key.len == key.len)
+            {
+                break;
+            }
+            index = node.child[bit(key, node.key.len)];
+        }
+
+        for (; host != hosts.end(); ++host)
+        {
+            fn(**host);
+        }
+    }
+
+    /* Number of trie nodes, including the branching ones and the free ones */
+    size_t capacity() const
+    {
+        return m_nodes.size();
+    }
+
+private:
+    std::deque<Node> m_nodes;
+    std::deque<value_type> m_values;
+    std::vector<uint32_t> m_free;
+    std::vector<uint32_t> m_freeValues;
+    HostPrefixMap m_hostPrefixes;
+    uint32_t m_root[2] = { NIL, NIL };
+    size_t m_size = 0;
+
+    /* hostBits is set when bits beyond the mask length had to be cleared */
+    static Key makeKey(const swss::IpAddress &ip, int len, bool *hostBits = nullptr)
+    {
+        Key key;
+        memset(&key, 0, sizeof(key));
+
+        ip_addr_t addr = ip.getIp();
+        if (addr.family == AF_INET)
+        {
+            key.family = 0;
+            memcpy(key.addr, &addr.ip_addr.ipv4, 4);
+        }
+        else
+        {
+            key.family = 1;
+            memcpy(key.addr, addr.ip_addr.ipv6, 16);
+        }
+        key.len = static_cast<uint8_t>(len);
+
+        /* Clear the host bits so that the branching nodes compare on the prefix only */
+        uint8_t cleared = 0;
+        for (int i = len; i < 128; i++)
+        {
+            cleared = static_cast<uint8_t>(cleared | (key.addr[i / 8] & (0x80 >> (i % 8))));
+            key.addr[i / 8] = static_cast<uint8_t>(key.addr[i / 8] & ~(0x80 >> (i % 8)));
+        }
+        if (hostBits)
+        {
+            *hostBits = cleared != 0;
+        }
+        return key;
+    }
+
+    static Key makeKey(const swss::IpPrefix &prefix, bool *hostBits = nullptr)
+    {
+        return makeKey(prefix.getIp(), prefix.getMaskLength(), hostBits);
+    }
+
+    template <typename... Args>
+    uint32_t allocateValue(const swss::IpPrefix &prefix, Args&&... args)
+    {
+        if (m_freeValues.empty())
+        {
+            m_values.emplace_back(std::piecewise_construct,
+                                  std::forward_as_tuple(prefix),
+                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            return static_cast<uint32_t>(m_values.size() - 1);
+        }
+
+        uint32_t value = m_freeValues.back();
+        m_freeValues.pop_back();
+        m_values[value].first = prefix;
+        m_values[value].second = V(std::forward<Args>(args)...);
+        return value;
+    }
+
+    /* Reset the entry to release what the mapped value holds */
+    void releaseValue(uint32_t value)
+    {
+        m_values[value] = value_type();
+        m_freeValues.push_back(value);
+    }
+
+    static int bit(const Key &key, int i)
+    {
+        return (key.addr[i / 8] >> (7 - i % 8)) & 1;
+    }
+
+    /* Number of leading bits shared by the two keys, capped at max */
+    static int commonLength(const Key &a, const Key &b, int max)
+    {
+        int len = 0;
+        for (int i = 0; i < 16 && len < max; i++)
+        {
+            uint8_t diff = static_cast<uint8_t>(a.addr[i] ^ b.addr[i]);
+            if (diff)
+            {
+                len += __builtin_clz(diff) - 24;
+                break;
+            }
+            len += 8;
+        }
+        return len < max ? len : max;
+    }
+
+    uint32_t allocate(const Key &key, uint32_t parent)
+    {
+        if (m_free.empty())
+        {
+            m_nodes.emplace_back(key, parent);
+            return static_cast<uint32_t>(m_nodes.size() - 1);
+        }
+
+        uint32_t index = m_free.back();
+        m_free.pop_back();
+        Node &node = m_nodes[index];
+        node.key = key;
+        node.parent = parent;
+        node.child[0] = node.child[1] = NIL;
+        return index;
+    }
+
+    void release(uint32_t index)
+    {
+        m_free.push_back(index);
+    }
+
+    uint32_t lookup(const Key &key) const
+    {
+        uint32_t index = m_root[key.family];
+        while (index != NIL)
+        {
+            const Node &node = m_nodes[index];
+            if (node.key.len > key.len || commonLength(node.key, key, node.key.len) < node.key.len)
+            {
+                return NIL;
+            }
+            if (node.key.len == key.len)
+            {
+                return node.value != NIL ? index : NIL;
+            }
+            index = node.child[bit(key, node.key.len)];
+        }
+        return NIL;
+    }
+
+    /* Return the node of the key, creating it if needed */
+    uint32_t insert(const Key &key)
+    {
+        if (m_root[key.family] == NIL)
+        {
+            Key root;
+            memset(&root, 0, sizeof(root));
+            root.family = key.family;
+            m_root[key.family] = allocate(root, NIL);
+        }
+
+        uint32_t index = m_root[key.family];
+        uint32_t result;
+        while (true)
+        {
+            /* The node key is a prefix of the inserted key */
+            if (m_nodes[index].key.len == key.len)
+            {
+                result = index;
+                break;
+            }
+
+            int b = bit(key, m_nodes[index].key.len);
+            uint32_t child = m_nodes[index].child[b];
+            if (child == NIL)
+            {
+                result = allocate(key, index);
+                m_nodes[index].child[b] = result;
+                break;
+            }
+
+            const Key &child_key = m_nodes[child].key;
+            int common = commonLength(child_key, key, std::min(child_key.len, key.len));
+            if (common == child_key.len)
+            {
+                index = child;
+                continue;
+            }
+
+            /* The inserted key diverges from the child or is one of its prefixes */
+            uint32_t parent;
+            if (common == key.len)
+            {
+                result = parent = allocate(key, index);
+            }
+            else
+            {
+                Key branch = key;
+                for (int i = common; i < key.len; i++)
+                {
+                    branch.addr[i / 8] = static_cast<uint8_t>(branch.addr[i / 8] & ~(0x80 >> (i % 8)));
+                }
+                branch.len = static_cast<uint8_t>(common);
+                parent = allocate(branch, index);
+                result = allocate(key, parent);
+                m_nodes[parent].child[bit(key, common)] = result;
+            }
+
+            m_nodes[parent].child[bit(m_nodes[child].key, common)] = child;
+            m_nodes[child].parent = parent;
+            m_nodes[index].child[b] = parent;
+            break;
+        }
+
+        return result;
+    }
+
+    void remove(uint32_t index)
+    {
+        releaseValue(m_nodes[index].value);
+        m_nodes[index].value = NIL;
+        m_size--;
+
+        /* Drop the nodes that are neither a route nor a branching point */
+        while (m_nodes[index].parent != NIL && m_nodes[index].value == NIL)
+        {
+            Node &node = m_nodes[index];
+            uint32_t parent = node.parent;
+            int slot = m_nodes[parent].child[0] == index ? 0 : 1;
+
+            if (node.child[0] != NIL && node.child[1] != NIL)
+            {
+                break;
+            }
+
+            uint32_t child = node.child[0] != NIL ? node.child[0] : node.child[1];
+            m_nodes[parent].child[slot] = child;
+            release(index);
+
+            if (child != NIL)
+            {
+                m_nodes[child].parent = parent;
+                break;
+            }
+            index = parent;
+        }
+    }
+
+    /* First route node in preorder, starting from index included */
+    uint32_t firstFrom(uint32_t index) const
+    {
+        if (index == NIL || m_nodes[index].value != NIL)
+        {
+            return index;
+        }
+        return next(index);
+    }
+
+    uint32_t first() const
+    {
+        return firstFrom(m_root[0] != NIL ? m_root[0] : m_root[1]);
+    }
+
+    const_iterator firstEntry() const
+    {
+        uint32_t index = first();
+        return index != NIL ? const_iterator(this, index) : const_iterator(this, m_hostPrefixes.cbegin());
+    }
+
+    iterator toIterator(const_iterator it)
+    {
+        return it.m_index != NIL ? iterator(this, it.m_index) : iterator(this, it.m_host);
+    }
+
+    /* Next route node in preorder */
+    uint32_t next(uint32_t index) const
+    {
+        while (true)
+        {
+            const Node &node = m_nodes[index];
+            if (node.child[0] != NIL)
+            {
+                index = node.child[0];
+            }
+            else if (node.child[1] != NIL)
+            {
+                index = node.child[1];
+            }
+            else
+            {
+                /* Climb up to the first ancestor with an unvisited right subtree */
+                while (true)
+                {
+                    uint32_t parent = m_nodes[index].parent;
+                    if (parent == NIL)
+                    {
+                        if (index == m_root[0] && m_root[1] != NIL)
+                        {
+                            index = m_root[1];
+                            break;
+                        }
+                        return NIL;
+                    }
+                    if (m_nodes[parent].child[0] == index && m_nodes[parent].child[1] != NIL)
+                    {
+                        index = m_nodes[parent].child[1];
+                        break;
+                    }
+                    index = parent;
+                }
+            }
+
+            if (m_nodes[index].value != NIL)
+            {
+                return index;
+            }
+        }
+    }
+};
+
+#endif /* SWSS_ROUTETRIE_H */
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "table.h"
+
+/*
+ * Index type used by SyncMap to locate the pending tasks of a key.
+ *
+ * Ordered: keys are kept in lexicographical order, which is the behavior
+ *          of the original std::multimap based SyncMap.
+ * Hashed:  keys are kept in first-insertion (FIFO) order and located with
+ *          a hash lookup, which avoids the O(log n) string compares of the
+ *          ordered index on large tables such as ROUTE_TABLE.
+ */
+enum class SyncMapIndex
+{
+    Ordered,
+    Hashed
+};
+
+class SyncMap;
+
+struct SyncMapGroup;
+
+/*
+ * A pending task. It exposes the same first/second members as the
+ * std::multimap value type so that Orch::doTask() implementations keep
+ * working unchanged.
+ */
+struct SyncMapEntry : public std::pair<std::string, swss::KeyOpFieldsValuesTuple>
+{
+    SyncMapEntry(const std::string &key, const swss::KeyOpFieldsValuesTuple &kofv)
+        : std::pair<std::string, swss::KeyOpFieldsValuesTuple>(key, kofv)
+    {
+    }
+
+private:
+    friend class SyncMap;
+
+    SyncMapGroup *group = nullptr;
+};
+
+/*
+ * All entries of one key are stored next to each other in the entry list,
+ * so iteration observes them in insertion order like std::multimap does.
+ */
+struct SyncMapGroup
+{
+    std::list<SyncMapEntry>::iterator first;
+    std::list<SyncMapEntry>::iterator last;
+    size_t count = 0;
+};
+
+/*
+ * Container holding the pending tasks of a consumer.
+ *
+ * It provides the subset of the std::multimap interface used by the orchs,
+ * with stable iterators across insertions and erasures of other entries.
+ * Entries live in a single list, the index only maps a key to the range of
+ * its entries. Erased list nodes are kept in a bounded spare pool and reused
+ * by later insertions to avoid a heap allocation per task.
+ */
+class SyncMap
+{
+public:
+    typedef std::string key_type;
+    typedef swss::KeyOpFieldsValuesTuple mapped_type;
+    typedef SyncMapEntry value_type;
+    typedef std::list<SyncMapEntry>::iterator iterator;
+    typedef std::list<SyncMapEntry>::const_iterator const_iterator;
+    typedef std::list<SyncMapEntry>::reverse_iterator reverse_iterator;
+    typedef std::list<SyncMapEntry>::const_reverse_iterator const_reverse_iterator;
+
+    static const size_t DEFAULT_MAX_SPARE_NODES = 4096;
+
+    explicit SyncMap(SyncMapIndex index = SyncMapIndex::Ordered,
+                     size_t maxSpareNodes = DEFAULT_MAX_SPARE_NODES)
+        : m_index(index)
+        , m_maxSpareNodes(maxSpareNodes)
+    {
+    }
+
+    SyncMap(const SyncMap&) = delete;
+    SyncMap& operator=(const SyncMap&) = delete;
+
+    SyncMapIndex getIndex() const { return m_index; }
+
+    /*
+     * Switch the index type. Pending entries are kept, and reordered by key
+     * when switching to the ordered index. Entries of one key keep their
+     * relative order.
+     */
+    void setIndex(SyncMapIndex index)
+    {
+        if (index == m_index)
+        {
+            return;
+        }
+
+        m_index = index;
+
+        std::list<SyncMapEntry> entries;
+        entries.swap(m_entries);
+        m_ordered.clear();
+        m_hashed.clear();
+
+        while (!entries.empty())
+        {
+            auto group = lookupOrCreate(entries.begin()->first);
+            auto pos = group->count ? std::next(group->last) : insertPosition(entries.begin()->first);
+            m_entries.splice(pos, entries, entries.begin());
+            link(group, std::prev(pos));
+        }
+    }
+
+    iterator begin() { return m_entries.begin(); }
+    iterator end() { return m_entries.end(); }
+    const_iterator begin() const { return m_entries.begin(); }
+    const_iterator end() const { return m_entries.end(); }
+    const_iterator cbegin() const { return m_entries.cbegin(); }
+    const_iterator cend() const { return m_entries.cend(); }
+    reverse_iterator rbegin() { return m_entries.rbegin(); }
+    reverse_iterator rend() { return m_entries.rend(); }
+    const_reverse_iterator rbegin() const { return m_entries.rbegin(); }
+    const_reverse_iterator rend() const { return m_entries.rend(); }
+
+    bool empty() const { return m_entries.empty(); }
+    size_t size() const { return m_entries.size(); }
+
+    iterator find(const std::string &key)
+    {
+        auto group = lookup(key);
+        return group ? group->first : m_entries.end();
+    }
+
+    size_t count(const std::string &key) const
+    {
+        auto group = const_cast<SyncMap *>(this)->lookup(key);
+        return group ? group->count : 0;
+    }
+
+    std::pair<iterator, iterator> equal_range(const std::string &key)
+    {
+        auto group = lookup(key);
+        if (!group)
+        {
+            return std::make_pair(m_entries.end(), m_entries.end());
+        }
+        return std::make_pair(group->first, std::next(group->last));
+    }
+
+    /* Append the entry after the existing entries of the same key */
+    iterator emplace(const std::string &key, const swss::KeyOpFieldsValuesTuple &kofv)
+    {
+        auto group = lookupOrCreate(key);
+        auto pos = group->count ? std::next(group->last) : insertPosition(key);
+
+        iterator it;
+        if (m_spare.empty())
+        {
+            it = m_entries.emplace(pos, key, kofv);
+        }
+        else
+        {
+            m_entries.splice(pos, m_spare, m_spare.begin());
+            it = std::prev(pos);
+            it->first = key;
+            it->second = kofv;
+        }
+
+        link(group, it);
+        return it;
+    }
+
+    iterator emplace(const std::pair<std::string, swss::KeyOpFieldsValuesTuple> &value)
+    {
+        return emplace(value.first, value.second);
+    }
+
+    iterator erase(const_iterator pos)
+    {
+        auto group = pos->group;
+        auto it = m_entries.erase(pos, pos);
+        auto next = std::next(it);
+
+        if (--group->count == 0)
+        {
+            unindex(it->first);
+        }
+        else if (it == group->first)
+        {
+            group->first = next;
+        }
+        else if (it == group->last)
+        {
+            group->last = std::prev(it);
+        }
+
+        release(it);
+        return next;
+    }
+
+    size_t erase(const std::string &key)
+    {
+        auto range = equal_range(key);
+        size_t erased = 0;
+        for (auto it = range.first; it != range.second;)
+        {
+            it = erase(it);
+            erased++;
+        }
+        return erased;
+    }
+
+    void clear()
+    {
+        m_ordered.clear();
+        m_hashed.clear();
+        while (!m_entries.empty())
+        {
+            release(m_entries.begin());
+        }
+    }
+
+private:
+    SyncMapIndex m_index;
+    size_t m_maxSpareNodes;
+
+    std::list<SyncMapEntry> m_entries;
+    std::list<SyncMapEntry> m_spare;
+
+    std::map<std::string, SyncMapGroup> m_ordered;
+    std::unordered_map<std::string, SyncMapGroup> m_hashed;
+
+    SyncMapGroup *lookup(const std::string &key)
+    {
+        if (m_index == SyncMapIndex::Hashed)
+        {
+            auto it = m_hashed.find(key);
+            return it == m_hashed.end() ? nullptr : &it->second;
+        }
+
+        auto it = m_ordered.find(key);
+        return it == m_ordered.end() ? nullptr : &it->second;
+    }
+
+    SyncMapGroup *lookupOrCreate(const std::string &key)
+    {
+        if (m_index == SyncMapIndex::Hashed)
+        {
+            return &m_hashed[key];
+        }
+        return &m_ordered[key];
+    }
+
+    /* Position in front of which the first entry of a new key goes */
+    iterator insertPosition(const std::string &key)
+    {
+        if (m_index == SyncMapIndex::Hashed)
+        {
+            return m_entries.end();
+        }
+
+        auto it = m_ordered.upper_bound(key);
+        while (it != m_ordered.end() && it->second.count == 0)
+        {
+            ++it;
+        }
+        return it == m_ordered.end() ? m_entries.end() : it->second.first;
+    }
+
+    void link(SyncMapGroup *group, iterator it)
+    {
+        if (group->count++ == 0)
+        {
+            group->first = it;
+        }
+        group->last = it;
+        it->group = group;
+    }
+
+    void unindex(const std::string &key)
+    {
+        if (m_index == SyncMapIndex::Hashed)
+        {
+            m_hashed.erase(key);
+        }
+        else
+        {
+            m_ordered.erase(key);
+        }
+    }
+
+    /* Move the node to the spare pool, or free it when the pool is full */
+    void release(iterator it)
+    {
+        if (m_spare.size() < m_maxSpareNodes)
+        {
+            it->group = nullptr;
+            m_spare.splice(m_spare.begin(), m_entries, it);
+        }
+        else
+        {
+            m_entries.erase(it);
+        }
+    }
+};
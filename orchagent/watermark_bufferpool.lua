@@ -10,6 +10,7 @@ local counters_table_name = 'COUNTERS'
 local user_table_name = 'USER_WATERMARKS'
 local persistent_table_name = 'PERSISTENT_WATERMARKS'
 local periodic_table_name = 'PERIODIC_WATERMARKS'
+local periodic_dirty_set_name = 'PERIODIC_WATERMARKS_DIRTY'
 
 local sai_buffer_pool_watermark_stat_name = 'SAI_BUFFER_POOL_STAT_WATERMARK_BYTES'
 local sai_hdrm_pool_watermark_stat_name = 'SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES'
@@ -34,6 +35,7 @@ for i = n, 1, -1 do
     local persistent_hdrm_pool_wm = redis.call('HGET', persistent_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
     local periodic_hdrm_pool_wm = redis.call('HGET', periodic_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name)
 
+    -- Only the pools raised since the last periodic clear are cleared by the next one
     if buffer_pool_wm then
         buffer_pool_wm = tonumber(buffer_pool_wm)
 
@@ -43,6 +45,9 @@ for i = n, 1, -1 do
                    persistent_buffer_pool_wm and math.max(buffer_pool_wm, persistent_buffer_pool_wm) or buffer_pool_wm)
         redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], sai_buffer_pool_watermark_stat_name,
                    periodic_buffer_pool_wm and math.max(buffer_pool_wm, periodic_buffer_pool_wm) or buffer_pool_wm)
+        if buffer_pool_wm > 0 and tonumber(periodic_buffer_pool_wm or 0) == 0 then
+            redis.call('SADD', periodic_dirty_set_name, KEYS[i])
+        end
     end
 
     if hdrm_pool_wm then
@@ -54,6 +59,9 @@ for i = n, 1, -1 do
                    persistent_hdrm_pool_wm and math.max(hdrm_pool_wm, persistent_hdrm_pool_wm) or hdrm_pool_wm)
         redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], sai_hdrm_pool_watermark_stat_name,
                    periodic_hdrm_pool_wm and math.max(hdrm_pool_wm, periodic_hdrm_pool_wm) or hdrm_pool_wm)
+        if hdrm_pool_wm > 0 and tonumber(periodic_hdrm_pool_wm or 0) == 0 then
+            redis.call('SADD', periodic_dirty_set_name, KEYS[i])
+        end
     end
 end
 
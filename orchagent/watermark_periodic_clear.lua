@@ -0,0 +1,19 @@
+-- KEYS[1] - set of the objects raised since the last periodic clear
+-- ARGV[1] - periodic watermarks table name
+-- return the number of objects cleared
+
+local dirty_set_name = KEYS[1]
+local periodic_table_name = ARGV[1]
+
+local objects = redis.call('SMEMBERS', dirty_set_name)
+redis.call('DEL', dirty_set_name)
+
+for _, object in ipairs(objects) do
+    local key = periodic_table_name .. ':' .. object
+    local fields = redis.call('HKEYS', key)
+    for _, field in ipairs(fields) do
+        redis.call('HSET', key, field, '0')
+    end
+end
+
+return { tostring(#objects) }
@@ -10,6 +10,7 @@ local counters_table_name = "COUNTERS"
 local periodic_table_name = "PERIODIC_WATERMARKS"
 local persistent_table_name = "PERSISTENT_WATERMARKS"
 local user_table_name = "USER_WATERMARKS"
+local periodic_dirty_set_name = "PERIODIC_WATERMARKS_DIRTY"
 
 local rets = {}
 
@@ -32,14 +33,21 @@ for i = n, 1, -1 do
     local user_headroom_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES')
 
     -- Set the values into the other tables. Make comparioson, if th evalue was absent in COUNTERS, set to N/A
+    -- Only the PGs raised since the last periodic clear are cleared by the next one
     if (pg_shared_wm) then
         redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES',  periodic_shared_wm and math.max(tonumber(pg_shared_wm), tonumber(periodic_shared_wm)) or pg_shared_wm)
+        if tonumber(pg_shared_wm) > 0 and tonumber(periodic_shared_wm or 0) == 0 then
+            redis.call('SADD', periodic_dirty_set_name, KEYS[i])
+        end
         redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES', persistent_shared_wm and math.max(tonumber(pg_shared_wm), tonumber(persistent_shared_wm)) or pg_shared_wm)
         redis.call('HSET', user_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES', user_shared_wm and math.max(tonumber(pg_shared_wm), tonumber(user_shared_wm)) or pg_shared_wm)
     end
 
     if (pg_headroom_wm) then 
         redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES', periodic_headroom_wm and math.max(tonumber(pg_headroom_wm), tonumber(periodic_headroom_wm)) or pg_headroom_wm)
+        if tonumber(pg_headroom_wm) > 0 and tonumber(periodic_headroom_wm or 0) == 0 then
+            redis.call('SADD', periodic_dirty_set_name, KEYS[i])
+        end
         redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES', persistent_headroom_wm and math.max(tonumber(pg_headroom_wm), tonumber(persistent_headroom_wm)) or pg_headroom_wm)
         redis.call('HSET', user_table_name .. ':' .. KEYS[i], 'SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES', user_headroom_wm and math.max(tonumber(pg_headroom_wm), tonumber(user_headroom_wm)) or pg_headroom_wm)
     end
@@ -10,6 +10,7 @@ local counters_table_name = "COUNTERS"
 local periodic_table_name = "PERIODIC_WATERMARKS"
 local persistent_table_name = "PERSISTENT_WATERMARKS"
 local user_table_name = "USER_WATERMARKS"
+local periodic_dirty_set_name = "PERIODIC_WATERMARKS_DIRTY"
 
 local rets = {}
 
@@ -27,8 +28,12 @@ for i = n, 1, -1 do
     local user_shared_wm = redis.call('HGET', user_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES') 
 
     -- Set the values into the other tables. Make comparioson, if th evalue was absent in COUNTERS, set to N/A
+    -- Only the queues raised since the last periodic clear are cleared by the next one
     if tonumber(queue_shared_wm) then
         redis.call('HSET', periodic_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES', periodic_shared_wm and math.max(queue_shared_wm, periodic_shared_wm) or queue_shared_wm)
+        if tonumber(queue_shared_wm) > 0 and tonumber(periodic_shared_wm or 0) == 0 then
+            redis.call('SADD', periodic_dirty_set_name, KEYS[i])
+        end
         redis.call('HSET', persistent_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES', persistent_shared_wm and math.max(queue_shared_wm, persistent_shared_wm) or queue_shared_wm)
         redis.call('HSET', user_table_name .. ':' .. KEYS[i], 'SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES', user_shared_wm and math.max(queue_shared_wm, user_shared_wm) or queue_shared_wm)
     end
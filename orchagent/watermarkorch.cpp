@@ -4,10 +4,15 @@
 #include "notifier.h"
 #include "converter.h"
 #include "bufferorch.h"
+#include "redisapi.h"
 #include <inttypes.h>
+#include <chrono>
 
 #define DEFAULT_TELEMETRY_INTERVAL 120
 
+#define PERIODIC_WATERMARKS_DIRTY_SET "PERIODIC_WATERMARKS_DIRTY"
+#define PERIODIC_CLEAR_PLUGIN "watermark_periodic_clear.lua"
+
 #define CLEAR_PG_HEADROOM_REQUEST "PG_HEADROOM"
 #define CLEAR_PG_SHARED_REQUEST "PG_SHARED"
 #define CLEAR_QUEUE_SHARED_UNI_REQUEST "Q_SHARED_UNI"
@@ -27,10 +32,23 @@ WatermarkOrch::WatermarkOrch(DBConnector *db, const vector<string> &tables):
 
     m_countersDb = make_shared<DBConnector>("COUNTERS_DB", 0);
     m_appDb = make_shared<DBConnector>("APPL_DB", 0);
+    m_stateDb = make_shared<DBConnector>("STATE_DB", 0);
+    m_countersPipeline = make_shared<RedisPipeline>(m_countersDb.get());
     m_countersTable = make_shared<Table>(m_countersDb.get(), COUNTERS_TABLE);
-    m_periodicWatermarkTable = make_shared<Table>(m_countersDb.get(), PERIODIC_WATERMARKS_TABLE);
-    m_persistentWatermarkTable = make_shared<Table>(m_countersDb.get(), PERSISTENT_WATERMARKS_TABLE);
-    m_userWatermarkTable = make_shared<Table>(m_countersDb.get(), USER_WATERMARKS_TABLE);
+    m_periodicWatermarkTable = make_shared<Table>(m_countersPipeline.get(), PERIODIC_WATERMARKS_TABLE, true);
+    m_persistentWatermarkTable = make_shared<Table>(m_countersPipeline.get(), PERSISTENT_WATERMARKS_TABLE, true);
+    m_userWatermarkTable = make_shared<Table>(m_countersPipeline.get(), USER_WATERMARKS_TABLE, true);
+    m_statsTable = make_shared<Table>(m_stateDb.get(), WATERMARK_STATS_TABLE);
+
+    try
+    {
+        string periodicClearLuaScript = swss::loadLuaScript(PERIODIC_CLEAR_PLUGIN);
+        m_periodicClearSha = swss::loadRedisScript(m_countersDb.get(), periodicClearLuaScript);
+    }
+    catch (const runtime_error &e)
+    {
+        SWSS_LOG_WARN("Periodic watermarks will be all cleared, %s was not loaded: %s", PERIODIC_CLEAR_PLUGIN, e.what());
+    }
 
     m_clearNotificationConsumer = new swss::NotificationConsumer(
             m_appDb.get(),
@@ -159,74 +177,86 @@ void WatermarkOrch::doTask(NotificationConsumer &consumer)
         init_queue_ids();
     }
 
-    std::string op;
-    std::string data;
-    std::vector<swss::FieldValueTuple> values;
+    /* The requests of the same objects and watermarks are written once */
+    std::deque<KeyOpFieldsValuesTuple> requests;
+    consumer.pops(requests);
 
-    consumer.pop(op, data, values);
+    WatermarkClearBatch batch;
+    for (const auto &request : requests)
+    {
+        const auto &op = kfvOp(request);
+        const auto &data = kfvKey(request);
 
-    Table * table = NULL;
+        Table * table = NULL;
 
-    if (op == "PERSISTENT")
-    {
-        table = m_persistentWatermarkTable.get();
-    }
-    else if (op == "USER")
-    {
-        table = m_userWatermarkTable.get();
-    }
-    else
-    {
-        SWSS_LOG_WARN("Unknown watermark clear request op: %s", op.c_str());
-        return;
+        if (op == "PERSISTENT")
+        {
+            table = m_persistentWatermarkTable.get();
+        }
+        else if (op == "USER")
+        {
+            table = m_userWatermarkTable.get();
+        }
+        else
+        {
+            SWSS_LOG_WARN("Unknown watermark clear request op: %s", op.c_str());
+            continue;
+        }
+
+        addClearRequest(batch, table, data);
     }
 
+    size_t objects = batch.flush();
+    SWSS_LOG_DEBUG("%zu watermark clear requests, %zu objects written", requests.size(), objects);
+}
+
+void WatermarkOrch::addClearRequest(WatermarkClearBatch &batch, Table *table, const string &data)
+{
     if (data == CLEAR_PG_HEADROOM_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      m_pg_ids);
+        batch.add(table,
+                  "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
+                  m_pg_ids);
     }
     else if (data == CLEAR_PG_SHARED_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-                      m_pg_ids);
+        batch.add(table,
+                  "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
+                  m_pg_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_UNI_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_unicast_queue_ids);
+        batch.add(table,
+                  "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+                  m_unicast_queue_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_MULTI_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_multicast_queue_ids);
+        batch.add(table,
+                  "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+                  m_multicast_queue_ids);
     }
     else if (data == CLEAR_QUEUE_SHARED_ALL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_all_queue_ids);
+        batch.add(table,
+                  "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
+                  m_all_queue_ids);
     }
     else if (data == CLEAR_BUFFER_POOL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        batch.add(table,
+                  "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
+                  gBufferOrch->getBufferPoolNameOidMap());
     }
     else if (data == CLEAR_HEADROOM_POOL_REQUEST)
     {
-        clearSingleWm(table,
-                      "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        batch.add(table,
+                  "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
+                  gBufferOrch->getBufferPoolNameOidMap());
     }
     else
     {
         SWSS_LOG_WARN("Unknown watermark clear request data: %s", data.c_str());
-        return;
     }
 }
 
@@ -256,31 +286,58 @@ void WatermarkOrch::doTask(SelectableTimer &timer)
             m_telemetryTimer->stop();
         }
 
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES",
-                      m_pg_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_unicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_multicast_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES",
-                      m_all_queue_ids);
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_BUFFER_POOL_STAT_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
-        clearSingleWm(m_periodicWatermarkTable.get(),
-                      "SAI_BUFFER_POOL_STAT_XOFF_ROOM_WATERMARK_BYTES",
-                      gBufferOrch->getBufferPoolNameOidMap());
+        clearPeriodicWatermarks();
         SWSS_LOG_DEBUG("Periodic watermark cleared by timer!");
     }
 }
 
+void WatermarkOrch::clearPeriodicWatermarks()
+{
+    SWSS_LOG_ENTER();
+
+    auto start = chrono::steady_clock::now();
+    size_t objects = 0;
+
+    if (m_periodicFullClear || m_periodicClearSha.empty())
+    {
+        WatermarkClearBatch batch;
+        for (const auto &request : { CLEAR_PG_HEADROOM_REQUEST, CLEAR_PG_SHARED_REQUEST,
+                                     CLEAR_QUEUE_SHARED_UNI_REQUEST, CLEAR_QUEUE_SHARED_MULTI_REQUEST,
+                                     CLEAR_QUEUE_SHARED_ALL_REQUEST, CLEAR_BUFFER_POOL_REQUEST,
+                                     CLEAR_HEADROOM_POOL_REQUEST })
+        {
+            addClearRequest(batch, m_periodicWatermarkTable.get(), request);
+        }
+        objects = batch.flush();
+        m_periodicFullClear = false;
+    }
+    else
+    {
+        try
+        {
+            auto ret = swss::runRedisScript(*m_countersDb, m_periodicClearSha,
+                                            { PERIODIC_WATERMARKS_DIRTY_SET }, { PERIODIC_WATERMARKS_TABLE });
+            objects = ret.empty() ? 0 : to_uint<uint32_t>(*ret.begin());
+        }
+        catch (const exception &e)
+        {
+            SWSS_LOG_ERROR("Failed to clear the dirty periodic watermarks, all are cleared next time: %s", e.what());
+            m_periodicFullClear = true;
+        }
+    }
+
+    uint64_t latencyUs = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    m_periodicClears++;
+    m_periodicClearLatencyMaxUs = max(m_periodicClearLatencyMaxUs, latencyUs);
+
+    vector<FieldValueTuple> fvs = {
+        {"clears", to_string(m_periodicClears)},
+        {"objects", to_string(objects)},
+        {"latency_us", to_string(latencyUs)},
+        {"latency_max_us", to_string(m_periodicClearLatencyMaxUs)}};
+    m_statsTable->set("PERIODIC", fvs);
+}
+
 void WatermarkOrch::init_pg_ids()
 {
     SWSS_LOG_ENTER();
@@ -320,29 +377,54 @@ void WatermarkOrch::init_queue_ids()
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, vector<sai_object_id_t> &obj_ids)
+void WatermarkClearBatch::add(Table *table, const string &wm_name, sai_object_id_t id)
 {
-    /* Zero-out some WM in some table for some vector of object ids*/
-    SWSS_LOG_ENTER();
-    SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), obj_ids.size());
-
-    vector<FieldValueTuple> vfvt = {{wm_name, "0"}};
+    auto &fvs = m_clears[table][sai_serialize_object_id(id)];
+    for (const auto &fv : fvs)
+    {
+        if (fvField(fv) == wm_name)
+        {
+            return;
+        }
+    }
+    fvs.emplace_back(wm_name, "0");
+}
 
+void WatermarkClearBatch::add(Table *table, const string &wm_name, const vector<sai_object_id_t> &obj_ids)
+{
     for (sai_object_id_t id: obj_ids)
     {
-        table->set(sai_serialize_object_id(id), vfvt);
+        add(table, wm_name, id);
     }
 }
 
-void WatermarkOrch::clearSingleWm(Table *table, string wm_name, const object_reference_map &nameOidMap)
+void WatermarkClearBatch::add(Table *table, const string &wm_name, const object_reference_map &nameOidMap)
 {
-    SWSS_LOG_ENTER();
-    SWSS_LOG_DEBUG("clear WM %s, for %zu obj ids", wm_name.c_str(), nameOidMap.size());
+    for (const auto &it : nameOidMap)
+    {
+        add(table, wm_name, it.second.m_saiObjectId);
+    }
+}
 
-    vector<FieldValueTuple> fvTuples = {{wm_name, "0"}};
+size_t WatermarkClearBatch::flush()
+{
+    size_t objects = 0;
 
-    for (const auto &it : nameOidMap)
+    for (const auto &tableClears : m_clears)
+    {
+        for (const auto &objectClears : tableClears.second)
+        {
+            tableClears.first->set(objectClears.first, objectClears.second);
+        }
+        objects += tableClears.second.size();
+    }
+
+    /* The tables share a pipeline, the first flush writes them all */
+    for (const auto &tableClears : m_clears)
     {
-        table->set(sai_serialize_object_id(it.second.m_saiObjectId), fvTuples);
+        tableClears.first->flush();
     }
+
+    m_clears.clear();
+    return objects;
 }
@@ -7,8 +7,11 @@
 #include "port.h"
 
 #include "notificationconsumer.h"
+#include "redispipeline.h"
 #include "timer.h"
 
+#define WATERMARK_STATS_TABLE "WATERMARK_STATS_TABLE"
+
 const uint8_t queue_wm_status_mask = 1 << 0;
 const uint8_t pg_wm_status_mask = 1 << 1;
 
@@ -18,6 +21,31 @@ static const std::map<std::string, const uint8_t> groupToMask =
     { "PG_WATERMARK",        pg_wm_status_mask }
 };
 
+/*
+ * Watermarks to zero, per table and object, coalesced so that each object
+ * of a table is written once with all its watermarks. The tables are
+ * expected to be buffered on a pipeline, flush() writes them in one batch.
+ */
+class WatermarkClearBatch
+{
+public:
+    void add(swss::Table *table, const std::string &wm_name, const std::vector<sai_object_id_t> &obj_ids);
+    void add(swss::Table *table, const std::string &wm_name, const object_reference_map &nameOidMap);
+
+    bool empty() const
+    {
+        return m_clears.empty();
+    }
+
+    /* Returns the number of objects written */
+    size_t flush();
+
+private:
+    void add(swss::Table *table, const std::string &wm_name, sai_object_id_t id);
+
+    std::map<swss::Table *, std::map<std::string, std::vector<swss::FieldValueTuple>>> m_clears;
+};
+
 class WatermarkOrch : public Orch
 {
 public:
@@ -34,9 +62,6 @@ public:
     void handleWmConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
     void handleFcConfigUpdate(const std::string &key, const std::vector<swss::FieldValueTuple> &fvt);
 
-    void clearSingleWm(swss::Table *table, std::string wm_name, std::vector<sai_object_id_t> &obj_ids);
-    void clearSingleWm(swss::Table *table, std::string wm_name, const object_reference_map &nameOidMap);
-
     std::shared_ptr<swss::Table> getCountersTable(void)
     {
         return m_countersTable;
@@ -48,6 +73,9 @@ public:
     }
 
 private:
+    void addClearRequest(WatermarkClearBatch &batch, swss::Table *table, const std::string &data);
+    void clearPeriodicWatermarks();
+
     /*
     [7-2] - unused
     [1] - pg wm status
@@ -58,10 +86,24 @@ private:
 
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     std::shared_ptr<swss::DBConnector> m_appDb = nullptr;
+    std::shared_ptr<swss::DBConnector> m_stateDb = nullptr;
+    std::shared_ptr<swss::RedisPipeline> m_countersPipeline = nullptr;
     std::shared_ptr<swss::Table> m_countersTable = nullptr;
     std::shared_ptr<swss::Table> m_periodicWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_persistentWatermarkTable = nullptr;
     std::shared_ptr<swss::Table> m_userWatermarkTable = nullptr;
+    std::shared_ptr<swss::Table> m_statsTable = nullptr;
+
+    /*
+    The watermark plugins add the objects whose periodic watermarks become
+    non zero to a dirty set, only these are cleared at the end of a
+    telemetry interval. All of them are cleared the first time, or if the
+    dirty set can't be used.
+    */
+    std::string m_periodicClearSha;
+    bool m_periodicFullClear = true;
+    uint64_t m_periodicClears = 0;
+    uint64_t m_periodicClearLatencyMaxUs = 0;
 
     swss::NotificationConsumer* m_clearNotificationConsumer = nullptr;
     swss::SelectableTimer* m_telemetryTimer = nullptr;
@@ -6,6 +6,8 @@
 #include <schema.h>
 #include <tokenize.h>
 
+#include "recorder.h"
+
 using namespace std;
 using namespace swss;
 
@@ -15,6 +17,7 @@ static DBConnector db("APPL_DB", 0, true);
 void usage()
 {
 	cout << "Usage: swssplayer <file>" << endl;
+	cout << "    file: swss.rec recording, in text or binary format" << endl;
 	/* TODO: Add sample input file */
 }
 
@@ -66,13 +69,23 @@ int main(int argc, char **argv)
 		exit(EXIT_FAILURE);
 	}
 
-	ifstream file(argv[1]);
-	string line;
+	RecReader reader;
+	if (!reader.open(argv[1]))
+	{
+		cerr << "Failed to open " << argv[1] << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	string timestamp, record;
 
-	while (getline(file, line))
+	while (reader.next(timestamp, record))
 	{
-		auto tokens = tokenize(line, '|', 3);
-		processTokens(tokens);
+		auto tokens = tokenize(timestamp + "|" + record, '|', 3);
+		/* Skip the recording started records */
+		if (tokens.size() > 2)
+		{
+			processTokens(tokens);
+		}
 
 		line_index++;
 	}
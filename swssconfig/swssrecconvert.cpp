@@ -0,0 +1,50 @@
+#include <fstream>
+#include <iostream>
+
+#include "recorder.h"
+
+using namespace std;
+using namespace swss;
+
+void usage()
+{
+	cout << "Usage: swssrecconvert <file> [<output file>]" << endl;
+	cout << "    Write the records of a swss.rec or responsepublisher.rec recording, in" << endl;
+	cout << "    text or binary format, in text format to the output file or stdout" << endl;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 2 && argc != 3)
+	{
+		usage();
+		exit(EXIT_FAILURE);
+	}
+
+	RecReader reader;
+	if (!reader.open(argv[1]))
+	{
+		cerr << "Failed to open " << argv[1] << endl;
+		exit(EXIT_FAILURE);
+	}
+
+	ofstream file;
+	if (argc == 3)
+	{
+		file.open(argv[2]);
+		if (!file.is_open())
+		{
+			cerr << "Failed to open " << argv[2] << endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+	ostream &out = argc == 3 ? file : cout;
+
+	string timestamp, record;
+	while (reader.next(timestamp, record))
+	{
+		out << timestamp << "|" << record << "\n";
+	}
+
+	return 0;
+}
@@ -293,4 +293,157 @@ namespace aclorch_rule_test
         addTunnelNhRule(mock_invalid_nh_ip_str, mock_tunnel_name);
         ASSERT_FALSE(gAclOrch->getAclRule(acl_table, acl_rule));
     }
+
+    /* Bulk ACL entry functions of AclOrch, wrapped to count the calls and fail one entry */
+    sai_bulk_object_create_fn old_create_acl_entries;
+    sai_bulk_object_remove_fn old_remove_acl_entries;
+    uint32_t bulk_create_acl_entries_calls;
+    uint32_t bulk_remove_acl_entries_calls;
+    uint32_t bulk_acl_entries_count;
+    int fail_acl_entry_index;
+
+    sai_status_t create_acl_entries(GENERIC_BULK_CREATE_PARAMS(acl_entry))
+    {
+        bulk_create_acl_entries_calls++;
+        bulk_acl_entries_count += object_count;
+
+        auto status = old_create_acl_entries(GENERIC_BULK_CREATE_ARGS(acl_entry));
+        if (fail_acl_entry_index >= 0 && (uint32_t)fail_acl_entry_index < object_count)
+        {
+            old_sai_acl_api->remove_acl_entry(object_id[fail_acl_entry_index]);
+            object_id[fail_acl_entry_index] = SAI_NULL_OBJECT_ID;
+            object_statuses[fail_acl_entry_index] = SAI_STATUS_FAILURE;
+            status = SAI_STATUS_FAILURE;
+        }
+        return status;
+    }
+
+    sai_status_t remove_acl_entries(GENERIC_BULK_REMOVE_PARAMS(acl_entry))
+    {
+        bulk_remove_acl_entries_calls++;
+        bulk_acl_entries_count += object_count;
+
+        return old_remove_acl_entries(GENERIC_BULK_REMOVE_ARGS(acl_entry));
+    }
+
+    struct AclBulkRuleTest : public AclOrchRuleTest
+    {
+        string acl_table_type = "TEST_BULK_ACL_TABLE_TYPE";
+        string acl_table = "TEST_BULK_ACL_TABLE";
+
+        void PostSetUp() override
+        {
+            AclOrchRuleTest::PostSetUp();
+
+            auto &bulker = Portal::AclOrchInternal::getAclEntryBulker(gAclOrch);
+            old_create_acl_entries = bulker.create_entries;
+            old_remove_acl_entries = bulker.remove_entries;
+            bulker.create_entries = create_acl_entries;
+            bulker.remove_entries = remove_acl_entries;
+            bulk_create_acl_entries_calls = 0;
+            bulk_remove_acl_entries_calls = 0;
+            bulk_acl_entries_count = 0;
+            fail_acl_entry_index = -1;
+
+            doAclTableTypeTask({
+                {
+                    acl_table_type,
+                    SET_COMMAND,
+                    {
+                        { ACL_TABLE_TYPE_MATCHES, MATCH_DST_IP },
+                        { ACL_TABLE_TYPE_ACTIONS, ACTION_PACKET_ACTION }
+                    }
+                }
+            });
+            doAclTableTask({
+                {
+                    acl_table,
+                    SET_COMMAND,
+                    {
+                        { ACL_TABLE_TYPE, acl_table_type },
+                        { ACL_TABLE_STAGE, STAGE_INGRESS },
+                    }
+                }
+            });
+        }
+
+        void PreTearDown() override
+        {
+            auto &bulker = Portal::AclOrchInternal::getAclEntryBulker(gAclOrch);
+            bulker.create_entries = old_create_acl_entries;
+            bulker.remove_entries = old_remove_acl_entries;
+
+            AclOrchRuleTest::PreTearDown();
+        }
+
+        KeyOpFieldsValuesTuple dropRule(const string &rule, const string &dstIp)
+        {
+            return {
+                acl_table + "|" + rule,
+                SET_COMMAND,
+                {
+                    { RULE_PRIORITY, "9999" },
+                    { MATCH_DST_IP, dstIp },
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP }
+                }
+            };
+        }
+    };
+
+    TEST_F(AclBulkRuleTest, BulkCreateRemove_PerRuleStatus)
+    {
+        /* The rules of one task are created in one bulk call, the failure of one rule does not fail the others */
+        EXPECT_CALL(*mock_sai_acl_api, create_acl_entry).Times(0);
+        fail_acl_entry_index = 1;
+        doAclRuleTask({
+            dropRule("RULE_1", "10.0.0.1/32"),
+            dropRule("RULE_2", "10.0.0.2/32"),
+            dropRule("RULE_3", "10.0.0.3/32")
+        });
+
+        auto rule1 = gAclOrch->getAclRule(acl_table, "RULE_1");
+        auto rule3 = gAclOrch->getAclRule(acl_table, "RULE_3");
+        ASSERT_TRUE(rule1);
+        ASSERT_TRUE(rule3);
+        ASSERT_NE(rule1->getOid(), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(rule3->getOid(), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(rule1->getCounterOid(), rule3->getCounterOid());
+        ASSERT_FALSE(gAclOrch->getAclRule(acl_table, "RULE_2"));
+        ASSERT_EQ(bulk_create_acl_entries_calls, 1);
+        ASSERT_EQ(bulk_acl_entries_count, 3);
+
+        /* Both rules are removed in one bulk call */
+        EXPECT_CALL(*mock_sai_acl_api, remove_acl_entry).Times(0);
+        bulk_acl_entries_count = 0;
+        doAclRuleTask({
+            { acl_table + "|RULE_1", DEL_COMMAND, { } },
+            { acl_table + "|RULE_3", DEL_COMMAND, { } }
+        });
+        ASSERT_FALSE(gAclOrch->getAclRule(acl_table, "RULE_1"));
+        ASSERT_FALSE(gAclOrch->getAclRule(acl_table, "RULE_3"));
+        ASSERT_EQ(bulk_remove_acl_entries_calls, 1);
+        ASSERT_EQ(bulk_acl_entries_count, 2);
+    }
+
+    TEST_F(AclBulkRuleTest, BulkDelSetSameRule)
+    {
+        /* DEL and SET of the same rule in one task are applied in order, each on the single object path */
+        doAclRuleTask({ dropRule("RULE_1", "10.0.0.1/32") });
+        auto rule = gAclOrch->getAclRule(acl_table, "RULE_1");
+        ASSERT_TRUE(rule);
+        auto oldOid = rule->getOid();
+
+        EXPECT_CALL(*mock_sai_acl_api, remove_acl_entry).Times(1);
+        EXPECT_CALL(*mock_sai_acl_api, create_acl_entry).Times(1);
+        doAclRuleTask({
+            { acl_table + "|RULE_1", DEL_COMMAND, { } },
+            dropRule("RULE_1", "10.0.0.2/32")
+        });
+
+        rule = gAclOrch->getAclRule(acl_table, "RULE_1");
+        ASSERT_TRUE(rule);
+        ASSERT_NE(rule->getOid(), oldOid);
+        ASSERT_EQ(bulk_create_acl_entries_calls, 0);
+        ASSERT_EQ(bulk_remove_acl_entries_calls, 0);
+    }
 }
@@ -1755,6 +1755,20 @@ namespace aclorch_test
         ASSERT_TRUE(orch->getAclRule(aclTableName, aclRuleName));
     }
 
+    // Bulk ACL entry attribute set of AclOrch, wrapped to count the calls
+    sai_bulk_object_set_attribute_fn old_set_acl_entries_attribute;
+    uint32_t bulk_set_acl_entries_calls;
+    uint32_t bulk_set_acl_entries_count;
+
+    sai_status_t set_acl_entries_attribute(uint32_t object_count, const sai_object_id_t *object_id,
+                                           const sai_attribute_t *attr_list, sai_bulk_op_error_mode_t mode,
+                                           sai_status_t *object_statuses)
+    {
+        bulk_set_acl_entries_calls++;
+        bulk_set_acl_entries_count += object_count;
+        return old_set_acl_entries_attribute(object_count, object_id, attr_list, mode, object_statuses);
+    }
+
     TEST_F(AclOrchTest, AclRuleUpdate)
     {
         string acl_table_id = "acl_table_1";
@@ -1809,6 +1823,13 @@ namespace aclorch_test
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP), "1.1.1.1&mask:255.255.255.255");
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_FORWARD");
 
+        auto &entryBulker = Portal::AclOrchInternal::getAclEntryBulker(orch->m_aclOrch);
+        old_set_acl_entries_attribute = entryBulker.set_entries_attribute;
+        entryBulker.set_entries_attribute = set_acl_entries_attribute;
+        bulk_set_acl_entries_calls = 0;
+        bulk_set_acl_entries_count = 0;
+
+        // The changed priority, matches and action are set with one bulk call
         auto updatedRule = make_shared<AclRuleTest>(*rule);
         ASSERT_TRUE(updatedRule->validateAddPriority(RULE_PRIORITY, "900"));
         ASSERT_TRUE(updatedRule->validateAddMatch(MATCH_SRC_IP, "2.2.2.2/24"));
@@ -1816,6 +1837,8 @@ namespace aclorch_test
         ASSERT_TRUE(updatedRule->validateAddAction(ACTION_PACKET_ACTION, PACKET_ACTION_DROP));
 
         ASSERT_TRUE(orch->m_aclOrch->updateAclRule(updatedRule));
+        ASSERT_EQ(bulk_set_acl_entries_calls, 1);
+        ASSERT_EQ(bulk_set_acl_entries_count, 4);
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_PRIORITY), "900");
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP), "2.2.2.2&mask:255.255.255.0");
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_FIELD_DST_IP), "3.3.3.3&mask:255.255.255.0");
@@ -1824,7 +1847,9 @@ namespace aclorch_test
         auto updatedRule2 = make_shared<AclRuleTest>(*updatedRule);
         updatedRule2->setCounterEnabled(false);
         updatedRule2->disableMatch(SAI_ACL_ENTRY_ATTR_FIELD_DST_IP);
+        // A single changed attribute is set without the bulker
         ASSERT_TRUE(orch->m_aclOrch->updateAclRule(updatedRule2));
+        ASSERT_EQ(bulk_set_acl_entries_calls, 1);
         ASSERT_TRUE(validateAclRuleCounter(*orch->m_aclOrch->getAclRule(acl_table_id, acl_rule_id), false));
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_PRIORITY), "900");
         ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP), "2.2.2.2&mask:255.255.255.0");
@@ -1836,7 +1861,31 @@ namespace aclorch_test
         ASSERT_TRUE(orch->m_aclOrch->updateAclRule(updatedRule3));
         ASSERT_TRUE(validateAclRuleCounter(*orch->m_aclOrch->getAclRule(acl_table_id, acl_rule_id), true));
 
+        // The changed attributes of several rules are set with one bulk call
+        auto rule2 = make_shared<AclRuleTest>(orch->m_aclOrch, "acl_rule_2", acl_table_id);
+        ASSERT_TRUE(rule2->validateAddPriority(RULE_PRIORITY, "700"));
+        ASSERT_TRUE(rule2->validateAddMatch(MATCH_SRC_IP, "4.4.4.4/32"));
+        ASSERT_TRUE(rule2->validateAddAction(ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD));
+        ASSERT_TRUE(orch->m_aclOrch->addAclRule(rule2, acl_table_id));
+
+        auto updatedRule4 = make_shared<AclRuleTest>(*updatedRule3);
+        ASSERT_TRUE(updatedRule4->validateAddAction(ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD));
+        auto updatedRule5 = make_shared<AclRuleTest>(*rule2);
+        ASSERT_TRUE(updatedRule5->validateAddAction(ACTION_PACKET_ACTION, PACKET_ACTION_DROP));
+
+        bulk_set_acl_entries_calls = 0;
+        bulk_set_acl_entries_count = 0;
+        auto results = orch->m_aclOrch->updateAclRules({ updatedRule4, updatedRule5 });
+        ASSERT_EQ(results, vector<bool>({ true, true }));
+        ASSERT_EQ(bulk_set_acl_entries_calls, 1);
+        ASSERT_EQ(bulk_set_acl_entries_count, 2);
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_FORWARD");
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule2, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_DROP");
+
+        entryBulker.set_entries_attribute = old_set_acl_entries_attribute;
+
         ASSERT_TRUE(orch->m_aclOrch->removeAclRule(rule->getTableId(), rule->getId()));
+        ASSERT_TRUE(orch->m_aclOrch->removeAclRule(rule2->getTableId(), rule2->getId()));
     }
 
     TEST_F(AclOrchTest, deleteNonExistingRule)
@@ -1864,6 +1913,145 @@ namespace aclorch_test
         ASSERT_TRUE(orch->m_aclOrch->removeAclRule(tableId, ruleId));
     }
 
+    // Counters of the ACL entry and counter SAI calls made by AclOrch
+    namespace acl_bulk_benchmark
+    {
+        sai_acl_api_t *old_acl_api;
+        sai_bulk_object_create_fn old_create_entries[2];
+        sai_bulk_object_remove_fn old_remove_entries[2];
+        size_t sai_calls;
+
+        sai_status_t create_acl_entry(sai_object_id_t *id, sai_object_id_t switch_id, uint32_t count, const sai_attribute_t *attrs)
+        {
+            sai_calls++;
+            return old_acl_api->create_acl_entry(id, switch_id, count, attrs);
+        }
+
+        sai_status_t remove_acl_entry(sai_object_id_t id)
+        {
+            sai_calls++;
+            return old_acl_api->remove_acl_entry(id);
+        }
+
+        sai_status_t create_acl_counter(sai_object_id_t *id, sai_object_id_t switch_id, uint32_t count, const sai_attribute_t *attrs)
+        {
+            sai_calls++;
+            return old_acl_api->create_acl_counter(id, switch_id, count, attrs);
+        }
+
+        sai_status_t remove_acl_counter(sai_object_id_t id)
+        {
+            sai_calls++;
+            return old_acl_api->remove_acl_counter(id);
+        }
+
+        template <int N>
+        sai_status_t create_entries(sai_object_id_t switch_id, uint32_t object_count, const uint32_t *attr_count,
+                                    const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode,
+                                    sai_object_id_t *object_id, sai_status_t *object_statuses)
+        {
+            sai_calls++;
+            return old_create_entries[N](switch_id, object_count, attr_count, attr_list, mode, object_id, object_statuses);
+        }
+
+        template <int N>
+        sai_status_t remove_entries(uint32_t object_count, const sai_object_id_t *object_id,
+                                    sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+        {
+            sai_calls++;
+            return old_remove_entries[N](object_count, object_id, mode, object_statuses);
+        }
+    }
+
+    // Reports the number of SAI calls made to create and remove ACL rules with and without batching.
+    // Run with --gtest_also_run_disabled_tests --gtest_filter=*AclRule_Bulk_Benchmark*
+    TEST_F(AclOrchTest, DISABLED_AclRule_Bulk_Benchmark)
+    {
+        using namespace acl_bulk_benchmark;
+
+        string tableId = "acl_table";
+        const size_t ruleCount = 4096;
+
+        auto orch = createAclOrch();
+
+        orch->doAclTableTask(deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }}));
+
+        deque<KeyOpFieldsValuesTuple> setRules;
+        deque<KeyOpFieldsValuesTuple> delRules;
+        for (size_t i = 0; i < ruleCount; i++)
+        {
+            string key = tableId + "|rule_" + to_string(i);
+            string dstIp = "10." + to_string((i >> 8) & 0xff) + "." + to_string(i & 0xff) + ".1/32";
+            setRules.push_back({ key, SET_COMMAND, {
+                { RULE_PRIORITY, to_string(1000 + i) },
+                { MATCH_DST_IP, dstIp },
+                { ACTION_PACKET_ACTION, PACKET_ACTION_DROP }
+            }});
+            delRules.push_back({ key, DEL_COMMAND, {} });
+        }
+
+        sai_acl_api_t counting_acl_api = *sai_acl_api;
+        counting_acl_api.create_acl_entry = acl_bulk_benchmark::create_acl_entry;
+        counting_acl_api.remove_acl_entry = acl_bulk_benchmark::remove_acl_entry;
+        counting_acl_api.create_acl_counter = acl_bulk_benchmark::create_acl_counter;
+        counting_acl_api.remove_acl_counter = acl_bulk_benchmark::remove_acl_counter;
+        old_acl_api = sai_acl_api;
+        sai_acl_api = &counting_acl_api;
+
+        auto &entryBulker = Portal::AclOrchInternal::getAclEntryBulker(orch->m_aclOrch);
+        auto &counterBulker = Portal::AclOrchInternal::getAclCounterBulker(orch->m_aclOrch);
+        old_create_entries[0] = entryBulker.create_entries;
+        old_remove_entries[0] = entryBulker.remove_entries;
+        old_create_entries[1] = counterBulker.create_entries;
+        old_remove_entries[1] = counterBulker.remove_entries;
+        entryBulker.create_entries = create_entries<0>;
+        entryBulker.remove_entries = remove_entries<0>;
+        counterBulker.create_entries = create_entries<1>;
+        counterBulker.remove_entries = remove_entries<1>;
+
+        map<bool, pair<size_t, size_t>> results;
+        for (bool bulk : { false, true })
+        {
+            orch->m_aclOrch->setRuleBulkEnabled(bulk);
+
+            sai_calls = 0;
+            orch->doAclRuleTask(setRules);
+            size_t createCalls = sai_calls;
+            ASSERT_EQ(orch->getAclTable(tableId)->rules.size(), ruleCount);
+
+            sai_calls = 0;
+            orch->doAclRuleTask(delRules);
+            size_t removeCalls = sai_calls;
+            ASSERT_TRUE(orch->getAclTable(tableId)->rules.empty());
+
+            results[bulk] = { createCalls, removeCalls };
+            cout << (bulk ? "bulk  " : "single") << " mode: "
+                 << ruleCount << " rules, " << createCalls << " SAI calls to create, "
+                 << removeCalls << " SAI calls to remove" << endl;
+        }
+
+        entryBulker.create_entries = old_create_entries[0];
+        entryBulker.remove_entries = old_remove_entries[0];
+        counterBulker.create_entries = old_create_entries[1];
+        counterBulker.remove_entries = old_remove_entries[1];
+        sai_acl_api = old_acl_api;
+
+        // One call per ACL entry and per counter without batching
+        ASSERT_EQ(results[false].first, 2 * ruleCount);
+        ASSERT_EQ(results[false].second, 2 * ruleCount);
+        ASSERT_LT(results[true].first, results[false].first);
+        ASSERT_LT(results[true].second, results[false].second);
+    }
+
     sai_switch_api_t *old_sai_switch_api;
 
     // The following function is used to override SAI API get_switch_attribute to request passing
@@ -0,0 +1,254 @@
+#include <errno.h>
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "rtnlclient.h"
+
+/* Override this pointer for custom behavior */
+int (*rtnlCallback)(const std::string &call) = nullptr;
+
+int mockRtnlReturn = 0;
+std::vector<std::string> mockRtnlCalls;
+
+namespace
+{
+    /*
+     * Record an operation, like "setLinkMtu Ethernet0 9100", and return its
+     * result. linkExists is true when its result is 0.
+     */
+    int mockCall(const std::string &call)
+    {
+        mockRtnlCalls.push_back(call);
+        return rtnlCallback != nullptr ? rtnlCallback(call) : mockRtnlReturn;
+    }
+
+    std::string ranges(const std::vector<swss::RtnlClient::BridgeVlanRange> &vlans)
+    {
+        std::string result;
+        for (const auto &range : vlans)
+        {
+            result += (result.empty() ? "" : ",") + std::to_string(range.vlanId);
+            if (range.lastVlanId > range.vlanId)
+            {
+                result += "-" + std::to_string(range.lastVlanId);
+            }
+            if (range.pvidUntagged)
+            {
+                result += " untagged";
+            }
+        }
+        return result;
+    }
+}
+
+namespace swss {
+
+RtnlClient::RtnlClient()
+{
+}
+
+RtnlClient::~RtnlClient()
+{
+}
+
+bool RtnlClient::isRetriable(int err)
+{
+    return err == -ENODEV || err == -EBUSY || err == -EAGAIN;
+}
+
+std::string RtnlClient::errorString(int err)
+{
+    return strerror(-err);
+}
+
+void RtnlClient::beginBatch()
+{
+    m_batching = true;
+    m_results.clear();
+}
+
+int RtnlClient::commitBatch()
+{
+    m_batching = false;
+    for (int result : m_results)
+    {
+        if (result)
+        {
+            return result;
+        }
+    }
+    return 0;
+}
+
+/* The operations are applied at once, a batch only collects their results */
+int RtnlClient::failRequest(int err)
+{
+    if (!m_batching)
+    {
+        m_results.clear();
+    }
+    m_results.push_back(err);
+
+    return err;
+}
+
+bool RtnlClient::linkExists(const std::string &ifname)
+{
+    return mockCall("linkExists " + ifname) == 0;
+}
+
+int RtnlClient::getVrfs(std::map<std::string, uint32_t> &vrfs)
+{
+    vrfs.clear();
+    return mockCall("getVrfs");
+}
+
+int RtnlClient::getLinks(const std::string &kind, std::vector<std::string> &ifnames)
+{
+    ifnames.clear();
+    return mockCall("getLinks " + kind);
+}
+
+int RtnlClient::addBridge(const std::string &ifname, bool up)
+{
+    return failRequest(mockCall("addBridge " + ifname + (up ? " up" : "")));
+}
+
+int RtnlClient::addDummy(const std::string &ifname)
+{
+    return failRequest(mockCall("addDummy " + ifname));
+}
+
+int RtnlClient::addVlan(const std::string &ifname, const std::string &parent, uint16_t vlanId,
+                        const MacAddress &mac, bool up)
+{
+    return failRequest(mockCall("addVlan " + ifname + " " + parent + " " + std::to_string(vlanId) +
+                                " " + mac.to_string() + (up ? " up" : "")));
+}
+
+int RtnlClient::addVlan(const std::string &ifname, const std::string &parent, uint16_t vlanId, bool up)
+{
+    return failRequest(mockCall("addVlan " + ifname + " " + parent + " " + std::to_string(vlanId) + (up ? " up" : "")));
+}
+
+int RtnlClient::addVrf(const std::string &ifname, uint32_t table)
+{
+    return failRequest(mockCall("addVrf " + ifname + " " + std::to_string(table)));
+}
+
+int RtnlClient::addVxlan(const std::string &ifname, uint32_t vni, const IpAddress *srcIp, const IpAddress *dstIp,
+                         uint16_t dstPort, bool learning, const MacAddress *mac)
+{
+    return failRequest(mockCall("addVxlan " + ifname + " " + std::to_string(vni) +
+                                (srcIp ? " local " + srcIp->to_string() : "") +
+                                (dstIp ? " remote " + dstIp->to_string() : "") +
+                                " dstport " + std::to_string(dstPort) + (learning ? "" : " nolearning") +
+                                (mac ? " address " + mac->to_string() : "")));
+}
+
+int RtnlClient::delLink(const std::string &ifname)
+{
+    return failRequest(mockCall("delLink " + ifname));
+}
+
+int RtnlClient::setLinkAdminState(const std::string &ifname, bool up)
+{
+    return failRequest(mockCall("setLinkAdminState " + ifname + (up ? " up" : " down")));
+}
+
+int RtnlClient::setLinkMtu(const std::string &ifname, uint32_t mtu)
+{
+    return failRequest(mockCall("setLinkMtu " + ifname + " " + std::to_string(mtu)));
+}
+
+int RtnlClient::setLinkMac(const std::string &ifname, const MacAddress &mac)
+{
+    return failRequest(mockCall("setLinkMac " + ifname + " " + mac.to_string()));
+}
+
+int RtnlClient::setLinkMaster(const std::string &ifname, const std::string &master)
+{
+    return failRequest(mockCall("setLinkMaster " + ifname + (master.empty() ? " nomaster" : " " + master)));
+}
+
+int RtnlClient::setBridgeVlanFiltering(const std::string &ifname, bool enable)
+{
+    return failRequest(mockCall("setBridgeVlanFiltering " + ifname + " " + std::to_string(enable)));
+}
+
+int RtnlClient::setBridgeNoLinkLocalLearn(const std::string &ifname, bool enable)
+{
+    return failRequest(mockCall("setBridgeNoLinkLocalLearn " + ifname + " " + std::to_string(enable)));
+}
+
+int RtnlClient::setBridgePortLearning(const std::string &ifname, bool enable)
+{
+    return failRequest(mockCall("setBridgePortLearning " + ifname + (enable ? " on" : " off")));
+}
+
+int RtnlClient::addBridgeVlan(const std::string &ifname, uint16_t vlanId, bool pvidUntagged,
+                              bool self, uint16_t lastVlanId)
+{
+    return failRequest(mockCall("addBridgeVlans " + ifname + " " + ranges({{vlanId, lastVlanId, pvidUntagged}}) +
+                                (self ? " self" : "")));
+}
+
+int RtnlClient::delBridgeVlan(const std::string &ifname, uint16_t vlanId, bool self, uint16_t lastVlanId)
+{
+    return failRequest(mockCall("delBridgeVlans " + ifname + " " + ranges({{vlanId, lastVlanId, false}}) +
+                                (self ? " self" : "")));
+}
+
+int RtnlClient::addBridgeVlans(const std::string &ifname, const std::vector<BridgeVlanRange> &vlans, bool self)
+{
+    return failRequest(mockCall("addBridgeVlans " + ifname + " " + ranges(vlans) + (self ? " self" : "")));
+}
+
+int RtnlClient::delBridgeVlans(const std::string &ifname, const std::vector<BridgeVlanRange> &vlans, bool self)
+{
+    return failRequest(mockCall("delBridgeVlans " + ifname + " " + ranges(vlans) + (self ? " self" : "")));
+}
+
+int RtnlClient::getBridgeVlans(const std::string &ifname, std::vector<uint16_t> &vlans)
+{
+    vlans.clear();
+    return mockCall("getBridgeVlans " + ifname);
+}
+
+int RtnlClient::addAddress(const std::string &ifname, const IpPrefix &prefix, bool broadcast, uint32_t metric)
+{
+    return failRequest(mockCall("addAddress " + ifname + " " + prefix.to_string() +
+                                (broadcast && prefix.isV4() ? " broadcast " + prefix.getBroadcastIp().to_string() : "") +
+                                (metric ? " metric " + std::to_string(metric) : "")));
+}
+
+int RtnlClient::delAddress(const std::string &ifname, const IpPrefix &prefix)
+{
+    return failRequest(mockCall("delAddress " + ifname + " " + prefix.to_string()));
+}
+
+int RtnlClient::addNeighbor(const std::string &ifname, const IpAddress &ip, const MacAddress &mac)
+{
+    return failRequest(mockCall("addNeighbor " + ifname + " " + ip.to_string() + " " + mac.to_string()));
+}
+
+int RtnlClient::delNeighbor(const std::string &ifname, const IpAddress &ip)
+{
+    return failRequest(mockCall("delNeighbor " + ifname + " " + ip.to_string()));
+}
+
+int RtnlClient::addRoute(const std::string &ifname, const IpPrefix &prefix, uint32_t metric)
+{
+    return failRequest(mockCall("addRoute " + ifname + " " + prefix.to_string() +
+                                (metric ? " metric " + std::to_string(metric) : "")));
+}
+
+int RtnlClient::delRoute(const IpPrefix &prefix)
+{
+    return failRequest(mockCall("delRoute " + prefix.to_string()));
+}
+
+}
@@ -3,6 +3,7 @@
 #include "mock_table.h"
 
 #include <sstream>
+#include <chrono>
 
 extern PortsOrch *gPortsOrch;
 
@@ -368,4 +369,129 @@ namespace consumer_test
         test_consumer.execute();
         ASSERT_EQ(test_orch.m_notification_count, consumer_pops_batch_size*2);
     }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_Hashed_Fifo_Order)
+    {
+        consumer->setPendingTaskIndex(SyncMapIndex::Hashed);
+
+        // Keys are returned in arrival order instead of key order
+        vector<string> keys = { "key_c", "key_a", "key_b" };
+        for (const auto &k : keys)
+        {
+            consumer->addToSync(KeyOpFieldsValuesTuple({ k, SET_COMMAND, { { f1, v1a } } }));
+        }
+
+        // A DEL of an existing key is kept at the key's original position
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "key_a", DEL_COMMAND, { } }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ "key_a", SET_COMMAND, { { f2, v2a } } }));
+
+        vector<pair<string, string>> expected = {
+            { "key_c", SET_COMMAND },
+            { "key_a", DEL_COMMAND },
+            { "key_a", SET_COMMAND },
+            { "key_b", SET_COMMAND } };
+
+        ASSERT_EQ(consumer->m_toSync.size(), expected.size());
+        auto it = consumer->m_toSync.begin();
+        for (const auto &exp : expected)
+        {
+            ASSERT_EQ(it->first, exp.first);
+            ASSERT_EQ(kfvOp(it->second), exp.second);
+            it++;
+        }
+        ASSERT_EQ(consumer->m_toSync.count("key_a"), 2UL);
+
+        // Switching back to the ordered index sorts the pending keys
+        consumer->setPendingTaskIndex(SyncMapIndex::Ordered);
+        ASSERT_EQ(consumer->m_toSync.begin()->first, "key_a");
+        ASSERT_EQ(consumer->m_toSync.rbegin()->first, "key_c");
+    }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_Hashed_Del_Set_Merge)
+    {
+        consumer->setPendingTaskIndex(SyncMapIndex::Hashed);
+
+        // Same sequence as ConsumerAddToSync_Del_Set_Multiple, the result must not
+        // depend on the index type
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                DEL_COMMAND,
+                { { } } });
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+        auto entryc = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1b },
+                    { f3, v3a } } });
+
+        kofv_q.push_back(entrya);
+        kofv_q.push_back(entryb);
+        kofv_q.push_back(entryc);
+        consumer->addToSync(kofv_q);
+
+        exp_kofv = entrya;
+        validate_syncmap(consumer->m_toSync, 2, key, exp_kofv);
+
+        exp_kofv = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f2, v2a },
+                    { f1, v1b },
+                    { f3, v3a } } });
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+    }
+
+    /*
+     * Microbenchmark of the pending task index. It is disabled by default,
+     * run with --gtest_also_run_disabled_tests --gtest_filter=*SyncMap_Benchmark*
+     */
+    TEST_F(ConsumerTest, DISABLED_SyncMap_Benchmark)
+    {
+        for (size_t count : { 100000UL, 1000000UL })
+        {
+            vector<KeyOpFieldsValuesTuple> entries;
+            entries.reserve(count);
+            for (size_t i = 0; i < count; i++)
+            {
+                string prefix = to_string((i >> 16) & 0xff) + "." + to_string((i >> 8) & 0xff) + "."
+                                + to_string(i & 0xff) + ".0/24";
+                entries.emplace_back(prefix, SET_COMMAND, vector<FieldValueTuple>{ { "nexthop", "10.0.0.1" }, { "ifname", "Ethernet0" } });
+            }
+
+            for (auto index : { SyncMapIndex::Ordered, SyncMapIndex::Hashed })
+            {
+                SyncMap sync(index);
+
+                auto start = chrono::steady_clock::now();
+                for (const auto &entry : entries)
+                {
+                    sync.emplace(kfvKey(entry), entry);
+                }
+                // Update every key once more, as seen during route flaps
+                for (const auto &entry : entries)
+                {
+                    auto range = sync.equal_range(kfvKey(entry));
+                    range.first->second = entry;
+                }
+                auto inserted = chrono::steady_clock::now();
+                for (auto it = sync.begin(); it != sync.end();)
+                {
+                    it = sync.erase(it);
+                }
+                auto drained = chrono::steady_clock::now();
+
+                cout << "SyncMap " << (index == SyncMapIndex::Ordered ? "ordered" : "hashed")
+                     << " keys " << count
+                     << " insert+update " << chrono::duration_cast<chrono::milliseconds>(inserted - start).count() << " ms"
+                     << " drain " << chrono::duration_cast<chrono::milliseconds>(drained - inserted).count() << " ms"
+                     << endl;
+
+                ASSERT_TRUE(sync.empty());
+            }
+        }
+    }
 }
@@ -0,0 +1,333 @@
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define private public
+#include "countercheckorch.h"
+#include "pfcwdorch.h"
+#undef private
+#include "mock_orch_test.h"
+#include "sai_serialize.h"
+
+namespace countersnapshot_test
+{
+    using namespace std;
+    using namespace swss;
+
+    class CounterSnapshotTest : public ::testing::Test
+    {
+    protected:
+        string m_group = "UT_" + to_string(getpid());
+    };
+
+    TEST_F(CounterSnapshotTest, WriteAndRead)
+    {
+        CounterSnapshotReader reader(m_group);
+        CounterSnapshot snapshot;
+        uint64_t value;
+
+        /* No region, the counters are to be read from redis */
+        ASSERT_FALSE(reader.read(snapshot));
+        ASSERT_EQ(reader.getStats().redisFallbacks, 1u);
+
+        {
+            CounterSnapshotWriter writer(m_group, 4, 2);
+            ASSERT_TRUE(writer.isValid());
+            ASSERT_FALSE(writer.setLayout({1, 2, 3, 4, 5}, {"SAI_PORT_STAT_IF_IN_OCTETS"}));
+            ASSERT_FALSE(writer.setLayout({1}, {string(CounterSnapshot::COUNTER_NAME_SIZE, 'A')}));
+
+            ASSERT_TRUE(writer.setLayout({0x1000000000001, 0x1000000000002},
+                                         {"SAI_PORT_STAT_IF_IN_OCTETS", "SAI_PORT_STAT_IF_OUT_OCTETS"}));
+            /* No poll published yet */
+            ASSERT_FALSE(reader.read(snapshot));
+
+            writer.begin();
+            writer.set(0, 0, 100);
+            writer.set(0, 1, 200);
+            writer.set(1, 0, 300);
+            writer.set(2, 0, 400);
+            writer.commit();
+
+            ASSERT_TRUE(reader.read(snapshot));
+            ASSERT_EQ(reader.getStats().snapshotReads, 1u);
+            ASSERT_EQ(reader.getStats().redisFallbacks, 2u);
+            ASSERT_EQ(snapshot.getPoll(), 1u);
+            ASSERT_EQ(snapshot.getObjects().size(), 2u);
+            ASSERT_EQ(snapshot.getCounters()[1], "SAI_PORT_STAT_IF_OUT_OCTETS");
+            ASSERT_TRUE(snapshot.get(0x1000000000001, "SAI_PORT_STAT_IF_OUT_OCTETS", value));
+            ASSERT_EQ(value, 200u);
+            ASSERT_TRUE(snapshot.get(0x1000000000002, "SAI_PORT_STAT_IF_IN_OCTETS", value));
+            ASSERT_EQ(value, 300u);
+            /* Not read at this poll */
+            ASSERT_FALSE(snapshot.get(0x1000000000002, "SAI_PORT_STAT_IF_OUT_OCTETS", value));
+            ASSERT_EQ(snapshot.getValue(1, 1), CounterSnapshot::NOT_AVAILABLE);
+            ASSERT_FALSE(snapshot.get(0x1000000000003, "SAI_PORT_STAT_IF_IN_OCTETS", value));
+            ASSERT_EQ(snapshot.getCounterIndex("SAI_PORT_STAT_IF_IN_ERRORS"), CounterSnapshot::NOT_FOUND);
+        }
+
+        /* The region is gone with its writer */
+        ASSERT_FALSE(reader.read(snapshot));
+        ASSERT_EQ(reader.getStats().redisFallbacks, 3u);
+
+        /* A new writer of the group has a new layout, even with the same objects */
+        CounterSnapshotWriter writer(m_group, 1, 1);
+        ASSERT_TRUE(writer.setLayout({0x1000000000001}, {"SAI_PORT_STAT_IF_IN_OCTETS"}));
+        writer.begin();
+        writer.set(0, 0, 500);
+        writer.commit();
+
+        uint64_t layout = snapshot.getLayout();
+        ASSERT_TRUE(reader.read(snapshot));
+        ASSERT_NE(snapshot.getLayout(), layout);
+        ASSERT_EQ(snapshot.getObjects().size(), 1u);
+        ASSERT_TRUE(snapshot.get(0x1000000000001, "SAI_PORT_STAT_IF_IN_OCTETS", value));
+        ASSERT_EQ(value, 500u);
+    }
+
+    TEST_F(CounterSnapshotTest, ConcurrentPolls)
+    {
+        const size_t objects = 64;
+        const size_t counters = 32;
+
+        CounterSnapshotWriter writer(m_group, objects, counters);
+        vector<uint64_t> objectIds;
+        vector<string> counterNames;
+        for (size_t i = 0; i < objects; i++)
+        {
+            objectIds.push_back(0x1000000000000 + i);
+        }
+        for (size_t i = 0; i < counters; i++)
+        {
+            counterNames.push_back("COUNTER_" + to_string(i));
+        }
+        ASSERT_TRUE(writer.setLayout(objectIds, counterNames));
+
+        /* Each poll writes its number in all the counters, a reader never sees two polls mixed */
+        atomic<bool> stop(false);
+        thread poller([&]() {
+            for (uint64_t poll = 1; !stop; poll++)
+            {
+                writer.begin();
+                for (size_t i = 0; i < objects; i++)
+                {
+                    for (size_t j = 0; j < counters; j++)
+                    {
+                        writer.set(i, j, poll);
+                    }
+                }
+                writer.commit();
+                this_thread::sleep_for(chrono::microseconds(50));
+            }
+        });
+
+        CounterSnapshotReader reader(m_group);
+        CounterSnapshot snapshot;
+        size_t reads = 0;
+        bool mixed = false;
+        for (int i = 0; i < 2000 && !mixed; i++)
+        {
+            if (!reader.read(snapshot))
+            {
+                continue;
+            }
+            reads++;
+
+            uint64_t poll = snapshot.getPoll();
+            for (size_t j = 0; j < objects && !mixed; j++)
+            {
+                for (size_t k = 0; k < counters; k++)
+                {
+                    mixed |= snapshot.getValue(j, k) != poll;
+                }
+            }
+        }
+
+        stop = true;
+        poller.join();
+
+        ASSERT_GT(reads, 0u);
+        ASSERT_FALSE(mixed);
+    }
+
+    /* A poller publishing the same value, the poll number, in all the counters of a group */
+    class SnapshotPoller
+    {
+    public:
+        SnapshotPoller(const string &group, const vector<uint64_t> &objects, const vector<string> &counters) :
+            m_writer(group, objects.size(), counters.size())
+        {
+            m_valid = m_writer.setLayout(objects, counters);
+            m_thread = thread([this, objects, counters]() {
+                for (uint64_t poll = 1; !m_stop; poll++)
+                {
+                    m_writer.begin();
+                    for (size_t i = 0; i < objects.size(); i++)
+                    {
+                        for (size_t j = 0; j < counters.size(); j++)
+                        {
+                            m_writer.set(i, j, poll);
+                        }
+                    }
+                    m_writer.commit();
+                    this_thread::sleep_for(chrono::microseconds(50));
+                }
+            });
+        }
+
+        ~SnapshotPoller()
+        {
+            m_stop = true;
+            m_thread.join();
+        }
+
+        bool isValid() const
+        {
+            return m_valid;
+        }
+
+    private:
+        CounterSnapshotWriter m_writer;
+        bool m_valid = false;
+        atomic<bool> m_stop { false };
+        thread m_thread;
+    };
+
+    class CounterSnapshotConsumerTest : public mock_orch_test::MockOrchTest
+    {
+    protected:
+        const sai_object_id_t m_portId = 0x1000000000101;
+        const sai_object_id_t m_queueId = 0x15000000000103;
+    };
+
+    TEST_F(CounterSnapshotConsumerTest, CounterCheckOrch)
+    {
+        auto &orch = CounterCheckOrch::getInstance(m_config_db.get());
+        vector<string> counters;
+        for (int prio = 0; prio < PFC_WD_TC_MAX; prio++)
+        {
+            counters.push_back("SAI_PORT_STAT_PFC_" + to_string(prio) + "_RX_PKTS");
+        }
+
+        {
+            SnapshotPoller poller(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, {m_portId}, counters);
+            ASSERT_TRUE(poller.isValid());
+
+            /* The checks run while the poller publishes, each one sees a single poll */
+            size_t reads = 0;
+            uint64_t last = 0;
+            for (int i = 0; i < 2000; i++)
+            {
+                orch.readCounterSnapshots();
+                auto frames = orch.getPfcFrameCounters(m_portId);
+                if (!orch.m_portSnapshotValid)
+                {
+                    continue;
+                }
+                reads++;
+
+                for (auto value : frames)
+                {
+                    ASSERT_EQ(value, frames[0]);
+                }
+                ASSERT_GE(frames[0], last);
+                last = frames[0];
+            }
+            ASSERT_GT(reads, 0u);
+        }
+
+        /* Without the poller the counters come from COUNTERS_DB, and the fallback is counted */
+        Table countersTable(orch.m_countersDb.get(), COUNTERS_TABLE);
+        vector<FieldValueTuple> fvs;
+        for (const auto &counter : counters)
+        {
+            fvs.emplace_back(counter, "7");
+        }
+        countersTable.set(sai_serialize_object_id(m_portId), fvs);
+
+        auto fallbacks = orch.m_portSnapshotReader.getStats().redisFallbacks;
+        orch.readCounterSnapshots();
+        ASSERT_FALSE(orch.m_portSnapshotValid);
+        ASSERT_EQ(orch.m_portSnapshotReader.getStats().redisFallbacks, fallbacks + 1);
+        auto frames = orch.getPfcFrameCounters(m_portId);
+        for (auto value : frames)
+        {
+            ASSERT_EQ(value, 7u);
+        }
+    }
+
+    TEST_F(CounterSnapshotConsumerTest, PfcWdSwOrch)
+    {
+        vector<string> pfcWdTables = { CFG_PFC_WD_TABLE_NAME };
+        auto orch = new PfcWdSwOrch<PfcWdZeroBufferHandler, PfcWdLossyHandler>(
+            m_config_db.get(), pfcWdTables, {}, {}, {}, 100);
+        orch->m_nativeDetection = true;
+        orch->m_detector.addQueue(m_queueId, m_portId, 3, 200, 200, false);
+        auto reader = dynamic_cast<PfcWdSnapshotReader *>(orch->m_counterReader.get());
+        ASSERT_NE(reader, nullptr);
+
+        {
+            SnapshotPoller poller(PFC_WD_FLEX_COUNTER_GROUP, {m_queueId, m_portId}, {
+                "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES",
+                "SAI_QUEUE_STAT_PACKETS",
+                "SAI_QUEUE_ATTR_PAUSE_STATUS",
+                "SAI_PORT_STAT_PFC_3_RX_PKTS",
+                "SAI_PORT_STAT_PFC_3_ON2OFF_RX_PKTS"
+            });
+            ASSERT_TRUE(poller.isValid());
+
+            /*
+             * The detection runs while the poller publishes. A sample never
+             * mixes two polls, and the ON2OFF counter moving with the PFC
+             * one, there is no storm.
+             */
+            size_t reads = 0;
+            uint64_t last = 0;
+            for (int i = 0; i < 2000; i++)
+            {
+                orch->runNativeDetection(100);
+                ASSERT_TRUE(orch->m_events.empty());
+
+                const auto &sample = orch->m_samples[0];
+                if (!sample.valid)
+                {
+                    continue;
+                }
+                reads++;
+
+                ASSERT_EQ(sample.pfcRxPackets, sample.packets);
+                ASSERT_EQ(sample.pfcOn2OffRxPackets, sample.packets);
+                ASSERT_TRUE(sample.pauseStatus);
+                ASSERT_GE(sample.packets, last);
+                last = sample.packets;
+            }
+            ASSERT_GT(reads, 0u);
+            ASSERT_GT(reader->getSnapshotStats().snapshotReads, 0u);
+        }
+
+        /* Without the poller the counters come from COUNTERS_DB, and the fallback is counted */
+        Table countersTable(orch->getCountersDb().get(), COUNTERS_TABLE);
+        countersTable.set(sai_serialize_object_id(m_portId), {
+            {"SAI_PORT_STAT_PFC_3_RX_PKTS", "7"},
+            {"SAI_PORT_STAT_PFC_3_ON2OFF_RX_PKTS", "7"}
+        });
+        countersTable.set(sai_serialize_object_id(m_queueId), {
+            {"SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", "0"},
+            {"SAI_QUEUE_STAT_PACKETS", "7"},
+            {"SAI_QUEUE_ATTR_PAUSE_STATUS", "true"}
+        });
+
+        auto fallbacks = reader->getSnapshotStats().redisFallbacks;
+        auto batches = reader->getTableStats().batches;
+        orch->runNativeDetection(100);
+        ASSERT_EQ(reader->getSnapshotStats().redisFallbacks, fallbacks + 1);
+        ASSERT_EQ(reader->getTableStats().batches, batches + 1);
+        ASSERT_TRUE(orch->m_samples[0].valid);
+        ASSERT_EQ(orch->m_samples[0].packets, 7u);
+
+        delete orch;
+    }
+}
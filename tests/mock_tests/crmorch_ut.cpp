@@ -0,0 +1,206 @@
+#define private public
+#include "crmorch.h"
+#undef private
+#include "mock_orch_test.h"
+
+namespace crmorch_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    sai_switch_api_t ut_sai_switch_api;
+    sai_switch_api_t *pold_sai_switch_api;
+
+    uint32_t _available_ipv4_nexthops;
+    uint32_t _sai_get_available_ipv4_nexthops_count;
+
+    sai_status_t _ut_stub_sai_get_switch_attribute(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        if (attr_count == 1 && attr_list[0].id == SAI_SWITCH_ATTR_AVAILABLE_IPV4_NEXTHOP_ENTRY)
+        {
+            _sai_get_available_ipv4_nexthops_count++;
+            attr_list[0].value.u32 = _available_ipv4_nexthops;
+            return SAI_STATUS_SUCCESS;
+        }
+        return pold_sai_switch_api->get_switch_attribute(switch_id, attr_count, attr_list);
+    }
+
+    class CrmOrchTest : public MockOrchTest
+    {
+    protected:
+        shared_ptr<swss::DBConnector> m_counters_db;
+
+        void PostSetUp() override
+        {
+            ut_sai_switch_api = *sai_switch_api;
+            pold_sai_switch_api = sai_switch_api;
+            ut_sai_switch_api.get_switch_attribute = _ut_stub_sai_get_switch_attribute;
+            sai_switch_api = &ut_sai_switch_api;
+
+            _available_ipv4_nexthops = 10;
+            _sai_get_available_ipv4_nexthops_count = 0;
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+
+            gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV4_NEXTHOP).countersMap["STATS"].usedCounter = 0;
+        }
+
+        void PreTearDown() override
+        {
+            sai_switch_api = pold_sai_switch_api;
+        }
+
+        void setConfig(const vector<FieldValueTuple> &fvs)
+        {
+            auto consumer = dynamic_cast<Consumer *>(gCrmOrch->getExecutor(CFG_CRM_TABLE_NAME));
+            consumer->addToSync(deque<KeyOpFieldsValuesTuple>{ { "Config", SET_COMMAND, fvs } });
+            static_cast<Orch *>(gCrmOrch)->doTask();
+        }
+
+        void poll()
+        {
+            gCrmOrch->doTask(*gCrmOrch->m_timer);
+        }
+
+        void checkWatermark()
+        {
+            gCrmOrch->doTask(*gCrmOrch->m_watermarkTimer);
+        }
+
+        string getCounter(const string &field)
+        {
+            Table countersCrmTable(m_counters_db.get(), COUNTERS_CRM_TABLE);
+            string value;
+            countersCrmTable.hget("STATS", field, value);
+            return value;
+        }
+    };
+
+    TEST_F(CrmOrchTest, EventDrivenWatermark)
+    {
+        setConfig({
+            { "event_driven", "true" },
+            { "ipv4_nexthop_threshold_type", "used" },
+            { "ipv4_nexthop_low_threshold", "3" },
+            { "ipv4_nexthop_high_threshold", "8" }
+        });
+        poll();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 1u);
+
+        auto &cnt = gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV4_NEXTHOP).countersMap["STATS"];
+        for (int i = 0; i < 7; i++)
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        }
+        ASSERT_FALSE(gCrmOrch->m_watermarkPending.load());
+
+        /* Crossing the high threshold only flags the resource for the main loop */
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        ASSERT_TRUE(gCrmOrch->m_watermarkPending.load());
+        ASSERT_EQ(gCrmOrch->m_watermarkResources, set<CrmResourceType>({ CrmResourceType::CRM_IPV4_NEXTHOP }));
+        ASSERT_EQ(cnt.exceededLogCounter, 0u);
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 1u);
+
+        /* The watermark timer reads the resource and reports the crossing */
+        _available_ipv4_nexthops = 2;
+        checkWatermark();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 2u);
+        ASSERT_EQ(cnt.exceededLogCounter, 1u);
+        ASSERT_FALSE(gCrmOrch->m_watermarkPending.load());
+        ASSERT_TRUE(gCrmOrch->m_watermarkResources.empty());
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_used"), "8");
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_available"), "2");
+
+        /* Nothing is read when nothing crossed a threshold */
+        checkWatermark();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 2u);
+
+        /* Going back under the low threshold clears it */
+        for (int i = 0; i < 4; i++)
+        {
+            gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        }
+        ASSERT_FALSE(gCrmOrch->m_watermarkPending.load());
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        ASSERT_TRUE(gCrmOrch->m_watermarkPending.load());
+        _available_ipv4_nexthops = 8;
+        checkWatermark();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 3u);
+        ASSERT_EQ(cnt.exceededLogCounter, 0u);
+
+        /* Disabling the mode drops the flagged resources */
+        for (int i = 0; i < 6; i++)
+        {
+            gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        }
+        ASSERT_TRUE(gCrmOrch->m_watermarkPending.load());
+        setConfig({ { "event_driven", "false" } });
+        ASSERT_FALSE(gCrmOrch->m_watermarkPending.load());
+        ASSERT_TRUE(gCrmOrch->m_watermarkResources.empty());
+    }
+
+    TEST_F(CrmOrchTest, EventDrivenPolling)
+    {
+        setConfig({ { "event_driven", "true" } });
+
+        /* The first polling reads and writes everything */
+        poll();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 1u);
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_available"), "10");
+
+        /* Without a used counter change, the polling is skipped */
+        Table countersCrmTable(m_counters_db.get(), COUNTERS_CRM_TABLE);
+        countersCrmTable.hset("STATS", "crm_stats_ipv4_nexthop_available", "0");
+        _available_ipv4_nexthops = 9;
+        poll();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 1u);
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_available"), "0");
+
+        /* A used counter change reads everything, and writes the changed counters */
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEXTHOP);
+        poll();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 2u);
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_available"), "9");
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_used"), "1");
+
+        /* Unchanged counters are not written again */
+        countersCrmTable.hset("STATS", "crm_stats_ipv4_nexthop_used", "0");
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEXTHOP);
+        poll();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 3u);
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_used"), "0");
+
+        /* A full update eventually reads and writes everything again */
+        countersCrmTable.hset("STATS", "crm_stats_ipv4_nexthop_available", "0");
+        _available_ipv4_nexthops = 7;
+        uint32_t polls = 0;
+        while (_sai_get_available_ipv4_nexthops_count == 3u && polls < 100)
+        {
+            poll();
+            polls++;
+        }
+        ASSERT_GT(polls, 1u);
+        ASSERT_LT(polls, 100u);
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_available"), "7");
+        ASSERT_EQ(getCounter("crm_stats_ipv4_nexthop_used"), "1");
+
+        /* The default mode reads and writes everything on each polling */
+        setConfig({ { "event_driven", "false" } });
+        poll();
+        poll();
+        ASSERT_EQ(_sai_get_available_ipv4_nexthops_count, 6u);
+    }
+
+    TEST_F(CrmOrchTest, UnknownThresholdType)
+    {
+        auto &res = gCrmOrch->m_resourcesMap.at(CrmResourceType::CRM_IPV4_NEXTHOP);
+        auto thresholdType = res.thresholdType;
+
+        res.thresholdType = static_cast<CrmThresholdType>(100);
+        ASSERT_THROW(gCrmOrch->checkCrmThresholds(res), runtime_error);
+
+        res.thresholdType = thresholdType;
+    }
+}
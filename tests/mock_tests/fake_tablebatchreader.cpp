@@ -0,0 +1,37 @@
+#include "tablebatchreader.h"
+
+using namespace std;
+
+namespace swss
+{
+
+TableBatchReader::TableBatchReader(DBConnector *db, const string &tableName) :
+    m_db(db),
+    m_table(tableName, SonicDBConfig::getSeparator(db))
+{
+}
+
+/* Read through the mock Table, counted as the batch it would be sent as */
+void TableBatchReader::get(const vector<string> &keys, vector<vector<FieldValueTuple>> &values)
+{
+    values.assign(keys.size(), vector<FieldValueTuple>());
+    if (keys.empty())
+    {
+        return;
+    }
+
+    Table table(m_db, m_table.getTableName());
+    string buffer;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        formatHgetall(m_table.getKeyName(keys[i]), buffer);
+        table.get(keys[i], values[i]);
+        m_stats.replyBytes += getReplySize(values[i]);
+    }
+
+    m_stats.batches++;
+    m_stats.commands += keys.size();
+    m_stats.requestBytes += buffer.size();
+}
+
+}
@@ -31,6 +31,49 @@ namespace fdb_syncd_flush_test
     {
         return SAI_STATUS_SUCCESS;
     }
+    vector<uint32_t> _ut_bulk_create_sizes;
+    vector<uint32_t> _ut_bulk_remove_sizes;
+
+    sai_status_t _ut_stub_sai_create_fdb_entries (
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        _ut_bulk_create_sizes.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            /* Entry already learnt by the hardware, must be treated as created */
+            object_statuses[i] = (fdb_entry[i].mac_address[5] == 0x02) ?
+                SAI_STATUS_ITEM_ALREADY_EXISTS : SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_remove_fdb_entries (
+        _In_ uint32_t object_count,
+        _In_ const sai_fdb_entry_t *fdb_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        _ut_bulk_remove_sizes.push_back(object_count);
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    void _hook_sai_fdb_bulk_api()
+    {
+        _ut_bulk_create_sizes.clear();
+        _ut_bulk_remove_sizes.clear();
+        ut_sai_fdb_api.create_fdb_entries = _ut_stub_sai_create_fdb_entries;
+        ut_sai_fdb_api.remove_fdb_entries = _ut_stub_sai_remove_fdb_entries;
+    }
+
     void _hook_sai_fdb_api()
     {
         ut_sai_fdb_api = *sai_fdb_api;
@@ -548,4 +591,88 @@ namespace fdb_syncd_flush_test
         ASSERT_EQ(m_portsOrch->m_portList[VXLAN_REMOTE].m_fdb_count, 1);
         _unhook_sai_fdb_api();
     }
+
+    void addFdbTasks(FdbOrch* m_fdborch, const deque<KeyOpFieldsValuesTuple>& entries)
+    {
+        auto consumer = dynamic_cast<Consumer *>(m_fdborch->getExecutor(APP_FDB_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(m_fdborch)->doTask(*consumer);
+    }
+
+    /* Test FDB entries of APP_FDB_TABLE are programmed with a single bulk call */
+    TEST_F(FdbOrchTest, BulkCreateRemove)
+    {
+        _hook_sai_fdb_api();
+        _hook_sai_fdb_bulk_api();
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+        m_portsOrch->m_initDone = true;
+
+        addFdbTasks(m_fdborch.get(), {
+            {"Vlan40:7c:fe:90:12:22:01", SET_COMMAND, {{"port", ETH0}, {"type", "static"}}},
+            {"Vlan40:7c:fe:90:12:22:02", SET_COMMAND, {{"port", ETH0}, {"type", "static"}}},
+            {"Vlan40:7c:fe:90:12:22:03", SET_COMMAND, {{"port", ETH0}, {"type", "dynamic"}}}
+        });
+
+        /* One bulk call, the entry reported as already existing is kept */
+        ASSERT_EQ(_ut_bulk_create_sizes, vector<uint32_t>({3}));
+        ASSERT_EQ(m_fdborch->m_entries.size(), 3u);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 3);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 3);
+
+        string port;
+        ASSERT_TRUE(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:02", "port", port));
+        ASSERT_EQ(port, ETH0);
+
+        auto consumer = dynamic_cast<Consumer *>(m_fdborch->getExecutor(APP_FDB_TABLE_NAME));
+        ASSERT_TRUE(consumer->m_toSync.empty());
+
+        addFdbTasks(m_fdborch.get(), {
+            {"Vlan40:7c:fe:90:12:22:01", DEL_COMMAND, {}},
+            {"Vlan40:7c:fe:90:12:22:03", DEL_COMMAND, {}}
+        });
+
+        ASSERT_EQ(_ut_bulk_remove_sizes, vector<uint32_t>({2}));
+        ASSERT_EQ(m_fdborch->m_entries.size(), 1u);
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 1);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1);
+        ASSERT_FALSE(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:01", "port", port));
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        _unhook_sai_fdb_api();
+    }
+
+    /* Test a DEL and a SET of the same MAC handled in the same bulk */
+    TEST_F(FdbOrchTest, BulkDelSetSameEntry)
+    {
+        _hook_sai_fdb_api();
+        _hook_sai_fdb_bulk_api();
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+        m_portsOrch->m_initDone = true;
+
+        addFdbTasks(m_fdborch.get(), {
+            {"Vlan40:7c:fe:90:12:22:01", SET_COMMAND, {{"port", ETH0}, {"type", "static"}}}
+        });
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1);
+
+        auto consumer = dynamic_cast<Consumer *>(m_fdborch->getExecutor(APP_FDB_TABLE_NAME));
+        consumer->addToSync(deque<KeyOpFieldsValuesTuple>({
+            {"Vlan40:7c:fe:90:12:22:01", DEL_COMMAND, {}}
+        }));
+        addFdbTasks(m_fdborch.get(), {
+            {"Vlan40:7c:fe:90:12:22:01", SET_COMMAND, {{"port", ETH0}, {"type", "dynamic"}}}
+        });
+
+        /* The entry is removed and created again instead of being updated */
+        ASSERT_EQ(_ut_bulk_remove_sizes, vector<uint32_t>({1}));
+        ASSERT_EQ(_ut_bulk_create_sizes, vector<uint32_t>({1, 1}));
+        ASSERT_EQ(m_fdborch->m_entries.size(), 1u);
+        ASSERT_EQ(m_fdborch->m_entries.begin()->second.type, "dynamic");
+        ASSERT_EQ(m_portsOrch->m_portList[VLAN40].m_fdb_count, 1);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 1);
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        _unhook_sai_fdb_api();
+    }
 }
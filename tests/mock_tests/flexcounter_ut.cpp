@@ -19,8 +19,10 @@
 #undef private
 
 #include <sstream>
+#include "tokenize.h"
 
 extern bool gTraditionalFlexCounter;
+extern bool gFlexCounterBulkKeys;
 
 namespace flexcounter_test
 {
@@ -33,6 +35,7 @@ namespace flexcounter_test
     shared_ptr<swss::Table> mockFlexCounterGroupTable;
     shared_ptr<swss::Table> mockFlexCounterTable;
     sai_set_switch_attribute_fn mockOldSaiSetSwitchAttribute;
+    size_t mockFlexCounterOperations;
 
     void mock_counter_init(sai_set_switch_attribute_fn old)
     {
@@ -41,6 +44,7 @@ namespace flexcounter_test
         mockFlexCounterTable = make_shared<swss::Table>(mockFlexCounterDb.get(), "FLEX_COUNTER_TABLE");
 
         mockOldSaiSetSwitchAttribute = old;
+        mockFlexCounterOperations = 0;
     }
 
     sai_status_t mockFlexCounterOperation(sai_object_id_t objectId, const sai_attribute_t *attr)
@@ -55,6 +59,13 @@ namespace flexcounter_test
         auto serializedObjectId = sai_serialize_object_id(objectId);
         std::string key((const char*)param->counter_key.list);
 
+        mockFlexCounterOperations++;
+
+        // A bulk operation has a list of objects, "GROUP:oid1,oid2,..."
+        auto delimiter = key.find(':');
+        auto group = key.substr(0, delimiter + 1);
+        auto objects = swss::tokenize(key.substr(delimiter + 1), ',');
+
         if (param->stats_mode.list != nullptr)
         {
             entries.push_back({STATS_MODE_FIELD, (const char*)param->stats_mode.list});
@@ -63,11 +74,17 @@ namespace flexcounter_test
         if (param->counter_ids.list != nullptr)
         {
             entries.push_back({(const char*)param->counter_field_name.list, (const char*)param->counter_ids.list});
-            mockFlexCounterTable->set(key, entries);
+            for (const auto &object : objects)
+            {
+                mockFlexCounterTable->set(group + object, entries);
+            }
         }
         else
         {
-            mockFlexCounterTable->del(key);
+            for (const auto &object : objects)
+            {
+                mockFlexCounterTable->del(group + object);
+            }
         }
 
         return SAI_STATUS_SUCCESS;
@@ -873,4 +890,128 @@ namespace flexcounter_test
         m_DashOrch->handleFCStatusUpdate(false);
         ASSERT_FALSE(checkFlexCounter(ENI_STAT_COUNTER_FLEX_COUNTER_GROUP, tmp_entry.eni_id, ENI_COUNTER_ID_LIST));
     }
+
+    class FlexCounterManagerTest : public MockOrchTest
+    {
+        virtual void PostSetUp() {
+            _hook_sai_switch_api();
+        }
+
+        virtual void PreTearDown() {
+           _unhook_sai_switch_api();
+        }
+    };
+
+    TEST_F(FlexCounterManagerTest, BulkCounterIdList)
+    {
+        const string group = "BULK_TEST_COUNTER";
+        const unordered_set<string> stats = { "SAI_PORT_STAT_IF_IN_OCTETS", "SAI_PORT_STAT_IF_OUT_OCTETS" };
+        const size_t count = FLEX_COUNTER_BULK_CHUNK_SIZE * 2 + 1;
+
+        bool traditional = gTraditionalFlexCounter;
+        gTraditionalFlexCounter = false;
+        gFlexCounterBulkKeys = true;
+
+        vector<sai_object_id_t> oids;
+        for (size_t i = 0; i < count; i++)
+        {
+            oids.push_back(0x1000000000000 + i);
+        }
+
+        {
+            FlexCounterManager manager(group, StatsMode::READ, 1000, true);
+
+            mockFlexCounterOperations = 0;
+            {
+                FlexCounterBulk bulk({ &manager });
+                for (auto oid : oids)
+                {
+                    manager.setCounterIdList(oid, CounterType::PORT, stats);
+                }
+                /* Set and cleared in the same pass, never installed */
+                manager.clearCounterIdList(oids[0]);
+
+                ASSERT_EQ(mockFlexCounterOperations, 0u);
+                ASSERT_FALSE(checkFlexCounter(group, oids[1], PORT_COUNTER_ID_LIST));
+            }
+
+            /* One operation per chunk of objects */
+            ASSERT_EQ(mockFlexCounterOperations, 2u);
+            ASSERT_FALSE(checkFlexCounter(group, oids[0], PORT_COUNTER_ID_LIST));
+            for (size_t i = 1; i < count; i++)
+            {
+                ASSERT_TRUE(checkFlexCounter(group, oids[i], PORT_COUNTER_ID_LIST));
+            }
+
+            /* Only the changed objects are updated */
+            mockFlexCounterOperations = 0;
+            {
+                FlexCounterBulk bulk({ &manager });
+                for (size_t i = 1; i < count; i++)
+                {
+                    manager.setCounterIdList(oids[i], CounterType::PORT, stats);
+                }
+                manager.setCounterIdList(oids[1], CounterType::PORT, { "SAI_PORT_STAT_IF_IN_OCTETS" });
+                manager.setCounterIdList(oids[2], CounterType::PORT, { "SAI_PORT_STAT_IF_IN_OCTETS" });
+            }
+            ASSERT_EQ(mockFlexCounterOperations, 1u);
+            ASSERT_TRUE(checkFlexCounter(group, oids[1], { { PORT_COUNTER_ID_LIST, "SAI_PORT_STAT_IF_IN_OCTETS" } }));
+            ASSERT_TRUE(checkFlexCounter(group, oids[2], { { PORT_COUNTER_ID_LIST, "SAI_PORT_STAT_IF_IN_OCTETS" } }));
+
+            /* Counters are cleared right away, even in bulk mode */
+            {
+                FlexCounterBulk bulk({ &manager });
+                manager.clearCounterIdList(oids[1]);
+                ASSERT_FALSE(checkFlexCounter(group, oids[1], PORT_COUNTER_ID_LIST));
+            }
+        }
+
+        for (auto oid : oids)
+        {
+            ASSERT_FALSE(checkFlexCounter(group, oid, PORT_COUNTER_ID_LIST));
+        }
+
+        gFlexCounterBulkKeys = false;
+        gTraditionalFlexCounter = traditional;
+    }
+
+    TEST_F(FlexCounterManagerTest, BulkCounterIdListSingleKeys)
+    {
+        const string group = "BULK_TEST_COUNTER";
+        const unordered_set<string> stats = { "SAI_PORT_STAT_IF_IN_OCTETS", "SAI_PORT_STAT_IF_OUT_OCTETS" };
+        const vector<sai_object_id_t> oids = { 0x1000000000001, 0x1000000000002, 0x1000000000003 };
+
+        bool traditional = gTraditionalFlexCounter;
+        gTraditionalFlexCounter = false;
+
+        /* Without multi-object keys, each object is installed with its own key */
+        FlexCounterManager manager(group, StatsMode::READ, 1000, true);
+        mockFlexCounterOperations = 0;
+        {
+            FlexCounterBulk bulk({ &manager });
+            for (auto oid : oids)
+            {
+                manager.setCounterIdList(oid, CounterType::PORT, stats);
+            }
+            ASSERT_EQ(mockFlexCounterOperations, 0u);
+        }
+        ASSERT_EQ(mockFlexCounterOperations, oids.size());
+        for (auto oid : oids)
+        {
+            ASSERT_TRUE(checkFlexCounter(group, oid, PORT_COUNTER_ID_LIST));
+        }
+
+        /* Unchanged objects are still skipped */
+        mockFlexCounterOperations = 0;
+        {
+            FlexCounterBulk bulk({ &manager });
+            for (auto oid : oids)
+            {
+                manager.setCounterIdList(oid, CounterType::PORT, stats);
+            }
+        }
+        ASSERT_EQ(mockFlexCounterOperations, 0u);
+
+        gTraditionalFlexCounter = traditional;
+    }
 }
@@ -0,0 +1,406 @@
+#include "ut_helpers_fpmsyncd.h"
+#include "gtest/gtest.h"
+#include <gmock/gmock.h>
+#include "mock_table.h"
+#include <net/if.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+#define private public // Need to modify internal cache
+#include "fpmlink.h"
+#include "routesync.h"
+#undef private
+
+using namespace swss;
+using namespace testing;
+
+/*
+Test Fixture
+*/
+namespace ut_fpmsyncd
+{
+    struct FpmSyncdRoutesTest : public ::testing::Test
+    {
+        std::shared_ptr<swss::DBConnector> m_app_db;
+        std::shared_ptr<swss::RedisPipeline> pipeline;
+        std::shared_ptr<RouteSync> m_routeSync;
+        std::shared_ptr<FpmLink> m_fpmLink;
+        std::shared_ptr<swss::Table> m_routeTable;
+
+        virtual void SetUp() override
+        {
+            testing_db::reset();
+
+            m_app_db = std::make_shared<swss::DBConnector>("APPL_DB", 0);
+            pipeline = std::make_shared<swss::RedisPipeline>(m_app_db.get());
+            m_routeSync = std::make_shared<RouteSync>(pipeline.get());
+            m_fpmLink = std::make_shared<FpmLink>(m_routeSync.get());
+            m_routeTable = std::make_shared<swss::Table>(m_app_db.get(), APP_ROUTE_TABLE_NAME);
+        }
+
+        virtual void TearDown() override
+        {
+        }
+
+        /* Handle the message the way fpmsyncd did before the fast path */
+        void processLibnl(struct nlmsghdr *h)
+        {
+            struct rtnl_route *route_obj = NULL;
+            ASSERT_GE(rtnl_route_parse(h, &route_obj), 0);
+            m_routeSync->onMsg(h->nlmsg_type, (struct nl_object *)route_obj);
+            rtnl_route_put(route_obj);
+        }
+
+        std::map<std::string, std::vector<FieldValueTuple>> dumpRoutes()
+        {
+            std::map<std::string, std::vector<FieldValueTuple>> routes;
+            std::vector<std::string> keys;
+            m_routeTable->getKeys(keys);
+            for (const auto &key : keys)
+            {
+                m_routeTable->get(key, routes[key]);
+            }
+            return routes;
+        }
+    };
+
+    struct RouteNextHop
+    {
+        const char *gateway;
+        uint32_t ifindex;
+        uint8_t weight;
+    };
+
+    static void putAddress(struct nlmsghdr *n, int type, const IpAddress &addr)
+    {
+        ip_addr_t ip = addr.getIp();
+        if (ip.family == AF_INET)
+        {
+            nl_attr_put(n, sizeof(struct nlmsg), type, &ip.ip_addr.ipv4_addr, 4);
+        }
+        else
+        {
+            nl_attr_put(n, sizeof(struct nlmsg), type, ip.ip_addr.ipv6_addr, 16);
+        }
+    }
+
+    /* Build a Netlink object containing a regular route as sent by zebra */
+    static struct nlmsg *create_route_nlmsg(uint16_t cmd, const IpPrefix &dst,
+                                            const std::vector<RouteNextHop> &nhs,
+                                            uint32_t table_id = 0, uint8_t rtm_type = RTN_UNICAST)
+    {
+        struct nlmsg *msg = (struct nlmsg *)calloc(1, sizeof(struct nlmsg));
+        if (!msg)
+        {
+            return NULL;
+        }
+
+        msg->n.nlmsg_len = NLMSG_LENGTH(sizeof(struct rtmsg));
+        msg->n.nlmsg_flags = NLM_F_CREATE | NLM_F_REQUEST;
+        msg->n.nlmsg_type = cmd;
+        msg->r.rtm_family = dst.isV4() ? AF_INET : AF_INET6;
+        msg->r.rtm_dst_len = (uint8_t)dst.getMaskLength();
+        msg->r.rtm_protocol = RTPROT_BGP;
+        msg->r.rtm_scope = RT_SCOPE_UNIVERSE;
+        msg->r.rtm_type = rtm_type;
+
+        putAddress(&msg->n, RTA_DST, dst.getIp());
+        nl_attr_put32(&msg->n, sizeof(*msg), RTA_PRIORITY, 20);
+        if (table_id)
+        {
+            nl_attr_put32(&msg->n, sizeof(*msg), RTA_TABLE, table_id);
+        }
+
+        if (nhs.size() == 1)
+        {
+            if (nhs[0].gateway)
+            {
+                putAddress(&msg->n, RTA_GATEWAY, IpAddress(nhs[0].gateway));
+            }
+            nl_attr_put32(&msg->n, sizeof(*msg), RTA_OIF, nhs[0].ifindex);
+        }
+        else if (nhs.size() > 1)
+        {
+            struct rtattr *nest = nl_attr_nest(&msg->n, sizeof(*msg), RTA_MULTIPATH);
+            for (const auto &nh : nhs)
+            {
+                struct rtnexthop *rtnh = (struct rtnexthop *)NLMSG_TAIL(&msg->n);
+                memset(rtnh, 0, sizeof(*rtnh));
+                rtnh->rtnh_ifindex = (int)nh.ifindex;
+                rtnh->rtnh_hops = nh.weight;
+                msg->n.nlmsg_len = NLMSG_ALIGN(msg->n.nlmsg_len) + (uint32_t)sizeof(*rtnh);
+                if (nh.gateway)
+                {
+                    putAddress(&msg->n, RTA_GATEWAY, IpAddress(nh.gateway));
+                }
+                rtnh->rtnh_len = (unsigned short)((uint8_t *)NLMSG_TAIL(&msg->n) - (uint8_t *)rtnh);
+            }
+            nl_attr_nest_end(&msg->n, nest);
+        }
+
+        return msg;
+    }
+}
+
+namespace ut_fpmsyncd
+{
+    /* Test that the fast path writes the same routes as the libnl path */
+    TEST_F(FpmSyncdRoutesTest, FastPathMatchesLibnl)
+    {
+        std::vector<struct nlmsg *> msgs = {
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"), { { "10.0.0.1", 10, 0 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.2.1/32"), { { NULL, 10, 0 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("0.0.0.0/0"),
+                               { { "10.0.0.1", 10, 1 }, { "10.0.0.3", 12, 2 }, { "10.0.0.5", 10, 3 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.3.0/24"),
+                               { { "10.0.0.1", 10, 1 }, { "10.0.0.3", 10, 0 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("fc00:1::/64"),
+                               { { "fc00::1", 10, 1 }, { "fe80::1", 10, 1 }, { NULL, 10, 1 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("fc00:2::1/128"), { { "fc00::1", 10, 0 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("fc00:3::/48"), {}, 0, RTN_BLACKHOLE),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.4.0/24"), { { "10.0.0.1", 10, 0 } }),
+            create_route_nlmsg(RTM_DELROUTE, IpPrefix("192.168.4.0/24"), {}),
+        };
+
+        std::map<std::string, std::vector<FieldValueTuple>> expected;
+        for (auto *msg : msgs)
+        {
+            ASSERT_NE(msg, nullptr);
+            processLibnl(&msg->n);
+        }
+        expected = dumpRoutes();
+        ASSERT_EQ(expected.size(), 7);
+
+        testing_db::reset();
+        for (auto *msg : msgs)
+        {
+            ASSERT_TRUE(m_routeSync->onRouteMsgFast(&msg->n));
+        }
+        ASSERT_EQ(dumpRoutes(), expected);
+
+        std::string value;
+        ASSERT_TRUE(m_routeTable->hget("0.0.0.0/0", "nexthop", value));
+        ASSERT_EQ(value, "10.0.0.1,10.0.0.3,10.0.0.5");
+        ASSERT_TRUE(m_routeTable->hget("0.0.0.0/0", "ifname", value));
+        ASSERT_EQ(value, "Vrf10,unknown,Vrf10");
+        ASSERT_TRUE(m_routeTable->hget("0.0.0.0/0", "weight", value));
+        ASSERT_EQ(value, "1,2,3");
+        ASSERT_FALSE(m_routeTable->hget("192.168.3.0/24", "weight", value));
+        ASSERT_TRUE(m_routeTable->hget("fc00:1::/64", "nexthop", value));
+        ASSERT_EQ(value, "fc00::1,fe80::1,::");
+        ASSERT_TRUE(m_routeTable->hget("fc00:2::1", "nexthop", value));
+        ASSERT_TRUE(m_routeTable->hget("fc00:3::/48", "blackhole", value));
+        ASSERT_FALSE(m_routeTable->hget("192.168.4.0/24", "nexthop", value));
+
+        for (auto *msg : msgs)
+        {
+            free_nlobj(msg);
+        }
+    }
+
+    /* Test that routes the fast path does not handle are left to the libnl path */
+    TEST_F(FpmSyncdRoutesTest, FastPathFallback)
+    {
+        /* VRF route */
+        struct nlmsg *nl_obj = create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"),
+                                                  { { "10.0.0.1", 10, 0 } }, 10);
+        ASSERT_NE(nl_obj, nullptr);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&nl_obj->n));
+        free_nlobj(nl_obj);
+
+        /* Multicast route */
+        nl_obj = create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"),
+                                    { { "10.0.0.1", 10, 0 } }, 0, RTN_MULTICAST);
+        ASSERT_NE(nl_obj, nullptr);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&nl_obj->n));
+        free_nlobj(nl_obj);
+
+        /* Encapsulated next hop */
+        nl_obj = create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"), { { "10.0.0.1", 10, 0 } });
+        ASSERT_NE(nl_obj, nullptr);
+        nl_attr_put16(&nl_obj->n, sizeof(*nl_obj), RTA_ENCAP_TYPE, NH_ENCAP_SRV6_ROUTE);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&nl_obj->n));
+        free_nlobj(nl_obj);
+
+        /* Route without next hop */
+        nl_obj = create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"), {});
+        ASSERT_NE(nl_obj, nullptr);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&nl_obj->n));
+        free_nlobj(nl_obj);
+
+        /* SRv6 VPN route */
+        IpPrefix dst("192.168.6.0/24");
+        IpAddress vpn_sid("fc00:0:2:1::");
+        IpAddress encap_src_addr("fc00:0:1:1::1");
+        nl_obj = create_srv6_vpn_route_nlmsg(RTM_NEWROUTE, &dst, &encap_src_addr, &vpn_sid, 0);
+        ASSERT_NE(nl_obj, nullptr);
+        ASSERT_FALSE(m_routeSync->onRouteMsgFast(&nl_obj->n));
+        free_nlobj(nl_obj);
+
+        ASSERT_TRUE(dumpRoutes().empty());
+    }
+
+    /* Test that route updates are coalesced in a batch and written when it is flushed */
+    TEST_F(FpmSyncdRoutesTest, RouteBatch)
+    {
+        std::vector<struct nlmsg *> msgs = {
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"), { { "10.0.0.1", 10, 0 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"), { { "10.0.0.1", 10, 1 }, { "10.0.0.3", 10, 1 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.1.0/24"), { { "10.0.0.3", 10, 0 } }),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.2.0/24"), { { "10.0.0.1", 10, 0 } }),
+            create_route_nlmsg(RTM_DELROUTE, IpPrefix("192.168.2.0/24"), {}),
+            create_route_nlmsg(RTM_NEWROUTE, IpPrefix("192.168.3.0/24"), { { "10.0.0.1", 10, 0 } }),
+        };
+
+        for (auto *msg : msgs)
+        {
+            ASSERT_NE(msg, nullptr);
+        }
+
+        m_routeSync->setRouteBatchPolicy(3, 1000000);
+        for (size_t i = 0; i < 5; i++)
+        {
+            ASSERT_TRUE(m_routeSync->onRouteMsgFast(&msgs[i]->n));
+        }
+
+        /* Nothing is written before the batch is due */
+        ASSERT_TRUE(dumpRoutes().empty());
+        ASSERT_GT(m_routeSync->getRouteBatchTimeout(), 0);
+        m_routeSync->flushRouteBatch();
+        ASSERT_TRUE(dumpRoutes().empty());
+
+        m_routeSync->flushRouteBatch(true);
+        ASSERT_EQ(m_routeSync->getRouteBatchTimeout(), -1);
+        auto routes = dumpRoutes();
+        ASSERT_EQ(routes.size(), 1);
+
+        /* The fields of the coalesced updates are merged like hset would */
+        std::string value;
+        ASSERT_TRUE(m_routeTable->hget("192.168.1.0/24", "nexthop", value));
+        ASSERT_EQ(value, "10.0.0.3");
+        ASSERT_TRUE(m_routeTable->hget("192.168.1.0/24", "weight", value));
+        ASSERT_EQ(value, "1,1");
+
+        /* A full batch is written right away */
+        m_routeSync->onRouteMsgFast(&msgs[3]->n);
+        m_routeSync->onRouteMsgFast(&msgs[4]->n);
+        m_routeSync->onRouteMsgFast(&msgs[3]->n);
+        m_routeSync->onRouteMsgFast(&msgs[0]->n);
+        ASSERT_EQ(dumpRoutes().size(), 1);
+        m_routeSync->onRouteMsgFast(&msgs[5]->n);
+        ASSERT_EQ(m_routeSync->getRouteBatchTimeout(), -1);
+        ASSERT_EQ(dumpRoutes().size(), 3);
+
+        DBConnector stateDb("STATE_DB", 0);
+        Table statsTable(&stateDb, FPMSYNCD_STATS_TABLE);
+        m_routeSync->publishRouteBatchStats(statsTable);
+        ASSERT_TRUE(statsTable.hget(FPMSYNCD_ROUTE_BATCH_STATS_KEY, "updates", value));
+        ASSERT_EQ(value, "10");
+        ASSERT_TRUE(statsTable.hget(FPMSYNCD_ROUTE_BATCH_STATS_KEY, "coalesced", value));
+        ASSERT_EQ(value, "5");
+        ASSERT_TRUE(statsTable.hget(FPMSYNCD_ROUTE_BATCH_STATS_KEY, "batches", value));
+        ASSERT_EQ(value, "2");
+        ASSERT_TRUE(statsTable.hget(FPMSYNCD_ROUTE_BATCH_STATS_KEY, "max_batch_size", value));
+        ASSERT_EQ(value, "3");
+
+        for (auto *msg : msgs)
+        {
+            free_nlobj(msg);
+        }
+    }
+
+    /*
+     * Route throughput of the fast path and of the libnl path. The FPM stream
+     * is read from the file named by FPMSYNCD_BENCHMARK_STREAM, a capture of
+     * the FPM messages sent by zebra, or generated with 200k ECMP routes. It
+     * is disabled by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*RouteSync_Benchmark*
+     */
+    TEST_F(FpmSyncdRoutesTest, DISABLED_RouteSync_Benchmark)
+    {
+        std::vector<char> stream;
+        const char *path = getenv("FPMSYNCD_BENCHMARK_STREAM");
+        if (path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            ASSERT_TRUE(file.good());
+            stream.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        }
+        else
+        {
+            for (uint32_t i = 0; i < 200000; i++)
+            {
+                IpPrefix dst = (i % 2) ?
+                    IpPrefix("fc00:" + std::to_string(i >> 16) + ":" + std::to_string(i & 0xffff) + "::/64") :
+                    IpPrefix("10." + std::to_string((i >> 16) & 0xff) + "." + std::to_string((i >> 8) & 0xff) + "."
+                             + std::to_string(i & 0xff) + "/32");
+                std::vector<RouteNextHop> nhs;
+                if (i % 2)
+                {
+                    nhs = { { "fc00::1", 10, 1 }, { "fc00::3", 10, 1 }, { "fc00::5", 10, 1 }, { "fc00::7", 10, 1 } };
+                }
+                else
+                {
+                    nhs = { { "10.0.0.1", 10, 1 }, { "10.0.0.3", 10, 1 }, { "10.0.0.5", 10, 1 }, { "10.0.0.7", 10, 1 } };
+                }
+
+                struct nlmsg *nl_obj = create_route_nlmsg(RTM_NEWROUTE, dst, nhs);
+                ASSERT_NE(nl_obj, nullptr);
+
+                fpm_msg_hdr_t hdr{};
+                hdr.version = FPM_PROTO_VERSION;
+                hdr.msg_type = FPM_MSG_TYPE_NETLINK;
+                hdr.msg_len = htons((uint16_t)fpm_data_len_to_msg_len(nl_obj->n.nlmsg_len));
+                stream.insert(stream.end(), (char *)&hdr, (char *)&hdr + FPM_MSG_HDR_LEN);
+                stream.insert(stream.end(), (char *)&nl_obj->n, (char *)&nl_obj->n + nl_obj->n.nlmsg_len);
+                stream.resize(stream.size() + fpm_msg_align(nl_obj->n.nlmsg_len) - nl_obj->n.nlmsg_len);
+                free_nlobj(nl_obj);
+            }
+        }
+
+        std::vector<fpm_msg_hdr_t *> fpm_msgs;
+        size_t len = stream.size();
+        for (auto *hdr = (fpm_msg_hdr_t *)(void *)stream.data(); fpm_msg_ok(hdr, len); hdr = fpm_msg_next(hdr, &len))
+        {
+            fpm_msgs.push_back(hdr);
+        }
+        ASSERT_FALSE(fpm_msgs.empty());
+
+        size_t routes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (auto *hdr : fpm_msgs)
+        {
+            size_t msg_len = fpm_msg_data_len(hdr);
+            for (auto *nl_hdr = (nlmsghdr *)fpm_msg_data(hdr); NLMSG_OK(nl_hdr, msg_len); nl_hdr = NLMSG_NEXT(nl_hdr, msg_len))
+            {
+                if (nl_hdr->nlmsg_type == RTM_NEWROUTE || nl_hdr->nlmsg_type == RTM_DELROUTE)
+                {
+                    processLibnl(nl_hdr);
+                    routes++;
+                }
+            }
+        }
+        auto libnl_done = std::chrono::steady_clock::now();
+
+        testing_db::reset();
+        auto fast_start = std::chrono::steady_clock::now();
+        for (auto *hdr : fpm_msgs)
+        {
+            m_fpmLink->processFpmMessage(hdr);
+        }
+        auto fast_done = std::chrono::steady_clock::now();
+
+        auto libnl_us = std::chrono::duration_cast<std::chrono::microseconds>(libnl_done - start).count();
+        auto fast_us = std::chrono::duration_cast<std::chrono::microseconds>(fast_done - fast_start).count();
+        std::cout << "RouteSync routes " << routes
+                  << " libnl " << (libnl_us ? routes * 1000000 / (size_t)libnl_us : 0) << " routes/s"
+                  << " fast path " << (fast_us ? routes * 1000000 / (size_t)fast_us : 0) << " routes/s"
+                  << std::endl;
+    }
+}
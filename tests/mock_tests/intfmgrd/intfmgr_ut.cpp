@@ -1,4 +1,5 @@
 #include "gtest/gtest.h"
+#include <errno.h>
 #include <iostream>
 #include <fstream>
 #include <unistd.h>
@@ -11,20 +12,23 @@
 
 extern int (*callback)(const std::string &cmd, std::string &stdout);
 extern std::vector<std::string> mockCallArgs;
+extern int (*rtnlCallback)(const std::string &call);
+extern std::vector<std::string> mockRtnlCalls;
 
 bool Ethernet0IPv6Set = false;
 
 int cb(const std::string &cmd, std::string &stdout){
     mockCallArgs.push_back(cmd);
     if (cmd == "sysctl -w net.ipv6.conf.\"Ethernet0\".disable_ipv6=0") Ethernet0IPv6Set = true;
-    else if (cmd.find("/sbin/ip -6 address \"add\"") == 0) {
-        return Ethernet0IPv6Set ? 0 : 2;
-    }
-    else if (cmd == "/sbin/ip link set \"Ethernet64.10\" \"up\""){
-        return 1;
+    return 0;
+}
+
+int rtnlCb(const std::string &call){
+    if (call.find("addAddress Ethernet0 2001::8/64") == 0) {
+        return Ethernet0IPv6Set ? 0 : -EACCES;
     }
-    else {
-        return 0;
+    else if (call == "setLinkAdminState Ethernet64.10 up"){
+        return -ENODEV;
     }
     return 0;
 }
@@ -58,7 +62,9 @@ namespace intfmgr_ut
             };
             cfg_intf_tables = tables;
             mockCallArgs.clear();
+            mockRtnlCalls.clear();
             callback = cb;
+            rtnlCallback = rtnlCb;
         }
     };
 
@@ -78,8 +84,8 @@ namespace intfmgr_ut
         const std::vector<swss::FieldValueTuple> data;
         intfmgr.doIntfAddrTask(keys, data, "SET");
         int ip_cmd_called = 0;
-        for (auto cmd : mockCallArgs){
-            if (cmd.find("/sbin/ip -6 address \"add\"") == 0){
+        for (auto call : mockRtnlCalls){
+            if (call.find("addAddress Ethernet0 2001::8/64") == 0){
                 ip_cmd_called++;
             }
         }
@@ -102,14 +108,42 @@ namespace intfmgr_ut
         const std::vector<swss::FieldValueTuple> data;
         intfmgr.doIntfAddrTask(keys, data, "SET");
         int ip_cmd_called = 0;
-        for (auto cmd : mockCallArgs){
-            if (cmd.find("/sbin/ip -6 address \"add\"") == 0){
+        for (auto call : mockRtnlCalls){
+            if (call.find("addAddress Ethernet0 2001::8/64") == 0){
                 ip_cmd_called++;
             }
         }
         ASSERT_EQ(ip_cmd_called, 1);
     }
 
+    TEST_F(IntfMgrTest, testLoopbackAndAddress){
+        swss::IntfMgr intfmgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_intf_tables);
+        mockCallArgs.clear();
+        mockRtnlCalls.clear();
+
+        intfmgr.addLoopbackIntf("Loopback0");
+        intfmgr.setIntfIp("Loopback0", "add", swss::IpPrefix("10.1.0.1/32"));
+        intfmgr.setIntfIp("Ethernet4", "add", swss::IpPrefix("10.2.0.1/24"));
+        intfmgr.setIntfIp("Ethernet4", "del", swss::IpPrefix("10.2.0.1/24"));
+        intfmgr.setIntfVrf("Ethernet4", "Vrf1");
+        intfmgr.setIntfVrf("Ethernet4", "");
+        intfmgr.delLoopbackIntf("Loopback0");
+
+        std::vector<std::string> expected = {
+            "addDummy Loopback0",
+            "setLinkMtu Loopback0 65536",
+            "setLinkAdminState Loopback0 up",
+            "addAddress Loopback0 10.1.0.1/32",
+            "addAddress Ethernet4 10.2.0.1/24 broadcast 10.2.0.255",
+            "delAddress Ethernet4 10.2.0.1/24",
+            "setLinkMaster Ethernet4 Vrf1",
+            "setLinkMaster Ethernet4 nomaster",
+            "delLink Loopback0",
+        };
+        ASSERT_EQ(mockRtnlCalls, expected);
+        ASSERT_TRUE(mockCallArgs.empty());
+    }
+
     //This test except no runtime error when the set admin status command failed
     //and the subinterface has not ok status (for example not existing subinterface)
     TEST_F(IntfMgrTest, testSetAdminStatusFailToNotOkSubInt){
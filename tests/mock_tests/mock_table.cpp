@@ -1,6 +1,7 @@
 #include "table.h"
 #include "producerstatetable.h"
 #include "producertable.h"
+#include <algorithm>
 #include <set>
 #include <memory>
 
@@ -116,6 +117,25 @@ namespace swss
             table->second.erase(key);
         }
     }
+
+    void Table::hdel(const std::string &key, const std::string &field, const std::string& /* op */, const std::string& /*prefix*/)
+    {
+        auto &table = gDB[m_pipe->getDbId()][getTableName()];
+        auto iter = table.find(key);
+        if (iter == table.end())
+        {
+            return;
+        }
+
+        auto &values = iter->second;
+        values.erase(std::remove_if(values.begin(), values.end(),
+                                    [&](const FieldValueTuple &fv) { return fvField(fv) == field; }),
+                     values.end());
+        if (values.empty())
+        {
+            table.erase(iter);
+        }
+    }
     
     void ProducerStateTable::set(const std::string &key,
                                  const std::vector<FieldValueTuple> &values,
@@ -0,0 +1,220 @@
+#include "gtest/gtest.h"
+#include <string.h>
+#include <linux/neighbour.h>
+#include <netlink/route/neighbour.h>
+#include "mock_table.h"
+#include "redisutility.h"
+#include "dbconnector.h"
+#include "producerstatetable.h"
+#include "subscriberstatetable.h"
+#include "warmRestartAssist.h"
+#define private public
+#include "neighsync.h"
+#undef private
+
+/* Mock rtnl_link_i2name() call, for the interface names of the neighbor events */
+extern "C" {
+    char *__wrap_rtnl_link_i2name(struct nl_cache *cache, int ifindex, char *dst, size_t len)
+    {
+        switch (ifindex)
+        {
+            case 2:
+                strncpy(dst, "Ethernet0", len);
+                return dst;
+            case 3:
+                strncpy(dst, "Vlan1000", len);
+                return dst;
+            default:
+                return NULL;
+        }
+    }
+}
+
+namespace neighsync_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    struct NeighSyncTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<swss::RedisPipeline> m_pipeline;
+        shared_ptr<NeighSync> m_neighSync;
+
+        NeighSyncTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+            m_pipeline = make_shared<swss::RedisPipeline>(m_app_db.get());
+        }
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+
+        /* Created by each test, after the config it starts with */
+        void createNeighSync()
+        {
+            m_neighSync = make_shared<NeighSync>(m_pipeline.get(), m_state_db.get(), m_config_db.get());
+        }
+
+        void processConfig()
+        {
+            for (auto selectable : m_neighSync->getConfigSelectables())
+            {
+                ASSERT_TRUE(m_neighSync->processConfig(selectable));
+            }
+        }
+
+        void sendNeigh(int nlmsg_type, int family, const char *ip, const char *mac, int ifindex, int state)
+        {
+            struct rtnl_neigh *neigh = rtnl_neigh_alloc();
+            struct nl_addr *addr;
+
+            ASSERT_EQ(nl_addr_parse(ip, family, &addr), 0);
+            rtnl_neigh_set_dst(neigh, addr);
+            nl_addr_put(addr);
+            if (mac)
+            {
+                ASSERT_EQ(nl_addr_parse(mac, AF_LLC, &addr), 0);
+                rtnl_neigh_set_lladdr(neigh, addr);
+                nl_addr_put(addr);
+            }
+            rtnl_neigh_set_ifindex(neigh, ifindex);
+            rtnl_neigh_set_state(neigh, state);
+
+            m_neighSync->onMsg(nlmsg_type, (struct nl_object *)neigh);
+            rtnl_neigh_put(neigh);
+        }
+
+        bool getNeigh(const string &key, string &mac)
+        {
+            Table neighTable(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            if (!neighTable.get(key, values))
+            {
+                return false;
+            }
+            auto value_opt = swss::fvsGetValue(values, "neigh", true);
+            mac = value_opt ? value_opt.get() : "";
+            return true;
+        }
+    };
+
+    TEST_F(NeighSyncTest, LinkLocalConfigCache)
+    {
+        Table cfgIntfTable(m_config_db.get(), CFG_INTF_TABLE_NAME);
+        Table cfgVlanIntfTable(m_config_db.get(), CFG_VLAN_INTF_TABLE_NAME);
+        cfgIntfTable.set("Ethernet0", {{"ipv6_use_link_local_only", "enable"}});
+        cfgIntfTable.set("Ethernet0|10.0.0.0/31", {{"NULL", "NULL"}});
+        createNeighSync();
+
+        /* The existing config is loaded on start, the address entries are not interfaces */
+        ASSERT_EQ(m_neighSync->m_intfLinkLocal, unordered_set<string>({"Ethernet0"}));
+
+        string mac;
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, "fe80::1", "00:00:00:00:00:01", 2, NUD_REACHABLE);
+        ASSERT_TRUE(getNeigh("Ethernet0:fe80::1", mac));
+        ASSERT_EQ(mac, "00:00:00:00:00:01");
+
+        /* Disabled by a config change, link local neighbors are ignored but still removed */
+        cfgIntfTable.set("Ethernet0", {{"ipv6_use_link_local_only", "disable"}});
+        processConfig();
+        ASSERT_TRUE(m_neighSync->m_intfLinkLocal.empty());
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, "fe80::2", "00:00:00:00:00:02", 2, NUD_REACHABLE);
+        ASSERT_FALSE(getNeigh("Ethernet0:fe80::2", mac));
+        sendNeigh(RTM_DELNEIGH, AF_INET6, "fe80::1", "00:00:00:00:00:01", 2, NUD_REACHABLE);
+        ASSERT_FALSE(getNeigh("Ethernet0:fe80::1", mac));
+
+        /* Enabled later on a VLAN interface */
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, "fe80::3", "00:00:00:00:00:03", 3, NUD_REACHABLE);
+        ASSERT_FALSE(getNeigh("Vlan1000:fe80::3", mac));
+        cfgVlanIntfTable.set("Vlan1000", {{"ipv6_use_link_local_only", "enable"}});
+        processConfig();
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, "fe80::3", "00:00:00:00:00:03", 3, NUD_REACHABLE);
+        ASSERT_TRUE(getNeigh("Vlan1000:fe80::3", mac));
+
+        /* The removal of the interface entry invalidates it too */
+        m_neighSync->updateConfigCache(m_neighSync->m_cfgVlanInterfaceTable, KeyOpFieldsValuesTuple{"Vlan1000", DEL_COMMAND, {}});
+        sendNeigh(RTM_NEWNEIGH, AF_INET6, "fe80::4", "00:00:00:00:00:04", 3, NUD_REACHABLE);
+        ASSERT_FALSE(getNeigh("Vlan1000:fe80::4", mac));
+
+        ASSERT_FALSE(m_neighSync->processConfig(nullptr));
+    }
+
+    TEST_F(NeighSyncTest, PeerSwitchConfigCache)
+    {
+        createNeighSync();
+
+        string mac;
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "169.254.0.1", "00:00:00:00:00:01", 2, NUD_REACHABLE);
+        ASSERT_TRUE(getNeigh("Ethernet0:169.254.0.1", mac));
+
+        /* A peer switch makes it a dual ToR */
+        Table cfgPeerSwitchTable(m_config_db.get(), CFG_PEER_SWITCH_TABLE_NAME);
+        cfgPeerSwitchTable.set("peer_switch_hostname", {{"address_ipv4", "10.1.0.33"}});
+        processConfig();
+        ASSERT_EQ(m_neighSync->m_peerSwitches, set<string>({"peer_switch_hostname"}));
+
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "169.254.0.2", "00:00:00:00:00:02", 2, NUD_REACHABLE);
+        ASSERT_FALSE(getNeigh("Ethernet0:169.254.0.2", mac));
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "10.0.0.5", nullptr, 2, NUD_FAILED);
+        ASSERT_TRUE(getNeigh("Ethernet0:10.0.0.5", mac));
+        ASSERT_EQ(mac, "00:00:00:00:00:00");
+
+        /* Back to a single ToR once the peer switch is removed */
+        m_neighSync->updateConfigCache(m_neighSync->m_cfgPeerSwitchTable,
+                                       KeyOpFieldsValuesTuple{"peer_switch_hostname", DEL_COMMAND, {}});
+        ASSERT_TRUE(m_neighSync->m_peerSwitches.empty());
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "10.0.0.5", nullptr, 2, NUD_FAILED);
+        ASSERT_FALSE(getNeigh("Ethernet0:10.0.0.5", mac));
+    }
+
+    TEST_F(NeighSyncTest, FlushBoundary)
+    {
+        createNeighSync();
+
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "10.0.0.1", "00:00:00:00:00:01", 2, NUD_REACHABLE);
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "10.0.0.2", "00:00:00:00:00:02", 2, NUD_REACHABLE);
+        sendNeigh(RTM_DELNEIGH, AF_INET, "10.0.0.1", "00:00:00:00:00:01", 2, NUD_REACHABLE);
+        /* Counted as an event, not written */
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "10.0.0.3", "00:00:00:00:00:03", 2, NUD_NOARP);
+
+        /* The writes wait for the flush to be accounted */
+        ASSERT_EQ(m_neighSync->m_stats.events, uint64_t(4));
+        ASSERT_EQ(m_neighSync->m_stats.writes, uint64_t(3));
+        ASSERT_EQ(m_neighSync->m_pendingEvents.size(), size_t(3));
+        ASSERT_TRUE(m_neighSync->m_stats.latencyUs.empty());
+
+        m_neighSync->flush();
+        ASSERT_TRUE(m_neighSync->m_pendingEvents.empty());
+        ASSERT_EQ(m_neighSync->m_stats.latencyUs.size(), size_t(3));
+
+        string mac;
+        ASSERT_FALSE(getNeigh("Ethernet0:10.0.0.1", mac));
+        ASSERT_TRUE(getNeigh("Ethernet0:10.0.0.2", mac));
+        ASSERT_FALSE(getNeigh("Ethernet0:10.0.0.3", mac));
+
+        /* A write after the flush belongs to the next one */
+        sendNeigh(RTM_NEWNEIGH, AF_INET, "10.0.0.4", "00:00:00:00:00:04", 2, NUD_REACHABLE);
+        ASSERT_EQ(m_neighSync->m_pendingEvents.size(), size_t(1));
+        ASSERT_EQ(m_neighSync->m_stats.latencyUs.size(), size_t(3));
+        m_neighSync->flush();
+        ASSERT_EQ(m_neighSync->m_stats.latencyUs.size(), size_t(4));
+        m_neighSync->flush();
+        ASSERT_EQ(m_neighSync->m_stats.latencyUs.size(), size_t(4));
+
+        Table statsTable(m_state_db.get(), NEIGHSYNCD_STATS_TABLE);
+        m_neighSync->publishStats(statsTable);
+        vector<FieldValueTuple> values;
+        ASSERT_TRUE(statsTable.get(NEIGHSYNCD_EVENT_STATS_KEY, values));
+        ASSERT_EQ(swss::fvsGetValue(values, "events", true).get(), "5");
+        ASSERT_EQ(swss::fvsGetValue(values, "writes", true).get(), "4");
+        ASSERT_TRUE(m_neighSync->m_stats.latencyUs.empty());
+        ASSERT_EQ(m_neighSync->m_stats.intervalEvents, uint64_t(0));
+    }
+}
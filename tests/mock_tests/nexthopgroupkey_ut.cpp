@@ -0,0 +1,204 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "ut_helper.h"
+#include "routeorch.h"
+
+namespace nexthopgroupkey_test
+{
+    using namespace std;
+
+    TEST(NextHopGroupKeyTest, Interning)
+    {
+        NextHopGroupKey nhg1("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4");
+        NextHopGroupKey nhg2("10.0.0.2@Ethernet4,10.0.0.1@Ethernet0");
+        NextHopGroupKey nhg3("10.0.0.1@Ethernet0");
+
+        ASSERT_EQ(nhg1, nhg2);
+        ASSERT_EQ(nhg1.getId(), nhg2.getId());
+        ASSERT_EQ(nhg1.getHash(), nhg2.getHash());
+        ASSERT_NE(nhg1.getId(), nhg3.getId());
+        ASSERT_NE(nhg1, nhg3);
+        ASSERT_FALSE(nhg1 < nhg2);
+        ASSERT_NE(nhg1 < nhg3, nhg3 < nhg1);
+
+        /* Weights are part of the key */
+        NextHopGroupKey weighted1("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4", string("1,2"));
+        NextHopGroupKey weighted2("10.0.0.1@Ethernet0,10.0.0.2@Ethernet4", string("2,1"));
+        ASSERT_NE(weighted1, weighted2);
+        ASSERT_NE(weighted1, nhg1);
+
+        /* Modifying a copy does not change the original key */
+        NextHopGroupKey nhg4 = nhg3;
+        nhg4.add("10.0.0.2@Ethernet4");
+        ASSERT_EQ(nhg3.getSize(), 1);
+        ASSERT_EQ(nhg4, nhg1);
+        ASSERT_EQ(nhg4.getId(), nhg1.getId());
+        ASSERT_EQ(std::hash<NextHopGroupKey>()(nhg4), std::hash<NextHopGroupKey>()(nhg1));
+
+        nhg4.remove("10.0.0.2@Ethernet4");
+        ASSERT_EQ(nhg4, nhg3);
+        nhg4.remove("10.0.0.1@Ethernet0");
+        ASSERT_EQ(nhg4, NextHopGroupKey());
+        ASSERT_EQ(nhg4.getId(), 0);
+        ASSERT_EQ(nhg4.to_string(), "");
+
+        unordered_map<NextHopGroupKey, int> groups;
+        groups[nhg1] = 1;
+        groups[nhg2]++;
+        groups[nhg3] = 3;
+        ASSERT_EQ(groups.size(), 2);
+        ASSERT_EQ(groups[nhg1], 2);
+    }
+
+    TEST(NextHopGroupKeyTest, CopyOnWrite)
+    {
+        NextHopGroupKey nhg1("10.2.0.1@Ethernet0,10.2.0.2@Ethernet4");
+        NextHopGroupKey nhg2 = nhg1;
+        const auto &nhs = nhg1.getNextHops();
+
+        /* The shared set is left untouched, the modified key points to the interned new set */
+        nhg2.add("10.2.0.3@Ethernet8");
+        ASSERT_EQ(nhs.size(), 2);
+        ASSERT_EQ(&nhg1.getNextHops(), &nhs);
+        ASSERT_EQ(nhg2, NextHopGroupKey("10.2.0.1@Ethernet0,10.2.0.2@Ethernet4,10.2.0.3@Ethernet8"));
+        ASSERT_NE(nhg2.getId(), nhg1.getId());
+
+        nhg2.remove("10.2.0.3@Ethernet8");
+        ASSERT_EQ(nhg2, nhg1);
+        ASSERT_EQ(&nhg2.getNextHops(), &nhs);
+
+        /* Adding a next hop already in the set keeps the set */
+        nhg2.add("10.2.0.1@Ethernet0");
+        ASSERT_EQ(&nhg2.getNextHops(), &nhs);
+
+        /* Const accessors do not write to the shared set, keys can be read from several threads */
+        vector<thread> readers;
+        atomic<size_t> mismatches(0);
+        for (int i = 0; i < 4; i++)
+        {
+            readers.emplace_back([&]() {
+                for (int j = 0; j < 1000; j++)
+                {
+                    NextHopGroupKey nhg3("10.2.0.2@Ethernet4");
+                    nhg3.add("10.2.0.1@Ethernet0");
+                    if (nhg3 != nhg1 || nhg3.getHash() != nhg1.getHash() || nhg1.getId() != nhg2.getId())
+                    {
+                        mismatches++;
+                    }
+                }
+            });
+        }
+        for (auto &reader : readers)
+        {
+            reader.join();
+        }
+        ASSERT_EQ(mismatches.load(), 0);
+    }
+
+    TEST(NextHopGroupKeyTest, IdReuse)
+    {
+        uint32_t id;
+        {
+            NextHopGroupKey nhg("10.1.0.1@Ethernet0,10.1.0.2@Ethernet4");
+            id = nhg.getId();
+            ASSERT_NE(id, 0);
+        }
+
+        /* The ID of a released set is handed to the next new set */
+        NextHopGroupKey nhg("10.1.0.3@Ethernet0,10.1.0.4@Ethernet4");
+        ASSERT_EQ(nhg.getId(), id);
+    }
+
+    TEST(NextHopGroupKeyTest, ConcurrentInternRelease)
+    {
+        vector<string> sets = {
+            "10.3.0.1@Ethernet0",
+            "10.3.0.1@Ethernet0,10.3.0.2@Ethernet4",
+            "10.3.0.2@Ethernet4,10.3.0.3@Ethernet8",
+            "10.3.0.1@Ethernet0,10.3.0.2@Ethernet4,10.3.0.3@Ethernet8"
+        };
+
+        /* The last key of a set is dropped by a thread while the others intern it again */
+        vector<thread> workers;
+        atomic<size_t> mismatches(0);
+        for (int i = 0; i < 8; i++)
+        {
+            workers.emplace_back([&, i]() {
+                for (int j = 0; j < 5000; j++)
+                {
+                    const auto &nhs = sets[(i + j) % sets.size()];
+                    NextHopGroupKey nhg1(nhs);
+                    NextHopGroupKey nhg2 = nhg1;
+                    nhg2.remove(*nhg1.getNextHops().begin());
+                    NextHopGroupKey nhg3(nhs);
+                    if (nhg3 != nhg1 || nhg3.getId() != nhg1.getId() || nhg3.getHash() != nhg1.getHash() ||
+                        (nhg2.getSize() != 0 && nhg2.getId() == nhg1.getId()))
+                    {
+                        mismatches++;
+                    }
+                }
+            });
+        }
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        ASSERT_EQ(mismatches.load(), 0);
+
+        /* Every set was released, the table still interns them */
+        NextHopGroupKey nhg1(sets[1]);
+        NextHopGroupKey nhg2(sets[1]);
+        ASSERT_NE(nhg1.getId(), 0);
+        ASSERT_EQ(nhg1.getId(), nhg2.getId());
+    }
+
+    /*
+     * Next hop group table lookups during an ECMP churn, where a link flap
+     * rebuilds every group using the link. It is disabled by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*NextHopGroupKey_Benchmark*
+     */
+    TEST(NextHopGroupKeyTest, DISABLED_NextHopGroupKey_Benchmark)
+    {
+        const size_t groups = 10000;
+        const size_t width = 8;
+
+        vector<string> keys;
+        for (size_t i = 0; i < groups; i++)
+        {
+            string nhs;
+            for (size_t j = 0; j < width; j++)
+            {
+                nhs += (j ? "," : "") + string("10.") + to_string(i % 200) + "." + to_string((i / 200 + j) % 250) + ".1@Ethernet" + to_string(j * 4);
+            }
+            keys.push_back(nhs);
+        }
+
+        NextHopGroupTable table;
+        for (const auto &key : keys)
+        {
+            table[NextHopGroupKey(key)].ref_count = 1;
+        }
+
+        auto start = chrono::steady_clock::now();
+        size_t found = 0;
+        for (int round = 0; round < 10; round++)
+        {
+            for (const auto &key : keys)
+            {
+                NextHopGroupKey nhg(key);
+                nhg.remove(*nhg.getNextHops().begin());
+                found += table.count(nhg);
+                NextHopGroupKey full(key);
+                found += table.count(full);
+            }
+        }
+        auto done = chrono::steady_clock::now();
+
+        ASSERT_GE(found, groups * 10);
+        cout << "NextHopGroupKey groups " << groups << " width " << width
+             << " churn " << chrono::duration_cast<chrono::milliseconds>(done - start).count() << " ms"
+             << endl;
+    }
+}
@@ -1,8 +1,10 @@
-#include "orchdaemon.h"
 #include "dbconnector.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "mock_sai_switch.h"
+#define private public
+#include "orchdaemon.h"
+#undef private
 
 extern sai_switch_api_t* sai_switch_api;
 sai_switch_api_t test_sai_switch;
@@ -49,4 +51,96 @@ namespace orchdaemon_test
 
         orchd->logRotate();
     }
+
+    class GroupedOrch : public Orch
+    {
+        public:
+            GroupedOrch(const string &group) :
+                Orch(&appl_db, vector<string>{})
+            {
+                setExecutionGroup(group);
+            }
+
+            void doTask(Consumer &consumer) override
+            {
+            }
+    };
+
+    TEST_F(OrchDaemonTest, AssignWorkersByExecutionGroup)
+    {
+        auto *mainOrch = new GroupedOrch("");
+        auto *dashOrch1 = new GroupedOrch("dash");
+        auto *dashOrch2 = new GroupedOrch("dash");
+        auto *dashDependent = new GroupedOrch("");
+        auto *otherOrch = new GroupedOrch("other");
+        auto *conflictOrch1 = new GroupedOrch("group1");
+        auto *conflictOrch2 = new GroupedOrch("group2");
+        auto *conflictDependent = new GroupedOrch("");
+
+        // An orch without group follows the orch it depends on
+        dashDependent->addDependency(dashOrch1);
+        // Dependencies are transitive, conflicting groups stay on the main thread
+        conflictDependent->addDependency(conflictOrch1);
+        conflictOrch2->addDependency(conflictDependent);
+
+        for (auto *o : vector<Orch *>{mainOrch, dashOrch1, dashOrch2, dashDependent, otherOrch,
+                                      conflictOrch1, conflictOrch2, conflictDependent})
+        {
+            orchd->addOrchList(o);
+        }
+
+        orchd->setWorkerThreadsEnabled(true);
+        orchd->assignWorkers();
+
+        ASSERT_EQ(orchd->getMainOrchList(),
+                  (vector<Orch *>{mainOrch, conflictOrch1, conflictOrch2, conflictDependent}));
+
+        ASSERT_EQ(orchd->m_workers.size(), 2);
+        map<string, vector<Orch *>> workerOrchs;
+        for (auto &worker : orchd->m_workers)
+        {
+            workerOrchs[worker->getGroup()] = worker->getOrchs();
+        }
+        ASSERT_EQ(workerOrchs["dash"], (vector<Orch *>{dashOrch1, dashOrch2, dashDependent}));
+        ASSERT_EQ(workerOrchs["other"], (vector<Orch *>{otherOrch}));
+    }
+
+    TEST_F(OrchDaemonTest, AssignWorkersDisabled)
+    {
+        auto *dashOrch = new GroupedOrch("dash");
+        orchd->addOrchList(dashOrch);
+
+        orchd->assignWorkers();
+
+        ASSERT_EQ(orchd->getMainOrchList(), (vector<Orch *>{dashOrch}));
+        ASSERT_TRUE(orchd->m_workers.empty());
+    }
+
+    TEST(OrchSchedStatsTest, PublishUpdatedEntries)
+    {
+        OrchSchedStats stats("main");
+
+        // Nothing is recorded while disabled
+        stats.record("ROUTE_TABLE", 100, 10);
+        stats.setEnabled(true);
+        stats.record("ROUTE_TABLE", 100, 10);
+        stats.record("ROUTE_TABLE", 300, 30);
+        stats.publish();
+
+        Table table(&state_db, ORCH_SCHED_STATS_TABLE);
+        string value;
+        ASSERT_TRUE(table.hget("main|ROUTE_TABLE", "count", value));
+        ASSERT_EQ(value, "2");
+        ASSERT_TRUE(table.hget("main|ROUTE_TABLE", "avg_wait_us", value));
+        ASSERT_EQ(value, "200");
+        ASSERT_TRUE(table.hget("main|ROUTE_TABLE", "max_wait_us", value));
+        ASSERT_EQ(value, "300");
+        ASSERT_TRUE(table.hget("main|ROUTE_TABLE", "max_exec_us", value));
+        ASSERT_EQ(value, "30");
+
+        // Entries not updated since the last publish are not rewritten
+        table.del("main|ROUTE_TABLE");
+        stats.publish();
+        ASSERT_FALSE(table.hget("main|ROUTE_TABLE", "count", value));
+    }
 }
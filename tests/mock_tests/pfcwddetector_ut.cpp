@@ -0,0 +1,425 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "pfcwddetector.h"
+#include "sai_serialize.h"
+
+namespace pfcwddetector_test
+{
+    using namespace std;
+    using namespace swss;
+
+    typedef vector<pair<sai_object_id_t, PfcWdDetector::Event>> Events;
+
+    const sai_object_id_t portId = 0x1000000000001;
+    const sai_object_id_t queueId = 0x15000000000003;
+
+    /* Counters of a queue under a PFC storm, or not, after the given sample */
+    PfcWdDetector::QueueSample nextSample(const PfcWdDetector::QueueSample &last, bool storm, bool operational = true)
+    {
+        PfcWdDetector::QueueSample sample = last;
+        sample.valid = true;
+        sample.operational = operational;
+        sample.pauseStatus = storm;
+        sample.pfcRxPackets += storm ? 100 : 0;
+        sample.pfcOn2OffRxPackets += storm ? 0 : 1;
+        sample.packets += storm ? 0 : 100;
+        return sample;
+    }
+
+    Events poll(PfcWdDetector &detector, vector<PfcWdDetector::QueueSample> &samples, bool storm, bool operational = true)
+    {
+        Events events;
+        samples[0] = nextSample(samples[0], storm, operational);
+        detector.poll(100, samples, events);
+        return events;
+    }
+
+    TEST(PfcWdDetectorTest, StormAndRestore)
+    {
+        PfcWdDetector detector;
+        detector.addQueue(queueId, portId, 3, 200, 300, false);
+        vector<PfcWdDetector::QueueSample> samples(1);
+
+        /* The first poll only saves the counters */
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_EQ(detector.getQueues()[0].detectionTimeLeft, 100000u);
+        ASSERT_EQ(poll(detector, samples, true), Events({{queueId, PfcWdDetector::Event::STORM}}));
+        ASSERT_EQ(detector.getQueues()[0].detectionTimeLeft, 200000u);
+
+        /* The queue is restored once no PFC frame is received for the restoration time */
+        ASSERT_TRUE(poll(detector, samples, true, false).empty());
+        ASSERT_TRUE(poll(detector, samples, false, false).empty());
+        ASSERT_TRUE(poll(detector, samples, false, false).empty());
+        ASSERT_TRUE(poll(detector, samples, true, false).empty());
+        ASSERT_EQ(detector.getQueues()[0].restorationTimeLeft, 300000u);
+        ASSERT_TRUE(poll(detector, samples, false, false).empty());
+        ASSERT_TRUE(poll(detector, samples, false, false).empty());
+        ASSERT_EQ(poll(detector, samples, false, false), Events({{queueId, PfcWdDetector::Event::RESTORE}}));
+
+        /* A storm interrupted by a poll without one starts over */
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_TRUE(poll(detector, samples, false).empty());
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_EQ(poll(detector, samples, true), Events({{queueId, PfcWdDetector::Event::STORM}}));
+    }
+
+    TEST(PfcWdDetectorTest, AlertAndBigRedSwitch)
+    {
+        PfcWdDetector detector;
+        detector.addQueue(queueId, portId, 3, 100, 0, true);
+        vector<PfcWdDetector::QueueSample> samples(1);
+
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_EQ(poll(detector, samples, true), Events({{queueId, PfcWdDetector::Event::STORM}}));
+
+        /* In alert mode the detection keeps running and restores at once */
+        ASSERT_EQ(poll(detector, samples, true, false), Events({{queueId, PfcWdDetector::Event::STORM}}));
+        ASSERT_EQ(poll(detector, samples, false, false), Events({{queueId, PfcWdDetector::Event::RESTORE}}));
+
+        /* Nothing is detected nor saved in big red switch mode */
+        samples[0].bigRedSwitch = true;
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        ASSERT_EQ(detector.getQueues()[0].detectionTimeLeft, 100000u);
+
+        /* Nor without all the counters, the reset forgets the last ones */
+        samples[0].bigRedSwitch = false;
+        detector.reset();
+        ASSERT_TRUE(poll(detector, samples, true).empty());
+        samples[0].valid = false;
+        Events events;
+        detector.poll(100, samples, events);
+        ASSERT_TRUE(events.empty());
+        ASSERT_EQ(poll(detector, samples, true), Events({{queueId, PfcWdDetector::Event::STORM}}));
+    }
+
+    TEST(PfcWdDetectorTest, RemoveQueue)
+    {
+        PfcWdDetector detector;
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            detector.addQueue(queueId + i, portId, i, 200, 200, false);
+        }
+
+        detector.removeQueue(queueId + 1);
+        detector.removeQueue(queueId + 7);
+
+        const auto &queues = detector.getQueues();
+        ASSERT_EQ(queues.size(), 3u);
+        ASSERT_EQ(queues[0].queueId, queueId);
+        ASSERT_EQ(queues[1].queueId, queueId + 3);
+        ASSERT_EQ(queues[1].index, 3);
+        ASSERT_EQ(queues[2].queueId, queueId + 2);
+    }
+
+    TEST(PfcWdDetectorTest, CountersTableReader)
+    {
+        ::testing_db::reset();
+
+        DBConnector countersDb("COUNTERS_DB", 0);
+        auto countersTable = make_shared<Table>(&countersDb, "COUNTERS");
+
+        countersTable->set(sai_serialize_object_id(portId), {
+            {"SAI_PORT_STAT_PFC_3_RX_PKTS", "10"},
+            {"SAI_PORT_STAT_PFC_3_ON2OFF_RX_PKTS", "4"},
+            {"SAI_PORT_STAT_PFC_3_RX_PKTS_last", "8"},
+            {"SAI_PORT_STAT_PFC_4_RX_PKTS", "20"}
+        });
+        countersTable->set(sai_serialize_object_id(queueId), {
+            {"SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", "0"},
+            {"SAI_QUEUE_STAT_PACKETS", "1234"},
+            {"SAI_QUEUE_ATTR_PAUSE_STATUS", "true"},
+            {"DEBUG_STORM", "enabled"}
+        });
+        countersTable->set(sai_serialize_object_id(queueId + 1), {
+            {"SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", "0"},
+            {"SAI_QUEUE_STAT_PACKETS", "1234"},
+            {"SAI_QUEUE_ATTR_PAUSE_STATUS", "false"}
+        });
+
+        PfcWdDetector detector;
+        detector.addQueue(queueId, portId, 3, 200, 200, false);
+        detector.addQueue(queueId + 1, portId, 4, 200, 200, false);
+
+        PfcWdCountersTableReader reader(&countersDb);
+        vector<PfcWdDetector::QueueSample> samples;
+        reader.read(detector.getQueues(), samples);
+
+        /* The port is read once for its two queues, all in one batch */
+        ASSERT_EQ(reader.getStats().batches, 1u);
+        ASSERT_EQ(reader.getStats().commands, 3u);
+
+        ASSERT_EQ(samples.size(), 2u);
+        ASSERT_TRUE(samples[0].valid);
+        ASSERT_EQ(samples[0].packets, 1234u);
+        ASSERT_EQ(samples[0].pfcRxPackets, 10u);
+        ASSERT_EQ(samples[0].pfcOn2OffRxPackets, 4u);
+        ASSERT_TRUE(samples[0].pauseStatus);
+        ASSERT_TRUE(samples[0].debugStorm);
+
+        /* No ON2OFF counter for priority 4 */
+        ASSERT_FALSE(samples[1].valid);
+        ASSERT_EQ(samples[1].pfcRxPackets, 20u);
+        ASSERT_FALSE(samples[1].pauseStatus);
+        ASSERT_FALSE(samples[1].debugStorm);
+    }
+
+    TEST(PfcWdDetectorTest, SnapshotReader)
+    {
+        ::testing_db::reset();
+
+        DBConnector countersDb("COUNTERS_DB", 0);
+        auto countersTable = make_shared<Table>(&countersDb, "COUNTERS");
+        countersTable->set(sai_serialize_object_id(portId), {
+            {"SAI_PORT_STAT_PFC_3_RX_PKTS", "10"},
+            {"SAI_PORT_STAT_PFC_3_ON2OFF_RX_PKTS", "4"}
+        });
+        countersTable->set(sai_serialize_object_id(queueId), {
+            {"SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", "0"},
+            {"SAI_QUEUE_STAT_PACKETS", "1234"},
+            {"SAI_QUEUE_ATTR_PAUSE_STATUS", "false"}
+        });
+
+        PfcWdDetector detector;
+        detector.addQueue(queueId, portId, 3, 200, 200, false);
+
+        string group = "UT_PFC_WD_" + to_string(getpid());
+        PfcWdSnapshotReader reader(group, &countersDb);
+        vector<PfcWdDetector::QueueSample> samples;
+
+        /* Without a snapshot region the counters come from the COUNTERS table */
+        reader.read(detector.getQueues(), samples);
+        ASSERT_TRUE(samples[0].valid);
+        ASSERT_EQ(samples[0].packets, 1234u);
+        ASSERT_FALSE(samples[0].pauseStatus);
+
+        CounterSnapshotWriter writer(group, 2, 5);
+        ASSERT_TRUE(writer.setLayout({queueId, portId}, {
+            "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES",
+            "SAI_QUEUE_STAT_PACKETS",
+            "SAI_QUEUE_ATTR_PAUSE_STATUS",
+            "SAI_PORT_STAT_PFC_3_RX_PKTS",
+            "SAI_PORT_STAT_PFC_3_ON2OFF_RX_PKTS"
+        }));
+        writer.begin();
+        writer.set(0, 0, 0);
+        writer.set(0, 1, 5678);
+        writer.set(0, 2, 1);
+        writer.set(1, 3, 20);
+        writer.commit();
+
+        /* The ON2OFF counter was not read at this poll */
+        reader.read(detector.getQueues(), samples);
+        ASSERT_FALSE(samples[0].valid);
+
+        writer.begin();
+        writer.set(1, 4, 8);
+        writer.commit();
+
+        reader.read(detector.getQueues(), samples);
+        ASSERT_TRUE(samples[0].valid);
+        ASSERT_EQ(samples[0].packets, 5678u);
+        ASSERT_TRUE(samples[0].pauseStatus);
+        ASSERT_EQ(samples[0].pfcRxPackets, 20u);
+        ASSERT_EQ(samples[0].pfcOn2OffRxPackets, 8u);
+    }
+
+    /* Size of a redis command or of a bulk string reply, in the protocol */
+    size_t respSize(const vector<string> &args)
+    {
+        size_t size = 3 + to_string(args.size()).size();
+        for (const auto &arg : args)
+        {
+            size += 5 + to_string(arg.size()).size() + arg.size();
+        }
+        return size;
+    }
+
+    struct LuaCalls
+    {
+        uint64_t commands = 0;
+        uint64_t bytes = 0;
+    };
+
+    /*
+     * Redis calls of pfc_detect_broadcom.lua then pfc_restore.lua for an
+     * operational queue, in their order, replayed on the mock tables to count
+     * the commands and the bytes of their arguments and replies. The scripts
+     * run inside redis, these are not sent on a connection.
+     */
+    void replayLuaPoll(Table &countersTable, Table &mapsTable, const string &queueKey, LuaCalls &calls)
+    {
+        /* The maps are hashes of their own, not keys of a table */
+        auto keyName = [](Table &table, const string &key) {
+            return table.getTableName().empty() ? key : table.getKeyName(key);
+        };
+        auto hget = [&](Table &table, const string &key, const string &field) {
+            string value;
+            bool found = table.hget(key, field, value);
+            calls.commands++;
+            calls.bytes += respSize({"HGET", keyName(table, key), field}) + (found ? respSize({value}) - 4 : 5);
+            return found ? value : string();
+        };
+        auto hset = [&](Table &table, const string &key, const string &field, const string &value) {
+            table.hset(key, field, value);
+            calls.commands++;
+            calls.bytes += respSize({"HSET", keyName(table, key), field, value}) + 4;
+        };
+        auto hkeys = [&](const string &key) {
+            vector<FieldValueTuple> fvs;
+            countersTable.get(key, fvs);
+            vector<string> fields;
+            for (const auto &fv : fvs)
+            {
+                fields.push_back(fvField(fv));
+            }
+            calls.commands++;
+            calls.bytes += respSize({"HKEYS", countersTable.getKeyName(key)}) + respSize(fields);
+        };
+
+        // pfc_detect_broadcom.lua
+        hkeys(queueKey);
+        hget(countersTable, queueKey, "PFC_WD_STATUS");
+        hget(countersTable, queueKey, "PFC_WD_ACTION");
+        hget(countersTable, queueKey, "BIG_RED_SWITCH_MODE");
+        hget(countersTable, queueKey, "PFC_WD_DETECTION_TIME");
+        string timeLeft = hget(countersTable, queueKey, "PFC_WD_DETECTION_TIME_LEFT");
+        string index = hget(mapsTable, "COUNTERS_QUEUE_INDEX_MAP", queueKey);
+        string portKey = hget(mapsTable, "COUNTERS_QUEUE_PORT_MAP", queueKey);
+        string pfcRx = "SAI_PORT_STAT_PFC_" + index + "_RX_PKTS";
+        string pfcOn2Off = "SAI_PORT_STAT_PFC_" + index + "_ON2OFF_RX_PKTS";
+        hget(countersTable, queueKey, "SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES");
+        string packets = hget(countersTable, queueKey, "SAI_QUEUE_STAT_PACKETS");
+        string pfcRxPackets = hget(countersTable, portKey, pfcRx);
+        string pfcOn2OffPackets = hget(countersTable, portKey, pfcOn2Off);
+        string pauseStatus = hget(countersTable, queueKey, "SAI_QUEUE_ATTR_PAUSE_STATUS");
+        hget(countersTable, queueKey, "SAI_QUEUE_STAT_PACKETS_last");
+        hget(countersTable, portKey, pfcRx + "_last");
+        hget(countersTable, portKey, pfcOn2Off + "_last");
+        hget(countersTable, queueKey, "SAI_QUEUE_ATTR_PAUSE_STATUS_last");
+        hget(countersTable, queueKey, "DEBUG_STORM");
+        hset(countersTable, queueKey, "SAI_QUEUE_ATTR_PAUSE_STATUS_last", pauseStatus);
+        hset(countersTable, queueKey, "SAI_QUEUE_STAT_PACKETS_last", packets);
+        hset(countersTable, queueKey, "PFC_WD_DETECTION_TIME_LEFT", timeLeft.empty() ? "200000" : timeLeft);
+        hset(countersTable, portKey, pfcRx + "_last", pfcRxPackets);
+        hset(countersTable, portKey, pfcOn2Off + "_last", pfcOn2OffPackets);
+
+        // pfc_restore.lua, which stops at an operational queue
+        hkeys(queueKey);
+        hget(countersTable, queueKey, "PFC_WD_STATUS");
+        hget(countersTable, queueKey, "PFC_WD_RESTORATION_TIME");
+        hget(countersTable, queueKey, "PFC_WD_ACTION");
+        hget(countersTable, queueKey, "BIG_RED_SWITCH_MODE");
+    }
+
+    /*
+     * Cost of a detection poll over 64 ports with 8 monitored queues each,
+     * the counters read from COUNTERS_DB and the state machine run, against
+     * the state machine alone, and the redis commands and bytes of a poll
+     * against the ones of the pfc_detect/pfc_restore Lua plugins. The plugins
+     * run inside redis and their time can't be measured here. It is disabled
+     * by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*PfcWdDetection_Benchmark*
+     */
+    TEST(PfcWdDetectorTest, DISABLED_PfcWdDetection_Benchmark)
+    {
+        const int ports = 64;
+        const int queues = 8;
+        const int polls = 1000;
+
+        ::testing_db::reset();
+
+        DBConnector countersDb("COUNTERS_DB", 0);
+        auto countersTable = make_shared<Table>(&countersDb, "COUNTERS");
+        Table mapsTable(&countersDb, "");
+
+        PfcWdDetector detector;
+        vector<string> queueKeys;
+        for (int port = 0; port < ports; port++)
+        {
+            vector<FieldValueTuple> portCounters;
+            for (int queue = 0; queue < queues; queue++)
+            {
+                sai_object_id_t id = queueId + static_cast<sai_object_id_t>(port * queues + queue);
+                detector.addQueue(id, portId + port, static_cast<uint8_t>(queue), 200, 200, false);
+
+                queueKeys.push_back(sai_serialize_object_id(id));
+                countersTable->set(queueKeys.back(), {
+                    {"SAI_QUEUE_STAT_CURR_OCCUPANCY_BYTES", "0"},
+                    {"SAI_QUEUE_STAT_PACKETS", "1234"},
+                    {"SAI_QUEUE_ATTR_PAUSE_STATUS", "false"},
+                    {"PFC_WD_DETECTION_TIME", "200000"},
+                    {"PFC_WD_RESTORATION_TIME", "200000"},
+                    {"PFC_WD_ACTION", "drop"},
+                    {"PFC_WD_STATUS", "operational"}
+                });
+                mapsTable.hset("COUNTERS_QUEUE_INDEX_MAP", queueKeys.back(), to_string(queue));
+                mapsTable.hset("COUNTERS_QUEUE_PORT_MAP", queueKeys.back(), sai_serialize_object_id(portId + port));
+                portCounters.emplace_back("SAI_PORT_STAT_PFC_" + to_string(queue) + "_RX_PKTS", "0");
+                portCounters.emplace_back("SAI_PORT_STAT_PFC_" + to_string(queue) + "_ON2OFF_RX_PKTS", "0");
+            }
+            countersTable->set(sai_serialize_object_id(portId + port), portCounters);
+        }
+
+        /* The first poll of the plugins writes the _last fields the next ones read */
+        LuaCalls luaCalls;
+        for (int i = 0; i < 2; i++)
+        {
+            luaCalls = LuaCalls();
+            for (const auto &key : queueKeys)
+            {
+                replayLuaPoll(*countersTable, mapsTable, key, luaCalls);
+            }
+        }
+        /* The EVALSHA of each plugin with the queue keys, and the SELECT it starts with */
+        vector<string> evalsha = {"EVALSHA", string(40, '0'), to_string(queueKeys.size())};
+        evalsha.insert(evalsha.end(), queueKeys.begin(), queueKeys.end());
+        evalsha.insert(evalsha.end(), {"2", "COUNTERS", "100"});
+        uint64_t luaRequestBytes = 2 * respSize(evalsha);
+        luaCalls.commands += 2;
+        luaCalls.bytes += 2 * (respSize({"SELECT", "2"}) + 5);
+
+        PfcWdCountersTableReader reader(&countersDb);
+        vector<PfcWdDetector::QueueSample> samples;
+        Events events;
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < polls; i++)
+        {
+            reader.read(detector.getQueues(), samples);
+            detector.poll(100, samples, events);
+        }
+        auto read = chrono::steady_clock::now();
+        for (int i = 0; i < polls; i++)
+        {
+            detector.poll(100, samples, events);
+        }
+        auto done = chrono::steady_clock::now();
+
+        const auto &stats = reader.getStats();
+        ASSERT_EQ(stats.batches, static_cast<uint64_t>(polls));
+        ASSERT_EQ(stats.commands, static_cast<uint64_t>(polls * (ports * queues + ports)));
+
+        auto readUs = chrono::duration_cast<chrono::microseconds>(read - start).count();
+        auto pollUs = chrono::duration_cast<chrono::microseconds>(done - read).count();
+        cout << ports * queues << " queues, read and detect " << readUs / polls << " us/poll, "
+             << "detect only " << pollUs / polls << " us/poll" << endl;
+        cout << "native: " << stats.batches / polls << " round trip/poll, "
+             << stats.commands / polls << " redis commands/poll, "
+             << stats.requestBytes / polls << " request bytes/poll, "
+             << stats.replyBytes / polls << " reply bytes/poll" << endl;
+        cout << "lua: 2 round trips/poll, " << luaRequestBytes << " request bytes/poll, "
+             << luaCalls.commands << " redis commands/poll in the scripts, "
+             << luaCalls.bytes << " bytes/poll of their arguments and replies" << endl;
+    }
+}
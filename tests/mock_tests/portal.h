@@ -39,6 +39,16 @@ struct Portal
         {
             return aclOrch->m_AclTables;
         }
+
+        static AclEntryBulker &getAclEntryBulker(AclOrch *aclOrch)
+        {
+            return aclOrch->m_aclEntryBulker;
+        }
+
+        static AclCounterBulker &getAclCounterBulker(AclOrch *aclOrch)
+        {
+            return aclOrch->m_aclCounterBulker;
+        }
     };
 
     struct CrmOrchInternal
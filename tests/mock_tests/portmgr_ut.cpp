@@ -4,6 +4,7 @@
 #include "redisutility.h"
 
 extern std::vector<std::string> mockCallArgs;
+extern std::vector<std::string> mockRtnlCalls;
 
 namespace portmgr_ut
 {
@@ -49,9 +50,11 @@ namespace portmgr_ut
             {"index", "1"}
         });
         mockCallArgs.clear();
+        mockRtnlCalls.clear();
         m_portMgr->addExistingData(&cfg_port_table);
         m_portMgr->doTask();
         ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(mockRtnlCalls.empty());
         std::vector<FieldValueTuple> values;
         app_port_table.get("Ethernet0", values);
         auto value_opt = swss::fvsGetValue(values, "mtu", true);
@@ -72,9 +75,10 @@ namespace portmgr_ut
             {"state", "ok"}
         });
         m_portMgr->doTask();
-        ASSERT_EQ(size_t(2), mockCallArgs.size());
-        ASSERT_EQ("/sbin/ip link set dev \"Ethernet0\" mtu \"9100\"", mockCallArgs[0]);
-        ASSERT_EQ("/sbin/ip link set dev \"Ethernet0\" down", mockCallArgs[1]);
+        ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_EQ(size_t(2), mockRtnlCalls.size());
+        ASSERT_EQ("setLinkMtu Ethernet0 9100", mockRtnlCalls[0]);
+        ASSERT_EQ("setLinkAdminState Ethernet0 down", mockRtnlCalls[1]);
         
         // Set port admin_status, verify that it could override the default value
         cfg_port_table.set("Ethernet0", {
@@ -100,9 +104,11 @@ namespace portmgr_ut
         });
 
         mockCallArgs.clear();
+        mockRtnlCalls.clear();
         m_portMgr->addExistingData(&cfg_port_table);
         m_portMgr->doTask();
         ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(mockRtnlCalls.empty());
 
         cfg_port_table.set("Ethernet0", {
             {"speed", "50000"},
@@ -114,14 +120,16 @@ namespace portmgr_ut
         m_portMgr->addExistingData(&cfg_port_table);
         m_portMgr->doTask();
         ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(mockRtnlCalls.empty());
 
         state_port_table.set("Ethernet0", {
             {"state", "ok"}
         });
         m_portMgr->doTask();
-        ASSERT_EQ(size_t(2), mockCallArgs.size());
-        ASSERT_EQ("/sbin/ip link set dev \"Ethernet0\" mtu \"1518\"", mockCallArgs[0]);
-        ASSERT_EQ("/sbin/ip link set dev \"Ethernet0\" up", mockCallArgs[1]);
+        ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_EQ(size_t(2), mockRtnlCalls.size());
+        ASSERT_EQ("setLinkMtu Ethernet0 1518", mockRtnlCalls[0]);
+        ASSERT_EQ("setLinkAdminState Ethernet0 up", mockRtnlCalls[1]);
     }
 
     TEST_F(PortMgrTest, ConfigurePortPTDefaultTimestampTemplate)
@@ -138,9 +146,11 @@ namespace portmgr_ut
             {"pt_interface_id", "129"}
         });
         mockCallArgs.clear();
+        mockRtnlCalls.clear();
         m_portMgr->addExistingData(&cfg_port_table);
         m_portMgr->doTask();
         ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(mockRtnlCalls.empty());
         std::vector<FieldValueTuple> values;
         app_port_table.get("Ethernet0", values);
         auto value_opt = swss::fvsGetValue(values, "mtu", true);
@@ -177,9 +187,11 @@ namespace portmgr_ut
             {"pt_timestamp_template", "template2"}
         });
         mockCallArgs.clear();
+        mockRtnlCalls.clear();
         m_portMgr->addExistingData(&cfg_port_table);
         m_portMgr->doTask();
         ASSERT_TRUE(mockCallArgs.empty());
+        ASSERT_TRUE(mockRtnlCalls.empty());
         std::vector<FieldValueTuple> values;
         app_port_table.get("Ethernet0", values);
         auto value_opt = swss::fvsGetValue(values, "mtu", true);
@@ -7,6 +7,7 @@
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
 #include "notifier.h"
+#include "timer.h"
 #include "mock_sai_bridge.h"
 #define private public
 #include "pfcactionhandler.h"
@@ -18,6 +19,7 @@
 #undef private
 
 #include <sstream>
+#include <unistd.h>
 
 extern redisReply *mockReply;
 using ::testing::_;
@@ -230,6 +232,7 @@ namespace portsorch_test
     int32_t *_sai_syncd_notification_event;
     uint32_t _sai_switch_dlr_packet_action_count;
     uint32_t _sai_switch_dlr_packet_action;
+    set<string> _sai_flex_counter_keys;
     sai_status_t _ut_stub_sai_set_switch_attribute(
         _In_ sai_object_id_t switch_id,
         _In_ const sai_attribute_t *attr)
@@ -239,6 +242,19 @@ namespace portsorch_test
             *_sai_syncd_notifications_count =+ 1;
             *_sai_syncd_notification_event = attr[0].value.s32;
         }
+        else if (attr[0].id == SAI_REDIS_SWITCH_ATTR_FLEX_COUNTER)
+        {
+            auto param = static_cast<sai_redis_flex_counter_parameter_t *>(attr[0].value.ptr);
+            string key(param->counter_key.list, param->counter_key.count);
+            if (param->counter_ids.count)
+            {
+                _sai_flex_counter_keys.insert(key);
+            }
+            else
+            {
+                _sai_flex_counter_keys.erase(key);
+            }
+        }
 	else if (attr[0].id == SAI_SWITCH_ATTR_PFC_DLR_PACKET_ACTION)
         {
 	    _sai_switch_dlr_packet_action_count++;
@@ -688,6 +704,112 @@ namespace portsorch_test
         cleanupPorts(gPortsOrch);
     }
 
+    /*
+     * Test lazy queue and PG flex counters, added when the port goes oper up
+     * and removed once the port has been oper down for the idle time, while
+     * the counter maps of all the ports are kept
+     */
+    TEST_F(PortsOrchTest, LazyBufferCounters)
+    {
+        _hook_sai_switch_api();
+        _sai_flex_counter_keys.clear();
+
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table deviceMetadata = Table(m_config_db.get(), CFG_DEVICE_METADATA_TABLE_NAME);
+        Table flexCounterCfg = Table(m_config_db.get(), CFG_FLEX_COUNTER_TABLE_NAME);
+        Table queueMap = Table(m_counters_db.get(), COUNTERS_QUEUE_NAME_MAP);
+        Table pgMap = Table(m_counters_db.get(), COUNTERS_PG_NAME_MAP);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+        gPortsOrch->addExistingData(&portTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        Port port;
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_TRUE(port.m_oper_status != SAI_PORT_OPER_STATUS_UP);
+
+        deviceMetadata.set("localhost", { { "lazy_buffer_counters", "true" },
+                                          { "lazy_buffer_counters_idle_time", "1" } });
+        flexCounterCfg.set("QUEUE", { { FLEX_COUNTER_STATUS_FIELD, "enable" } });
+        flexCounterCfg.set("PG_WATERMARK", { { FLEX_COUNTER_STATUS_FIELD, "enable" } });
+        auto flexCounterOrch = gDirectory.get<FlexCounterOrch*>();
+        flexCounterOrch->addExistingData(&flexCounterCfg);
+        static_cast<Orch *>(flexCounterOrch)->doTask();
+
+        auto pgWatermarkKey = [](const Port &p, size_t pgIndex) {
+            return string(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP) + ":" +
+                   sai_serialize_object_id(p.m_priority_group_ids[pgIndex]);
+        };
+        Port port4;
+        gPortsOrch->getPort("Ethernet4", port4);
+
+        // The maps of the oper down port are there, its flex counters are not
+        string value;
+        ASSERT_TRUE(queueMap.hget("", "Ethernet0:3", value));
+        ASSERT_EQ(value, sai_serialize_object_id(port.m_queue_ids[3]));
+        ASSERT_TRUE(pgMap.hget("", "Ethernet0:3", value));
+        ASSERT_EQ(value, sai_serialize_object_id(port.m_priority_group_ids[3]));
+        ASSERT_FALSE(_sai_flex_counter_keys.count(pgWatermarkKey(port, 3)));
+
+        auto exec = static_cast<Notifier *>(gPortsOrch->getExecutor("PORT_STATUS_NOTIFICATIONS"));
+        auto consumer = exec->getNotificationConsumer();
+        auto notifyOperStatus = [&](sai_port_oper_status_t oper_status) {
+            mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->type = REDIS_REPLY_ARRAY;
+            mockReply->elements = 3; // REDIS_PUBLISH_MESSAGE_ELEMNTS
+            mockReply->element = (redisReply **)calloc(sizeof(redisReply *), mockReply->elements);
+            mockReply->element[2] = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->element[2]->type = REDIS_REPLY_STRING;
+            sai_port_oper_status_notification_t port_oper_status;
+            memset(&port_oper_status, 0, sizeof(port_oper_status));
+            port_oper_status.port_state = oper_status;
+            port_oper_status.port_id = port.m_port_id;
+            std::string data = sai_serialize_port_oper_status_ntf(1, &port_oper_status);
+            std::vector<FieldValueTuple> notifyValues;
+            FieldValueTuple opdata("port_state_change", data);
+            notifyValues.push_back(opdata);
+            std::string msg = swss::JSon::buildJson(notifyValues);
+            mockReply->element[2]->str = (char*)calloc(1, msg.length() + 1);
+            memcpy(mockReply->element[2]->str, msg.c_str(), msg.length());
+
+            consumer->readData();
+            gPortsOrch->doTask(*consumer);
+            mockReply = nullptr;
+        };
+
+        // The flex counters of the port are added when it goes oper up
+        notifyOperStatus(SAI_PORT_OPER_STATUS_UP);
+        ASSERT_TRUE(_sai_flex_counter_keys.count(pgWatermarkKey(port, 3)));
+        ASSERT_FALSE(_sai_flex_counter_keys.count(pgWatermarkKey(port4, 3)));
+        ASSERT_TRUE(queueMap.hget("", "Ethernet4:3", value));
+
+        // And removed once it has been oper down for the idle time
+        notifyOperStatus(SAI_PORT_OPER_STATUS_DOWN);
+        auto poller = static_cast<ExecutableTimer *>(gPortsOrch->getExecutor("LAZY_BUFFER_COUNTERS_POLLER"));
+        poller->execute();
+        ASSERT_TRUE(_sai_flex_counter_keys.count(pgWatermarkKey(port, 3)));
+
+        sleep(1);
+        poller->execute();
+        ASSERT_FALSE(_sai_flex_counter_keys.count(pgWatermarkKey(port, 3)));
+        ASSERT_TRUE(queueMap.hget("", "Ethernet0:3", value));
+        ASSERT_TRUE(pgMap.hget("", "Ethernet0:3", value));
+
+        // Up again
+        notifyOperStatus(SAI_PORT_OPER_STATUS_UP);
+        ASSERT_TRUE(_sai_flex_counter_keys.count(pgWatermarkKey(port, 3)));
+
+        _unhook_sai_switch_api();
+        cleanupPorts(gPortsOrch);
+    }
+
    /*
     * Test port oper error count
     */
@@ -2439,6 +2561,164 @@ namespace portsorch_test
         _unhook_sai_port_api();
     }
 
+    uint32_t _sai_get_ports_attribute_count;
+    uint32_t _sai_get_port_oper_attribute_count;
+    sai_object_id_t _sai_get_ports_zero_speed_port = SAI_NULL_OBJECT_ID;
+
+    sai_status_t _ut_stub_sai_get_ports_attribute(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ const uint32_t *attr_count,
+        _Inout_ sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        _sai_get_ports_attribute_count++;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            for (uint32_t j = 0; j < attr_count[i]; j++)
+            {
+                auto &attr = attr_list[i][j];
+                if (attr.id == SAI_PORT_ATTR_OPER_STATUS)
+                {
+                    attr.value.u32 = (uint32_t)SAI_PORT_OPER_STATUS_UP;
+                }
+                else if (attr.id == SAI_PORT_ATTR_OPER_SPEED)
+                {
+                    attr.value.u32 = object_id[i] == _sai_get_ports_zero_speed_port ? 0 : 100000;
+                }
+                else if (attr.id == SAI_PORT_ATTR_OPER_PORT_FEC_MODE)
+                {
+                    attr.value.s32 = SAI_PORT_FEC_MODE_RS;
+                }
+            }
+            object_statuses[i] = SAI_STATUS_SUCCESS;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_sai_get_port_oper_attribute(
+        _In_ sai_object_id_t port_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            if (attr_list[i].id == SAI_PORT_ATTR_OPER_STATUS ||
+                attr_list[i].id == SAI_PORT_ATTR_OPER_SPEED ||
+                attr_list[i].id == SAI_PORT_ATTR_OPER_PORT_FEC_MODE)
+            {
+                _sai_get_port_oper_attribute_count++;
+            }
+        }
+        return pold_sai_port_api->get_port_attribute(port_id, attr_count, attr_list);
+    }
+
+    /*
+     * Test case: refreshPortStatus reads the oper status, speed and FEC of all
+     * the ports by bulk GETs
+     **/
+    TEST_F(PortsOrchTest, RefreshPortStatusBulkGet)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table statePortTable = Table(m_state_db.get(), STATE_PORT_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ut_sai_port_api = *sai_port_api;
+        pold_sai_port_api = sai_port_api;
+        ut_sai_port_api.get_ports_attribute = _ut_stub_sai_get_ports_attribute;
+        ut_sai_port_api.get_port_attribute = _ut_stub_sai_get_port_oper_attribute;
+        sai_port_api = &ut_sai_port_api;
+
+        _sai_get_ports_attribute_count = 0;
+        _sai_get_port_oper_attribute_count = 0;
+        gPortsOrch->oper_fec_sup = true;
+        gPortsOrch->refreshPortStatus();
+
+        // One bulk GET for the oper status and one for the speed and FEC
+        ASSERT_EQ(_sai_get_ports_attribute_count, 2u);
+        ASSERT_EQ(_sai_get_port_oper_attribute_count, 0u);
+
+        for (const auto &it : ports)
+        {
+            Port port;
+            gPortsOrch->getPort(it.first, port);
+            ASSERT_EQ(port.m_oper_status, SAI_PORT_OPER_STATUS_UP);
+
+            string value;
+            ASSERT_TRUE(statePortTable.hget(it.first, "speed", value));
+            ASSERT_EQ(value, "100000");
+            ASSERT_TRUE(statePortTable.hget(it.first, "fec", value));
+            ASSERT_EQ(value, "rs");
+        }
+
+        // The attributes are only cached for the pass
+        ASSERT_TRUE(gPortsOrch->m_portOperAttrCache.empty());
+
+        // A speed of 0 read in bulk is read again by a single GET
+        Port port;
+        gPortsOrch->getPort("Ethernet0", port);
+        _sai_get_ports_zero_speed_port = port.m_port_id;
+        _sai_get_ports_attribute_count = 0;
+        gPortsOrch->refreshPortStatus();
+        _sai_get_ports_zero_speed_port = SAI_NULL_OBJECT_ID;
+        ASSERT_EQ(_sai_get_ports_attribute_count, 2u);
+        ASSERT_EQ(_sai_get_port_oper_attribute_count, 1u);
+        ASSERT_TRUE(gPortsOrch->m_portOperAttrCache.empty());
+
+        // The port state change is handled with the attributes of its notification
+        auto exec = static_cast<Notifier *>(gPortsOrch->getExecutor("PORT_STATUS_NOTIFICATIONS"));
+        auto consumer = exec->getNotificationConsumer();
+
+        mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+        mockReply->type = REDIS_REPLY_ARRAY;
+        mockReply->elements = 3; // REDIS_PUBLISH_MESSAGE_ELEMNTS
+        mockReply->element = (redisReply **)calloc(sizeof(redisReply *), mockReply->elements);
+        mockReply->element[2] = (redisReply *)calloc(sizeof(redisReply), 1);
+        mockReply->element[2]->type = REDIS_REPLY_STRING;
+        sai_port_oper_status_notification_t port_oper_status;
+        port_oper_status.port_id = port.m_port_id;
+        port_oper_status.port_state = SAI_PORT_OPER_STATUS_DOWN;
+        port_oper_status.port_error_status = SAI_PORT_ERROR_STATUS_CLEAR;
+        std::string data = sai_serialize_port_oper_status_ntf(1, &port_oper_status);
+        std::vector<FieldValueTuple> notifyValues;
+        FieldValueTuple opdata("port_state_change", data);
+        notifyValues.push_back(opdata);
+        std::string msg = swss::JSon::buildJson(notifyValues);
+        mockReply->element[2]->str = (char*)calloc(1, msg.length() + 1);
+        memcpy(mockReply->element[2]->str, msg.c_str(), msg.length());
+
+        consumer->readData();
+        gPortsOrch->doTask(*consumer);
+        mockReply = nullptr;
+
+        gPortsOrch->getPort("Ethernet0", port);
+        ASSERT_EQ(port.m_oper_status, SAI_PORT_OPER_STATUS_DOWN);
+        ASSERT_TRUE(gPortsOrch->m_portOperAttrCache.empty());
+        ASSERT_EQ(_sai_get_ports_attribute_count, 2u);
+
+        sai_port_api = pold_sai_port_api;
+    }
+
     /*
      * Test case: SAI_PORT_ATTR_PRIORITY_FLOW_CONTROL_MODE is not supported by vendor
      **/
@@ -0,0 +1,314 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "ratecounters.h"
+#include "sai_serialize.h"
+
+namespace ratecounters_test
+{
+    using namespace std;
+    using namespace swss;
+
+    const sai_object_id_t portId = 0x1000000000001;
+    const sai_object_id_t rifId = 0x6000000000001;
+    const sai_object_id_t counterId = 0x22000000000001;
+
+    class RateCountersTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+
+        string get(const string &key, const string &field)
+        {
+            string value;
+            return m_ratesTable.hget(key, field, value) ? value : "";
+        }
+
+        void setPortCounters(sai_object_id_t id, uint64_t packets, uint64_t octets)
+        {
+            m_countersTable.set(sai_serialize_object_id(id), {
+                {"SAI_PORT_STAT_IF_IN_UCAST_PKTS", to_string(packets)},
+                {"SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS", to_string(packets)},
+                {"SAI_PORT_STAT_IF_OUT_UCAST_PKTS", to_string(packets * 2)},
+                {"SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS", "0"},
+                {"SAI_PORT_STAT_IF_IN_OCTETS", to_string(octets)},
+                {"SAI_PORT_STAT_IF_OUT_OCTETS", to_string(octets * 2)}
+            });
+        }
+
+        DBConnector m_countersDb{"COUNTERS_DB", 0};
+        Table m_countersTable{&m_countersDb, "COUNTERS"};
+        Table m_ratesTable{&m_countersDb, "RATES"};
+        string m_group = "UT_RATES_" + to_string(getpid());
+    };
+
+    TEST_F(RateCountersTest, PortRates)
+    {
+        RateCounters rates(RateCounters::Type::PORT, &m_countersDb, m_group);
+        rates.setSerdesRateGetter([](sai_object_id_t) { return RateCounters::getSerdesRate(4, 100000); });
+        ASSERT_EQ(rates.getName(), "PORT");
+        ASSERT_EQ(rates.getLuaPlugin(), "port_rates.lua");
+
+        const string port = sai_serialize_object_id(portId);
+        setPortCounters(portId, 100, 1000);
+
+        /* Nothing is computed until the smoothing factor is configured */
+        rates.poll(1000, {port});
+        ASSERT_EQ(get(port + ":PORT", "INIT_DONE"), "");
+
+        m_ratesTable.set("PORT", {{"PORT_ALPHA", "0.5"}});
+        rates.poll(1000, {port});
+        ASSERT_EQ(get(port + ":PORT", "INIT_DONE"), "COUNTERS_LAST");
+        ASSERT_EQ(get(port, "SAI_PORT_STAT_IF_IN_OCTETS_last"), "1000");
+        ASSERT_EQ(get(port, "RX_BPS"), "");
+        /* No FEC counters on this port */
+        ASSERT_EQ(get(port, "FEC_PRE_BER"), "");
+
+        /* The first rates are not smoothed */
+        setPortCounters(portId, 300, 3000);
+        rates.poll(500, {port});
+        ASSERT_EQ(get(port + ":PORT", "INIT_DONE"), "DONE");
+        ASSERT_EQ(get(port, "RX_BPS"), "4000");
+        ASSERT_EQ(get(port, "TX_BPS"), "8000");
+        ASSERT_EQ(get(port, "RX_PPS"), "800");
+        ASSERT_EQ(get(port, "TX_PPS"), "800");
+        ASSERT_EQ(get(port, "SAI_PORT_STAT_IF_IN_UCAST_PKTS_last"), "300");
+
+        setPortCounters(portId, 300, 5000);
+        rates.poll(1000, {port});
+        ASSERT_EQ(get(port, "RX_BPS"), "3000");
+        ASSERT_EQ(get(port, "TX_BPS"), "6000");
+        ASSERT_EQ(get(port, "RX_PPS"), "400");
+
+        /* FEC BER from the second poll with FEC counters */
+        m_countersTable.set(port, {
+            {"SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS", "0"},
+            {"SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES", "0"}
+        });
+        rates.poll(1000, {port});
+        ASSERT_EQ(get(port, "FEC_PRE_BER"), "-1");
+        ASSERT_EQ(get(port, "SAI_PORT_STAT_IF_FEC_NOT_CORRECTABLE_FARMES_last"), "0");
+
+        m_countersTable.set(port, {
+            {"SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS", "1031250"},
+            {"SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES", "10"}
+        });
+        rates.poll(1000, {port});
+        ASSERT_EQ(get(port, "FEC_PRE_BER"), "1e-05");
+        ASSERT_EQ(get(port, "FEC_POST_BER"), "9.6969696969697e-19");
+    }
+
+    TEST_F(RateCountersTest, MissingCounters)
+    {
+        m_ratesTable.set("RIF", {{"RIF_ALPHA", "0.1"}});
+        m_ratesTable.set("TRAP", {{"TRAP_ALPHA", "0.1"}});
+
+        /* The objects with missing counters are skipped */
+        RateCounters rifRates(RateCounters::Type::RIF, &m_countersDb, m_group);
+        const string rif = sai_serialize_object_id(rifId);
+        m_countersTable.set(rif, {
+            {"SAI_ROUTER_INTERFACE_STAT_IN_OCTETS", "100"},
+            {"SAI_ROUTER_INTERFACE_STAT_IN_PACKETS", "1"}
+        });
+        rifRates.poll(1000, {rif});
+        ASSERT_EQ(get(rif + ":RIF", "INIT_DONE"), "");
+
+        /* Unless they are 0 when they are missing */
+        RateCounters trapRates(RateCounters::Type::TRAP, &m_countersDb, m_group);
+        const string counter = sai_serialize_object_id(counterId);
+        trapRates.poll(1000, {counter});
+        ASSERT_EQ(get(counter + ":TRAP", "INIT_DONE"), "COUNTERS_LAST");
+        ASSERT_EQ(get(counter, "SAI_COUNTER_STAT_PACKETS_last"), "0");
+
+        m_countersTable.set(counter, {{"SAI_COUNTER_STAT_PACKETS", "50"}});
+        trapRates.poll(2000, {counter});
+        ASSERT_EQ(get(counter, "RX_PPS"), "25");
+    }
+
+    TEST_F(RateCountersTest, ObjectsOfPoll)
+    {
+        m_ratesTable.set("PORT", {{"PORT_ALPHA", "0.5"}});
+        RateCounters rates(RateCounters::Type::PORT, &m_countersDb, m_group);
+
+        vector<string> ports;
+        for (sai_object_id_t i = 0; i < 4; i++)
+        {
+            setPortCounters(portId + i, 0, 0);
+            ports.push_back(sai_serialize_object_id(portId + i));
+        }
+
+        rates.poll(1000, ports);
+        ASSERT_EQ(rates.getObjectCount(), 4u);
+
+        /* The smoothing factor, the counters in one batch, then the writes in one flush */
+        ASSERT_EQ(rates.getStats().polls, 1u);
+        ASSERT_EQ(rates.getStats().roundTrips, 3u);
+        ASSERT_EQ(rates.getStats().commands, 1u + 4u + 8u);
+
+        /* The removed ports are forgotten, the others keep their state */
+        setPortCounters(portId + 3, 0, 1000);
+        rates.poll(1000, {ports[3], ports[3]});
+        ASSERT_EQ(rates.getObjectCount(), 1u);
+        ASSERT_EQ(get(ports[3], "RX_BPS"), "1000");
+
+        /* A port that comes back starts over */
+        rates.poll(1000, {ports[0]});
+        ASSERT_EQ(rates.getObjectCount(), 1u);
+        setPortCounters(portId, 0, 1000);
+        rates.poll(1000, {ports[0]});
+        ASSERT_EQ(get(ports[0], "RX_BPS"), "1000");
+    }
+
+    TEST_F(RateCountersTest, SnapshotCounters)
+    {
+        m_ratesTable.set("PORT", {{"PORT_ALPHA", "0.5"}});
+        RateCounters rates(RateCounters::Type::PORT, &m_countersDb, m_group);
+
+        /* The counters of the snapshot are used over the COUNTERS table */
+        const string port = sai_serialize_object_id(portId);
+        setPortCounters(portId, 0, 0);
+
+        CounterSnapshotWriter writer(m_group, 1, 6);
+        ASSERT_TRUE(writer.setLayout({portId}, {
+            "SAI_PORT_STAT_IF_IN_OCTETS",
+            "SAI_PORT_STAT_IF_OUT_OCTETS",
+            "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS"
+        }));
+
+        for (uint64_t poll = 0; poll < 2; poll++)
+        {
+            writer.begin();
+            writer.set(0, 0, poll * 2000);
+            writer.set(0, 1, poll * 1000);
+            for (size_t counter = 2; counter < 6; counter++)
+            {
+                writer.set(0, counter, poll * 10);
+            }
+            writer.commit();
+
+            rates.poll(1000, {port});
+        }
+
+        ASSERT_EQ(get(port, "RX_BPS"), "2000");
+        ASSERT_EQ(get(port, "TX_BPS"), "1000");
+        ASSERT_EQ(get(port, "RX_PPS"), "20");
+        ASSERT_EQ(get(port, "SAI_PORT_STAT_IF_IN_OCTETS_last"), "2000");
+
+        /* Nothing is read from the COUNTERS table */
+        ASSERT_EQ(rates.getStats().roundTrips, 4u);
+        ASSERT_EQ(rates.getStats().commands, 6u);
+    }
+
+    TEST_F(RateCountersTest, SerdesRate)
+    {
+        ASSERT_DOUBLE_EQ(RateCounters::getSerdesRate(4, 100000), 4 * 25.78125e+9);
+        ASSERT_DOUBLE_EQ(RateCounters::getSerdesRate(8, 400000), 8 * 53.125e+9);
+        ASSERT_DOUBLE_EQ(RateCounters::getSerdesRate(1, 10000), 10.3125e+9);
+        ASSERT_EQ(RateCounters::getSerdesRate(3, 100000), 0);
+        ASSERT_EQ(RateCounters::getSerdesRate(0, 100000), 0);
+        ASSERT_EQ(RateCounters::getSerdesRate(4, 20000), 0);
+    }
+
+    /*
+     * Rates of 512 ports with N counters in the COUNTERS table, of which the
+     * 8 of port_rates.lua, read from the COUNTERS table and from the counter
+     * snapshot, with the redis commands and round trips of a poll.
+     * port_rates.lua runs inside redis and can't be measured here, it issues
+     * about 30 redis calls per port per poll, of which 12 writes. It is
+     * disabled by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*RateCounters_Benchmark*
+     */
+    TEST_F(RateCountersTest, DISABLED_RateCounters_Benchmark)
+    {
+        const size_t ports = 512;
+        const size_t counters = 64;
+        const int polls = 100;
+
+        m_ratesTable.set("PORT", {{"PORT_ALPHA", "0.5"}});
+
+        vector<string> counterNames = {
+            "SAI_PORT_STAT_IF_IN_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_OUT_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS",
+            "SAI_PORT_STAT_IF_IN_OCTETS",
+            "SAI_PORT_STAT_IF_OUT_OCTETS",
+            "SAI_PORT_STAT_IF_IN_FEC_CORRECTED_BITS",
+            "SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES"
+        };
+        while (counterNames.size() < counters)
+        {
+            counterNames.push_back("SAI_PORT_STAT_" + to_string(counterNames.size()));
+        }
+
+        vector<uint64_t> objects;
+        vector<string> keys;
+        for (size_t port = 0; port < ports; port++)
+        {
+            objects.push_back(portId + port);
+            keys.push_back(sai_serialize_object_id(portId + port));
+
+            vector<FieldValueTuple> values;
+            for (const auto &name : counterNames)
+            {
+                values.emplace_back(name, "1234567890");
+            }
+            m_countersTable.set(keys.back(), values);
+        }
+
+        RateCounters rates(RateCounters::Type::PORT, &m_countersDb, m_group);
+        rates.setSerdesRateGetter([](sai_object_id_t) { return RateCounters::getSerdesRate(4, 100000); });
+
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < polls; i++)
+        {
+            rates.poll(1000, keys);
+        }
+        auto table = chrono::steady_clock::now();
+        auto tableStats = rates.getStats();
+
+        CounterSnapshotWriter writer(m_group, ports, counters);
+        ASSERT_TRUE(writer.setLayout(objects, counterNames));
+        writer.begin();
+        for (size_t port = 0; port < ports; port++)
+        {
+            for (size_t counter = 0; counter < counters; counter++)
+            {
+                writer.set(port, counter, 1234567890);
+            }
+        }
+        writer.commit();
+
+        auto snapshot = chrono::steady_clock::now();
+        for (int i = 0; i < polls; i++)
+        {
+            rates.poll(1000, keys);
+        }
+        auto done = chrono::steady_clock::now();
+
+        auto snapshotStats = rates.getStats();
+        snapshotStats.commands -= tableStats.commands;
+        snapshotStats.roundTrips -= tableStats.roundTrips;
+
+        auto tableUs = chrono::duration_cast<chrono::microseconds>(table - start).count();
+        auto snapshotUs = chrono::duration_cast<chrono::microseconds>(done - snapshot).count();
+        cout << ports << " ports x " << counters << " counters, COUNTERS table " << tableUs / polls
+             << " us/poll, counter snapshot " << snapshotUs / polls << " us/poll" << endl;
+        cout << "redis commands/poll: COUNTERS table " << tableStats.commands / polls
+             << " in " << tableStats.roundTrips / polls << " round trips, counter snapshot "
+             << snapshotStats.commands / polls << " in " << snapshotStats.roundTrips / polls
+             << " round trips, port_rates.lua about " << ports * 30 << endl;
+    }
+}
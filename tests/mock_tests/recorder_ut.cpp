@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "recorder.h"
+
+namespace recorder_test
+{
+    using namespace std;
+    using namespace swss;
+
+    class RecorderTest : public ::testing::Test
+    {
+    protected:
+        string m_file = "recorder_ut.rec";
+
+        void SetUp() override
+        {
+            removeFiles();
+        }
+
+        void TearDown() override
+        {
+            removeFiles();
+        }
+
+        void removeFiles()
+        {
+            remove(m_file.c_str());
+            remove((m_file + ".1").c_str());
+            for (int i = 1; i <= 4; i++)
+            {
+                remove((m_file + ".rotated." + to_string(i)).c_str());
+            }
+        }
+
+        void startRec(RecWriter &writer, RecFormat format)
+        {
+            writer.setRecord(true);
+            writer.setRotate(false);
+            writer.setLocation(".");
+            writer.setFileName(m_file);
+            writer.setName("Test");
+            writer.setFormat(format);
+            writer.startRec(false);
+        }
+
+        vector<string> readRecords(const string &file, bool binary)
+        {
+            RecReader reader;
+            vector<string> records;
+            string timestamp, val;
+
+            EXPECT_TRUE(reader.open(file));
+            EXPECT_EQ(reader.isBinary(), binary);
+            while (reader.next(timestamp, val))
+            {
+                EXPECT_EQ(timestamp.size(), string("2024-01-01.00:00:00.000000").size());
+                records.push_back(val);
+            }
+            return records;
+        }
+    };
+
+    TEST_F(RecorderTest, TextAndBinaryFormats)
+    {
+        vector<string> expected = { "recording started", "ROUTE_TABLE:10.0.0.0/24|SET|nexthop:10.0.0.1|ifname:Ethernet0", "" };
+
+        {
+            RecWriter writer;
+            startRec(writer, RecFormat::TEXT);
+            writer.record(expected[1]);
+            writer.record(expected[2]);
+        }
+        ASSERT_EQ(readRecords(m_file, false), expected);
+
+        /* The text file is moved aside, not appended with binary records */
+        {
+            RecWriter writer;
+            startRec(writer, RecFormat::BINARY);
+            writer.record(expected[1]);
+            writer.record(expected[2]);
+            writer.flush();
+            ASSERT_EQ(readRecords(m_file, true), expected);
+        }
+        ASSERT_EQ(readRecords(m_file + ".rotated.1", false), expected);
+
+        /* The version and the block header are little endian on any host */
+        ifstream ifs(m_file, ifstream::binary);
+        vector<unsigned char> bytes(20);
+        ifs.read(reinterpret_cast<char *>(bytes.data()), bytes.size());
+        ASSERT_EQ(ifs.gcount(), 20);
+        ASSERT_EQ(vector<unsigned char>(bytes.begin() + 8, bytes.end()),
+                  vector<unsigned char>({ 1, 0, 0, 0, 'S', 'B', 'L', 'K', 0, 0, 0, 0 }));
+    }
+
+    TEST_F(RecorderTest, BinaryRotation)
+    {
+        const int count = 100000;
+
+        /* A file rotated by logrotate is left alone */
+        ofstream(m_file + ".1") << "logrotate" << endl;
+
+        {
+            RecWriter writer;
+            writer.setMaxFileSize(RecWriter::BLOCK_SIZE * 4, 3);
+            startRec(writer, RecFormat::BINARY);
+            for (int i = 0; i < count; i++)
+            {
+                writer.record("ROUTE_TABLE:10.0." + to_string(i) + "|SET|nexthop:10.0.0.1");
+            }
+        }
+
+        /* The records of the last files, in order and without a gap */
+        vector<string> records;
+        for (int i = 2; i >= 0; i--)
+        {
+            auto file = i ? m_file + ".rotated." + to_string(i) : m_file;
+            ASSERT_EQ(access(file.c_str(), F_OK), 0);
+            auto fileRecords = readRecords(file, true);
+            records.insert(records.end(), fileRecords.begin(), fileRecords.end());
+        }
+        /* 3 files in all, with the current one */
+        ASSERT_EQ(access((m_file + ".rotated.3").c_str(), F_OK), -1);
+        string line;
+        ASSERT_TRUE(getline(ifstream(m_file + ".1"), line));
+        ASSERT_EQ(line, "logrotate");
+
+        ASSERT_GT(records.size(), 0u);
+        ASSERT_EQ(records.back(), "ROUTE_TABLE:10.0." + to_string(count - 1) + "|SET|nexthop:10.0.0.1");
+        int first = count - static_cast<int>(records.size());
+        for (size_t i = 0; i < records.size(); i++)
+        {
+            ASSERT_EQ(records[i], "ROUTE_TABLE:10.0." + to_string(first + static_cast<int>(i)) + "|SET|nexthop:10.0.0.1");
+        }
+    }
+}
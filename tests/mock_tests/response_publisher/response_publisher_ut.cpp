@@ -30,3 +30,48 @@ TEST(ResponsePublisher, TestPublishBuffered)
     ASSERT_TRUE(stateTable.hget("SOME_KEY", "field", value));
     ASSERT_EQ(value, "value");
 }
+
+TEST(ResponsePublisher, TestDbWriteThread)
+{
+    DBConnector conn{"APPL_STATE_DB", 0};
+    DBConnector stateDb{"STATE_DB", 0};
+    Table stateTable{&conn, "SOME_TABLE"};
+    Table statsTable{&stateDb, RESPONSE_PUBLISHER_STATS_TABLE};
+    std::vector<FieldValueTuple> values;
+    std::string value;
+
+    {
+        ResponsePublisher publisher{"APPL_STATE_DB", true, true};
+
+        // Writes of the same key may be coalesced by the DB write thread,
+        // the end result must be the same.
+        publisher.writeToDB("SOME_TABLE", "KEY1", {{"field1", "value1"}}, SET_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY1", {{"field2", "value2"}}, SET_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY2", {{"field", "value"}}, SET_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY2", {}, DEL_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY3", {{"field", "value"}}, SET_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY3", {}, DEL_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY3", {{"field3", "value3"}}, SET_COMMAND);
+        publisher.writeToDB("SOME_TABLE", "KEY4", {}, SET_COMMAND);
+        publisher.flush();
+
+        ASSERT_EQ(publisher.getStats().entries, 8u);
+        // The DB write thread is done with all the entries once the publisher is destroyed.
+    }
+
+    ASSERT_TRUE(stateTable.hget("KEY1", "field1", value));
+    ASSERT_EQ(value, "value1");
+    ASSERT_TRUE(stateTable.hget("KEY1", "field2", value));
+    ASSERT_EQ(value, "value2");
+    ASSERT_FALSE(stateTable.get("KEY2", values));
+    ASSERT_TRUE(stateTable.get("KEY3", values));
+    ASSERT_EQ(values, std::vector<FieldValueTuple>({{"field3", "value3"}}));
+    ASSERT_TRUE(stateTable.hget("KEY4", "NULL", value));
+
+    std::string writes, coalesced;
+    ASSERT_TRUE(statsTable.hget("APPL_STATE_DB", "entries", value));
+    ASSERT_EQ(value, "8");
+    ASSERT_TRUE(statsTable.hget("APPL_STATE_DB", "writes", writes));
+    ASSERT_TRUE(statsTable.hget("APPL_STATE_DB", "coalesced", coalesced));
+    ASSERT_EQ(std::stoi(writes) + std::stoi(coalesced), 8);
+}
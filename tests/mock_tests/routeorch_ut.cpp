@@ -11,6 +11,7 @@
 #include "bulker.h"
 
 extern string gMySwitchType;
+extern bool gNhgInPlaceUpdate;
 
 extern std::unique_ptr<MockResponsePublisher> gMockResponsePublisher;
 
@@ -95,12 +96,16 @@ namespace routeorch_test
 
     struct RouteOrchTest : public ::testing::Test
     {
+        bool m_nhgInPlaceUpdate;
+
         RouteOrchTest()
         {
         }
 
         void SetUp() override
         {
+            m_nhgInPlaceUpdate = gNhgInPlaceUpdate;
+
             ASSERT_EQ(sai_route_api, nullptr);
             map<string, string> profile = {
                 { "SAI_VS_SWITCH_TYPE", "SAI_VS_SWITCH_TYPE_BCM56850" },
@@ -371,6 +376,8 @@ namespace routeorch_test
 
             sai_route_api = pold_sai_route_api;
             ut_helper::uninitSaiApi();
+
+            gNhgInPlaceUpdate = m_nhgInPlaceUpdate;
         }
     };
 
@@ -552,4 +559,137 @@ namespace routeorch_test
         ASSERT_EQ(current_create_count, create_route_count);
         ASSERT_EQ(current_set_count, set_route_count);
     }
+
+    TEST_F(RouteOrchTest, RouteOrchTestNhgInPlaceUpdate)
+    {
+        Table neighborTable = Table(m_app_db.get(), APP_NEIGH_TABLE_NAME);
+        neighborTable.set("Ethernet0:10.0.0.4", { {"neigh", "00:00:0a:00:00:04"},
+                                                  {"family", "IPv4" }});
+        gNeighOrch->addExistingData(&neighborTable);
+        static_cast<Orch *>(gNeighOrch)->doTask();
+
+        gNhgInPlaceUpdate = true;
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"3.3.3.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3,10.0.0.4"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        NextHopGroupKey nhg3("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0,10.0.0.4@Ethernet0");
+        NextHopGroupKey nhg2("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0");
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg3));
+        auto nhg_id = gRouteOrch->getNextHopGroupId(nhg3);
+        auto nhg_count = gRouteOrch->getNhgCount();
+
+        // Removing a member updates the group used by the route only, the route is not set
+        entries.clear();
+        entries.push_back({"3.3.3.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        consumer->addToSync(entries);
+        auto current_set_count = set_route_count;
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(current_set_count, set_route_count);
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg3));
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg2));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupId(nhg2), nhg_id);
+        ASSERT_EQ(gRouteOrch->getNhgCount(), nhg_count);
+        ASSERT_FALSE(gRouteOrch->isRefCounterZero(nhg2));
+        ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix("3.3.3.0/24")), nhg2);
+
+        // Adding the member back updates the same group
+        entries.clear();
+        entries.push_back({"3.3.3.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3,10.0.0.4"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(current_set_count, set_route_count);
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg2));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupId(nhg3), nhg_id);
+
+        // A group shared by two routes is not modified
+        entries.clear();
+        entries.push_back({"4.4.4.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3,10.0.0.4"}}});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        entries.clear();
+        entries.push_back({"3.3.3.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"}}});
+        consumer->addToSync(entries);
+        current_set_count = set_route_count;
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(current_set_count + 1, set_route_count);
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg3));
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg2));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupId(nhg3), nhg_id);
+        ASSERT_NE(gRouteOrch->getNextHopGroupId(nhg2), nhg_id);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchTestNhgInPlaceWeightUpdate)
+    {
+        gNhgInPlaceUpdate = true;
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"5.5.5.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"},
+                                                  {"weight", "1,2"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        NextHopGroupKey nhg_old("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0", "1,2");
+        NextHopGroupKey nhg_new("10.0.0.2@Ethernet0,10.0.0.3@Ethernet0", "3,2");
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_old));
+        auto nhg_id = gRouteOrch->getNextHopGroupId(nhg_old);
+
+        auto get_members = [](sai_object_id_t nhg_oid) {
+            vector<sai_object_id_t> members(8);
+            sai_attribute_t attr;
+            attr.id = SAI_NEXT_HOP_GROUP_ATTR_NEXT_HOP_MEMBER_LIST;
+            attr.value.objlist.count = (uint32_t)members.size();
+            attr.value.objlist.list = members.data();
+            EXPECT_EQ(sai_next_hop_group_api->get_next_hop_group_attribute(nhg_oid, 1, &attr), SAI_STATUS_SUCCESS);
+            members.resize(attr.value.objlist.count);
+            sort(members.begin(), members.end());
+            return members;
+        };
+        auto get_weights = [](const vector<sai_object_id_t>& members) {
+            multiset<int32_t> weights;
+            for (auto member : members)
+            {
+                sai_attribute_t attr;
+                attr.id = SAI_NEXT_HOP_GROUP_MEMBER_ATTR_WEIGHT;
+                EXPECT_EQ(sai_next_hop_group_api->get_next_hop_group_member_attribute(member, 1, &attr), SAI_STATUS_SUCCESS);
+                weights.insert(attr.value.s32);
+            }
+            return weights;
+        };
+
+        auto members = get_members(nhg_id);
+        ASSERT_EQ(members.size(), 2);
+        ASSERT_EQ(get_weights(members), multiset<int32_t>({ 1, 2 }));
+
+        // A weight-only change sets the weight of the existing members
+        entries.clear();
+        entries.push_back({"5.5.5.0/24", "SET", { {"ifname", "Ethernet0,Ethernet0"},
+                                                  {"nexthop", "10.0.0.2,10.0.0.3"},
+                                                  {"weight", "3,2"}}});
+        consumer->addToSync(entries);
+        auto current_set_count = set_route_count;
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(current_set_count, set_route_count);
+        ASSERT_FALSE(gRouteOrch->hasNextHopGroup(nhg_old));
+        ASSERT_TRUE(gRouteOrch->hasNextHopGroup(nhg_new));
+        ASSERT_EQ(gRouteOrch->getNextHopGroupId(nhg_new), nhg_id);
+        ASSERT_EQ(gRouteOrch->getSyncdRouteNhgKey(gVirtualRouterId, IpPrefix("5.5.5.0/24")), nhg_new);
+        ASSERT_EQ(get_members(nhg_id), members);
+        ASSERT_EQ(get_weights(members), multiset<int32_t>({ 3, 2 }));
+    }
 }
@@ -0,0 +1,302 @@
+#include <malloc.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <fstream>
+
+#include "ut_helper.h"
+#include "routeorch.h"
+
+namespace routetrie_test
+{
+    using namespace std;
+
+    /* Route entry layout used before the next hop group keys were interned */
+    struct LegacyRouteNhg
+    {
+        NextHopGroupKey nhg_key;
+        std::string nhg_index;
+    };
+
+    static size_t getRssBytes()
+    {
+        size_t pages = 0, resident = 0;
+        ifstream statm("/proc/self/statm");
+        statm >> pages >> resident;
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+
+    static vector<IpPrefix> generatePrefixes(size_t count)
+    {
+        vector<IpPrefix> prefixes;
+        prefixes.reserve(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            if (i % 2)
+            {
+                size_t n = i / 2;
+                prefixes.emplace_back("2001:db8:" + to_string((n >> 16) & 0xffff) + ":" + to_string(n & 0xffff) + "::/64");
+            }
+            else
+            {
+                size_t n = i / 2;
+                prefixes.emplace_back(to_string(10 + ((n >> 24) & 0x3f)) + "." + to_string((n >> 16) & 0xff) + "."
+                                      + to_string((n >> 8) & 0xff) + "." + to_string(n & 0xff) + "/32");
+            }
+        }
+        return prefixes;
+    }
+
+    static vector<NextHopGroupKey> generateNhgs(size_t count)
+    {
+        vector<NextHopGroupKey> nhgs;
+        for (size_t i = 0; i < count; i++)
+        {
+            nhgs.emplace_back("10.0." + to_string(i) + ".1@Ethernet0,10.0." + to_string(i) + ".2@Ethernet4");
+        }
+        return nhgs;
+    }
+
+    TEST(RouteTrieTest, InsertFindErase)
+    {
+        RouteTable table;
+
+        ASSERT_TRUE(table.empty());
+        ASSERT_TRUE(table.emplace(IpPrefix("10.0.0.0/8"), RouteNhg(NextHopGroupKey("1.1.1.1@Ethernet0"), "")).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.1.0.0/16"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.1.1.0/24"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.2.0.0/16"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("0.0.0.0/0"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("::/0"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("2001:db8::/32"), RouteNhg()).second);
+        ASSERT_FALSE(table.emplace(IpPrefix("10.1.0.0/16"), RouteNhg()).second);
+        ASSERT_EQ(table.size(), 7);
+
+        ASSERT_EQ(table.at(IpPrefix("10.0.0.0/8")).nhg_key, NextHopGroupKey("1.1.1.1@Ethernet0"));
+        ASSERT_EQ(table.find(IpPrefix("10.0.0.0/16")), table.end());
+        ASSERT_EQ(table.find(IpPrefix("10.1.1.0/25")), table.end());
+        ASSERT_EQ(table.count(IpPrefix("2001:db8::/32")), 1);
+        ASSERT_THROW(table.at(IpPrefix("11.0.0.0/8")), std::out_of_range);
+
+        /* Covering prefixes are visited before the prefixes they cover */
+        vector<string> order;
+        for (const auto &route : table)
+        {
+            order.push_back(route.first.to_string());
+        }
+        ASSERT_EQ(order, vector<string>({ "0.0.0.0/0", "10.0.0.0/8", "10.1.0.0/16", "10.1.1.0/24", "10.2.0.0/16",
+                                          "::/0", "2001:db8::/32" }));
+
+        vector<string> covering;
+        table.forEachCovering(IpAddress("10.1.1.1"), [&](const RouteTable::value_type &route) {
+            covering.push_back(route.first.to_string());
+        });
+        ASSERT_EQ(covering, vector<string>({ "0.0.0.0/0", "10.0.0.0/8", "10.1.0.0/16", "10.1.1.0/24" }));
+
+        ASSERT_EQ(table.erase(IpPrefix("10.1.0.0/16")), 1);
+        ASSERT_EQ(table.erase(IpPrefix("10.1.0.0/16")), 0);
+        ASSERT_NE(table.find(IpPrefix("10.1.1.0/24")), table.end());
+
+        for (auto it = table.begin(); it != table.end();)
+        {
+            if (it->first.isV4())
+            {
+                it = table.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        ASSERT_EQ(table.size(), 2);
+        ASSERT_EQ(table.begin()->first, IpPrefix("::/0"));
+
+        /* Nodes of the removed routes are reused */
+        size_t capacity = table.capacity();
+        ASSERT_TRUE(table.emplace(IpPrefix("10.1.1.0/24"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.1.2.0/24"), RouteNhg()).second);
+        ASSERT_EQ(table.capacity(), capacity);
+    }
+
+    TEST(RouteTrieTest, HostBitsPrefix)
+    {
+        RouteTable table;
+
+        /* Prefixes differing only in their host bits are different routes, like in std::map */
+        ASSERT_TRUE(table.emplace(IpPrefix("10.0.0.0/24"), RouteNhg(NextHopGroupKey("1.1.1.1@Ethernet0"), "")).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.0.0.1/24"), RouteNhg(NextHopGroupKey("1.1.1.2@Ethernet4"), "")).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.0.0.2/24"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.0.0.0/16"), RouteNhg()).second);
+        ASSERT_TRUE(table.emplace(IpPrefix("10.0.0.1/8"), RouteNhg()).second);
+        ASSERT_FALSE(table.emplace(IpPrefix("10.0.0.1/24"), RouteNhg()).second);
+        ASSERT_EQ(table.size(), 5);
+
+        ASSERT_EQ(table.at(IpPrefix("10.0.0.0/24")).nhg_key, NextHopGroupKey("1.1.1.1@Ethernet0"));
+        ASSERT_EQ(table.at(IpPrefix("10.0.0.1/24")).nhg_key, NextHopGroupKey("1.1.1.2@Ethernet4"));
+        ASSERT_EQ(table.find(IpPrefix("10.0.0.1/24"))->first, IpPrefix("10.0.0.1/24"));
+        ASSERT_EQ(table.find(IpPrefix("10.0.0.3/24")), table.end());
+        ASSERT_EQ(table.count(IpPrefix("10.0.0.0/8")), 0);
+        ASSERT_THROW(table.at(IpPrefix("10.0.0.3/24")), std::out_of_range);
+
+        /* Prefixes with host bits set are visited after the other ones */
+        vector<string> order;
+        for (const auto &route : table)
+        {
+            order.push_back(route.first.to_string());
+        }
+        ASSERT_EQ(order, vector<string>({ "10.0.0.0/16", "10.0.0.0/24", "10.0.0.1/8", "10.0.0.1/24", "10.0.0.2/24" }));
+
+        vector<string> covering;
+        table.forEachCovering(IpAddress("10.0.0.5"), [&](const RouteTable::value_type &route) {
+            covering.push_back(route.first.to_string());
+        });
+        ASSERT_EQ(covering, vector<string>({ "10.0.0.1/8", "10.0.0.0/16", "10.0.0.0/24", "10.0.0.1/24", "10.0.0.2/24" }));
+
+        ASSERT_EQ(table.erase(IpPrefix("10.0.0.1/24")), 1);
+        ASSERT_EQ(table.erase(IpPrefix("10.0.0.1/24")), 0);
+        ASSERT_EQ(table.at(IpPrefix("10.0.0.0/24")).nhg_key, NextHopGroupKey("1.1.1.1@Ethernet0"));
+        ASSERT_EQ(table.size(), 4);
+
+        for (auto it = table.begin(); it != table.end();)
+        {
+            if (it->first.getMaskLength() == 24)
+            {
+                it = table.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        order.clear();
+        for (const auto &route : table)
+        {
+            order.push_back(route.first.to_string());
+        }
+        ASSERT_EQ(order, vector<string>({ "10.0.0.0/16", "10.0.0.1/8" }));
+
+        ASSERT_EQ(table.erase(IpPrefix("10.0.0.0/16")), 1);
+        ASSERT_EQ(table.begin()->first, IpPrefix("10.0.0.1/8"));
+        table.clear();
+        ASSERT_TRUE(table.empty());
+        ASSERT_EQ(table.begin(), table.end());
+    }
+
+    TEST(RouteTrieTest, InternedNextHopGroup)
+    {
+        NextHopGroupKey nhg("1.1.1.1@Ethernet0,1.1.1.2@Ethernet4");
+
+        RouteTable table;
+        table[IpPrefix("1.0.0.0/24")] = RouteNhg(nhg, "");
+        table[IpPrefix("2.0.0.0/24")] = RouteNhg(NextHopGroupKey(nhg.to_string()), "");
+        table[IpPrefix("3.0.0.0/24")] = RouteNhg(nhg, "group1");
+
+        /* Routes using the same next hops share the interned key */
+        const auto &first = table.at(IpPrefix("1.0.0.0/24")).nhg_key;
+        const auto &second = table.at(IpPrefix("2.0.0.0/24")).nhg_key;
+        ASSERT_EQ(first.getId(), second.getId());
+        ASSERT_EQ(first.getHash(), second.getHash());
+        ASSERT_EQ(table.at(IpPrefix("1.0.0.0/24")), table.at(IpPrefix("2.0.0.0/24")));
+        ASSERT_NE(table.at(IpPrefix("1.0.0.0/24")), table.at(IpPrefix("3.0.0.0/24")));
+        ASSERT_EQ(table.at(IpPrefix("3.0.0.0/24")), RouteNhg(nhg, "group1"));
+
+        RouteNhg copy = table.at(IpPrefix("1.0.0.0/24"));
+        table.erase(IpPrefix("1.0.0.0/24"));
+        table.at(IpPrefix("2.0.0.0/24")).nhg_key = NextHopGroupKey();
+        table.erase(IpPrefix("3.0.0.0/24"));
+        ASSERT_EQ(copy.nhg_key, nhg);
+        ASSERT_EQ(copy.nhg_key.getId(), nhg.getId());
+        ASSERT_EQ(table.at(IpPrefix("2.0.0.0/24")).nhg_key.getSize(), 0);
+    }
+
+    TEST(RouteTrieTest, RouteKeyOrder)
+    {
+        set<RouteKey> routes;
+        routes.insert({ 1, IpPrefix("1.0.0.0/24") });
+        routes.insert({ 2, IpPrefix("1.0.0.0/24") });
+        routes.insert({ 1, IpPrefix("2.0.0.0/24") });
+        ASSERT_EQ(routes.size(), 3);
+        ASSERT_EQ(routes.count({ 2, IpPrefix("1.0.0.0/24") }), 1);
+    }
+
+    /*
+     * Memory and throughput of the route table at 1M and 2M prefixes. It is
+     * disabled by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*RouteTable_Benchmark*
+     */
+    TEST(RouteTrieTest, DISABLED_RouteTable_Benchmark)
+    {
+        const auto nhgs = generateNhgs(64);
+
+        for (size_t count : { 1000000UL, 2000000UL })
+        {
+            const auto prefixes = generatePrefixes(count);
+
+            {
+                malloc_trim(0);
+                size_t rss = getRssBytes();
+                map<IpPrefix, LegacyRouteNhg> table;
+
+                auto start = chrono::steady_clock::now();
+                for (size_t i = 0; i < count; i++)
+                {
+                    table[prefixes[i]] = LegacyRouteNhg{ nhgs[i % nhgs.size()], "" };
+                }
+                auto inserted = chrono::steady_clock::now();
+                size_t found = 0;
+                for (const auto &prefix : prefixes)
+                {
+                    found += table.count(prefix);
+                }
+                auto looked_up = chrono::steady_clock::now();
+                size_t mem = getRssBytes() - rss;
+                for (const auto &prefix : prefixes)
+                {
+                    table.erase(prefix);
+                }
+                auto removed = chrono::steady_clock::now();
+
+                ASSERT_EQ(found, count);
+                cout << "std::map routes " << count
+                     << " memory " << mem / count << " B/route"
+                     << " insert " << chrono::duration_cast<chrono::milliseconds>(inserted - start).count() << " ms"
+                     << " find " << chrono::duration_cast<chrono::milliseconds>(looked_up - inserted).count() << " ms"
+                     << " erase " << chrono::duration_cast<chrono::milliseconds>(removed - looked_up).count() << " ms"
+                     << endl;
+            }
+
+            {
+                malloc_trim(0);
+                size_t rss = getRssBytes();
+                RouteTable table;
+
+                auto start = chrono::steady_clock::now();
+                for (size_t i = 0; i < count; i++)
+                {
+                    table[prefixes[i]] = RouteNhg(nhgs[i % nhgs.size()], "");
+                }
+                auto inserted = chrono::steady_clock::now();
+                size_t found = 0;
+                for (const auto &prefix : prefixes)
+                {
+                    found += table.count(prefix);
+                }
+                auto looked_up = chrono::steady_clock::now();
+                size_t mem = getRssBytes() - rss;
+                for (const auto &prefix : prefixes)
+                {
+                    table.erase(prefix);
+                }
+                auto removed = chrono::steady_clock::now();
+
+                ASSERT_EQ(found, count);
+                cout << "RouteTrie routes " << count
+                     << " memory " << mem / count << " B/route"
+                     << " insert " << chrono::duration_cast<chrono::milliseconds>(inserted - start).count() << " ms"
+                     << " find " << chrono::duration_cast<chrono::milliseconds>(looked_up - inserted).count() << " ms"
+                     << " erase " << chrono::duration_cast<chrono::milliseconds>(removed - looked_up).count() << " ms"
+                     << endl;
+            }
+        }
+    }
+}
@@ -0,0 +1,413 @@
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <linux/if_bridge.h>
+#include <linux/if_link.h>
+#include <linux/neighbour.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+
+#include "gtest/gtest.h"
+#define private public
+#include "rtnlclient.h"
+#undef private
+
+namespace rtnlclient_test
+{
+    using namespace std;
+    using namespace swss;
+
+    /* Requests queued by a batch, which are not sent until it is committed */
+    vector<const struct nlmsghdr *> queuedRequests(const RtnlClient &rtnl)
+    {
+        vector<const struct nlmsghdr *> requests;
+        size_t left = rtnl.m_requests.size();
+        for (auto *nlh = reinterpret_cast<const struct nlmsghdr *>(rtnl.m_requests.data()); NLMSG_OK(nlh, left); nlh = NLMSG_NEXT(nlh, left))
+        {
+            requests.push_back(nlh);
+        }
+        return requests;
+    }
+
+    /* Attributes of a request after its family header, or of a nested attribute */
+    vector<const struct rtattr *> attrs(const struct nlmsghdr *nlh, size_t hdrLen)
+    {
+        vector<const struct rtattr *> result;
+        int len = static_cast<int>(nlh->nlmsg_len - NLMSG_LENGTH(hdrLen));
+        auto *rta = reinterpret_cast<const struct rtattr *>(static_cast<const uint8_t *>(NLMSG_DATA(nlh)) + NLMSG_ALIGN(hdrLen));
+        for (; RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+        {
+            result.push_back(rta);
+        }
+        return result;
+    }
+
+    vector<const struct rtattr *> attrs(const struct rtattr *nest)
+    {
+        vector<const struct rtattr *> result;
+        int len = static_cast<int>(RTA_PAYLOAD(nest));
+        for (auto *rta = static_cast<const struct rtattr *>(RTA_DATA(nest)); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+        {
+            result.push_back(rta);
+        }
+        return result;
+    }
+
+    const struct rtattr *findAttr(const vector<const struct rtattr *> &attrs, uint16_t type)
+    {
+        for (auto *rta : attrs)
+        {
+            if ((rta->rta_type & NLA_TYPE_MASK) == type)
+            {
+                return rta;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    T attrValue(const struct rtattr *rta)
+    {
+        EXPECT_EQ(RTA_PAYLOAD(rta), sizeof(T));
+        T value;
+        memcpy(&value, RTA_DATA(rta), sizeof(T));
+        return value;
+    }
+
+    string attrString(const struct rtattr *rta)
+    {
+        return static_cast<const char *>(RTA_DATA(rta));
+    }
+
+    string attrIp(const struct rtattr *rta)
+    {
+        char buf[INET6_ADDRSTRLEN];
+        int family = RTA_PAYLOAD(rta) == 4 ? AF_INET : AF_INET6;
+        return inet_ntop(family, RTA_DATA(rta), buf, sizeof(buf));
+    }
+
+    TEST(RtnlClientTest, LinkRequests)
+    {
+        RtnlClient rtnl;
+        int lo = static_cast<int>(if_nametoindex("lo"));
+
+        rtnl.beginBatch();
+        ASSERT_EQ(rtnl.setLinkMtu("Ethernet0", 9100), 0);
+        ASSERT_EQ(rtnl.setLinkAdminState("Ethernet0", true), 0);
+        ASSERT_EQ(rtnl.setLinkMaster("Ethernet0", ""), 0);
+        ASSERT_EQ(rtnl.setLinkMac("Ethernet0", MacAddress("00:01:02:03:04:05")), 0);
+        ASSERT_EQ(rtnl.addVlan("Ethernet0.10", "lo", 10, false), 0);
+        ASSERT_EQ(rtnl.delLink("Ethernet0.10"), 0);
+        ASSERT_EQ(rtnl.getBatchResults(), vector<int>(6, 0));
+
+        auto requests = queuedRequests(rtnl);
+        ASSERT_EQ(requests.size(), 6);
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            ASSERT_EQ(requests[i]->nlmsg_seq, rtnl.m_firstSeq + i);
+            ASSERT_TRUE(requests[i]->nlmsg_flags & NLM_F_REQUEST);
+            ASSERT_TRUE(requests[i]->nlmsg_flags & NLM_F_ACK);
+        }
+
+        /* ip link set dev Ethernet0 mtu 9100 */
+        auto *ifi = static_cast<const struct ifinfomsg *>(NLMSG_DATA(requests[0]));
+        auto tb = attrs(requests[0], sizeof(*ifi));
+        ASSERT_EQ(requests[0]->nlmsg_type, RTM_NEWLINK);
+        ASSERT_FALSE(requests[0]->nlmsg_flags & NLM_F_CREATE);
+        ASSERT_EQ(ifi->ifi_change, 0);
+        ASSERT_EQ(attrString(findAttr(tb, IFLA_IFNAME)), "Ethernet0");
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(tb, IFLA_MTU)), 9100);
+
+        /* ip link set dev Ethernet0 up */
+        ifi = static_cast<const struct ifinfomsg *>(NLMSG_DATA(requests[1]));
+        ASSERT_EQ(ifi->ifi_flags, IFF_UP);
+        ASSERT_EQ(ifi->ifi_change, IFF_UP);
+
+        /* ip link set dev Ethernet0 nomaster */
+        tb = attrs(requests[2], sizeof(*ifi));
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(tb, IFLA_MASTER)), 0);
+
+        /* ip link set dev Ethernet0 address 00:01:02:03:04:05 */
+        tb = attrs(requests[3], sizeof(*ifi));
+        ASSERT_EQ(RTA_PAYLOAD(findAttr(tb, IFLA_ADDRESS)), ETHER_ADDR_LEN);
+        ASSERT_EQ(memcmp(RTA_DATA(findAttr(tb, IFLA_ADDRESS)), MacAddress("00:01:02:03:04:05").getMac(), ETHER_ADDR_LEN), 0);
+
+        /* ip link add link lo name Ethernet0.10 type vlan id 10 */
+        tb = attrs(requests[4], sizeof(*ifi));
+        ASSERT_EQ(requests[4]->nlmsg_type, RTM_NEWLINK);
+        ASSERT_EQ(requests[4]->nlmsg_flags & (NLM_F_CREATE | NLM_F_EXCL), NLM_F_CREATE | NLM_F_EXCL);
+        ASSERT_EQ(attrString(findAttr(tb, IFLA_IFNAME)), "Ethernet0.10");
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(tb, IFLA_LINK)), lo);
+        ASSERT_EQ(findAttr(tb, IFLA_ADDRESS), nullptr);
+        auto linkinfo = attrs(findAttr(tb, IFLA_LINKINFO));
+        ASSERT_EQ(attrString(findAttr(linkinfo, IFLA_INFO_KIND)), "vlan");
+        auto vlaninfo = attrs(findAttr(linkinfo, IFLA_INFO_DATA));
+        ASSERT_EQ(attrValue<uint16_t>(findAttr(vlaninfo, IFLA_VLAN_ID)), 10);
+
+        /* ip link del Ethernet0.10 */
+        tb = attrs(requests[5], sizeof(*ifi));
+        ASSERT_EQ(requests[5]->nlmsg_type, RTM_DELLINK);
+        ASSERT_EQ(attrString(findAttr(tb, IFLA_IFNAME)), "Ethernet0.10");
+
+        /* A new batch drops the queued requests, nothing is sent */
+        rtnl.beginBatch();
+        ASSERT_TRUE(queuedRequests(rtnl).empty());
+    }
+
+    TEST(RtnlClientTest, BridgeRequests)
+    {
+        RtnlClient rtnl;
+        int lo = static_cast<int>(if_nametoindex("lo"));
+
+        rtnl.beginBatch();
+        ASSERT_EQ(rtnl.addBridgeVlans("lo", {{100, 199, false}, {200, 0, true}}), 0);
+        ASSERT_EQ(rtnl.delBridgeVlan("lo", 10, true), 0);
+        ASSERT_EQ(rtnl.setBridgePortLearning("lo", false), 0);
+        ASSERT_EQ(rtnl.addVxlan("Vxlan100", 100, nullptr, nullptr, 4789, true), 0);
+
+        IpAddress srcIp("10.0.0.1");
+        IpAddress dstIp("10.0.0.2");
+        MacAddress mac("00:01:02:03:04:05");
+        ASSERT_EQ(rtnl.addVxlan("Vxlan200", 200, &srcIp, &dstIp, 4789, false, &mac), 0);
+
+        auto requests = queuedRequests(rtnl);
+        ASSERT_EQ(requests.size(), 5);
+
+        /* bridge vlan add vid 100-199 dev lo, bridge vlan add vid 200 pvid untagged dev lo */
+        auto *ifi = static_cast<const struct ifinfomsg *>(NLMSG_DATA(requests[0]));
+        ASSERT_EQ(requests[0]->nlmsg_type, RTM_SETLINK);
+        ASSERT_EQ(ifi->ifi_family, AF_BRIDGE);
+        ASSERT_EQ(ifi->ifi_index, lo);
+        auto afspec = attrs(findAttr(attrs(requests[0], sizeof(*ifi)), IFLA_AF_SPEC));
+        ASSERT_EQ(findAttr(afspec, IFLA_BRIDGE_FLAGS), nullptr);
+        ASSERT_EQ(afspec.size(), 3);
+        auto vinfo = attrValue<struct bridge_vlan_info>(afspec[0]);
+        ASSERT_EQ(vinfo.vid, 100);
+        ASSERT_EQ(vinfo.flags, BRIDGE_VLAN_INFO_RANGE_BEGIN);
+        vinfo = attrValue<struct bridge_vlan_info>(afspec[1]);
+        ASSERT_EQ(vinfo.vid, 199);
+        ASSERT_EQ(vinfo.flags, BRIDGE_VLAN_INFO_RANGE_END);
+        vinfo = attrValue<struct bridge_vlan_info>(afspec[2]);
+        ASSERT_EQ(vinfo.vid, 200);
+        ASSERT_EQ(vinfo.flags, BRIDGE_VLAN_INFO_PVID | BRIDGE_VLAN_INFO_UNTAGGED);
+
+        /* bridge vlan del vid 10 dev lo self */
+        ASSERT_EQ(requests[1]->nlmsg_type, RTM_DELLINK);
+        afspec = attrs(findAttr(attrs(requests[1], sizeof(*ifi)), IFLA_AF_SPEC));
+        ASSERT_EQ(attrValue<uint16_t>(findAttr(afspec, IFLA_BRIDGE_FLAGS)), BRIDGE_FLAGS_SELF);
+        ASSERT_EQ(attrValue<struct bridge_vlan_info>(findAttr(afspec, IFLA_BRIDGE_VLAN_INFO)).vid, 10);
+
+        /* bridge link set dev lo learning off */
+        ifi = static_cast<const struct ifinfomsg *>(NLMSG_DATA(requests[2]));
+        ASSERT_EQ(requests[2]->nlmsg_type, RTM_SETLINK);
+        ASSERT_EQ(ifi->ifi_family, AF_BRIDGE);
+        auto protinfo = findAttr(attrs(requests[2], sizeof(*ifi)), IFLA_PROTINFO);
+        ASSERT_TRUE(protinfo->rta_type & NLA_F_NESTED);
+        ASSERT_EQ(attrValue<uint8_t>(findAttr(attrs(protinfo), IFLA_BRPORT_LEARNING)), 0);
+
+        /* ip link add Vxlan100 type vxlan id 100 dstport 4789 */
+        auto tb = attrs(requests[3], sizeof(*ifi));
+        auto linkinfo = attrs(findAttr(tb, IFLA_LINKINFO));
+        ASSERT_EQ(attrString(findAttr(linkinfo, IFLA_INFO_KIND)), "vxlan");
+        auto vxlaninfo = attrs(findAttr(linkinfo, IFLA_INFO_DATA));
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(vxlaninfo, IFLA_VXLAN_ID)), 100);
+        ASSERT_EQ(attrValue<uint16_t>(findAttr(vxlaninfo, IFLA_VXLAN_PORT)), htons(4789));
+        ASSERT_EQ(attrValue<uint8_t>(findAttr(vxlaninfo, IFLA_VXLAN_LEARNING)), 1);
+        ASSERT_EQ(findAttr(vxlaninfo, IFLA_VXLAN_LOCAL), nullptr);
+        ASSERT_EQ(findAttr(vxlaninfo, IFLA_VXLAN_GROUP), nullptr);
+
+        /* ip link add Vxlan200 address 00:01:02:03:04:05 type vxlan id 200 local 10.0.0.1 remote 10.0.0.2 nolearning dstport 4789 */
+        tb = attrs(requests[4], sizeof(*ifi));
+        ASSERT_NE(findAttr(tb, IFLA_ADDRESS), nullptr);
+        vxlaninfo = attrs(findAttr(attrs(findAttr(tb, IFLA_LINKINFO)), IFLA_INFO_DATA));
+        ASSERT_EQ(attrIp(findAttr(vxlaninfo, IFLA_VXLAN_LOCAL)), "10.0.0.1");
+        ASSERT_EQ(attrIp(findAttr(vxlaninfo, IFLA_VXLAN_GROUP)), "10.0.0.2");
+        ASSERT_EQ(attrValue<uint8_t>(findAttr(vxlaninfo, IFLA_VXLAN_LEARNING)), 0);
+
+        rtnl.beginBatch();
+    }
+
+    TEST(RtnlClientTest, AddressRequests)
+    {
+        RtnlClient rtnl;
+        int lo = static_cast<int>(if_nametoindex("lo"));
+
+        rtnl.beginBatch();
+        ASSERT_EQ(rtnl.addAddress("lo", IpPrefix("10.1.0.1/24"), true), 0);
+        ASSERT_EQ(rtnl.addAddress("lo", IpPrefix("2001::1/64"), true, 256), 0);
+        ASSERT_EQ(rtnl.delAddress("lo", IpPrefix("10.1.0.1/24")), 0);
+        ASSERT_EQ(rtnl.addNeighbor("lo", IpAddress("10.1.0.2"), MacAddress("00:01:02:03:04:05")), 0);
+        ASSERT_EQ(rtnl.delNeighbor("lo", IpAddress("10.1.0.2")), 0);
+        ASSERT_EQ(rtnl.addRoute("lo", IpPrefix("10.2.0.0/16"), 20), 0);
+
+        auto requests = queuedRequests(rtnl);
+        ASSERT_EQ(requests.size(), 6);
+
+        /* ip address add 10.1.0.1/24 broadcast 10.1.0.255 dev lo */
+        auto *ifa = static_cast<const struct ifaddrmsg *>(NLMSG_DATA(requests[0]));
+        auto tb = attrs(requests[0], sizeof(*ifa));
+        ASSERT_EQ(requests[0]->nlmsg_type, RTM_NEWADDR);
+        ASSERT_EQ(requests[0]->nlmsg_flags & (NLM_F_CREATE | NLM_F_EXCL), NLM_F_CREATE | NLM_F_EXCL);
+        ASSERT_EQ(ifa->ifa_family, AF_INET);
+        ASSERT_EQ(ifa->ifa_prefixlen, 24);
+        ASSERT_EQ(ifa->ifa_index, lo);
+        ASSERT_EQ(attrIp(findAttr(tb, IFA_LOCAL)), "10.1.0.1");
+        ASSERT_EQ(attrIp(findAttr(tb, IFA_BROADCAST)), "10.1.0.255");
+        ASSERT_EQ(findAttr(tb, IFA_RT_PRIORITY), nullptr);
+
+        /* ip -6 address add 2001::1/64 dev lo metric 256 */
+        ifa = static_cast<const struct ifaddrmsg *>(NLMSG_DATA(requests[1]));
+        tb = attrs(requests[1], sizeof(*ifa));
+        ASSERT_EQ(ifa->ifa_family, AF_INET6);
+        ASSERT_EQ(attrIp(findAttr(tb, IFA_LOCAL)), "2001::1");
+        ASSERT_EQ(findAttr(tb, IFA_BROADCAST), nullptr);
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(tb, IFA_RT_PRIORITY)), 256);
+
+        /* ip address del 10.1.0.1/24 dev lo */
+        tb = attrs(requests[2], sizeof(*ifa));
+        ASSERT_EQ(requests[2]->nlmsg_type, RTM_DELADDR);
+        ASSERT_EQ(findAttr(tb, IFA_BROADCAST), nullptr);
+
+        /* ip neigh add 10.1.0.2 lladdr 00:01:02:03:04:05 dev lo */
+        auto *ndm = static_cast<const struct ndmsg *>(NLMSG_DATA(requests[3]));
+        tb = attrs(requests[3], sizeof(*ndm));
+        ASSERT_EQ(requests[3]->nlmsg_type, RTM_NEWNEIGH);
+        ASSERT_EQ(ndm->ndm_ifindex, lo);
+        ASSERT_EQ(ndm->ndm_state, NUD_PERMANENT);
+        ASSERT_EQ(attrIp(findAttr(tb, NDA_DST)), "10.1.0.2");
+        ASSERT_EQ(RTA_PAYLOAD(findAttr(tb, NDA_LLADDR)), ETHER_ADDR_LEN);
+
+        /* ip neigh del 10.1.0.2 dev lo */
+        tb = attrs(requests[4], sizeof(*ndm));
+        ASSERT_EQ(requests[4]->nlmsg_type, RTM_DELNEIGH);
+        ASSERT_EQ(findAttr(tb, NDA_LLADDR), nullptr);
+
+        /* ip route add 10.2.0.0/16 dev lo metric 20 */
+        auto *rtm = static_cast<const struct rtmsg *>(NLMSG_DATA(requests[5]));
+        tb = attrs(requests[5], sizeof(*rtm));
+        ASSERT_EQ(requests[5]->nlmsg_type, RTM_NEWROUTE);
+        ASSERT_EQ(rtm->rtm_dst_len, 16);
+        ASSERT_EQ(rtm->rtm_table, RT_TABLE_MAIN);
+        ASSERT_EQ(attrIp(findAttr(tb, RTA_DST)), "10.2.0.0");
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(tb, RTA_OIF)), lo);
+        ASSERT_EQ(attrValue<uint32_t>(findAttr(tb, RTA_PRIORITY)), 20);
+
+        rtnl.beginBatch();
+    }
+
+    TEST(RtnlClientTest, UnknownInterface)
+    {
+        RtnlClient rtnl;
+
+        ASSERT_TRUE(rtnl.linkExists("lo"));
+        ASSERT_FALSE(rtnl.linkExists("nonexist0"));
+
+        ASSERT_EQ(rtnl.addRoute("nonexist0", IpPrefix("10.0.0.1/32")), -ENODEV);
+        ASSERT_EQ(rtnl.addBridgeVlan("nonexist0", 10, true), -ENODEV);
+        ASSERT_EQ(rtnl.getBatchResults(), vector<int>({-ENODEV}));
+
+        vector<uint16_t> vlans;
+        ASSERT_EQ(rtnl.getBridgeVlans("nonexist0", vlans), -ENODEV);
+
+        /* Each queued operation keeps its own result */
+        rtnl.beginBatch();
+        ASSERT_EQ(rtnl.addNeighbor("nonexist0", IpAddress("10.0.0.1"), MacAddress("00:01:02:03:04:05")), -ENODEV);
+        ASSERT_EQ(rtnl.setLinkMaster("lo", "nonexist1"), -ENODEV);
+        ASSERT_EQ(rtnl.commitBatch(), -ENODEV);
+        ASSERT_EQ(rtnl.getBatchResults(), vector<int>({-ENODEV, -ENODEV}));
+
+        ASSERT_TRUE(RtnlClient::isRetriable(-ENODEV));
+        ASSERT_FALSE(RtnlClient::isRetriable(-EEXIST));
+    }
+
+    /*
+     * VLAN member add throughput of the bridge command against RtnlClient,
+     * one request per member, batched, and batched with VLAN ranges. It needs CAP_NET_ADMIN and a kernel
+     * with bridge VLAN filtering, and moves the test process to a new network
+     * namespace. It is disabled by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*VlanMember_Benchmark*
+     */
+    TEST(RtnlClientTest, DISABLED_VlanMember_Benchmark)
+    {
+        const uint16_t ports = 32;
+        const uint16_t vlans = 100;
+        const uint16_t firstVlan = 100;
+        const uint16_t lastVlan = firstVlan + vlans - 1;
+
+        ASSERT_EQ(unshare(CLONE_NEWNET), 0);
+
+        RtnlClient rtnl;
+        ASSERT_EQ(rtnl.addBridge("Bridge", true), 0);
+        int err = rtnl.setBridgeVlanFiltering("Bridge", true);
+        if (err)
+        {
+            cout << "Bridge VLAN filtering is not available: " << RtnlClient::errorString(err) << endl;
+            return;
+        }
+        ASSERT_EQ(rtnl.addBridgeVlan("Bridge", firstVlan, false, true, lastVlan), 0);
+
+        for (uint16_t port = 0; port < ports; port++)
+        {
+            string alias = "Ethernet" + to_string(port * 4);
+            ASSERT_EQ(rtnl.addDummy(alias), 0);
+            ASSERT_EQ(rtnl.setLinkMaster(alias, "Bridge"), 0);
+            ASSERT_EQ(rtnl.setLinkAdminState(alias, true), 0);
+        }
+
+        auto run = [&](const string &name, const function<void(const string &, uint16_t)> &add) {
+            auto start = chrono::steady_clock::now();
+            for (uint16_t port = 0; port < ports; port++)
+            {
+                for (uint16_t vlan = firstVlan; vlan <= lastVlan; vlan++)
+                {
+                    add("Ethernet" + to_string(port * 4), vlan);
+                }
+            }
+            ASSERT_EQ(rtnl.commitBatch(), 0);
+            auto done = chrono::steady_clock::now();
+
+            auto us = chrono::duration_cast<chrono::microseconds>(done - start).count();
+            cout << name << " " << ports * vlans << " members " << us / 1000 << " ms, "
+                 << static_cast<uint64_t>(ports * vlans) * 1000000 / static_cast<uint64_t>(max<int64_t>(us, 1))
+                 << " members/s" << endl;
+
+            for (uint16_t port = 0; port < ports; port++)
+            {
+                string alias = "Ethernet" + to_string(port * 4);
+                vector<uint16_t> members;
+                ASSERT_EQ(rtnl.getBridgeVlans(alias, members), 0);
+                ASSERT_EQ(count_if(members.begin(), members.end(), [&](uint16_t v) { return v >= firstVlan; }), vlans);
+                ASSERT_EQ(rtnl.delBridgeVlan(alias, firstVlan, false, lastVlan), 0);
+            }
+        };
+
+        run("bridge command", [&](const string &alias, uint16_t vlan) {
+            string cmd = "/sbin/bridge vlan add vid " + to_string(vlan) + " dev " + alias;
+            ASSERT_EQ(system(cmd.c_str()), 0);
+        });
+
+        run("RtnlClient", [&](const string &alias, uint16_t vlan) {
+            ASSERT_EQ(rtnl.addBridgeVlan(alias, vlan, false), 0);
+        });
+
+        rtnl.beginBatch();
+        run("RtnlClient batch", [&](const string &alias, uint16_t vlan) {
+            rtnl.addBridgeVlan(alias, vlan, false);
+        });
+
+        /* As VlanMgr applies tagged members, a single range request per port */
+        rtnl.beginBatch();
+        run("RtnlClient ranges", [&](const string &alias, uint16_t vlan) {
+            if (vlan == firstVlan)
+            {
+                rtnl.addBridgeVlans(alias, {{firstVlan, lastVlan, false}});
+            }
+        });
+    }
+}
@@ -0,0 +1,384 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <typeinfo>
+
+#include "mock_orch_test.h"
+#include "recorder.h"
+#include "tokenize.h"
+
+namespace swssreplay_test
+{
+    using namespace std;
+    using namespace mock_orch_test;
+
+    /*
+     * Replays a swss.rec recording into the Consumers of the orchs of
+     * MockOrchTest, on top of the virtual SAI, without redis. The records
+     * are fed as OrchDaemon does: a batch of the records arrived by then per
+     * Consumer, drained, then a doTask() of all the orchs for the retries.
+     */
+    class SwssReplay
+    {
+    public:
+        struct Record
+        {
+            uint64_t timestampUs;
+            string record;
+        };
+
+        /* Records per table, and CPU time of the Consumer */
+        struct TableStats
+        {
+            uint64_t records = 0;
+            uint64_t cpuUs = 0;
+        };
+
+        SwssReplay(const vector<Orch **> &orchs)
+        {
+            for (auto orch : orchs)
+            {
+                for (auto &it : (*orch)->m_consumerMap)
+                {
+                    auto consumer = dynamic_cast<Consumer *>(it.second.get());
+                    if (!consumer)
+                    {
+                        continue;
+                    }
+
+                    string prefix = consumer->getTableName() + consumer->getConsumerTable()->getTableNameSeparator();
+                    m_consumers.emplace(prefix, consumer);
+                    m_orchs[consumer] = *orch;
+                }
+                m_orchList.push_back(*orch);
+            }
+        }
+
+        static bool parseTimestamp(const string &timestamp, uint64_t &timestampUs)
+        {
+            struct tm tm = {};
+            auto end = strptime(timestamp.c_str(), "%Y-%m-%d.%H:%M:%S", &tm);
+            if (!end || *end != '.')
+            {
+                return false;
+            }
+            tm.tm_isdst = -1;
+            timestampUs = static_cast<uint64_t>(mktime(&tm)) * 1000000 + strtoull(end + 1, NULL, 10);
+            return true;
+        }
+
+        static bool load(const string &file, vector<Record> &records)
+        {
+            RecReader reader;
+            if (!reader.open(file))
+            {
+                return false;
+            }
+
+            string timestamp, record;
+            while (reader.next(timestamp, record))
+            {
+                uint64_t timestampUs;
+                if (parseTimestamp(timestamp, timestampUs))
+                {
+                    records.push_back({ timestampUs, record });
+                }
+            }
+            return true;
+        }
+
+        /*
+         * With speed 0 the records are fed as fast as the orchs take them,
+         * else at speed times the recorded pace.
+         */
+        void replay(const vector<Record> &records, double speed)
+        {
+            struct Task
+            {
+                Consumer *consumer;
+                KeyOpFieldsValuesTuple tuple;
+                uint64_t offsetUs;
+                chrono::steady_clock::time_point arrival;
+            };
+
+            vector<Task> tasks;
+            for (const auto &record : records)
+            {
+                tasks.emplace_back();
+                auto &task = tasks.back();
+                if (!parse(record.record, task.consumer, task.tuple))
+                {
+                    tasks.pop_back();
+                    m_skipped++;
+                    continue;
+                }
+                task.offsetUs = record.timestampUs > records[0].timestampUs ? record.timestampUs - records[0].timestampUs : 0;
+            }
+
+            auto start = chrono::steady_clock::now();
+            auto arrival = [&](const Task &task) {
+                return start + chrono::microseconds(static_cast<int64_t>(static_cast<double>(task.offsetUs) / speed));
+            };
+
+            map<Consumer *, deque<KeyOpFieldsValuesTuple>> batches;
+            map<Consumer *, vector<Task *>> batchTasks;
+            size_t next = 0;
+
+            while (next < tasks.size())
+            {
+                auto now = chrono::steady_clock::now();
+                if (speed > 0 && arrival(tasks[next]) > now)
+                {
+                    now = arrival(tasks[next]);
+                    this_thread::sleep_until(now);
+                }
+
+                /* The tasks arrived by now, up to a batch per Consumer as Consumer::execute() pops */
+                for (; next < tasks.size(); next++)
+                {
+                    auto &task = tasks[next];
+                    task.arrival = speed > 0 ? arrival(task) : now;
+                    if (task.arrival > now || batches[task.consumer].size() >= static_cast<size_t>(gBatchSize))
+                    {
+                        break;
+                    }
+                    batches[task.consumer].push_back(task.tuple);
+                    batchTasks[task.consumer].push_back(&task);
+                }
+
+                for (auto &batch : batches)
+                {
+                    if (batch.second.empty())
+                    {
+                        continue;
+                    }
+
+                    auto consumer = batch.first;
+                    auto cpuStart = threadCpuUs();
+                    consumer->addToSync(batch.second);
+                    consumer->drain();
+                    auto cpu = threadCpuUs() - cpuStart;
+
+                    auto &stats = m_tableStats[consumer->getTableName()];
+                    stats.records += batch.second.size();
+                    stats.cpuUs += cpu;
+                    m_orchCpuUs[m_orchs[consumer]] += cpu;
+
+                    auto done = chrono::steady_clock::now();
+                    for (auto task : batchTasks[consumer])
+                    {
+                        addLatency(static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(done - task->arrival).count()));
+                    }
+                    m_replayed += batch.second.size();
+                    batch.second.clear();
+                    batchTasks[consumer].clear();
+
+                    /* As OrchDaemon, retry the pending tasks of all the orchs after each Consumer */
+                    for (auto orch : m_orchList)
+                    {
+                        cpuStart = threadCpuUs();
+                        orch->doTask();
+                        m_orchCpuUs[orch] += threadCpuUs() - cpuStart;
+                    }
+                }
+            }
+
+            m_elapsedUs = static_cast<uint64_t>(chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count());
+        }
+
+        void report(ostream &out)
+        {
+            out << "Replayed " << m_replayed << " records in " << m_elapsedUs / 1000 << " ms, "
+                << m_replayed * 1000000 / max<uint64_t>(m_elapsedUs, 1) << " records/s, "
+                << m_skipped << " records of unknown tables skipped" << endl;
+
+            out << "Table throughput:" << endl;
+            for (const auto &it : m_tableStats)
+            {
+                out << "  " << it.first << ": " << it.second.records << " records, "
+                    << it.second.cpuUs / 1000 << " ms CPU, "
+                    << it.second.records * 1000000 / max<uint64_t>(it.second.cpuUs, 1) << " records/s" << endl;
+            }
+
+            out << "Orch CPU time:" << endl;
+            for (const auto &it : m_orchCpuUs)
+            {
+                out << "  " << typeid(*it.first).name() << ": " << it.second / 1000 << " ms" << endl;
+            }
+
+            out << "End to end latency:" << endl;
+            uint64_t count = 0;
+            for (size_t i = 0; i < m_latencyHistogram.size(); i++)
+            {
+                count += m_latencyHistogram[i];
+                if (m_latencyHistogram[i])
+                {
+                    out << "  < " << (1ull << i) << " us: " << m_latencyHistogram[i]
+                        << " (" << count * 100 / max<uint64_t>(m_latencies, 1) << "%)" << endl;
+                }
+            }
+            out << "  max: " << m_maxLatencyUs << " us" << endl;
+        }
+
+        uint64_t getReplayed()
+        {
+            return m_replayed;
+        }
+
+    private:
+        /* Consumers by "<table name><separator>", as the records start */
+        map<string, Consumer *> m_consumers;
+        map<Consumer *, Orch *> m_orchs;
+        vector<Orch *> m_orchList;
+
+        map<string, TableStats> m_tableStats;
+        map<Orch *, uint64_t> m_orchCpuUs;
+        /* Latencies by power of 2 microseconds */
+        vector<uint64_t> m_latencyHistogram = vector<uint64_t>(40);
+        uint64_t m_latencies = 0;
+        uint64_t m_maxLatencyUs = 0;
+        uint64_t m_replayed = 0;
+        uint64_t m_skipped = 0;
+        uint64_t m_elapsedUs = 0;
+
+        static uint64_t threadCpuUs()
+        {
+            struct timespec ts;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+        }
+
+        void addLatency(uint64_t latencyUs)
+        {
+            size_t bucket = 0;
+            while (bucket + 1 < m_latencyHistogram.size() && (1ull << bucket) <= latencyUs)
+            {
+                bucket++;
+            }
+            m_latencyHistogram[bucket]++;
+            m_latencies++;
+            m_maxLatencyUs = max(m_maxLatencyUs, latencyUs);
+        }
+
+        /* "<table><separator><key>|<op>|<field>:<value>|...", as ConsumerBase::dumpTuple() */
+        bool parse(const string &record, Consumer *&consumer, KeyOpFieldsValuesTuple &task)
+        {
+            /* The longest table name, a CONFIG_DB key may start as another table name */
+            consumer = nullptr;
+            size_t prefixSize = 0;
+            for (const auto &it : m_consumers)
+            {
+                if (it.first.size() > prefixSize && !record.compare(0, it.first.size(), it.first))
+                {
+                    consumer = it.second;
+                    prefixSize = it.first.size();
+                }
+            }
+            if (!consumer)
+            {
+                return false;
+            }
+
+            size_t keyStart = prefixSize;
+            size_t opStart = string::npos;
+            for (auto op : { "|" SET_COMMAND, "|" DEL_COMMAND })
+            {
+                for (auto pos = record.find(op, keyStart); pos != string::npos; pos = record.find(op, pos + 1))
+                {
+                    auto end = pos + strlen(op);
+                    if (end == record.size() || record[end] == '|')
+                    {
+                        opStart = min(opStart, pos);
+                        break;
+                    }
+                }
+            }
+            if (opStart == string::npos)
+            {
+                return false;
+            }
+
+            kfvKey(task) = record.substr(keyStart, opStart - keyStart);
+            auto fields = tokenize(record.substr(opStart + 1), '|');
+            kfvOp(task) = fields[0];
+            for (size_t i = 1; i < fields.size(); i++)
+            {
+                auto fv = tokenize(fields[i], ':', 1);
+                kfvFieldsValues(task).emplace_back(fv[0], fv.size() > 1 ? fv[1] : "");
+            }
+            return true;
+        }
+    };
+
+    class SwssReplayTest : public MockOrchTest
+    {
+    };
+
+    /*
+     * Replay of the recording given by SWSS_REPLAY_FILE, text or binary, or
+     * else of a generated one: the ports, an interface, a neighbor and 10000
+     * routes added then removed. SWSS_REPLAY_SPEED keeps the recorded pace,
+     * sped up by this factor, by default the records are fed as fast as the
+     * orchs take them. It is disabled by default, run with
+     * --gtest_also_run_disabled_tests --gtest_filter=*Replay_Benchmark*
+     */
+    TEST_F(SwssReplayTest, DISABLED_Replay_Benchmark)
+    {
+        vector<SwssReplay::Record> records;
+        auto file = getenv("SWSS_REPLAY_FILE");
+        auto speed = getenv("SWSS_REPLAY_SPEED");
+
+        if (file)
+        {
+            ASSERT_TRUE(SwssReplay::load(file, records)) << "Failed to read " << file;
+        }
+        else
+        {
+            uint64_t timestampUs = 0;
+            auto add = [&](const string &record) {
+                records.push_back({ timestampUs, record });
+                timestampUs += 10;
+            };
+
+            auto ports = ut_helper::getInitialSaiPorts();
+            for (const auto &port : ports)
+            {
+                string record = string(APP_PORT_TABLE_NAME) + ":" + port.first + "|SET";
+                for (const auto &fv : port.second)
+                {
+                    record += "|" + fvField(fv) + ":" + fvValue(fv);
+                }
+                add(record);
+            }
+            add(string(APP_PORT_TABLE_NAME) + ":PortConfigDone|SET|count:" + to_string(ports.size()));
+            add(string(APP_PORT_TABLE_NAME) + ":PortInitDone|SET|lanes:0");
+            add(string(APP_INTF_TABLE_NAME) + ":Ethernet0|SET|NULL:NULL|mac_addr:00:00:00:00:00:00");
+            add(string(APP_INTF_TABLE_NAME) + ":Ethernet0:10.0.0.1/24|SET|scope:global|family:IPv4");
+            add(string(APP_NEIGH_TABLE_NAME) + ":Ethernet0:10.0.0.2|SET|neigh:00:00:0a:00:00:02|family:IPv4");
+            for (const auto &op : { "SET|nexthop:10.0.0.2|ifname:Ethernet0", "DEL" })
+            {
+                for (int i = 0; i < 10000; i++)
+                {
+                    add(string(APP_ROUTE_TABLE_NAME) + ":20." + to_string(i / 256) + "." + to_string(i % 256) + ".0/24|" + op);
+                }
+            }
+        }
+
+        /* The replayed records are not recorded again */
+        bool record = Recorder::Instance().swss.isRecord();
+        Recorder::Instance().swss.setRecord(false);
+
+        SwssReplay replay(ut_orch_list);
+        replay.replay(records, speed ? atof(speed) : 0);
+        replay.report(cout);
+
+        Recorder::Instance().swss.setRecord(record);
+        ASSERT_GT(replay.getReplayed(), 0u);
+    }
+}
@@ -5,6 +5,7 @@
 
 extern int (*callback)(const std::string &cmd, std::string &stdout);
 extern std::vector<std::string> mockCallArgs;
+extern std::vector<std::string> mockRtnlCalls;
 static std::vector< std::pair<pid_t, int> > mockKillCommands;
 static std::map<std::string, std::FILE*> pidFiles;
 
@@ -159,6 +160,7 @@ namespace teammgr_ut
 
             cfg_lag_tables = tables;
             mockCallArgs.clear();
+            mockRtnlCalls.clear();
             mockKillCommands.clear();
             pidFiles.clear();
             callback = cb;
@@ -187,6 +189,7 @@ namespace teammgr_ut
         ASSERT_NE(mockCallArgs.size(), 0);
         EXPECT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel382"), std::string::npos);
         EXPECT_EQ(mockCallArgs.size(), 1);
+        EXPECT_TRUE(mockRtnlCalls.empty());
         EXPECT_EQ(mockKillCommands.size(), 1);
         EXPECT_EQ(mockKillCommands.front().first, 1234);
         EXPECT_EQ(mockKillCommands.front().second, SIGTERM);
@@ -206,6 +209,7 @@ namespace teammgr_ut
         ASSERT_NE(mockCallArgs.size(), 0);
         EXPECT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel812"), std::string::npos);
         EXPECT_EQ(mockCallArgs.size(), 1);
+        EXPECT_TRUE(mockRtnlCalls.empty());
         EXPECT_EQ(mockKillCommands.size(), 0);
     }
 
@@ -219,8 +223,10 @@ namespace teammgr_ut
                                             { "min_links", "2" } });
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
-        ASSERT_EQ(mockCallArgs.size(), 3);
+        ASSERT_EQ(mockCallArgs.size(), 1);
         ASSERT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel495"), std::string::npos);
+        ASSERT_EQ(mockRtnlCalls, std::vector<std::string>({"setLinkAdminState PortChannel495 up",
+                                                           "setLinkMtu PortChannel495 9100"}));
         teammgr.cleanTeamProcesses();
         EXPECT_EQ(mockKillCommands.size(), 2);
         EXPECT_EQ(mockKillCommands.front().first, 5678);
@@ -240,7 +246,8 @@ namespace teammgr_ut
         teammgr.doTask();
         ASSERT_NE(mockCallArgs.size(), 0);
         EXPECT_NE(mockCallArgs.front().find("/usr/bin/teamd -r -t PortChannel198"), std::string::npos);
-        EXPECT_EQ(mockCallArgs.size(), 3);
+        EXPECT_EQ(mockCallArgs.size(), 1);
+        EXPECT_EQ(mockRtnlCalls.size(), 2);
         teammgr.cleanTeamProcesses();
         EXPECT_EQ(mockKillCommands.size(), 0);
     }
@@ -257,7 +264,8 @@ namespace teammgr_ut
         }
         teammgr.addExistingData(&cfg_lag_table);
         teammgr.doTask();
-        ASSERT_EQ(mockCallArgs.size(), 60);
+        ASSERT_EQ(mockCallArgs.size(), 20);
+        ASSERT_EQ(mockRtnlCalls.size(), 40);
         std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
         teammgr.cleanTeamProcesses();
         std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
@@ -0,0 +1,238 @@
+#include <errno.h>
+
+#define protected public
+#include "orch.h"
+#undef protected
+#include "vlanmgr.h"
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "redisutility.h"
+
+extern int (*rtnlCallback)(const std::string &call);
+extern std::vector<std::string> mockRtnlCalls;
+
+namespace vlanmgr_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    bool failLag = false;
+
+    int rtnlCb(const string &call)
+    {
+        /* The batched request of Ethernet4 fails, its members added one by one succeed */
+        if (call == "addBridgeVlans Ethernet4 100-101")
+        {
+            return -EBUSY;
+        }
+        if (failLag && call.find("addBridgeVlans PortChannel1") == 0)
+        {
+            return -ENODEV;
+        }
+        return 0;
+    }
+
+    struct VlanMgrTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<VlanMgr> m_vlanMgr;
+        VlanMgrTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>(
+                "APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>(
+                "CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>(
+                "STATE_DB", 0);
+        }
+
+        virtual void SetUp() override
+        {
+            ::testing_db::reset();
+            rtnlCallback = rtnlCb;
+            failLag = false;
+
+            vector<string> cfg_vlan_tables = {
+                CFG_VLAN_TABLE_NAME,
+                CFG_VLAN_MEMBER_TABLE_NAME,
+            };
+            m_vlanMgr.reset(new VlanMgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_vlan_tables, {}));
+            mockRtnlCalls.clear();
+
+            Table state_port_table(m_state_db.get(), STATE_PORT_TABLE_NAME);
+            Table state_lag_table(m_state_db.get(), STATE_LAG_TABLE_NAME);
+            Table state_vlan_table(m_state_db.get(), STATE_VLAN_TABLE_NAME);
+            for (auto port : {"Ethernet0", "Ethernet4"})
+            {
+                state_port_table.set(port, {{"state", "ok"}});
+            }
+            state_lag_table.set("PortChannel1", {{"state", "ok"}});
+            for (auto vlan : {"Vlan100", "Vlan101", "Vlan102", "Vlan200"})
+            {
+                state_vlan_table.set(vlan, {{"state", "ok"}});
+            }
+        }
+
+        virtual void TearDown() override
+        {
+            rtnlCallback = nullptr;
+        }
+
+        void setMembers(const vector<pair<string, string>> &members)
+        {
+            Table cfg_vlan_member_table(m_config_db.get(), CFG_VLAN_MEMBER_TABLE_NAME);
+            for (const auto &member : members)
+            {
+                cfg_vlan_member_table.set(member.first, {{"tagging_mode", member.second}});
+            }
+            m_vlanMgr->addExistingData(&cfg_vlan_member_table);
+            m_vlanMgr->doTask();
+        }
+
+        bool isMemberSet(const string &key)
+        {
+            Table state_vlan_member_table(m_state_db.get(), STATE_VLAN_MEMBER_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            return state_vlan_member_table.get(key, values);
+        }
+    };
+
+    TEST_F(VlanMgrTest, MemberRanges)
+    {
+        setMembers({
+            {"Vlan101|Ethernet0", "tagged"},
+            {"Vlan100|Ethernet0", "tagged"},
+            {"Vlan102|Ethernet0", "tagged"},
+            {"Vlan200|Ethernet0", "untagged"},
+            {"Vlan100|Ethernet4", "tagged"}
+        });
+
+        /* One request per port, contiguous tagged VLANs are sent as a range */
+        vector<string> expected = {
+            "setLinkMaster Ethernet0 Bridge",
+            "delBridgeVlans Ethernet0 1",
+            "addBridgeVlans Ethernet0 100-102,200 untagged",
+            "setLinkMaster Ethernet4 Bridge",
+            "delBridgeVlans Ethernet4 1",
+            "addBridgeVlans Ethernet4 100"
+        };
+        ASSERT_EQ(expected, mockRtnlCalls);
+        for (auto key : {"Vlan100|Ethernet0", "Vlan101|Ethernet0", "Vlan102|Ethernet0", "Vlan200|Ethernet0", "Vlan100|Ethernet4"})
+        {
+            ASSERT_TRUE(isMemberSet(key)) << key;
+        }
+
+        /* Removed members of a port are sent as ranges too, then the port leaves the bridge */
+        auto consumer = dynamic_cast<Consumer *>(m_vlanMgr->getExecutor(CFG_VLAN_MEMBER_TABLE_NAME));
+        consumer->addToSync(deque<KeyOpFieldsValuesTuple>{
+            {"Vlan100|Ethernet0", DEL_COMMAND, {}},
+            {"Vlan101|Ethernet0", DEL_COMMAND, {}},
+            {"Vlan102|Ethernet0", DEL_COMMAND, {}},
+            {"Vlan200|Ethernet0", DEL_COMMAND, {}}
+        });
+        mockRtnlCalls.clear();
+        m_vlanMgr->doTask();
+
+        expected = {
+            "delBridgeVlans Ethernet0 100-102,200",
+            "getBridgeVlans Ethernet0",
+            "setLinkMaster Ethernet0 nomaster"
+        };
+        ASSERT_EQ(expected, mockRtnlCalls);
+        for (auto key : {"Vlan100|Ethernet0", "Vlan101|Ethernet0", "Vlan102|Ethernet0", "Vlan200|Ethernet0"})
+        {
+            ASSERT_FALSE(isMemberSet(key)) << key;
+        }
+        ASSERT_TRUE(isMemberSet("Vlan100|Ethernet4"));
+    }
+
+    TEST_F(VlanMgrTest, MemberFallback)
+    {
+        failLag = true;
+        setMembers({
+            {"Vlan100|Ethernet0", "tagged"},
+            {"Vlan100|Ethernet4", "tagged"},
+            {"Vlan101|Ethernet4", "tagged"},
+            {"Vlan100|PortChannel1", "tagged"}
+        });
+
+        /* Only the ports whose request failed are retried, one member at a time */
+        vector<string> expected = {
+            "setLinkMaster Ethernet0 Bridge",
+            "delBridgeVlans Ethernet0 1",
+            "addBridgeVlans Ethernet0 100",
+            "setLinkMaster Ethernet4 Bridge",
+            "delBridgeVlans Ethernet4 1",
+            "addBridgeVlans Ethernet4 100-101",
+            "setLinkMaster PortChannel1 Bridge",
+            "delBridgeVlans PortChannel1 1",
+            "addBridgeVlans PortChannel1 100",
+            "setLinkMaster Ethernet4 Bridge",
+            "delBridgeVlans Ethernet4 1",
+            "addBridgeVlans Ethernet4 100",
+            "setLinkMaster Ethernet4 Bridge",
+            "delBridgeVlans Ethernet4 1",
+            "addBridgeVlans Ethernet4 101",
+            "setLinkMaster PortChannel1 Bridge",
+            "delBridgeVlans PortChannel1 1",
+            "addBridgeVlans PortChannel1 100"
+        };
+        ASSERT_EQ(expected, mockRtnlCalls);
+        ASSERT_TRUE(isMemberSet("Vlan100|Ethernet0"));
+        ASSERT_TRUE(isMemberSet("Vlan100|Ethernet4"));
+        ASSERT_TRUE(isMemberSet("Vlan101|Ethernet4"));
+
+        /* The failed LAG member is kept and retried */
+        ASSERT_FALSE(isMemberSet("Vlan100|PortChannel1"));
+        auto consumer = dynamic_cast<Consumer *>(m_vlanMgr->getExecutor(CFG_VLAN_MEMBER_TABLE_NAME));
+        ASSERT_EQ(size_t(1), consumer->m_toSync.size());
+
+        failLag = false;
+        mockRtnlCalls.clear();
+        m_vlanMgr->doTask();
+        expected = {
+            "setLinkMaster PortChannel1 Bridge",
+            "delBridgeVlans PortChannel1 1",
+            "addBridgeVlans PortChannel1 100"
+        };
+        ASSERT_EQ(expected, mockRtnlCalls);
+        ASSERT_TRUE(isMemberSet("Vlan100|PortChannel1"));
+        ASSERT_TRUE(consumer->m_toSync.empty());
+    }
+
+    TEST_F(VlanMgrTest, MemberPendingKey)
+    {
+        setMembers({{"Vlan100|Ethernet0", "tagged"}});
+        ASSERT_TRUE(isMemberSet("Vlan100|Ethernet0"));
+
+        /* The removal is applied before the new task of the same member */
+        auto consumer = dynamic_cast<Consumer *>(m_vlanMgr->getExecutor(CFG_VLAN_MEMBER_TABLE_NAME));
+        consumer->addToSync(deque<KeyOpFieldsValuesTuple>{
+            {"Vlan100|Ethernet0", DEL_COMMAND, {}},
+            {"Vlan100|Ethernet0", SET_COMMAND, {{"tagging_mode", "untagged"}}}
+        });
+        mockRtnlCalls.clear();
+        m_vlanMgr->doTask();
+
+        vector<string> expected = {
+            "delBridgeVlans Ethernet0 100",
+            "getBridgeVlans Ethernet0",
+            "setLinkMaster Ethernet0 nomaster",
+            "setLinkMaster Ethernet0 Bridge",
+            "delBridgeVlans Ethernet0 1",
+            "addBridgeVlans Ethernet0 100 untagged"
+        };
+        ASSERT_EQ(expected, mockRtnlCalls);
+        ASSERT_TRUE(isMemberSet("Vlan100|Ethernet0"));
+        ASSERT_TRUE(consumer->m_toSync.empty());
+
+        Table app_vlan_member_table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+        vector<FieldValueTuple> values;
+        ASSERT_TRUE(app_vlan_member_table.get("Vlan100:Ethernet0", values));
+        auto value_opt = swss::fvsGetValue(values, "tagging_mode", true);
+        ASSERT_TRUE(value_opt);
+        ASSERT_EQ("untagged", value_opt.get());
+    }
+}
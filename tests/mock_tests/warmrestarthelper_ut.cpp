@@ -103,4 +103,78 @@ namespace wrhelper_test
         m_routeTable->hget("1.2.0.0/24", "protocol", val);
         ASSERT_EQ(val, "kernel");
     }
+
+    TEST_F(WRHelperTest, testShardedReconciliation)
+    {
+        const size_t count = 20000;
+
+        wrHelper->setState(WarmStart::INITIALIZED);
+
+        /* Old-life entries */
+        for (size_t i = 0; i < count; i++)
+        {
+            m_routeTable->set("10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256) + "/32",
+                            {
+                                {"ifname", "Ethernet0,Ethernet4"},
+                                {"nexthop", "2.0.0.1,2.0.0.2"}
+                            });
+        }
+        wrHelper->runRestoration();
+        ASSERT_EQ(wrHelper->getState(), WarmStart::RESTORED);
+
+        /*
+         * New life entries: unchanged with fields and next hops reordered,
+         * updated, deleted, missing (stale) and brand new.
+         */
+        for (size_t i = 0; i < count; i++)
+        {
+            std::string key = "10.0." + std::to_string(i / 256) + "." + std::to_string(i % 256) + "/32";
+            switch (i % 4)
+            {
+            case 0:
+                wrHelper->insertRefreshMap({key, "SET", {{"nexthop", "2.0.0.2,2.0.0.1"}, {"ifname", "Ethernet4,Ethernet0"}}});
+                break;
+            case 1:
+                wrHelper->insertRefreshMap({key, "SET", {{"ifname", "Ethernet0,Ethernet4"}, {"nexthop", "2.0.0.1,2.0.0.3"}}});
+                break;
+            case 2:
+                wrHelper->insertRefreshMap({key, "DEL", {}});
+                break;
+            default:
+                break;
+            }
+        }
+        wrHelper->insertRefreshMap({"11.0.0.0/24", "SET", {{"ifname", "Ethernet8"}, {"nexthop", "2.0.0.5"}}});
+        wrHelper->insertRefreshMap({"12.0.0.0/24", "DEL", {}});
+
+        wrHelper->reconcile();
+        ASSERT_EQ(wrHelper->getState(), WarmStart::RECONCILED);
+
+        std::vector<std::string> keys;
+        m_routeTable->getKeys(keys);
+        ASSERT_EQ(keys.size(), count / 2 + 1);
+
+        std::string val;
+        ASSERT_TRUE(m_routeTable->hget("10.0.0.0/32", "nexthop", val));
+        ASSERT_EQ(val, "2.0.0.1,2.0.0.2");
+        ASSERT_TRUE(m_routeTable->hget("10.0.0.1/32", "nexthop", val));
+        ASSERT_EQ(val, "2.0.0.1,2.0.0.3");
+        ASSERT_FALSE(m_routeTable->hget("10.0.0.2/32", "nexthop", val));
+        ASSERT_FALSE(m_routeTable->hget("10.0.0.3/32", "nexthop", val));
+        ASSERT_TRUE(m_routeTable->hget("11.0.0.0/24", "nexthop", val));
+        ASSERT_FALSE(m_routeTable->hget("12.0.0.0/24", "nexthop", val));
+
+        /* Reconciliation timings are recorded next to the warm-restart state */
+        swss::DBConnector stateDb("STATE_DB", 0);
+        swss::Table warmRestartTable(&stateDb, STATE_WARM_RESTART_TABLE_NAME);
+        ASSERT_TRUE(warmRestartTable.hget("bgp", "reconcile_records", val));
+        ASSERT_EQ(val, std::to_string(count));
+        ASSERT_TRUE(warmRestartTable.hget("bgp", "reconcile_threads", val));
+        ASSERT_GE(std::stoul(val), 1u);
+        for (auto field : {"restore_us", "reconcile_partition_us", "reconcile_compare_us",
+                           "reconcile_write_us", "reconcile_duration_us"})
+        {
+            ASSERT_TRUE(warmRestartTable.hget("bgp", field, val));
+        }
+    }
 }
@@ -0,0 +1,324 @@
+#define private public
+#include "portsorch.h"
+#include "watermarkorch.h"
+#undef private
+#include "mock_orch_test.h"
+#include "mock_table.h"
+#include "sai_serialize.h"
+#include "json.h"
+#include <hiredis/hiredis.h>
+
+extern redisReply *mockReply;
+
+namespace watermarkorch_test
+{
+    using namespace std;
+    using namespace swss;
+
+    class WatermarkClearBatchTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            ::testing_db::reset();
+        }
+    };
+
+    TEST_F(WatermarkClearBatchTest, CoalesceClears)
+    {
+        DBConnector countersDb("COUNTERS_DB", 0);
+        Table userTable(&countersDb, "USER_WATERMARKS");
+        Table persistentTable(&countersDb, "PERSISTENT_WATERMARKS");
+
+        vector<sai_object_id_t> unicastQueues = {0x15000000000001, 0x15000000000002};
+        vector<sai_object_id_t> allQueues = {0x15000000000001, 0x15000000000002, 0x15000000000003};
+        vector<sai_object_id_t> pgs = {0x1a000000000001};
+
+        WatermarkClearBatch batch;
+        ASSERT_TRUE(batch.empty());
+
+        /* Overlapping queue requests write each queue once */
+        batch.add(&userTable, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", unicastQueues);
+        batch.add(&userTable, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", allQueues);
+        /* The headroom and shared watermarks of a PG are written together */
+        batch.add(&userTable, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", pgs);
+        batch.add(&userTable, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", pgs);
+        /* The same objects of another table are written apart */
+        batch.add(&persistentTable, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES", unicastQueues);
+        ASSERT_FALSE(batch.empty());
+
+        ASSERT_EQ(batch.flush(), 6u);
+        ASSERT_TRUE(batch.empty());
+        ASSERT_EQ(batch.flush(), 0u);
+
+        vector<FieldValueTuple> fvs;
+        ASSERT_TRUE(userTable.get(sai_serialize_object_id(0x15000000000003), fvs));
+        ASSERT_EQ(fvs.size(), 1u);
+        ASSERT_EQ(fvField(fvs[0]), "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES");
+        ASSERT_EQ(fvValue(fvs[0]), "0");
+
+        ASSERT_TRUE(userTable.get(sai_serialize_object_id(0x1a000000000001), fvs));
+        ASSERT_EQ(fvs.size(), 2u);
+
+        vector<string> keys;
+        persistentTable.getKeys(keys);
+        ASSERT_EQ(keys.size(), 2u);
+    }
+
+    TEST_F(WatermarkClearBatchTest, KeepOtherWatermarks)
+    {
+        DBConnector countersDb("COUNTERS_DB", 0);
+        Table periodicTable(&countersDb, "PERIODIC_WATERMARKS");
+
+        string pg = sai_serialize_object_id(0x1a000000000001);
+        periodicTable.set(pg, {{"SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", "100"},
+                               {"SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", "200"}});
+
+        WatermarkClearBatch batch;
+        batch.add(&periodicTable, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", vector<sai_object_id_t>{0x1a000000000001});
+        ASSERT_EQ(batch.flush(), 1u);
+
+        string value;
+        ASSERT_TRUE(periodicTable.hget(pg, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", value));
+        ASSERT_EQ(value, "100");
+        ASSERT_TRUE(periodicTable.hget(pg, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", value));
+        ASSERT_EQ(value, "0");
+    }
+
+    class WatermarkOrchTest : public mock_orch_test::MockOrchTest
+    {
+    protected:
+        const sai_object_id_t m_pg1 = 0x1a000000000001;
+        const sai_object_id_t m_pg2 = 0x1a000000000002;
+        const sai_object_id_t m_unicastQueue = 0x15000000000001;
+        const sai_object_id_t m_multicastQueue = 0x15000000000002;
+        const sai_object_id_t m_allQueue = 0x15000000000003;
+
+        shared_ptr<DBConnector> m_counters_db;
+        WatermarkOrch *m_watermarkOrch;
+
+        void PostSetUp() override
+        {
+            m_counters_db = make_shared<DBConnector>("COUNTERS_DB", 0);
+            for (const auto &name : { PERIODIC_WATERMARKS_TABLE, PERSISTENT_WATERMARKS_TABLE, USER_WATERMARKS_TABLE })
+            {
+                Table table(m_counters_db.get(), name);
+                vector<string> keys;
+                table.getKeys(keys);
+                for (const auto &key : keys)
+                {
+                    table.del(key);
+                }
+            }
+
+            Table pgIndexTable(m_counters_db.get(), COUNTERS_PG_INDEX_MAP);
+            pgIndexTable.set("", { { sai_serialize_object_id(m_pg1), "0" },
+                                   { sai_serialize_object_id(m_pg2), "1" } });
+            Table queueTypeTable(m_counters_db.get(), COUNTERS_QUEUE_TYPE_MAP);
+            queueTypeTable.set("", { { sai_serialize_object_id(m_unicastQueue), "SAI_QUEUE_TYPE_UNICAST" },
+                                     { sai_serialize_object_id(m_multicastQueue), "SAI_QUEUE_TYPE_MULTICAST" },
+                                     { sai_serialize_object_id(m_allQueue), "SAI_QUEUE_TYPE_ALL" } });
+
+            m_watermarkOrch = new WatermarkOrch(m_config_db.get(), { CFG_WATERMARK_TABLE_NAME, CFG_FLEX_COUNTER_TABLE_NAME });
+            /* The plugin can't be loaded here, the dirty set is cleared by the mocked replies */
+            m_watermarkOrch->m_periodicClearSha = "sha";
+        }
+
+        void PreTearDown() override
+        {
+            delete m_watermarkOrch;
+        }
+
+        /* The PGs, the queues of each type and the buffer pools */
+        size_t fullClearObjects()
+        {
+            return 5 + gBufferOrch->getBufferPoolNameOidMap().size();
+        }
+
+        string getWatermark(const string &tableName, sai_object_id_t id, const string &field)
+        {
+            Table table(m_counters_db.get(), tableName);
+            string value;
+            table.hget(sai_serialize_object_id(id), field, value);
+            return value;
+        }
+
+        string getStat(const string &field)
+        {
+            Table statsTable(m_state_db.get(), WATERMARK_STATS_TABLE);
+            string value;
+            statsTable.hget("PERIODIC", field, value);
+            return value;
+        }
+
+        void sendClearRequest(const string &op, const string &data)
+        {
+            mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->type = REDIS_REPLY_ARRAY;
+            mockReply->elements = 3; // REDIS_PUBLISH_MESSAGE_ELEMNTS
+            mockReply->element = (redisReply **)calloc(sizeof(redisReply *), mockReply->elements);
+            mockReply->element[2] = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->element[2]->type = REDIS_REPLY_STRING;
+            string msg = JSon::buildJson({ { op, data } });
+            mockReply->element[2]->str = (char *)calloc(1, msg.length() + 1);
+            memcpy(mockReply->element[2]->str, msg.c_str(), msg.length());
+
+            m_watermarkOrch->m_clearNotificationConsumer->readData();
+            mockReply = nullptr;
+        }
+
+        /* The reply of the dirty set script, the number of objects it cleared */
+        void setScriptReply(const string &objects)
+        {
+            mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->type = REDIS_REPLY_ARRAY;
+            mockReply->elements = 1;
+            mockReply->element = (redisReply **)calloc(sizeof(redisReply *), mockReply->elements);
+            mockReply->element[0] = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->element[0]->type = REDIS_REPLY_STRING;
+            mockReply->element[0]->str = (char *)calloc(1, objects.length() + 1);
+            memcpy(mockReply->element[0]->str, objects.c_str(), objects.length());
+            mockReply->element[0]->len = objects.length();
+        }
+
+        void setScriptError()
+        {
+            string error = "NOSCRIPT No matching script";
+            mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->type = REDIS_REPLY_ERROR;
+            mockReply->str = (char *)calloc(1, error.length() + 1);
+            memcpy(mockReply->str, error.c_str(), error.length());
+            mockReply->len = error.length();
+        }
+    };
+
+    TEST_F(WatermarkOrchTest, ClearPeriodicWatermarks)
+    {
+        Table periodicTable(m_counters_db.get(), PERIODIC_WATERMARKS_TABLE);
+        string pg1 = sai_serialize_object_id(m_pg1);
+        periodicTable.set(pg1, { { "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", "100" } });
+
+        /* The first clear zeroes all the periodic watermarks */
+        m_watermarkOrch->init_pg_ids();
+        m_watermarkOrch->init_queue_ids();
+        m_watermarkOrch->clearPeriodicWatermarks();
+        ASSERT_FALSE(m_watermarkOrch->m_periodicFullClear);
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg2, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_unicastQueue, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_multicastQueue, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_allQueue, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getStat("clears"), "1");
+        ASSERT_EQ(getStat("objects"), to_string(fullClearObjects()));
+        ASSERT_NE(getStat("latency_us"), "");
+        ASSERT_NE(getStat("latency_max_us"), "");
+
+        /* Then only the dirty set is cleared, by the script */
+        periodicTable.set(pg1, { { "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", "100" } });
+        setScriptReply("1");
+        m_watermarkOrch->clearPeriodicWatermarks();
+        mockReply = nullptr;
+        ASSERT_FALSE(m_watermarkOrch->m_periodicFullClear);
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "100");
+        ASSERT_EQ(getStat("clears"), "2");
+        ASSERT_EQ(getStat("objects"), "1");
+
+        /* A script failure clears nothing, and everything the next time */
+        setScriptError();
+        m_watermarkOrch->clearPeriodicWatermarks();
+        mockReply = nullptr;
+        ASSERT_TRUE(m_watermarkOrch->m_periodicFullClear);
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "100");
+        ASSERT_EQ(getStat("clears"), "3");
+        ASSERT_EQ(getStat("objects"), "0");
+
+        m_watermarkOrch->clearPeriodicWatermarks();
+        ASSERT_FALSE(m_watermarkOrch->m_periodicFullClear);
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getStat("clears"), "4");
+        ASSERT_EQ(getStat("objects"), to_string(fullClearObjects()));
+
+        /* Without the script, every clear is a full one */
+        m_watermarkOrch->m_periodicClearSha.clear();
+        periodicTable.set(pg1, { { "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", "100" } });
+        m_watermarkOrch->clearPeriodicWatermarks();
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getStat("clears"), "5");
+        ASSERT_EQ(getStat("objects"), to_string(fullClearObjects()));
+    }
+
+    TEST_F(WatermarkOrchTest, TelemetryTimer)
+    {
+        m_watermarkOrch->handleWmConfigUpdate("TELEMETRY_INTERVAL", { { "interval", "30" } });
+        ASSERT_TRUE(m_watermarkOrch->m_timerChanged);
+
+        /* The first expiry loads the objects, applies the new interval and clears */
+        m_watermarkOrch->doTask(*m_watermarkOrch->m_telemetryTimer);
+        ASSERT_FALSE(m_watermarkOrch->m_timerChanged);
+        ASSERT_EQ(m_watermarkOrch->m_pg_ids.size(), 2u);
+        ASSERT_EQ(m_watermarkOrch->m_unicast_queue_ids.size(), 1u);
+        ASSERT_EQ(m_watermarkOrch->m_multicast_queue_ids.size(), 1u);
+        ASSERT_EQ(m_watermarkOrch->m_all_queue_ids.size(), 1u);
+        ASSERT_EQ(getWatermark(PERIODIC_WATERMARKS_TABLE, m_pg2, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getStat("clears"), "1");
+        ASSERT_EQ(getStat("objects"), to_string(fullClearObjects()));
+
+        setScriptReply("0");
+        m_watermarkOrch->doTask(*m_watermarkOrch->m_telemetryTimer);
+        mockReply = nullptr;
+        ASSERT_EQ(getStat("clears"), "2");
+        ASSERT_EQ(getStat("objects"), "0");
+
+        /* Another timer clears nothing */
+        SelectableTimer otherTimer(timespec { .tv_sec = 1, .tv_nsec = 0 });
+        m_watermarkOrch->doTask(otherTimer);
+        ASSERT_EQ(m_watermarkOrch->m_periodicClears, 2u);
+        ASSERT_EQ(getStat("clears"), "2");
+    }
+
+    TEST_F(WatermarkOrchTest, ClearRequests)
+    {
+        Table userTable(m_counters_db.get(), USER_WATERMARKS_TABLE);
+        Table persistentTable(m_counters_db.get(), PERSISTENT_WATERMARKS_TABLE);
+        string pg1 = sai_serialize_object_id(m_pg1);
+        userTable.set(pg1, { { "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", "100" } });
+        persistentTable.set(pg1, { { "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES", "100" },
+                                   { "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES", "200" } });
+
+        /* The requests wait for the ports */
+        bool initDone = gPortsOrch->m_initDone;
+        gPortsOrch->m_initDone = false;
+        sendClearRequest("USER", "PG_HEADROOM");
+        m_watermarkOrch->doTask(*m_watermarkOrch->m_clearNotificationConsumer);
+        ASSERT_EQ(getWatermark(USER_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"), "100");
+
+        /* The pending requests are all handled at once, the duplicated ones written once */
+        gPortsOrch->m_initDone = true;
+        ASSERT_TRUE(gPortsOrch->allPortsReady());
+        sendClearRequest("USER", "PG_HEADROOM");
+        sendClearRequest("USER", "Q_SHARED_UNI");
+        sendClearRequest("USER", "Q_SHARED_ALL");
+        sendClearRequest("PERSISTENT", "PG_SHARED");
+        sendClearRequest("PERSISTENT", "UNKNOWN");
+        sendClearRequest("UNKNOWN", "Q_SHARED_MULTI");
+        m_watermarkOrch->doTask(*m_watermarkOrch->m_clearNotificationConsumer);
+        gPortsOrch->m_initDone = initDone;
+
+        vector<FieldValueTuple> fvs;
+        ASSERT_TRUE(userTable.get(pg1, fvs));
+        ASSERT_EQ(fvs.size(), 1u);
+        ASSERT_EQ(getWatermark(USER_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(USER_WATERMARKS_TABLE, m_pg2, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(USER_WATERMARKS_TABLE, m_unicastQueue, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(USER_WATERMARKS_TABLE, m_allQueue, "SAI_QUEUE_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_FALSE(userTable.get(sai_serialize_object_id(m_multicastQueue), fvs));
+
+        /* The other watermarks of the objects are kept */
+        ASSERT_EQ(getWatermark(PERSISTENT_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_XOFF_ROOM_WATERMARK_BYTES"), "100");
+        ASSERT_EQ(getWatermark(PERSISTENT_WATERMARKS_TABLE, m_pg1, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_EQ(getWatermark(PERSISTENT_WATERMARKS_TABLE, m_pg2, "SAI_INGRESS_PRIORITY_GROUP_STAT_SHARED_WATERMARK_BYTES"), "0");
+        ASSERT_FALSE(persistentTable.get(sai_serialize_object_id(m_multicastQueue), fvs));
+        ASSERT_FALSE(persistentTable.get(sai_serialize_object_id(m_unicastQueue), fvs));
+        ASSERT_FALSE(m_watermarkOrch->m_clearNotificationConsumer->hasData());
+    }
+}
@@ -1,12 +1,30 @@
 #include <cassert>
 #include <sstream>
+#include <thread>
+#include <inttypes.h>
 
 #include "warmRestartHelper.h"
+#include "schema.h"
 
 
 using namespace swss;
 
 
+/*
+ * The comparison of the restored and refreshed entries is sharded across up
+ * to RECONCILE_MAX_THREADS threads, with at least RECONCILE_MIN_SHARD_SIZE
+ * entries per thread.
+ */
+#define RECONCILE_MAX_THREADS       8
+#define RECONCILE_MIN_SHARD_SIZE    4096
+
+static uint64_t elapsedUs(std::chrono::steady_clock::time_point start,
+                          std::chrono::steady_clock::time_point end)
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+
 WarmStartHelper::WarmStartHelper(RedisPipeline      *pipeline,
                                  ProducerStateTable *syncTable,
                                  const std::string  &syncTableName,
@@ -104,7 +122,9 @@ bool WarmStartHelper::runRestoration()
     SWSS_LOG_NOTICE("Warm-Restart: Initiating AppDB restoration process for %s "
                     "application.", m_appName.c_str());
 
+    auto start = std::chrono::steady_clock::now();
     m_restorationTable.getContent(m_restorationVector);
+    m_restoreUs = elapsedUs(start, std::chrono::steady_clock::now());
 
     /*
      * If there's no AppDB state to restore, then alert callee right away to avoid
@@ -156,18 +176,56 @@ void WarmStartHelper::reconcile(void)
 
     assert(getState() == WarmStart::RESTORED);
 
-    for (auto &restoredElem : m_restorationVector)
+    auto start = std::chrono::steady_clock::now();
+
+    /*
+     * The restored entries are sharded by key hash, and each shard is compared
+     * with the refreshMap by its own thread. The refreshMap is only read until
+     * all the shards are done.
+     */
+    size_t entries = m_restorationVector.size();
+    size_t shardCount = std::min<size_t>({RECONCILE_MAX_THREADS,
+                                          std::max<size_t>(std::thread::hardware_concurrency(), 1),
+                                          std::max<size_t>(entries / RECONCILE_MIN_SHARD_SIZE, 1)});
+
+    std::vector<std::vector<size_t>> shards(shardCount);
+    std::hash<std::string> keyHash;
+    for (size_t i = 0; i < entries; i++)
+    {
+        shards[keyHash(kfvKey(m_restorationVector[i])) % shardCount].push_back(i);
+    }
+
+    auto partitioned = std::chrono::steady_clock::now();
+
+    std::vector<ReconcileAction> actions(entries);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < shardCount; i++)
+    {
+        workers.emplace_back(&WarmStartHelper::compareShard, this, std::cref(shards[i]), std::ref(actions));
+    }
+    compareShard(shards[0], actions);
+    for (auto &worker : workers)
     {
-        std::string restoredKey  = kfvKey(restoredElem);
-        auto restoredFV          = kfvFieldsValues(restoredElem);
+        worker.join();
+    }
+
+    auto compared = std::chrono::steady_clock::now();
 
-        auto iter = m_refreshMap.find(restoredKey);
+    /*
+     * The outcome of the shards is merged back in the order of the restored
+     * entries, so that the producer writes are the same as a serial pass.
+     */
+    for (size_t i = 0; i < entries; i++)
+    {
+        const auto &restoredElem = m_restorationVector[i];
+        const std::string &restoredKey = kfvKey(restoredElem);
+        const auto &restoredFV         = kfvFieldsValues(restoredElem);
 
         /*
          * If the restored element is not found in the refreshMap, we must
          * push a delete operation for this entry.
          */
-        if (iter == m_refreshMap.end())
+        if (actions[i] == RECONCILE_DELETE_STALE)
         {
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting stale entry %s",
                             printKFV(restoredKey, restoredFV).c_str());
@@ -180,7 +238,7 @@ void WarmStartHelper::reconcile(void)
          * If an explicit delete request is sent by the application, process it
          * right away.
          */
-        else if (kfvOp(iter->second) == DEL_COMMAND)
+        else if (actions[i] == RECONCILE_DELETE)
         {
             SWSS_LOG_NOTICE("Warm-Restart reconciliation: deleting entry %s",
                             printKFV(restoredKey, restoredFV).c_str());
@@ -189,15 +247,16 @@ void WarmStartHelper::reconcile(void)
         }
 
         /*
-         * If a matching entry is found in refreshMap, proceed to compare it
-         * with its restored counterpart.
+         * If a matching entry is found in refreshMap with a different content,
+         * push the refreshed one.
          */
         else
         {
-            auto refreshedKey = kfvKey(iter->second);
-            auto refreshedFV  = kfvFieldsValues(iter->second);
+            auto iter = m_refreshMap.find(restoredKey);
+            const auto &refreshedKey = kfvKey(iter->second);
+            const auto &refreshedFV  = kfvFieldsValues(iter->second);
 
-            if (compareAllFV(restoredFV, refreshedFV))
+            if (actions[i] == RECONCILE_UPDATE)
             {
                 SWSS_LOG_NOTICE("Warm-Restart reconciliation: updating entry %s",
                                 printKFV(refreshedKey, refreshedFV).c_str());
@@ -253,6 +312,13 @@ void WarmStartHelper::reconcile(void)
     /* Clearing restoration vector */
     m_restorationVector.clear();
 
+    auto done = std::chrono::steady_clock::now();
+    publishReconcileStats(entries, shardCount,
+                          elapsedUs(start, partitioned),
+                          elapsedUs(partitioned, compared),
+                          elapsedUs(compared, done),
+                          elapsedUs(start, done));
+
     setState(WarmStart::RECONCILED);
 
     SWSS_LOG_NOTICE("Warm-Restart: Concluded reconciliation process for %s "
@@ -260,6 +326,72 @@ void WarmStartHelper::reconcile(void)
 }
 
 
+/*
+ * Compare the restored entries of a shard with their refreshed counterparts.
+ * Runs concurrently with the other shards, so it only reads the restored and
+ * refreshed state and writes the actions of its own entries.
+ */
+void WarmStartHelper::compareShard(const std::vector<size_t>    &shard,
+                                   std::vector<ReconcileAction> &actions)
+{
+    for (size_t i : shard)
+    {
+        const auto &restoredElem = m_restorationVector[i];
+
+        auto iter = m_refreshMap.find(kfvKey(restoredElem));
+        if (iter == m_refreshMap.end())
+        {
+            actions[i] = RECONCILE_DELETE_STALE;
+        }
+        else if (kfvOp(iter->second) == DEL_COMMAND)
+        {
+            actions[i] = RECONCILE_DELETE;
+        }
+        else if (compareAllFV(kfvFieldsValues(restoredElem), kfvFieldsValues(iter->second)))
+        {
+            actions[i] = RECONCILE_UPDATE;
+        }
+        else
+        {
+            actions[i] = RECONCILE_NONE;
+        }
+    }
+}
+
+
+/*
+ * Record the duration of the last reconciliation in STATE_DB WARM_RESTART_TABLE,
+ * next to the warm-restart state of the application.
+ */
+void WarmStartHelper::publishReconcileStats(size_t entries, size_t shards,
+                                            uint64_t partitionUs, uint64_t compareUs,
+                                            uint64_t writeUs, uint64_t totalUs)
+{
+    SWSS_LOG_NOTICE("Warm-Restart: Reconciled %zu records for %s application "
+                    "with %zu threads in %" PRIu64 " us (partition %" PRIu64
+                    " us, compare %" PRIu64 " us, write %" PRIu64 " us).",
+                    entries, m_appName.c_str(), shards, totalUs,
+                    partitionUs, compareUs, writeUs);
+
+    if (!m_warmRestartTable)
+    {
+        m_stateDb = std::make_unique<DBConnector>("STATE_DB", 0);
+        m_warmRestartTable = std::make_unique<Table>(m_stateDb.get(), STATE_WARM_RESTART_TABLE_NAME);
+    }
+
+    std::vector<FieldValueTuple> fvs = {
+        {"reconcile_records", std::to_string(entries)},
+        {"reconcile_threads", std::to_string(shards)},
+        {"restore_us", std::to_string(m_restoreUs)},
+        {"reconcile_partition_us", std::to_string(partitionUs)},
+        {"reconcile_compare_us", std::to_string(compareUs)},
+        {"reconcile_write_us", std::to_string(writeUs)},
+        {"reconcile_duration_us", std::to_string(totalUs)}
+    };
+    m_warmRestartTable->set(m_appName, fvs);
+}
+
+
 /*
  * Compare all field-value-tuples within two vectors.
  *
@@ -280,20 +412,34 @@ bool WarmStartHelper::compareAllFV(const std::vector<FieldValueTuple> &v1,
         return true;
     }
 
-    std::unordered_map<std::string, std::string> v1Map((v1.begin()), v1.end());
-
-     /* Iterate though all v2 tuples to check if their content match v1 ones */
-    for (auto &v2fv : v2)
+    /*
+     * Sort both sides by field so that the tuples can be compared pairwise.
+     * The buffers are per thread as reconciliation compares shards in parallel.
+     */
+    thread_local std::vector<const FieldValueTuple *> sorted1, sorted2;
+    auto byField = [](const FieldValueTuple *a, const FieldValueTuple *b) {
+        return fvField(*a) < fvField(*b);
+    };
+
+    sorted1.clear();
+    sorted2.clear();
+    for (size_t i = 0; i < v1.size(); i++)
     {
-        auto v1Iter = v1Map.find(v2fv.first);
+        sorted1.push_back(&v1[i]);
+        sorted2.push_back(&v2[i]);
+    }
+    std::sort(sorted1.begin(), sorted1.end(), byField);
+    std::sort(sorted2.begin(), sorted2.end(), byField);
 
+    for (size_t i = 0; i < sorted1.size(); i++)
+    {
         /* Return true when v2 has a new field */
-        if (v1Iter == v1Map.end())
+        if (fvField(*sorted1[i]) != fvField(*sorted2[i]))
         {
             return true;
         }
 
-        if (compareOneFV(v1Map[fvField(*v1Iter)], fvValue(v2fv)))
+        if (compareOneFV(fvValue(*sorted1[i]), fvValue(*sorted2[i])))
         {
             return true;
         }
@@ -324,6 +470,11 @@ bool WarmStartHelper::compareOneFV(const std::string &s1, const std::string &s2)
         return true;
     }
 
+    if (s1 == s2)
+    {
+        return false;
+    }
+
     std::vector<std::string> splitValuesS1 = tokenize(s1, ',');
     std::vector<std::string> splitValuesS2 = tokenize(s2, ',');
 
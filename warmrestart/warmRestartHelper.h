@@ -6,6 +6,8 @@
 #include <map>
 #include <unordered_map>
 #include <algorithm>
+#include <chrono>
+#include <memory>
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
@@ -61,6 +63,22 @@ class WarmStartHelper {
 
   private:
 
+    /* Outcome of the comparison of a restored entry with the refreshed state */
+    enum ReconcileAction : uint8_t
+    {
+        RECONCILE_DELETE_STALE,     // entry not refreshed by the application
+        RECONCILE_DELETE,           // entry deleted by the application
+        RECONCILE_UPDATE,           // entry refreshed with a different content
+        RECONCILE_NONE              // entry refreshed with the same content
+    };
+
+    void compareShard(const std::vector<size_t>       &shard,
+                      std::vector<ReconcileAction>    &actions);
+
+    void publishReconcileStats(size_t entries, size_t shards,
+                               uint64_t partitionUs, uint64_t compareUs,
+                               uint64_t writeUs, uint64_t totalUs);
+
     bool compareAllFV(const std::vector<FieldValueTuple> &left,
                       const std::vector<FieldValueTuple> &right);
 
@@ -75,6 +93,9 @@ class WarmStartHelper {
     std::string               m_syncTableName;     // producer-table-name to sync/push state to
     std::string               m_dockName;          // sonic-docker requesting warmStart services
     std::string               m_appName;           // sonic-app requesting warmStart services
+    uint64_t                  m_restoreUs = 0;     // duration of the AppDB restoration
+    std::unique_ptr<DBConnector> m_stateDb;        // STATE_DB for the reconciliation timings
+    std::unique_ptr<Table>    m_warmRestartTable;  // STATE_DB WARM_RESTART_TABLE
 };
 
 